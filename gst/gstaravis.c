@@ -34,12 +34,16 @@
  */
 
 #include <gstaravis.h>
+#include <gstaravisbufferpool.h>
+#include <gstaravismultisrc.h>
 #include <arvgvspprivate.h>
+#include <arvgcfeaturenodeprivate.h>
 #include <time.h>
 #include <string.h>
 
 #define GST_ARAVIS_DEFAULT_N_BUFFERS		50
 #define GST_ARAVIS_BUFFER_TIMEOUT_DEFAULT	2000000
+#define GST_ARAVIS_MAX_N_OUTPUT_FORMATS		3
 
 GST_DEBUG_CATEGORY_STATIC (aravis_debug);
 #define GST_CAT_DEFAULT aravis_debug
@@ -60,7 +64,8 @@ enum
   PROP_PACKET_SIZE,
   PROP_AUTO_PACKET_SIZE,
   PROP_PACKET_RESEND,
-  PROP_NUM_BUFFERS
+  PROP_NUM_BUFFERS,
+  PROP_STATS_INTERVAL
 };
 
 G_DEFINE_TYPE (GstAravis, gst_aravis, GST_TYPE_PUSH_SRC);
@@ -70,6 +75,87 @@ static GstStaticPadTemplate aravis_src_template = GST_STATIC_PAD_TEMPLATE ("src"
 									   GST_PAD_ALWAYS,
 									   GST_STATIC_CAPS ("ANY"));
 
+/* Pixel formats aravissrc outputs for a camera pixel format. Packed formats are unpacked to 16 bit, and Bayer
+ * formats are demosaiced to 8 bit RGB and BGRx, GStreamer not handling them otherwise. Raw Bayer is only offered
+ * for 8 bit pixels, as for the GStreamer bayer elements. */
+
+static guint
+_get_output_formats (ArvPixelFormat pixel_format, ArvPixelFormat output_formats[GST_ARAVIS_MAX_N_OUTPUT_FORMATS])
+{
+	ArvPixelFormat unpacked_format;
+	guint n_output_formats = 0;
+
+	unpacked_format = arv_pixel_format_get_unpacked_format (pixel_format);
+	if (unpacked_format == 0)
+		unpacked_format = pixel_format;
+
+	if (arv_demosaic_get_output_format (unpacked_format, FALSE) == 0) {
+		output_formats[n_output_formats++] = unpacked_format;
+	} else {
+		if (ARV_PIXEL_FORMAT_BIT_PER_PIXEL (pixel_format) == 8)
+			output_formats[n_output_formats++] = pixel_format;
+		output_formats[n_output_formats++] = ARV_PIXEL_FORMAT_RGB_8_PACKED;
+		output_formats[n_output_formats++] = ARV_PIXEL_FORMAT_BGRA_8_PACKED;
+	}
+
+	return n_output_formats;
+}
+
+/* Maximum value of the Bayer pixels, scaled to 255 in the 8 bit output */
+
+static guint16
+_get_bayer_max_value (ArvPixelFormat pixel_format)
+{
+	switch (pixel_format) {
+		case ARV_PIXEL_FORMAT_BAYER_GR_10:
+		case ARV_PIXEL_FORMAT_BAYER_RG_10:
+		case ARV_PIXEL_FORMAT_BAYER_GB_10:
+		case ARV_PIXEL_FORMAT_BAYER_BG_10:
+			return 0x3ff;
+		case ARV_PIXEL_FORMAT_BAYER_GR_12:
+		case ARV_PIXEL_FORMAT_BAYER_RG_12:
+		case ARV_PIXEL_FORMAT_BAYER_GB_12:
+		case ARV_PIXEL_FORMAT_BAYER_BG_12:
+			return 0xfff;
+		default:
+			return 0xffff;
+	}
+}
+
+/* Returns a converter from the camera pixel format to one of its output formats, NULL if there is no such
+ * conversion */
+
+static ArvConverter *
+_create_converter (ArvPixelFormat pixel_format, ArvPixelFormat output_format)
+{
+	ArvConverter *converter;
+	ArvPixelFormat bayer_format;
+	gboolean success = TRUE;
+
+	converter = arv_converter_new (pixel_format);
+
+	if (output_format != pixel_format && arv_pixel_format_get_unpacked_format (pixel_format) != 0)
+		success = arv_converter_add_unpack (converter, NULL);
+
+	bayer_format = arv_converter_get_output_format (converter);
+	if (success && arv_demosaic_get_output_format (bayer_format, FALSE) != 0 &&
+	    (output_format == ARV_PIXEL_FORMAT_RGB_8_PACKED || output_format == ARV_PIXEL_FORMAT_BGRA_8_PACKED)) {
+		success = arv_converter_add_demosaic (converter, ARV_DEMOSAIC_METHOD_BILINEAR,
+						      output_format == ARV_PIXEL_FORMAT_BGRA_8_PACKED, NULL);
+		if (success && ARV_PIXEL_FORMAT_BIT_PER_PIXEL (bayer_format) > 8)
+			success = arv_converter_add_window (converter, 0, _get_bayer_max_value (bayer_format), NULL);
+		if (success && output_format == ARV_PIXEL_FORMAT_BGRA_8_PACKED)
+			success = arv_converter_add_alpha (converter, NULL);
+	}
+
+	if (!success || arv_converter_get_output_format (converter) != output_format) {
+		g_object_unref (converter);
+		return NULL;
+	}
+
+	return converter;
+}
+
 static GstCaps *
 gst_aravis_get_all_camera_caps (GstAravis *gst_aravis)
 {
@@ -102,22 +188,30 @@ gst_aravis_get_all_camera_caps (GstAravis *gst_aravis)
 
 	caps = gst_caps_new_empty ();
 	for (i = 0; i < n_pixel_formats; i++) {
-		const char *caps_string;
-
-		caps_string = arv_pixel_format_to_gst_caps_string (pixel_formats[i]);
-
-		if (caps_string != NULL) {
-			GstStructure *structure;
-
-			structure = gst_structure_from_string (caps_string, NULL);
-			gst_structure_set (structure,
-					   "width", GST_TYPE_INT_RANGE, min_width, max_width,
-					   "height", GST_TYPE_INT_RANGE, min_height, max_height,
-					   "framerate", GST_TYPE_FRACTION_RANGE,
-							   min_frame_rate_numerator, min_frame_rate_denominator,
-							   max_frame_rate_numerator, max_frame_rate_denominator,
-					   NULL);
-			gst_caps_append_structure (caps, structure);
+		ArvPixelFormat output_formats[GST_ARAVIS_MAX_N_OUTPUT_FORMATS];
+		guint n_output_formats;
+		guint j;
+
+		n_output_formats = _get_output_formats (pixel_formats[i], output_formats);
+
+		for (j = 0; j < n_output_formats; j++) {
+			const char *caps_string;
+
+			caps_string = arv_pixel_format_to_gst_caps_string (output_formats[j]);
+
+			if (caps_string != NULL) {
+				GstStructure *structure;
+
+				structure = gst_structure_from_string (caps_string, NULL);
+				gst_structure_set (structure,
+						   "width", GST_TYPE_INT_RANGE, min_width, max_width,
+						   "height", GST_TYPE_INT_RANGE, min_height, max_height,
+						   "framerate", GST_TYPE_FRACTION_RANGE,
+								   min_frame_rate_numerator, min_frame_rate_denominator,
+								   max_frame_rate_numerator, max_frame_rate_denominator,
+						   NULL);
+				caps = gst_caps_merge_structure (caps, structure);
+			}
 		}
 	}
 
@@ -126,54 +220,180 @@ gst_aravis_get_all_camera_caps (GstAravis *gst_aravis)
 	return caps;
 }
 
+/* Features the camera caps are built from. Their change count is incremented by the Genicam dependency graph each
+ * time they, or one of the features they depend on, like the binning for the width bounds, are written. */
+
+static const char *caps_feature_names[] = {
+	"Width",
+	"Height",
+	"PixelFormat",
+	"AcquisitionFrameRate",
+	"AcquisitionFrameRateAbs",
+	"FPS"
+};
+
+static guint64
+_get_caps_change_count (GstAravis *gst_aravis)
+{
+	ArvGc *genicam;
+	guint64 change_count = 0;
+	guint i;
+
+	genicam = arv_device_get_genicam (arv_camera_get_device (gst_aravis->camera));
+
+	for (i = 0; i < G_N_ELEMENTS (caps_feature_names); i++) {
+		ArvGcNode *node = arv_gc_get_node (genicam, caps_feature_names[i]);
+
+		if (ARV_IS_GC_FEATURE_NODE (node))
+			change_count += arv_gc_feature_node_get_change_count (ARV_GC_FEATURE_NODE (node));
+	}
+
+	return change_count;
+}
+
+/* The camera caps are only enumerated again when one of the caps features has changed since the last
+ * enumeration */
+
+static void
+_update_all_caps (GstAravis *gst_aravis)
+{
+	GstCaps *caps;
+	guint64 change_count;
+
+	if (!ARV_IS_CAMERA (gst_aravis->camera))
+		return;
+
+	change_count = _get_caps_change_count (gst_aravis);
+
+	GST_OBJECT_LOCK (gst_aravis);
+	if (gst_aravis->all_caps != NULL && change_count == gst_aravis->all_caps_change_count) {
+		GST_OBJECT_UNLOCK (gst_aravis);
+		return;
+	}
+	GST_OBJECT_UNLOCK (gst_aravis);
+
+	caps = gst_aravis_get_all_camera_caps (gst_aravis);
+
+	GST_OBJECT_LOCK (gst_aravis);
+	if (gst_aravis->all_caps != NULL)
+		gst_caps_unref (gst_aravis->all_caps);
+	gst_aravis->all_caps = caps;
+	gst_aravis->all_caps_change_count = change_count;
+	GST_OBJECT_UNLOCK (gst_aravis);
+}
+
 static GstCaps *
 gst_aravis_get_caps (GstBaseSrc * src, GstCaps * filter)
 {
 	GstAravis* gst_aravis = GST_ARAVIS(src);
 	GstCaps *caps;
 
+	_update_all_caps (gst_aravis);
+
+	GST_OBJECT_LOCK (gst_aravis);
 	if (gst_aravis->all_caps != NULL)
-		caps = gst_caps_copy (gst_aravis->all_caps);
+		caps = gst_caps_ref (gst_aravis->all_caps);
 	else
 		caps = gst_caps_new_any ();
+	GST_OBJECT_UNLOCK (gst_aravis);
+
+	if (filter != NULL) {
+		GstCaps *filtered_caps;
+
+		filtered_caps = gst_caps_intersect_full (filter, caps, GST_CAPS_INTERSECT_FIRST);
+		gst_caps_unref (caps);
+		caps = filtered_caps;
+	}
 
 	GST_LOG_OBJECT (gst_aravis, "Available caps = %" GST_PTR_FORMAT, caps);
 
 	return caps;
 }
 
+/* Finds the camera pixel format, and the output format, matching the requested caps. The formats output without
+ * any conversion are preferred. */
+
+static gboolean
+_find_pixel_format (GstAravis *gst_aravis, const GstStructure *structure,
+		    ArvPixelFormat *pixel_format, ArvPixelFormat *output_format)
+{
+	gint64 *pixel_formats;
+	guint n_pixel_formats;
+	gboolean found = FALSE;
+	guint pass, i, j;
+
+	pixel_formats = arv_camera_get_available_pixel_formats (gst_aravis->camera, &n_pixel_formats, NULL);
+
+	for (pass = 0; pass < 2 && !found; pass++) {
+		for (i = 0; i < n_pixel_formats && !found; i++) {
+			ArvPixelFormat output_formats[GST_ARAVIS_MAX_N_OUTPUT_FORMATS];
+			guint n_output_formats;
+
+			n_output_formats = _get_output_formats (pixel_formats[i], output_formats);
+
+			for (j = 0; j < n_output_formats && !found; j++) {
+				GstStructure *output_structure;
+				const char *caps_string;
+
+				if ((pass == 0) != (output_formats[j] == pixel_formats[i]))
+					continue;
+
+				caps_string = arv_pixel_format_to_gst_caps_string (output_formats[j]);
+				if (caps_string == NULL)
+					continue;
+
+				output_structure = gst_structure_from_string (caps_string, NULL);
+				found = gst_structure_can_intersect (structure, output_structure);
+				gst_structure_free (output_structure);
+
+				if (found) {
+					*pixel_format = pixel_formats[i];
+					*output_format = output_formats[j];
+				}
+			}
+		}
+	}
+
+	g_free (pixel_formats);
+
+	return found;
+}
+
 static gboolean
 gst_aravis_set_caps (GstBaseSrc *src, GstCaps *caps)
 {
 	GstAravis* gst_aravis = GST_ARAVIS(src);
 	GstStructure *structure;
 	ArvPixelFormat pixel_format;
+	ArvPixelFormat output_format;
 	int height, width;
-	int depth = 0, bpp = 0;
 	const GValue *frame_rate;
+	double actual_frame_rate;
 	const char *caps_string;
-	const char *format_string;
-	unsigned int i;
+	ArvDevice *device;
+	GError *error = NULL;
 
 	GST_LOG_OBJECT (gst_aravis, "Requested caps = %" GST_PTR_FORMAT, caps);
 
+	structure = gst_caps_get_structure (caps, 0);
+
+	if (!_find_pixel_format (gst_aravis, structure, &pixel_format, &output_format)) {
+		GST_ERROR_OBJECT (gst_aravis, "No camera pixel format for caps %" GST_PTR_FORMAT, caps);
+		return FALSE;
+	}
+
+	GST_DEBUG_OBJECT (gst_aravis, "Pixel format 0x%08x, output as 0x%08x", pixel_format, output_format);
+
 	arv_camera_stop_acquisition (gst_aravis->camera, NULL);
 
 	if (gst_aravis->stream != NULL)
 		g_object_unref (gst_aravis->stream);
 
-	structure = gst_caps_get_structure (caps, 0);
-
 	arv_camera_get_region (gst_aravis->camera, NULL, NULL, &width, &height, NULL);
 
 	gst_structure_get_int (structure, "width", &width);
 	gst_structure_get_int (structure, "height", &height);
-	gst_structure_get_int (structure, "depth", &depth);
-	gst_structure_get_int (structure, "bpp", &bpp);
 	frame_rate = gst_structure_get_value (structure, "framerate");
-	format_string = gst_structure_get_string (structure, "format");
-
-	pixel_format = arv_pixel_format_from_gst_caps (gst_structure_get_name (structure), format_string, bpp, depth);
 
 	arv_camera_set_region (gst_aravis->camera, gst_aravis->offset_x, gst_aravis->offset_y, width, height, NULL);
 	arv_camera_set_binning (gst_aravis->camera, gst_aravis->h_binning, gst_aravis->v_binning, NULL);
@@ -234,7 +454,7 @@ gst_aravis_set_caps (GstBaseSrc *src, GstCaps *caps)
 	if (gst_aravis->fixed_caps != NULL)
 		gst_caps_unref (gst_aravis->fixed_caps);
 
-	caps_string = arv_pixel_format_to_gst_caps_string (pixel_format);
+	caps_string = arv_pixel_format_to_gst_caps_string (output_format);
 	if (caps_string != NULL) {
 		GstStructure *structure;
 		GstCaps *caps;
@@ -255,6 +475,14 @@ gst_aravis_set_caps (GstBaseSrc *src, GstCaps *caps)
 	} else
 		gst_aravis->fixed_caps = NULL;
 
+	g_clear_object (&gst_aravis->converter);
+	gst_aravis->converter = _create_converter (pixel_format, output_format);
+	if (gst_aravis->converter == NULL) {
+		GST_ERROR_OBJECT (gst_aravis, "No conversion from 0x%08x to 0x%08x", pixel_format, output_format);
+		gst_aravis->stream = NULL;
+		return FALSE;
+	}
+
 	gst_aravis->payload = arv_camera_get_payload (gst_aravis->camera, NULL);
 	gst_aravis->stream = arv_camera_create_stream (gst_aravis->camera, NULL, NULL);
 
@@ -265,10 +493,22 @@ gst_aravis_set_caps (GstBaseSrc *src, GstCaps *caps)
 			g_object_set (gst_aravis->stream, "packet-resend", ARV_GV_STREAM_PACKET_RESEND_NEVER, NULL);
 	}
 
+	/* The stream buffers are allocated by the buffer pool, see gst_aravis_decide_allocation() */
+
+	/* GigE Vision devices sample their clock from the heartbeat thread, which allows a drift correction. Other
+	 * devices are only sampled once, for the clock offset. */
+	device = arv_camera_get_device (gst_aravis->camera);
+	gst_aravis->clock_model = arv_device_get_clock_model (device);
+	if (ARV_IS_GV_DEVICE (device))
+		arv_gv_device_set_clock_sampling (ARV_GV_DEVICE (device), TRUE);
+	else if (!arv_device_sample_clock (device, &error)) {
+		GST_DEBUG_OBJECT (gst_aravis, "Failed to sample device clock: %s", error->message);
+		g_clear_error (&error);
+	}
 
-	for (i = 0; i < gst_aravis->num_buffers; i++)
-		arv_stream_push_buffer (gst_aravis->stream,
-					arv_buffer_new (gst_aravis->payload, NULL));
+	actual_frame_rate = arv_camera_get_frame_rate (gst_aravis->camera, NULL);
+	gst_aravis_latency_set_frame_duration (&gst_aravis->latency, actual_frame_rate > 0.0 ?
+					       (GstClockTime) (GST_SECOND / actual_frame_rate) : GST_CLOCK_TIME_NONE);
 
 	GST_LOG_OBJECT (gst_aravis, "Start acquisition");
 	arv_camera_start_acquisition (gst_aravis->camera, NULL);
@@ -276,6 +516,9 @@ gst_aravis_set_caps (GstBaseSrc *src, GstCaps *caps)
 	gst_aravis->timestamp_offset = 0;
 	gst_aravis->last_timestamp = 0;
 
+	gst_aravis_latency_reset (&gst_aravis->latency);
+	gst_aravis->last_stats_time_us = g_get_monotonic_time ();
+
 	return TRUE;
 }
 
@@ -311,7 +554,7 @@ gst_aravis_start (GstBaseSrc *src)
 	if (gst_aravis->camera == NULL)
 		gst_aravis_init_camera (gst_aravis);
 
-	gst_aravis->all_caps = gst_aravis_get_all_camera_caps (gst_aravis);
+	_update_all_caps (gst_aravis);
 
 	return TRUE;
 }
@@ -320,14 +563,20 @@ gst_aravis_start (GstBaseSrc *src)
 gboolean gst_aravis_stop( GstBaseSrc * src )
 {
         GstAravis* gst_aravis = GST_ARAVIS(src);
+	ArvDevice *device;
 
 	arv_camera_stop_acquisition (gst_aravis->camera, NULL);
 
+	device = arv_camera_get_device (gst_aravis->camera);
+	if (ARV_IS_GV_DEVICE (device))
+		arv_gv_device_set_clock_sampling (ARV_GV_DEVICE (device), FALSE);
+
 	if (gst_aravis->stream != NULL) {
 		g_object_unref (gst_aravis->stream);
 		gst_aravis->stream = NULL;
 
 	}
+	g_clear_object (&gst_aravis->converter);
 	if (gst_aravis->all_caps != NULL) {
 		gst_caps_unref (gst_aravis->all_caps);
 		gst_aravis->all_caps = NULL;
@@ -359,66 +608,216 @@ gst_aravis_get_times (GstBaseSrc * basesrc, GstBuffer * buffer,
 	}
 }
 
+/* The pool size is the maximum of the num-buffers property, and of the number of buffers downstream elements may
+ * hold, plus 2 for the camera being filling one and the next one. */
+
+static gboolean
+gst_aravis_decide_allocation (GstBaseSrc *src, GstQuery *query)
+{
+	GstAravis *gst_aravis = GST_ARAVIS (src);
+	GstBufferPool *pool;
+	GstStructure *config;
+	GstCaps *caps;
+	guint size = 0, min = 0, max = 0;
+	guint n_buffers;
+	gint height;
+
+	if (gst_aravis->stream == NULL)
+		return FALSE;
+
+	gst_query_parse_allocation (query, &caps, NULL);
+
+	if (gst_query_get_n_allocation_pools (query) > 0)
+		gst_query_parse_nth_allocation_pool (query, 0, NULL, &size, &min, &max);
+
+	n_buffers = MAX ((guint) gst_aravis->num_buffers, min + 2);
+
+	arv_camera_get_region (gst_aravis->camera, NULL, NULL, NULL, &height, NULL);
+
+	pool = gst_aravis_buffer_pool_new (gst_aravis->stream, gst_aravis->payload, height,
+					   gst_aravis->buffer_timeout_us);
+	size = gst_aravis_buffer_pool_get_buffer_size (GST_ARAVIS_BUFFER_POOL (pool));
+
+	config = gst_buffer_pool_get_config (pool);
+	gst_buffer_pool_config_set_params (config, caps, size, n_buffers, n_buffers);
+	if (!gst_buffer_pool_set_config (pool, config)) {
+		GST_ERROR_OBJECT (gst_aravis, "Failed to configure the buffer pool");
+		gst_object_unref (pool);
+		return FALSE;
+	}
+
+	GST_DEBUG_OBJECT (gst_aravis, "Buffer pool of %u buffers of %u bytes (downstream min = %u)",
+			  n_buffers, size, min);
+
+	if (gst_query_get_n_allocation_pools (query) > 0)
+		gst_query_set_nth_allocation_pool (query, 0, pool, size, n_buffers, n_buffers);
+	else
+		gst_query_add_allocation_pool (query, pool, size, n_buffers, n_buffers);
+
+	gst_object_unref (pool);
+
+	return TRUE;
+}
+
+static void
+_add_latency_sample (GstAravis *gst_aravis, GstClockTime latency)
+{
+	if (gst_aravis_latency_add_sample (&gst_aravis->latency, latency)) {
+		GST_DEBUG_OBJECT (gst_aravis, "Latency changed");
+		gst_element_post_message (GST_ELEMENT (gst_aravis), gst_message_new_latency (GST_OBJECT (gst_aravis)));
+	}
+}
+
+static void
+_post_statistics (GstAravis *gst_aravis)
+{
+	GstStructure *structure;
+	GstClockTime min_latency = 0, max_latency = 0;
+	guint64 n_completed_buffers = 0;
+	guint64 n_failures = 0;
+	guint64 n_underruns = 0;
+
+	arv_stream_get_statistics (gst_aravis->stream, &n_completed_buffers, &n_failures, &n_underruns);
+
+	gst_aravis_latency_get_bounds (&gst_aravis->latency, &min_latency, &max_latency);
+
+	structure = gst_structure_new ("aravissrc-statistics",
+				       "completed-buffers", G_TYPE_UINT64, n_completed_buffers,
+				       "failures", G_TYPE_UINT64, n_failures,
+				       "underruns", G_TYPE_UINT64, n_underruns,
+				       "min-latency", G_TYPE_UINT64, min_latency,
+				       "max-latency", G_TYPE_UINT64, max_latency,
+				       NULL);
+
+	gst_element_post_message (GST_ELEMENT (gst_aravis),
+				  gst_message_new_element (GST_OBJECT (gst_aravis), structure));
+}
+
+static gboolean
+gst_aravis_query (GstBaseSrc *src, GstQuery *query)
+{
+	GstAravis *gst_aravis = GST_ARAVIS (src);
+
+	if (GST_QUERY_TYPE (query) == GST_QUERY_LATENCY) {
+		GstClockTime min_latency, max_latency;
+
+		if (gst_aravis_latency_query (&gst_aravis->latency, gst_aravis->num_buffers,
+					      &min_latency, &max_latency)) {
+			GST_DEBUG_OBJECT (gst_aravis, "Report latency %" GST_TIME_FORMAT " - %" GST_TIME_FORMAT,
+					  GST_TIME_ARGS (min_latency), GST_TIME_ARGS (max_latency));
+			gst_query_set_latency (query, TRUE, min_latency, max_latency);
+			return TRUE;
+		}
+	}
+
+	return GST_BASE_SRC_CLASS (gst_aravis_parent_class)->query (src, query);
+}
+
 static GstFlowReturn
 gst_aravis_create (GstPushSrc * push_src, GstBuffer ** buffer)
 {
 	GstAravis *gst_aravis;
+	GstBufferPool *pool;
+	GstFlowReturn result;
 	ArvBuffer *arv_buffer;
 	int arv_row_stride;
 	int width, height;
-	char *buffer_data;
-	size_t buffer_size;
 	guint64 timestamp_ns;
+	guint64 exposure_end_ns;
+	guint64 completion_ns;
 
 	gst_aravis = GST_ARAVIS (push_src);
 
-	do {
-		arv_buffer = arv_stream_timeout_pop_buffer (gst_aravis->stream, gst_aravis->buffer_timeout_us);
-		if (arv_buffer != NULL && arv_buffer_get_status (arv_buffer) != ARV_BUFFER_STATUS_SUCCESS)
-			arv_stream_push_buffer (gst_aravis->stream, arv_buffer);
-	} while (arv_buffer != NULL && arv_buffer_get_status (arv_buffer) != ARV_BUFFER_STATUS_SUCCESS);
-
-	if (arv_buffer == NULL)
+	pool = gst_base_src_get_buffer_pool (GST_BASE_SRC (push_src));
+	if (pool == NULL)
 		return GST_FLOW_ERROR;
 
-	buffer_data = (char *) arv_buffer_get_data (arv_buffer, &buffer_size);
+	/* The buffer returns its ArvBuffer to the stream when released by the downstream elements */
+	result = gst_buffer_pool_acquire_buffer (pool, buffer, NULL);
+	gst_object_unref (pool);
+	if (result != GST_FLOW_OK)
+		return result;
+
+	arv_buffer = gst_aravis_buffer_pool_get_arv_buffer (*buffer);
+
 	arv_buffer_get_image_region (arv_buffer, NULL, NULL, &width, &height);
-	arv_row_stride = width * ARV_PIXEL_FORMAT_BIT_PER_PIXEL (arv_buffer_get_image_pixel_format (arv_buffer)) / 8;
+	arv_row_stride = arv_buffer_get_image_row_stride (arv_buffer);
 	timestamp_ns = arv_buffer_get_timestamp (arv_buffer);
-
-	/* Gstreamer requires row stride to be a multiple of 4 */
-	if ((arv_row_stride & 0x3) != 0) {
+	completion_ns = arv_buffer_get_completion_timestamp (arv_buffer);
+
+	/* The buffer timestamp is taken as the end of the exposure. Without a device clock model, the arrival of the
+	 * first packet is used instead. */
+	exposure_end_ns = 0;
+	if (gst_aravis->clock_model != NULL)
+		exposure_end_ns = arv_clock_model_get_host_timestamp (gst_aravis->clock_model, timestamp_ns);
+	if (exposure_end_ns == 0)
+		exposure_end_ns = arv_buffer_get_system_timestamp (arv_buffer);
+
+	_add_latency_sample (gst_aravis, completion_ns > exposure_end_ns ? completion_ns - exposure_end_ns : 0);
+
+	/* The image is converted to the negotiated format in a separate buffer, and the pooled buffer goes back to
+	 * the stream right away. Gstreamer also requires row stride to be a multiple of 4, which is only false if the
+	 * rows could not be padded during reception. */
+	if (arv_converter_get_n_steps (gst_aravis->converter) > 0 || (arv_row_stride & 0x3) != 0) {
 		int gst_row_stride;
+		GError *error = NULL;
 		size_t size;
 		void *data;
-		int i;
 
-		gst_row_stride = (arv_row_stride & ~(0x3)) + 4;
+		gst_row_stride = width *
+			ARV_PIXEL_FORMAT_BIT_PER_PIXEL (arv_converter_get_output_format (gst_aravis->converter)) / 8;
+		gst_row_stride = (gst_row_stride + 3) & ~(0x3);
 
 		size = height * gst_row_stride;
 		data = g_malloc (size);
 
-		for (i = 0; i < height; i++)
-			memcpy (((char *) data) + i * gst_row_stride, buffer_data + i * arv_row_stride, arv_row_stride);
+		if (!arv_converter_process (gst_aravis->converter, arv_buffer_get_data (arv_buffer, NULL),
+					    arv_row_stride, width, height, data, gst_row_stride, &error)) {
+			GST_ELEMENT_ERROR (gst_aravis, STREAM, FAILED, ("Image conversion failed"), ("%s", error->message));
+			g_clear_error (&error);
+			g_free (data);
+			gst_buffer_unref (*buffer);
+			*buffer = NULL;
+			return GST_FLOW_ERROR;
+		}
 
+		gst_buffer_unref (*buffer);
 		*buffer = gst_buffer_new_wrapped (data, size);
-	} else {
-		*buffer = gst_buffer_new_wrapped_full (0, buffer_data, buffer_size, 0, buffer_size, NULL, NULL);
 	}
 
 	if (!gst_base_src_get_do_timestamp(GST_BASE_SRC(push_src))) {
-		if (gst_aravis->timestamp_offset == 0) {
-			gst_aravis->timestamp_offset = timestamp_ns;
-			gst_aravis->last_timestamp = timestamp_ns;
-		}
+		GstClockTime running_time;
+
+		running_time = gst_aravis_get_running_time (GST_ELEMENT (gst_aravis), exposure_end_ns);
+
+		if (GST_CLOCK_TIME_IS_VALID (running_time)) {
+			if (gst_aravis->last_timestamp == 0)
+				gst_aravis->last_timestamp = running_time;
+
+			GST_BUFFER_PTS (*buffer) = running_time;
+			GST_BUFFER_DURATION (*buffer) = running_time > gst_aravis->last_timestamp ?
+				running_time - gst_aravis->last_timestamp : 0;
+
+			gst_aravis->last_timestamp = running_time;
+		} else {
+			/* No pipeline clock, timestamps relative to the first frame */
+			if (gst_aravis->timestamp_offset == 0) {
+				gst_aravis->timestamp_offset = timestamp_ns;
+				gst_aravis->last_timestamp = timestamp_ns;
+			}
 
-		GST_BUFFER_PTS (*buffer) = timestamp_ns - gst_aravis->timestamp_offset;
-		GST_BUFFER_DURATION (*buffer) = timestamp_ns - gst_aravis->last_timestamp;
+			GST_BUFFER_PTS (*buffer) = timestamp_ns - gst_aravis->timestamp_offset;
+			GST_BUFFER_DURATION (*buffer) = timestamp_ns - gst_aravis->last_timestamp;
 
-		gst_aravis->last_timestamp = timestamp_ns;
+			gst_aravis->last_timestamp = timestamp_ns;
+		}
 	}
 
-	arv_stream_push_buffer (gst_aravis->stream, arv_buffer);
+	if (gst_aravis->stats_interval_ms > 0 &&
+	    g_get_monotonic_time () - gst_aravis->last_stats_time_us >= (gint64) gst_aravis->stats_interval_ms * 1000) {
+		gst_aravis->last_stats_time_us = g_get_monotonic_time ();
+		_post_statistics (gst_aravis);
+	}
 
 	return GST_FLOW_OK;
 }
@@ -474,7 +873,12 @@ gst_aravis_init (GstAravis *gst_aravis)
 	gst_aravis->stream = NULL;
 
 	gst_aravis->all_caps = NULL;
+	gst_aravis->all_caps_change_count = 0;
 	gst_aravis->fixed_caps = NULL;
+
+	gst_aravis->clock_model = NULL;
+	gst_aravis_latency_init (&gst_aravis->latency);
+	gst_aravis->stats_interval_ms = 0;
 }
 
 static void
@@ -490,6 +894,7 @@ gst_aravis_finalize (GObject * object)
 		g_object_unref (gst_aravis->stream);
 		gst_aravis->stream = NULL;
 	}
+	g_clear_object (&gst_aravis->converter);
 	if (gst_aravis->all_caps != NULL) {
 		gst_caps_unref (gst_aravis->all_caps);
 		gst_aravis->all_caps = NULL;
@@ -502,6 +907,8 @@ gst_aravis_finalize (GObject * object)
 	g_free (gst_aravis->camera_name);
 	gst_aravis->camera_name = NULL;
 
+	gst_aravis_latency_clear (&gst_aravis->latency);
+
         G_OBJECT_CLASS (gst_aravis_parent_class)->finalize (object);
 }
 
@@ -568,6 +975,9 @@ gst_aravis_set_property (GObject * object, guint prop_id,
                 case PROP_NUM_BUFFERS:
                         gst_aravis->num_buffers = g_value_get_int (value);
                         break;
+		case PROP_STATS_INTERVAL:
+			gst_aravis->stats_interval_ms = g_value_get_uint (value);
+			break;
 		default:
 			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
 			break;
@@ -623,6 +1033,9 @@ gst_aravis_get_property (GObject * object, guint prop_id, GValue * value,
         	case PROP_NUM_BUFFERS:
                         g_value_set_int (value, gst_aravis->num_buffers);
                         break;
+		case PROP_STATS_INTERVAL:
+			g_value_set_uint (value, gst_aravis->stats_interval_ms);
+			break;
 		default:
 			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
 			break;
@@ -754,6 +1167,14 @@ gst_aravis_class_init (GstAravisClass * klass)
                                    "Number of video buffers to allocate for video frames",
                                    1, G_MAXINT, GST_ARAVIS_DEFAULT_N_BUFFERS,
                                    G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+	g_object_class_install_property
+		(gobject_class,
+		 PROP_STATS_INTERVAL,
+		 g_param_spec_uint ("stats-interval",
+				    "Statistics Interval",
+				    "Interval between stream statistics messages on the bus, in ms (0 = disabled)",
+				    0, G_MAXUINT, 0,
+				    G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
         GST_DEBUG_CATEGORY_INIT (aravis_debug, "aravissrc", 0, "Aravis interface");
 
@@ -770,6 +1191,8 @@ gst_aravis_class_init (GstAravisClass * klass)
 	gstbasesrc_class->fixate = gst_aravis_fixate_caps;
 	gstbasesrc_class->start = gst_aravis_start;
 	gstbasesrc_class->stop = gst_aravis_stop;
+	gstbasesrc_class->decide_allocation = gst_aravis_decide_allocation;
+	gstbasesrc_class->query = gst_aravis_query;
 
 	gstbasesrc_class->get_times = gst_aravis_get_times;
 
@@ -779,7 +1202,8 @@ gst_aravis_class_init (GstAravisClass * klass)
 static gboolean
 plugin_init (GstPlugin * plugin)
 {
-        return gst_element_register (plugin, "aravissrc", GST_RANK_NONE, GST_TYPE_ARAVIS);
+        return gst_element_register (plugin, "aravissrc", GST_RANK_NONE, GST_TYPE_ARAVIS) &&
+		gst_element_register (plugin, "aravismultisrc", GST_RANK_NONE, GST_TYPE_ARAVIS_MULTI_SRC);
 }
 
 #define PACKAGE "aravis"
@@ -26,6 +26,7 @@
 #include <gst/gst.h>
 #include <gst/base/gstpushsrc.h>
 #include <arv.h>
+#include <gstaravislatency.h>
 
 G_BEGIN_DECLS
 
@@ -66,12 +67,23 @@ struct _GstAravis {
 
 	ArvCamera *camera;
 	ArvStream *stream;
+	ArvConverter *converter;
 
 	GstCaps *all_caps;
+	guint64 all_caps_change_count;
 	GstCaps *fixed_caps;
 
 	guint64 timestamp_offset;
 	guint64 last_timestamp;
+
+	/* Device to host time conversion, owned by the camera device */
+	ArvClockModel *clock_model;
+
+	/* Exposure end to buffer completion durations */
+	GstAravisLatency latency;
+
+	guint stats_interval_ms;
+	gint64 last_stats_time_us;
 };
 
 struct _GstAravisClass {
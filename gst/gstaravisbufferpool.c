@@ -0,0 +1,261 @@
+/*
+ * Copyright © 2010-2019 Emmanuel Pacaud <emmanuel@gnome.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Buffer pool of aravissrc. Each GstBuffer wraps the data of an ArvBuffer, which is handed to the stream while the
+ * GstBuffer is released to the pool, and popped from the stream when the GstBuffer is acquired. Downstream elements
+ * thus read the camera data without any copy, and the camera can not overwrite data still in use.
+ *
+ * Several pools may share the same stream during a renegotiation, as the new pool is activated before the old one is
+ * deactivated. Each ArvBuffer is tagged with its pool, and a pool only hands out its own buffers. The ArvBuffers of a
+ * stopped pool stay in the stream, which owns them from then on, and are dropped by the next acquisition. */
+
+#include <gstaravisbufferpool.h>
+
+/* Row alignment required by the default GStreamer video layout */
+#define GST_ARAVIS_BUFFER_POOL_ROW_ALIGNMENT	4
+
+GST_DEBUG_CATEGORY_STATIC (aravis_buffer_pool_debug);
+#define GST_CAT_DEFAULT aravis_buffer_pool_debug
+
+G_DEFINE_TYPE (GstAravisBufferPool, gst_aravis_buffer_pool, GST_TYPE_BUFFER_POOL);
+
+static GQuark
+_gst_buffer_quark (void)
+{
+	return g_quark_from_static_string ("gst-aravis-gst-buffer");
+}
+
+static GQuark
+_pool_quark (void)
+{
+	return g_quark_from_static_string ("gst-aravis-buffer-pool");
+}
+
+static GQuark
+_arv_buffer_quark (void)
+{
+	return g_quark_from_static_string ("gst-aravis-arv-buffer");
+}
+
+/**
+ * gst_aravis_buffer_pool_get_arv_buffer:
+ * @buffer: a #GstBuffer acquired from a #GstAravisBufferPool
+ *
+ * Returns: (transfer none): the #ArvBuffer holding the data of @buffer, or %NULL.
+ */
+
+ArvBuffer *
+gst_aravis_buffer_pool_get_arv_buffer (GstBuffer *buffer)
+{
+	g_return_val_if_fail (GST_IS_BUFFER (buffer), NULL);
+
+	return gst_mini_object_get_qdata (GST_MINI_OBJECT (buffer), _arv_buffer_quark ());
+}
+
+size_t
+gst_aravis_buffer_pool_get_buffer_size (GstAravisBufferPool *pool)
+{
+	g_return_val_if_fail (GST_IS_ARAVIS_BUFFER_POOL (pool), 0);
+
+	return pool->payload + (size_t) pool->height * (GST_ARAVIS_BUFFER_POOL_ROW_ALIGNMENT - 1);
+}
+
+static GstFlowReturn
+gst_aravis_buffer_pool_alloc_buffer (GstBufferPool *pool, GstBuffer **buffer, GstBufferPoolAcquireParams *params)
+{
+	GstAravisBufferPool *self = GST_ARAVIS_BUFFER_POOL (pool);
+	ArvBuffer *arv_buffer;
+	size_t size;
+	void *data;
+
+	arv_buffer = arv_buffer_new_padded (self->payload, self->height, GST_ARAVIS_BUFFER_POOL_ROW_ALIGNMENT);
+	if (arv_buffer == NULL)
+		return GST_FLOW_ERROR;
+
+	size = gst_aravis_buffer_pool_get_buffer_size (self);
+	data = (void *) arv_buffer_get_data (arv_buffer, NULL);
+
+	/* The memory owns the ArvBuffer reference */
+	*buffer = gst_buffer_new_wrapped_full (0, data, size, 0, size, arv_buffer, g_object_unref);
+
+	gst_mini_object_set_qdata (GST_MINI_OBJECT (*buffer), _arv_buffer_quark (), arv_buffer, NULL);
+	g_object_set_qdata (G_OBJECT (arv_buffer), _gst_buffer_quark (), *buffer);
+	g_object_set_qdata (G_OBJECT (arv_buffer), _pool_quark (), self);
+
+	g_mutex_lock (&self->mutex);
+	g_ptr_array_add (self->buffers, *buffer);
+	g_mutex_unlock (&self->mutex);
+
+	GST_LOG_OBJECT (pool, "Allocated buffer %p of %" G_GSIZE_FORMAT " bytes", *buffer, size);
+
+	return GST_FLOW_OK;
+}
+
+static GstFlowReturn
+gst_aravis_buffer_pool_acquire_buffer (GstBufferPool *pool, GstBuffer **buffer, GstBufferPoolAcquireParams *params)
+{
+	GstAravisBufferPool *self = GST_ARAVIS_BUFFER_POOL (pool);
+	ArvBuffer *arv_buffer;
+	size_t size;
+
+	if (GST_BUFFER_POOL_IS_FLUSHING (pool) || !gst_buffer_pool_is_active (pool))
+		return GST_FLOW_FLUSHING;
+
+	for (;;) {
+		arv_buffer = arv_stream_timeout_pop_buffer (self->stream, self->timeout_us);
+		if (arv_buffer == NULL)
+			return GST_BUFFER_POOL_IS_FLUSHING (pool) ? GST_FLOW_FLUSHING : GST_FLOW_ERROR;
+
+		if (g_object_get_qdata (G_OBJECT (arv_buffer), _pool_quark ()) != self) {
+			/* Buffer of another pool sharing the stream. Its GstBuffer is not ours to hand out, drop the
+			 * stream reference, the other pool still owns it if it is not stopped yet. */
+			GST_LOG_OBJECT (pool, "Drop foreign buffer %p", arv_buffer);
+			g_object_unref (arv_buffer);
+			continue;
+		}
+
+		if (arv_buffer_get_status (arv_buffer) == ARV_BUFFER_STATUS_SUCCESS)
+			break;
+
+		arv_stream_push_buffer (self->stream, arv_buffer);
+	}
+
+	*buffer = g_object_get_qdata (G_OBJECT (arv_buffer), _gst_buffer_quark ());
+	if (*buffer == NULL) {
+		arv_stream_push_buffer (self->stream, arv_buffer);
+		return GST_FLOW_ERROR;
+	}
+
+	arv_buffer_get_data (arv_buffer, &size);
+	gst_buffer_resize (*buffer, 0, size);
+
+	/* Drop the reference held by the stream, the buffer memory still owns one */
+	g_object_unref (arv_buffer);
+
+	return GST_FLOW_OK;
+}
+
+static void
+gst_aravis_buffer_pool_release_buffer (GstBufferPool *pool, GstBuffer *buffer)
+{
+	GstAravisBufferPool *self = GST_ARAVIS_BUFFER_POOL (pool);
+	ArvBuffer *arv_buffer;
+
+	arv_buffer = gst_aravis_buffer_pool_get_arv_buffer (buffer);
+	g_return_if_fail (ARV_IS_BUFFER (arv_buffer));
+
+	if (!gst_buffer_pool_is_active (pool)) {
+		/* Late release of a deactivated pool, keep the buffer out of the stream and let the parent class
+		 * destroy it */
+		g_mutex_lock (&self->mutex);
+		g_ptr_array_remove_fast (self->buffers, buffer);
+		g_mutex_unlock (&self->mutex);
+
+		GST_BUFFER_POOL_CLASS (gst_aravis_buffer_pool_parent_class)->release_buffer (pool, buffer);
+		return;
+	}
+
+	arv_stream_push_buffer (self->stream, g_object_ref (arv_buffer));
+}
+
+static gboolean
+gst_aravis_buffer_pool_stop (GstBufferPool *pool)
+{
+	GstAravisBufferPool *self = GST_ARAVIS_BUFFER_POOL (pool);
+	guint i;
+
+	/* The remaining buffers were released to the stream, which may be shared with a newer pool and must not be
+	 * flushed. Disown their ArvBuffer, whose last reference is now held by the stream, and hand the GstBuffers to
+	 * the parent class, for their destruction. */
+	g_mutex_lock (&self->mutex);
+	for (i = 0; i < self->buffers->len; i++) {
+		GstBuffer *buffer = g_ptr_array_index (self->buffers, i);
+		ArvBuffer *arv_buffer = gst_aravis_buffer_pool_get_arv_buffer (buffer);
+
+		g_object_set_qdata (G_OBJECT (arv_buffer), _pool_quark (), NULL);
+		g_object_set_qdata (G_OBJECT (arv_buffer), _gst_buffer_quark (), NULL);
+
+		GST_BUFFER_POOL_CLASS (gst_aravis_buffer_pool_parent_class)->release_buffer (pool, buffer);
+	}
+	g_ptr_array_set_size (self->buffers, 0);
+	g_mutex_unlock (&self->mutex);
+
+	return GST_BUFFER_POOL_CLASS (gst_aravis_buffer_pool_parent_class)->stop (pool);
+}
+
+/**
+ * gst_aravis_buffer_pool_new:
+ * @stream: the #ArvStream filling the buffers
+ * @payload: camera payload size, in bytes
+ * @height: image height, in rows
+ * @timeout_us: timeout of buffer acquisition, in µs
+ *
+ * Returns: a new #GstAravisBufferPool, with rows padded to a multiple of 4 bytes.
+ */
+
+GstBufferPool *
+gst_aravis_buffer_pool_new (ArvStream *stream, size_t payload, guint height, guint64 timeout_us)
+{
+	GstAravisBufferPool *pool;
+
+	g_return_val_if_fail (ARV_IS_STREAM (stream), NULL);
+
+	pool = g_object_new (GST_TYPE_ARAVIS_BUFFER_POOL, NULL);
+	pool->stream = g_object_ref (stream);
+	pool->payload = payload;
+	pool->height = height;
+	pool->timeout_us = timeout_us;
+
+	return GST_BUFFER_POOL (pool);
+}
+
+static void
+gst_aravis_buffer_pool_init (GstAravisBufferPool *pool)
+{
+	g_mutex_init (&pool->mutex);
+	pool->buffers = g_ptr_array_new ();
+}
+
+static void
+gst_aravis_buffer_pool_finalize (GObject *object)
+{
+	GstAravisBufferPool *pool = GST_ARAVIS_BUFFER_POOL (object);
+
+	g_ptr_array_unref (pool->buffers);
+	g_mutex_clear (&pool->mutex);
+	g_clear_object (&pool->stream);
+
+	G_OBJECT_CLASS (gst_aravis_buffer_pool_parent_class)->finalize (object);
+}
+
+static void
+gst_aravis_buffer_pool_class_init (GstAravisBufferPoolClass *klass)
+{
+	GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+	GstBufferPoolClass *buffer_pool_class = GST_BUFFER_POOL_CLASS (klass);
+
+	gobject_class->finalize = gst_aravis_buffer_pool_finalize;
+
+	buffer_pool_class->alloc_buffer = gst_aravis_buffer_pool_alloc_buffer;
+	buffer_pool_class->acquire_buffer = gst_aravis_buffer_pool_acquire_buffer;
+	buffer_pool_class->release_buffer = gst_aravis_buffer_pool_release_buffer;
+	buffer_pool_class->stop = gst_aravis_buffer_pool_stop;
+
+	GST_DEBUG_CATEGORY_INIT (aravis_buffer_pool_debug, "aravisbufferpool", 0, "Aravis buffer pool");
+}
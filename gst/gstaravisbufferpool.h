@@ -0,0 +1,61 @@
+/*
+ * Copyright © 2010-2019 Emmanuel Pacaud <emmanuel@gnome.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef GST_ARAVIS_BUFFER_POOL_H
+#define GST_ARAVIS_BUFFER_POOL_H
+
+#include <gst/gst.h>
+#include <arv.h>
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_ARAVIS_BUFFER_POOL 		(gst_aravis_buffer_pool_get_type())
+#define GST_ARAVIS_BUFFER_POOL(obj)		(G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_ARAVIS_BUFFER_POOL,GstAravisBufferPool))
+#define GST_IS_ARAVIS_BUFFER_POOL(obj) 		(G_TYPE_CHECK_INSTANCE_TYPE((obj),GST_TYPE_ARAVIS_BUFFER_POOL))
+
+typedef struct _GstAravisBufferPool GstAravisBufferPool;
+typedef struct _GstAravisBufferPoolClass GstAravisBufferPoolClass;
+
+struct _GstAravisBufferPool {
+	GstBufferPool pool;
+
+	ArvStream *stream;
+
+	size_t payload;
+	guint height;
+	guint64 timeout_us;
+
+	GMutex mutex;
+	GPtrArray *buffers;
+};
+
+struct _GstAravisBufferPoolClass {
+	GstBufferPoolClass parent_class;
+};
+
+GType 		gst_aravis_buffer_pool_get_type 	(void);
+
+GstBufferPool *	gst_aravis_buffer_pool_new 		(ArvStream *stream, size_t payload, guint height,
+							 guint64 timeout_us);
+size_t		gst_aravis_buffer_pool_get_buffer_size	(GstAravisBufferPool *pool);
+ArvBuffer *	gst_aravis_buffer_pool_get_arv_buffer	(GstBuffer *buffer);
+
+G_END_DECLS
+
+#endif
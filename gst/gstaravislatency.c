@@ -0,0 +1,220 @@
+/*
+ * Copyright © 2010-2019 Emmanuel Pacaud <emmanuel@gnome.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Latency tracking shared by aravissrc and aravismultisrc. The latency of the last frames is kept in a sliding
+ * window. The pipeline is asked for a new latency configuration when the maximum of the window exceeds the reported
+ * latency, such that a single late frame only raises the latency until it leaves the window. */
+
+#include <gstaravislatency.h>
+
+void
+gst_aravis_latency_init (GstAravisLatency *latency)
+{
+	g_mutex_init (&latency->mutex);
+
+	latency->n_samples = 0;
+	latency->index = 0;
+	latency->reported_latency = GST_CLOCK_TIME_NONE;
+	latency->frame_duration = GST_CLOCK_TIME_NONE;
+}
+
+void
+gst_aravis_latency_clear (GstAravisLatency *latency)
+{
+	g_mutex_clear (&latency->mutex);
+}
+
+/* Forgets the measured latency, but not the frame duration */
+
+void
+gst_aravis_latency_reset (GstAravisLatency *latency)
+{
+	g_mutex_lock (&latency->mutex);
+	latency->n_samples = 0;
+	latency->index = 0;
+	latency->reported_latency = GST_CLOCK_TIME_NONE;
+	g_mutex_unlock (&latency->mutex);
+}
+
+void
+gst_aravis_latency_set_frame_duration (GstAravisLatency *latency, GstClockTime frame_duration)
+{
+	g_mutex_lock (&latency->mutex);
+	latency->frame_duration = frame_duration;
+	g_mutex_unlock (&latency->mutex);
+}
+
+GstClockTime
+gst_aravis_latency_get_frame_duration (GstAravisLatency *latency)
+{
+	GstClockTime frame_duration;
+
+	g_mutex_lock (&latency->mutex);
+	frame_duration = latency->frame_duration;
+	g_mutex_unlock (&latency->mutex);
+
+	return frame_duration;
+}
+
+/* Must be called with the mutex held */
+
+static gboolean
+_get_bounds (GstAravisLatency *latency, GstClockTime *min_latency, GstClockTime *max_latency)
+{
+	guint i;
+
+	if (latency->n_samples == 0)
+		return FALSE;
+
+	*min_latency = latency->samples[0];
+	*max_latency = latency->samples[0];
+	for (i = 1; i < latency->n_samples; i++) {
+		*min_latency = MIN (*min_latency, latency->samples[i]);
+		*max_latency = MAX (*max_latency, latency->samples[i]);
+	}
+
+	return TRUE;
+}
+
+/**
+ * gst_aravis_latency_add_sample:
+ * @latency: a #GstAravisLatency
+ * @sample: latency of the last frame
+ *
+ * Returns: %TRUE if the maximum measured latency exceeds the reported one, in which case the element must post a
+ * latency message.
+ */
+
+gboolean
+gst_aravis_latency_add_sample (GstAravisLatency *latency, GstClockTime sample)
+{
+	GstClockTime min_latency, max_latency;
+	gboolean is_changed;
+
+	g_mutex_lock (&latency->mutex);
+
+	latency->samples[latency->index] = sample;
+	latency->index = (latency->index + 1) % GST_ARAVIS_LATENCY_N_SAMPLES;
+	if (latency->n_samples < GST_ARAVIS_LATENCY_N_SAMPLES)
+		latency->n_samples++;
+
+	_get_bounds (latency, &min_latency, &max_latency);
+	is_changed = !GST_CLOCK_TIME_IS_VALID (latency->reported_latency) || max_latency > latency->reported_latency;
+	if (is_changed)
+		latency->reported_latency = max_latency;
+
+	g_mutex_unlock (&latency->mutex);
+
+	return is_changed;
+}
+
+/**
+ * gst_aravis_latency_get_bounds:
+ * @latency: a #GstAravisLatency
+ * @min_latency: (out): minimum latency of the last frames
+ * @max_latency: (out): maximum latency of the last frames
+ *
+ * Returns: %FALSE if no latency was measured yet.
+ */
+
+gboolean
+gst_aravis_latency_get_bounds (GstAravisLatency *latency, GstClockTime *min_latency, GstClockTime *max_latency)
+{
+	gboolean is_measured;
+
+	g_mutex_lock (&latency->mutex);
+	is_measured = _get_bounds (latency, min_latency, max_latency);
+	g_mutex_unlock (&latency->mutex);
+
+	return is_measured;
+}
+
+/**
+ * gst_aravis_latency_query:
+ * @latency: a #GstAravisLatency
+ * @n_buffers: number of frames the element can buffer before dropping
+ * @min_latency: (out): latency to report as minimum
+ * @max_latency: (out): latency to report as maximum
+ *
+ * Computes the latency of a LATENCY query answer. The minimum latency is the worst latency measured over the last
+ * frames, 0 if nothing was measured yet. The element can buffer up to @n_buffers frames before dropping, which gives
+ * the maximum latency, %GST_CLOCK_TIME_NONE if the frame duration is unknown.
+ *
+ * Returns: %FALSE if no latency was measured yet.
+ */
+
+gboolean
+gst_aravis_latency_query (GstAravisLatency *latency, guint n_buffers,
+			  GstClockTime *min_latency, GstClockTime *max_latency)
+{
+	GstClockTime measured_min_latency, measured_max_latency;
+	gboolean is_measured;
+
+	g_mutex_lock (&latency->mutex);
+
+	is_measured = _get_bounds (latency, &measured_min_latency, &measured_max_latency);
+	if (is_measured) {
+		latency->reported_latency = measured_max_latency;
+		*min_latency = measured_max_latency;
+	} else
+		*min_latency = 0;
+
+	if (GST_CLOCK_TIME_IS_VALID (latency->frame_duration))
+		*max_latency = *min_latency + n_buffers * latency->frame_duration;
+	else
+		*max_latency = GST_CLOCK_TIME_NONE;
+
+	g_mutex_unlock (&latency->mutex);
+
+	return is_measured;
+}
+
+/**
+ * gst_aravis_get_running_time:
+ * @element: a #GstElement
+ * @host_time_ns: a time, in host real time nanoseconds
+ *
+ * Converts @host_time_ns to the running time of the pipeline of @element, using the time elapsed since
+ * @host_time_ns, measured on both clocks.
+ *
+ * Returns: the running time, %GST_CLOCK_TIME_NONE if @element has no clock.
+ */
+
+GstClockTime
+gst_aravis_get_running_time (GstElement *element, guint64 host_time_ns)
+{
+	GstClock *clock;
+	GstClockTime clock_time;
+	GstClockTime base_time;
+	gint64 age_ns;
+
+	clock = gst_element_get_clock (element);
+	if (clock == NULL)
+		return GST_CLOCK_TIME_NONE;
+
+	clock_time = gst_clock_get_time (clock);
+	age_ns = MAX (g_get_real_time () * 1000LL - (gint64) host_time_ns, 0);
+	base_time = gst_element_get_base_time (element);
+
+	gst_object_unref (clock);
+
+	clock_time = clock_time > (GstClockTime) age_ns ? clock_time - age_ns : 0;
+
+	return clock_time > base_time ? clock_time - base_time : 0;
+}
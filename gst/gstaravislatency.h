@@ -0,0 +1,56 @@
+/*
+ * Copyright © 2010-2019 Emmanuel Pacaud <emmanuel@gnome.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef GST_ARAVIS_LATENCY_H
+#define GST_ARAVIS_LATENCY_H
+
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+#define GST_ARAVIS_LATENCY_N_SAMPLES	32
+
+typedef struct {
+	GMutex mutex;
+
+	/* Latency of the last frames */
+	GstClockTime samples[GST_ARAVIS_LATENCY_N_SAMPLES];
+	guint n_samples;
+	guint index;
+
+	GstClockTime reported_latency;
+	GstClockTime frame_duration;
+} GstAravisLatency;
+
+void		gst_aravis_latency_init			(GstAravisLatency *latency);
+void		gst_aravis_latency_clear		(GstAravisLatency *latency);
+void		gst_aravis_latency_reset		(GstAravisLatency *latency);
+void		gst_aravis_latency_set_frame_duration	(GstAravisLatency *latency, GstClockTime frame_duration);
+GstClockTime	gst_aravis_latency_get_frame_duration	(GstAravisLatency *latency);
+gboolean	gst_aravis_latency_add_sample		(GstAravisLatency *latency, GstClockTime sample);
+gboolean	gst_aravis_latency_get_bounds		(GstAravisLatency *latency,
+							 GstClockTime *min_latency, GstClockTime *max_latency);
+gboolean	gst_aravis_latency_query		(GstAravisLatency *latency, guint n_buffers,
+							 GstClockTime *min_latency, GstClockTime *max_latency);
+
+GstClockTime	gst_aravis_get_running_time		(GstElement *element, guint64 host_time_ns);
+
+G_END_DECLS
+
+#endif
@@ -0,0 +1,904 @@
+/*
+ * Copyright © 2010-2019 Emmanuel Pacaud <emmanuel@gnome.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/**
+ * SECTION:element-aravismultisrc
+ *
+ * Synchronized multi-camera source using the Aravis vision library
+ *
+ * The cameras are opened concurrently, triggered together, and their buffers are matched by timestamp. Each
+ * frame set is pushed on the per camera src_%u pads, with the same PTS on all pads.
+ *
+ * <refsect2>
+ * <title>Example launch line</title>
+ * |[
+ * gst-launch -v aravismultisrc name=src camera-names="Basler-21322519,Basler-21322520" trigger=action frame-rate=10
+ *     src.src_0 ! videoconvert ! autovideosink src.src_1 ! videoconvert ! autovideosink
+ * ]|
+ * </refsect2>
+ */
+
+#include <gstaravismultisrc.h>
+
+#define GST_ARAVIS_MULTI_SRC_DEFAULT_N_BUFFERS		20
+#define GST_ARAVIS_MULTI_SRC_DEFAULT_SYNC_TOLERANCE	1000000
+#define GST_ARAVIS_MULTI_SRC_ROW_ALIGNMENT		4
+#define GST_ARAVIS_MULTI_SRC_POP_TIMEOUT_US		100000
+#define GST_ARAVIS_MULTI_SRC_ACTION_TIMEOUT_MS		50
+
+GST_DEBUG_CATEGORY_STATIC (aravis_multi_src_debug);
+#define GST_CAT_DEFAULT aravis_multi_src_debug
+
+enum
+{
+  PROP_0,
+  PROP_CAMERA_NAMES,
+  PROP_TRIGGER,
+  PROP_FRAME_RATE,
+  PROP_SYNC_TOLERANCE,
+  PROP_ACTION_DEVICE_KEY,
+  PROP_ACTION_GROUP_KEY,
+  PROP_ACTION_GROUP_MASK,
+  PROP_NUM_BUFFERS
+};
+
+G_DEFINE_TYPE (GstAravisMultiSrc, gst_aravis_multi_src, GST_TYPE_ELEMENT);
+
+static GstStaticPadTemplate aravis_multi_src_template = GST_STATIC_PAD_TEMPLATE ("src_%u",
+										 GST_PAD_SRC,
+										 GST_PAD_SOMETIMES,
+										 GST_STATIC_CAPS ("ANY"));
+
+GType
+gst_aravis_multi_src_trigger_get_type (void)
+{
+	static gsize trigger_type = 0;
+	static const GEnumValue trigger_values[] = {
+		{GST_ARAVIS_MULTI_SRC_TRIGGER_NONE, "Free running cameras", "none"},
+		{GST_ARAVIS_MULTI_SRC_TRIGGER_SOFTWARE, "Software trigger", "software"},
+		{GST_ARAVIS_MULTI_SRC_TRIGGER_ACTION, "GigE Vision action command", "action"},
+		{0, NULL, NULL}
+	};
+
+	if (g_once_init_enter (&trigger_type)) {
+		GType type = g_enum_register_static ("GstAravisMultiSrcTrigger", trigger_values);
+
+		g_once_init_leave (&trigger_type, type);
+	}
+
+	return trigger_type;
+}
+
+typedef struct {
+	ArvStream *stream;
+	ArvBuffer *buffer;
+} GstAravisMultiSrcRelease;
+
+static void
+_release_arv_buffer (gpointer user_data)
+{
+	GstAravisMultiSrcRelease *release = user_data;
+
+	arv_stream_push_buffer (release->stream, release->buffer);
+	g_object_unref (release->stream);
+	g_free (release);
+}
+
+/* The returned buffer gives the ArvBuffer back to its stream when released by the downstream elements. On error,
+ * the ArvBuffer is given back immediately. */
+
+static GstBuffer *
+_wrap_arv_buffer (GstAravisMultiSrc *self, GstAravisMultiSrcSource *source, ArvBuffer *arv_buffer)
+{
+	GstAravisMultiSrcRelease *release;
+	const void *data;
+	size_t row_stride;
+	size_t size;
+	int width, height;
+
+	arv_buffer_get_image_region (arv_buffer, NULL, NULL, &width, &height);
+	row_stride = arv_buffer_get_image_row_stride (arv_buffer);
+	data = arv_buffer_get_data (arv_buffer, &size);
+
+	/* Gstreamer requires row stride to be a multiple of 4, which is only false if the rows could not be padded
+	 * during reception */
+	if ((row_stride & 0x3) != 0) {
+		size_t gst_row_stride;
+		size_t gst_size;
+		GError *error = NULL;
+		void *gst_data;
+
+		gst_row_stride = (row_stride & ~(0x3)) + 4;
+		gst_size = height * gst_row_stride;
+		gst_data = g_malloc (gst_size);
+
+		if (!arv_converter_process (source->converter, data, row_stride, width, height,
+					    gst_data, gst_row_stride, &error)) {
+			GST_ELEMENT_ERROR (self, STREAM, FAILED, ("Image conversion failed"), ("%s", error->message));
+			g_clear_error (&error);
+			g_free (gst_data);
+			arv_stream_push_buffer (source->stream, g_object_ref (arv_buffer));
+			return NULL;
+		}
+
+		arv_stream_push_buffer (source->stream, g_object_ref (arv_buffer));
+
+		return gst_buffer_new_wrapped (gst_data, gst_size);
+	}
+
+	release = g_new (GstAravisMultiSrcRelease, 1);
+	release->stream = g_object_ref (source->stream);
+	release->buffer = g_object_ref (arv_buffer);
+
+	return gst_buffer_new_wrapped_full (GST_MEMORY_FLAG_READONLY, (gpointer) data, size,
+					    0, MIN (size, row_stride * height), release, _release_arv_buffer);
+}
+
+/* The buffers are late by the frame set age */
+
+static void
+_update_latency (GstAravisMultiSrc *self, guint64 timestamp_ns)
+{
+	GstClockTime age_ns;
+
+	age_ns = MAX (g_get_real_time () * 1000LL - (gint64) timestamp_ns, 0);
+
+	if (gst_aravis_latency_add_sample (&self->latency, age_ns)) {
+		GST_DEBUG_OBJECT (self, "Latency changed");
+		gst_element_post_message (GST_ELEMENT (self), gst_message_new_latency (GST_OBJECT (self)));
+	}
+}
+
+static void
+_push_initial_events (GstAravisMultiSrc *self, GstAravisMultiSrcSource *source, guint index, guint group_id)
+{
+	GstSegment segment;
+	GstEvent *event;
+	char *stream_id;
+
+	stream_id = gst_pad_create_stream_id_printf (source->pad, GST_ELEMENT (self), "%u", index);
+	event = gst_event_new_stream_start (stream_id);
+	gst_event_set_group_id (event, group_id);
+	gst_pad_push_event (source->pad, event);
+	g_free (stream_id);
+
+	gst_pad_push_event (source->pad, gst_event_new_caps (source->caps));
+
+	gst_segment_init (&segment, GST_FORMAT_TIME);
+	gst_pad_push_event (source->pad, gst_event_new_segment (&segment));
+}
+
+static GstFlowReturn
+_push_frame_set (GstAravisMultiSrc *self, ArvFrameSet *frame_set)
+{
+	GstFlowReturn flow = GST_FLOW_OK;
+	GstClockTime pts;
+	GstClockTime duration;
+	gboolean conversion_failed = FALSE;
+	guint64 timestamp_ns;
+	guint group_id = 0;
+	guint i;
+
+	timestamp_ns = arv_frame_set_get_timestamp (frame_set);
+
+	_update_latency (self, timestamp_ns);
+
+	/* All the buffers of the frame set share the same timestamps. The frame set timestamp is expressed in host real
+	 * time, thanks to the clock offset estimation of the frame synchronizer. */
+	pts = gst_aravis_get_running_time (GST_ELEMENT (self), timestamp_ns);
+	if (!GST_CLOCK_TIME_IS_VALID (pts)) {
+		/* No pipeline clock, timestamps relative to the first frame set */
+		if (self->timestamp_offset == 0)
+			self->timestamp_offset = timestamp_ns;
+		pts = timestamp_ns > self->timestamp_offset ? timestamp_ns - self->timestamp_offset : 0;
+	}
+	duration = self->frame_rate > 0.0 ? (GstClockTime) (GST_SECOND / self->frame_rate) : GST_CLOCK_TIME_NONE;
+
+	for (i = 0; i < self->n_sources; i++) {
+		GstAravisMultiSrcSource *source = &self->sources[i];
+		ArvBuffer *arv_buffer;
+		GstBuffer *buffer;
+
+		arv_buffer = arv_frame_set_get_buffer (frame_set, i);
+		if (arv_buffer == NULL)
+			continue;
+
+		if (source->need_events) {
+			if (group_id == 0)
+				group_id = gst_util_group_id_next ();
+			_push_initial_events (self, source, i, group_id);
+			source->need_events = FALSE;
+		}
+
+		buffer = _wrap_arv_buffer (self, source, arv_buffer);
+		if (buffer == NULL) {
+			conversion_failed = TRUE;
+			continue;
+		}
+
+		GST_BUFFER_PTS (buffer) = pts;
+		GST_BUFFER_DURATION (buffer) = duration;
+		GST_BUFFER_OFFSET (buffer) = self->n_frame_sets;
+		GST_BUFFER_OFFSET_END (buffer) = self->n_frame_sets + 1;
+
+		flow = gst_flow_combiner_update_pad_flow (self->flow_combiner, source->pad,
+							  gst_pad_push (source->pad, buffer));
+	}
+
+	self->n_frame_sets++;
+
+	return conversion_failed ? GST_FLOW_ERROR : flow;
+}
+
+static void
+_push_event (GstAravisMultiSrc *self, GstEvent *event)
+{
+	guint i;
+
+	for (i = 0; i < self->n_sources; i++)
+		gst_pad_push_event (self->sources[i].pad, gst_event_ref (event));
+
+	gst_event_unref (event);
+}
+
+/* The software triggers are sent to the cameras in turn, the action command is received by all the cameras at
+ * once */
+
+static void
+_trigger (GstAravisMultiSrc *self)
+{
+	GError *error = NULL;
+	guint i;
+
+	switch (self->trigger) {
+		case GST_ARAVIS_MULTI_SRC_TRIGGER_SOFTWARE:
+			for (i = 0; i < self->n_sources; i++) {
+				arv_camera_software_trigger (self->sources[i].camera, &error);
+				if (error != NULL) {
+					GST_WARNING_OBJECT (self, "Software trigger of camera %u failed: %s",
+							    i, error->message);
+					g_clear_error (&error);
+				}
+			}
+			break;
+		case GST_ARAVIS_MULTI_SRC_TRIGGER_ACTION:
+			{
+				guint n_acknowledges = 0;
+
+				arv_gv_interface_issue_action_command (self->action_device_key,
+								       self->action_group_key,
+								       self->action_group_mask,
+								       0, NULL, self->n_sources,
+								       GST_ARAVIS_MULTI_SRC_ACTION_TIMEOUT_MS,
+								       &n_acknowledges, &error);
+				if (error != NULL) {
+					GST_WARNING_OBJECT (self, "Action command failed (%u/%u acknowledges): %s",
+							    n_acknowledges, self->n_sources, error->message);
+					g_clear_error (&error);
+				}
+			}
+			break;
+		default:
+			break;
+	}
+}
+
+static void
+gst_aravis_multi_src_loop (gpointer user_data)
+{
+	GstAravisMultiSrc *self = GST_ARAVIS_MULTI_SRC (user_data);
+	ArvFrameSet *frame_set;
+	GstFlowReturn flow;
+	guint64 timeout_us = GST_ARAVIS_MULTI_SRC_POP_TIMEOUT_US;
+
+	/* The triggers are issued from the streaming thread, between two frame set waits. A late trigger is not
+	 * caught up, which would only make a burst of frames. */
+	if (self->trigger != GST_ARAVIS_MULTI_SRC_TRIGGER_NONE) {
+		gint64 period_us = MAX (1, (gint64) (1e6 / self->frame_rate));
+		gint64 now_us = g_get_monotonic_time ();
+
+		if (now_us >= self->next_trigger_time_us) {
+			_trigger (self);
+
+			self->next_trigger_time_us += period_us;
+			if (self->next_trigger_time_us <= now_us)
+				self->next_trigger_time_us = now_us + period_us;
+		}
+
+		timeout_us = MIN (timeout_us, (guint64) (self->next_trigger_time_us - now_us));
+	}
+
+	frame_set = arv_frame_sync_timeout_pop_frame_set (self->frame_sync, timeout_us);
+	if (frame_set == NULL)
+		return;
+
+	/* The buffers pushed downstream hold their own reference, the other ones are released with the frame set */
+	flow = _push_frame_set (self, frame_set);
+	g_object_unref (frame_set);
+
+	if (flow == GST_FLOW_OK)
+		return;
+
+	GST_DEBUG_OBJECT (self, "Pausing task, reason %s", gst_flow_get_name (flow));
+	gst_task_pause (self->task);
+
+	if (flow == GST_FLOW_EOS) {
+		_push_event (self, gst_event_new_eos ());
+	} else if (flow == GST_FLOW_NOT_LINKED || flow < GST_FLOW_EOS) {
+		GST_ELEMENT_ERROR (self, STREAM, FAILED, ("Internal data stream error."),
+				   ("streaming stopped, reason %s", gst_flow_get_name (flow)));
+		_push_event (self, gst_event_new_eos ());
+	}
+}
+
+static gboolean
+gst_aravis_multi_src_src_query (GstPad *pad, GstObject *parent, GstQuery *query)
+{
+	GstAravisMultiSrc *self = GST_ARAVIS_MULTI_SRC (parent);
+
+	if (GST_QUERY_TYPE (query) == GST_QUERY_LATENCY) {
+		GstClockTime min_latency, max_latency;
+
+		gst_aravis_latency_query (&self->latency, self->num_buffers, &min_latency, &max_latency);
+
+		GST_DEBUG_OBJECT (self, "Report latency %" GST_TIME_FORMAT " - %" GST_TIME_FORMAT,
+				  GST_TIME_ARGS (min_latency), GST_TIME_ARGS (max_latency));
+
+		gst_query_set_latency (query, TRUE, min_latency, max_latency);
+
+		return TRUE;
+	}
+
+	return gst_pad_query_default (pad, parent, query);
+}
+
+static gboolean
+_configure_trigger (GstAravisMultiSrc *self, GError **error)
+{
+	GError *local_error = NULL;
+	guint i;
+
+	for (i = 0; i < self->n_sources && local_error == NULL; i++) {
+		ArvCamera *camera = arv_camera_group_get_camera (self->camera_group, i);
+
+		switch (self->trigger) {
+			case GST_ARAVIS_MULTI_SRC_TRIGGER_NONE:
+				if (self->frame_rate > 0.0)
+					arv_camera_set_frame_rate (camera, self->frame_rate, &local_error);
+				break;
+			case GST_ARAVIS_MULTI_SRC_TRIGGER_SOFTWARE:
+				arv_camera_set_trigger (camera, "Software", &local_error);
+				break;
+			case GST_ARAVIS_MULTI_SRC_TRIGGER_ACTION:
+				arv_camera_set_trigger (camera, "Action1", &local_error);
+				break;
+		}
+	}
+
+	if (local_error != NULL) {
+		g_propagate_error (error, local_error);
+		return FALSE;
+	}
+
+	if (self->trigger == GST_ARAVIS_MULTI_SRC_TRIGGER_ACTION) {
+		const char *features[] = {"ActionDeviceKey", "ActionGroupKey", "ActionGroupMask"};
+		char *values[G_N_ELEMENTS (features)];
+		gboolean success;
+
+		values[0] = g_strdup_printf ("%u", self->action_device_key);
+		values[1] = g_strdup_printf ("%u", self->action_group_key);
+		values[2] = g_strdup_printf ("%u", self->action_group_mask);
+
+		success = arv_camera_group_set_features (self->camera_group, features, (const char **) values,
+							 G_N_ELEMENTS (features), error);
+
+		for (i = 0; i < G_N_ELEMENTS (values); i++)
+			g_free (values[i]);
+
+		return success;
+	}
+
+	return TRUE;
+}
+
+static gboolean
+_open_source (GstAravisMultiSrc *self, guint index)
+{
+	GstAravisMultiSrcSource *source = &self->sources[index];
+	GstStructure *structure;
+	ArvPixelFormat pixel_format;
+	const char *caps_string;
+	double frame_rate;
+	char *pad_name;
+	guint payload;
+	int frame_rate_numerator;
+	int frame_rate_denominator;
+	int width, height;
+	int i;
+
+	source->camera = arv_camera_group_get_camera (self->camera_group, index);
+
+	pixel_format = arv_camera_get_pixel_format (source->camera, NULL);
+	arv_camera_get_region (source->camera, NULL, NULL, &width, &height, NULL);
+	payload = arv_camera_get_payload (source->camera, NULL);
+	frame_rate = self->frame_rate > 0.0 ? self->frame_rate : arv_camera_get_frame_rate (source->camera, NULL);
+
+	if (frame_rate > 0.0) {
+		GstClockTime frame_duration = (GstClockTime) (GST_SECOND / frame_rate);
+		GstClockTime slowest_frame_duration = gst_aravis_latency_get_frame_duration (&self->latency);
+
+		if (!GST_CLOCK_TIME_IS_VALID (slowest_frame_duration) || frame_duration > slowest_frame_duration)
+			gst_aravis_latency_set_frame_duration (&self->latency, frame_duration);
+	}
+
+	caps_string = arv_pixel_format_to_gst_caps_string (pixel_format);
+	if (caps_string == NULL) {
+		GST_ELEMENT_ERROR (self, STREAM, FORMAT, ("Unsupported pixel format of camera '%s'",
+							  arv_camera_group_get_device_id (self->camera_group, index)),
+				   ("Pixel format 0x%08x has no Gstreamer equivalent", pixel_format));
+		return FALSE;
+	}
+
+	gst_util_double_to_fraction (frame_rate, &frame_rate_numerator, &frame_rate_denominator);
+
+	structure = gst_structure_from_string (caps_string, NULL);
+	gst_structure_set (structure,
+			   "width", G_TYPE_INT, width,
+			   "height", G_TYPE_INT, height,
+			   "framerate", GST_TYPE_FRACTION, frame_rate_numerator, frame_rate_denominator,
+			   NULL);
+	source->caps = gst_caps_new_empty ();
+	gst_caps_append_structure (source->caps, structure);
+
+	GST_DEBUG_OBJECT (self, "Camera %u caps = %" GST_PTR_FORMAT, index, source->caps);
+
+	source->converter = arv_converter_new (pixel_format);
+
+	source->stream = arv_camera_create_stream (source->camera, NULL, NULL);
+	if (!ARV_IS_STREAM (source->stream)) {
+		GST_ELEMENT_ERROR (self, RESOURCE, FAILED, ("Failed to create stream of camera '%s'",
+							    arv_camera_group_get_device_id (self->camera_group, index)),
+				   (NULL));
+		return FALSE;
+	}
+
+	for (i = 0; i < self->num_buffers; i++) {
+		ArvBuffer *buffer;
+
+		buffer = arv_buffer_new_padded (payload, height, GST_ARAVIS_MULTI_SRC_ROW_ALIGNMENT);
+		if (buffer == NULL)
+			buffer = arv_buffer_new (payload, NULL);
+		arv_stream_push_buffer (source->stream, buffer);
+	}
+
+	pad_name = g_strdup_printf ("src_%u", index);
+	source->pad = gst_pad_new_from_static_template (&aravis_multi_src_template, pad_name);
+	g_free (pad_name);
+
+	gst_pad_set_query_function (source->pad, gst_aravis_multi_src_src_query);
+	gst_pad_use_fixed_caps (source->pad);
+	source->need_events = TRUE;
+
+	return TRUE;
+}
+
+static gboolean
+_open (GstAravisMultiSrc *self)
+{
+	ArvStream **streams;
+	char **camera_names;
+	GError *error = NULL;
+	guint i;
+
+	if (self->camera_names == NULL || self->camera_names[0] == '\0') {
+		GST_ELEMENT_ERROR (self, RESOURCE, NOT_FOUND, ("No camera"), ("The camera-names property is empty"));
+		return FALSE;
+	}
+
+	if (self->trigger != GST_ARAVIS_MULTI_SRC_TRIGGER_NONE && self->frame_rate <= 0.0) {
+		GST_ELEMENT_ERROR (self, RESOURCE, SETTINGS, ("No trigger rate"),
+				   ("The frame-rate property must be set in trigger mode"));
+		return FALSE;
+	}
+
+	camera_names = g_strsplit (self->camera_names, ",", -1);
+	for (i = 0; camera_names[i] != NULL; i++)
+		g_strstrip (camera_names[i]);
+
+	GST_LOG_OBJECT (self, "Open cameras '%s'", self->camera_names);
+
+	self->camera_group = arv_camera_group_new ((const char **) camera_names, 0);
+	g_strfreev (camera_names);
+
+	self->n_sources = arv_camera_group_get_n_cameras (self->camera_group);
+
+	for (i = 0; i < self->n_sources; i++) {
+		ArvCamera *camera = arv_camera_group_get_camera (self->camera_group, i);
+		const char *device_id = arv_camera_group_get_device_id (self->camera_group, i);
+
+		if (camera == NULL) {
+			const GError *open_error = arv_camera_group_get_error (self->camera_group, i);
+
+			GST_ELEMENT_ERROR (self, RESOURCE, NOT_FOUND, ("Failed to open camera '%s'", device_id),
+					   ("%s", open_error != NULL ? open_error->message : "Unknown error"));
+			return FALSE;
+		}
+
+		if (self->trigger == GST_ARAVIS_MULTI_SRC_TRIGGER_ACTION && !arv_camera_is_gv_device (camera)) {
+			GST_ELEMENT_ERROR (self, RESOURCE, SETTINGS, ("Camera '%s' is not a GigE Vision device", device_id),
+					   ("Action commands are only supported by GigE Vision devices"));
+			return FALSE;
+		}
+	}
+
+	if (!_configure_trigger (self, &error)) {
+		GST_ELEMENT_ERROR (self, RESOURCE, SETTINGS, ("Failed to configure the camera triggers"),
+				   ("%s", error != NULL ? error->message : "Unknown error"));
+		g_clear_error (&error);
+		return FALSE;
+	}
+
+	gst_aravis_latency_set_frame_duration (&self->latency, GST_CLOCK_TIME_NONE);
+
+	self->sources = g_new0 (GstAravisMultiSrcSource, self->n_sources);
+	for (i = 0; i < self->n_sources; i++)
+		if (!_open_source (self, i))
+			return FALSE;
+
+	/* The frame synchronizer expresses the frame set timestamps in host time, which gives consistent timestamps
+	 * across cameras */
+	streams = g_new (ArvStream *, self->n_sources);
+	for (i = 0; i < self->n_sources; i++)
+		streams[i] = self->sources[i].stream;
+	self->frame_sync = arv_frame_sync_new (streams, self->n_sources, ARV_FRAME_SYNC_MODE_TIMESTAMP);
+	g_free (streams);
+
+	arv_frame_sync_set_tolerance (self->frame_sync, self->sync_tolerance_ns);
+	arv_frame_sync_set_drop_policy (self->frame_sync, ARV_FRAME_SYNC_DROP_POLICY_DROP_INCOMPLETE);
+	arv_frame_sync_set_clock_offset_estimation (self->frame_sync, TRUE);
+
+	self->flow_combiner = gst_flow_combiner_new ();
+	for (i = 0; i < self->n_sources; i++) {
+		gst_pad_set_active (self->sources[i].pad, TRUE);
+		gst_element_add_pad (GST_ELEMENT (self), self->sources[i].pad);
+		gst_flow_combiner_add_pad (self->flow_combiner, self->sources[i].pad);
+	}
+	gst_element_no_more_pads (GST_ELEMENT (self));
+
+	self->n_frame_sets = 0;
+	self->timestamp_offset = 0;
+
+	gst_aravis_latency_reset (&self->latency);
+
+	return TRUE;
+}
+
+static void
+_start (GstAravisMultiSrc *self)
+{
+	guint i;
+
+	if (!self->is_acquiring) {
+		GST_LOG_OBJECT (self, "Start acquisition");
+
+		for (i = 0; i < self->n_sources; i++)
+			arv_camera_start_acquisition (self->sources[i].camera, NULL);
+		self->is_acquiring = TRUE;
+		self->next_trigger_time_us = g_get_monotonic_time ();
+	}
+
+	gst_task_start (self->task);
+}
+
+static void
+_close (GstAravisMultiSrc *self)
+{
+	guint i;
+
+	if (self->is_acquiring) {
+		GST_LOG_OBJECT (self, "Stop acquisition");
+
+		for (i = 0; i < self->n_sources; i++)
+			arv_camera_stop_acquisition (self->sources[i].camera, NULL);
+		self->is_acquiring = FALSE;
+	}
+
+	g_clear_object (&self->frame_sync);
+
+	for (i = 0; self->sources != NULL && i < self->n_sources; i++) {
+		GstAravisMultiSrcSource *source = &self->sources[i];
+
+		if (source->pad != NULL) {
+			if (GST_PAD_PARENT (source->pad) == GST_OBJECT (self)) {
+				gst_flow_combiner_remove_pad (self->flow_combiner, source->pad);
+				gst_pad_set_active (source->pad, FALSE);
+				gst_element_remove_pad (GST_ELEMENT (self), source->pad);
+			} else
+				gst_object_unref (gst_object_ref_sink (source->pad));
+			source->pad = NULL;
+		}
+
+		g_clear_object (&source->stream);
+		g_clear_object (&source->converter);
+		if (source->caps != NULL) {
+			gst_caps_unref (source->caps);
+			source->caps = NULL;
+		}
+	}
+	g_clear_pointer (&self->sources, g_free);
+	self->n_sources = 0;
+
+	g_clear_pointer (&self->flow_combiner, gst_flow_combiner_free);
+	g_clear_object (&self->camera_group);
+}
+
+static GstStateChangeReturn
+gst_aravis_multi_src_change_state (GstElement *element, GstStateChange transition)
+{
+	GstAravisMultiSrc *self = GST_ARAVIS_MULTI_SRC (element);
+	GstStateChangeReturn result;
+
+	switch (transition) {
+		case GST_STATE_CHANGE_READY_TO_PAUSED:
+			if (!_open (self)) {
+				_close (self);
+				return GST_STATE_CHANGE_FAILURE;
+			}
+			break;
+		case GST_STATE_CHANGE_PAUSED_TO_PLAYING:
+			_start (self);
+			break;
+		default:
+			break;
+	}
+
+	result = GST_ELEMENT_CLASS (gst_aravis_multi_src_parent_class)->change_state (element, transition);
+	if (result == GST_STATE_CHANGE_FAILURE)
+		return result;
+
+	switch (transition) {
+		case GST_STATE_CHANGE_READY_TO_PAUSED:
+			result = GST_STATE_CHANGE_NO_PREROLL;
+			break;
+		case GST_STATE_CHANGE_PLAYING_TO_PAUSED:
+			/* Don't wait for the task, it may be blocked in a prerolling sink */
+			gst_task_pause (self->task);
+			result = GST_STATE_CHANGE_NO_PREROLL;
+			break;
+		case GST_STATE_CHANGE_PAUSED_TO_READY:
+			/* The pads are deactivated, the task is not blocked downstream anymore */
+			gst_task_stop (self->task);
+			gst_task_join (self->task);
+			_close (self);
+			break;
+		default:
+			break;
+	}
+
+	return result;
+}
+
+static void
+gst_aravis_multi_src_init (GstAravisMultiSrc *self)
+{
+	GST_OBJECT_FLAG_SET (self, GST_ELEMENT_FLAG_SOURCE);
+
+	self->camera_names = NULL;
+	self->trigger = GST_ARAVIS_MULTI_SRC_TRIGGER_NONE;
+	self->frame_rate = 0.0;
+	self->sync_tolerance_ns = GST_ARAVIS_MULTI_SRC_DEFAULT_SYNC_TOLERANCE;
+	self->action_device_key = 0;
+	self->action_group_key = 1;
+	self->action_group_mask = 1;
+	self->num_buffers = GST_ARAVIS_MULTI_SRC_DEFAULT_N_BUFFERS;
+
+	self->camera_group = NULL;
+	self->sources = NULL;
+	self->n_sources = 0;
+	self->frame_sync = NULL;
+	self->flow_combiner = NULL;
+	self->is_acquiring = FALSE;
+
+	g_rec_mutex_init (&self->task_lock);
+	self->task = gst_task_new (gst_aravis_multi_src_loop, self, NULL);
+	gst_task_set_lock (self->task, &self->task_lock);
+
+	gst_aravis_latency_init (&self->latency);
+}
+
+static void
+gst_aravis_multi_src_finalize (GObject *object)
+{
+	GstAravisMultiSrc *self = GST_ARAVIS_MULTI_SRC (object);
+
+	_close (self);
+
+	gst_object_unref (self->task);
+	g_rec_mutex_clear (&self->task_lock);
+
+	g_free (self->camera_names);
+	self->camera_names = NULL;
+
+	gst_aravis_latency_clear (&self->latency);
+
+	G_OBJECT_CLASS (gst_aravis_multi_src_parent_class)->finalize (object);
+}
+
+static void
+gst_aravis_multi_src_set_property (GObject *object, guint prop_id, const GValue *value, GParamSpec *pspec)
+{
+	GstAravisMultiSrc *self = GST_ARAVIS_MULTI_SRC (object);
+
+	/* The settings are applied when the cameras are opened, in the READY to PAUSED transition */
+	switch (prop_id) {
+		case PROP_CAMERA_NAMES:
+			g_free (self->camera_names);
+			self->camera_names = g_value_dup_string (value);
+			break;
+		case PROP_TRIGGER:
+			self->trigger = g_value_get_enum (value);
+			break;
+		case PROP_FRAME_RATE:
+			self->frame_rate = g_value_get_double (value);
+			break;
+		case PROP_SYNC_TOLERANCE:
+			self->sync_tolerance_ns = g_value_get_uint64 (value);
+			break;
+		case PROP_ACTION_DEVICE_KEY:
+			self->action_device_key = g_value_get_uint (value);
+			break;
+		case PROP_ACTION_GROUP_KEY:
+			self->action_group_key = g_value_get_uint (value);
+			break;
+		case PROP_ACTION_GROUP_MASK:
+			self->action_group_mask = g_value_get_uint (value);
+			break;
+		case PROP_NUM_BUFFERS:
+			self->num_buffers = g_value_get_int (value);
+			break;
+		default:
+			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+			break;
+	}
+}
+
+static void
+gst_aravis_multi_src_get_property (GObject *object, guint prop_id, GValue *value, GParamSpec *pspec)
+{
+	GstAravisMultiSrc *self = GST_ARAVIS_MULTI_SRC (object);
+
+	switch (prop_id) {
+		case PROP_CAMERA_NAMES:
+			g_value_set_string (value, self->camera_names);
+			break;
+		case PROP_TRIGGER:
+			g_value_set_enum (value, self->trigger);
+			break;
+		case PROP_FRAME_RATE:
+			g_value_set_double (value, self->frame_rate);
+			break;
+		case PROP_SYNC_TOLERANCE:
+			g_value_set_uint64 (value, self->sync_tolerance_ns);
+			break;
+		case PROP_ACTION_DEVICE_KEY:
+			g_value_set_uint (value, self->action_device_key);
+			break;
+		case PROP_ACTION_GROUP_KEY:
+			g_value_set_uint (value, self->action_group_key);
+			break;
+		case PROP_ACTION_GROUP_MASK:
+			g_value_set_uint (value, self->action_group_mask);
+			break;
+		case PROP_NUM_BUFFERS:
+			g_value_set_int (value, self->num_buffers);
+			break;
+		default:
+			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+			break;
+	}
+}
+
+static void
+gst_aravis_multi_src_class_init (GstAravisMultiSrcClass *klass)
+{
+	GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+	GstElementClass *element_class = GST_ELEMENT_CLASS (klass);
+
+	gobject_class->finalize = gst_aravis_multi_src_finalize;
+	gobject_class->set_property = gst_aravis_multi_src_set_property;
+	gobject_class->get_property = gst_aravis_multi_src_get_property;
+
+	g_object_class_install_property
+		(gobject_class,
+		 PROP_CAMERA_NAMES,
+		 g_param_spec_string ("camera-names",
+				      "Camera names",
+				      "Comma separated list of camera names",
+				      NULL,
+				      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+	g_object_class_install_property
+		(gobject_class,
+		 PROP_TRIGGER,
+		 g_param_spec_enum ("trigger",
+				    "Trigger",
+				    "Camera trigger mode",
+				    GST_TYPE_ARAVIS_MULTI_SRC_TRIGGER,
+				    GST_ARAVIS_MULTI_SRC_TRIGGER_NONE,
+				    G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+	g_object_class_install_property
+		(gobject_class,
+		 PROP_FRAME_RATE,
+		 g_param_spec_double ("frame-rate",
+				      "Frame rate",
+				      "Trigger rate in trigger mode, camera frame rate otherwise (Hz, 0 = camera setting)",
+				      0.0, 1000000.0, 0.0,
+				      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+	g_object_class_install_property
+		(gobject_class,
+		 PROP_SYNC_TOLERANCE,
+		 g_param_spec_uint64 ("sync-tolerance",
+				      "Synchronization tolerance",
+				      "Maximum timestamp difference between the buffers of a frame set (ns)",
+				      0, G_MAXUINT64, GST_ARAVIS_MULTI_SRC_DEFAULT_SYNC_TOLERANCE,
+				      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+	g_object_class_install_property
+		(gobject_class,
+		 PROP_ACTION_DEVICE_KEY,
+		 g_param_spec_uint ("action-device-key",
+				    "Action device key",
+				    "Device key of the action command trigger",
+				    0, G_MAXUINT32, 0,
+				    G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+	g_object_class_install_property
+		(gobject_class,
+		 PROP_ACTION_GROUP_KEY,
+		 g_param_spec_uint ("action-group-key",
+				    "Action group key",
+				    "Group key of the action command trigger",
+				    0, G_MAXUINT32, 1,
+				    G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+	g_object_class_install_property
+		(gobject_class,
+		 PROP_ACTION_GROUP_MASK,
+		 g_param_spec_uint ("action-group-mask",
+				    "Action group mask",
+				    "Group mask of the action command trigger",
+				    0, G_MAXUINT32, 1,
+				    G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+	g_object_class_install_property
+		(gobject_class,
+		 PROP_NUM_BUFFERS,
+		 g_param_spec_int ("num-buffers",
+				   "Number of Buffers",
+				   "Number of video buffers to allocate for each camera",
+				   1, G_MAXINT, GST_ARAVIS_MULTI_SRC_DEFAULT_N_BUFFERS,
+				   G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+	GST_DEBUG_CATEGORY_INIT (aravis_multi_src_debug, "aravismultisrc", 0, "Aravis multi-camera source");
+
+	gst_element_class_set_details_simple (element_class,
+					      "Aravis Synchronized Multi-Camera Source",
+					      "Source/Video",
+					      "Aravis based source of synchronized frames from several cameras",
+					      "Emmanuel Pacaud <emmanuel@gnome.org>");
+	gst_element_class_add_pad_template (element_class,
+					    gst_static_pad_template_get (&aravis_multi_src_template));
+
+	element_class->change_state = gst_aravis_multi_src_change_state;
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright © 2010-2019 Emmanuel Pacaud <emmanuel@gnome.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef GST_ARAVIS_MULTI_SRC_H
+#define GST_ARAVIS_MULTI_SRC_H
+
+#include <gst/gst.h>
+#include <gst/base/gstflowcombiner.h>
+#include <arv.h>
+#include <gstaravislatency.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GstAravisMultiSrcTrigger:
+ * @GST_ARAVIS_MULTI_SRC_TRIGGER_NONE: free running cameras
+ * @GST_ARAVIS_MULTI_SRC_TRIGGER_SOFTWARE: software trigger, issued to each camera in turn
+ * @GST_ARAVIS_MULTI_SRC_TRIGGER_ACTION: GigE Vision action command, received by all the cameras at once
+ */
+
+typedef enum {
+	GST_ARAVIS_MULTI_SRC_TRIGGER_NONE,
+	GST_ARAVIS_MULTI_SRC_TRIGGER_SOFTWARE,
+	GST_ARAVIS_MULTI_SRC_TRIGGER_ACTION
+} GstAravisMultiSrcTrigger;
+
+#define GST_TYPE_ARAVIS_MULTI_SRC_TRIGGER	(gst_aravis_multi_src_trigger_get_type())
+
+#define GST_TYPE_ARAVIS_MULTI_SRC 		(gst_aravis_multi_src_get_type())
+#define GST_ARAVIS_MULTI_SRC(obj)		(G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_ARAVIS_MULTI_SRC,GstAravisMultiSrc))
+#define GST_IS_ARAVIS_MULTI_SRC(obj) 		(G_TYPE_CHECK_INSTANCE_TYPE((obj),GST_TYPE_ARAVIS_MULTI_SRC))
+
+typedef struct _GstAravisMultiSrc GstAravisMultiSrc;
+typedef struct _GstAravisMultiSrcClass GstAravisMultiSrcClass;
+
+typedef struct {
+	ArvCamera *camera;		/* Owned by the camera group */
+	ArvStream *stream;
+	ArvConverter *converter;
+
+	GstPad *pad;
+	GstCaps *caps;
+	gboolean need_events;
+} GstAravisMultiSrcSource;
+
+struct _GstAravisMultiSrc {
+	GstElement element;
+
+	char *camera_names;
+	GstAravisMultiSrcTrigger trigger;
+	double frame_rate;
+	guint64 sync_tolerance_ns;
+	guint action_device_key;
+	guint action_group_key;
+	guint action_group_mask;
+	gint num_buffers;
+
+	ArvCameraGroup *camera_group;
+	GstAravisMultiSrcSource *sources;
+	guint n_sources;
+	ArvFrameSync *frame_sync;
+	GstFlowCombiner *flow_combiner;
+	gboolean is_acquiring;
+
+	GstTask *task;
+	GRecMutex task_lock;
+
+	gint64 next_trigger_time_us;
+	guint64 n_frame_sets;
+	guint64 timestamp_offset;
+
+	/* Frame set ages at push time, which include the wait for the slowest camera. The frame duration is the
+	 * one of the slowest camera. */
+	GstAravisLatency latency;
+};
+
+struct _GstAravisMultiSrcClass {
+	GstElementClass parent_class;
+};
+
+GType gst_aravis_multi_src_trigger_get_type (void);
+GType gst_aravis_multi_src_get_type (void);
+
+G_END_DECLS
+
+#endif
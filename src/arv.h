@@ -28,10 +28,19 @@
 #include <arvtypes.h>
 
 #include <arvbuffer.h>
+#include <arvpixelunpack.h>
+#include <arvdemosaic.h>
+#include <arvconverter.h>
+#include <arvimagestats.h>
+#include <arvimageanalyzer.h>
 #include <arvcamera.h>
+#include <arvcameragroup.h>
 #include <arvchunkparser.h>
+#include <arvclockmodel.h>
 #include <arvdebug.h>
 #include <arvdevice.h>
+#include <arvframeset.h>
+#include <arvframesync.h>
 
 #include <arvdomcharacterdata.h>
 #include <arvdomdocumentfragment.h>
@@ -54,6 +63,7 @@
 #include <arvfakestream.h>
 
 #include <arvfeatures.h>
+#include <arvfeaturehandle.h>
 
 #include <arvgc.h>
 #include <arvgcboolean.h>
@@ -96,6 +106,7 @@
 #include <arvgvfakecamera.h>
 #include <arvgvinterface.h>
 #include <arvgvstream.h>
+#include <arvgvbandwidthplanner.h>
 
 #include <arvinterface.h>
 #include <arvmisc.h>
@@ -33,6 +33,10 @@
  */
 
 #include <arvbufferprivate.h>
+#include <arvpixelunpack.h>
+#include <arvdemosaic.h>
+#include <arvimagestats.h>
+#include <string.h>
 
 gboolean
 arv_buffer_payload_type_has_chunks (ArvBufferPayloadType payload_type)
@@ -78,6 +82,8 @@ arv_buffer_new_full (size_t size, void *preallocated, void *user_data, GDestroyN
 
 	buffer = g_object_new (ARV_TYPE_BUFFER, NULL);
 	buffer->priv->size = size;
+	buffer->priv->allocated_size = size;
+	buffer->priv->row_alignment = 1;
 	buffer->priv->user_data = user_data;
 	buffer->priv->user_data_destroy_func = user_data_destroy_func;
 	buffer->priv->chunk_endianness = G_BIG_ENDIAN;
@@ -134,12 +140,51 @@ arv_buffer_new_allocate (size_t size)
 	return arv_buffer_new_full (size, NULL, NULL, NULL);
 }
 
+/**
+ * arv_buffer_new_padded:
+ * @size: payload size
+ * @max_height: maximum number of image rows
+ * @row_alignment: row alignment, in bytes, must be a power of 2
+ *
+ * Creates a new buffer for the storage of the video stream images, with rows
+ * padded to a multiple of @row_alignment bytes. The data space is enlarged by
+ * @row_alignment - 1 bytes per row, which allows the streams to write the
+ * rows of images of up to @max_height rows directly at their padded offset.
+ * Such images can be consumed by GStreamer or OpenCV without repacking.
+ *
+ * Padding only applies to image payloads without chunk data, and to pixel
+ * formats whose rows end on a byte boundary. Otherwise, the image rows are
+ * tightly packed, as for buffers created with arv_buffer_new().
+ *
+ * Returns: a new #ArvBuffer object
+ *
+ * Since: 0.8.0
+ */
+
+ArvBuffer *
+arv_buffer_new_padded (size_t size, guint max_height, guint row_alignment)
+{
+	ArvBuffer *buffer;
+	size_t allocated_size;
+
+	g_return_val_if_fail (row_alignment > 0 && (row_alignment & (row_alignment - 1)) == 0, NULL);
+
+	allocated_size = size + (size_t) max_height * (row_alignment - 1);
+
+	buffer = arv_buffer_new_full (allocated_size, NULL, NULL, NULL);
+	buffer->priv->size = size;
+	buffer->priv->row_alignment = row_alignment;
+
+	return buffer;
+}
+
 /**
  * arv_buffer_get_data:
  * @buffer: a #ArvBuffer
  * @size: (allow-none): location to store data size, or %NULL
  *
- * Buffer data accessor.
+ * Buffer data accessor. For an image with padded rows, @size is the padded
+ * image size, see arv_buffer_get_image_row_stride().
  *
  * Returns: (array length=size) (element-type guint8): a pointer to the buffer data.
  *
@@ -152,7 +197,9 @@ arv_buffer_get_data (ArvBuffer *buffer, size_t *size)
 	g_return_val_if_fail (ARV_IS_BUFFER (buffer), NULL);
 
 	if (size != NULL)
-		*size = buffer->priv->size;
+		*size = buffer->priv->row_stride != 0 ?
+			buffer->priv->row_stride * buffer->priv->height :
+			buffer->priv->size;
 
 	return buffer->priv->data;
 }
@@ -192,52 +239,204 @@ arv_buffer_has_chunks (ArvBuffer *buffer)
  * Since: 0.4.0
  **/
 
-const void *
-arv_buffer_get_chunk_data (ArvBuffer *buffer, guint64 chunk_id, size_t *size)
+/* Walks the chunk trailer list once, from the end of the buffer */
+
+static void
+_build_chunk_index (ArvBuffer *buffer)
 {
 	ArvChunkInfos *infos;
 	unsigned char *data;
 	ptrdiff_t offset;
 
-	if (size != NULL)
-		*size = 0;
-
-	g_return_val_if_fail (arv_buffer_has_chunks (buffer), NULL);
-	g_return_val_if_fail (buffer->priv->data != NULL, NULL);
+	if (buffer->priv->chunk_index == NULL)
+		buffer->priv->chunk_index = g_array_new (FALSE, FALSE, sizeof (ArvBufferChunk));
+	else
+		g_array_set_size (buffer->priv->chunk_index, 0);
 
 	data = buffer->priv->data;
 	offset = buffer->priv->size - sizeof (ArvChunkInfos);
 	while (offset > 0) {
-		guint32 id;
-		guint32 chunk_size;
+		ArvBufferChunk chunk;
+		ptrdiff_t data_offset;
 
 		infos = (ArvChunkInfos *) &data[offset];
 
 		if (buffer->priv->chunk_endianness == G_BIG_ENDIAN) {
-			id = GUINT32_FROM_BE (infos->id);
-			chunk_size = GUINT32_FROM_BE (infos->size);
+			chunk.id = GUINT32_FROM_BE (infos->id);
+			chunk.size = GUINT32_FROM_BE (infos->size);
 		} else {
-			id = GUINT32_FROM_LE (infos->id);
-			chunk_size = GUINT32_FROM_LE (infos->size);
+			chunk.id = GUINT32_FROM_LE (infos->id);
+			chunk.size = GUINT32_FROM_LE (infos->size);
 		}
 
-		if (id == chunk_id) {
-			ptrdiff_t data_offset;
+		data_offset = offset - chunk.size;
+		if (data_offset < 0)
+			break;
 
-			data_offset = offset - chunk_size;
-			if (data_offset >= 0) {
-				if (size != NULL)
-					*size = chunk_size;
-				return &data[data_offset];
-			} else
-		       		return NULL;
-		}
-		if (chunk_size > 0)
-			offset = offset - chunk_size - sizeof (ArvChunkInfos);
+		chunk.offset = data_offset;
+		g_array_append_val (buffer->priv->chunk_index, chunk);
+
+		if (chunk.size > 0)
+			offset = offset - chunk.size - sizeof (ArvChunkInfos);
 		else
 			offset = 0;
 	};
 
+	buffer->priv->has_chunk_index = TRUE;
+}
+
+/* Must be called each time the buffer is reused for a new payload */
+
+void
+arv_buffer_invalidate_chunk_index (ArvBuffer *buffer)
+{
+	g_return_if_fail (ARV_IS_BUFFER (buffer));
+
+	buffer->priv->has_chunk_index = FALSE;
+}
+
+/* Sets the metadata of a buffer holding a converted copy of the image of source */
+
+void
+arv_buffer_copy_image_info (ArvBuffer *buffer, ArvBuffer *source, ArvPixelFormat pixel_format)
+{
+	g_return_if_fail (ARV_IS_BUFFER (buffer));
+	g_return_if_fail (ARV_IS_BUFFER (source));
+
+	buffer->priv->payload_type = ARV_BUFFER_PAYLOAD_TYPE_IMAGE;
+	buffer->priv->status = source->priv->status;
+	buffer->priv->frame_id = source->priv->frame_id;
+	buffer->priv->timestamp_ns = source->priv->timestamp_ns;
+	buffer->priv->system_timestamp_ns = source->priv->system_timestamp_ns;
+	buffer->priv->completion_timestamp_ns = source->priv->completion_timestamp_ns;
+	buffer->priv->host_timestamp_ns = source->priv->host_timestamp_ns;
+	buffer->priv->x_offset = source->priv->x_offset;
+	buffer->priv->y_offset = source->priv->y_offset;
+	buffer->priv->width = source->priv->width;
+	buffer->priv->height = source->priv->height;
+	buffer->priv->pixel_format = pixel_format;
+	buffer->priv->row_stride = 0;
+	buffer->priv->has_chunk_index = FALSE;
+	g_clear_object (&buffer->priv->image_stats);
+}
+
+/* Returns TRUE if the image rows of buffer have to be padded, and there is enough room for them */
+
+gboolean
+arv_buffer_get_padded_layout (ArvBuffer *buffer, size_t *row_size, size_t *row_stride)
+{
+	ArvBufferPrivate *priv;
+	guint64 n_bits;
+	size_t size, stride;
+
+	g_return_val_if_fail (ARV_IS_BUFFER (buffer), FALSE);
+
+	priv = buffer->priv;
+
+	if (priv->row_alignment < 2 || priv->payload_type != ARV_BUFFER_PAYLOAD_TYPE_IMAGE)
+		return FALSE;
+
+	n_bits = (guint64) priv->width * ARV_PIXEL_FORMAT_BIT_PER_PIXEL (priv->pixel_format);
+	if (n_bits == 0 || (n_bits % 8) != 0)
+		return FALSE;
+
+	size = n_bits / 8;
+	stride = (size + priv->row_alignment - 1) & ~((size_t) priv->row_alignment - 1);
+
+	if (stride == size ||
+	    size * priv->height > priv->size ||
+	    stride * priv->height > priv->allocated_size)
+		return FALSE;
+
+	if (row_size != NULL)
+		*row_size = size;
+	if (row_stride != NULL)
+		*row_stride = stride;
+
+	return TRUE;
+}
+
+/* Writes a part of a tightly packed image, starting at offset in the packed layout. If the buffer rows are padded,
+ * each row is written at its padded offset, and any data past the last row are dropped. The caller is responsible
+ * for the bound check of the tightly packed layout. */
+
+void
+arv_buffer_write_image_data (ArvBuffer *buffer, size_t offset, const void *data, size_t size)
+{
+	const char *source = data;
+	size_t row_size;
+	size_t row;
+	size_t column;
+
+	g_return_if_fail (ARV_IS_BUFFER (buffer));
+
+	if (buffer->priv->row_stride == 0) {
+		memcpy (buffer->priv->data + offset, data, size);
+		return;
+	}
+
+	row_size = (size_t) buffer->priv->width * ARV_PIXEL_FORMAT_BIT_PER_PIXEL (buffer->priv->pixel_format) / 8;
+	row = offset / row_size;
+	column = offset % row_size;
+
+	while (size > 0 && row < buffer->priv->height) {
+		size_t n_bytes = MIN (size, row_size - column);
+
+		memcpy (buffer->priv->data + row * buffer->priv->row_stride + column, source, n_bytes);
+
+		source += n_bytes;
+		size -= n_bytes;
+		column = 0;
+		row++;
+	}
+}
+
+/* Moves the rows of a tightly packed image to their padded offset, starting from the last one, as the padded
+ * rows never overlap the tightly packed rows located before them. Only used as a fallback by streams which could
+ * not know the image layout before the reception of the first image data. */
+
+void
+arv_buffer_pad_image_rows (ArvBuffer *buffer)
+{
+	size_t row_size, row_stride;
+	gint64 i;
+
+	g_return_if_fail (ARV_IS_BUFFER (buffer));
+
+	if (buffer->priv->row_stride != 0 ||
+	    !arv_buffer_get_padded_layout (buffer, &row_size, &row_stride))
+		return;
+
+	for (i = (gint64) buffer->priv->height - 1; i > 0; i--)
+		memmove (buffer->priv->data + i * row_stride, buffer->priv->data + i * row_size, row_size);
+
+	buffer->priv->row_stride = row_stride;
+}
+
+const void *
+arv_buffer_get_chunk_data (ArvBuffer *buffer, guint64 chunk_id, size_t *size)
+{
+	unsigned int i;
+
+	if (size != NULL)
+		*size = 0;
+
+	g_return_val_if_fail (arv_buffer_has_chunks (buffer), NULL);
+	g_return_val_if_fail (buffer->priv->data != NULL, NULL);
+
+	if (!buffer->priv->has_chunk_index)
+		_build_chunk_index (buffer);
+
+	for (i = 0; i < buffer->priv->chunk_index->len; i++) {
+		ArvBufferChunk *chunk = &g_array_index (buffer->priv->chunk_index, ArvBufferChunk, i);
+
+		if (chunk->id == chunk_id) {
+			if (size != NULL)
+				*size = chunk->size;
+			return &buffer->priv->data[chunk->offset];
+		}
+	}
+
 	return NULL;
 }
 
@@ -378,6 +577,48 @@ arv_buffer_set_system_timestamp (ArvBuffer *buffer, guint64 timestamp_ns)
 	buffer->priv->system_timestamp_ns = timestamp_ns;
 }
 
+/**
+ * arv_buffer_get_completion_timestamp:
+ * @buffer: a #ArvBuffer
+ *
+ * Gets the host time at which the stream completed the buffer, in the same time base as the system timestamp. For
+ * GigE Vision devices, the difference with the system timestamp is the transfer time of the frame, from the first
+ * to the last packet.
+ *
+ * Returns: the completion timestamp, in nanoseconds.
+ *
+ * Since: 0.8.0
+ */
+
+guint64
+arv_buffer_get_completion_timestamp (ArvBuffer *buffer)
+{
+	g_return_val_if_fail (ARV_IS_BUFFER (buffer), 0);
+
+	return buffer->priv->completion_timestamp_ns;
+}
+
+/**
+ * arv_buffer_get_host_timestamp:
+ * @buffer: a #ArvBuffer
+ *
+ * Gets the buffer camera timestamp converted to the host time base, the one of the system timestamp, using the
+ * device clock model at the buffer completion, see arv_device_get_clock_model(). Unlike the system timestamp, it is
+ * not affected by the transfer latency.
+ *
+ * Returns: the host equivalent of the buffer timestamp, in nanoseconds, 0 if the device clock was not sampled yet.
+ *
+ * Since: 0.8.0
+ */
+
+guint64
+arv_buffer_get_host_timestamp (ArvBuffer *buffer)
+{
+	g_return_val_if_fail (ARV_IS_BUFFER (buffer), 0);
+
+	return buffer->priv->host_timestamp_ns;
+}
+
 
 /**
  * arv_buffer_get_frame_id:
@@ -528,6 +769,185 @@ arv_buffer_get_image_pixel_format (ArvBuffer *buffer)
 	return buffer->priv->pixel_format;
 }
 
+/**
+ * arv_buffer_get_image_row_stride:
+ * @buffer: a #ArvBuffer
+ *
+ * Gets the distance between the start of two consecutive image rows. It is larger than the row size if the rows
+ * are padded, see arv_buffer_new_padded(). This function must only be called on buffer containing a
+ * @ARV_BUFFER_PAYLOAD_TYPE_IMAGE payload.
+ *
+ * Returns: image row stride, in bytes.
+ *
+ * Since: 0.8.0
+ */
+
+size_t
+arv_buffer_get_image_row_stride (ArvBuffer *buffer)
+{
+	g_return_val_if_fail (ARV_IS_BUFFER (buffer), 0);
+	g_return_val_if_fail (arv_buffer_payload_type_has_aoi (buffer->priv->payload_type), 0);
+
+	if (buffer->priv->row_stride != 0)
+		return buffer->priv->row_stride;
+
+	return (size_t) buffer->priv->width * ARV_PIXEL_FORMAT_BIT_PER_PIXEL (buffer->priv->pixel_format) / 8;
+}
+
+/**
+ * arv_buffer_get_row_alignment:
+ * @buffer: a #ArvBuffer
+ *
+ * Returns: the requested row alignment, in bytes, 1 for tightly packed rows.
+ *
+ * Since: 0.8.0
+ */
+
+guint
+arv_buffer_get_row_alignment (ArvBuffer *buffer)
+{
+	g_return_val_if_fail (ARV_IS_BUFFER (buffer), 1);
+
+	return buffer->priv->row_alignment;
+}
+
+/**
+ * arv_buffer_get_image_stats:
+ * @buffer: a #ArvBuffer
+ *
+ * Gets the statistics of the buffer image, computed during the acquisition by the image analyzer of the
+ * stream, see arv_stream_set_image_analyzer().
+ *
+ * Returns: (transfer none) (nullable): the image statistics, %NULL if they were not computed.
+ *
+ * Since: 0.8.0
+ */
+
+ArvImageStats *
+arv_buffer_get_image_stats (ArvBuffer *buffer)
+{
+	g_return_val_if_fail (ARV_IS_BUFFER (buffer), NULL);
+
+	return buffer->priv->image_stats;
+}
+
+void
+arv_buffer_set_image_stats (ArvBuffer *buffer, ArvImageStats *image_stats)
+{
+	g_return_if_fail (ARV_IS_BUFFER (buffer));
+	g_return_if_fail (image_stats == NULL || ARV_IS_IMAGE_STATS (image_stats));
+
+	g_clear_object (&buffer->priv->image_stats);
+	buffer->priv->image_stats = image_stats;
+}
+
+/**
+ * arv_buffer_unpack_to_16bit:
+ * @buffer: a #ArvBuffer containing an image in a packed pixel format
+ * @output: (array length=n_pixels): destination of the unpacked pixels
+ * @n_pixels: size of @output, in pixels
+ * @unpacked_pixel_format: (out) (optional): pixel format of the unpacked image
+ *
+ * Unpacks the image of @buffer to 16 bit per pixel values, see arv_pixel_unpack(). @output must be large
+ * enough for the image width times height pixels.
+ *
+ * Returns: %TRUE on success, %FALSE if the buffer pixel format is not a supported packed format, or if the
+ * buffer or the output are too small.
+ *
+ * Since: 0.8.0
+ */
+
+gboolean
+arv_buffer_unpack_to_16bit (ArvBuffer *buffer, guint16 *output, size_t n_pixels,
+			    ArvPixelFormat *unpacked_pixel_format)
+{
+	size_t n_image_pixels;
+
+	g_return_val_if_fail (ARV_IS_BUFFER (buffer), FALSE);
+	g_return_val_if_fail (arv_buffer_payload_type_has_aoi (buffer->priv->payload_type), FALSE);
+
+	n_image_pixels = (size_t) buffer->priv->width * buffer->priv->height;
+	if (n_pixels < n_image_pixels)
+		return FALSE;
+
+	if (buffer->priv->row_stride != 0) {
+		size_t row_size;
+		guint i;
+
+		arv_buffer_get_padded_layout (buffer, &row_size, NULL);
+
+		for (i = 0; i < buffer->priv->height; i++)
+			if (!arv_pixel_unpack (buffer->priv->pixel_format,
+					       buffer->priv->data + i * buffer->priv->row_stride, row_size,
+					       output + (size_t) i * buffer->priv->width, buffer->priv->width))
+				return FALSE;
+	} else if (!arv_pixel_unpack (buffer->priv->pixel_format, buffer->priv->data, buffer->priv->size,
+				      output, n_image_pixels))
+		return FALSE;
+
+	if (unpacked_pixel_format != NULL)
+		*unpacked_pixel_format = arv_pixel_format_get_unpacked_format (buffer->priv->pixel_format);
+
+	return TRUE;
+}
+
+/**
+ * arv_buffer_demosaic:
+ * @buffer: a #ArvBuffer containing a Bayer image
+ * @output_buffer: a #ArvBuffer receiving the color image
+ * @output_format: RGB or BGR pixel format of the output, see arv_demosaic_get_output_format(), or 0 for RGB
+ * @method: interpolation method
+ * @n_threads: maximum number of threads, 0 for the number of processors
+ *
+ * Converts the Bayer image of @buffer to a color image stored in @output_buffer, see arv_demosaic(). The
+ * data of @output_buffer must be at least 3 times the size of the Bayer image. The image metadata, frame id and
+ * timestamps of @buffer are copied to @output_buffer, with the output pixel format.
+ *
+ * Returns: %TRUE on success, %FALSE if the buffer pixel format is not supported, or if the buffers are too
+ * small.
+ *
+ * Since: 0.8.0
+ */
+
+gboolean
+arv_buffer_demosaic (ArvBuffer *buffer, ArvBuffer *output_buffer, ArvPixelFormat output_format,
+		     ArvDemosaicMethod method, guint n_threads)
+{
+	ArvBufferPrivate *priv;
+	size_t input_stride;
+	size_t input_size;
+	size_t pixel_size;
+
+	g_return_val_if_fail (ARV_IS_BUFFER (buffer), FALSE);
+	g_return_val_if_fail (ARV_IS_BUFFER (output_buffer), FALSE);
+	g_return_val_if_fail (buffer != output_buffer, FALSE);
+	g_return_val_if_fail (arv_buffer_payload_type_has_aoi (buffer->priv->payload_type), FALSE);
+
+	priv = buffer->priv;
+
+	if (output_format == 0)
+		output_format = arv_demosaic_get_output_format (priv->pixel_format, FALSE);
+	if (output_format == 0)
+		return FALSE;
+
+	pixel_size = ARV_PIXEL_FORMAT_BIT_PER_PIXEL (priv->pixel_format) / 8;
+	input_stride = arv_buffer_get_image_row_stride (buffer);
+	arv_buffer_get_data (buffer, &input_size);
+
+	if (input_size < input_stride * priv->height ||
+	    output_buffer->priv->size < 3 * pixel_size * priv->width * priv->height)
+		return FALSE;
+
+	if (!arv_demosaic (priv->pixel_format, priv->data, input_stride, priv->width, priv->height,
+			   output_format, output_buffer->priv->data, 3 * pixel_size * priv->width,
+			   method, n_threads))
+		return FALSE;
+
+	arv_buffer_copy_image_info (output_buffer, buffer, output_format);
+
+	return TRUE;
+}
+
 G_DEFINE_TYPE_WITH_CODE (ArvBuffer, arv_buffer, G_TYPE_OBJECT, G_ADD_PRIVATE (ArvBuffer))
 
 static void
@@ -551,6 +971,11 @@ arv_buffer_finalize (GObject *object)
 	if (buffer->priv->user_data && buffer->priv->user_data_destroy_func)
 		buffer->priv->user_data_destroy_func (buffer->priv->user_data);
 
+	if (buffer->priv->chunk_index != NULL)
+		g_array_unref (buffer->priv->chunk_index);
+
+	g_clear_object (&buffer->priv->image_stats);
+
 	G_OBJECT_CLASS (arv_buffer_parent_class)->finalize (object);
 }
 
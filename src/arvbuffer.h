@@ -28,6 +28,7 @@
 #endif
 
 #include <arvtypes.h>
+#include <arvdemosaic.h>
 
 G_BEGIN_DECLS
 
@@ -94,6 +95,7 @@ ArvBuffer *		arv_buffer_new_allocate		(size_t size);
 ArvBuffer *		arv_buffer_new 			(size_t size, void *preallocated);
 ArvBuffer * 		arv_buffer_new_full		(size_t size, void *preallocated,
 						 	void *user_data, GDestroyNotify user_data_destroy_func);
+ArvBuffer *		arv_buffer_new_padded		(size_t size, guint max_height, guint row_alignment);
 
 ArvBufferStatus		arv_buffer_get_status		(ArvBuffer *buffer);
 
@@ -104,6 +106,8 @@ guint64			arv_buffer_get_timestamp	(ArvBuffer *buffer);
 void			arv_buffer_set_timestamp	(ArvBuffer *buffer, guint64 timestamp_ns);
 guint64			arv_buffer_get_system_timestamp	(ArvBuffer *buffer);
 void			arv_buffer_set_system_timestamp	(ArvBuffer *buffer, guint64 timestamp_ns);
+guint64			arv_buffer_get_completion_timestamp	(ArvBuffer *buffer);
+guint64			arv_buffer_get_host_timestamp	(ArvBuffer *buffer);
 guint32 		arv_buffer_get_frame_id 	(ArvBuffer *buffer);
 const void *		arv_buffer_get_data		(ArvBuffer *buffer, size_t *size);
 
@@ -113,6 +117,15 @@ gint			arv_buffer_get_image_height		(ArvBuffer *buffer);
 gint			arv_buffer_get_image_x			(ArvBuffer *buffer);
 gint			arv_buffer_get_image_y			(ArvBuffer *buffer);
 ArvPixelFormat		arv_buffer_get_image_pixel_format	(ArvBuffer *buffer);
+size_t			arv_buffer_get_image_row_stride		(ArvBuffer *buffer);
+guint			arv_buffer_get_row_alignment		(ArvBuffer *buffer);
+ArvImageStats *		arv_buffer_get_image_stats		(ArvBuffer *buffer);
+
+gboolean		arv_buffer_unpack_to_16bit		(ArvBuffer *buffer, guint16 *output, size_t n_pixels,
+								 ArvPixelFormat *unpacked_pixel_format);
+gboolean		arv_buffer_demosaic			(ArvBuffer *buffer, ArvBuffer *output_buffer,
+								 ArvPixelFormat output_format,
+								 ArvDemosaicMethod method, guint n_threads);
 
 gboolean		arv_buffer_has_chunks		(ArvBuffer *buffer);
 const void *		arv_buffer_get_chunk_data	(ArvBuffer *buffer, guint64 chunk_id, size_t *size);
@@ -32,8 +32,15 @@
 
 G_BEGIN_DECLS
 
+typedef struct {
+	guint32 id;
+	guint32 size;
+	size_t offset;
+} ArvBufferChunk;
+
 typedef struct {
 	size_t size;
+	size_t allocated_size;
 	gboolean is_preallocated;
 	unsigned char *data;
 
@@ -49,6 +56,8 @@ typedef struct {
 	guint32 frame_id;
 	guint64 timestamp_ns;
 	guint64 system_timestamp_ns;
+	guint64 completion_timestamp_ns;
+	guint64 host_timestamp_ns;
 
 	guint32 x_offset;
 	guint32 y_offset;
@@ -56,6 +65,17 @@ typedef struct {
 	guint32 height;
 
 	ArvPixelFormat pixel_format;
+
+	/* Padded image layout, row_stride is 0 for tightly packed rows */
+	guint row_alignment;
+	size_t row_stride;
+
+	/* Chunk layout, indexed on the first chunk data access */
+	gboolean has_chunk_index;
+	GArray *chunk_index;
+
+	/* Statistics computed by the stream image analyzer */
+	ArvImageStats *image_stats;
 } ArvBufferPrivate;
 
 struct _ArvBuffer {
@@ -71,6 +91,16 @@ struct _ArvBufferClass {
 gboolean	arv_buffer_payload_type_has_chunks 	(ArvBufferPayloadType payload_type);
 gboolean	arv_buffer_payload_type_has_aoi 	(ArvBufferPayloadType payload_type);
 
+void		arv_buffer_invalidate_chunk_index	(ArvBuffer *buffer);
+
+gboolean	arv_buffer_get_padded_layout		(ArvBuffer *buffer, size_t *row_size, size_t *row_stride);
+void		arv_buffer_write_image_data		(ArvBuffer *buffer, size_t offset,
+							 const void *data, size_t size);
+void		arv_buffer_pad_image_rows		(ArvBuffer *buffer);
+void		arv_buffer_copy_image_info		(ArvBuffer *buffer, ArvBuffer *source,
+							 ArvPixelFormat pixel_format);
+void		arv_buffer_set_image_stats		(ArvBuffer *buffer, ArvImageStats *image_stats);
+
 G_END_DECLS
 
 #endif
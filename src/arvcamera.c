@@ -51,6 +51,7 @@
 #include <arvgcstring.h>
 #include <arvbuffer.h>
 #include <arvgc.h>
+#include <arvfeaturehandle.h>
 #include <arvgvdevice.h>
 #if ARAVIS_HAS_USB
 #include <arvuvdevice.h>
@@ -110,6 +111,23 @@ typedef struct {
 	gboolean has_exposure_time;
 	gboolean has_acquisition_frame_rate;
 	gboolean has_acquisition_frame_rate_enabled;
+
+	/* Handles of the features used by the camera API, resolved at construction and never modified afterwards, which
+	 * allows their use without locking. NULL if the feature is not available. */
+	ArvFeatureHandle *offset_x;
+	ArvFeatureHandle *offset_y;
+	ArvFeatureHandle *width;
+	ArvFeatureHandle *height;
+	ArvFeatureHandle *pixel_format;
+	ArvFeatureHandle *payload_size;
+	ArvFeatureHandle *exposure_time;
+	ArvFeatureHandle *gain;
+	ArvFeatureHandle *acquisition_start;
+	ArvFeatureHandle *acquisition_stop;
+	ArvFeatureHandle *trigger_software;
+
+	GRWLock feature_handles_lock;	/* Protects feature_handles */
+	GHashTable *feature_handles;
 } ArvCameraPrivate;
 
 G_DEFINE_TYPE_WITH_CODE (ArvCamera, arv_camera, G_TYPE_OBJECT, G_ADD_PRIVATE (ArvCamera))
@@ -120,6 +138,54 @@ enum
 	PROP_CAMERA_DEVICE
 };
 
+/* Accessors for the features resolved at construction, which fall back to the generic feature API if the feature was
+ * not found, for a consistent error reporting */
+
+static gint64
+_get_integer (ArvCamera *camera, ArvFeatureHandle *handle, const char *feature, GError **error)
+{
+	if (handle != NULL)
+		return arv_feature_handle_get_int64 (handle, error);
+
+	return arv_camera_get_integer (camera, feature, error);
+}
+
+static void
+_set_integer (ArvCamera *camera, ArvFeatureHandle *handle, const char *feature, gint64 value, GError **error)
+{
+	if (handle != NULL)
+		arv_feature_handle_set_int64 (handle, value, error);
+	else
+		arv_camera_set_integer (camera, feature, value, error);
+}
+
+static double
+_get_float (ArvCamera *camera, ArvFeatureHandle *handle, const char *feature, GError **error)
+{
+	if (handle != NULL)
+		return arv_feature_handle_get_double (handle, error);
+
+	return arv_camera_get_float (camera, feature, error);
+}
+
+static void
+_set_float (ArvCamera *camera, ArvFeatureHandle *handle, const char *feature, double value, GError **error)
+{
+	if (handle != NULL)
+		arv_feature_handle_set_double (handle, value, error);
+	else
+		arv_camera_set_float (camera, feature, value, error);
+}
+
+static void
+_execute_command (ArvCamera *camera, ArvFeatureHandle *handle, const char *feature, GError **error)
+{
+	if (handle != NULL)
+		arv_feature_handle_execute (handle, error);
+	else
+		arv_camera_execute_command (camera, feature, error);
+}
+
 /**
  * arv_camera_create_stream:
  * @camera: a #ArvCamera
@@ -240,22 +306,23 @@ arv_camera_get_sensor_size (ArvCamera *camera, gint *width, gint *height, GError
 void
 arv_camera_set_region (ArvCamera *camera, gint x, gint y, gint width, gint height, GError **error)
 {
+	ArvCameraPrivate *priv = arv_camera_get_instance_private (camera);
 	GError *local_error = NULL;
 
 	g_return_if_fail (ARV_IS_CAMERA (camera));
 
 	if (x >= 0)
-		arv_camera_set_integer (camera, "OffsetX", 0, &local_error);
+		_set_integer (camera, priv->offset_x, "OffsetX", 0, &local_error);
 	if (y >= 0 && local_error == NULL)
-		arv_camera_set_integer (camera, "OffsetY", 0, &local_error);
+		_set_integer (camera, priv->offset_y, "OffsetY", 0, &local_error);
 	if (width > 0 && local_error == NULL)
-		arv_camera_set_integer (camera, "Width", width, &local_error);
+		_set_integer (camera, priv->width, "Width", width, &local_error);
 	if (height > 0 && local_error == NULL)
-		arv_camera_set_integer (camera, "Height", height, &local_error);
+		_set_integer (camera, priv->height, "Height", height, &local_error);
 	if (x >= 0 && local_error == NULL)
-		arv_camera_set_integer (camera, "OffsetX", x, &local_error);
+		_set_integer (camera, priv->offset_x, "OffsetX", x, &local_error);
 	if (y >= 0 && local_error == NULL)
-		arv_camera_set_integer (camera, "OffsetY", y, &local_error);
+		_set_integer (camera, priv->offset_y, "OffsetY", y, &local_error);
 
 	if (local_error != NULL)
 		g_propagate_error (error, local_error);
@@ -278,18 +345,19 @@ arv_camera_set_region (ArvCamera *camera, gint x, gint y, gint width, gint heigh
 void
 arv_camera_get_region (ArvCamera *camera, gint *x, gint *y, gint *width, gint *height, GError **error)
 {
+	ArvCameraPrivate *priv = arv_camera_get_instance_private (camera);
 	GError *local_error = NULL;
 
 	g_return_if_fail (ARV_IS_CAMERA (camera));
 
 	if (x != NULL)
-		*x = arv_camera_get_integer (camera, "OffsetX", &local_error);
+		*x = _get_integer (camera, priv->offset_x, "OffsetX", &local_error);
 	if (y != NULL && local_error == NULL)
-		*y = arv_camera_get_integer (camera, "OffsetY", &local_error);
+		*y = _get_integer (camera, priv->offset_y, "OffsetY", &local_error);
 	if (width != NULL && local_error == NULL)
-		*width = arv_camera_get_integer (camera, "Width", &local_error);
+		*width = _get_integer (camera, priv->width, "Width", &local_error);
 	if (height != NULL && local_error == NULL)
-		*height = arv_camera_get_integer (camera, "Height", &local_error);
+		*height = _get_integer (camera, priv->height, "Height", &local_error);
 
 	if (local_error != NULL)
 		g_propagate_error (error, local_error);
@@ -570,7 +638,11 @@ arv_camera_get_y_binning_increment (ArvCamera *camera, GError **error)
 void
 arv_camera_set_pixel_format (ArvCamera *camera, ArvPixelFormat format, GError **error)
 {
-	arv_camera_set_integer (camera, "PixelFormat", format, error);
+	ArvCameraPrivate *priv = arv_camera_get_instance_private (camera);
+
+	g_return_if_fail (ARV_IS_CAMERA (camera));
+
+	_set_integer (camera, priv->pixel_format, "PixelFormat", format, error);
 }
 
 /**
@@ -603,7 +675,11 @@ arv_camera_set_pixel_format_from_string (ArvCamera *camera, const char * format,
 ArvPixelFormat
 arv_camera_get_pixel_format (ArvCamera *camera, GError **error)
 {
-	return arv_camera_get_integer (camera, "PixelFormat", error);
+	ArvCameraPrivate *priv = arv_camera_get_instance_private (camera);
+
+	g_return_val_if_fail (ARV_IS_CAMERA (camera), 0);
+
+	return _get_integer (camera, priv->pixel_format, "PixelFormat", error);
 }
 
 /**
@@ -697,7 +773,11 @@ arv_camera_get_available_pixel_formats_as_display_names (ArvCamera *camera, guin
 void
 arv_camera_start_acquisition (ArvCamera *camera, GError **error)
 {
-	arv_camera_execute_command (camera, "AcquisitionStart", error);
+	ArvCameraPrivate *priv = arv_camera_get_instance_private (camera);
+
+	g_return_if_fail (ARV_IS_CAMERA (camera));
+
+	_execute_command (camera, priv->acquisition_start, "AcquisitionStart", error);
 }
 
 /**
@@ -713,7 +793,11 @@ arv_camera_start_acquisition (ArvCamera *camera, GError **error)
 void
 arv_camera_stop_acquisition (ArvCamera *camera, GError **error)
 {
-	arv_camera_execute_command (camera, "AcquisitionStop", error);
+	ArvCameraPrivate *priv = arv_camera_get_instance_private (camera);
+
+	g_return_if_fail (ARV_IS_CAMERA (camera));
+
+	_execute_command (camera, priv->acquisition_stop, "AcquisitionStop", error);
 }
 
 /**
@@ -1317,7 +1401,11 @@ arv_camera_clear_triggers (ArvCamera* camera, GError **error)
 void
 arv_camera_software_trigger (ArvCamera *camera, GError **error)
 {
-	arv_camera_execute_command (camera, "TriggerSoftware", error);
+	ArvCameraPrivate *priv = arv_camera_get_instance_private (camera);
+
+	g_return_if_fail (ARV_IS_CAMERA (camera));
+
+	_execute_command (camera, priv->trigger_software, "TriggerSoftware", error);
 }
 
 /**
@@ -1350,22 +1438,22 @@ arv_camera_set_exposure_time (ArvCamera *camera, double exposure_time_us, GError
 				arv_camera_set_integer (camera, "ExposureTimeRaw", 1, &local_error);
 			break;
 		case ARV_CAMERA_SERIES_RICOH:
-			arv_camera_set_integer (camera, "ExposureTimeRaw", exposure_time_us, &local_error);
+			_set_integer (camera, priv->exposure_time, "ExposureTimeRaw", exposure_time_us, &local_error);
 			break;
 		case ARV_CAMERA_SERIES_XIMEA:
-			arv_camera_set_integer (camera, "ExposureTime", exposure_time_us, &local_error);
+			_set_integer (camera, priv->exposure_time, "ExposureTime", exposure_time_us, &local_error);
 			break;
 		case ARV_CAMERA_SERIES_MATRIX_VISION:
 			arv_camera_set_string (camera, "ExposureMode", "Timed", &local_error);
 			if (local_error == NULL)
-				arv_camera_set_float (camera, "ExposureTime", exposure_time_us, &local_error);
+				_set_float (camera, priv->exposure_time, "ExposureTime", exposure_time_us, &local_error);
 			break;
 		case ARV_CAMERA_SERIES_BASLER_ACE:
 		default:
-			arv_camera_set_float (camera,
-					      priv->has_exposure_time ?
-					      "ExposureTime" :
-					      "ExposureTimeAbs", exposure_time_us, &local_error);
+			_set_float (camera, priv->exposure_time,
+				    priv->has_exposure_time ?
+				    "ExposureTime" :
+				    "ExposureTimeAbs", exposure_time_us, &local_error);
 			break;
 	}
 
@@ -1392,14 +1480,16 @@ arv_camera_get_exposure_time (ArvCamera *camera, GError **error)
 
 	switch (priv->series) {
 		case ARV_CAMERA_SERIES_XIMEA:
-			return arv_camera_get_integer (camera,"ExposureTime", error);
+			return _get_integer (camera, priv->exposure_time, "ExposureTime", error);
 		case ARV_CAMERA_SERIES_RICOH:
-			return arv_camera_get_integer (camera,"ExposureTimeRaw", error);
+			return _get_integer (camera, priv->exposure_time, "ExposureTimeRaw", error);
+		case ARV_CAMERA_SERIES_MATRIX_VISION:
+			return _get_float (camera, priv->exposure_time, "ExposureTime", error);
 		default:
-			return arv_camera_get_float (camera,
-						     priv->has_exposure_time ?
-						     "ExposureTime" :
-						     "ExposureTimeAbs", error);
+			return _get_float (camera, priv->exposure_time,
+					   priv->has_exposure_time ?
+					   "ExposureTime" :
+					   "ExposureTimeAbs", error);
 	}
 }
 
@@ -1511,9 +1601,9 @@ arv_camera_set_gain (ArvCamera *camera, double gain, GError **error)
 		return;
 
 	if (priv->has_gain)
-		arv_camera_set_float (camera, "Gain", gain, error);
+		_set_float (camera, priv->gain, "Gain", gain, error);
 	else
-		arv_camera_set_integer (camera, "GainRaw", gain, error);
+		_set_integer (camera, priv->gain, "GainRaw", gain, error);
 }
 
 /**
@@ -1534,9 +1624,9 @@ arv_camera_get_gain (ArvCamera *camera, GError **error)
 	g_return_val_if_fail (ARV_IS_CAMERA (camera), 0.0);
 
 	if (priv->has_gain)
-		return arv_camera_get_float (camera, "Gain", error);
+		return _get_float (camera, priv->gain, "Gain", error);
 
-	return arv_camera_get_integer (camera, "GainRaw", error);
+	return _get_integer (camera, priv->gain, "GainRaw", error);
 }
 
 /**
@@ -1621,7 +1711,11 @@ arv_camera_get_gain_auto (ArvCamera *camera, GError **error)
 guint
 arv_camera_get_payload (ArvCamera *camera, GError **error)
 {
-	return arv_camera_get_integer (camera, "PayloadSize", error);
+	ArvCameraPrivate *priv = arv_camera_get_instance_private (camera);
+
+	g_return_val_if_fail (ARV_IS_CAMERA (camera), 0);
+
+	return _get_integer (camera, priv->payload_size, "PayloadSize", error);
 }
 
 /**
@@ -1797,6 +1891,41 @@ arv_camera_is_binning_available (ArvCamera *camera, GError **error)
 	return horizontal && vertical;
 }
 
+/* Handles of the features accessed by name are created on first use, and reused for the following accesses. Lookups
+ * only take the reader lock. */
+
+static ArvFeatureHandle *
+_get_feature_handle (ArvCamera *camera, const char *feature, GError **error)
+{
+	ArvCameraPrivate *priv = arv_camera_get_instance_private (camera);
+	ArvFeatureHandle *handle;
+	ArvFeatureHandle *new_handle;
+
+	g_return_val_if_fail (feature != NULL, NULL);
+
+	g_rw_lock_reader_lock (&priv->feature_handles_lock);
+	handle = g_hash_table_lookup (priv->feature_handles, feature);
+	g_rw_lock_reader_unlock (&priv->feature_handles_lock);
+
+	if (handle != NULL)
+		return handle;
+
+	new_handle = arv_device_get_feature_handle (priv->device, feature, error);
+	if (new_handle == NULL)
+		return NULL;
+
+	g_rw_lock_writer_lock (&priv->feature_handles_lock);
+	handle = g_hash_table_lookup (priv->feature_handles, feature);
+	if (handle == NULL) {
+		handle = new_handle;
+		g_hash_table_insert (priv->feature_handles, g_strdup (feature), handle);
+	} else
+		g_object_unref (new_handle);
+	g_rw_lock_writer_unlock (&priv->feature_handles_lock);
+
+	return handle;
+}
+
 /**
  * arv_camera_execute_command:
  * @camera: a #ArvCamera
@@ -1811,11 +1940,13 @@ arv_camera_is_binning_available (ArvCamera *camera, GError **error)
 void
 arv_camera_execute_command (ArvCamera *camera, const char *feature, GError **error)
 {
-	ArvCameraPrivate *priv = arv_camera_get_instance_private (camera);
+	ArvFeatureHandle *handle;
 
 	g_return_if_fail (ARV_IS_CAMERA (camera));
 
-	arv_device_execute_command (priv->device, feature, error);
+	handle = _get_feature_handle (camera, feature, error);
+	if (handle != NULL)
+		arv_feature_handle_execute (handle, error);
 }
 
 /**
@@ -1833,11 +1964,13 @@ arv_camera_execute_command (ArvCamera *camera, const char *feature, GError **err
 void
 arv_camera_set_boolean (ArvCamera *camera, const char *feature, gboolean value, GError **error)
 {
-	ArvCameraPrivate *priv = arv_camera_get_instance_private (camera);
+	ArvFeatureHandle *handle;
 
 	g_return_if_fail (ARV_IS_CAMERA (camera));
 
-	arv_device_set_boolean_feature_value (priv->device, feature, value, error);
+	handle = _get_feature_handle (camera, feature, error);
+	if (handle != NULL)
+		arv_feature_handle_set_boolean (handle, value, error);
 }
 
 /**
@@ -1854,11 +1987,15 @@ arv_camera_set_boolean (ArvCamera *camera, const char *feature, gboolean value,
 gboolean
 arv_camera_get_boolean (ArvCamera *camera, const char *feature, GError **error)
 {
-	ArvCameraPrivate *priv = arv_camera_get_instance_private (camera);
+	ArvFeatureHandle *handle;
 
 	g_return_val_if_fail (ARV_IS_CAMERA (camera), FALSE);
 
-	return arv_device_get_boolean_feature_value (priv->device, feature, error);
+	handle = _get_feature_handle (camera, feature, error);
+	if (handle != NULL)
+		return arv_feature_handle_get_boolean (handle, error);
+
+	return FALSE;
 }
 
 /**
@@ -1894,11 +2031,13 @@ arv_camera_get_boolean_gi (ArvCamera *camera, const char *feature, gboolean *val
 void
 arv_camera_set_string (ArvCamera *camera, const char *feature, const char *value, GError **error)
 {
-	ArvCameraPrivate *priv = arv_camera_get_instance_private (camera);
+	ArvFeatureHandle *handle;
 
 	g_return_if_fail (ARV_IS_CAMERA (camera));
 
-	arv_device_set_string_feature_value (priv->device, feature, value, error);
+	handle = _get_feature_handle (camera, feature, error);
+	if (handle != NULL)
+		arv_feature_handle_set_string (handle, value, error);
 }
 
 /**
@@ -1915,11 +2054,15 @@ arv_camera_set_string (ArvCamera *camera, const char *feature, const char *value
 const char *
 arv_camera_get_string (ArvCamera *camera, const char *feature, GError **error)
 {
-	ArvCameraPrivate *priv = arv_camera_get_instance_private (camera);
+	ArvFeatureHandle *handle;
 
 	g_return_val_if_fail (ARV_IS_CAMERA (camera), FALSE);
 
-	return arv_device_get_string_feature_value (priv->device, feature, error);
+	handle = _get_feature_handle (camera, feature, error);
+	if (handle != NULL)
+		return arv_feature_handle_get_string (handle, error);
+
+	return NULL;
 }
 
 /**
@@ -1937,11 +2080,13 @@ arv_camera_get_string (ArvCamera *camera, const char *feature, GError **error)
 void
 arv_camera_set_integer (ArvCamera *camera, const char *feature, gint64 value, GError **error)
 {
-	ArvCameraPrivate *priv = arv_camera_get_instance_private (camera);
+	ArvFeatureHandle *handle;
 
 	g_return_if_fail (ARV_IS_CAMERA (camera));
 
-	arv_device_set_integer_feature_value (priv->device, feature, value, error);
+	handle = _get_feature_handle (camera, feature, error);
+	if (handle != NULL)
+		arv_feature_handle_set_int64 (handle, value, error);
 }
 
 /**
@@ -1958,11 +2103,15 @@ arv_camera_set_integer (ArvCamera *camera, const char *feature, gint64 value, GE
 gint64
 arv_camera_get_integer (ArvCamera *camera, const char *feature, GError **error)
 {
-	ArvCameraPrivate *priv = arv_camera_get_instance_private (camera);
+	ArvFeatureHandle *handle;
 
 	g_return_val_if_fail (ARV_IS_CAMERA (camera), 0);
 
-	return arv_device_get_integer_feature_value (priv->device, feature, error);
+	handle = _get_feature_handle (camera, feature, error);
+	if (handle != NULL)
+		return arv_feature_handle_get_int64 (handle, error);
+
+	return 0;
 }
 
 /**
@@ -2108,11 +2257,13 @@ arv_camera_get_integer_bounds_as_double (ArvCamera *camera, const char *feature,
 void
 arv_camera_set_float (ArvCamera *camera, const char *feature, double value, GError **error)
 {
-	ArvCameraPrivate *priv = arv_camera_get_instance_private (camera);
+	ArvFeatureHandle *handle;
 
 	g_return_if_fail (ARV_IS_CAMERA (camera));
 
-	arv_device_set_float_feature_value (priv->device, feature, value, error);
+	handle = _get_feature_handle (camera, feature, error);
+	if (handle != NULL)
+		arv_feature_handle_set_double (handle, value, error);
 }
 
 /**
@@ -2129,11 +2280,15 @@ arv_camera_set_float (ArvCamera *camera, const char *feature, double value, GErr
 double
 arv_camera_get_float (ArvCamera *camera, const char *feature, GError **error)
 {
-	ArvCameraPrivate *priv = arv_camera_get_instance_private (camera);
+	ArvFeatureHandle *handle;
 
 	g_return_val_if_fail (ARV_IS_CAMERA (camera), 0.0);
 
-	return arv_device_get_float_feature_value (priv->device, feature, error);
+	handle = _get_feature_handle (camera, feature, error);
+	if (handle != NULL)
+		return arv_feature_handle_get_double (handle, error);
+
+	return 0.0;
 }
 
 /**
@@ -2380,7 +2535,8 @@ arv_camera_gv_set_packet_delay (ArvCamera *camera, gint64 delay_ns, GError **err
 	if (tick_frequency <= 0)
 		return;
 
-	value = tick_frequency * delay_ns / 1000000000LL;
+	/* Round up, a requested delay must never be shortened */
+	value = (tick_frequency * delay_ns + 999999999LL) / 1000000000LL;
 	arv_camera_set_integer (camera, "GevSCPD", value, error);
 }
 
@@ -2421,6 +2577,81 @@ arv_camera_gv_get_packet_delay (ArvCamera *camera, GError **error)
 	return value * 1000000000LL / tick_frequency;
 }
 
+/**
+ * arv_camera_gv_set_frame_transmission_delay:
+ * @camera: a #ArvCamera
+ * @delay_ns: frame transmission delay, in nanoseconds
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Configure the delay between the end of the image readout and the transmission of the first
+ * packet of the frame, for the current stream channel. Staggering this delay between cameras
+ * triggered at the same time avoids their frames colliding on a shared link.
+ *
+ * Since: 0.8.0
+ */
+
+void
+arv_camera_gv_set_frame_transmission_delay (ArvCamera *camera, gint64 delay_ns, GError **error)
+{
+	GError *local_error = NULL;
+	gint64 tick_frequency;
+	gint64 value;
+
+	if (delay_ns < 0)
+		return;
+
+	g_return_if_fail (arv_camera_is_gv_device (camera));
+
+	tick_frequency = arv_camera_get_integer (camera, "GevTimestampTickFrequency", &local_error);
+	if (local_error != NULL) {
+		g_propagate_error (error, local_error);
+		return;
+	}
+
+	if (tick_frequency <= 0)
+		return;
+
+	value = (tick_frequency * delay_ns + 999999999LL) / 1000000000LL;
+	arv_camera_set_integer (camera, "GevSCFTD", value, error);
+}
+
+/**
+ * arv_camera_gv_get_frame_transmission_delay:
+ * @camera: a #ArvCamera
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Returns: The frame transmission delay, in nanoseconds.
+ *
+ * Since: 0.8.0
+ */
+
+gint64
+arv_camera_gv_get_frame_transmission_delay (ArvCamera *camera, GError **error)
+{
+	GError *local_error = NULL;
+	gint64 tick_frequency;
+	gint64 value;
+
+	g_return_val_if_fail (arv_camera_is_gv_device (camera), 0);
+
+	tick_frequency = arv_camera_get_integer (camera, "GevTimestampTickFrequency", &local_error);
+	if (local_error != NULL) {
+		g_propagate_error (error, local_error);
+		return 0;
+	}
+
+	if (tick_frequency <= 0)
+		return 0;
+
+	value = arv_camera_get_integer (camera, "GevSCFTD", &local_error);
+	if (local_error != NULL) {
+		g_propagate_error (error, local_error);
+		return 0;
+	}
+
+	return value * 1000000000LL / tick_frequency;
+}
+
 /**
  * arv_camera_gv_set_packet_size:
  * @camera: a #ArvCamera
@@ -2823,11 +3054,29 @@ arv_camera_create_chunk_parser (ArvCamera *camera)
 
 ArvCamera *
 arv_camera_new (const char *name)
+{
+	return arv_camera_new_with_error (name, NULL);
+}
+
+/**
+ * arv_camera_new_with_error:
+ * @name: (allow-none): name of the camera.
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Same as arv_camera_new(), but reports why the camera could not be opened.
+ *
+ * Returns: a new #ArvCamera, %NULL on error.
+ *
+ * Since: 0.8.0
+ */
+
+ArvCamera *
+arv_camera_new_with_error (const char *name, GError **error)
 {
 	ArvCamera *camera;
 	ArvDevice *device;
 
-	device = arv_open_device (name);
+	device = arv_open_device_with_error (name, error);
 
 	if (!ARV_IS_DEVICE (device))
 		return NULL;
@@ -2845,6 +3094,10 @@ arv_camera_new (const char *name)
 static void
 arv_camera_init (ArvCamera *camera)
 {
+	ArvCameraPrivate *priv = arv_camera_get_instance_private (camera);
+
+	g_rw_lock_init (&priv->feature_handles_lock);
+	priv->feature_handles = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_object_unref);
 }
 
 static void
@@ -2852,6 +3105,20 @@ arv_camera_finalize (GObject *object)
 {
 	ArvCameraPrivate *priv = arv_camera_get_instance_private (ARV_CAMERA (object));
 
+	g_clear_object (&priv->offset_x);
+	g_clear_object (&priv->offset_y);
+	g_clear_object (&priv->width);
+	g_clear_object (&priv->height);
+	g_clear_object (&priv->pixel_format);
+	g_clear_object (&priv->payload_size);
+	g_clear_object (&priv->exposure_time);
+	g_clear_object (&priv->gain);
+	g_clear_object (&priv->acquisition_start);
+	g_clear_object (&priv->acquisition_stop);
+	g_clear_object (&priv->trigger_software);
+
+	g_clear_pointer (&priv->feature_handles, g_hash_table_unref);
+	g_rw_lock_clear (&priv->feature_handles_lock);
 	g_clear_object (&priv->device);
 
 	G_OBJECT_CLASS (arv_camera_parent_class)->finalize (object);
@@ -2867,6 +3134,7 @@ arv_camera_constructor (GType gtype, guint n_properties, GObjectConstructParam *
 	ArvCameraSeries series;
 	const char *vendor_name;
 	const char *model_name;
+	const char *exposure_time_feature;
 
 	object = G_OBJECT_CLASS (arv_camera_parent_class)->constructor (gtype, n_properties, properties);
 
@@ -2928,6 +3196,31 @@ arv_camera_constructor (GType gtype, guint n_properties, GObjectConstructParam *
 	priv->has_acquisition_frame_rate_enabled = ARV_IS_GC_INTEGER (arv_device_get_feature (priv->device,
 											      "AcquisitionFrameRateEnabled"));
 
+	priv->offset_x = arv_device_get_feature_handle (priv->device, "OffsetX", NULL);
+	priv->offset_y = arv_device_get_feature_handle (priv->device, "OffsetY", NULL);
+	priv->width = arv_device_get_feature_handle (priv->device, "Width", NULL);
+	priv->height = arv_device_get_feature_handle (priv->device, "Height", NULL);
+	priv->pixel_format = arv_device_get_feature_handle (priv->device, "PixelFormat", NULL);
+	priv->payload_size = arv_device_get_feature_handle (priv->device, "PayloadSize", NULL);
+	priv->gain = arv_device_get_feature_handle (priv->device, priv->has_gain ? "Gain" : "GainRaw", NULL);
+	priv->acquisition_start = arv_device_get_feature_handle (priv->device, "AcquisitionStart", NULL);
+	priv->acquisition_stop = arv_device_get_feature_handle (priv->device, "AcquisitionStop", NULL);
+	priv->trigger_software = arv_device_get_feature_handle (priv->device, "TriggerSoftware", NULL);
+
+	switch (series) {
+		case ARV_CAMERA_SERIES_RICOH:
+			exposure_time_feature = "ExposureTimeRaw";
+			break;
+		case ARV_CAMERA_SERIES_XIMEA:
+		case ARV_CAMERA_SERIES_MATRIX_VISION:
+			exposure_time_feature = "ExposureTime";
+			break;
+		default:
+			exposure_time_feature = priv->has_exposure_time ? "ExposureTime" : "ExposureTimeAbs";
+			break;
+	}
+	priv->exposure_time = arv_device_get_feature_handle (priv->device, exposure_time_feature, NULL);
+
     return object;
 }
 
@@ -41,6 +41,7 @@ struct _ArvCameraClass {
 };
 
 ArvCamera *	arv_camera_new			(const char *name);
+ArvCamera *	arv_camera_new_with_error	(const char *name, GError **error);
 ArvDevice *	arv_camera_get_device		(ArvCamera *camera);
 
 ArvStream *	arv_camera_create_stream	(ArvCamera *camera, ArvStreamCallback callback, void *user_data);
@@ -174,6 +175,8 @@ int 		arv_camera_gv_get_current_stream_channel(ArvCamera *camera, GError **error
 
 void		arv_camera_gv_set_packet_delay		(ArvCamera *camera, gint64 delay_ns, GError **error);
 gint64 		arv_camera_gv_get_packet_delay 		(ArvCamera *camera, GError **error);
+void		arv_camera_gv_set_frame_transmission_delay	(ArvCamera *camera, gint64 delay_ns, GError **error);
+gint64		arv_camera_gv_get_frame_transmission_delay	(ArvCamera *camera, GError **error);
 void 		arv_camera_gv_set_packet_size 		(ArvCamera *camera, gint packet_size, GError **error);
 guint		arv_camera_gv_get_packet_size		(ArvCamera *camera, GError **error);
 guint		arv_camera_gv_auto_packet_size		(ArvCamera *camera, GError **error);
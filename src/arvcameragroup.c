@@ -0,0 +1,434 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2019 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel@gnome.org>
+ */
+
+/**
+ * SECTION: arvcameragroup
+ * @short_description: Concurrent opening and configuration of a set of cameras
+ *
+ * #ArvCameraGroup opens a list of cameras concurrently, using a bounded pool
+ * of worker threads, and applies a common feature set to all of them in
+ * parallel. The time spent and the error encountered are recorded for each
+ * camera, a failure on one camera does not prevent the others from being
+ * opened or configured.
+ *
+ * During the group creation, GigE Vision cameras of the same model, device
+ * version and Genicam url share a single download of the Genicam data.
+ *
+ * <informalexample>
+ * <programlisting>
+ * const char *device_ids[] = {"Basler-21322519", "Basler-21322520", NULL};
+ * const char *features[] = {"PixelFormat", "ExposureTime"};
+ * const char *values[] = {"Mono8", "1000"};
+ * ArvCameraGroup *group;
+ *
+ * group = arv_camera_group_new (device_ids, 0);
+ * if (!arv_camera_group_set_features (group, features, values, 2, &error))
+ *         for (i = 0; i < arv_camera_group_get_n_cameras (group); i++)
+ *                 if (arv_camera_group_get_error (group, i) != NULL)
+ *                         g_print ("%s: %s\n", arv_camera_group_get_device_id (group, i),
+ *                                  arv_camera_group_get_error (group, i)->message);
+ * </programlisting>
+ * </informalexample>
+ */
+
+#include <arvcameragroup.h>
+#include <arvcamera.h>
+#include <arvdevice.h>
+#include <arvgcfeaturenode.h>
+#include <arvgvdeviceprivate.h>
+#include <arvdebug.h>
+
+/* Default maximum number of concurrent worker threads */
+#define ARV_CAMERA_GROUP_DEFAULT_N_WORKERS	16
+
+typedef struct {
+	char *device_id;
+	ArvCamera *camera;
+
+	/* Error of the last operation on this camera */
+	GError *error;
+
+	guint64 open_duration;
+	guint64 configuration_duration;
+} ArvCameraGroupMember;
+
+typedef struct {
+	const char **features;
+	const char **values;
+	guint n_features;
+} ArvCameraGroupConfiguration;
+
+typedef struct {
+	ArvCameraGroupMember *members;
+	guint n_members;
+	guint n_workers;
+} ArvCameraGroupPrivate;
+
+struct _ArvCameraGroup {
+	GObject	object;
+
+	ArvCameraGroupPrivate *priv;
+};
+
+struct _ArvCameraGroupClass {
+	GObjectClass parent_class;
+};
+
+G_DEFINE_TYPE_WITH_CODE (ArvCameraGroup, arv_camera_group, G_TYPE_OBJECT, G_ADD_PRIVATE (ArvCameraGroup))
+
+/* Each worker only accesses the member it is given, no locking is needed */
+
+static void
+_open_worker (gpointer data, gpointer user_data)
+{
+	ArvCameraGroupMember *member = data;
+	gint64 start_time;
+
+	start_time = g_get_monotonic_time ();
+	member->camera = arv_camera_new_with_error (member->device_id, &member->error);
+	member->open_duration = g_get_monotonic_time () - start_time;
+
+	arv_debug_device ("[ArvCameraGroup::open] '%s' %s in %" G_GUINT64_FORMAT " µs",
+			  member->device_id, member->error == NULL ? "opened" : member->error->message,
+			  member->open_duration);
+}
+
+static void
+_configuration_worker (gpointer data, gpointer user_data)
+{
+	ArvCameraGroupMember *member = data;
+	ArvCameraGroupConfiguration *configuration = user_data;
+	ArvDevice *device;
+	gint64 start_time;
+	guint i;
+
+	g_clear_error (&member->error);
+
+	start_time = g_get_monotonic_time ();
+
+	device = arv_camera_get_device (member->camera);
+
+	/* Features are applied in the given order, as some of them may depend on the previous ones (selectors) */
+	for (i = 0; i < configuration->n_features && member->error == NULL; i++) {
+		ArvGcNode *node;
+
+		node = arv_device_get_feature (device, configuration->features[i]);
+		if (ARV_IS_GC_FEATURE_NODE (node))
+			arv_gc_feature_node_set_value_from_string (ARV_GC_FEATURE_NODE (node),
+								   configuration->values[i], &member->error);
+		else
+			g_set_error (&member->error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_FEATURE_NOT_FOUND,
+				     "[ArvCameraGroup::set_features] Feature '%s' not found on '%s'",
+				     configuration->features[i], member->device_id);
+	}
+
+	member->configuration_duration = g_get_monotonic_time () - start_time;
+}
+
+static void
+_run_workers (ArvCameraGroup *group, GFunc worker, gpointer user_data, gboolean opened_only)
+{
+	GThreadPool *pool;
+	guint i;
+
+	pool = g_thread_pool_new (worker, user_data, group->priv->n_workers, FALSE, NULL);
+	if (pool == NULL) {
+		for (i = 0; i < group->priv->n_members; i++)
+			if (!opened_only || group->priv->members[i].camera != NULL)
+				worker (&group->priv->members[i], user_data);
+		return;
+	}
+
+	for (i = 0; i < group->priv->n_members; i++)
+		if (!opened_only || group->priv->members[i].camera != NULL)
+			g_thread_pool_push (pool, &group->priv->members[i], NULL);
+
+	/* Wait for the completion of all the pending tasks */
+	g_thread_pool_free (pool, FALSE, TRUE);
+}
+
+/**
+ * arv_camera_group_new:
+ * @device_ids: (array zero-terminated=1): a %NULL terminated list of device ids
+ * @n_workers: maximum number of cameras opened at the same time, 0 for a default value
+ *
+ * Opens concurrently the cameras listed in @device_ids. The call returns once
+ * all the open attempts are finished. A camera that could not be opened is
+ * kept in the group, with a %NULL #ArvCamera and an error available using
+ * arv_camera_group_get_error().
+ *
+ * Returns: a new #ArvCameraGroup.
+ *
+ * Since: 0.8.0
+ */
+
+ArvCameraGroup *
+arv_camera_group_new (const char **device_ids, guint n_workers)
+{
+	ArvCameraGroup *group;
+	guint i;
+
+	group = g_object_new (ARV_TYPE_CAMERA_GROUP, NULL);
+
+	group->priv->n_members = device_ids != NULL ? g_strv_length ((char **) device_ids) : 0;
+	group->priv->members = g_new0 (ArvCameraGroupMember, group->priv->n_members);
+	for (i = 0; i < group->priv->n_members; i++)
+		group->priv->members[i].device_id = g_strdup (device_ids[i]);
+
+	if (n_workers == 0)
+		n_workers = MIN (group->priv->n_members, ARV_CAMERA_GROUP_DEFAULT_N_WORKERS);
+	group->priv->n_workers = MAX (n_workers, 1);
+
+	if (group->priv->n_members == 0)
+		return group;
+
+	arv_gv_device_retain_genicam_cache ();
+	_run_workers (group, _open_worker, group, FALSE);
+	arv_gv_device_release_genicam_cache ();
+
+	return group;
+}
+
+/**
+ * arv_camera_group_get_n_cameras:
+ * @group: a #ArvCameraGroup
+ *
+ * Returns: the number of cameras of the group, including the ones that could not be opened.
+ *
+ * Since: 0.8.0
+ */
+
+guint
+arv_camera_group_get_n_cameras (ArvCameraGroup *group)
+{
+	g_return_val_if_fail (ARV_IS_CAMERA_GROUP (group), 0);
+
+	return group->priv->n_members;
+}
+
+/**
+ * arv_camera_group_get_n_opened_cameras:
+ * @group: a #ArvCameraGroup
+ *
+ * Returns: the number of successfully opened cameras.
+ *
+ * Since: 0.8.0
+ */
+
+guint
+arv_camera_group_get_n_opened_cameras (ArvCameraGroup *group)
+{
+	guint n_opened = 0;
+	guint i;
+
+	g_return_val_if_fail (ARV_IS_CAMERA_GROUP (group), 0);
+
+	for (i = 0; i < group->priv->n_members; i++)
+		if (group->priv->members[i].camera != NULL)
+			n_opened++;
+
+	return n_opened;
+}
+
+/**
+ * arv_camera_group_get_device_id:
+ * @group: a #ArvCameraGroup
+ * @index: camera index
+ *
+ * Returns: the device id used for opening the camera at @index.
+ *
+ * Since: 0.8.0
+ */
+
+const char *
+arv_camera_group_get_device_id (ArvCameraGroup *group, guint index)
+{
+	g_return_val_if_fail (ARV_IS_CAMERA_GROUP (group), NULL);
+	g_return_val_if_fail (index < group->priv->n_members, NULL);
+
+	return group->priv->members[index].device_id;
+}
+
+/**
+ * arv_camera_group_get_camera:
+ * @group: a #ArvCameraGroup
+ * @index: camera index
+ *
+ * Returns: (transfer none): the camera at @index, %NULL if it could not be opened.
+ *
+ * Since: 0.8.0
+ */
+
+ArvCamera *
+arv_camera_group_get_camera (ArvCameraGroup *group, guint index)
+{
+	g_return_val_if_fail (ARV_IS_CAMERA_GROUP (group), NULL);
+	g_return_val_if_fail (index < group->priv->n_members, NULL);
+
+	return group->priv->members[index].camera;
+}
+
+/**
+ * arv_camera_group_get_error:
+ * @group: a #ArvCameraGroup
+ * @index: camera index
+ *
+ * Returns: (transfer none): the error of the last operation on the camera at @index, %NULL if it succeeded.
+ *
+ * Since: 0.8.0
+ */
+
+const GError *
+arv_camera_group_get_error (ArvCameraGroup *group, guint index)
+{
+	g_return_val_if_fail (ARV_IS_CAMERA_GROUP (group), NULL);
+	g_return_val_if_fail (index < group->priv->n_members, NULL);
+
+	return group->priv->members[index].error;
+}
+
+/**
+ * arv_camera_group_get_open_duration:
+ * @group: a #ArvCameraGroup
+ * @index: camera index
+ *
+ * Returns: the time spent opening the camera at @index, in µs.
+ *
+ * Since: 0.8.0
+ */
+
+guint64
+arv_camera_group_get_open_duration (ArvCameraGroup *group, guint index)
+{
+	g_return_val_if_fail (ARV_IS_CAMERA_GROUP (group), 0);
+	g_return_val_if_fail (index < group->priv->n_members, 0);
+
+	return group->priv->members[index].open_duration;
+}
+
+/**
+ * arv_camera_group_get_configuration_duration:
+ * @group: a #ArvCameraGroup
+ * @index: camera index
+ *
+ * Returns: the time spent during the last call to arv_camera_group_set_features() for the camera at @index, in µs.
+ *
+ * Since: 0.8.0
+ */
+
+guint64
+arv_camera_group_get_configuration_duration (ArvCameraGroup *group, guint index)
+{
+	g_return_val_if_fail (ARV_IS_CAMERA_GROUP (group), 0);
+	g_return_val_if_fail (index < group->priv->n_members, 0);
+
+	return group->priv->members[index].configuration_duration;
+}
+
+/**
+ * arv_camera_group_set_features:
+ * @group: a #ArvCameraGroup
+ * @features: (array length=n_features): feature names
+ * @values: (array length=n_features): feature values, as strings
+ * @n_features: number of features
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Sets the given features on all the opened cameras of the group. The cameras
+ * are configured in parallel, while the features are set on each camera in
+ * the given order. The configuration of a camera stops at its first error.
+ * Per camera errors and timings are available using
+ * arv_camera_group_get_error() and
+ * arv_camera_group_get_configuration_duration().
+ *
+ * Returns: %TRUE if all the opened cameras were successfully configured.
+ *
+ * Since: 0.8.0
+ */
+
+gboolean
+arv_camera_group_set_features (ArvCameraGroup *group,
+			       const char **features, const char **values, guint n_features,
+			       GError **error)
+{
+	ArvCameraGroupConfiguration configuration;
+	ArvCameraGroupMember *first_failure = NULL;
+	guint n_failures = 0;
+	guint i;
+
+	g_return_val_if_fail (ARV_IS_CAMERA_GROUP (group), FALSE);
+	g_return_val_if_fail (n_features == 0 || (features != NULL && values != NULL), FALSE);
+
+	configuration.features = features;
+	configuration.values = values;
+	configuration.n_features = n_features;
+
+	_run_workers (group, _configuration_worker, &configuration, TRUE);
+
+	for (i = 0; i < group->priv->n_members; i++) {
+		ArvCameraGroupMember *member = &group->priv->members[i];
+
+		if (member->camera != NULL && member->error != NULL) {
+			if (first_failure == NULL)
+				first_failure = member;
+			n_failures++;
+		}
+	}
+
+	if (first_failure != NULL) {
+		g_set_error (error, first_failure->error->domain, first_failure->error->code,
+			     "[ArvCameraGroup::set_features] Configuration failed on %u camera(s), first error on '%s': %s",
+			     n_failures, first_failure->device_id, first_failure->error->message);
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+static void
+arv_camera_group_init (ArvCameraGroup *group)
+{
+	group->priv = arv_camera_group_get_instance_private (group);
+}
+
+static void
+_finalize (GObject *object)
+{
+	ArvCameraGroup *group = ARV_CAMERA_GROUP (object);
+	guint i;
+
+	for (i = 0; i < group->priv->n_members; i++) {
+		g_clear_object (&group->priv->members[i].camera);
+		g_clear_error (&group->priv->members[i].error);
+		g_free (group->priv->members[i].device_id);
+	}
+	g_clear_pointer (&group->priv->members, g_free);
+
+	G_OBJECT_CLASS (arv_camera_group_parent_class)->finalize (object);
+}
+
+static void
+arv_camera_group_class_init (ArvCameraGroupClass *this_class)
+{
+	GObjectClass *object_class = G_OBJECT_CLASS (this_class);
+
+	object_class->finalize = _finalize;
+}
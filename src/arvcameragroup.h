@@ -0,0 +1,53 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2019 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel@gnome.org>
+ */
+
+#ifndef ARV_CAMERA_GROUP_H
+#define ARV_CAMERA_GROUP_H
+
+#if !defined (ARV_H_INSIDE) && !defined (ARAVIS_COMPILATION)
+#error "Only <arv.h> can be included directly."
+#endif
+
+#include <arvtypes.h>
+
+G_BEGIN_DECLS
+
+#define ARV_TYPE_CAMERA_GROUP             (arv_camera_group_get_type ())
+G_DECLARE_FINAL_TYPE (ArvCameraGroup, arv_camera_group, ARV, CAMERA_GROUP, GObject)
+
+ArvCameraGroup *	arv_camera_group_new				(const char **device_ids, guint n_workers);
+
+guint			arv_camera_group_get_n_cameras			(ArvCameraGroup *group);
+guint			arv_camera_group_get_n_opened_cameras		(ArvCameraGroup *group);
+const char *		arv_camera_group_get_device_id			(ArvCameraGroup *group, guint index);
+ArvCamera *		arv_camera_group_get_camera			(ArvCameraGroup *group, guint index);
+const GError *		arv_camera_group_get_error			(ArvCameraGroup *group, guint index);
+guint64			arv_camera_group_get_open_duration		(ArvCameraGroup *group, guint index);
+guint64			arv_camera_group_get_configuration_duration	(ArvCameraGroup *group, guint index);
+
+gboolean		arv_camera_group_set_features			(ArvCameraGroup *group,
+									 const char **features, const char **values,
+									 guint n_features, GError **error);
+
+G_END_DECLS
+
+#endif
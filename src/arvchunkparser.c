@@ -237,6 +237,79 @@ arv_chunk_parser_get_float_value (ArvChunkParser *parser, ArvBuffer *buffer, con
 	return value;
 }
 
+/**
+ * arv_chunk_parser_get_values:
+ * @parser: a #ArvChunkParser
+ * @buffer: a #ArvBuffer with a #ARV_BUFFER_PAYLOAD_TYPE_CHUNK_DATA payload
+ * @chunks: (array length=n_values): chunk data names
+ * @values: (array length=n_values) (out caller-allocates): value placeholders
+ * @n_values: number of chunk data to retrieve
+ * @error: a #GError placeholder
+ *
+ * Retrieves several chunk data values at once. This is more efficient than
+ * the use of the single value accessors, as the buffer is bound to the parser
+ * only once, and the chunk layout of @buffer is only indexed once.
+ *
+ * @values must be either zero-filled or initialized #GValue. On return, each
+ * value holds a #G_TYPE_BOOLEAN, #G_TYPE_INT64, #G_TYPE_DOUBLE or
+ * #G_TYPE_STRING value, depending on the chunk feature type. Enumeration
+ * values are returned as strings. They must be unset using g_value_unset().
+ *
+ * Returns: %TRUE on success, %FALSE if one of the chunk data could not be
+ * retrieved.
+ *
+ * Since: 0.8.0
+ */
+
+gboolean
+arv_chunk_parser_get_values (ArvChunkParser *parser, ArvBuffer *buffer,
+			     const char **chunks, GValue *values, guint n_values, GError **error)
+{
+	GError *local_error = NULL;
+	guint i;
+
+	g_return_val_if_fail (ARV_IS_CHUNK_PARSER (parser), FALSE);
+	g_return_val_if_fail (ARV_IS_BUFFER (buffer), FALSE);
+	g_return_val_if_fail (n_values == 0 || (chunks != NULL && values != NULL), FALSE);
+
+	arv_gc_set_buffer (parser->priv->genicam, buffer);
+
+	for (i = 0; i < n_values && local_error == NULL; i++) {
+		ArvGcNode *node;
+
+		if (G_IS_VALUE (&values[i]))
+			g_value_unset (&values[i]);
+
+		node = arv_gc_get_node (parser->priv->genicam, chunks[i]);
+
+		if (ARV_IS_GC_BOOLEAN (node)) {
+			g_value_init (&values[i], G_TYPE_BOOLEAN);
+			g_value_set_boolean (&values[i], arv_gc_boolean_get_value (ARV_GC_BOOLEAN (node),
+										   &local_error));
+		} else if (ARV_IS_GC_FLOAT (node)) {
+			g_value_init (&values[i], G_TYPE_DOUBLE);
+			g_value_set_double (&values[i], arv_gc_float_get_value (ARV_GC_FLOAT (node), &local_error));
+		} else if (ARV_IS_GC_STRING (node)) {
+			g_value_init (&values[i], G_TYPE_STRING);
+			g_value_set_string (&values[i], arv_gc_string_get_value (ARV_GC_STRING (node), &local_error));
+		} else if (ARV_IS_GC_INTEGER (node)) {
+			g_value_init (&values[i], G_TYPE_INT64);
+			g_value_set_int64 (&values[i], arv_gc_integer_get_value (ARV_GC_INTEGER (node), &local_error));
+		} else {
+			g_set_error (&local_error, ARV_CHUNK_PARSER_ERROR, ARV_CHUNK_PARSER_ERROR_INVALID_FEATURE_TYPE,
+				     "Node '%s' is not a chunk data value", chunks[i]);
+		}
+	}
+
+	if (local_error != NULL) {
+		arv_warning_chunk ("%s", local_error->message);
+		g_propagate_error (error, local_error);
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
 /**
  * arv_chunk_parser_new:
  * @xml: XML genicam data
@@ -61,6 +61,9 @@ gint64			arv_chunk_parser_get_integer_value	(ArvChunkParser *parser, ArvBuffer *
 								 const char *chunk, GError **error);
 double			arv_chunk_parser_get_float_value	(ArvChunkParser *parser, ArvBuffer *buffer,
 								 const char *chunk, GError **error);
+gboolean		arv_chunk_parser_get_values		(ArvChunkParser *parser, ArvBuffer *buffer,
+								 const char **chunks, GValue *values, guint n_values,
+								 GError **error);
 
 G_END_DECLS
 
@@ -0,0 +1,344 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2019 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel@gnome.org>
+ */
+
+/**
+ * SECTION: arvclockmodel
+ * @short_description: Device to host clock model
+ *
+ * #ArvClockModel maps a device clock onto the host clock, from pairs of
+ * simultaneous device and host times. The offset and the drift between the
+ * two clocks are estimated by a weighted linear regression over the last
+ * samples, a sample weight being inversely proportional to the square of its
+ * uncertainty, usually half the round trip time of the device timestamp
+ * latch request.
+ *
+ * It is used by #ArvDevice, see arv_device_sample_clock(). An accurate model
+ * allows the fusion of the camera frames with the data of other sensors
+ * timestamped by the host, without the need of PTP hardware.
+ */
+
+#include <arvclockmodel.h>
+#include <math.h>
+
+/* Number of samples used for the regression. With the 5 second sampling period of the GigE Vision heartbeat, this
+ * is long enough to average the latch jitter out, and short enough to track thermal drift. */
+#define ARV_CLOCK_MODEL_N_SAMPLES		32
+/* Minimum sample uncertainty, in ns, as host time is only known with a microsecond resolution */
+#define ARV_CLOCK_MODEL_MIN_UNCERTAINTY		500
+
+typedef struct {
+	guint64 device_time;
+	gint64 offset;		/* host time - device time */
+	double weight;
+} ArvClockModelSample;
+
+typedef struct {
+	GMutex mutex;
+
+	ArvClockModelSample samples[ARV_CLOCK_MODEL_N_SAMPLES];
+	guint n_samples;
+	guint sample_index;
+
+	/* Fitted offset is reference_offset + offset_correction + drift * (device_time - reference_device_time) */
+	guint64 reference_device_time;
+	gint64 reference_offset;
+	double offset_correction;
+	double drift;
+} ArvClockModelPrivate;
+
+struct _ArvClockModel {
+	GObject	object;
+
+	ArvClockModelPrivate *priv;
+};
+
+struct _ArvClockModelClass {
+	GObjectClass parent_class;
+};
+
+G_DEFINE_TYPE_WITH_CODE (ArvClockModel, arv_clock_model, G_TYPE_OBJECT, G_ADD_PRIVATE (ArvClockModel))
+
+/* Called with the model mutex locked. Values are taken relative to the last sample, for the sake of the double
+ * precision. */
+
+static void
+_update_regression (ArvClockModel *model)
+{
+	ArvClockModelPrivate *priv = model->priv;
+	ArvClockModelSample *last_sample;
+	double sum_w = 0.0, sum_wx = 0.0, sum_wy = 0.0;
+	double mean_x, mean_y;
+	double sxx = 0.0, sxy = 0.0;
+	guint i;
+
+	last_sample = &priv->samples[(priv->sample_index + ARV_CLOCK_MODEL_N_SAMPLES - 1) % ARV_CLOCK_MODEL_N_SAMPLES];
+
+	priv->reference_device_time = last_sample->device_time;
+	priv->reference_offset = last_sample->offset;
+
+	for (i = 0; i < priv->n_samples; i++) {
+		double x = (gint64) (priv->samples[i].device_time - priv->reference_device_time);
+		double y = priv->samples[i].offset - priv->reference_offset;
+
+		sum_w += priv->samples[i].weight;
+		sum_wx += priv->samples[i].weight * x;
+		sum_wy += priv->samples[i].weight * y;
+	}
+
+	mean_x = sum_wx / sum_w;
+	mean_y = sum_wy / sum_w;
+
+	for (i = 0; i < priv->n_samples; i++) {
+		double x = (gint64) (priv->samples[i].device_time - priv->reference_device_time) - mean_x;
+		double y = (priv->samples[i].offset - priv->reference_offset) - mean_y;
+
+		sxx += priv->samples[i].weight * x * x;
+		sxy += priv->samples[i].weight * x * y;
+	}
+
+	/* A single sample, or samples at the same device time, only give the offset */
+	priv->drift = sxx > 0.0 ? sxy / sxx : 0.0;
+	priv->offset_correction = mean_y - priv->drift * mean_x;
+}
+
+/**
+ * arv_clock_model_new:
+ *
+ * Returns: a new empty #ArvClockModel.
+ *
+ * Since: 0.8.0
+ */
+
+ArvClockModel *
+arv_clock_model_new (void)
+{
+	return g_object_new (ARV_TYPE_CLOCK_MODEL, NULL);
+}
+
+/**
+ * arv_clock_model_add_sample:
+ * @model: a #ArvClockModel
+ * @device_time: device time, in ns
+ * @host_time: host time at @device_time, in ns
+ * @uncertainty: uncertainty of @host_time, in ns
+ *
+ * Adds a pair of simultaneous device and host times to @model, replacing the oldest sample if the regression
+ * window is full. If the device clock went backward, for example after a timestamp reset, the previous samples
+ * are discarded.
+ *
+ * Since: 0.8.0
+ */
+
+void
+arv_clock_model_add_sample (ArvClockModel *model, guint64 device_time, guint64 host_time, guint64 uncertainty)
+{
+	ArvClockModelPrivate *priv;
+	ArvClockModelSample *sample;
+	double u;
+
+	g_return_if_fail (ARV_IS_CLOCK_MODEL (model));
+
+	priv = model->priv;
+
+	g_mutex_lock (&priv->mutex);
+
+	if (priv->n_samples > 0 && device_time < priv->reference_device_time) {
+		priv->n_samples = 0;
+		priv->sample_index = 0;
+	}
+
+	u = MAX (uncertainty, ARV_CLOCK_MODEL_MIN_UNCERTAINTY);
+
+	sample = &priv->samples[priv->sample_index];
+	sample->device_time = device_time;
+	sample->offset = (gint64) (host_time - device_time);
+	sample->weight = 1.0 / (u * u);
+
+	priv->sample_index = (priv->sample_index + 1) % ARV_CLOCK_MODEL_N_SAMPLES;
+	if (priv->n_samples < ARV_CLOCK_MODEL_N_SAMPLES)
+		priv->n_samples++;
+
+	_update_regression (model);
+
+	g_mutex_unlock (&priv->mutex);
+}
+
+/**
+ * arv_clock_model_reset:
+ * @model: a #ArvClockModel
+ *
+ * Discards all the samples of @model.
+ *
+ * Since: 0.8.0
+ */
+
+void
+arv_clock_model_reset (ArvClockModel *model)
+{
+	g_return_if_fail (ARV_IS_CLOCK_MODEL (model));
+
+	g_mutex_lock (&model->priv->mutex);
+
+	model->priv->n_samples = 0;
+	model->priv->sample_index = 0;
+	model->priv->offset_correction = 0.0;
+	model->priv->drift = 0.0;
+
+	g_mutex_unlock (&model->priv->mutex);
+}
+
+/**
+ * arv_clock_model_get_n_samples:
+ * @model: a #ArvClockModel
+ *
+ * Returns: the number of samples currently used by the regression. The drift is only estimated from two samples.
+ *
+ * Since: 0.8.0
+ */
+
+guint
+arv_clock_model_get_n_samples (ArvClockModel *model)
+{
+	guint n_samples;
+
+	g_return_val_if_fail (ARV_IS_CLOCK_MODEL (model), 0);
+
+	g_mutex_lock (&model->priv->mutex);
+	n_samples = model->priv->n_samples;
+	g_mutex_unlock (&model->priv->mutex);
+
+	return n_samples;
+}
+
+/**
+ * arv_clock_model_get_host_timestamp:
+ * @model: a #ArvClockModel
+ * @device_time: a device time, in ns
+ *
+ * Converts a device time, for example a buffer timestamp given by arv_buffer_get_timestamp(), to the host time
+ * base.
+ *
+ * Returns: the host equivalent of @device_time, in ns, 0 if @model has no sample.
+ *
+ * Since: 0.8.0
+ */
+
+guint64
+arv_clock_model_get_host_timestamp (ArvClockModel *model, guint64 device_time)
+{
+	ArvClockModelPrivate *priv;
+	guint64 host_time = 0;
+
+	g_return_val_if_fail (ARV_IS_CLOCK_MODEL (model), 0);
+
+	priv = model->priv;
+
+	g_mutex_lock (&priv->mutex);
+
+	if (priv->n_samples > 0) {
+		double correction;
+
+		correction = priv->offset_correction +
+			priv->drift * (double) (gint64) (device_time - priv->reference_device_time);
+		host_time = device_time + priv->reference_offset + (gint64) round (correction);
+	}
+
+	g_mutex_unlock (&priv->mutex);
+
+	return host_time;
+}
+
+/**
+ * arv_clock_model_get_offset:
+ * @model: a #ArvClockModel
+ *
+ * Returns: the estimated host time minus device time at the last sample, in ns.
+ *
+ * Since: 0.8.0
+ */
+
+gint64
+arv_clock_model_get_offset (ArvClockModel *model)
+{
+	gint64 offset = 0;
+
+	g_return_val_if_fail (ARV_IS_CLOCK_MODEL (model), 0);
+
+	g_mutex_lock (&model->priv->mutex);
+
+	if (model->priv->n_samples > 0)
+		offset = model->priv->reference_offset + (gint64) round (model->priv->offset_correction);
+
+	g_mutex_unlock (&model->priv->mutex);
+
+	return offset;
+}
+
+/**
+ * arv_clock_model_get_drift:
+ * @model: a #ArvClockModel
+ *
+ * Returns: the estimated rate difference between the host clock and the device clock, in parts per million. A
+ * positive value means the host clock is faster than the device clock.
+ *
+ * Since: 0.8.0
+ */
+
+double
+arv_clock_model_get_drift (ArvClockModel *model)
+{
+	double drift;
+
+	g_return_val_if_fail (ARV_IS_CLOCK_MODEL (model), 0.0);
+
+	g_mutex_lock (&model->priv->mutex);
+	drift = model->priv->drift * 1e6;
+	g_mutex_unlock (&model->priv->mutex);
+
+	return drift;
+}
+
+static void
+arv_clock_model_init (ArvClockModel *model)
+{
+	model->priv = arv_clock_model_get_instance_private (model);
+
+	g_mutex_init (&model->priv->mutex);
+}
+
+static void
+_finalize (GObject *object)
+{
+	ArvClockModel *model = ARV_CLOCK_MODEL (object);
+
+	g_mutex_clear (&model->priv->mutex);
+
+	G_OBJECT_CLASS (arv_clock_model_parent_class)->finalize (object);
+}
+
+static void
+arv_clock_model_class_init (ArvClockModelClass *this_class)
+{
+	GObjectClass *object_class = G_OBJECT_CLASS (this_class);
+
+	object_class->finalize = _finalize;
+}
@@ -0,0 +1,50 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2019 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel@gnome.org>
+ */
+
+#ifndef ARV_CLOCK_MODEL_H
+#define ARV_CLOCK_MODEL_H
+
+#if !defined (ARV_H_INSIDE) && !defined (ARAVIS_COMPILATION)
+#error "Only <arv.h> can be included directly."
+#endif
+
+#include <arvtypes.h>
+
+G_BEGIN_DECLS
+
+#define ARV_TYPE_CLOCK_MODEL             (arv_clock_model_get_type ())
+G_DECLARE_FINAL_TYPE (ArvClockModel, arv_clock_model, ARV, CLOCK_MODEL, GObject)
+
+ArvClockModel *	arv_clock_model_new			(void);
+
+void		arv_clock_model_add_sample		(ArvClockModel *model, guint64 device_time, guint64 host_time,
+							 guint64 uncertainty);
+void		arv_clock_model_reset			(ArvClockModel *model);
+
+guint		arv_clock_model_get_n_samples		(ArvClockModel *model);
+guint64		arv_clock_model_get_host_timestamp	(ArvClockModel *model, guint64 device_time);
+gint64		arv_clock_model_get_offset		(ArvClockModel *model);
+double		arv_clock_model_get_drift		(ArvClockModel *model);
+
+G_END_DECLS
+
+#endif
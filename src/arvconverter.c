@@ -0,0 +1,1098 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2019 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel@gnome.org>
+ */
+
+/**
+ * SECTION: arvconverter
+ * @short_description: Pixel format conversion pipeline
+ *
+ * #ArvConverter applies a sequence of pixel conversion steps to images:
+ * unpacking of packed pixel formats, Bayer demosaicing, windowing of 10 to 16 bit pixels to 8 bit, red and
+ * blue channel swap, addition of an opaque alpha channel, YUV 4:2:2 to RGB conversion, and 8 bit look-up tables.
+ * Each step accepts the output format of the previous one.
+ *
+ * The steps are fused: the image is converted row by row, each row going
+ * through all the steps while it is in the processor cache, using small
+ * row buffers for the intermediate results. The rows are grouped in bands,
+ * sized such that the input and output data of a band fit in the level 2
+ * cache, which are distributed to a thread pool shared by all the converters
+ * and arv_demosaic().
+ *
+ * Demosaicing needs the rows above and below the converted one. When it
+ * follows the unpacking of a packed Bayer format, each thread keeps a window
+ * of the last three unpacked rows, such that every input row is unpacked only
+ * once per band.
+ *
+ * A converter without any step copies the image, which is useful to change
+ * the row stride.
+ *
+ * <informalexample>
+ * <programlisting>
+ * ArvConverter *converter;
+ *
+ * converter = arv_converter_new (ARV_PIXEL_FORMAT_BAYER_RG_8);
+ * arv_converter_add_demosaic (converter, ARV_DEMOSAIC_METHOD_BILINEAR, FALSE, NULL);
+ * arv_converter_add_lut (converter, gamma_lut, NULL);
+ *
+ * arv_converter_process_buffer (converter, buffer, rgb_buffer, &error);
+ * </programlisting>
+ * </informalexample>
+ */
+
+#include <arvconverter.h>
+#include <arvconverterprivate.h>
+#include <arvdemosaicprivate.h>
+#include <arvpixelunpack.h>
+#include <arvbufferprivate.h>
+#include <arvdebug.h>
+#include <string.h>
+
+/* Input and output data of a band of rows, sized for a level 2 cache */
+#define ARV_CONVERTER_BAND_SIZE		(128 * 1024)
+
+typedef enum {
+	ARV_CONVERTER_STEP_UNPACK,
+	ARV_CONVERTER_STEP_DEMOSAIC,
+	ARV_CONVERTER_STEP_WINDOW,
+	ARV_CONVERTER_STEP_SWAP_RED_BLUE,
+	ARV_CONVERTER_STEP_ALPHA,
+	ARV_CONVERTER_STEP_YUV_TO_RGB,
+	ARV_CONVERTER_STEP_LUT
+} ArvConverterStepType;
+
+typedef struct {
+	ArvConverterStepType type;
+	ArvPixelFormat input_format;
+	ArvPixelFormat output_format;
+
+	guint n_samples;		/* Samples per pixel, for window, swap and lut */
+	guint sample_size;		/* Sample size in bytes, for swap */
+
+	ArvDemosaicMethod method;	/* Demosaic */
+	gboolean bgr;			/* Demosaic and YUV */
+	gboolean is_uyvy;		/* YUV */
+
+	guint low;			/* Window */
+	guint range;
+	guint32 scale;
+
+	guint8 lut[256];
+} ArvConverterStep;
+
+typedef struct {
+	ArvPixelFormat input_format;
+	ArvPixelFormat output_format;
+
+	GArray *steps;
+
+	guint n_threads;
+	ArvSimdIsa isa;
+} ArvConverterPrivate;
+
+struct _ArvConverter {
+	GObject	object;
+
+	ArvConverterPrivate *priv;
+};
+
+struct _ArvConverterClass {
+	GObjectClass parent_class;
+};
+
+G_DEFINE_TYPE_WITH_CODE (ArvConverter, arv_converter, G_TYPE_OBJECT, G_ADD_PRIVATE (ArvConverter))
+
+GQuark
+arv_converter_error_quark (void)
+{
+	return g_quark_from_static_string ("arv-converter-error-quark");
+}
+
+typedef struct {
+	ArvPixelFormat input_format;
+	ArvPixelFormat output_format;
+} ArvConverterFormatPair;
+
+static const ArvConverterFormatPair arv_converter_window_formats[] = {
+	{ARV_PIXEL_FORMAT_MONO_10,		ARV_PIXEL_FORMAT_MONO_8},
+	{ARV_PIXEL_FORMAT_MONO_12,		ARV_PIXEL_FORMAT_MONO_8},
+	{ARV_PIXEL_FORMAT_MONO_14,		ARV_PIXEL_FORMAT_MONO_8},
+	{ARV_PIXEL_FORMAT_MONO_16,		ARV_PIXEL_FORMAT_MONO_8},
+	{ARV_PIXEL_FORMAT_BAYER_GR_10,		ARV_PIXEL_FORMAT_BAYER_GR_8},
+	{ARV_PIXEL_FORMAT_BAYER_RG_10,		ARV_PIXEL_FORMAT_BAYER_RG_8},
+	{ARV_PIXEL_FORMAT_BAYER_GB_10,		ARV_PIXEL_FORMAT_BAYER_GB_8},
+	{ARV_PIXEL_FORMAT_BAYER_BG_10,		ARV_PIXEL_FORMAT_BAYER_BG_8},
+	{ARV_PIXEL_FORMAT_BAYER_GR_12,		ARV_PIXEL_FORMAT_BAYER_GR_8},
+	{ARV_PIXEL_FORMAT_BAYER_RG_12,		ARV_PIXEL_FORMAT_BAYER_RG_8},
+	{ARV_PIXEL_FORMAT_BAYER_GB_12,		ARV_PIXEL_FORMAT_BAYER_GB_8},
+	{ARV_PIXEL_FORMAT_BAYER_BG_12,		ARV_PIXEL_FORMAT_BAYER_BG_8},
+	{ARV_PIXEL_FORMAT_BAYER_GR_16,		ARV_PIXEL_FORMAT_BAYER_GR_8},
+	{ARV_PIXEL_FORMAT_BAYER_RG_16,		ARV_PIXEL_FORMAT_BAYER_RG_8},
+	{ARV_PIXEL_FORMAT_BAYER_GB_16,		ARV_PIXEL_FORMAT_BAYER_GB_8},
+	{ARV_PIXEL_FORMAT_BAYER_BG_16,		ARV_PIXEL_FORMAT_BAYER_BG_8},
+	{ARV_PIXEL_FORMAT_RGB_10_PACKED,	ARV_PIXEL_FORMAT_RGB_8_PACKED},
+	{ARV_PIXEL_FORMAT_RGB_12_PACKED,	ARV_PIXEL_FORMAT_RGB_8_PACKED},
+	{ARV_PIXEL_FORMAT_RGB_16_PACKED,	ARV_PIXEL_FORMAT_RGB_8_PACKED},
+	{ARV_PIXEL_FORMAT_BGR_10_PACKED,	ARV_PIXEL_FORMAT_BGR_8_PACKED},
+	{ARV_PIXEL_FORMAT_BGR_12_PACKED,	ARV_PIXEL_FORMAT_BGR_8_PACKED},
+	{ARV_PIXEL_FORMAT_BGR_16_PACKED,	ARV_PIXEL_FORMAT_BGR_8_PACKED}
+};
+
+static const ArvConverterFormatPair arv_converter_swap_formats[] = {
+	{ARV_PIXEL_FORMAT_RGB_8_PACKED,		ARV_PIXEL_FORMAT_BGR_8_PACKED},
+	{ARV_PIXEL_FORMAT_RGBA_8_PACKED,	ARV_PIXEL_FORMAT_BGRA_8_PACKED},
+	{ARV_PIXEL_FORMAT_RGB_10_PACKED,	ARV_PIXEL_FORMAT_BGR_10_PACKED},
+	{ARV_PIXEL_FORMAT_RGB_12_PACKED,	ARV_PIXEL_FORMAT_BGR_12_PACKED},
+	{ARV_PIXEL_FORMAT_RGB_16_PACKED,	ARV_PIXEL_FORMAT_BGR_16_PACKED}
+};
+
+static const ArvConverterFormatPair arv_converter_alpha_formats[] = {
+	{ARV_PIXEL_FORMAT_RGB_8_PACKED,		ARV_PIXEL_FORMAT_RGBA_8_PACKED},
+	{ARV_PIXEL_FORMAT_BGR_8_PACKED,		ARV_PIXEL_FORMAT_BGRA_8_PACKED}
+};
+
+static const ArvPixelFormat arv_converter_lut_formats[] = {
+	ARV_PIXEL_FORMAT_MONO_8,
+	ARV_PIXEL_FORMAT_BAYER_GR_8,
+	ARV_PIXEL_FORMAT_BAYER_RG_8,
+	ARV_PIXEL_FORMAT_BAYER_GB_8,
+	ARV_PIXEL_FORMAT_BAYER_BG_8,
+	ARV_PIXEL_FORMAT_RGB_8_PACKED,
+	ARV_PIXEL_FORMAT_BGR_8_PACKED,
+	ARV_PIXEL_FORMAT_RGBA_8_PACKED,
+	ARV_PIXEL_FORMAT_BGRA_8_PACKED
+};
+
+/* Size of a row, 0 if the row does not end on a byte boundary */
+
+static size_t
+_get_row_size (ArvPixelFormat pixel_format, guint width)
+{
+	guint64 n_bits = (guint64) width * ARV_PIXEL_FORMAT_BIT_PER_PIXEL (pixel_format);
+
+	return (n_bits % 8) == 0 ? n_bits / 8 : 0;
+}
+
+static void
+_set_invalid_format_error (ArvConverter *converter, const char *step, GError **error)
+{
+	g_set_error (error, ARV_CONVERTER_ERROR, ARV_CONVERTER_ERROR_INVALID_PIXEL_FORMAT,
+		     "[Converter::add_%s] Pixel format 0x%08x not supported", step, converter->priv->output_format);
+}
+
+static void
+_add_step (ArvConverter *converter, ArvConverterStep *step)
+{
+	step->input_format = converter->priv->output_format;
+
+	g_array_append_vals (converter->priv->steps, step, 1);
+
+	converter->priv->output_format = step->output_format;
+}
+
+/**
+ * arv_converter_add_unpack:
+ * @converter: a #ArvConverter
+ *
+ * Adds an unpacking of a packed pixel format to 16 bit pixels, see
+ * arv_pixel_unpack(). The rows are unpacked one by one, which requires image
+ * widths such that the packed rows end on a byte boundary.
+ *
+ * Returns: %TRUE on success.
+ *
+ * Since: 0.8.0
+ */
+
+gboolean
+arv_converter_add_unpack (ArvConverter *converter, GError **error)
+{
+	ArvConverterStep step = {0};
+
+	g_return_val_if_fail (ARV_IS_CONVERTER (converter), FALSE);
+
+	step.output_format = arv_pixel_format_get_unpacked_format (converter->priv->output_format);
+	if (step.output_format == 0) {
+		_set_invalid_format_error (converter, "unpack", error);
+		return FALSE;
+	}
+
+	step.type = ARV_CONVERTER_STEP_UNPACK;
+
+	_add_step (converter, &step);
+
+	return TRUE;
+}
+
+/**
+ * arv_converter_add_demosaic:
+ * @converter: a #ArvConverter
+ * @method: interpolation method
+ * @bgr: %TRUE for a BGR output, %FALSE for RGB
+ *
+ * Adds a Bayer to RGB or BGR conversion, see arv_demosaic(). As the
+ * interpolation uses the neighbour rows, this must be the first step, or
+ * follow the unpacking of a packed Bayer format.
+ *
+ * Returns: %TRUE on success.
+ *
+ * Since: 0.8.0
+ */
+
+gboolean
+arv_converter_add_demosaic (ArvConverter *converter, ArvDemosaicMethod method, gboolean bgr, GError **error)
+{
+	ArvConverterStep step = {0};
+
+	g_return_val_if_fail (ARV_IS_CONVERTER (converter), FALSE);
+	g_return_val_if_fail (method <= ARV_DEMOSAIC_METHOD_EDGE_AWARE, FALSE);
+
+	if (converter->priv->steps->len > 1 ||
+	    (converter->priv->steps->len == 1 &&
+	     g_array_index (converter->priv->steps, ArvConverterStep, 0).type != ARV_CONVERTER_STEP_UNPACK)) {
+		g_set_error (error, ARV_CONVERTER_ERROR, ARV_CONVERTER_ERROR_INVALID_STEP,
+			     "[Converter::add_demosaic] Demosaicing must be the first step, or follow an unpacking");
+		return FALSE;
+	}
+
+	step.output_format = arv_demosaic_get_output_format (converter->priv->output_format, bgr);
+	if (step.output_format == 0) {
+		_set_invalid_format_error (converter, "demosaic", error);
+		return FALSE;
+	}
+
+	step.type = ARV_CONVERTER_STEP_DEMOSAIC;
+	step.method = method;
+	step.bgr = bgr;
+
+	_add_step (converter, &step);
+
+	return TRUE;
+}
+
+/**
+ * arv_converter_add_window:
+ * @converter: a #ArvConverter
+ * @low: pixel value mapped to 0
+ * @high: pixel value mapped to 255
+ *
+ * Adds a conversion of 10, 12, 14 or 16 bit monochrome, Bayer, RGB or BGR
+ * pixels to the corresponding 8 bit format. The values between @low and
+ * @high are linearly scaled to the [0,255] range, the values outside of this
+ * window are clamped.
+ *
+ * Returns: %TRUE on success.
+ *
+ * Since: 0.8.0
+ */
+
+gboolean
+arv_converter_add_window (ArvConverter *converter, guint16 low, guint16 high, GError **error)
+{
+	ArvConverterStep step = {0};
+	guint i;
+
+	g_return_val_if_fail (ARV_IS_CONVERTER (converter), FALSE);
+
+	if (high <= low) {
+		g_set_error (error, ARV_CONVERTER_ERROR, ARV_CONVERTER_ERROR_INVALID_PARAMETER,
+			     "[Converter::add_window] Empty window [%u,%u]", low, high);
+		return FALSE;
+	}
+
+	for (i = 0; i < G_N_ELEMENTS (arv_converter_window_formats); i++)
+		if (arv_converter_window_formats[i].input_format == converter->priv->output_format)
+			step.output_format = arv_converter_window_formats[i].output_format;
+
+	if (step.output_format == 0) {
+		_set_invalid_format_error (converter, "window", error);
+		return FALSE;
+	}
+
+	step.type = ARV_CONVERTER_STEP_WINDOW;
+	step.n_samples = ARV_PIXEL_FORMAT_BIT_PER_PIXEL (step.output_format) / 8;
+	step.low = low;
+	step.range = high - low;
+	/* 16.16 fixed point scale factor, (range - 1) * scale + 0x8000 is below 256 << 16 */
+	step.scale = ((255u << 16) + step.range / 2) / step.range;
+
+	_add_step (converter, &step);
+
+	return TRUE;
+}
+
+/**
+ * arv_converter_add_swap_red_blue:
+ * @converter: a #ArvConverter
+ *
+ * Adds a conversion from RGB to BGR, or from BGR to RGB, with 8 or 16 bit
+ * samples, or from RGBA 8 to BGRA 8 and the opposite.
+ *
+ * Returns: %TRUE on success.
+ *
+ * Since: 0.8.0
+ */
+
+gboolean
+arv_converter_add_swap_red_blue (ArvConverter *converter, GError **error)
+{
+	ArvConverterStep step = {0};
+	guint i;
+
+	g_return_val_if_fail (ARV_IS_CONVERTER (converter), FALSE);
+
+	for (i = 0; i < G_N_ELEMENTS (arv_converter_swap_formats); i++) {
+		if (arv_converter_swap_formats[i].input_format == converter->priv->output_format)
+			step.output_format = arv_converter_swap_formats[i].output_format;
+		else if (arv_converter_swap_formats[i].output_format == converter->priv->output_format)
+			step.output_format = arv_converter_swap_formats[i].input_format;
+	}
+
+	if (step.output_format == 0) {
+		_set_invalid_format_error (converter, "swap_red_blue", error);
+		return FALSE;
+	}
+
+	step.type = ARV_CONVERTER_STEP_SWAP_RED_BLUE;
+	/* RGBA 8 is the only 4 channel format */
+	step.n_samples = ARV_PIXEL_FORMAT_BIT_PER_PIXEL (step.output_format) == 32 ? 4 : 3;
+	step.sample_size = ARV_PIXEL_FORMAT_BIT_PER_PIXEL (step.output_format) == 48 ? 2 : 1;
+
+	_add_step (converter, &step);
+
+	return TRUE;
+}
+
+/**
+ * arv_converter_add_alpha:
+ * @converter: a #ArvConverter
+ *
+ * Adds a conversion from 8 bit RGB to RGBA, or from BGR to BGRA, with an
+ * opaque alpha channel. This gives the 4 byte pixels expected by most
+ * display systems.
+ *
+ * Returns: %TRUE on success.
+ *
+ * Since: 0.8.0
+ */
+
+gboolean
+arv_converter_add_alpha (ArvConverter *converter, GError **error)
+{
+	ArvConverterStep step = {0};
+	guint i;
+
+	g_return_val_if_fail (ARV_IS_CONVERTER (converter), FALSE);
+
+	for (i = 0; i < G_N_ELEMENTS (arv_converter_alpha_formats); i++)
+		if (arv_converter_alpha_formats[i].input_format == converter->priv->output_format)
+			step.output_format = arv_converter_alpha_formats[i].output_format;
+
+	if (step.output_format == 0) {
+		_set_invalid_format_error (converter, "alpha", error);
+		return FALSE;
+	}
+
+	step.type = ARV_CONVERTER_STEP_ALPHA;
+
+	_add_step (converter, &step);
+
+	return TRUE;
+}
+
+/**
+ * arv_converter_add_yuv_to_rgb:
+ * @converter: a #ArvConverter
+ * @bgr: %TRUE for a BGR output, %FALSE for RGB
+ *
+ * Adds a conversion of YUV 4:2:2 pixels, in the UYVY order
+ * (%ARV_PIXEL_FORMAT_YUV_422_PACKED) or in the YUYV order
+ * (%ARV_PIXEL_FORMAT_YUV_422_YUYV_PACKED), to 8 bit RGB or BGR, using the
+ * ITU-R BT.601 coefficients. The image width must be even.
+ *
+ * Returns: %TRUE on success.
+ *
+ * Since: 0.8.0
+ */
+
+gboolean
+arv_converter_add_yuv_to_rgb (ArvConverter *converter, gboolean bgr, GError **error)
+{
+	ArvConverterStep step = {0};
+
+	g_return_val_if_fail (ARV_IS_CONVERTER (converter), FALSE);
+
+	if (converter->priv->output_format != ARV_PIXEL_FORMAT_YUV_422_PACKED &&
+	    converter->priv->output_format != ARV_PIXEL_FORMAT_YUV_422_YUYV_PACKED) {
+		_set_invalid_format_error (converter, "yuv_to_rgb", error);
+		return FALSE;
+	}
+
+	step.type = ARV_CONVERTER_STEP_YUV_TO_RGB;
+	step.output_format = bgr ? ARV_PIXEL_FORMAT_BGR_8_PACKED : ARV_PIXEL_FORMAT_RGB_8_PACKED;
+	step.bgr = bgr;
+	step.is_uyvy = converter->priv->output_format == ARV_PIXEL_FORMAT_YUV_422_PACKED;
+
+	_add_step (converter, &step);
+
+	return TRUE;
+}
+
+/**
+ * arv_converter_add_lut:
+ * @converter: a #ArvConverter
+ * @lut: (array fixed-size=256): look-up table
+ *
+ * Adds a replacement of each sample value v of 8 bit pixels by lut[v]. All the
+ * channels, including alpha, go through the same table.
+ *
+ * Returns: %TRUE on success.
+ *
+ * Since: 0.8.0
+ */
+
+gboolean
+arv_converter_add_lut (ArvConverter *converter, const guint8 *lut, GError **error)
+{
+	ArvConverterStep step = {0};
+	guint i;
+
+	g_return_val_if_fail (ARV_IS_CONVERTER (converter), FALSE);
+	g_return_val_if_fail (lut != NULL, FALSE);
+
+	for (i = 0; i < G_N_ELEMENTS (arv_converter_lut_formats); i++)
+		if (arv_converter_lut_formats[i] == converter->priv->output_format)
+			step.output_format = converter->priv->output_format;
+
+	if (step.output_format == 0) {
+		_set_invalid_format_error (converter, "lut", error);
+		return FALSE;
+	}
+
+	step.type = ARV_CONVERTER_STEP_LUT;
+	step.n_samples = ARV_PIXEL_FORMAT_BIT_PER_PIXEL (step.output_format) / 8;
+	memcpy (step.lut, lut, sizeof (step.lut));
+
+	_add_step (converter, &step);
+
+	return TRUE;
+}
+
+/* Row conversions */
+
+static void
+_window_row (const ArvConverterStep *step, const guint16 *input, guint8 *output, guint width)
+{
+	size_t n_samples = (size_t) width * step->n_samples;
+	size_t i;
+
+	for (i = 0; i < n_samples; i++) {
+		guint value = input[i] > step->low ? input[i] - step->low : 0;
+
+		output[i] = value >= step->range ? 255 : (value * step->scale + 0x8000) >> 16;
+	}
+}
+
+static void
+_swap_red_blue_row (const ArvConverterStep *step, const guint8 *input, guint8 *output, guint width)
+{
+	size_t pixel_size = step->n_samples * step->sample_size;
+	size_t sample_size = step->sample_size;
+	size_t i;
+
+	for (i = 0; i < width; i++) {
+		const guint8 *in = input + i * pixel_size;
+		guint8 *out = output + i * pixel_size;
+
+		memcpy (out, in + 2 * sample_size, sample_size);
+		memcpy (out + sample_size, in + sample_size, sample_size);
+		memcpy (out + 2 * sample_size, in, sample_size);
+		if (step->n_samples == 4)
+			out[3] = in[3];
+	}
+}
+
+static void
+_alpha_row (const ArvConverterStep *step, const guint8 *input, guint8 *output, guint width)
+{
+	size_t i;
+
+	for (i = 0; i < width; i++) {
+		output[4 * i] = input[3 * i];
+		output[4 * i + 1] = input[3 * i + 1];
+		output[4 * i + 2] = input[3 * i + 2];
+		output[4 * i + 3] = 0xff;
+	}
+}
+
+/* Takes the value before the final division by 256 */
+
+static inline guint8
+_clamp_8 (int value)
+{
+	return value < 0 ? 0 : value > 0xffff ? 255 : value >> 8;
+}
+
+static inline void
+_yuv_to_rgb_pixel (int y, int u, int v, gboolean bgr, guint8 *output)
+{
+	int c = 298 * (y - 16) + 128;
+	int d = u - 128;
+	int e = v - 128;
+
+	output[bgr ? 2 : 0] = _clamp_8 (c + 409 * e);
+	output[1] = _clamp_8 (c - 100 * d - 208 * e);
+	output[bgr ? 0 : 2] = _clamp_8 (c + 516 * d);
+}
+
+static void
+_yuv_to_rgb_row (const ArvConverterStep *step, const guint8 *input, guint8 *output, guint width)
+{
+	guint i;
+
+	for (i = 0; i + 1 < width; i += 2) {
+		const guint8 *in = input + 2 * i;
+		int y0, y1, u, v;
+
+		if (step->is_uyvy) {
+			u = in[0]; y0 = in[1]; v = in[2]; y1 = in[3];
+		} else {
+			y0 = in[0]; u = in[1]; y1 = in[2]; v = in[3];
+		}
+
+		_yuv_to_rgb_pixel (y0, u, v, step->bgr, output + 3 * i);
+		_yuv_to_rgb_pixel (y1, u, v, step->bgr, output + 3 * i + 3);
+	}
+}
+
+static void
+_lut_row (const ArvConverterStep *step, const guint8 *input, guint8 *output, guint width)
+{
+	size_t n_samples = (size_t) width * step->n_samples;
+	size_t i;
+
+	for (i = 0; i < n_samples; i++)
+		output[i] = step->lut[input[i]];
+}
+
+typedef struct {
+	ArvConverter *converter;
+
+	const guint8 *input;
+	size_t input_stride;
+	size_t input_row_size;
+	guint width;
+	guint height;
+	guint8 *output;
+	size_t output_stride;
+
+	size_t scratch_row_size;
+	gboolean has_unpacked_window;	/* Demosaicing of unpacked rows */
+	guint rows_per_band;
+	guint n_bands;
+	gint next_band;		/* Atomic access */
+} ArvConverterJob;
+
+/* Row buffers of a thread */
+
+typedef struct {
+	guint8 *rows[2];		/* Intermediate results, alternately written and read by the steps */
+	guint8 *window[3];		/* Last unpacked rows, indexed by row modulo 3 */
+	guint window_y[3];
+} ArvConverterScratch;
+
+static const guint8 *
+_get_unpacked_row (ArvConverterJob *job, const ArvConverterStep *unpack_step, guint y, ArvConverterScratch *scratch)
+{
+	guint slot = y % 3;
+
+	if (scratch->window_y[slot] != y) {
+		arv_pixel_unpack (unpack_step->input_format, job->input + y * job->input_stride, job->input_row_size,
+				  (guint16 *) scratch->window[slot], job->width);
+		scratch->window_y[slot] = y;
+	}
+
+	return scratch->window[slot];
+}
+
+static void
+_demosaic_unpacked_row (ArvConverterJob *job, const ArvConverterStep *unpack_step, const ArvConverterStep *step,
+			guint y, ArvConverterScratch *scratch, guint8 *output)
+{
+	guint y_above = y > 0 ? y - 1 : 1;
+	guint y_below = y + 1 < job->height ? y + 1 : job->height - 2;
+	const guint8 *above = _get_unpacked_row (job, unpack_step, y_above, scratch);
+	const guint8 *current = _get_unpacked_row (job, unpack_step, y, scratch);
+	const guint8 *below = _get_unpacked_row (job, unpack_step, y_below, scratch);
+
+	arv_demosaic_row_with_neighbours (job->converter->priv->isa, step->input_format, above, current, below,
+					  job->width, y, step->bgr, step->method, output);
+}
+
+static void
+_process_row (ArvConverterJob *job, guint y, ArvConverterScratch *scratch)
+{
+	GArray *steps = job->converter->priv->steps;
+	const guint8 *input = job->input + y * job->input_stride;
+	guint8 *output = job->output + y * job->output_stride;
+	guint i;
+
+	if (steps->len == 0) {
+		memcpy (output, input, job->input_row_size);
+		return;
+	}
+
+	for (i = 0; i < steps->len; i++) {
+		const ArvConverterStep *step = &g_array_index (steps, ArvConverterStep, i);
+		guint8 *step_output = i + 1 == steps->len ? output : scratch->rows[i % 2];
+
+		/* The rows feeding a demosaicing are unpacked in its window */
+		if (step->type == ARV_CONVERTER_STEP_UNPACK && job->has_unpacked_window)
+			continue;
+
+		switch (step->type) {
+			case ARV_CONVERTER_STEP_UNPACK:
+				arv_pixel_unpack (step->input_format, input, job->input_row_size,
+						  (guint16 *) step_output, job->width);
+				break;
+			case ARV_CONVERTER_STEP_DEMOSAIC:
+				if (job->has_unpacked_window)
+					_demosaic_unpacked_row (job, &g_array_index (steps, ArvConverterStep, 0), step,
+								y, scratch, step_output);
+				else
+					arv_demosaic_row (job->converter->priv->isa, step->input_format,
+							  job->input, job->input_stride, job->width, job->height, y,
+							  step->bgr, step->method, step_output);
+				break;
+			case ARV_CONVERTER_STEP_WINDOW:
+				_window_row (step, (const guint16 *) input, step_output, job->width);
+				break;
+			case ARV_CONVERTER_STEP_SWAP_RED_BLUE:
+				_swap_red_blue_row (step, input, step_output, job->width);
+				break;
+			case ARV_CONVERTER_STEP_ALPHA:
+				_alpha_row (step, input, step_output, job->width);
+				break;
+			case ARV_CONVERTER_STEP_YUV_TO_RGB:
+				_yuv_to_rgb_row (step, input, step_output, job->width);
+				break;
+			case ARV_CONVERTER_STEP_LUT:
+				_lut_row (step, input, step_output, job->width);
+				break;
+		}
+
+		input = step_output;
+	}
+}
+
+/* Processes bands until there is none left. Run by the calling thread and the thread pool workers. */
+
+static void
+_process_bands (gpointer data)
+{
+	ArvConverterJob *job = data;
+	ArvConverterScratch scratch;
+	guint n_rows = job->has_unpacked_window ? 5 : 2;
+	guint8 *rows;
+	gint band;
+	guint i;
+
+	rows = g_malloc (n_rows * job->scratch_row_size);
+	for (i = 0; i < 2; i++)
+		scratch.rows[i] = rows + i * job->scratch_row_size;
+	for (i = 0; i < 3; i++) {
+		scratch.window[i] = job->has_unpacked_window ? rows + (2 + i) * job->scratch_row_size : NULL;
+		scratch.window_y[i] = G_MAXUINT;
+	}
+
+	while ((band = g_atomic_int_add (&job->next_band, 1)) < (gint) job->n_bands) {
+		guint y_end = MIN ((band + 1) * job->rows_per_band, job->height);
+		guint y;
+
+		for (y = band * job->rows_per_band; y < y_end; y++)
+			_process_row (job, y, &scratch);
+	}
+
+	g_free (rows);
+}
+
+/* The workers of all the conversions are taken from a single pool, created on first use and kept until the end of
+ * the process, so that converting a stream of images does not create any thread. */
+
+typedef struct {
+	ArvConverterWorkerFunc func;
+	gpointer data;
+
+	GMutex mutex;
+	GCond cond;
+	guint n_pending_workers;
+} ArvConverterTask;
+
+static void
+_thread_pool_func (gpointer data, gpointer user_data)
+{
+	ArvConverterTask *task = data;
+
+	task->func (task->data);
+
+	g_mutex_lock (&task->mutex);
+	task->n_pending_workers--;
+	if (task->n_pending_workers == 0)
+		g_cond_signal (&task->cond);
+	g_mutex_unlock (&task->mutex);
+}
+
+static GThreadPool *
+_get_thread_pool (void)
+{
+	static gsize thread_pool = 0;
+
+	if (g_once_init_enter (&thread_pool)) {
+		GThreadPool *pool;
+
+		pool = g_thread_pool_new (_thread_pool_func, NULL, MAX ((gint) g_get_num_processors () - 1, 1),
+					  FALSE, NULL);
+
+		g_once_init_leave (&thread_pool, (gsize) pool);
+	}
+
+	return (GThreadPool *) thread_pool;
+}
+
+/* Runs @func in the calling thread and in @n_workers threads of the shared pool, and waits for all of them. @func
+ * must take its work from @data until there is none left, as the workers may start after the calling thread has
+ * done everything. */
+
+void
+arv_converter_run_workers (ArvConverterWorkerFunc func, gpointer data, guint n_workers)
+{
+	ArvConverterTask task;
+	GThreadPool *thread_pool;
+	guint i;
+
+	if (n_workers == 0) {
+		func (data);
+		return;
+	}
+
+	thread_pool = _get_thread_pool ();
+
+	task.func = func;
+	task.data = data;
+	g_mutex_init (&task.mutex);
+	g_cond_init (&task.cond);
+	task.n_pending_workers = n_workers;
+
+	for (i = 0; i < n_workers; i++)
+		g_thread_pool_push (thread_pool, &task, NULL);
+
+	func (data);
+
+	g_mutex_lock (&task.mutex);
+	while (task.n_pending_workers > 0)
+		g_cond_wait (&task.cond, &task.mutex);
+	g_mutex_unlock (&task.mutex);
+
+	g_cond_clear (&task.cond);
+	g_mutex_clear (&task.mutex);
+}
+
+static guint
+_get_n_threads (ArvConverter *converter)
+{
+	return converter->priv->n_threads > 0 ? converter->priv->n_threads : g_get_num_processors ();
+}
+
+/**
+ * arv_converter_process:
+ * @converter: a #ArvConverter
+ * @input: input image
+ * @input_stride: distance between two input rows, in bytes
+ * @width: image width
+ * @height: image height
+ * @output: output image
+ * @output_stride: distance between two output rows, in bytes
+ *
+ * Converts an image. The pixel formats must not have rows ending in the
+ * middle of a byte. This function may be called from several threads at
+ * the same time, but not while steps are added.
+ *
+ * Returns: %TRUE on success.
+ *
+ * Since: 0.8.0
+ */
+
+gboolean
+arv_converter_process (ArvConverter *converter,
+		       const void *input, size_t input_stride,
+		       guint width, guint height,
+		       void *output, size_t output_stride,
+		       GError **error)
+{
+	ArvConverterPrivate *priv;
+	ArvConverterJob job = {0};
+	size_t output_row_size;
+	guint i;
+
+	g_return_val_if_fail (ARV_IS_CONVERTER (converter), FALSE);
+	g_return_val_if_fail (input != NULL, FALSE);
+	g_return_val_if_fail (output != NULL, FALSE);
+
+	priv = converter->priv;
+
+	job.input_row_size = _get_row_size (priv->input_format, width);
+	output_row_size = _get_row_size (priv->output_format, width);
+
+	if (width == 0 || height == 0 || job.input_row_size == 0 || output_row_size == 0 ||
+	    input_stride < job.input_row_size || output_stride < output_row_size) {
+		g_set_error (error, ARV_CONVERTER_ERROR, ARV_CONVERTER_ERROR_INVALID_GEOMETRY,
+			     "[Converter::process] Invalid geometry (%ux%u, strides %" G_GSIZE_FORMAT
+			     ", %" G_GSIZE_FORMAT ")", width, height, input_stride, output_stride);
+		return FALSE;
+	}
+
+	for (i = 0; i < priv->steps->len; i++) {
+		const ArvConverterStep *step = &g_array_index (priv->steps, ArvConverterStep, i);
+
+		if ((step->type == ARV_CONVERTER_STEP_DEMOSAIC && (width < 2 || height < 2)) ||
+		    (step->type == ARV_CONVERTER_STEP_YUV_TO_RGB && (width % 2) != 0)) {
+			g_set_error (error, ARV_CONVERTER_ERROR, ARV_CONVERTER_ERROR_INVALID_GEOMETRY,
+				     "[Converter::process] Invalid image size (%ux%u)", width, height);
+			return FALSE;
+		}
+
+		job.scratch_row_size = MAX (job.scratch_row_size, _get_row_size (step->output_format, width));
+	}
+
+	job.has_unpacked_window = priv->steps->len > 1 &&
+		g_array_index (priv->steps, ArvConverterStep, 1).type == ARV_CONVERTER_STEP_DEMOSAIC;
+
+	job.converter = converter;
+	job.input = input;
+	job.input_stride = input_stride;
+	job.width = width;
+	job.height = height;
+	job.output = output;
+	job.output_stride = output_stride;
+	job.rows_per_band = MAX (ARV_CONVERTER_BAND_SIZE / (job.input_row_size + output_row_size), 1);
+	job.n_bands = (height + job.rows_per_band - 1) / job.rows_per_band;
+
+	arv_converter_run_workers (_process_bands, &job, MIN (_get_n_threads (converter), job.n_bands) - 1);
+
+	return TRUE;
+}
+
+/**
+ * arv_converter_process_buffer:
+ * @converter: a #ArvConverter
+ * @buffer: a #ArvBuffer containing an image in the converter input format
+ * @output_buffer: a #ArvBuffer receiving the converted image
+ *
+ * Converts the image of @buffer into @output_buffer, without any row padding. The
+ * rows of @buffer may be padded, see arv_buffer_new_padded().
+ * The image metadata, frame id and timestamps of @buffer are copied to
+ * @output_buffer, with the converter output pixel format.
+ *
+ * Returns: %TRUE on success.
+ *
+ * Since: 0.8.0
+ */
+
+gboolean
+arv_converter_process_buffer (ArvConverter *converter, ArvBuffer *buffer, ArvBuffer *output_buffer, GError **error)
+{
+	ArvPixelFormat pixel_format;
+	const void *data;
+	void *output_data;
+	size_t size;
+	size_t output_size;
+	size_t input_stride;
+	size_t output_row_size;
+	gint width, height;
+
+	g_return_val_if_fail (ARV_IS_CONVERTER (converter), FALSE);
+	g_return_val_if_fail (ARV_IS_BUFFER (buffer), FALSE);
+	g_return_val_if_fail (ARV_IS_BUFFER (output_buffer), FALSE);
+	g_return_val_if_fail (buffer != output_buffer, FALSE);
+
+	pixel_format = arv_buffer_get_image_pixel_format (buffer);
+	if (pixel_format != converter->priv->input_format) {
+		g_set_error (error, ARV_CONVERTER_ERROR, ARV_CONVERTER_ERROR_INVALID_PIXEL_FORMAT,
+			     "[Converter::process_buffer] Buffer pixel format 0x%08x differs from 0x%08x",
+			     pixel_format, converter->priv->input_format);
+		return FALSE;
+	}
+
+	arv_buffer_get_image_region (buffer, NULL, NULL, &width, &height);
+	data = arv_buffer_get_data (buffer, &size);
+	output_data = (void *) arv_buffer_get_data (output_buffer, &output_size);
+
+	input_stride = arv_buffer_get_image_row_stride (buffer);
+	output_row_size = _get_row_size (converter->priv->output_format, width);
+
+	if (size < input_stride * height || output_size < output_row_size * height) {
+		g_set_error (error, ARV_CONVERTER_ERROR, ARV_CONVERTER_ERROR_INVALID_GEOMETRY,
+			     "[Converter::process_buffer] Buffer too small");
+		return FALSE;
+	}
+
+	if (!arv_converter_process (converter, data, input_stride, width, height,
+				    output_data, output_row_size, error))
+		return FALSE;
+
+	arv_buffer_copy_image_info (output_buffer, buffer, converter->priv->output_format);
+
+	return TRUE;
+}
+
+/**
+ * arv_converter_get_input_format:
+ * @converter: a #ArvConverter
+ *
+ * Returns: the pixel format of the images to convert.
+ *
+ * Since: 0.8.0
+ */
+
+ArvPixelFormat
+arv_converter_get_input_format (ArvConverter *converter)
+{
+	g_return_val_if_fail (ARV_IS_CONVERTER (converter), 0);
+
+	return converter->priv->input_format;
+}
+
+/**
+ * arv_converter_get_output_format:
+ * @converter: a #ArvConverter
+ *
+ * Returns: the pixel format of the converted images, which is the output format of the last step, or the input
+ * format for a converter without any step.
+ *
+ * Since: 0.8.0
+ */
+
+ArvPixelFormat
+arv_converter_get_output_format (ArvConverter *converter)
+{
+	g_return_val_if_fail (ARV_IS_CONVERTER (converter), 0);
+
+	return converter->priv->output_format;
+}
+
+/**
+ * arv_converter_get_n_steps:
+ * @converter: a #ArvConverter
+ *
+ * Returns: the number of conversion steps.
+ *
+ * Since: 0.8.0
+ */
+
+guint
+arv_converter_get_n_steps (ArvConverter *converter)
+{
+	g_return_val_if_fail (ARV_IS_CONVERTER (converter), 0);
+
+	return converter->priv->steps->len;
+}
+
+/**
+ * arv_converter_set_n_threads:
+ * @converter: a #ArvConverter
+ * @n_threads: maximum number of threads, 0 for the number of processors
+ *
+ * Sets the maximum number of threads used for the conversion of an image,
+ * including the calling thread.
+ *
+ * Since: 0.8.0
+ */
+
+void
+arv_converter_set_n_threads (ArvConverter *converter, guint n_threads)
+{
+	g_return_if_fail (ARV_IS_CONVERTER (converter));
+
+	converter->priv->n_threads = n_threads;
+}
+
+/**
+ * arv_converter_get_n_threads:
+ * @converter: a #ArvConverter
+ *
+ * Returns: the maximum number of threads, 0 meaning the number of processors.
+ *
+ * Since: 0.8.0
+ */
+
+guint
+arv_converter_get_n_threads (ArvConverter *converter)
+{
+	g_return_val_if_fail (ARV_IS_CONVERTER (converter), 0);
+
+	return converter->priv->n_threads;
+}
+
+/**
+ * arv_converter_new:
+ * @input_format: pixel format of the images to convert
+ *
+ * Returns: a new #ArvConverter, without any conversion step.
+ *
+ * Since: 0.8.0
+ */
+
+ArvConverter *
+arv_converter_new (ArvPixelFormat input_format)
+{
+	ArvConverter *converter;
+
+	converter = g_object_new (ARV_TYPE_CONVERTER, NULL);
+	converter->priv->input_format = input_format;
+	converter->priv->output_format = input_format;
+
+	return converter;
+}
+
+static void
+arv_converter_init (ArvConverter *converter)
+{
+	converter->priv = arv_converter_get_instance_private (converter);
+
+	converter->priv->steps = g_array_new (FALSE, TRUE, sizeof (ArvConverterStep));
+	converter->priv->isa = arv_simd_get_isa ();
+}
+
+static void
+_finalize (GObject *object)
+{
+	ArvConverter *converter = ARV_CONVERTER (object);
+
+	g_array_unref (converter->priv->steps);
+
+	G_OBJECT_CLASS (arv_converter_parent_class)->finalize (object);
+}
+
+static void
+arv_converter_class_init (ArvConverterClass *this_class)
+{
+	GObjectClass *object_class = G_OBJECT_CLASS (this_class);
+
+	object_class->finalize = _finalize;
+}
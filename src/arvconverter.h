@@ -0,0 +1,88 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2019 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel@gnome.org>
+ */
+
+#ifndef ARV_CONVERTER_H
+#define ARV_CONVERTER_H
+
+#if !defined (ARV_H_INSIDE) && !defined (ARAVIS_COMPILATION)
+#error "Only <arv.h> can be included directly."
+#endif
+
+#include <arvtypes.h>
+#include <arvdemosaic.h>
+
+G_BEGIN_DECLS
+
+#define ARV_CONVERTER_ERROR arv_converter_error_quark()
+
+GQuark 		arv_converter_error_quark 		(void);
+
+/**
+ * ArvConverterError:
+ * @ARV_CONVERTER_ERROR_INVALID_PIXEL_FORMAT: the step does not accept the pixel format of the previous one
+ * @ARV_CONVERTER_ERROR_INVALID_STEP: the step can not be added at this position
+ * @ARV_CONVERTER_ERROR_INVALID_PARAMETER: invalid step parameter
+ * @ARV_CONVERTER_ERROR_INVALID_GEOMETRY: the image size or the row strides are not supported
+ */
+
+typedef enum {
+	ARV_CONVERTER_ERROR_INVALID_PIXEL_FORMAT,
+	ARV_CONVERTER_ERROR_INVALID_STEP,
+	ARV_CONVERTER_ERROR_INVALID_PARAMETER,
+	ARV_CONVERTER_ERROR_INVALID_GEOMETRY
+} ArvConverterError;
+
+#define ARV_TYPE_CONVERTER             (arv_converter_get_type ())
+G_DECLARE_FINAL_TYPE (ArvConverter, arv_converter, ARV, CONVERTER, GObject)
+
+ArvConverter *		arv_converter_new			(ArvPixelFormat input_format);
+
+ArvPixelFormat		arv_converter_get_input_format		(ArvConverter *converter);
+ArvPixelFormat		arv_converter_get_output_format		(ArvConverter *converter);
+guint			arv_converter_get_n_steps		(ArvConverter *converter);
+
+void			arv_converter_set_n_threads		(ArvConverter *converter, guint n_threads);
+guint			arv_converter_get_n_threads		(ArvConverter *converter);
+
+gboolean		arv_converter_add_unpack		(ArvConverter *converter, GError **error);
+gboolean		arv_converter_add_demosaic		(ArvConverter *converter, ArvDemosaicMethod method,
+								 gboolean bgr, GError **error);
+gboolean		arv_converter_add_window		(ArvConverter *converter, guint16 low, guint16 high,
+								 GError **error);
+gboolean		arv_converter_add_swap_red_blue		(ArvConverter *converter, GError **error);
+gboolean		arv_converter_add_alpha			(ArvConverter *converter, GError **error);
+gboolean		arv_converter_add_yuv_to_rgb		(ArvConverter *converter, gboolean bgr, GError **error);
+gboolean		arv_converter_add_lut			(ArvConverter *converter, const guint8 *lut,
+								 GError **error);
+
+gboolean		arv_converter_process			(ArvConverter *converter,
+								 const void *input, size_t input_stride,
+								 guint width, guint height,
+								 void *output, size_t output_stride,
+								 GError **error);
+gboolean		arv_converter_process_buffer		(ArvConverter *converter,
+								 ArvBuffer *buffer, ArvBuffer *output_buffer,
+								 GError **error);
+
+G_END_DECLS
+
+#endif
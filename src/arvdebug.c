@@ -102,6 +102,7 @@ ArvDebugCategory arv_debug_category_viewer =
 };
 
 static GHashTable *arv_debug_categories = NULL;
+static GMutex arv_debug_mutex;
 
 static void
 arv_debug_category_free (ArvDebugCategory *category)
@@ -112,6 +113,8 @@ arv_debug_category_free (ArvDebugCategory *category)
 	}
 }
 
+/* Must be called with arv_debug_mutex held */
+
 static void
 arv_debug_initialize (const char *debug_var)
 {
@@ -164,6 +167,8 @@ arv_debug_check	(ArvDebugCategory *category, ArvDebugLevel level)
 	if ((int) category->level >= 0)
 		return FALSE;
 
+	g_mutex_lock (&arv_debug_mutex);
+
 	arv_debug_initialize (g_getenv ("ARV_DEBUG"));
 
 	configured_category = g_hash_table_lookup (arv_debug_categories, category->name);
@@ -174,6 +179,7 @@ arv_debug_check	(ArvDebugCategory *category, ArvDebugLevel level)
 	else
 		category->level = 0;
 
+	g_mutex_unlock (&arv_debug_mutex);
 
 	return (int) level <= (int) category->level;
 }
@@ -233,15 +239,20 @@ arv_log (ArvDebugCategory *category, const char *format, ...)
 void
 arv_debug_enable (const char *category_selection)
 {
+	g_mutex_lock (&arv_debug_mutex);
 	arv_debug_initialize (category_selection);
+	g_mutex_unlock (&arv_debug_mutex);
 }
 
 void
 arv_debug_shutdown (void)
 {
-	GHashTable *debug_categories = arv_debug_categories;
+	GHashTable *debug_categories;
 
+	g_mutex_lock (&arv_debug_mutex);
+	debug_categories = arv_debug_categories;
 	arv_debug_categories = NULL;
+	g_mutex_unlock (&arv_debug_mutex);
 
 	if (debug_categories != NULL)
 		g_hash_table_unref (debug_categories);
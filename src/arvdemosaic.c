@@ -0,0 +1,716 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2019 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel@gnome.org>
+ */
+
+/**
+ * SECTION: arvdemosaic
+ * @short_description: Bayer to RGB conversion
+ *
+ * These functions convert Bayer images, with 8 bit or 16 bit pixels and any
+ * of the four color filter orders, to RGB or BGR images of the same bit
+ * depth. Three interpolation methods are available, see #ArvDemosaicMethod.
+ *
+ * Image borders are handled by mirroring the image around the first and
+ * last rows and columns, which preserves the color filter pattern. The
+ * conversion uses SSSE3, AVX2 or NEON instructions when available, and can
+ * be split into bands of rows processed by the thread pool of #ArvConverter.
+ */
+
+#include <arvdemosaicprivate.h>
+#include <arvconverterprivate.h>
+#include <arvdebug.h>
+
+#if ARV_SIMD_HAS_X86
+#include <immintrin.h>
+#endif
+
+#if ARV_SIMD_HAS_NEON
+#include <arm_neon.h>
+#endif
+
+#define ARV_DEMOSAIC_MIN_ROWS_PER_BAND	32
+
+typedef struct {
+	ArvPixelFormat bayer_format;
+	ArvPixelFormat rgb_format;
+	ArvPixelFormat bgr_format;
+	guint red_x;			/* Position of the red pixel in the 2x2 color filter pattern */
+	guint red_y;
+	guint pixel_size;		/* Input pixel size, in bytes */
+} ArvDemosaicFormat;
+
+static const ArvDemosaicFormat arv_demosaic_formats[] = {
+	{ARV_PIXEL_FORMAT_BAYER_GR_8,	ARV_PIXEL_FORMAT_RGB_8_PACKED,	ARV_PIXEL_FORMAT_BGR_8_PACKED,	1, 0, 1},
+	{ARV_PIXEL_FORMAT_BAYER_RG_8,	ARV_PIXEL_FORMAT_RGB_8_PACKED,	ARV_PIXEL_FORMAT_BGR_8_PACKED,	0, 0, 1},
+	{ARV_PIXEL_FORMAT_BAYER_GB_8,	ARV_PIXEL_FORMAT_RGB_8_PACKED,	ARV_PIXEL_FORMAT_BGR_8_PACKED,	0, 1, 1},
+	{ARV_PIXEL_FORMAT_BAYER_BG_8,	ARV_PIXEL_FORMAT_RGB_8_PACKED,	ARV_PIXEL_FORMAT_BGR_8_PACKED,	1, 1, 1},
+
+	{ARV_PIXEL_FORMAT_BAYER_GR_10,	ARV_PIXEL_FORMAT_RGB_10_PACKED,	ARV_PIXEL_FORMAT_BGR_10_PACKED,	1, 0, 2},
+	{ARV_PIXEL_FORMAT_BAYER_RG_10,	ARV_PIXEL_FORMAT_RGB_10_PACKED,	ARV_PIXEL_FORMAT_BGR_10_PACKED,	0, 0, 2},
+	{ARV_PIXEL_FORMAT_BAYER_GB_10,	ARV_PIXEL_FORMAT_RGB_10_PACKED,	ARV_PIXEL_FORMAT_BGR_10_PACKED,	0, 1, 2},
+	{ARV_PIXEL_FORMAT_BAYER_BG_10,	ARV_PIXEL_FORMAT_RGB_10_PACKED,	ARV_PIXEL_FORMAT_BGR_10_PACKED,	1, 1, 2},
+
+	{ARV_PIXEL_FORMAT_BAYER_GR_12,	ARV_PIXEL_FORMAT_RGB_12_PACKED,	ARV_PIXEL_FORMAT_BGR_12_PACKED,	1, 0, 2},
+	{ARV_PIXEL_FORMAT_BAYER_RG_12,	ARV_PIXEL_FORMAT_RGB_12_PACKED,	ARV_PIXEL_FORMAT_BGR_12_PACKED,	0, 0, 2},
+	{ARV_PIXEL_FORMAT_BAYER_GB_12,	ARV_PIXEL_FORMAT_RGB_12_PACKED,	ARV_PIXEL_FORMAT_BGR_12_PACKED,	0, 1, 2},
+	{ARV_PIXEL_FORMAT_BAYER_BG_12,	ARV_PIXEL_FORMAT_RGB_12_PACKED,	ARV_PIXEL_FORMAT_BGR_12_PACKED,	1, 1, 2},
+
+	{ARV_PIXEL_FORMAT_BAYER_GR_16,	ARV_PIXEL_FORMAT_RGB_16_PACKED,	ARV_PIXEL_FORMAT_BGR_16_PACKED,	1, 0, 2},
+	{ARV_PIXEL_FORMAT_BAYER_RG_16,	ARV_PIXEL_FORMAT_RGB_16_PACKED,	ARV_PIXEL_FORMAT_BGR_16_PACKED,	0, 0, 2},
+	{ARV_PIXEL_FORMAT_BAYER_GB_16,	ARV_PIXEL_FORMAT_RGB_16_PACKED,	ARV_PIXEL_FORMAT_BGR_16_PACKED,	0, 1, 2},
+	{ARV_PIXEL_FORMAT_BAYER_BG_16,	ARV_PIXEL_FORMAT_RGB_16_PACKED,	ARV_PIXEL_FORMAT_BGR_16_PACKED,	1, 1, 2},
+
+	{ARV_PIXEL_FORMAT_CUSTOM_BAYER_GR_16, ARV_PIXEL_FORMAT_RGB_16_PACKED, ARV_PIXEL_FORMAT_BGR_16_PACKED, 1, 0, 2},
+	{ARV_PIXEL_FORMAT_CUSTOM_BAYER_RG_16, ARV_PIXEL_FORMAT_RGB_16_PACKED, ARV_PIXEL_FORMAT_BGR_16_PACKED, 0, 0, 2},
+	{ARV_PIXEL_FORMAT_CUSTOM_BAYER_GB_16, ARV_PIXEL_FORMAT_RGB_16_PACKED, ARV_PIXEL_FORMAT_BGR_16_PACKED, 0, 1, 2},
+	{ARV_PIXEL_FORMAT_CUSTOM_BAYER_BG_16, ARV_PIXEL_FORMAT_RGB_16_PACKED, ARV_PIXEL_FORMAT_BGR_16_PACKED, 1, 1, 2}
+};
+
+/* Each missing color of a pixel is interpolated from one of the following neighbourhoods. With c the current
+ * pixel, cl and cr its left and right neighbours, a0 and b0 the pixels above and below, and al, ar, bl, br the
+ * diagonal ones:
+ *
+ * SELF:	c
+ * HORIZONTAL:	avg (cl, cr), or cr for the nearest method
+ * VERTICAL:	avg (a0, b0), or b0
+ * CROSS:	avg (HORIZONTAL, VERTICAL), or cr. The edge aware method uses HORIZONTAL or VERTICAL alone when the
+ *		gradient is smaller in that direction
+ * DIAGONAL:	avg (avg (al, ar), avg (bl, br)), or br
+ *
+ * with avg (a, b) = (a + b + 1) >> 1, which is what the SIMD instructions compute. */
+
+typedef enum {
+	ARV_DEMOSAIC_SOURCE_SELF,
+	ARV_DEMOSAIC_SOURCE_HORIZONTAL,
+	ARV_DEMOSAIC_SOURCE_VERTICAL,
+	ARV_DEMOSAIC_SOURCE_CROSS,
+	ARV_DEMOSAIC_SOURCE_DIAGONAL,
+	ARV_DEMOSAIC_N_SOURCES
+} ArvDemosaicSource;
+
+/* Sources of the three output channels, in output order, for the even and odd columns of a row */
+
+typedef struct {
+	ArvDemosaicSource sources[3][2];
+} ArvDemosaicRowLayout;
+
+typedef struct {
+	const ArvDemosaicFormat *format;
+	const guint8 *input;
+	size_t input_stride;
+	guint width;
+	guint height;
+	guint8 *output;
+	size_t output_stride;
+	gboolean bgr;
+	ArvDemosaicMethod method;
+	ArvSimdIsa isa;
+	guint n_bands;
+	gint next_band;		/* Atomic access */
+} ArvDemosaicJob;
+
+static void
+_get_row_layout (const ArvDemosaicFormat *format, guint y, gboolean bgr, ArvDemosaicRowLayout *layout)
+{
+	gboolean is_red_row = (y & 1) == format->red_y;
+	guint parity;
+
+	for (parity = 0; parity < 2; parity++) {
+		ArvDemosaicSource red, green, blue;
+		gboolean is_red_column = parity == format->red_x;
+
+		if (is_red_row) {
+			if (is_red_column) {
+				red = ARV_DEMOSAIC_SOURCE_SELF;
+				green = ARV_DEMOSAIC_SOURCE_CROSS;
+				blue = ARV_DEMOSAIC_SOURCE_DIAGONAL;
+			} else {
+				red = ARV_DEMOSAIC_SOURCE_HORIZONTAL;
+				green = ARV_DEMOSAIC_SOURCE_SELF;
+				blue = ARV_DEMOSAIC_SOURCE_VERTICAL;
+			}
+		} else {
+			if (is_red_column) {
+				red = ARV_DEMOSAIC_SOURCE_VERTICAL;
+				green = ARV_DEMOSAIC_SOURCE_SELF;
+				blue = ARV_DEMOSAIC_SOURCE_HORIZONTAL;
+			} else {
+				red = ARV_DEMOSAIC_SOURCE_DIAGONAL;
+				green = ARV_DEMOSAIC_SOURCE_CROSS;
+				blue = ARV_DEMOSAIC_SOURCE_SELF;
+			}
+		}
+
+		layout->sources[0][parity] = bgr ? blue : red;
+		layout->sources[1][parity] = green;
+		layout->sources[2][parity] = bgr ? red : blue;
+	}
+}
+
+static inline guint
+_avg (guint a, guint b)
+{
+	return (a + b + 1) >> 1;
+}
+
+static inline guint
+_get_source_value (ArvDemosaicSource source, ArvDemosaicMethod method,
+		   guint c, guint cl, guint cr, guint a0, guint al, guint ar, guint b0, guint bl, guint br)
+{
+	switch (source) {
+		case ARV_DEMOSAIC_SOURCE_SELF:
+			return c;
+		case ARV_DEMOSAIC_SOURCE_HORIZONTAL:
+			return method == ARV_DEMOSAIC_METHOD_NEAREST ? cr : _avg (cl, cr);
+		case ARV_DEMOSAIC_SOURCE_VERTICAL:
+			return method == ARV_DEMOSAIC_METHOD_NEAREST ? b0 : _avg (a0, b0);
+		case ARV_DEMOSAIC_SOURCE_CROSS:
+			if (method == ARV_DEMOSAIC_METHOD_NEAREST)
+				return cr;
+			if (method == ARV_DEMOSAIC_METHOD_EDGE_AWARE) {
+				guint gh = cl > cr ? cl - cr : cr - cl;
+				guint gv = a0 > b0 ? a0 - b0 : b0 - a0;
+
+				if (gv < gh)
+					return _avg (a0, b0);
+				if (gh < gv)
+					return _avg (cl, cr);
+			}
+			return _avg (_avg (cl, cr), _avg (a0, b0));
+		case ARV_DEMOSAIC_SOURCE_DIAGONAL:
+			return method == ARV_DEMOSAIC_METHOD_NEAREST ? br : _avg (_avg (al, ar), _avg (bl, br));
+		default:
+			g_assert_not_reached ();
+	}
+
+	return 0;
+}
+
+/* Reference implementation, also used for the first column and for the columns left over by the vector
+ * kernels. Columns -1 and width are mirrored to 1 and width - 2. */
+
+#define ARV_DEMOSAIC_SCALAR_ROW(function_name, pixel_type)						\
+static void												\
+function_name (const pixel_type *above, const pixel_type *current, const pixel_type *below,		\
+	       guint width, guint x_start, guint x_end, const ArvDemosaicRowLayout *layout,		\
+	       ArvDemosaicMethod method, pixel_type *output)						\
+{													\
+	guint x;											\
+													\
+	for (x = x_start; x < x_end; x++) {								\
+		guint xl = x > 0 ? x - 1 : 1;								\
+		guint xr = x + 1 < width ? x + 1 : width - 2;						\
+		guint channel;										\
+													\
+		for (channel = 0; channel < 3; channel++)						\
+			output[3 * x + channel] = _get_source_value (layout->sources[channel][x & 1], method,	\
+								     current[x], current[xl], current[xr],	\
+								     above[x], above[xl], above[xr],		\
+								     below[x], below[xl], below[xr]);		\
+	}												\
+}
+
+ARV_DEMOSAIC_SCALAR_ROW (_demosaic_row_scalar_8, guint8)
+ARV_DEMOSAIC_SCALAR_ROW (_demosaic_row_scalar_16, guint16)
+
+#undef ARV_DEMOSAIC_SCALAR_ROW
+
+/* The vector kernels start at the second column, such that all the neighbours of the processed pixels are inside
+ * the row, and return the first column they did not process. */
+
+#if ARV_SIMD_HAS_X86
+
+/* pshufb masks interleaving 16 8 bit pixels, or 8 16 bit pixels, of the three channels into three 16 byte
+ * vectors, indexed by output vector and channel */
+
+static const guint8 arv_demosaic_interleave_8[3][3][16] = {
+	{
+		{0, 0x80, 0x80, 1, 0x80, 0x80, 2, 0x80, 0x80, 3, 0x80, 0x80, 4, 0x80, 0x80, 5},
+		{0x80, 0, 0x80, 0x80, 1, 0x80, 0x80, 2, 0x80, 0x80, 3, 0x80, 0x80, 4, 0x80, 0x80},
+		{0x80, 0x80, 0, 0x80, 0x80, 1, 0x80, 0x80, 2, 0x80, 0x80, 3, 0x80, 0x80, 4, 0x80}
+	},
+	{
+		{0x80, 0x80, 6, 0x80, 0x80, 7, 0x80, 0x80, 8, 0x80, 0x80, 9, 0x80, 0x80, 10, 0x80},
+		{5, 0x80, 0x80, 6, 0x80, 0x80, 7, 0x80, 0x80, 8, 0x80, 0x80, 9, 0x80, 0x80, 10},
+		{0x80, 5, 0x80, 0x80, 6, 0x80, 0x80, 7, 0x80, 0x80, 8, 0x80, 0x80, 9, 0x80, 0x80}
+	},
+	{
+		{0x80, 11, 0x80, 0x80, 12, 0x80, 0x80, 13, 0x80, 0x80, 14, 0x80, 0x80, 15, 0x80, 0x80},
+		{0x80, 0x80, 11, 0x80, 0x80, 12, 0x80, 0x80, 13, 0x80, 0x80, 14, 0x80, 0x80, 15, 0x80},
+		{10, 0x80, 0x80, 11, 0x80, 0x80, 12, 0x80, 0x80, 13, 0x80, 0x80, 14, 0x80, 0x80, 15}
+	}
+};
+
+static const guint8 arv_demosaic_interleave_16[3][3][16] = {
+	{
+		{0, 1, 0x80, 0x80, 0x80, 0x80, 2, 3, 0x80, 0x80, 0x80, 0x80, 4, 5, 0x80, 0x80},
+		{0x80, 0x80, 0, 1, 0x80, 0x80, 0x80, 0x80, 2, 3, 0x80, 0x80, 0x80, 0x80, 4, 5},
+		{0x80, 0x80, 0x80, 0x80, 0, 1, 0x80, 0x80, 0x80, 0x80, 2, 3, 0x80, 0x80, 0x80, 0x80}
+	},
+	{
+		{0x80, 0x80, 6, 7, 0x80, 0x80, 0x80, 0x80, 8, 9, 0x80, 0x80, 0x80, 0x80, 10, 11},
+		{0x80, 0x80, 0x80, 0x80, 6, 7, 0x80, 0x80, 0x80, 0x80, 8, 9, 0x80, 0x80, 0x80, 0x80},
+		{4, 5, 0x80, 0x80, 0x80, 0x80, 6, 7, 0x80, 0x80, 0x80, 0x80, 8, 9, 0x80, 0x80}
+	},
+	{
+		{0x80, 0x80, 0x80, 0x80, 12, 13, 0x80, 0x80, 0x80, 0x80, 14, 15, 0x80, 0x80, 0x80, 0x80},
+		{10, 11, 0x80, 0x80, 0x80, 0x80, 12, 13, 0x80, 0x80, 0x80, 0x80, 14, 15, 0x80, 0x80},
+		{0x80, 0x80, 10, 11, 0x80, 0x80, 0x80, 0x80, 12, 13, 0x80, 0x80, 0x80, 0x80, 14, 15}
+	}
+};
+
+__attribute__ ((target ("ssse3")))
+static inline __m128i
+_ssse3_select (__m128i mask, __m128i a, __m128i b)
+{
+	return _mm_or_si128 (_mm_and_si128 (mask, a), _mm_andnot_si128 (mask, b));
+}
+
+__attribute__ ((target ("ssse3")))
+static inline void
+_ssse3_store_interleaved (const guint8 masks[3][3][16], const __m128i *channels, void *output)
+{
+	guint i;
+
+	for (i = 0; i < 3; i++) {
+		__m128i v;
+
+		v = _mm_or_si128 (_mm_or_si128 (_mm_shuffle_epi8 (channels[0], _mm_loadu_si128 ((const __m128i *) masks[i][0])),
+						_mm_shuffle_epi8 (channels[1], _mm_loadu_si128 ((const __m128i *) masks[i][1]))),
+				  _mm_shuffle_epi8 (channels[2], _mm_loadu_si128 ((const __m128i *) masks[i][2])));
+		_mm_storeu_si128 ((__m128i *) output + i, v);
+	}
+}
+
+/* The two kernels only differ by the lane width. even_mask selects the lanes of the even pixels of a vector. */
+
+#define ARV_DEMOSAIC_SSSE3_ROW(function_name, pixel_type, n_lanes, avg, subs, cmpeq, even_mask, masks)	\
+__attribute__ ((target ("ssse3")))										\
+static guint													\
+function_name (const pixel_type *above, const pixel_type *current, const pixel_type *below,			\
+	       guint width, const ArvDemosaicRowLayout *layout, ArvDemosaicMethod method, pixel_type *output)	\
+{														\
+	__m128i sources[ARV_DEMOSAIC_N_SOURCES];								\
+	__m128i channels[3];											\
+	__m128i even = even_mask;										\
+	__m128i zero = _mm_setzero_si128 ();									\
+	guint x;												\
+	guint i;												\
+														\
+	for (x = 1; x + n_lanes < width; x += n_lanes) {							\
+		__m128i cl = _mm_loadu_si128 ((const __m128i *) (current + x - 1));				\
+		__m128i cr = _mm_loadu_si128 ((const __m128i *) (current + x + 1));				\
+		__m128i a0 = _mm_loadu_si128 ((const __m128i *) (above + x));					\
+		__m128i b0 = _mm_loadu_si128 ((const __m128i *) (below + x));					\
+														\
+		sources[ARV_DEMOSAIC_SOURCE_SELF] = _mm_loadu_si128 ((const __m128i *) (current + x));		\
+														\
+		if (method == ARV_DEMOSAIC_METHOD_NEAREST) {							\
+			sources[ARV_DEMOSAIC_SOURCE_HORIZONTAL] = cr;						\
+			sources[ARV_DEMOSAIC_SOURCE_VERTICAL] = b0;						\
+			sources[ARV_DEMOSAIC_SOURCE_CROSS] = cr;						\
+			sources[ARV_DEMOSAIC_SOURCE_DIAGONAL] = _mm_loadu_si128 ((const __m128i *) (below + x + 1)); \
+		} else {											\
+			__m128i h = avg (cl, cr);								\
+			__m128i v = avg (a0, b0);								\
+														\
+			sources[ARV_DEMOSAIC_SOURCE_HORIZONTAL] = h;						\
+			sources[ARV_DEMOSAIC_SOURCE_VERTICAL] = v;						\
+			sources[ARV_DEMOSAIC_SOURCE_CROSS] = avg (h, v);					\
+			sources[ARV_DEMOSAIC_SOURCE_DIAGONAL] =							\
+				avg (avg (_mm_loadu_si128 ((const __m128i *) (above + x - 1)),			\
+					  _mm_loadu_si128 ((const __m128i *) (above + x + 1))),			\
+				     avg (_mm_loadu_si128 ((const __m128i *) (below + x - 1)),			\
+					  _mm_loadu_si128 ((const __m128i *) (below + x + 1))));		\
+														\
+			if (method == ARV_DEMOSAIC_METHOD_EDGE_AWARE) {						\
+				__m128i gh = _mm_or_si128 (subs (cl, cr), subs (cr, cl));			\
+				__m128i gv = _mm_or_si128 (subs (a0, b0), subs (b0, a0));			\
+				/* All ones where gv < gh, and where gh < gv */					\
+				__m128i vertical = _mm_xor_si128 (cmpeq (subs (gh, gv), zero), _mm_set1_epi8 (-1)); \
+				__m128i horizontal = _mm_xor_si128 (cmpeq (subs (gv, gh), zero), _mm_set1_epi8 (-1)); \
+														\
+				sources[ARV_DEMOSAIC_SOURCE_CROSS] =						\
+					_ssse3_select (vertical, v,						\
+						       _ssse3_select (horizontal, h,				\
+								      sources[ARV_DEMOSAIC_SOURCE_CROSS]));	\
+			}											\
+		}												\
+														\
+		for (i = 0; i < 3; i++)										\
+			channels[i] = _ssse3_select (even, sources[layout->sources[i][x & 1]],			\
+						     sources[layout->sources[i][(x + 1) & 1]]);			\
+														\
+		_ssse3_store_interleaved (masks, channels, output + 3 * x);					\
+	}													\
+														\
+	return x;												\
+}
+
+ARV_DEMOSAIC_SSSE3_ROW (_demosaic_row_ssse3_8, guint8, 16, _mm_avg_epu8, _mm_subs_epu8, _mm_cmpeq_epi8,
+			_mm_set1_epi16 (0x00ff), arv_demosaic_interleave_8)
+ARV_DEMOSAIC_SSSE3_ROW (_demosaic_row_ssse3_16, guint16, 8, _mm_avg_epu16, _mm_subs_epu16, _mm_cmpeq_epi16,
+			_mm_set1_epi32 (0x0000ffff), arv_demosaic_interleave_16)
+
+#undef ARV_DEMOSAIC_SSSE3_ROW
+
+#endif
+
+#if ARV_SIMD_HAS_NEON
+
+#define ARV_DEMOSAIC_NEON_ROW(function_name, pixel_type, n_lanes, suffix, vector_type, mask_type, even_mask, store)	\
+static guint														\
+function_name (const pixel_type *above, const pixel_type *current, const pixel_type *below,				\
+	       guint width, const ArvDemosaicRowLayout *layout, ArvDemosaicMethod method, pixel_type *output)		\
+{															\
+	vector_type sources[ARV_DEMOSAIC_N_SOURCES];									\
+	mask_type even = even_mask;											\
+	guint x;													\
+															\
+	for (x = 1; x + n_lanes < width; x += n_lanes) {								\
+		vector_type cl = vld1q_##suffix (current + x - 1);							\
+		vector_type cr = vld1q_##suffix (current + x + 1);							\
+		vector_type a0 = vld1q_##suffix (above + x);								\
+		vector_type b0 = vld1q_##suffix (below + x);								\
+															\
+		sources[ARV_DEMOSAIC_SOURCE_SELF] = vld1q_##suffix (current + x);					\
+															\
+		if (method == ARV_DEMOSAIC_METHOD_NEAREST) {								\
+			sources[ARV_DEMOSAIC_SOURCE_HORIZONTAL] = cr;							\
+			sources[ARV_DEMOSAIC_SOURCE_VERTICAL] = b0;							\
+			sources[ARV_DEMOSAIC_SOURCE_CROSS] = cr;							\
+			sources[ARV_DEMOSAIC_SOURCE_DIAGONAL] = vld1q_##suffix (below + x + 1);				\
+		} else {												\
+			vector_type h = vrhaddq_##suffix (cl, cr);							\
+			vector_type v = vrhaddq_##suffix (a0, b0);							\
+															\
+			sources[ARV_DEMOSAIC_SOURCE_HORIZONTAL] = h;							\
+			sources[ARV_DEMOSAIC_SOURCE_VERTICAL] = v;							\
+			sources[ARV_DEMOSAIC_SOURCE_CROSS] = vrhaddq_##suffix (h, v);					\
+			sources[ARV_DEMOSAIC_SOURCE_DIAGONAL] =								\
+				vrhaddq_##suffix (vrhaddq_##suffix (vld1q_##suffix (above + x - 1),			\
+								    vld1q_##suffix (above + x + 1)),			\
+						  vrhaddq_##suffix (vld1q_##suffix (below + x - 1),			\
+								    vld1q_##suffix (below + x + 1)));			\
+															\
+			if (method == ARV_DEMOSAIC_METHOD_EDGE_AWARE) {							\
+				vector_type gh = vabdq_##suffix (cl, cr);						\
+				vector_type gv = vabdq_##suffix (a0, b0);						\
+															\
+				sources[ARV_DEMOSAIC_SOURCE_CROSS] =							\
+					vbslq_##suffix (vcltq_##suffix (gv, gh), v,					\
+							vbslq_##suffix (vcltq_##suffix (gh, gv), h,			\
+									sources[ARV_DEMOSAIC_SOURCE_CROSS]));		\
+			}												\
+		}													\
+															\
+		{													\
+			store channels;											\
+			guint i;											\
+															\
+			for (i = 0; i < 3; i++)										\
+				channels.val[i] = vbslq_##suffix (even, sources[layout->sources[i][x & 1]],		\
+								  sources[layout->sources[i][(x + 1) & 1]]);		\
+															\
+			vst3q_##suffix (output + 3 * x, channels);							\
+		}													\
+	}														\
+															\
+	return x;													\
+}
+
+ARV_DEMOSAIC_NEON_ROW (_demosaic_row_neon_8, guint8, 16, u8, uint8x16_t, uint8x16_t,
+		       vreinterpretq_u8_u16 (vdupq_n_u16 (0x00ff)), uint8x16x3_t)
+ARV_DEMOSAIC_NEON_ROW (_demosaic_row_neon_16, guint16, 8, u16, uint16x8_t, uint16x8_t,
+		       vreinterpretq_u16_u32 (vdupq_n_u32 (0x0000ffff)), uint16x8x3_t)
+
+#undef ARV_DEMOSAIC_NEON_ROW
+
+#endif
+
+/* Converts the row y, given its neighbour rows. Only the parity of y matters. */
+
+static void
+_demosaic_row_with_neighbours (const ArvDemosaicFormat *format, ArvSimdIsa isa,
+			       const guint8 *above, const guint8 *current, const guint8 *below,
+			       guint width, guint y, gboolean bgr, ArvDemosaicMethod method, guint8 *output)
+{
+	ArvDemosaicRowLayout layout;
+	guint x = 1;
+
+	_get_row_layout (format, y, bgr, &layout);
+
+	if (format->pixel_size == 1) {
+		switch (isa) {
+#if ARV_SIMD_HAS_X86
+			case ARV_SIMD_ISA_AVX2:
+			case ARV_SIMD_ISA_SSSE3:
+				x = _demosaic_row_ssse3_8 (above, current, below, width, &layout, method, output);
+				break;
+#endif
+#if ARV_SIMD_HAS_NEON
+			case ARV_SIMD_ISA_NEON:
+				x = _demosaic_row_neon_8 (above, current, below, width, &layout, method, output);
+				break;
+#endif
+			default:
+				break;
+		}
+
+		_demosaic_row_scalar_8 (above, current, below, width, 0, 1, &layout, method, output);
+		_demosaic_row_scalar_8 (above, current, below, width, x, width, &layout, method, output);
+	} else {
+		const guint16 *above_16 = (const guint16 *) above;
+		const guint16 *current_16 = (const guint16 *) current;
+		const guint16 *below_16 = (const guint16 *) below;
+		guint16 *output_16 = (guint16 *) output;
+
+		switch (isa) {
+#if ARV_SIMD_HAS_X86
+			case ARV_SIMD_ISA_AVX2:
+			case ARV_SIMD_ISA_SSSE3:
+				x = _demosaic_row_ssse3_16 (above_16, current_16, below_16, width,
+							    &layout, method, output_16);
+				break;
+#endif
+#if ARV_SIMD_HAS_NEON
+			case ARV_SIMD_ISA_NEON:
+				x = _demosaic_row_neon_16 (above_16, current_16, below_16, width,
+							   &layout, method, output_16);
+				break;
+#endif
+			default:
+				break;
+		}
+
+		_demosaic_row_scalar_16 (above_16, current_16, below_16, width, 0, 1, &layout, method, output_16);
+		_demosaic_row_scalar_16 (above_16, current_16, below_16, width, x, width, &layout, method, output_16);
+	}
+}
+
+/* Converts the row y. The neighbour rows are taken from the input image, mirrored at the top and bottom borders,
+ * so the rows are independent. */
+
+static void
+_demosaic_row (const ArvDemosaicFormat *format, ArvSimdIsa isa, const guint8 *input, size_t input_stride,
+	       guint width, guint height, guint y, gboolean bgr, ArvDemosaicMethod method, guint8 *output)
+{
+	guint y_above = y > 0 ? y - 1 : 1;
+	guint y_below = y + 1 < height ? y + 1 : height - 2;
+
+	_demosaic_row_with_neighbours (format, isa,
+				       input + y_above * input_stride,
+				       input + y * input_stride,
+				       input + y_below * input_stride,
+				       width, y, bgr, method, output);
+}
+
+/* Converts bands until there is none left. Run by the calling thread and the workers. */
+
+static void
+_demosaic_bands (gpointer data)
+{
+	ArvDemosaicJob *job = data;
+	gint band;
+
+	while ((band = g_atomic_int_add (&job->next_band, 1)) < (gint) job->n_bands) {
+		guint y_end = (guint64) job->height * (band + 1) / job->n_bands;
+		guint y;
+
+		for (y = (guint64) job->height * band / job->n_bands; y < y_end; y++)
+			_demosaic_row (job->format, job->isa, job->input, job->input_stride, job->width, job->height,
+				       y, job->bgr, job->method, job->output + y * job->output_stride);
+	}
+}
+
+static const ArvDemosaicFormat *
+_find_format (ArvPixelFormat bayer_format)
+{
+	guint i;
+
+	for (i = 0; i < G_N_ELEMENTS (arv_demosaic_formats); i++)
+		if (arv_demosaic_formats[i].bayer_format == bayer_format)
+			return &arv_demosaic_formats[i];
+
+	return NULL;
+}
+
+gboolean
+arv_demosaic_with_isa (ArvSimdIsa isa, ArvPixelFormat bayer_format,
+		       const void *input, size_t input_stride,
+		       guint width, guint height,
+		       ArvPixelFormat output_format,
+		       void *output, size_t output_stride,
+		       ArvDemosaicMethod method, guint n_threads)
+{
+	const ArvDemosaicFormat *format;
+	ArvDemosaicJob job;
+
+	g_return_val_if_fail (input != NULL, FALSE);
+	g_return_val_if_fail (output != NULL, FALSE);
+	g_return_val_if_fail (method <= ARV_DEMOSAIC_METHOD_EDGE_AWARE, FALSE);
+
+	format = _find_format (bayer_format);
+	if (format == NULL) {
+		arv_debug_misc ("[Demosaic::demosaic] Unsupported pixel format 0x%08x", bayer_format);
+		return FALSE;
+	}
+
+	if (output_format != format->rgb_format && output_format != format->bgr_format) {
+		arv_debug_misc ("[Demosaic::demosaic] Unsupported output pixel format 0x%08x for 0x%08x",
+				output_format, bayer_format);
+		return FALSE;
+	}
+
+	if (width < 2 || height < 2) {
+		arv_debug_misc ("[Demosaic::demosaic] Image too small (%ux%u)", width, height);
+		return FALSE;
+	}
+
+	if (input_stride < (size_t) width * format->pixel_size ||
+	    output_stride < (size_t) width * 3 * format->pixel_size) {
+		arv_debug_misc ("[Demosaic::demosaic] Stride too small");
+		return FALSE;
+	}
+
+	if (!arv_simd_isa_is_supported (isa))
+		return FALSE;
+
+	if (n_threads == 0)
+		n_threads = g_get_num_processors ();
+
+	job.format = format;
+	job.input = input;
+	job.input_stride = input_stride;
+	job.width = width;
+	job.height = height;
+	job.output = output;
+	job.output_stride = output_stride;
+	job.bgr = output_format == format->bgr_format;
+	job.method = method;
+	job.isa = isa;
+	job.n_bands = CLAMP (height / ARV_DEMOSAIC_MIN_ROWS_PER_BAND, 1, n_threads);
+	job.next_band = 0;
+
+	arv_converter_run_workers (_demosaic_bands, &job, job.n_bands - 1);
+
+	return TRUE;
+}
+
+/* Row by row conversion, for the fused conversions of #ArvConverter. The image geometry must have been checked
+ * by the caller. */
+
+gboolean
+arv_demosaic_row (ArvSimdIsa isa, ArvPixelFormat bayer_format,
+		  const void *input, size_t input_stride,
+		  guint width, guint height, guint y,
+		  gboolean bgr, ArvDemosaicMethod method, void *output)
+{
+	const ArvDemosaicFormat *format;
+
+	format = _find_format (bayer_format);
+	if (format == NULL || width < 2 || height < 2 || y >= height)
+		return FALSE;
+
+	_demosaic_row (format, isa, input, input_stride, width, height, y, bgr, method, output);
+
+	return TRUE;
+}
+
+/* Same as arv_demosaic_row(), with the neighbour rows given by the caller, which is responsible for the mirroring at
+ * the image borders. This allows the conversion of rows produced by a previous step of #ArvConverter. */
+
+gboolean
+arv_demosaic_row_with_neighbours (ArvSimdIsa isa, ArvPixelFormat bayer_format,
+				  const void *above, const void *current, const void *below,
+				  guint width, guint y,
+				  gboolean bgr, ArvDemosaicMethod method, void *output)
+{
+	const ArvDemosaicFormat *format;
+
+	format = _find_format (bayer_format);
+	if (format == NULL || width < 2)
+		return FALSE;
+
+	_demosaic_row_with_neighbours (format, isa, above, current, below, width, y, bgr, method, output);
+
+	return TRUE;
+}
+
+/**
+ * arv_demosaic_get_output_format:
+ * @bayer_format: a Bayer pixel format
+ * @bgr: %TRUE for a BGR output, %FALSE for RGB
+ *
+ * Returns: the output pixel format of arv_demosaic() for @bayer_format, with the same bit depth, 0 if
+ * @bayer_format is not supported.
+ *
+ * Since: 0.8.0
+ */
+
+ArvPixelFormat
+arv_demosaic_get_output_format (ArvPixelFormat bayer_format, gboolean bgr)
+{
+	const ArvDemosaicFormat *format;
+
+	format = _find_format (bayer_format);
+	if (format == NULL)
+		return 0;
+
+	return bgr ? format->bgr_format : format->rgb_format;
+}
+
+/**
+ * arv_demosaic:
+ * @bayer_format: input Bayer pixel format, 8 bit or unpacked 10, 12 or 16 bit
+ * @input: input image
+ * @input_stride: distance between two input rows, in bytes
+ * @width: image width
+ * @height: image height
+ * @output_format: output pixel format, as returned by arv_demosaic_get_output_format()
+ * @output: output image
+ * @output_stride: distance between two output rows, in bytes
+ * @method: interpolation method
+ * @n_threads: maximum number of threads, 0 for the number of processors
+ *
+ * Converts a Bayer image to RGB or BGR, with the pixel values of the same
+ * bit depth. 16 bit images must be in the host byte order. Images smaller
+ * than 2x2 are not supported. The rows are split in bands of at least 32
+ * rows, processed in parallel.
+ *
+ * Packed Bayer formats must be unpacked first, see arv_pixel_unpack().
+ *
+ * Returns: %TRUE on success, %FALSE if the formats or the image geometry are not supported.
+ *
+ * Since: 0.8.0
+ */
+
+gboolean
+arv_demosaic (ArvPixelFormat bayer_format,
+	      const void *input, size_t input_stride,
+	      guint width, guint height,
+	      ArvPixelFormat output_format,
+	      void *output, size_t output_stride,
+	      ArvDemosaicMethod method, guint n_threads)
+{
+	return arv_demosaic_with_isa (arv_simd_get_isa (), bayer_format, input, input_stride, width, height,
+				      output_format, output, output_stride, method, n_threads);
+}
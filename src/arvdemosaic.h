@@ -0,0 +1,61 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2019 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel@gnome.org>
+ */
+
+#ifndef ARV_DEMOSAIC_H
+#define ARV_DEMOSAIC_H
+
+#if !defined (ARV_H_INSIDE) && !defined (ARAVIS_COMPILATION)
+#error "Only <arv.h> can be included directly."
+#endif
+
+#include <arvtypes.h>
+
+G_BEGIN_DECLS
+
+/**
+ * ArvDemosaicMethod:
+ * @ARV_DEMOSAIC_METHOD_NEAREST: copy of the nearest pixel of each missing color, fastest
+ * @ARV_DEMOSAIC_METHOD_BILINEAR: average of the nearest pixels of each missing color
+ * @ARV_DEMOSAIC_METHOD_EDGE_AWARE: bilinear, except for the green channel at red and blue sites, which is
+ * interpolated along the direction of the smallest gradient
+ *
+ * Since: 0.8.0
+ */
+
+typedef enum {
+	ARV_DEMOSAIC_METHOD_NEAREST,
+	ARV_DEMOSAIC_METHOD_BILINEAR,
+	ARV_DEMOSAIC_METHOD_EDGE_AWARE
+} ArvDemosaicMethod;
+
+ArvPixelFormat	arv_demosaic_get_output_format	(ArvPixelFormat bayer_format, gboolean bgr);
+
+gboolean	arv_demosaic			(ArvPixelFormat bayer_format,
+						 const void *input, size_t input_stride,
+						 guint width, guint height,
+						 ArvPixelFormat output_format,
+						 void *output, size_t output_stride,
+						 ArvDemosaicMethod method, guint n_threads);
+
+G_END_DECLS
+
+#endif
@@ -0,0 +1,48 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2019 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel@gnome.org>
+ */
+
+#ifndef ARV_DEMOSAIC_PRIVATE_H
+#define ARV_DEMOSAIC_PRIVATE_H
+
+#include <arvdemosaic.h>
+#include <arvsimdprivate.h>
+
+G_BEGIN_DECLS
+
+gboolean	arv_demosaic_with_isa		(ArvSimdIsa isa, ArvPixelFormat bayer_format,
+						 const void *input, size_t input_stride,
+						 guint width, guint height,
+						 ArvPixelFormat output_format,
+						 void *output, size_t output_stride,
+						 ArvDemosaicMethod method, guint n_threads);
+gboolean	arv_demosaic_row		(ArvSimdIsa isa, ArvPixelFormat bayer_format,
+						 const void *input, size_t input_stride,
+						 guint width, guint height, guint y,
+						 gboolean bgr, ArvDemosaicMethod method, void *output);
+gboolean	arv_demosaic_row_with_neighbours	(ArvSimdIsa isa, ArvPixelFormat bayer_format,
+							 const void *above, const void *current, const void *below,
+							 guint width, guint y,
+							 gboolean bgr, ArvDemosaicMethod method, void *output);
+
+G_END_DECLS
+
+#endif
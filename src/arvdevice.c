@@ -31,15 +31,23 @@
 
 #include <arvdevice.h>
 #include <arvdeviceprivate.h>
-#include <arvgc.h>
+#include <arvgcprivate.h>
+#include <arvdomparserprivate.h>
+#include <arvzip.h>
+#include <arvfeaturehandle.h>
 #include <arvgccommand.h>
 #include <arvgcinteger.h>
 #include <arvgcfloat.h>
 #include <arvgcboolean.h>
 #include <arvgcenumeration.h>
 #include <arvgcstring.h>
-#include <arvstream.h>
+#include <arvstreamprivate.h>
+#include <arvclockmodel.h>
 #include <arvdebug.h>
+#include <string.h>
+
+/* Number of timestamp latches per clock sample, the one with the shortest round trip is kept */
+#define ARV_DEVICE_CLOCK_SAMPLE_N_LATCHES	4
 
 enum {
 	ARV_DEVICE_SIGNAL_CONTROL_LOST,
@@ -48,6 +56,12 @@ enum {
 
 static guint arv_device_signals[ARV_DEVICE_SIGNAL_LAST] = {0};
 
+typedef struct {
+	ArvClockModel *clock_model;
+} ArvDevicePrivate;
+
+G_DEFINE_ABSTRACT_TYPE_WITH_CODE (ArvDevice, arv_device, G_TYPE_OBJECT, G_ADD_PRIVATE (ArvDevice))
+
 GQuark
 arv_device_error_quark (void)
 {
@@ -71,9 +85,16 @@ arv_device_error_quark (void)
 ArvStream *
 arv_device_create_stream (ArvDevice *device, ArvStreamCallback callback, void *user_data)
 {
+	ArvDevicePrivate *priv = arv_device_get_instance_private (device);
+	ArvStream *stream;
+
 	g_return_val_if_fail (ARV_IS_DEVICE (device), NULL);
 
-	return ARV_DEVICE_GET_CLASS (device)->create_stream (device, callback, user_data);
+	stream = ARV_DEVICE_GET_CLASS (device)->create_stream (device, callback, user_data);
+	if (ARV_IS_STREAM (stream))
+		arv_stream_set_clock_model (stream, priv->clock_model);
+
+	return stream;
 }
 
 /**
@@ -265,6 +286,33 @@ arv_device_get_feature (ArvDevice *device, const char *feature)
 	return arv_gc_get_node (genicam, feature);
 }
 
+/**
+ * arv_device_get_feature_handle:
+ * @device: a #ArvDevice
+ * @feature: feature name
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Creates a handle for fast repeated accesses to @feature. See #ArvFeatureHandle.
+ *
+ * Returns: (transfer full): a new #ArvFeatureHandle, %NULL on error.
+ *
+ * Since: 0.8.0
+ */
+
+ArvFeatureHandle *
+arv_device_get_feature_handle (ArvDevice *device, const char *feature, GError **error)
+{
+	ArvGc *genicam;
+
+	g_return_val_if_fail (ARV_IS_DEVICE (device), NULL);
+	g_return_val_if_fail (feature != NULL, NULL);
+
+	genicam = arv_device_get_genicam (device);
+	g_return_val_if_fail (ARV_IS_GC (genicam), NULL);
+
+	return arv_feature_handle_new (genicam, feature, error);
+}
+
 /**
  * arv_device_is_feature_available:
  * @device: a #ArvDevice
@@ -803,16 +851,296 @@ arv_device_emit_control_lost_signal (ArvDevice *device)
 	g_signal_emit (device, arv_device_signals[ARV_DEVICE_SIGNAL_CONTROL_LOST], 0);
 }
 
-G_DEFINE_ABSTRACT_TYPE (ArvDevice, arv_device, G_TYPE_OBJECT)
+/* Zipped genicam data are inflated and parsed while they are read from the device memory */
+
+#define ARV_DEVICE_GENICAM_READ_SIZE	16384
+
+typedef struct {
+	ArvZipStream *zip_stream;
+	ArvDomParserContext *parser;
+
+	char *xml;
+	size_t xml_size;
+	size_t allocated_size;
+} ArvDeviceGenicamLoader;
+
+static void
+_genicam_loader_data_cb (const void *data, size_t size, void *user_data)
+{
+	ArvDeviceGenicamLoader *loader = user_data;
+
+	if (loader->xml_size + size > loader->allocated_size) {
+		size_t allocated_size;
+
+		/* The uncompressed size from the zip header avoids any reallocation */
+		allocated_size = arv_zip_stream_get_uncompressed_size (loader->zip_stream);
+		if (allocated_size < loader->xml_size + size)
+			allocated_size = MAX (2 * loader->allocated_size, loader->xml_size + size);
+
+		loader->xml = g_realloc (loader->xml, allocated_size + 1);
+		loader->allocated_size = allocated_size;
+	}
+
+	memcpy (loader->xml + loader->xml_size, data, size);
+	loader->xml_size += size;
+	loader->xml[loader->xml_size] = '\0';
+
+	if (loader->parser != NULL)
+		arv_dom_parser_context_push (loader->parser, data, size);
+}
+
+static gboolean
+_is_xml_file_name (const char *name)
+{
+	size_t length;
+
+	if (name == NULL)
+		return FALSE;
+
+	length = strlen (name);
+
+	return length >= 4 && g_ascii_strcasecmp (name + length - 4, ".xml") == 0;
+}
+
+/*
+ * arv_device_load_zipped_genicam:
+ * @device: a #ArvDevice
+ * @address: zip archive address in the device memory
+ * @size: zip archive size
+ * @xml_size: (out): uncompressed genicam data size
+ * @genicam: (out) (allow-none): placeholder for the parsed genicam document
+ *
+ * Reads the zip archive by chunks, inflating and parsing the genicam data as soon as they are received. Only the
+ * first file of the archive is extracted, and the reading stops at its end.
+ *
+ * Returns: the uncompressed genicam data, NULL on error. In that case, the caller may fall back to a full
+ * download and the use of #ArvZip.
+ */
+
+char *
+arv_device_load_zipped_genicam (ArvDevice *device, guint64 address, size_t size, size_t *xml_size, ArvGc **genicam)
+{
+	ArvDeviceGenicamLoader loader = {0};
+	ArvDomDocument *document = NULL;
+	GError *local_error = NULL;
+	void *chunk;
+	size_t offset;
+	gint64 start_time;
+
+	g_return_val_if_fail (ARV_IS_DEVICE (device), NULL);
+	g_return_val_if_fail (xml_size != NULL, NULL);
+
+	*xml_size = 0;
+	if (genicam != NULL)
+		*genicam = NULL;
+
+	start_time = g_get_monotonic_time ();
+
+	loader.zip_stream = arv_zip_stream_new (_genicam_loader_data_cb, &loader);
+	if (genicam != NULL)
+		loader.parser = arv_dom_parser_context_new ();
+
+	chunk = g_malloc (ARV_DEVICE_GENICAM_READ_SIZE);
+
+	for (offset = 0; offset < size && !arv_zip_stream_is_done (loader.zip_stream); ) {
+		size_t chunk_size = MIN (ARV_DEVICE_GENICAM_READ_SIZE, size - offset);
+		const char *file_name;
+
+		if (!arv_device_read_memory (device, address + offset, chunk_size, chunk, &local_error)) {
+			arv_warning_device ("[Device::load_zipped_genicam] %s", local_error->message);
+			g_clear_error (&local_error);
+			break;
+		}
+
+		if (!arv_zip_stream_push (loader.zip_stream, chunk, chunk_size))
+			break;
+
+		file_name = arv_zip_stream_get_file_name (loader.zip_stream);
+		if (file_name != NULL && !_is_xml_file_name (file_name)) {
+			arv_debug_device ("[Device::load_zipped_genicam] Unexpected first file in archive (%s)", file_name);
+			break;
+		}
+
+		offset += chunk_size;
+	}
+
+	g_free (chunk);
+
+	if (loader.parser != NULL)
+		document = arv_dom_parser_context_finish (loader.parser, NULL);
+
+	if (!arv_zip_stream_is_done (loader.zip_stream)) {
+		arv_zip_stream_free (loader.zip_stream);
+		g_clear_object (&document);
+		g_free (loader.xml);
+
+		return NULL;
+	}
+
+	arv_debug_device ("[Device::load_zipped_genicam] %s: %" G_GSIZE_FORMAT " bytes read out of %" G_GSIZE_FORMAT
+			  ", %" G_GSIZE_FORMAT " bytes inflated in %.3f s",
+			  arv_zip_stream_get_file_name (loader.zip_stream), offset,
+			  size, loader.xml_size, (g_get_monotonic_time () - start_time) / 1e6);
+
+	arv_zip_stream_free (loader.zip_stream);
+
+	if (genicam != NULL && document != NULL)
+		*genicam = arv_gc_new_from_document (device, document);
+
+	*xml_size = loader.xml_size;
+
+	return loader.xml;
+}
+
+/* Default timestamp latch implementation, using the SFNC features, with a fallback to the GigE Vision ones */
+
+static gboolean
+_latch_timestamp (ArvDevice *device, GError **error)
+{
+	GError *local_error = NULL;
+
+	if (arv_device_get_feature (device, "TimestampLatch") != NULL)
+		arv_device_execute_command (device, "TimestampLatch", &local_error);
+	else
+		arv_device_execute_command (device, "GevTimestampControlLatch", &local_error);
+
+	if (local_error != NULL) {
+		g_propagate_error (error, local_error);
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+static gboolean
+_get_latched_timestamp (ArvDevice *device, guint64 *timestamp_ns, GError **error)
+{
+	GError *local_error = NULL;
+	gint64 value;
+
+	if (arv_device_get_feature (device, "TimestampLatchValue") != NULL) {
+		value = arv_device_get_integer_feature_value (device, "TimestampLatchValue", &local_error);
+	} else {
+		gint64 frequency = 0;
+
+		value = arv_device_get_integer_feature_value (device, "GevTimestampValue", &local_error);
+		if (local_error == NULL)
+			frequency = arv_device_get_integer_feature_value (device, "GevTimestampTickFrequency",
+									  &local_error);
+		/* Conversion to ns, the same way as the GVSP packet timestamps */
+		if (local_error == NULL && frequency > 0)
+			value = (guint64) value / frequency * 1000000000LL +
+				((guint64) value % frequency) * 1000000000LL / frequency;
+	}
+
+	if (local_error != NULL) {
+		g_propagate_error (error, local_error);
+		return FALSE;
+	}
+
+	*timestamp_ns = value;
+
+	return TRUE;
+}
+
+/**
+ * arv_device_sample_clock:
+ * @device: a #ArvDevice
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Latches the device timestamp several times, and adds the latch with the shortest round trip time to the
+ * device clock model, the host time being taken at the middle of the latch request. The latched value is only
+ * retrieved when the round trip time improves. This function should be called periodically, typically every few
+ * seconds, for the estimation of the clock drift. GigE Vision devices can do it from their heartbeat thread, see
+ * arv_gv_device_set_clock_sampling().
+ *
+ * Returns: %TRUE on success.
+ *
+ * Since: 0.8.0
+ */
+
+gboolean
+arv_device_sample_clock (ArvDevice *device, GError **error)
+{
+	ArvDevicePrivate *priv = arv_device_get_instance_private (device);
+	ArvDeviceClass *device_class;
+	guint64 best_device_time = 0;
+	guint64 best_host_time = 0;
+	guint64 best_round_trip = G_MAXUINT64;
+	guint i;
+
+	g_return_val_if_fail (ARV_IS_DEVICE (device), FALSE);
+
+	device_class = ARV_DEVICE_GET_CLASS (device);
+
+	for (i = 0; i < ARV_DEVICE_CLOCK_SAMPLE_N_LATCHES; i++) {
+		guint64 device_time;
+		gint64 start_time;
+		gint64 end_time;
+
+		start_time = g_get_real_time ();
+		if (!device_class->latch_timestamp (device, error))
+			return FALSE;
+		end_time = g_get_real_time ();
+
+		/* The latched value is only retrieved if it is the best one so far */
+		if ((guint64) (end_time - start_time) < best_round_trip) {
+			if (!device_class->get_latched_timestamp (device, &device_time, error))
+				return FALSE;
+
+			best_round_trip = end_time - start_time;
+			best_host_time = (start_time + end_time) * 500LL;
+			best_device_time = device_time;
+		}
+	}
+
+	arv_clock_model_add_sample (priv->clock_model, best_device_time, best_host_time, best_round_trip * 500LL);
+
+	arv_log_device ("[Device::sample_clock] Round trip %" G_GUINT64_FORMAT " µs, offset %" G_GINT64_FORMAT
+			" ns, drift %.3f ppm", best_round_trip,
+			arv_clock_model_get_offset (priv->clock_model),
+			arv_clock_model_get_drift (priv->clock_model));
+
+	return TRUE;
+}
+
+/**
+ * arv_device_get_clock_model:
+ * @device: a #ArvDevice
+ *
+ * Gets the model of the device clock, built from the samples taken by arv_device_sample_clock(). It converts the
+ * buffer timestamps to the host real time base, the one of arv_buffer_get_system_timestamp().
+ *
+ * Returns: (transfer none): the device #ArvClockModel.
+ *
+ * Since: 0.8.0
+ */
+
+ArvClockModel *
+arv_device_get_clock_model (ArvDevice *device)
+{
+	ArvDevicePrivate *priv = arv_device_get_instance_private (device);
+
+	g_return_val_if_fail (ARV_IS_DEVICE (device), NULL);
+
+	return priv->clock_model;
+}
 
 static void
 arv_device_init (ArvDevice *device)
 {
+	ArvDevicePrivate *priv = arv_device_get_instance_private (device);
+
+	priv->clock_model = arv_clock_model_new ();
 }
 
 static void
 arv_device_finalize (GObject *object)
 {
+	ArvDevicePrivate *priv = arv_device_get_instance_private (ARV_DEVICE (object));
+
+	g_clear_object (&priv->clock_model);
+
 	G_OBJECT_CLASS (arv_device_parent_class)->finalize (object);
 }
 
@@ -823,6 +1151,9 @@ arv_device_class_init (ArvDeviceClass *device_class)
 
 	object_class->finalize = arv_device_finalize;
 
+	device_class->latch_timestamp = _latch_timestamp;
+	device_class->get_latched_timestamp = _get_latched_timestamp;
+
 	/**
 	 * ArvDevice::control-lost:
 	 * @device:a #ArvDevice
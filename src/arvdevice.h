@@ -30,6 +30,7 @@
 #include <arvtypes.h>
 #include <arvstream.h>
 #include <arvchunkparser.h>
+#include <arvfeaturehandle.h>
 
 G_BEGIN_DECLS
 
@@ -45,6 +46,8 @@ GQuark 		arv_device_error_quark 		(void);
  * @ARV_DEVICE_ERROR_PROTOCOL_ERROR: Protocol error
  * @ARV_DEVICE_ERROR_TRANSFER_ERROR: Transfer error
  * @ARV_DEVICE_ERROR_TIMEOUT: Tiemout detected
+ * @ARV_DEVICE_ERROR_NOT_FOUND: Device not found (Since 0.8.0)
+ * @ARV_DEVICE_ERROR_GENICAM_NOT_FOUND: Genicam data not found (Since 0.8.0)
  */
 
 typedef enum {
@@ -54,6 +57,8 @@ typedef enum {
 	ARV_DEVICE_ERROR_PROTOCOL_ERROR,
 	ARV_DEVICE_ERROR_TRANSFER_ERROR,
 	ARV_DEVICE_ERROR_TIMEOUT,
+	ARV_DEVICE_ERROR_NOT_FOUND,
+	ARV_DEVICE_ERROR_GENICAM_NOT_FOUND
 } ArvDeviceError;
 
 #define ARV_TYPE_DEVICE             (arv_device_get_type ())
@@ -72,6 +77,9 @@ struct _ArvDeviceClass {
 	gboolean	(*read_register)	(ArvDevice *device, guint64 address, guint32 *value, GError **error);
 	gboolean	(*write_register)	(ArvDevice *device, guint64 address, guint32 value, GError **error);
 
+	gboolean	(*latch_timestamp)		(ArvDevice *device, GError **error);
+	gboolean	(*get_latched_timestamp)	(ArvDevice *device, guint64 *timestamp_ns, GError **error);
+
 	/* signals */
 	void		(*control_lost)		(ArvDevice *device);
 };
@@ -88,6 +96,7 @@ ArvGc *		arv_device_get_genicam			(ArvDevice *device);
 
 gboolean 	arv_device_is_feature_available 	(ArvDevice *device, const char *feature, GError **error);
 ArvGcNode *	arv_device_get_feature			(ArvDevice *device, const char *feature);
+ArvFeatureHandle *	arv_device_get_feature_handle	(ArvDevice *device, const char *feature, GError **error);
 
 ArvChunkParser *arv_device_create_chunk_parser		(ArvDevice *device);
 
@@ -118,6 +127,9 @@ const char **	arv_device_get_available_enumeration_feature_values_as_display_nam
 
 void		arv_device_set_register_cache_policy	(ArvDevice *device, ArvRegisterCachePolicy policy);
 
+gboolean	arv_device_sample_clock			(ArvDevice *device, GError **error);
+ArvClockModel *	arv_device_get_clock_model		(ArvDevice *device);
+
 G_END_DECLS
 
 #endif
@@ -33,6 +33,9 @@ G_BEGIN_DECLS
 
 void 		arv_device_emit_control_lost_signal 	(ArvDevice *device);
 
+char *		arv_device_load_zipped_genicam		(ArvDevice *device, guint64 address, size_t size,
+							 size_t *xml_size, ArvGc **genicam);
+
 G_END_DECLS
 
 #endif
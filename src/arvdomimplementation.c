@@ -27,10 +27,10 @@
 #include <string.h>
 
 static GHashTable *document_types = NULL;
+static GMutex document_types_mutex;
 
-void
-arv_dom_implementation_add_document_type (const char *qualified_name,
-					  GType document_type)
+static void
+_add_document_type (const char *qualified_name, GType document_type)
 {
 	GType *document_type_ptr;
 
@@ -43,6 +43,15 @@ arv_dom_implementation_add_document_type (const char *qualified_name,
 	g_hash_table_insert (document_types, g_strdup (qualified_name), document_type_ptr);
 }
 
+void
+arv_dom_implementation_add_document_type (const char *qualified_name,
+					  GType document_type)
+{
+	g_mutex_lock (&document_types_mutex);
+	_add_document_type (qualified_name, document_type);
+	g_mutex_unlock (&document_types_mutex);
+}
+
 /**
  * arv_dom_implementation_create_document:
  * @namespace_uri: namespace URI
@@ -58,29 +67,39 @@ arv_dom_implementation_create_document (const char *namespace_uri,
 					const char *qualified_name)
 {
 	GType *document_type;
+	GType type = G_TYPE_INVALID;
 
 	g_return_val_if_fail (qualified_name != NULL, NULL);
 
-	if (document_types == NULL) {
-		arv_dom_implementation_add_document_type ("RegisterDescription", ARV_TYPE_GC);
-	}
+	g_mutex_lock (&document_types_mutex);
+
+	if (document_types == NULL)
+		_add_document_type ("RegisterDescription", ARV_TYPE_GC);
 
 	document_type = g_hash_table_lookup (document_types, qualified_name);
-	if (document_type == NULL) {
+	if (document_type != NULL)
+		type = *document_type;
+
+	g_mutex_unlock (&document_types_mutex);
+
+	if (type == G_TYPE_INVALID) {
 		arv_debug_dom ("[ArvDomImplementation::create_document] Unknow document type (%s)",
 			       qualified_name);
 		return NULL;
 	}
 
-	return g_object_new (*document_type, NULL);
+	return g_object_new (type, NULL);
 }
 
 void
 arv_dom_implementation_cleanup (void)
 {
-	if (document_types == NULL)
-		return;
+	g_mutex_lock (&document_types_mutex);
+
+	if (document_types != NULL) {
+		g_hash_table_unref (document_types);
+		document_types = NULL;
+	}
 
-	g_hash_table_unref (document_types);
-	document_types = NULL;
+	g_mutex_unlock (&document_types_mutex);
 }
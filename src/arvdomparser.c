@@ -25,7 +25,7 @@
 #include <arvdomimplementation.h>
 #include <arvdomnode.h>
 #include <arvdomelement.h>
-#include <arvdomparser.h>
+#include <arvdomparserprivate.h>
 #include <arvstr.h>
 #include <libxml/parser.h>
 #include <gio/gio.h>
@@ -244,6 +244,88 @@ _parse_memory (ArvDomDocument *document, ArvDomNode *node,
 	return state.document;
 }
 
+/* Incremental parsing, for xml data received by chunks */
+
+struct _ArvDomParserContext {
+	ArvDomSaxParserState state;
+	xmlParserCtxtPtr xml_context;
+	gboolean is_error;
+};
+
+ArvDomParserContext *
+arv_dom_parser_context_new (void)
+{
+	ArvDomParserContext *context;
+
+	context = g_new0 (ArvDomParserContext, 1);
+	context->state.current_node = NULL;
+	context->xml_context = xmlCreatePushParserCtxt (&sax_handler, &context->state, NULL, 0, NULL);
+	if (context->xml_context == NULL) {
+		g_free (context);
+		return NULL;
+	}
+
+	return context;
+}
+
+gboolean
+arv_dom_parser_context_push (ArvDomParserContext *context, const void *buffer, size_t size)
+{
+	g_return_val_if_fail (context != NULL, FALSE);
+	g_return_val_if_fail (buffer != NULL || size == 0, FALSE);
+
+	if (context->is_error)
+		return FALSE;
+
+	while (size > 0) {
+		int chunk_size = MIN (size, G_MAXINT);
+
+		if (xmlParseChunk (context->xml_context, buffer, chunk_size, 0) != 0) {
+			context->is_error = TRUE;
+			return FALSE;
+		}
+
+		buffer = ((const char *) buffer) + chunk_size;
+		size -= chunk_size;
+	}
+
+	return TRUE;
+}
+
+/* Frees the context, and returns the parsed document */
+
+ArvDomDocument *
+arv_dom_parser_context_finish (ArvDomParserContext *context, GError **error)
+{
+	ArvDomDocument *document;
+
+	g_return_val_if_fail (context != NULL, NULL);
+
+	if (!context->is_error &&
+	    xmlParseChunk (context->xml_context, NULL, 0, 1) != 0)
+		context->is_error = TRUE;
+
+	context->is_error = context->is_error || !context->xml_context->wellFormed;
+
+	document = context->state.document;
+
+	if (context->is_error) {
+		g_clear_object (&document);
+
+		arv_warning_dom ("[ArvDomParser::context_finish] Invalid document");
+
+		g_set_error (error,
+			     ARV_DOM_DOCUMENT_ERROR,
+			     ARV_DOM_DOCUMENT_ERROR_INVALID_XML,
+			     "Invalid document.");
+	}
+
+	xmlFreeParserCtxt (context->xml_context);
+	g_free (context);
+
+	return document;
+}
+
 /**
  * arv_dom_document_append_from_memory:
  * @document: a #ArvDomDocument
@@ -64,6 +64,7 @@ arv_get_fake_camera_genicam_filename (void)
 }
 
 typedef struct {
+	GMutex memory_mutex;
 	void *memory;
 
 	char *genicam_xml;
@@ -104,7 +105,9 @@ arv_fake_camera_read_memory (ArvFakeCamera *camera, guint32 address, guint32 siz
 	if (address < ARV_FAKE_CAMERA_MEMORY_SIZE) {
 		read_size = MIN (address  + size, ARV_FAKE_CAMERA_MEMORY_SIZE) - address;
 
+		g_mutex_lock (&camera->priv->memory_mutex);
 		memcpy (buffer, ((char *) camera->priv->memory) + address, read_size);
+		g_mutex_unlock (&camera->priv->memory_mutex);
 
 		if (read_size == size)
 			return TRUE;
@@ -136,8 +139,29 @@ arv_fake_camera_write_memory (ArvFakeCamera *camera, guint32 address, guint32 si
 	if (address + size > ARV_FAKE_CAMERA_MEMORY_SIZE)
 		return FALSE;
 
+	g_mutex_lock (&camera->priv->memory_mutex);
+
 	memcpy (((char *) camera->priv->memory) + address, buffer, size);
 
+	/* Timestamps are in ns since epoch, with a 1 GHz tick frequency */
+	if (address <= ARV_GVBS_TIMESTAMP_CONTROL_OFFSET &&
+	    address + size >= ARV_GVBS_TIMESTAMP_CONTROL_OFFSET + sizeof (guint32)) {
+		guint32 control;
+
+		control = GUINT32_FROM_BE (*((guint32 *) (((char *) camera->priv->memory) +
+							  ARV_GVBS_TIMESTAMP_CONTROL_OFFSET)));
+		if ((control & ARV_GVBS_TIMESTAMP_CONTROL_LATCH) != 0) {
+			guint64 timestamp = g_get_real_time () * 1000LL;
+
+			*((guint32 *) (((char *) camera->priv->memory) + ARV_GVBS_TIMESTAMP_LATCHED_VALUE_HIGH_OFFSET)) =
+				GUINT32_TO_BE (timestamp >> 32);
+			*((guint32 *) (((char *) camera->priv->memory) + ARV_GVBS_TIMESTAMP_LATCHED_VALUE_LOW_OFFSET)) =
+				GUINT32_TO_BE (timestamp & 0xffffffff);
+		}
+	}
+
+	g_mutex_unlock (&camera->priv->memory_mutex);
+
 	return TRUE;
 }
 
@@ -181,7 +205,9 @@ _get_register (ArvFakeCamera *camera, guint32 address)
 	if (address + sizeof (guint32) > ARV_FAKE_CAMERA_MEMORY_SIZE)
 		return 0;
 
+	g_mutex_lock (&camera->priv->memory_mutex);
 	value = *((guint32 *) (((char *)(camera->priv->memory) + address)));
+	g_mutex_unlock (&camera->priv->memory_mutex);
 
 	return GUINT32_FROM_BE (value);
 }
@@ -517,12 +543,14 @@ arv_fake_camera_diagonal_ramp (ArvBuffer *buffer, void *fill_pattern_data,
 	guint32 x, y;
 	guint32 width;
 	guint32 height;
+	size_t row_stride;
 
 	if (buffer == NULL)
 		return;
 
 	width = buffer->priv->width;
 	height = buffer->priv->height;
+	row_stride = arv_buffer_get_image_row_stride (buffer);
 
 	scale = 1.0 + gain + log10 ((double) exposure_time_us / 10000.0);
 
@@ -531,7 +559,7 @@ arv_fake_camera_diagonal_ramp (ArvBuffer *buffer, void *fill_pattern_data,
 		case ARV_PIXEL_FORMAT_MONO_8:
 			for (y = 0; y < height; y++)
 				for (x = 0; x < width; x++) {
-					unsigned char *pixel = &buffer->priv->data [y * width + x];
+					unsigned char *pixel = &buffer->priv->data [y * row_stride + x];
 
 					pixel_value = (x + buffer->priv->frame_id + y) % 255;
 					pixel_value *= scale;
@@ -543,7 +571,7 @@ arv_fake_camera_diagonal_ramp (ArvBuffer *buffer, void *fill_pattern_data,
 		case ARV_PIXEL_FORMAT_RGB_8_PACKED:
 			for (y = 0; y < height; y++)
 				for (x = 0; x < width; x++) {
-					unsigned char *pixel = &buffer->priv->data [3 * (y * width + x)];
+					unsigned char *pixel = &buffer->priv->data [y * row_stride + 3 * x];
 					unsigned int index;
 
 					pixel_value = (x + buffer->priv->frame_id + y) % 255;
@@ -567,7 +595,8 @@ arv_fake_camera_diagonal_ramp (ArvBuffer *buffer, void *fill_pattern_data,
  * @fill_pattern_callback: (scope call): callback for image filling
  * @fill_pattern_data: (closure): image filling user data
  *
- * Sets the fill pattern callback for custom test images.
+ * Sets the fill pattern callback for custom test images. The image rows must be written using the stride returned
+ * by arv_buffer_get_image_row_stride(), as they may be padded.
  */
 
 void
@@ -621,6 +650,8 @@ arv_fake_camera_fill_buffer (ArvFakeCamera *camera, ArvBuffer *buffer, guint32 *
 		return;
 	}
 
+	arv_buffer_invalidate_chunk_index (buffer);
+
 	buffer->priv->payload_type = ARV_BUFFER_PAYLOAD_TYPE_IMAGE;
 	buffer->priv->chunk_endianness = G_BIG_ENDIAN;
 	buffer->priv->width = width;
@@ -633,6 +664,10 @@ arv_fake_camera_fill_buffer (ArvFakeCamera *camera, ArvBuffer *buffer, guint32 *
 	buffer->priv->frame_id = camera->priv->frame_id++;
 	buffer->priv->pixel_format = _get_register (camera, ARV_FAKE_CAMERA_REGISTER_PIXEL_FORMAT);
 
+	/* The fill pattern callback writes the rows directly at their padded offset */
+	buffer->priv->row_stride = 0;
+	arv_buffer_get_padded_layout (buffer, NULL, &buffer->priv->row_stride);
+
 	g_mutex_lock (&camera->priv->fill_pattern_mutex);
 
 	arv_fake_camera_read_register (camera, ARV_FAKE_CAMERA_REGISTER_EXPOSURE_TIME_US, &exposure_time_us);
@@ -710,6 +745,117 @@ arv_fake_camera_set_trigger_frequency (ArvFakeCamera *camera, double frequency)
 	camera->priv->trigger_frequency = frequency;
 }
 
+/**
+ * arv_fake_camera_is_action_trigger_enabled:
+ * @camera: a #ArvFakeCamera
+ *
+ * Return value: %TRUE if the frame start trigger is enabled, with an action signal as source.
+ *
+ * Since: 0.8.0
+ */
+
+gboolean
+arv_fake_camera_is_action_trigger_enabled (ArvFakeCamera *camera)
+{
+	g_return_val_if_fail (ARV_IS_FAKE_CAMERA (camera), FALSE);
+
+	return _get_register (camera, ARV_FAKE_CAMERA_REGISTER_TRIGGER_MODE) == 1 &&
+		_get_register (camera, ARV_FAKE_CAMERA_REGISTER_TRIGGER_SOURCE) == ARV_FAKE_CAMERA_TRIGGER_SOURCE_ACTION1;
+}
+
+/**
+ * arv_fake_camera_check_action_command:
+ * @camera: a #ArvFakeCamera
+ * @device_key: action command device key
+ * @group_key: action command group key
+ * @group_mask: action command group mask
+ *
+ * Checks whether an action command is addressed to @camera, following the
+ * GigE Vision rules: the device key must match, and one of the action signals
+ * must have the same group key and a group mask sharing at least one bit with
+ * @group_mask.
+ *
+ * Return value: %TRUE if the action command must be executed by @camera.
+ *
+ * Since: 0.8.0
+ */
+
+gboolean
+arv_fake_camera_check_action_command (ArvFakeCamera *camera, guint32 device_key, guint32 group_key, guint32 group_mask)
+{
+	guint32 n_action_signals;
+	guint32 i;
+
+	g_return_val_if_fail (ARV_IS_FAKE_CAMERA (camera), FALSE);
+
+	if (_get_register (camera, ARV_GVBS_ACTION_DEVICE_KEY_OFFSET) != device_key)
+		return FALSE;
+
+	n_action_signals = _get_register (camera, ARV_GVBS_N_ACTION_SIGNALS_OFFSET);
+
+	for (i = 0; i < n_action_signals; i++) {
+		guint32 offset = i * ARV_GVBS_ACTION_GROUP_SIZE;
+
+		if (_get_register (camera, ARV_GVBS_ACTION_GROUP_KEY_0_OFFSET + offset) == group_key &&
+		    (_get_register (camera, ARV_GVBS_ACTION_GROUP_MASK_0_OFFSET + offset) & group_mask) != 0)
+			return TRUE;
+	}
+
+	return FALSE;
+}
+
+/**
+ * arv_fake_camera_is_event_notification_enabled:
+ * @camera: a #ArvFakeCamera
+ * @event: an event index, for example %ARV_FAKE_CAMERA_EVENT_EXPOSURE_END
+ *
+ * Return value: %TRUE if the notification of @event is enabled.
+ *
+ * Since: 0.8.0
+ */
+
+gboolean
+arv_fake_camera_is_event_notification_enabled (ArvFakeCamera *camera, guint event)
+{
+	g_return_val_if_fail (ARV_IS_FAKE_CAMERA (camera), FALSE);
+
+	return _get_register (camera, ARV_FAKE_CAMERA_REGISTER_EVENT_NOTIFICATION + 4 * event) != 0;
+}
+
+/**
+ * arv_fake_camera_get_message_address:
+ * @camera: a #ArvFakeCamera
+ *
+ * Return value: (transfer full): the message channel #GSocketAddress for this camera, %NULL if the message channel is
+ * disabled.
+ *
+ * Since: 0.8.0
+ */
+
+GSocketAddress *
+arv_fake_camera_get_message_address (ArvFakeCamera *camera)
+{
+	GSocketAddress *message_socket_address;
+	GInetAddress *inet_address;
+	guint32 port;
+	guint32 value;
+
+	g_return_val_if_fail (ARV_IS_FAKE_CAMERA (camera), NULL);
+
+	port = _get_register (camera, ARV_GVBS_MESSAGE_CHANNEL_0_PORT_OFFSET) & 0xffff;
+	if (port == 0)
+		return NULL;
+
+	arv_fake_camera_read_memory (camera, ARV_GVBS_MESSAGE_CHANNEL_0_IP_ADDRESS_OFFSET, sizeof (value), &value);
+
+	inet_address = g_inet_address_new_from_bytes ((guint8 *) &value, G_SOCKET_FAMILY_IPV4);
+	message_socket_address = g_inet_socket_address_new (inet_address, port);
+
+	g_object_unref (inet_address);
+
+	return message_socket_address;
+}
+
 guint32
 arv_fake_camera_get_control_channel_privilege (ArvFakeCamera *camera)
 {
@@ -777,6 +923,7 @@ arv_fake_camera_new_full (const char *serial_number, const char *genicam_filenam
 
 	memory = g_malloc0 (ARV_FAKE_CAMERA_MEMORY_SIZE);
 
+	g_mutex_init (&fake_camera->priv->memory_mutex);
 	g_mutex_init (&fake_camera->priv->fill_pattern_mutex);
 	fake_camera->priv->fill_pattern_callback = arv_fake_camera_diagonal_ramp;
 	fake_camera->priv->fill_pattern_data = NULL;
@@ -845,6 +992,14 @@ arv_fake_camera_new_full (const char *serial_number, const char *genicam_filenam
 
 	arv_fake_camera_write_register (fake_camera, ARV_GVBS_N_STREAM_CHANNELS_OFFSET, 1);
 
+	arv_fake_camera_write_register (fake_camera, ARV_GVBS_N_MESSAGE_CHANNELS_OFFSET, 1);
+
+	arv_fake_camera_write_register (fake_camera, ARV_GVBS_GVCP_CAPABILITY_OFFSET,
+					ARV_GVBS_GVCP_CAPABILITY_ACTION |
+					ARV_GVBS_GVCP_CAPABILITY_EVENT |
+					ARV_GVBS_GVCP_CAPABILITY_EVENT_DATA);
+	arv_fake_camera_write_register (fake_camera, ARV_GVBS_N_ACTION_SIGNALS_OFFSET, ARV_FAKE_CAMERA_N_ACTION_SIGNALS);
+
 	arv_fake_camera_write_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_TEST, ARV_FAKE_CAMERA_TEST_REGISTER_DEFAULT);
 
 	return fake_camera;
@@ -871,6 +1026,7 @@ arv_fake_camera_finalize (GObject *object)
 	ArvFakeCamera *fake_camera = ARV_FAKE_CAMERA (object);
 
 	g_mutex_clear (&fake_camera->priv->fill_pattern_mutex);
+	g_mutex_clear (&fake_camera->priv->memory_mutex);
 	g_clear_pointer (&fake_camera->priv->memory, g_free);
 	g_clear_pointer (&fake_camera->priv->genicam_xml, g_free);
 
@@ -73,12 +73,27 @@ void arv_set_fake_camera_genicam_filename (const char *filename);
 #define ARV_FAKE_CAMERA_REGISTER_TRIGGER_SOURCE		0x304
 #define ARV_FAKE_CAMERA_REGISTER_TRIGGER_ACTIVATION	0x308
 
+#define ARV_FAKE_CAMERA_TRIGGER_SOURCE_LINE0		0
+#define ARV_FAKE_CAMERA_TRIGGER_SOURCE_ACTION1		1
+
+#define ARV_FAKE_CAMERA_N_ACTION_SIGNALS		1
+
 #define ARV_FAKE_CAMERA_REGISTER_ACQUISITION		0x124
 #define ARV_FAKE_CAMERA_REGISTER_EXPOSURE_TIME_US	0x120
 
 #define ARV_FAKE_CAMERA_ACQUISITION_FRAME_RATE_DEFAULT	25.0
 #define ARV_FAKE_CAMERA_EXPOSURE_TIME_US_DEFAULT	10000.0
 
+/* Event control */
+
+#define ARV_FAKE_CAMERA_REGISTER_EVENT_NOTIFICATION	0x340
+
+#define ARV_FAKE_CAMERA_EVENT_EXPOSURE_END		0
+#define ARV_FAKE_CAMERA_EVENT_FRAME_END			1
+
+#define ARV_FAKE_CAMERA_EVENT_ID_EXPOSURE_END		0x9001
+#define ARV_FAKE_CAMERA_EVENT_ID_FRAME_END		0x9002
+
 /* Analog control */
 
 #define ARV_FAKE_CAMERA_REGISTER_GAIN_RAW		0x110
@@ -118,6 +133,13 @@ void		arv_fake_camera_set_fill_pattern	(ArvFakeCamera *camera,
 							 void *fill_pattern_data);
 void 		arv_fake_camera_set_trigger_frequency 	(ArvFakeCamera *camera, double frequency);
 
+gboolean	arv_fake_camera_is_action_trigger_enabled	(ArvFakeCamera *camera);
+gboolean	arv_fake_camera_check_action_command		(ArvFakeCamera *camera, guint32 device_key,
+								 guint32 group_key, guint32 group_mask);
+
+gboolean	arv_fake_camera_is_event_notification_enabled	(ArvFakeCamera *camera, guint event);
+GSocketAddress *arv_fake_camera_get_message_address		(ArvFakeCamera *camera);
+
 const char *	arv_fake_camera_get_genicam_xml 	(ArvFakeCamera *camera, size_t *size);
 
 G_END_DECLS
@@ -41,7 +41,7 @@ static char *arv_option_debug_domains = NULL;
 static const GOptionEntry arv_option_entries[] =
 {
 	{ "interface",		'i', 0, G_OPTION_ARG_STRING,
-		&arv_option_interface_name,	"Listening interface name", "interface_id"},
+		&arv_option_interface_name,	"Listening interface name or IPv4 address", "interface_id"},
 	{ "serial",             's', 0, G_OPTION_ARG_STRING,
 	        &arv_option_serial_number, 	"Fake camera serial number", "serial_nbr"},
 	{ "genicam",            'g', 0, G_OPTION_ARG_STRING,
@@ -69,12 +69,15 @@ arv_fake_interface_update_device_list (ArvInterface *interface, GArray *device_i
 }
 
 static ArvDevice *
-arv_fake_interface_open_device (ArvInterface *interface, const char *device_id)
+arv_fake_interface_open_device (ArvInterface *interface, const char *device_id, GError **error)
 {
 	if (g_strcmp0 (device_id, ARV_FAKE_DEVICE_ID) == 0 ||
 	    g_strcmp0 (device_id, ARV_FAKE_PHYSICAL_ID) == 0)
 		return arv_fake_device_new ("1");
 
+	g_set_error (error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_NOT_FOUND,
+		     "[FakeInterface::open_device] Device '%s' not found", device_id != NULL ? device_id : "(null)");
+
 	return NULL;
 }
 
@@ -135,7 +138,7 @@ arv_fake_interface_class_init (ArvFakeInterfaceClass *fake_interface_class)
 	object_class->finalize = arv_fake_interface_finalize;
 
 	interface_class->update_device_list = arv_fake_interface_update_device_list;
-	interface_class->open_device = arv_fake_interface_open_device;
+	interface_class->open_device_with_error = arv_fake_interface_open_device;
 
 	interface_class->protocol = "Fake";
 }
@@ -0,0 +1,560 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2019 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel@gnome.org>
+ */
+
+/**
+ * SECTION: arvfeaturehandle
+ * @short_description: Precompiled access to a genicam feature
+ *
+ * #ArvFeatureHandle resolves a genicam feature once, and gives access to its
+ * value without the feature name lookup and node type checks of the
+ * #ArvDevice or #ArvCamera feature API. It is intended for features accessed
+ * repeatedly, like the exposure time or the gain in a control loop.
+ *
+ * The handle is bound to the feature node existing at creation time. If the
+ * value location of the feature does not depend on other nodes, the register
+ * address and length are also resolved at creation, and are available using
+ * arv_feature_handle_get_register_location(). For integer features stored in
+ * such an IntReg register, arv_feature_handle_get_int64() reads the register
+ * directly from its port when the value would not be served from the register
+ * cache anyway, skipping the evaluation of the intermediate nodes.
+ *
+ * <informalexample>
+ * <programlisting>
+ * ArvFeatureHandle *handle;
+ *
+ * handle = arv_device_get_feature_handle (device, "ExposureTime", &error);
+ * for (i = 0; i < n; i++)
+ *         arv_feature_handle_set_double (handle, exposure_times[i], &error);
+ * g_object_unref (handle);
+ * </programlisting>
+ * </informalexample>
+ */
+
+#include <arvfeaturehandle.h>
+#include <arvdevice.h>
+#include <arvgcfeaturenode.h>
+#include <arvgcintegernode.h>
+#include <arvgcfloatnode.h>
+#include <arvgcenumeration.h>
+#include <arvgcboolean.h>
+#include <arvgccommand.h>
+#include <arvgcinteger.h>
+#include <arvgcfloat.h>
+#include <arvgcstring.h>
+#include <arvgcpropertynode.h>
+#include <arvgcregisternodeprivate.h>
+#include <arvgcintregnodeprivate.h>
+#include <arvgcport.h>
+#include <arvgcprivate.h>
+#include <arvmisc.h>
+#include <arvdebug.h>
+
+/* Maximum number of pValue links followed during the register lookup */
+#define ARV_FEATURE_HANDLE_MAX_DEPTH	8
+
+typedef struct {
+	ArvGc *genicam;
+	ArvGcFeatureNode *node;
+	char *name;
+
+	/* Interfaces resolved at creation, NULL if not implemented by the node */
+	ArvGcIntegerInterface *integer_interface;
+	ArvGcFloatInterface *float_interface;
+	ArvGcStringInterface *string_interface;
+
+	gboolean has_register_location;
+	guint64 address;
+	guint64 length;
+
+	/* Direct access to the IntReg holding an integer feature value */
+	ArvGcPort *port;
+	ArvGcCachable cachable;
+	ArvGcSignedness signedness;
+	guint endianess;
+} ArvFeatureHandlePrivate;
+
+struct _ArvFeatureHandle {
+	GObject	object;
+
+	ArvFeatureHandlePrivate *priv;
+};
+
+struct _ArvFeatureHandleClass {
+	GObjectClass parent_class;
+};
+
+G_DEFINE_TYPE_WITH_CODE (ArvFeatureHandle, arv_feature_handle, G_TYPE_OBJECT, G_ADD_PRIVATE (ArvFeatureHandle))
+
+static gboolean
+_check_interface (ArvFeatureHandle *handle, gpointer interface, const char *type_name, GError **error)
+{
+	if (interface != NULL)
+		return TRUE;
+
+	g_set_error (error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_WRONG_FEATURE,
+		     "node '%s' [%s] is not a %s", handle->priv->name,
+		     G_OBJECT_TYPE_NAME (handle->priv->node), type_name);
+
+	return FALSE;
+}
+
+/* Reads the integer value from the register, the same way ArvGcIntRegNode does, but without going through the node
+ * chain. Only used when the register node would read the port anyway. */
+
+static gboolean
+_get_direct_int64 (ArvFeatureHandle *handle, gint64 *value, GError **error)
+{
+	ArvFeatureHandlePrivate *priv = handle->priv;
+	GError *local_error = NULL;
+	guint8 data[8];
+
+	if (priv->port == NULL)
+		return FALSE;
+
+	if (priv->cachable != ARV_GC_CACHABLE_NO_CACHE &&
+	    arv_gc_get_register_cache_policy (priv->genicam) != ARV_REGISTER_CACHE_POLICY_DISABLE)
+		return FALSE;
+
+	arv_gc_port_read (priv->port, data, priv->address, priv->length, &local_error);
+	if (local_error != NULL) {
+		g_propagate_error (error, local_error);
+		*value = 0;
+		return TRUE;
+	}
+
+	if (priv->cachable == ARV_GC_CACHABLE_NO_CACHE)
+		arv_gc_increment_uncached_read_count (priv->genicam);
+
+	arv_copy_memory_with_endianess (value, sizeof (*value), G_BYTE_ORDER, data, priv->length, priv->endianess);
+
+	if (priv->length < 8 &&
+	    (*value & (((guint64) 1) << (priv->length * 8 - 1))) != 0 &&
+	    priv->signedness == ARV_GC_SIGNEDNESS_SIGNED)
+		*value |= G_MAXUINT64 ^ ((((guint64) 1) << (priv->length * 8)) - 1);
+
+	return TRUE;
+}
+
+/**
+ * arv_feature_handle_get_int64:
+ * @handle: a #ArvFeatureHandle
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Returns: the integer feature value, 0 on error.
+ *
+ * Since: 0.8.0
+ */
+
+gint64
+arv_feature_handle_get_int64 (ArvFeatureHandle *handle, GError **error)
+{
+	gint64 value;
+
+	g_return_val_if_fail (ARV_IS_FEATURE_HANDLE (handle), 0);
+
+	if (!_check_interface (handle, handle->priv->integer_interface, "ArvGcInteger", error))
+		return 0;
+
+	if (_get_direct_int64 (handle, &value, error))
+		return value;
+
+	return handle->priv->integer_interface->get_value ((ArvGcInteger *) handle->priv->node, error);
+}
+
+/**
+ * arv_feature_handle_set_int64:
+ * @handle: a #ArvFeatureHandle
+ * @value: new feature value
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Set the integer feature value.
+ *
+ * Since: 0.8.0
+ */
+
+void
+arv_feature_handle_set_int64 (ArvFeatureHandle *handle, gint64 value, GError **error)
+{
+	g_return_if_fail (ARV_IS_FEATURE_HANDLE (handle));
+
+	if (!_check_interface (handle, handle->priv->integer_interface, "ArvGcInteger", error))
+		return;
+
+	handle->priv->integer_interface->set_value ((ArvGcInteger *) handle->priv->node, value, error);
+}
+
+/**
+ * arv_feature_handle_get_double:
+ * @handle: a #ArvFeatureHandle
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Returns: the float feature value, 0.0 on error.
+ *
+ * Since: 0.8.0
+ */
+
+double
+arv_feature_handle_get_double (ArvFeatureHandle *handle, GError **error)
+{
+	g_return_val_if_fail (ARV_IS_FEATURE_HANDLE (handle), 0.0);
+
+	if (!_check_interface (handle, handle->priv->float_interface, "ArvGcFloat", error))
+		return 0.0;
+
+	return handle->priv->float_interface->get_value ((ArvGcFloat *) handle->priv->node, error);
+}
+
+/**
+ * arv_feature_handle_set_double:
+ * @handle: a #ArvFeatureHandle
+ * @value: new feature value
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Set the float feature value.
+ *
+ * Since: 0.8.0
+ */
+
+void
+arv_feature_handle_set_double (ArvFeatureHandle *handle, double value, GError **error)
+{
+	g_return_if_fail (ARV_IS_FEATURE_HANDLE (handle));
+
+	if (!_check_interface (handle, handle->priv->float_interface, "ArvGcFloat", error))
+		return;
+
+	handle->priv->float_interface->set_value ((ArvGcFloat *) handle->priv->node, value, error);
+}
+
+/**
+ * arv_feature_handle_get_boolean:
+ * @handle: a #ArvFeatureHandle
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Returns: the boolean feature value, %FALSE on error.
+ *
+ * Since: 0.8.0
+ */
+
+gboolean
+arv_feature_handle_get_boolean (ArvFeatureHandle *handle, GError **error)
+{
+	g_return_val_if_fail (ARV_IS_FEATURE_HANDLE (handle), FALSE);
+
+	if (!_check_interface (handle, ARV_IS_GC_BOOLEAN (handle->priv->node) ? handle : NULL, "ArvGcBoolean", error))
+		return FALSE;
+
+	return arv_gc_boolean_get_value (ARV_GC_BOOLEAN (handle->priv->node), error);
+}
+
+/**
+ * arv_feature_handle_set_boolean:
+ * @handle: a #ArvFeatureHandle
+ * @value: new feature value
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Set the boolean feature value.
+ *
+ * Since: 0.8.0
+ */
+
+void
+arv_feature_handle_set_boolean (ArvFeatureHandle *handle, gboolean value, GError **error)
+{
+	g_return_if_fail (ARV_IS_FEATURE_HANDLE (handle));
+
+	if (!_check_interface (handle, ARV_IS_GC_BOOLEAN (handle->priv->node) ? handle : NULL, "ArvGcBoolean", error))
+		return;
+
+	arv_gc_boolean_set_value (ARV_GC_BOOLEAN (handle->priv->node), value, error);
+}
+
+/**
+ * arv_feature_handle_get_string:
+ * @handle: a #ArvFeatureHandle
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Returns: the string feature value, %NULL on error.
+ *
+ * Since: 0.8.0
+ */
+
+const char *
+arv_feature_handle_get_string (ArvFeatureHandle *handle, GError **error)
+{
+	g_return_val_if_fail (ARV_IS_FEATURE_HANDLE (handle), NULL);
+
+	if (!_check_interface (handle, handle->priv->string_interface, "ArvGcString", error))
+		return NULL;
+
+	return handle->priv->string_interface->get_value ((ArvGcString *) handle->priv->node, error);
+}
+
+/**
+ * arv_feature_handle_set_string:
+ * @handle: a #ArvFeatureHandle
+ * @value: new feature value
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Set the string feature value.
+ *
+ * Since: 0.8.0
+ */
+
+void
+arv_feature_handle_set_string (ArvFeatureHandle *handle, const char *value, GError **error)
+{
+	g_return_if_fail (ARV_IS_FEATURE_HANDLE (handle));
+
+	if (!_check_interface (handle, handle->priv->string_interface, "ArvGcString", error))
+		return;
+
+	handle->priv->string_interface->set_value ((ArvGcString *) handle->priv->node, value, error);
+}
+
+/**
+ * arv_feature_handle_execute:
+ * @handle: a #ArvFeatureHandle
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Execute a genicam command.
+ *
+ * Since: 0.8.0
+ */
+
+void
+arv_feature_handle_execute (ArvFeatureHandle *handle, GError **error)
+{
+	g_return_if_fail (ARV_IS_FEATURE_HANDLE (handle));
+
+	if (!_check_interface (handle, ARV_IS_GC_COMMAND (handle->priv->node) ? handle : NULL, "ArvGcCommand", error))
+		return;
+
+	arv_gc_command_execute (ARV_GC_COMMAND (handle->priv->node), error);
+}
+
+/**
+ * arv_feature_handle_get_name:
+ * @handle: a #ArvFeatureHandle
+ *
+ * Returns: the feature name.
+ *
+ * Since: 0.8.0
+ */
+
+const char *
+arv_feature_handle_get_name (ArvFeatureHandle *handle)
+{
+	g_return_val_if_fail (ARV_IS_FEATURE_HANDLE (handle), NULL);
+
+	return handle->priv->name;
+}
+
+/**
+ * arv_feature_handle_get_node:
+ * @handle: a #ArvFeatureHandle
+ *
+ * Returns: (transfer none): the feature node resolved at the handle creation.
+ *
+ * Since: 0.8.0
+ */
+
+ArvGcFeatureNode *
+arv_feature_handle_get_node (ArvFeatureHandle *handle)
+{
+	g_return_val_if_fail (ARV_IS_FEATURE_HANDLE (handle), NULL);
+
+	return handle->priv->node;
+}
+
+/**
+ * arv_feature_handle_get_register_location:
+ * @handle: a #ArvFeatureHandle
+ * @address: (out) (allow-none): register address
+ * @length: (out) (allow-none): register length
+ *
+ * Retrieves the location of the register holding the feature value, if it
+ * was resolved at the handle creation. This is only the case if the feature
+ * value is directly stored in a register with an address that does not depend
+ * on other features.
+ *
+ * Returns: %TRUE if the register location is known.
+ *
+ * Since: 0.8.0
+ */
+
+gboolean
+arv_feature_handle_get_register_location (ArvFeatureHandle *handle, guint64 *address, guint64 *length)
+{
+	g_return_val_if_fail (ARV_IS_FEATURE_HANDLE (handle), FALSE);
+
+	if (!handle->priv->has_register_location)
+		return FALSE;
+
+	if (address != NULL)
+		*address = handle->priv->address;
+	if (length != NULL)
+		*length = handle->priv->length;
+
+	return TRUE;
+}
+
+/* Follows the pValue links of the value forwarding nodes, until a register node is found */
+
+static ArvGcRegisterNode *
+_find_register_node (ArvGcFeatureNode *node)
+{
+	unsigned int depth;
+
+	for (depth = 0; depth < ARV_FEATURE_HANDLE_MAX_DEPTH && node != NULL; depth++) {
+		ArvDomNode *iter;
+		ArvGcNode *value_node = NULL;
+
+		if (ARV_IS_GC_REGISTER_NODE (node))
+			return ARV_GC_REGISTER_NODE (node);
+
+		if (!ARV_IS_GC_INTEGER_NODE (node) &&
+		    !ARV_IS_GC_FLOAT_NODE (node) &&
+		    !ARV_IS_GC_BOOLEAN (node) &&
+		    !ARV_IS_GC_ENUMERATION (node))
+			return NULL;
+
+		for (iter = arv_dom_node_get_first_child (ARV_DOM_NODE (node));
+		     iter != NULL;
+		     iter = arv_dom_node_get_next_sibling (iter)) {
+			if (ARV_IS_GC_PROPERTY_NODE (iter)) {
+				switch (arv_gc_property_node_get_node_type (ARV_GC_PROPERTY_NODE (iter))) {
+					case ARV_GC_PROPERTY_NODE_TYPE_P_VALUE:
+						value_node = arv_gc_property_node_get_linked_node
+							(ARV_GC_PROPERTY_NODE (iter));
+						break;
+					case ARV_GC_PROPERTY_NODE_TYPE_P_INDEX:
+					case ARV_GC_PROPERTY_NODE_TYPE_VALUE_INDEXED:
+					case ARV_GC_PROPERTY_NODE_TYPE_P_VALUE_INDEXED:
+					case ARV_GC_PROPERTY_NODE_TYPE_P_VALUE_DEFAULT:
+						/* The value location depends on an index node */
+						return NULL;
+					default:
+						break;
+				}
+			}
+		}
+
+		node = ARV_IS_GC_FEATURE_NODE (value_node) ? ARV_GC_FEATURE_NODE (value_node) : NULL;
+	}
+
+	return NULL;
+}
+
+/**
+ * arv_feature_handle_new:
+ * @genicam: a #ArvGc
+ * @feature: feature name
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Resolves @feature, and creates a handle for the access to its value.
+ *
+ * Returns: (transfer full): a new #ArvFeatureHandle, %NULL on error.
+ *
+ * Since: 0.8.0
+ */
+
+ArvFeatureHandle *
+arv_feature_handle_new (ArvGc *genicam, const char *feature, GError **error)
+{
+	ArvFeatureHandle *handle;
+	ArvGcRegisterNode *register_node;
+	ArvGcNode *node;
+
+	g_return_val_if_fail (ARV_IS_GC (genicam), NULL);
+	g_return_val_if_fail (feature != NULL, NULL);
+
+	node = arv_gc_get_node (genicam, feature);
+	if (!ARV_IS_GC_FEATURE_NODE (node)) {
+		g_set_error (error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_FEATURE_NOT_FOUND,
+			     "node '%s' not found", feature);
+		return NULL;
+	}
+
+	handle = g_object_new (ARV_TYPE_FEATURE_HANDLE, NULL);
+	handle->priv->genicam = g_object_ref (genicam);
+	handle->priv->node = g_object_ref (node);
+	handle->priv->name = g_strdup (feature);
+
+	handle->priv->integer_interface = ARV_IS_GC_INTEGER (node) ? ARV_GC_INTEGER_GET_IFACE (node) : NULL;
+	handle->priv->float_interface = ARV_IS_GC_FLOAT (node) ? ARV_GC_FLOAT_GET_IFACE (node) : NULL;
+	handle->priv->string_interface = ARV_IS_GC_STRING (node) ? ARV_GC_STRING_GET_IFACE (node) : NULL;
+
+	register_node = _find_register_node (ARV_GC_FEATURE_NODE (node));
+	if (register_node != NULL)
+		handle->priv->has_register_location =
+			arv_gc_register_node_get_static_location (register_node,
+								  &handle->priv->address,
+								  &handle->priv->length);
+
+	if (handle->priv->has_register_location)
+		arv_debug_genicam ("[FeatureHandle::new] '%s' -> 0x%08" G_GINT64_MODIFIER "x (%" G_GUINT64_FORMAT ")",
+				   feature, handle->priv->address, handle->priv->length);
+
+	if (handle->priv->has_register_location &&
+	    handle->priv->integer_interface != NULL &&
+	    ARV_IS_GC_INT_REG_NODE (register_node) &&
+	    handle->priv->length > 0 && handle->priv->length <= 8) {
+		ArvGcPort *port = arv_gc_register_node_get_port (register_node);
+
+		if (port != NULL) {
+			handle->priv->port = g_object_ref (port);
+			handle->priv->cachable = arv_gc_register_node_get_cachable (register_node);
+			arv_gc_int_reg_node_get_format (ARV_GC_INT_REG_NODE (register_node),
+							&handle->priv->signedness, &handle->priv->endianess);
+		}
+	}
+
+	return handle;
+}
+
+static void
+arv_feature_handle_init (ArvFeatureHandle *handle)
+{
+	handle->priv = arv_feature_handle_get_instance_private (handle);
+}
+
+static void
+_finalize (GObject *object)
+{
+	ArvFeatureHandle *handle = ARV_FEATURE_HANDLE (object);
+
+	g_clear_object (&handle->priv->port);
+	g_clear_object (&handle->priv->node);
+	g_clear_object (&handle->priv->genicam);
+	g_clear_pointer (&handle->priv->name, g_free);
+
+	G_OBJECT_CLASS (arv_feature_handle_parent_class)->finalize (object);
+}
+
+static void
+arv_feature_handle_class_init (ArvFeatureHandleClass *this_class)
+{
+	GObjectClass *object_class = G_OBJECT_CLASS (this_class);
+
+	object_class->finalize = _finalize;
+}
@@ -0,0 +1,57 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2019 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel@gnome.org>
+ */
+
+#ifndef ARV_FEATURE_HANDLE_H
+#define ARV_FEATURE_HANDLE_H
+
+#if !defined (ARV_H_INSIDE) && !defined (ARAVIS_COMPILATION)
+#error "Only <arv.h> can be included directly."
+#endif
+
+#include <arvtypes.h>
+#include <arvgc.h>
+
+G_BEGIN_DECLS
+
+#define ARV_TYPE_FEATURE_HANDLE             (arv_feature_handle_get_type ())
+G_DECLARE_FINAL_TYPE (ArvFeatureHandle, arv_feature_handle, ARV, FEATURE_HANDLE, GObject)
+
+ArvFeatureHandle *	arv_feature_handle_new			(ArvGc *genicam, const char *feature, GError **error);
+
+const char *		arv_feature_handle_get_name		(ArvFeatureHandle *handle);
+ArvGcFeatureNode *	arv_feature_handle_get_node		(ArvFeatureHandle *handle);
+gboolean		arv_feature_handle_get_register_location	(ArvFeatureHandle *handle,
+									 guint64 *address, guint64 *length);
+
+gint64			arv_feature_handle_get_int64		(ArvFeatureHandle *handle, GError **error);
+void			arv_feature_handle_set_int64		(ArvFeatureHandle *handle, gint64 value, GError **error);
+double			arv_feature_handle_get_double		(ArvFeatureHandle *handle, GError **error);
+void			arv_feature_handle_set_double		(ArvFeatureHandle *handle, double value, GError **error);
+gboolean		arv_feature_handle_get_boolean		(ArvFeatureHandle *handle, GError **error);
+void			arv_feature_handle_set_boolean		(ArvFeatureHandle *handle, gboolean value, GError **error);
+const char *		arv_feature_handle_get_string		(ArvFeatureHandle *handle, GError **error);
+void			arv_feature_handle_set_string		(ArvFeatureHandle *handle, const char *value, GError **error);
+void			arv_feature_handle_execute		(ArvFeatureHandle *handle, GError **error);
+
+G_END_DECLS
+
+#endif
@@ -0,0 +1,209 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2019 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel@gnome.org>
+ */
+
+/**
+ * SECTION: arvframeset
+ * @short_description: Set of synchronized buffers
+ *
+ * #ArvFrameSet is the output of #ArvFrameSync. It holds one buffer per
+ * synchronized stream, in the order of the stream list given at the
+ * synchronizer creation. The buffers are the ones popped from the streams,
+ * no image data is copied. An incomplete frame set has a %NULL entry for
+ * each stream that did not deliver a matching buffer.
+ *
+ * The buffers are owned by the frame set. They are given back to their
+ * stream by arv_frame_sync_push_frame_set().
+ */
+
+#include <arvframesetprivate.h>
+#include <arvbuffer.h>
+
+typedef struct {
+	ArvBuffer **buffers;
+	guint n_buffers;
+
+	guint64 timestamp;
+} ArvFrameSetPrivate;
+
+struct _ArvFrameSet {
+	GObject	object;
+
+	ArvFrameSetPrivate *priv;
+};
+
+struct _ArvFrameSetClass {
+	GObjectClass parent_class;
+};
+
+G_DEFINE_TYPE_WITH_CODE (ArvFrameSet, arv_frame_set, G_TYPE_OBJECT, G_ADD_PRIVATE (ArvFrameSet))
+
+ArvFrameSet *
+arv_frame_set_new (guint n_buffers)
+{
+	ArvFrameSet *frame_set;
+
+	frame_set = g_object_new (ARV_TYPE_FRAME_SET, NULL);
+	frame_set->priv->buffers = g_new0 (ArvBuffer *, n_buffers);
+	frame_set->priv->n_buffers = n_buffers;
+
+	return frame_set;
+}
+
+void
+arv_frame_set_set_buffer (ArvFrameSet *frame_set, guint index, ArvBuffer *buffer)
+{
+	g_return_if_fail (ARV_IS_FRAME_SET (frame_set));
+	g_return_if_fail (index < frame_set->priv->n_buffers);
+	g_return_if_fail (frame_set->priv->buffers[index] == NULL);
+
+	frame_set->priv->buffers[index] = buffer;
+}
+
+ArvBuffer *
+arv_frame_set_steal_buffer (ArvFrameSet *frame_set, guint index)
+{
+	ArvBuffer *buffer;
+
+	g_return_val_if_fail (ARV_IS_FRAME_SET (frame_set), NULL);
+	g_return_val_if_fail (index < frame_set->priv->n_buffers, NULL);
+
+	buffer = frame_set->priv->buffers[index];
+	frame_set->priv->buffers[index] = NULL;
+
+	return buffer;
+}
+
+void
+arv_frame_set_set_timestamp (ArvFrameSet *frame_set, guint64 timestamp)
+{
+	g_return_if_fail (ARV_IS_FRAME_SET (frame_set));
+
+	frame_set->priv->timestamp = timestamp;
+}
+
+/**
+ * arv_frame_set_get_n_buffers:
+ * @frame_set: a #ArvFrameSet
+ *
+ * Returns: the number of entries of @frame_set, which is the number of synchronized streams.
+ *
+ * Since: 0.8.0
+ */
+
+guint
+arv_frame_set_get_n_buffers (ArvFrameSet *frame_set)
+{
+	g_return_val_if_fail (ARV_IS_FRAME_SET (frame_set), 0);
+
+	return frame_set->priv->n_buffers;
+}
+
+/**
+ * arv_frame_set_get_buffer:
+ * @frame_set: a #ArvFrameSet
+ * @index: stream index
+ *
+ * Returns: (transfer none) (nullable): the buffer of the @index-th stream, %NULL if the stream
+ * did not deliver a matching buffer.
+ *
+ * Since: 0.8.0
+ */
+
+ArvBuffer *
+arv_frame_set_get_buffer (ArvFrameSet *frame_set, guint index)
+{
+	g_return_val_if_fail (ARV_IS_FRAME_SET (frame_set), NULL);
+	g_return_val_if_fail (index < frame_set->priv->n_buffers, NULL);
+
+	return frame_set->priv->buffers[index];
+}
+
+/**
+ * arv_frame_set_is_complete:
+ * @frame_set: a #ArvFrameSet
+ *
+ * Returns: %TRUE if @frame_set has a buffer for each stream.
+ *
+ * Since: 0.8.0
+ */
+
+gboolean
+arv_frame_set_is_complete (ArvFrameSet *frame_set)
+{
+	guint i;
+
+	g_return_val_if_fail (ARV_IS_FRAME_SET (frame_set), FALSE);
+
+	for (i = 0; i < frame_set->priv->n_buffers; i++)
+		if (frame_set->priv->buffers[i] == NULL)
+			return FALSE;
+
+	return TRUE;
+}
+
+/**
+ * arv_frame_set_get_timestamp:
+ * @frame_set: a #ArvFrameSet
+ *
+ * Gets the reference timestamp of @frame_set, which is the earliest buffer timestamp of the set. When the
+ * clock offset estimation of the synchronizer is enabled, it is expressed in the host time base (ns since
+ * epoch), otherwise in the device time base.
+ *
+ * Returns: the frame set timestamp, in nanoseconds.
+ *
+ * Since: 0.8.0
+ */
+
+guint64
+arv_frame_set_get_timestamp (ArvFrameSet *frame_set)
+{
+	g_return_val_if_fail (ARV_IS_FRAME_SET (frame_set), 0);
+
+	return frame_set->priv->timestamp;
+}
+
+static void
+arv_frame_set_init (ArvFrameSet *frame_set)
+{
+	frame_set->priv = arv_frame_set_get_instance_private (frame_set);
+}
+
+static void
+_finalize (GObject *object)
+{
+	ArvFrameSet *frame_set = ARV_FRAME_SET (object);
+	guint i;
+
+	for (i = 0; i < frame_set->priv->n_buffers; i++)
+		g_clear_object (&frame_set->priv->buffers[i]);
+	g_clear_pointer (&frame_set->priv->buffers, g_free);
+
+	G_OBJECT_CLASS (arv_frame_set_parent_class)->finalize (object);
+}
+
+static void
+arv_frame_set_class_init (ArvFrameSetClass *this_class)
+{
+	GObjectClass *object_class = G_OBJECT_CLASS (this_class);
+
+	object_class->finalize = _finalize;
+}
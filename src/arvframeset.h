@@ -0,0 +1,44 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2019 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel@gnome.org>
+ */
+
+#ifndef ARV_FRAME_SET_H
+#define ARV_FRAME_SET_H
+
+#if !defined (ARV_H_INSIDE) && !defined (ARAVIS_COMPILATION)
+#error "Only <arv.h> can be included directly."
+#endif
+
+#include <arvtypes.h>
+
+G_BEGIN_DECLS
+
+#define ARV_TYPE_FRAME_SET             (arv_frame_set_get_type ())
+G_DECLARE_FINAL_TYPE (ArvFrameSet, arv_frame_set, ARV, FRAME_SET, GObject)
+
+guint		arv_frame_set_get_n_buffers	(ArvFrameSet *frame_set);
+ArvBuffer *	arv_frame_set_get_buffer	(ArvFrameSet *frame_set, guint index);
+gboolean	arv_frame_set_is_complete	(ArvFrameSet *frame_set);
+guint64		arv_frame_set_get_timestamp	(ArvFrameSet *frame_set);
+
+G_END_DECLS
+
+#endif
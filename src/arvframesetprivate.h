@@ -0,0 +1,37 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2019 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel@gnome.org>
+ */
+
+#ifndef ARV_FRAME_SET_PRIVATE_H
+#define ARV_FRAME_SET_PRIVATE_H
+
+#include <arvframeset.h>
+
+G_BEGIN_DECLS
+
+ArvFrameSet *	arv_frame_set_new		(guint n_buffers);
+void		arv_frame_set_set_buffer	(ArvFrameSet *frame_set, guint index, ArvBuffer *buffer);
+ArvBuffer *	arv_frame_set_steal_buffer	(ArvFrameSet *frame_set, guint index);
+void		arv_frame_set_set_timestamp	(ArvFrameSet *frame_set, guint64 timestamp);
+
+G_END_DECLS
+
+#endif
@@ -0,0 +1,854 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2019 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel@gnome.org>
+ */
+
+/**
+ * SECTION: arvframesync
+ * @short_description: Multi-stream frame synchronizer
+ *
+ * #ArvFrameSync groups the buffers of several streams into #ArvFrameSet
+ * objects, by matching their timestamps, or their frame ids when the
+ * cameras are triggered together, for example by an action command.
+ *
+ * Once created, the synchronizer takes over the output of the streams: it
+ * enables their signal emission and pops each completed buffer from its
+ * stream thread. Buffers are kept in a bounded per-stream queue until a
+ * match is found in all the other streams. A buffer that can not be
+ * matched anymore, because the other streams already delivered later
+ * buffers, or because waiting for a missing stream would exceed the queue
+ * bounds, is either given back to its stream or output in an incomplete
+ * frame set, depending on the drop policy. Failed buffers are always given
+ * back to their stream.
+ *
+ * In timestamp mode, the cameras clocks are not assumed to be synchronized.
+ * The offset between each device clock and the host clock is estimated from
+ * the buffer timestamps and the buffer reception times, and the timestamps
+ * are compared in the host time base. A buffer timestamp is converted once,
+ * on reception, with the offset known at that time. The estimation should be
+ * disabled when the device clocks are already synchronized, using PTP for
+ * example.
+ *
+ * In frame id mode, the frame ids are compared modulo 2^16, the size of the
+ * GigE Vision frame id, which allows the matching across a wrap around.
+ *
+ * <informalexample>
+ * <programlisting>
+ * ArvFrameSync *sync;
+ * ArvFrameSet *frame_set;
+ *
+ * sync = arv_frame_sync_new (streams, 2, ARV_FRAME_SYNC_MODE_TIMESTAMP);
+ * arv_frame_sync_set_tolerance (sync, 500000);
+ *
+ * frame_set = arv_frame_sync_timeout_pop_frame_set (sync, 1000000);
+ * if (frame_set != NULL) {
+ *         process (arv_frame_set_get_buffer (frame_set, 0), arv_frame_set_get_buffer (frame_set, 1));
+ *         arv_frame_sync_push_frame_set (sync, frame_set);
+ * }
+ * </programlisting>
+ * </informalexample>
+ */
+
+#include <arvframesync.h>
+#include <arvframesetprivate.h>
+#include <arvstream.h>
+#include <arvbuffer.h>
+#include <arvdebug.h>
+
+/* Default tolerance in timestamp mode, in ns */
+#define ARV_FRAME_SYNC_DEFAULT_TIMESTAMP_TOLERANCE	1000000
+#define ARV_FRAME_SYNC_DEFAULT_MAX_QUEUE_LENGTH		4
+/* Number of buffers used for the clock offset estimation */
+#define ARV_FRAME_SYNC_CLOCK_OFFSET_WINDOW		64
+
+enum {
+	ARV_FRAME_SYNC_SIGNAL_NEW_FRAME_SET,
+	ARV_FRAME_SYNC_SIGNAL_LAST
+} ArvFrameSyncSignals;
+
+static guint arv_frame_sync_signals[ARV_FRAME_SYNC_SIGNAL_LAST] = {0};
+
+/* Buffer waiting for a match, with its matching key and host timestamp computed on reception */
+
+typedef struct {
+	ArvBuffer *buffer;
+	gint64 key;
+	gint64 timestamp;
+} ArvFrameSyncPendingBuffer;
+
+typedef struct {
+	ArvFrameSync *sync;
+	ArvStream *stream;
+	gulong new_buffer_handler;
+
+	/* ArvFrameSyncPendingBuffer list, in reception order */
+	GQueue pending_buffers;
+
+	gint64 clock_offset_samples[ARV_FRAME_SYNC_CLOCK_OFFSET_WINDOW];
+	guint n_clock_offset_samples;
+	guint clock_offset_sample_index;
+	gint64 clock_offset;
+} ArvFrameSyncMember;
+
+typedef struct {
+	ArvFrameSyncMember *members;
+	guint n_members;
+
+	ArvFrameSyncMode mode;
+	ArvFrameSyncDropPolicy drop_policy;
+	guint64 tolerance;
+	guint max_queue_length;
+	gboolean clock_offset_estimation;
+
+	GMutex mutex;
+	GCond frame_set_cond;
+	GQueue frame_sets;
+
+	guint64 n_complete_frame_sets;
+	guint64 n_incomplete_frame_sets;
+	guint64 n_dropped_buffers;
+} ArvFrameSyncPrivate;
+
+struct _ArvFrameSync {
+	GObject	object;
+
+	ArvFrameSyncPrivate *priv;
+};
+
+struct _ArvFrameSyncClass {
+	GObjectClass parent_class;
+};
+
+G_DEFINE_TYPE_WITH_CODE (ArvFrameSync, arv_frame_sync, G_TYPE_OBJECT, G_ADD_PRIVATE (ArvFrameSync))
+
+/* All the functions below are called with the synchronizer mutex locked */
+
+static void
+_update_clock_offset (ArvFrameSyncMember *member, ArvBuffer *buffer)
+{
+	gint64 clock_offset;
+	guint i;
+
+	member->clock_offset_samples[member->clock_offset_sample_index] =
+		(gint64) arv_buffer_get_timestamp (buffer) - (gint64) arv_buffer_get_system_timestamp (buffer);
+	member->clock_offset_sample_index = (member->clock_offset_sample_index + 1) % ARV_FRAME_SYNC_CLOCK_OFFSET_WINDOW;
+	if (member->n_clock_offset_samples < ARV_FRAME_SYNC_CLOCK_OFFSET_WINDOW)
+		member->n_clock_offset_samples++;
+
+	/* The transfer delay always adds to the difference, the largest one is the closest to the actual offset */
+	clock_offset = member->clock_offset_samples[0];
+	for (i = 1; i < member->n_clock_offset_samples; i++)
+		clock_offset = MAX (clock_offset, member->clock_offset_samples[i]);
+
+	member->clock_offset = clock_offset;
+}
+
+static void
+_push_pending_buffer (ArvFrameSync *sync, ArvFrameSyncMember *member, ArvBuffer *buffer)
+{
+	ArvFrameSyncPendingBuffer *pending_buffer;
+
+	pending_buffer = g_new (ArvFrameSyncPendingBuffer, 1);
+	pending_buffer->buffer = buffer;
+
+	/* Frozen, as the clock offset estimation changes with the next buffers */
+	if (sync->priv->clock_offset_estimation)
+		pending_buffer->timestamp = (gint64) arv_buffer_get_timestamp (buffer) - member->clock_offset;
+	else
+		pending_buffer->timestamp = arv_buffer_get_timestamp (buffer);
+
+	if (sync->priv->mode == ARV_FRAME_SYNC_MODE_FRAME_ID)
+		pending_buffer->key = arv_buffer_get_frame_id (buffer);
+	else
+		pending_buffer->key = pending_buffer->timestamp;
+
+	g_queue_push_tail (&member->pending_buffers, pending_buffer);
+}
+
+static ArvBuffer *
+_pop_pending_buffer (ArvFrameSyncMember *member)
+{
+	ArvFrameSyncPendingBuffer *pending_buffer;
+	ArvBuffer *buffer;
+
+	pending_buffer = g_queue_pop_head (&member->pending_buffers);
+	if (pending_buffer == NULL)
+		return NULL;
+
+	buffer = pending_buffer->buffer;
+	g_free (pending_buffer);
+
+	return buffer;
+}
+
+/* Frame ids are compared modulo 2^16, for the support of the GigE Vision frame id wrap around */
+
+static gint64
+_get_key_difference (ArvFrameSync *sync, gint64 key_a, gint64 key_b)
+{
+	if (sync->priv->mode == ARV_FRAME_SYNC_MODE_FRAME_ID)
+		return (gint16) (guint16) (key_a - key_b);
+
+	return key_a - key_b;
+}
+
+static guint
+_get_n_present_buffers (ArvFrameSync *sync, ArvFrameSet *frame_set)
+{
+	guint n_buffers = 0;
+	guint i;
+
+	for (i = 0; i < sync->priv->n_members; i++)
+		if (arv_frame_set_get_buffer (frame_set, i) != NULL)
+			n_buffers++;
+
+	return n_buffers;
+}
+
+static void
+_release_frame_set (ArvFrameSync *sync, ArvFrameSet *frame_set)
+{
+	guint i;
+
+	for (i = 0; i < sync->priv->n_members; i++) {
+		ArvBuffer *buffer;
+
+		buffer = arv_frame_set_steal_buffer (frame_set, i);
+		if (buffer != NULL)
+			arv_stream_push_buffer (sync->priv->members[i].stream, buffer);
+	}
+
+	g_object_unref (frame_set);
+}
+
+/* Takes the head buffers matching the oldest one */
+
+static ArvFrameSet *
+_pop_frame_set (ArvFrameSync *sync, gint64 reference_key)
+{
+	ArvFrameSet *frame_set;
+	gboolean is_timestamp_set = FALSE;
+	gint64 timestamp = 0;
+	guint i;
+
+	frame_set = arv_frame_set_new (sync->priv->n_members);
+
+	for (i = 0; i < sync->priv->n_members; i++) {
+		ArvFrameSyncMember *member = &sync->priv->members[i];
+		ArvFrameSyncPendingBuffer *pending_buffer;
+
+		pending_buffer = g_queue_peek_head (&member->pending_buffers);
+		if (pending_buffer != NULL &&
+		    _get_key_difference (sync, pending_buffer->key, reference_key) <= (gint64) sync->priv->tolerance) {
+			if (!is_timestamp_set || pending_buffer->timestamp < timestamp) {
+				timestamp = pending_buffer->timestamp;
+				is_timestamp_set = TRUE;
+			}
+
+			arv_frame_set_set_buffer (frame_set, i, _pop_pending_buffer (member));
+		}
+	}
+
+	arv_frame_set_set_timestamp (frame_set, timestamp);
+
+	return frame_set;
+}
+
+static void
+_queue_frame_set (ArvFrameSync *sync, ArvFrameSet *frame_set)
+{
+	if (arv_frame_set_is_complete (frame_set))
+		sync->priv->n_complete_frame_sets++;
+	else
+		sync->priv->n_incomplete_frame_sets++;
+
+	/* The application does not keep up, the oldest frame sets are the least useful */
+	while (g_queue_get_length (&sync->priv->frame_sets) >= sync->priv->max_queue_length) {
+		ArvFrameSet *oldest = g_queue_pop_head (&sync->priv->frame_sets);
+
+		sync->priv->n_dropped_buffers += _get_n_present_buffers (sync, oldest);
+		_release_frame_set (sync, oldest);
+	}
+
+	g_queue_push_tail (&sync->priv->frame_sets, frame_set);
+	g_cond_signal (&sync->priv->frame_set_cond);
+}
+
+static guint
+_process_pending_buffers (ArvFrameSync *sync)
+{
+	guint n_frame_sets = 0;
+
+	for (;;) {
+		gboolean has_all_heads = TRUE;
+		gboolean has_heads = FALSE;
+		gboolean is_overflowing = FALSE;
+		gint64 min_key = 0;
+		gint64 max_key = 0;
+		guint i;
+
+		for (i = 0; i < sync->priv->n_members; i++) {
+			ArvFrameSyncMember *member = &sync->priv->members[i];
+			ArvFrameSyncPendingBuffer *pending_buffer;
+
+			if (g_queue_get_length (&member->pending_buffers) > sync->priv->max_queue_length)
+				is_overflowing = TRUE;
+
+			pending_buffer = g_queue_peek_head (&member->pending_buffers);
+			if (pending_buffer == NULL) {
+				has_all_heads = FALSE;
+				continue;
+			}
+
+			if (!has_heads || _get_key_difference (sync, pending_buffer->key, min_key) < 0)
+				min_key = pending_buffer->key;
+			if (!has_heads || _get_key_difference (sync, pending_buffer->key, max_key) > 0)
+				max_key = pending_buffer->key;
+			has_heads = TRUE;
+		}
+
+		/* Buffers are delivered in order, a missing stream may still deliver a match */
+		if (!has_heads || (!has_all_heads && !is_overflowing))
+			break;
+
+		if (has_all_heads && _get_key_difference (sync, max_key, min_key) <= (gint64) sync->priv->tolerance) {
+			_queue_frame_set (sync, _pop_frame_set (sync, min_key));
+			n_frame_sets++;
+			continue;
+		}
+
+		/* The oldest buffers can not be matched anymore */
+		if (sync->priv->drop_policy == ARV_FRAME_SYNC_DROP_POLICY_EMIT_INCOMPLETE) {
+			_queue_frame_set (sync, _pop_frame_set (sync, min_key));
+			n_frame_sets++;
+		} else {
+			ArvFrameSet *frame_set;
+			guint n_buffers;
+
+			frame_set = _pop_frame_set (sync, min_key);
+			n_buffers = _get_n_present_buffers (sync, frame_set);
+			sync->priv->n_dropped_buffers += n_buffers;
+
+			arv_debug_stream ("[ArvFrameSync::process_pending_buffers] Drop %u unmatched buffer(s)", n_buffers);
+
+			_release_frame_set (sync, frame_set);
+		}
+	}
+
+	return n_frame_sets;
+}
+
+static void
+_new_buffer_cb (ArvStream *stream, ArvFrameSyncMember *member)
+{
+	ArvFrameSync *sync = member->sync;
+	ArvBuffer *buffer;
+	guint n_frame_sets = 0;
+	guint i;
+
+	buffer = arv_stream_try_pop_buffer (stream);
+	if (buffer == NULL)
+		return;
+
+	g_mutex_lock (&sync->priv->mutex);
+
+	if (arv_buffer_get_status (buffer) == ARV_BUFFER_STATUS_SUCCESS) {
+		_update_clock_offset (member, buffer);
+		_push_pending_buffer (sync, member, buffer);
+		n_frame_sets = _process_pending_buffers (sync);
+	} else {
+		arv_stream_push_buffer (stream, buffer);
+		sync->priv->n_dropped_buffers++;
+	}
+
+	g_mutex_unlock (&sync->priv->mutex);
+
+	for (i = 0; i < n_frame_sets; i++)
+		g_signal_emit (sync, arv_frame_sync_signals[ARV_FRAME_SYNC_SIGNAL_NEW_FRAME_SET], 0);
+}
+
+/**
+ * arv_frame_sync_new:
+ * @streams: (array length=n_streams): a list of #ArvStream
+ * @n_streams: number of streams
+ * @mode: buffer matching criterion
+ *
+ * Creates a synchronizer for @streams. Signal emission is enabled on each stream, and the synchronizer
+ * pops all the completed buffers. The default tolerance is 1 ms in timestamp mode, and 0 in frame id mode.
+ *
+ * Returns: a new #ArvFrameSync.
+ *
+ * Since: 0.8.0
+ */
+
+ArvFrameSync *
+arv_frame_sync_new (ArvStream **streams, guint n_streams, ArvFrameSyncMode mode)
+{
+	ArvFrameSync *sync;
+	guint i;
+
+	g_return_val_if_fail (streams != NULL, NULL);
+	g_return_val_if_fail (n_streams > 0, NULL);
+
+	for (i = 0; i < n_streams; i++)
+		g_return_val_if_fail (ARV_IS_STREAM (streams[i]), NULL);
+
+	sync = g_object_new (ARV_TYPE_FRAME_SYNC, NULL);
+	sync->priv->mode = mode;
+	sync->priv->tolerance = mode == ARV_FRAME_SYNC_MODE_TIMESTAMP ? ARV_FRAME_SYNC_DEFAULT_TIMESTAMP_TOLERANCE : 0;
+	sync->priv->members = g_new0 (ArvFrameSyncMember, n_streams);
+	sync->priv->n_members = n_streams;
+
+	for (i = 0; i < n_streams; i++) {
+		ArvFrameSyncMember *member = &sync->priv->members[i];
+
+		member->sync = sync;
+		member->stream = g_object_ref (streams[i]);
+		g_queue_init (&member->pending_buffers);
+	}
+
+	for (i = 0; i < n_streams; i++) {
+		ArvFrameSyncMember *member = &sync->priv->members[i];
+
+		member->new_buffer_handler = g_signal_connect (member->stream, "new-buffer",
+							       G_CALLBACK (_new_buffer_cb), member);
+		arv_stream_set_emit_signals (member->stream, TRUE);
+	}
+
+	return sync;
+}
+
+/**
+ * arv_frame_sync_set_tolerance:
+ * @sync: a #ArvFrameSync
+ * @tolerance: maximum key difference between the buffers of a frame set
+ *
+ * Sets the maximum difference between the buffers of a frame set, in ns in timestamp mode, and in
+ * frame count in frame id mode.
+ *
+ * Since: 0.8.0
+ */
+
+void
+arv_frame_sync_set_tolerance (ArvFrameSync *sync, guint64 tolerance)
+{
+	g_return_if_fail (ARV_IS_FRAME_SYNC (sync));
+	g_return_if_fail (tolerance <= G_MAXINT64);
+
+	g_mutex_lock (&sync->priv->mutex);
+	sync->priv->tolerance = tolerance;
+	g_mutex_unlock (&sync->priv->mutex);
+}
+
+/**
+ * arv_frame_sync_get_tolerance:
+ * @sync: a #ArvFrameSync
+ *
+ * Returns: the matching tolerance, in ns in timestamp mode, in frame count in frame id mode.
+ *
+ * Since: 0.8.0
+ */
+
+guint64
+arv_frame_sync_get_tolerance (ArvFrameSync *sync)
+{
+	guint64 tolerance;
+
+	g_return_val_if_fail (ARV_IS_FRAME_SYNC (sync), 0);
+
+	g_mutex_lock (&sync->priv->mutex);
+	tolerance = sync->priv->tolerance;
+	g_mutex_unlock (&sync->priv->mutex);
+
+	return tolerance;
+}
+
+/**
+ * arv_frame_sync_set_drop_policy:
+ * @sync: a #ArvFrameSync
+ * @policy: a #ArvFrameSyncDropPolicy
+ *
+ * Sets what to do with the buffers that can not be matched in all the streams. Default is
+ * %ARV_FRAME_SYNC_DROP_POLICY_DROP_INCOMPLETE.
+ *
+ * Since: 0.8.0
+ */
+
+void
+arv_frame_sync_set_drop_policy (ArvFrameSync *sync, ArvFrameSyncDropPolicy policy)
+{
+	g_return_if_fail (ARV_IS_FRAME_SYNC (sync));
+
+	g_mutex_lock (&sync->priv->mutex);
+	sync->priv->drop_policy = policy;
+	g_mutex_unlock (&sync->priv->mutex);
+}
+
+/**
+ * arv_frame_sync_get_drop_policy:
+ * @sync: a #ArvFrameSync
+ *
+ * Returns: the current drop policy.
+ *
+ * Since: 0.8.0
+ */
+
+ArvFrameSyncDropPolicy
+arv_frame_sync_get_drop_policy (ArvFrameSync *sync)
+{
+	ArvFrameSyncDropPolicy policy;
+
+	g_return_val_if_fail (ARV_IS_FRAME_SYNC (sync), ARV_FRAME_SYNC_DROP_POLICY_DROP_INCOMPLETE);
+
+	g_mutex_lock (&sync->priv->mutex);
+	policy = sync->priv->drop_policy;
+	g_mutex_unlock (&sync->priv->mutex);
+
+	return policy;
+}
+
+/**
+ * arv_frame_sync_set_max_queue_length:
+ * @sync: a #ArvFrameSync
+ * @max_queue_length: maximum number of queued items
+ *
+ * Sets both the maximum number of buffers waiting for a match in each stream, and the maximum number of
+ * frame sets waiting to be popped. When the output queue is full, the oldest frame set is given back to
+ * the streams. Default is 4.
+ *
+ * Since: 0.8.0
+ */
+
+void
+arv_frame_sync_set_max_queue_length (ArvFrameSync *sync, guint max_queue_length)
+{
+	g_return_if_fail (ARV_IS_FRAME_SYNC (sync));
+	g_return_if_fail (max_queue_length > 0);
+
+	g_mutex_lock (&sync->priv->mutex);
+	sync->priv->max_queue_length = max_queue_length;
+	g_mutex_unlock (&sync->priv->mutex);
+}
+
+/**
+ * arv_frame_sync_get_max_queue_length:
+ * @sync: a #ArvFrameSync
+ *
+ * Returns: the maximum number of queued items.
+ *
+ * Since: 0.8.0
+ */
+
+guint
+arv_frame_sync_get_max_queue_length (ArvFrameSync *sync)
+{
+	guint max_queue_length;
+
+	g_return_val_if_fail (ARV_IS_FRAME_SYNC (sync), 0);
+
+	g_mutex_lock (&sync->priv->mutex);
+	max_queue_length = sync->priv->max_queue_length;
+	g_mutex_unlock (&sync->priv->mutex);
+
+	return max_queue_length;
+}
+
+/**
+ * arv_frame_sync_set_clock_offset_estimation:
+ * @sync: a #ArvFrameSync
+ * @enable: enable state
+ *
+ * Enables the conversion of the buffer timestamps to the host time base, using the estimated clock offset
+ * of each device. It should be disabled if the device clocks are already synchronized. Enabled by default.
+ * Only the buffers received after the call are affected.
+ *
+ * Since: 0.8.0
+ */
+
+void
+arv_frame_sync_set_clock_offset_estimation (ArvFrameSync *sync, gboolean enable)
+{
+	g_return_if_fail (ARV_IS_FRAME_SYNC (sync));
+
+	g_mutex_lock (&sync->priv->mutex);
+	sync->priv->clock_offset_estimation = enable;
+	g_mutex_unlock (&sync->priv->mutex);
+}
+
+/**
+ * arv_frame_sync_get_clock_offset_estimation:
+ * @sync: a #ArvFrameSync
+ *
+ * Returns: %TRUE if the timestamps are converted to the host time base.
+ *
+ * Since: 0.8.0
+ */
+
+gboolean
+arv_frame_sync_get_clock_offset_estimation (ArvFrameSync *sync)
+{
+	gboolean enable;
+
+	g_return_val_if_fail (ARV_IS_FRAME_SYNC (sync), FALSE);
+
+	g_mutex_lock (&sync->priv->mutex);
+	enable = sync->priv->clock_offset_estimation;
+	g_mutex_unlock (&sync->priv->mutex);
+
+	return enable;
+}
+
+/**
+ * arv_frame_sync_get_clock_offset:
+ * @sync: a #ArvFrameSync
+ * @index: stream index
+ *
+ * Gets the estimated offset between the device clock of the @index-th stream and the host clock, based on
+ * the timestamps of the last 64 received buffers. The estimation is updated even if the timestamp
+ * conversion is disabled.
+ *
+ * Returns: the device time minus the host time, in ns.
+ *
+ * Since: 0.8.0
+ */
+
+gint64
+arv_frame_sync_get_clock_offset (ArvFrameSync *sync, guint index)
+{
+	gint64 clock_offset;
+
+	g_return_val_if_fail (ARV_IS_FRAME_SYNC (sync), 0);
+	g_return_val_if_fail (index < sync->priv->n_members, 0);
+
+	g_mutex_lock (&sync->priv->mutex);
+	clock_offset = sync->priv->members[index].clock_offset;
+	g_mutex_unlock (&sync->priv->mutex);
+
+	return clock_offset;
+}
+
+/**
+ * arv_frame_sync_pop_frame_set:
+ * @sync: a #ArvFrameSync
+ *
+ * Pops the oldest frame set, blocking until one is available.
+ *
+ * Returns: (transfer full): a #ArvFrameSet.
+ *
+ * Since: 0.8.0
+ */
+
+ArvFrameSet *
+arv_frame_sync_pop_frame_set (ArvFrameSync *sync)
+{
+	ArvFrameSet *frame_set;
+
+	g_return_val_if_fail (ARV_IS_FRAME_SYNC (sync), NULL);
+
+	g_mutex_lock (&sync->priv->mutex);
+
+	while (g_queue_is_empty (&sync->priv->frame_sets))
+		g_cond_wait (&sync->priv->frame_set_cond, &sync->priv->mutex);
+	frame_set = g_queue_pop_head (&sync->priv->frame_sets);
+
+	g_mutex_unlock (&sync->priv->mutex);
+
+	return frame_set;
+}
+
+/**
+ * arv_frame_sync_try_pop_frame_set:
+ * @sync: a #ArvFrameSync
+ *
+ * Pops the oldest frame set, without blocking.
+ *
+ * Returns: (transfer full) (nullable): a #ArvFrameSet, %NULL if none is available.
+ *
+ * Since: 0.8.0
+ */
+
+ArvFrameSet *
+arv_frame_sync_try_pop_frame_set (ArvFrameSync *sync)
+{
+	ArvFrameSet *frame_set;
+
+	g_return_val_if_fail (ARV_IS_FRAME_SYNC (sync), NULL);
+
+	g_mutex_lock (&sync->priv->mutex);
+	frame_set = g_queue_pop_head (&sync->priv->frame_sets);
+	g_mutex_unlock (&sync->priv->mutex);
+
+	return frame_set;
+}
+
+/**
+ * arv_frame_sync_timeout_pop_frame_set:
+ * @sync: a #ArvFrameSync
+ * @timeout: timeout, in µs
+ *
+ * Pops the oldest frame set, waiting at most @timeout for one to be available.
+ *
+ * Returns: (transfer full) (nullable): a #ArvFrameSet, %NULL on timeout.
+ *
+ * Since: 0.8.0
+ */
+
+ArvFrameSet *
+arv_frame_sync_timeout_pop_frame_set (ArvFrameSync *sync, guint64 timeout)
+{
+	ArvFrameSet *frame_set;
+	gint64 end_time;
+
+	g_return_val_if_fail (ARV_IS_FRAME_SYNC (sync), NULL);
+
+	end_time = g_get_monotonic_time () + timeout;
+
+	g_mutex_lock (&sync->priv->mutex);
+
+	while (g_queue_is_empty (&sync->priv->frame_sets))
+		if (!g_cond_wait_until (&sync->priv->frame_set_cond, &sync->priv->mutex, end_time))
+			break;
+	frame_set = g_queue_pop_head (&sync->priv->frame_sets);
+
+	g_mutex_unlock (&sync->priv->mutex);
+
+	return frame_set;
+}
+
+/**
+ * arv_frame_sync_push_frame_set:
+ * @sync: a #ArvFrameSync
+ * @frame_set: (transfer full): a #ArvFrameSet popped from @sync
+ *
+ * Gives the buffers of @frame_set back to their stream, for reuse.
+ *
+ * Since: 0.8.0
+ */
+
+void
+arv_frame_sync_push_frame_set (ArvFrameSync *sync, ArvFrameSet *frame_set)
+{
+	g_return_if_fail (ARV_IS_FRAME_SYNC (sync));
+	g_return_if_fail (ARV_IS_FRAME_SET (frame_set));
+	g_return_if_fail (arv_frame_set_get_n_buffers (frame_set) == sync->priv->n_members);
+
+	_release_frame_set (sync, frame_set);
+}
+
+/**
+ * arv_frame_sync_get_statistics:
+ * @sync: a #ArvFrameSync
+ * @n_complete_frame_sets: (out) (optional): number of complete frame sets
+ * @n_incomplete_frame_sets: (out) (optional): number of incomplete frame sets
+ * @n_dropped_buffers: (out) (optional): number of buffers given back to their stream without being output,
+ * including the failed ones and the ones of the frame sets dropped because of a full output queue
+ *
+ * Since: 0.8.0
+ */
+
+void
+arv_frame_sync_get_statistics (ArvFrameSync *sync,
+			       guint64 *n_complete_frame_sets,
+			       guint64 *n_incomplete_frame_sets,
+			       guint64 *n_dropped_buffers)
+{
+	g_return_if_fail (ARV_IS_FRAME_SYNC (sync));
+
+	g_mutex_lock (&sync->priv->mutex);
+
+	if (n_complete_frame_sets != NULL)
+		*n_complete_frame_sets = sync->priv->n_complete_frame_sets;
+	if (n_incomplete_frame_sets != NULL)
+		*n_incomplete_frame_sets = sync->priv->n_incomplete_frame_sets;
+	if (n_dropped_buffers != NULL)
+		*n_dropped_buffers = sync->priv->n_dropped_buffers;
+
+	g_mutex_unlock (&sync->priv->mutex);
+}
+
+static void
+arv_frame_sync_init (ArvFrameSync *sync)
+{
+	sync->priv = arv_frame_sync_get_instance_private (sync);
+
+	sync->priv->drop_policy = ARV_FRAME_SYNC_DROP_POLICY_DROP_INCOMPLETE;
+	sync->priv->max_queue_length = ARV_FRAME_SYNC_DEFAULT_MAX_QUEUE_LENGTH;
+	sync->priv->clock_offset_estimation = TRUE;
+
+	g_mutex_init (&sync->priv->mutex);
+	g_cond_init (&sync->priv->frame_set_cond);
+	g_queue_init (&sync->priv->frame_sets);
+}
+
+static void
+_finalize (GObject *object)
+{
+	ArvFrameSync *sync = ARV_FRAME_SYNC (object);
+	ArvFrameSet *frame_set;
+	guint i;
+
+	/* Waits for a running callback to return */
+	for (i = 0; i < sync->priv->n_members; i++) {
+		arv_stream_set_emit_signals (sync->priv->members[i].stream, FALSE);
+		g_signal_handler_disconnect (sync->priv->members[i].stream, sync->priv->members[i].new_buffer_handler);
+	}
+
+	while ((frame_set = g_queue_pop_head (&sync->priv->frame_sets)) != NULL)
+		_release_frame_set (sync, frame_set);
+
+	for (i = 0; i < sync->priv->n_members; i++) {
+		ArvFrameSyncMember *member = &sync->priv->members[i];
+		ArvBuffer *buffer;
+
+		while ((buffer = _pop_pending_buffer (member)) != NULL)
+			arv_stream_push_buffer (member->stream, buffer);
+		g_clear_object (&member->stream);
+	}
+	g_clear_pointer (&sync->priv->members, g_free);
+
+	g_mutex_clear (&sync->priv->mutex);
+	g_cond_clear (&sync->priv->frame_set_cond);
+
+	G_OBJECT_CLASS (arv_frame_sync_parent_class)->finalize (object);
+}
+
+static void
+arv_frame_sync_class_init (ArvFrameSyncClass *this_class)
+{
+	GObjectClass *object_class = G_OBJECT_CLASS (this_class);
+
+	object_class->finalize = _finalize;
+
+	/**
+	 * ArvFrameSync::new-frame-set:
+	 * @sync: the synchronizer that emitted the signal
+	 *
+	 * Signal that a new frame set is available. It is emitted from a stream thread.
+	 *
+	 * Since: 0.8.0
+	 */
+
+	arv_frame_sync_signals[ARV_FRAME_SYNC_SIGNAL_NEW_FRAME_SET] =
+		g_signal_new ("new-frame-set",
+			      G_TYPE_FROM_CLASS (this_class),
+			      G_SIGNAL_RUN_LAST, 0,
+			      NULL, NULL,
+			      g_cclosure_marshal_VOID__VOID, G_TYPE_NONE, 0, G_TYPE_NONE);
+}
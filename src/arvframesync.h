@@ -0,0 +1,88 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2019 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel@gnome.org>
+ */
+
+#ifndef ARV_FRAME_SYNC_H
+#define ARV_FRAME_SYNC_H
+
+#if !defined (ARV_H_INSIDE) && !defined (ARAVIS_COMPILATION)
+#error "Only <arv.h> can be included directly."
+#endif
+
+#include <arvtypes.h>
+
+G_BEGIN_DECLS
+
+/**
+ * ArvFrameSyncMode:
+ * @ARV_FRAME_SYNC_MODE_TIMESTAMP: buffers are matched by timestamp
+ * @ARV_FRAME_SYNC_MODE_FRAME_ID: buffers are matched by frame id
+ *
+ * Buffer matching criterion.
+ */
+
+typedef enum {
+	ARV_FRAME_SYNC_MODE_TIMESTAMP,
+	ARV_FRAME_SYNC_MODE_FRAME_ID
+} ArvFrameSyncMode;
+
+/**
+ * ArvFrameSyncDropPolicy:
+ * @ARV_FRAME_SYNC_DROP_POLICY_DROP_INCOMPLETE: unmatched buffers are given back to their stream
+ * @ARV_FRAME_SYNC_DROP_POLICY_EMIT_INCOMPLETE: unmatched buffers are output in incomplete frame sets
+ *
+ * What to do with a buffer that has no counterpart in one or more of the other streams.
+ */
+
+typedef enum {
+	ARV_FRAME_SYNC_DROP_POLICY_DROP_INCOMPLETE,
+	ARV_FRAME_SYNC_DROP_POLICY_EMIT_INCOMPLETE
+} ArvFrameSyncDropPolicy;
+
+#define ARV_TYPE_FRAME_SYNC             (arv_frame_sync_get_type ())
+G_DECLARE_FINAL_TYPE (ArvFrameSync, arv_frame_sync, ARV, FRAME_SYNC, GObject)
+
+ArvFrameSync *		arv_frame_sync_new				(ArvStream **streams, guint n_streams,
+									 ArvFrameSyncMode mode);
+
+void			arv_frame_sync_set_tolerance			(ArvFrameSync *sync, guint64 tolerance);
+guint64			arv_frame_sync_get_tolerance			(ArvFrameSync *sync);
+void			arv_frame_sync_set_drop_policy			(ArvFrameSync *sync, ArvFrameSyncDropPolicy policy);
+ArvFrameSyncDropPolicy	arv_frame_sync_get_drop_policy			(ArvFrameSync *sync);
+void			arv_frame_sync_set_max_queue_length		(ArvFrameSync *sync, guint max_queue_length);
+guint			arv_frame_sync_get_max_queue_length		(ArvFrameSync *sync);
+void			arv_frame_sync_set_clock_offset_estimation	(ArvFrameSync *sync, gboolean enable);
+gboolean		arv_frame_sync_get_clock_offset_estimation	(ArvFrameSync *sync);
+gint64			arv_frame_sync_get_clock_offset			(ArvFrameSync *sync, guint index);
+
+ArvFrameSet *		arv_frame_sync_pop_frame_set			(ArvFrameSync *sync);
+ArvFrameSet *		arv_frame_sync_try_pop_frame_set		(ArvFrameSync *sync);
+ArvFrameSet *		arv_frame_sync_timeout_pop_frame_set		(ArvFrameSync *sync, guint64 timeout);
+void			arv_frame_sync_push_frame_set			(ArvFrameSync *sync, ArvFrameSet *frame_set);
+
+void			arv_frame_sync_get_statistics			(ArvFrameSync *sync,
+									 guint64 *n_complete_frame_sets,
+									 guint64 *n_incomplete_frame_sets,
+									 guint64 *n_dropped_buffers);
+
+G_END_DECLS
+
+#endif
@@ -27,9 +27,16 @@
  * #ArvGc implements the root document for the storage of the Genicam feature
  * nodes. It builds the node tree by parsing an xml file in the Genicam
  * standard format. See http://www.genicam.org.
+ *
+ * Feature nodes can be accessed concurrently from several threads. The node
+ * table is protected by a read-write lock, and each register, SwissKnife and
+ * Converter node serializes the access to its cached value. The buffer used
+ * for chunk data access is bound to the calling thread, see
+ * arv_gc_set_buffer(). The data of the last received event of each event
+ * identifier is shared by all threads, see arv_gc_set_event_data().
  */
 
-#include <arvgc.h>
+#include <arvgcprivate.h>
 #include <arvgcnode.h>
 #include <arvgcpropertynode.h>
 #include <arvgcindexnode.h>
@@ -57,7 +64,8 @@
 #include <arvgcintswissknifenode.h>
 #include <arvgcconverternode.h>
 #include <arvgcintconverternode.h>
-#include <arvgcport.h>
+#include <arvgcportprivate.h>
+#include <arvgcfeaturenodeprivate.h>
 #include <arvbuffer.h>
 #include <arvdebug.h>
 #include <arvdomparser.h>
@@ -66,11 +74,28 @@
 #include <stdio.h>
 
 typedef struct {
+	GRWLock nodes_lock;			/* Protects nodes and the dependency graph */
 	GHashTable *nodes;
 	ArvDevice *device;
-	ArvBuffer *buffer;
 
-	ArvRegisterCachePolicy cache_policy;
+	GMutex buffers_mutex;
+	GHashTable *buffers;			/* ArvGcThreadToken -> ArvBuffer */
+
+	GMutex events_mutex;
+	GHashTable *events;			/* Event id -> GBytes */
+	GHashTable *event_ports;		/* Event id -> GPtrArray of ArvGcPort, built on first event */
+
+	gint cache_policy;
+	gsize n_cache_hits;
+	gsize n_cache_misses;
+	gsize n_uncached_reads;
+	gsize n_memo_hits;
+
+	GHashTable *direct_dependents;		/* ArvGcFeatureNode -> GPtrArray of ArvGcFeatureNode */
+	GHashTable *dependents;			/* ArvGcFeatureNode -> GPtrArray of ArvGcFeatureNode */
+	gboolean is_dependency_graph_valid;
+
+	gint nodes_generation;
 } ArvGcPrivate;
 
 struct _ArvGc {
@@ -273,10 +298,16 @@ arv_gc_create_element (ArvDomDocument *document, const char *tag_name)
 ArvGcNode *
 arv_gc_get_node	(ArvGc *genicam, const char *name)
 {
+	ArvGcNode *node;
+
 	g_return_val_if_fail (ARV_IS_GC (genicam), NULL);
 	g_return_val_if_fail (name != NULL, NULL);
 
-	return g_hash_table_lookup (genicam->priv->nodes, name);
+	g_rw_lock_reader_lock (&genicam->priv->nodes_lock);
+	node = g_hash_table_lookup (genicam->priv->nodes, name);
+	g_rw_lock_reader_unlock (&genicam->priv->nodes_lock);
+
+	return node;
 }
 
 /**
@@ -311,13 +342,314 @@ arv_gc_register_feature_node (ArvGc *genicam, ArvGcFeatureNode *node)
 
 	g_object_ref (node);
 
+	g_rw_lock_writer_lock (&genicam->priv->nodes_lock);
+
 	g_hash_table_remove (genicam->priv->nodes, (char *) name);
 	g_hash_table_insert (genicam->priv->nodes, (char *) name, node);
 
+	genicam->priv->is_dependency_graph_valid = FALSE;
+	g_atomic_int_inc (&genicam->priv->nodes_generation);
+
+	g_rw_lock_writer_unlock (&genicam->priv->nodes_lock);
+
+	g_mutex_lock (&genicam->priv->events_mutex);
+	g_clear_pointer (&genicam->priv->event_ports, g_hash_table_unref);
+	g_mutex_unlock (&genicam->priv->events_mutex);
+
 	arv_log_genicam ("[Gc::register_feature_node] Register node '%s' [%s]", name,
 			 arv_dom_node_get_node_name (ARV_DOM_NODE (node)));
 }
 
+static void
+_add_dependent (GHashTable *graph, ArvGcFeatureNode *node, ArvGcFeatureNode *dependent)
+{
+	GPtrArray *dependents;
+	guint i;
+
+	if (node == dependent)
+		return;
+
+	dependents = g_hash_table_lookup (graph, node);
+	if (dependents == NULL) {
+		dependents = g_ptr_array_new ();
+		g_hash_table_insert (graph, node, dependents);
+	}
+
+	for (i = 0; i < dependents->len; i++)
+		if (g_ptr_array_index (dependents, i) == dependent)
+			return;
+
+	g_ptr_array_add (dependents, dependent);
+}
+
+static void
+_add_subtree_dependencies (GHashTable *graph, ArvGcFeatureNode *feature, ArvDomNode *parent)
+{
+	ArvDomNode *iter;
+
+	for (iter = arv_dom_node_get_first_child (parent);
+	     iter != NULL;
+	     iter = arv_dom_node_get_next_sibling (iter)) {
+		if (ARV_IS_GC_PROPERTY_NODE (iter)) {
+			ArvGcPropertyNode *property_node = ARV_GC_PROPERTY_NODE (iter);
+			ArvGcNode *linked_node;
+
+			switch (arv_gc_property_node_get_node_type (property_node)) {
+				case ARV_GC_PROPERTY_NODE_TYPE_P_PORT:
+					/* Not a value dependency, except for event ports, whose content
+					 * changes with each received event */
+					linked_node = arv_gc_property_node_get_linked_node (property_node);
+					if (ARV_IS_GC_PORT (linked_node) &&
+					    arv_gc_port_get_event_id (ARV_GC_PORT (linked_node), NULL))
+						_add_dependent (graph, ARV_GC_FEATURE_NODE (linked_node), feature);
+					break;
+				case ARV_GC_PROPERTY_NODE_TYPE_P_FEATURE:
+					/* Not a value dependency */
+					break;
+				case ARV_GC_PROPERTY_NODE_TYPE_P_SELECTED:
+					/* The selected feature depends on its selector */
+					linked_node = arv_gc_property_node_get_linked_node (property_node);
+					if (ARV_IS_GC_FEATURE_NODE (linked_node))
+						_add_dependent (graph, feature, ARV_GC_FEATURE_NODE (linked_node));
+					break;
+				default:
+					linked_node = arv_gc_property_node_get_linked_node (property_node);
+					if (ARV_IS_GC_FEATURE_NODE (linked_node))
+						_add_dependent (graph, ARV_GC_FEATURE_NODE (linked_node), feature);
+					break;
+			}
+
+			_add_subtree_dependencies (graph, feature, iter);
+		} else {
+			if (ARV_IS_GC_FEATURE_NODE (iter)) {
+				/* Embedded features (StructEntry, address SwissKnife...) share the
+				 * storage of their parent */
+				_add_dependent (graph, feature, ARV_GC_FEATURE_NODE (iter));
+				_add_dependent (graph, ARV_GC_FEATURE_NODE (iter), feature);
+			}
+
+			_add_subtree_dependencies (graph, feature, iter);
+		}
+	}
+}
+
+static void
+_build_dependency_graph (ArvGc *genicam)
+{
+	GHashTable *direct_dependents;
+	GList *features;
+	GList *iter;
+
+	/* Linked node resolution goes through arv_gc_get_node, the graph is built
+	 * out of the lock and swapped once complete */
+
+	g_rw_lock_reader_lock (&genicam->priv->nodes_lock);
+	features = g_hash_table_get_values (genicam->priv->nodes);
+	g_rw_lock_reader_unlock (&genicam->priv->nodes_lock);
+
+	direct_dependents = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL,
+						   (GDestroyNotify) g_ptr_array_unref);
+
+	for (iter = features; iter != NULL; iter = iter->next)
+		_add_subtree_dependencies (direct_dependents, ARV_GC_FEATURE_NODE (iter->data), ARV_DOM_NODE (iter->data));
+
+	g_list_free (features);
+
+	arv_debug_genicam ("[Gc::build_dependency_graph] %u nodes with dependents",
+			   g_hash_table_size (direct_dependents));
+
+	g_rw_lock_writer_lock (&genicam->priv->nodes_lock);
+
+	g_hash_table_unref (genicam->priv->direct_dependents);
+	genicam->priv->direct_dependents = direct_dependents;
+	g_hash_table_remove_all (genicam->priv->dependents);
+	genicam->priv->is_dependency_graph_valid = TRUE;
+
+	g_rw_lock_writer_unlock (&genicam->priv->nodes_lock);
+}
+
+/* Must be called with nodes_lock held */
+
+static GPtrArray *
+_compute_dependents (ArvGc *genicam, ArvGcFeatureNode *node)
+{
+	GPtrArray *dependents;
+	GHashTable *visited;
+	guint i;
+
+	/* Transitive closure, computed once per node and reused on each write */
+
+	dependents = g_ptr_array_new ();
+	visited = g_hash_table_new (g_direct_hash, g_direct_equal);
+
+	g_hash_table_add (visited, node);
+	g_ptr_array_add (dependents, node);
+
+	for (i = 0; i < dependents->len; i++) {
+		GPtrArray *direct_dependents;
+		guint j;
+
+		direct_dependents = g_hash_table_lookup (genicam->priv->direct_dependents,
+							 g_ptr_array_index (dependents, i));
+		if (direct_dependents == NULL)
+			continue;
+
+		for (j = 0; j < direct_dependents->len; j++) {
+			gpointer dependent = g_ptr_array_index (direct_dependents, j);
+
+			if (g_hash_table_add (visited, dependent))
+				g_ptr_array_add (dependents, dependent);
+		}
+	}
+
+	g_ptr_array_remove_index_fast (dependents, 0);
+	g_hash_table_unref (visited);
+
+	return dependents;
+}
+
+/**
+ * arv_gc_invalidate_dependents:
+ * @genicam: a #ArvGc object
+ * @node: a feature node whose value has changed
+ *
+ * Increments the change count of all the nodes which directly or indirectly depend on @node value, which marks their
+ * cached data as outdated.
+ */
+
+void
+arv_gc_invalidate_dependents (ArvGc *genicam, ArvGcFeatureNode *node)
+{
+	GPtrArray *dependents;
+	gboolean is_graph_valid;
+	guint i;
+
+	g_return_if_fail (ARV_IS_GC (genicam));
+	g_return_if_fail (ARV_IS_GC_FEATURE_NODE (node));
+
+	g_rw_lock_reader_lock (&genicam->priv->nodes_lock);
+	is_graph_valid = genicam->priv->is_dependency_graph_valid;
+	g_rw_lock_reader_unlock (&genicam->priv->nodes_lock);
+
+	if (!is_graph_valid)
+		_build_dependency_graph (genicam);
+
+	g_rw_lock_reader_lock (&genicam->priv->nodes_lock);
+	dependents = g_hash_table_lookup (genicam->priv->dependents, node);
+	if (dependents != NULL) {
+		for (i = 0; i < dependents->len; i++)
+			arv_gc_feature_node_invalidate (g_ptr_array_index (dependents, i));
+		g_rw_lock_reader_unlock (&genicam->priv->nodes_lock);
+		return;
+	}
+	g_rw_lock_reader_unlock (&genicam->priv->nodes_lock);
+
+	/* Transitive closure, computed once per node and reused on each write */
+
+	g_rw_lock_writer_lock (&genicam->priv->nodes_lock);
+	dependents = g_hash_table_lookup (genicam->priv->dependents, node);
+	if (dependents == NULL) {
+		dependents = _compute_dependents (genicam, node);
+		g_hash_table_insert (genicam->priv->dependents, node, dependents);
+	}
+	for (i = 0; i < dependents->len; i++)
+		arv_gc_feature_node_invalidate (g_ptr_array_index (dependents, i));
+	g_rw_lock_writer_unlock (&genicam->priv->nodes_lock);
+}
+
+void
+arv_gc_update_cache_statistics (ArvGc *genicam, gboolean hit)
+{
+	g_return_if_fail (ARV_IS_GC (genicam));
+
+	if (hit)
+		g_atomic_pointer_add (&genicam->priv->n_cache_hits, 1);
+	else
+		g_atomic_pointer_add (&genicam->priv->n_cache_misses, 1);
+}
+
+/* Called for each read of volatile data (non cachable register, chunk data) */
+
+void
+arv_gc_increment_uncached_read_count (ArvGc *genicam)
+{
+	g_return_if_fail (ARV_IS_GC (genicam));
+
+	g_atomic_pointer_add (&genicam->priv->n_uncached_reads, 1);
+}
+
+/* Incremented each time the node table is modified. Allows to keep resolved node pointers (pValue links, feature
+ * handles) across accesses. */
+
+guint
+arv_gc_get_nodes_generation (ArvGc *genicam)
+{
+	g_return_val_if_fail (ARV_IS_GC (genicam), 0);
+
+	return g_atomic_int_get (&genicam->priv->nodes_generation);
+}
+
+gboolean
+arv_gc_memo_is_valid (ArvGc *genicam, ArvGcFeatureNode *node, ArvGcMemo *memo)
+{
+	g_return_val_if_fail (ARV_IS_GC (genicam), FALSE);
+	g_return_val_if_fail (memo != NULL, FALSE);
+
+	if (!memo->is_valid ||
+	    g_atomic_int_get (&genicam->priv->cache_policy) != ARV_REGISTER_CACHE_POLICY_ENABLE ||
+	    memo->change_count != arv_gc_feature_node_get_change_count (node))
+		return FALSE;
+
+	g_atomic_pointer_add (&genicam->priv->n_memo_hits, 1);
+
+	return TRUE;
+}
+
+void
+arv_gc_memo_begin (ArvGc *genicam, ArvGcFeatureNode *node, ArvGcMemo *memo)
+{
+	g_return_if_fail (ARV_IS_GC (genicam));
+	g_return_if_fail (memo != NULL);
+
+	memo->is_valid = FALSE;
+	memo->change_count = arv_gc_feature_node_get_change_count (node);
+	memo->n_uncached_reads = (gsize) g_atomic_pointer_get (&genicam->priv->n_uncached_reads);
+}
+
+void
+arv_gc_memo_end (ArvGc *genicam, ArvGcMemo *memo)
+{
+	g_return_if_fail (ARV_IS_GC (genicam));
+	g_return_if_fail (memo != NULL);
+
+	/* Memoization is tied to the register cache: without it, any register read may return a new value */
+	memo->is_valid = g_atomic_int_get (&genicam->priv->cache_policy) == ARV_REGISTER_CACHE_POLICY_ENABLE &&
+		memo->n_uncached_reads == (gsize) g_atomic_pointer_get (&genicam->priv->n_uncached_reads);
+}
+
+/**
+ * arv_gc_get_register_cache_statistics:
+ * @genicam: a #ArvGc object
+ * @n_hits: (out) (allow-none): number of register reads served from the cache
+ * @n_misses: (out) (allow-none): number of register reads forwarded to the device
+ *
+ * Retrieves the register cache statistics, accumulated over all the register nodes of @genicam. Reads are only
+ * accounted when the register cache is enabled.
+ *
+ * Since: 0.8.0
+ */
+
+void
+arv_gc_get_register_cache_statistics (ArvGc *genicam, guint64 *n_hits, guint64 *n_misses)
+{
+	g_return_if_fail (ARV_IS_GC (genicam));
+
+	if (n_hits != NULL)
+		*n_hits = (gsize) g_atomic_pointer_get (&genicam->priv->n_cache_hits);
+	if (n_misses != NULL)
+		*n_misses = (gsize) g_atomic_pointer_get (&genicam->priv->n_cache_misses);
+}
+
 void
 arv_gc_set_default_node_data (ArvGc *genicam, const char *node_name, ...)
 {
@@ -346,7 +678,7 @@ arv_gc_set_register_cache_policy (ArvGc *genicam, ArvRegisterCachePolicy policy)
 {
 	g_return_if_fail (ARV_IS_GC (genicam));
 
-	genicam->priv->cache_policy = policy;
+	g_atomic_int_set (&genicam->priv->cache_policy, policy);
 }
 
 ArvRegisterCachePolicy
@@ -354,36 +686,160 @@ arv_gc_get_register_cache_policy (ArvGc *genicam)
 {
 	g_return_val_if_fail (ARV_IS_GC (genicam), ARV_REGISTER_CACHE_POLICY_DISABLE);
 
-	return genicam->priv->cache_policy;
+	return g_atomic_int_get (&genicam->priv->cache_policy);
 }
 
 static void
 _weak_notify_cb (gpointer data, GObject *object)
 {
 	ArvGc *genicam = data;
+	GHashTableIter iter;
+	gpointer value;
+
+	g_mutex_lock (&genicam->priv->buffers_mutex);
+
+	g_hash_table_iter_init (&iter, genicam->priv->buffers);
+	while (g_hash_table_iter_next (&iter, NULL, &value))
+		if (value == (gpointer) object)
+			g_hash_table_iter_remove (&iter);
+
+	g_mutex_unlock (&genicam->priv->buffers_mutex);
+}
+
+/* The buffer bindings are keyed by a per thread token, which is destroyed at thread exit and removes the bindings of
+ * the exiting thread from all the genicam instances it used. The genicam list is only accessed by its thread. */
+
+typedef struct {
+	GSList *genicams;			/* GWeakRef to ArvGc */
+} ArvGcThreadToken;
+
+static void
+_unbind_thread_buffer (ArvGc *genicam, ArvGcThreadToken *token)
+{
+	ArvBuffer *buffer;
+
+	g_mutex_lock (&genicam->priv->buffers_mutex);
+
+	buffer = g_hash_table_lookup (genicam->priv->buffers, token);
+	if (buffer != NULL) {
+		g_object_weak_unref (G_OBJECT (buffer), _weak_notify_cb, genicam);
+		g_hash_table_remove (genicam->priv->buffers, token);
+	}
+
+	g_mutex_unlock (&genicam->priv->buffers_mutex);
+}
+
+static void
+_weak_ref_free (GWeakRef *weak_ref)
+{
+	g_weak_ref_clear (weak_ref);
+	g_free (weak_ref);
+}
+
+static void
+_thread_token_free (ArvGcThreadToken *token)
+{
+	GSList *iter;
 
-	genicam->priv->buffer = NULL;
+	for (iter = token->genicams; iter != NULL; iter = iter->next) {
+		ArvGc *genicam = g_weak_ref_get (iter->data);
+
+		if (genicam != NULL) {
+			_unbind_thread_buffer (genicam, token);
+			g_object_unref (genicam);
+		}
+	}
+
+	g_slist_free_full (token->genicams, (GDestroyNotify) _weak_ref_free);
+	g_free (token);
+}
+
+static GPrivate arv_gc_thread_token = G_PRIVATE_INIT ((GDestroyNotify) _thread_token_free);
+
+static ArvGcThreadToken *
+_get_thread_token (gboolean create)
+{
+	ArvGcThreadToken *token = g_private_get (&arv_gc_thread_token);
+
+	if (token == NULL && create) {
+		token = g_new0 (ArvGcThreadToken, 1);
+		g_private_set (&arv_gc_thread_token, token);
+	}
+
+	return token;
+}
+
+static void
+_thread_token_add_genicam (ArvGcThreadToken *token, ArvGc *genicam)
+{
+	GSList *iter;
+	GSList *next;
+	GWeakRef *weak_ref;
+
+	for (iter = token->genicams; iter != NULL; iter = next) {
+		ArvGc *other = g_weak_ref_get (iter->data);
+
+		next = iter->next;
+
+		if (other == genicam) {
+			g_object_unref (other);
+			return;
+		}
+
+		if (other != NULL) {
+			g_object_unref (other);
+		} else {
+			_weak_ref_free (iter->data);
+			token->genicams = g_slist_delete_link (token->genicams, iter);
+		}
+	}
+
+	weak_ref = g_new0 (GWeakRef, 1);
+	g_weak_ref_init (weak_ref, genicam);
+	token->genicams = g_slist_prepend (token->genicams, weak_ref);
 }
 
+/**
+ * arv_gc_set_buffer:
+ * @genicam: a #ArvGc object
+ * @buffer: a #ArvBuffer
+ *
+ * Binds @buffer to @genicam for chunk data access. The binding is specific to the calling thread, which allows several
+ * threads to parse chunk data of different buffers concurrently. The binding is released when @buffer is finalized
+ * or when the calling thread exits.
+ */
+
 void
 arv_gc_set_buffer (ArvGc *genicam, ArvBuffer *buffer)
 {
+	ArvGcThreadToken *token;
+	ArvBuffer *old_buffer;
+
 	g_return_if_fail (ARV_IS_GC (genicam));
 	g_return_if_fail (ARV_IS_BUFFER (buffer));
 
-	if (genicam->priv->buffer != NULL)
-		g_object_weak_unref (G_OBJECT (genicam->priv->buffer), _weak_notify_cb, genicam);
+	token = _get_thread_token (TRUE);
+	_thread_token_add_genicam (token, genicam);
+
+	g_mutex_lock (&genicam->priv->buffers_mutex);
 
-	g_object_weak_ref (G_OBJECT (buffer), _weak_notify_cb, genicam);
+	old_buffer = g_hash_table_lookup (genicam->priv->buffers, token);
+	if (old_buffer != buffer) {
+		if (old_buffer != NULL)
+			g_object_weak_unref (G_OBJECT (old_buffer), _weak_notify_cb, genicam);
 
-	genicam->priv->buffer = buffer;
+		g_object_weak_ref (G_OBJECT (buffer), _weak_notify_cb, genicam);
+		g_hash_table_replace (genicam->priv->buffers, token, buffer);
+	}
+
+	g_mutex_unlock (&genicam->priv->buffers_mutex);
 }
 
 /**
  * arv_gc_get_buffer:
  * @genicam: a #ArvGc object
  *
- * Retrieves the binded buffer.
+ * Retrieves the buffer binded by the calling thread.
  *
  * Return value: (transfer none): a #ArvBuffer.
  */
@@ -391,18 +847,140 @@ arv_gc_set_buffer (ArvGc *genicam, ArvBuffer *buffer)
 ArvBuffer *
 arv_gc_get_buffer (ArvGc *genicam)
 {
+	ArvGcThreadToken *token;
+	ArvBuffer *buffer;
+
 	g_return_val_if_fail (ARV_IS_GC (genicam), NULL);
 
-	return genicam->priv->buffer;
+	token = _get_thread_token (FALSE);
+	if (token == NULL)
+		return NULL;
+
+	g_mutex_lock (&genicam->priv->buffers_mutex);
+	buffer = g_hash_table_lookup (genicam->priv->buffers, token);
+	g_mutex_unlock (&genicam->priv->buffers_mutex);
+
+	return buffer;
+}
+
+/* Must be called with events_mutex held */
+
+static GHashTable *
+_build_event_port_table (ArvGc *genicam)
+{
+	GHashTable *event_ports;
+	GList *nodes;
+	GList *iter;
+
+	event_ports = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, (GDestroyNotify) g_ptr_array_unref);
+
+	g_rw_lock_reader_lock (&genicam->priv->nodes_lock);
+	nodes = g_hash_table_get_values (genicam->priv->nodes);
+	g_rw_lock_reader_unlock (&genicam->priv->nodes_lock);
+
+	for (iter = nodes; iter != NULL; iter = iter->next) {
+		guint16 event_id;
+
+		if (ARV_IS_GC_PORT (iter->data) &&
+		    arv_gc_port_get_event_id (ARV_GC_PORT (iter->data), &event_id)) {
+			GPtrArray *ports;
+
+			ports = g_hash_table_lookup (event_ports, GUINT_TO_POINTER (event_id));
+			if (ports == NULL) {
+				ports = g_ptr_array_new ();
+				g_hash_table_insert (event_ports, GUINT_TO_POINTER (event_id), ports);
+			}
+			g_ptr_array_add (ports, iter->data);
+		}
+	}
+
+	g_list_free (nodes);
+
+	arv_debug_genicam ("[Gc::build_event_port_table] %u event identifiers", g_hash_table_size (event_ports));
+
+	return event_ports;
+}
+
+/**
+ * arv_gc_set_event_data:
+ * @genicam: a #ArvGc object
+ * @event_id: event identifier
+ * @data: (array length=size) (element-type guint8): event data
+ * @size: size of @data, in bytes
+ *
+ * Stores the data of a received event. The data are exposed to the features of the Port nodes with a matching EventID
+ * property, until the next event with the same identifier, and the cached values of these features are invalidated.
+ * For GigE Vision devices, @data contains the complete event item, including the event header.
+ *
+ * Since: 0.8.0
+ */
+
+void
+arv_gc_set_event_data (ArvGc *genicam, guint16 event_id, const void *data, size_t size)
+{
+	GPtrArray *ports;
+	guint i;
+
+	g_return_if_fail (ARV_IS_GC (genicam));
+	g_return_if_fail (data != NULL || size == 0);
+
+	g_mutex_lock (&genicam->priv->events_mutex);
+
+	if (genicam->priv->event_ports == NULL)
+		genicam->priv->event_ports = _build_event_port_table (genicam);
+
+	g_hash_table_replace (genicam->priv->events, GUINT_TO_POINTER (event_id), g_bytes_new (data, size));
+
+	ports = g_hash_table_lookup (genicam->priv->event_ports, GUINT_TO_POINTER (event_id));
+	if (ports != NULL)
+		g_ptr_array_ref (ports);
+
+	g_mutex_unlock (&genicam->priv->events_mutex);
+
+	if (ports == NULL)
+		return;
+
+	for (i = 0; i < ports->len; i++)
+		arv_gc_feature_node_increment_change_count (g_ptr_array_index (ports, i));
+
+	g_ptr_array_unref (ports);
+}
+
+/* Returns a reference to the data of the last event received with @event_id, or NULL */
+
+GBytes *
+arv_gc_dup_event_data (ArvGc *genicam, guint16 event_id)
+{
+	GBytes *data;
+
+	g_return_val_if_fail (ARV_IS_GC (genicam), NULL);
+
+	g_mutex_lock (&genicam->priv->events_mutex);
+	data = g_hash_table_lookup (genicam->priv->events, GUINT_TO_POINTER (event_id));
+	if (data != NULL)
+		g_bytes_ref (data);
+	g_mutex_unlock (&genicam->priv->events_mutex);
+
+	return data;
 }
 
 ArvGc *
 arv_gc_new (ArvDevice *device, const void *xml, size_t size)
 {
 	ArvDomDocument *document;
-	ArvGc *genicam;
 
 	document = arv_dom_document_new_from_memory (xml, size, NULL);
+
+	return arv_gc_new_from_document (device, document);
+}
+
+/* Takes ownership of an already parsed document, and binds it to @device */
+
+ArvGc *
+arv_gc_new_from_document (ArvDevice *device, ArvDomDocument *document)
+{
+	ArvGc *genicam;
+
 	if (!ARV_IS_GC (document)) {
 		if (document != NULL)
 			g_object_unref (document);
@@ -412,6 +990,8 @@ arv_gc_new (ArvDevice *device, const void *xml, size_t size)
 	genicam = ARV_GC (document);
 	genicam->priv->device = device;
 
+	_build_dependency_graph (genicam);
+
 	return genicam;
 }
 
@@ -422,20 +1002,53 @@ arv_gc_init (ArvGc *genicam)
 {
 	genicam->priv = arv_gc_get_instance_private (genicam);
 
+	g_rw_lock_init (&genicam->priv->nodes_lock);
+	g_mutex_init (&genicam->priv->buffers_mutex);
+	g_mutex_init (&genicam->priv->events_mutex);
+
 	genicam->priv->nodes = g_hash_table_new_full (g_str_hash, g_str_equal, NULL, g_object_unref);
+	genicam->priv->buffers = g_hash_table_new (g_direct_hash, g_direct_equal);
+	genicam->priv->events = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL,
+						       (GDestroyNotify) g_bytes_unref);
+	genicam->priv->event_ports = NULL;
 	genicam->priv->cache_policy = ARV_REGISTER_CACHE_POLICY_DISABLE;
+	genicam->priv->direct_dependents = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL,
+								  (GDestroyNotify) g_ptr_array_unref);
+	genicam->priv->dependents = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL,
+							   (GDestroyNotify) g_ptr_array_unref);
+	genicam->priv->is_dependency_graph_valid = FALSE;
 }
 
 static void
 arv_gc_finalize (GObject *object)
 {
 	ArvGc *genicam = ARV_GC (object);
+	GHashTableIter iter;
+	gpointer value;
+
+	g_hash_table_iter_init (&iter, genicam->priv->buffers);
+	while (g_hash_table_iter_next (&iter, NULL, &value))
+		g_object_weak_unref (G_OBJECT (value), _weak_notify_cb, genicam);
 
-	if (genicam->priv->buffer != NULL)
-		g_object_weak_unref (G_OBJECT (genicam->priv->buffer), _weak_notify_cb, genicam);
+	if (genicam->priv->n_cache_hits > 0 || genicam->priv->n_cache_misses > 0)
+		arv_debug_genicam ("[Gc::finalize] Register cache hits = %" G_GSIZE_FORMAT " / %" G_GSIZE_FORMAT,
+				   genicam->priv->n_cache_hits,
+				   genicam->priv->n_cache_hits + genicam->priv->n_cache_misses);
+	if (genicam->priv->n_memo_hits > 0)
+		arv_debug_genicam ("[Gc::finalize] Memoized value hits = %" G_GSIZE_FORMAT,
+				   genicam->priv->n_memo_hits);
 
+	g_hash_table_unref (genicam->priv->buffers);
+	g_hash_table_unref (genicam->priv->events);
+	g_clear_pointer (&genicam->priv->event_ports, g_hash_table_unref);
+	g_hash_table_unref (genicam->priv->dependents);
+	g_hash_table_unref (genicam->priv->direct_dependents);
 	g_hash_table_unref (genicam->priv->nodes);
 
+	g_mutex_clear (&genicam->priv->buffers_mutex);
+	g_mutex_clear (&genicam->priv->events_mutex);
+	g_rw_lock_clear (&genicam->priv->nodes_lock);
+
 	G_OBJECT_CLASS (arv_gc_parent_class)->finalize (object);
 }
 
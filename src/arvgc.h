@@ -48,7 +48,8 @@ typedef enum {
 	ARV_GC_ERROR_INVALID_LENGTH,
 	ARV_GC_ERROR_READ_ONLY,
 	ARV_GC_ERROR_SET_FROM_STRING_UNDEFINED,
-	ARV_GC_ERROR_GET_AS_STRING_UNDEFINED
+	ARV_GC_ERROR_GET_AS_STRING_UNDEFINED,
+	ARV_GC_ERROR_EVENT_NOT_FOUND
 } ArvGcError;
 
 /**
@@ -75,11 +76,14 @@ ArvGc * 		arv_gc_new 				(ArvDevice *device, const void *xml, size_t size);
 void 			arv_gc_register_feature_node 		(ArvGc *genicam, ArvGcFeatureNode *node);
 void			arv_gc_set_register_cache_policy	(ArvGc *genicam, ArvRegisterCachePolicy policy);
 ArvRegisterCachePolicy 	arv_gc_get_register_cache_policy 	(ArvGc *genicam);
+void			arv_gc_get_register_cache_statistics	(ArvGc *genicam, guint64 *n_hits, guint64 *n_misses);
 void 			arv_gc_set_default_node_data 		(ArvGc *genicam, const char *node_name, ...) G_GNUC_NULL_TERMINATED;
 ArvGcNode *		arv_gc_get_node				(ArvGc *genicam, const char *name);
 ArvDevice *		arv_gc_get_device			(ArvGc *genicam);
 void			arv_gc_set_buffer			(ArvGc *genicam, ArvBuffer *buffer);
 ArvBuffer *		arv_gc_get_buffer			(ArvGc *genicam);
+void			arv_gc_set_event_data			(ArvGc *genicam, guint16 event_id,
+								 const void *data, size_t size);
 
 G_END_DECLS
 
@@ -30,7 +30,7 @@
 #include <arvevaluator.h>
 #include <arvgcinteger.h>
 #include <arvgcfloat.h>
-#include <arvgc.h>
+#include <arvgcprivate.h>
 #include <arvdebug.h>
 #include <string.h>
 
@@ -46,8 +46,15 @@ typedef struct {
 	ArvGcPropertyNode *is_linear;
 	ArvGcPropertyNode *slope;
 
+	GRecMutex mutex;		/* Protects the evaluators and memoized values */
 	ArvEvaluator *formula_to;
 	ArvEvaluator *formula_from;
+
+	/* Indexed by ArvGcConverterNodeType */
+	ArvGcMemo int64_memos[ARV_GC_CONVERTER_NODE_TYPE_INC + 1];
+	gint64 int64_values[ARV_GC_CONVERTER_NODE_TYPE_INC + 1];
+	ArvGcMemo double_memos[ARV_GC_CONVERTER_NODE_TYPE_INC + 1];
+	double double_values[ARV_GC_CONVERTER_NODE_TYPE_INC + 1];
 } ArvGcConverterPrivate;
 
 G_DEFINE_ABSTRACT_TYPE_WITH_CODE (ArvGcConverter, arv_gc_converter, ARV_TYPE_GC_FEATURE_NODE,
@@ -111,6 +118,7 @@ arv_gc_converter_init (ArvGcConverter *self)
 {
 	ArvGcConverterPrivate *priv = arv_gc_converter_get_instance_private (ARV_GC_CONVERTER (self));
 
+	g_rec_mutex_init (&priv->mutex);
 	priv->formula_to = arv_evaluator_new (NULL);
 	priv->formula_from = arv_evaluator_new (NULL);
 	priv->value = NULL;
@@ -127,6 +135,7 @@ arv_gc_converter_finalize (GObject *object)
 
 	g_object_unref (priv->formula_to);
 	g_object_unref (priv->formula_from);
+	g_rec_mutex_clear (&priv->mutex);
 
 	G_OBJECT_CLASS (arv_gc_converter_parent_class)->finalize (object);
 }
@@ -328,13 +337,19 @@ arv_gc_converter_update_from_variables (ArvGcConverter *gc_converter, ArvGcConve
 	return TRUE;
 }
 
-double
-arv_gc_converter_convert_to_double (ArvGcConverter *gc_converter, ArvGcConverterNodeType node_type, GError **error)
+static double
+_convert_to_double (ArvGcConverter *gc_converter, ArvGcConverterNodeType node_type, GError **error)
 {
 	ArvGcConverterPrivate *priv = arv_gc_converter_get_instance_private (gc_converter);
 	GError *local_error = NULL;
+	ArvGc *genicam;
 
-	g_return_val_if_fail (ARV_IS_GC_CONVERTER (gc_converter), 0.0);
+	genicam = arv_gc_node_get_genicam (ARV_GC_NODE (gc_converter));
+
+	if (arv_gc_memo_is_valid (genicam, ARV_GC_FEATURE_NODE (gc_converter), &priv->double_memos[node_type]))
+		return priv->double_values[node_type];
+
+	arv_gc_memo_begin (genicam, ARV_GC_FEATURE_NODE (gc_converter), &priv->double_memos[node_type]);
 
 	if (!arv_gc_converter_update_from_variables (gc_converter, node_type, &local_error)) {
 		if (local_error != NULL)
@@ -350,16 +365,42 @@ arv_gc_converter_convert_to_double (ArvGcConverter *gc_converter, ArvGcConverter
 		}
 	}
 
-	return arv_evaluator_evaluate_as_double (priv->formula_from, NULL);
+	priv->double_values[node_type] = arv_evaluator_evaluate_as_double (priv->formula_from, NULL);
+
+	arv_gc_memo_end (genicam, &priv->double_memos[node_type]);
+
+	return priv->double_values[node_type];
 }
 
-gint64
-arv_gc_converter_convert_to_int64 (ArvGcConverter *gc_converter, ArvGcConverterNodeType node_type, GError **error)
+double
+arv_gc_converter_convert_to_double (ArvGcConverter *gc_converter, ArvGcConverterNodeType node_type, GError **error)
+{
+	ArvGcConverterPrivate *priv = arv_gc_converter_get_instance_private (gc_converter);
+	double value;
+
+	g_return_val_if_fail (ARV_IS_GC_CONVERTER (gc_converter), 0.0);
+	g_return_val_if_fail (node_type <= ARV_GC_CONVERTER_NODE_TYPE_INC, 0.0);
+
+	g_rec_mutex_lock (&priv->mutex);
+	value = _convert_to_double (gc_converter, node_type, error);
+	g_rec_mutex_unlock (&priv->mutex);
+
+	return value;
+}
+
+static gint64
+_convert_to_int64 (ArvGcConverter *gc_converter, ArvGcConverterNodeType node_type, GError **error)
 {
 	ArvGcConverterPrivate *priv = arv_gc_converter_get_instance_private (gc_converter);
 	GError *local_error = NULL;
+	ArvGc *genicam;
 
-	g_return_val_if_fail (ARV_IS_GC_CONVERTER (gc_converter), 0);
+	genicam = arv_gc_node_get_genicam (ARV_GC_NODE (gc_converter));
+
+	if (arv_gc_memo_is_valid (genicam, ARV_GC_FEATURE_NODE (gc_converter), &priv->int64_memos[node_type]))
+		return priv->int64_values[node_type];
+
+	arv_gc_memo_begin (genicam, ARV_GC_FEATURE_NODE (gc_converter), &priv->int64_memos[node_type]);
 
 	if (!arv_gc_converter_update_from_variables (gc_converter, node_type, &local_error)) {
 		if (local_error != NULL)
@@ -375,7 +416,27 @@ arv_gc_converter_convert_to_int64 (ArvGcConverter *gc_converter, ArvGcConverterN
 		}
 	}
 
-	return arv_evaluator_evaluate_as_double (priv->formula_from, NULL);
+	priv->int64_values[node_type] = arv_evaluator_evaluate_as_double (priv->formula_from, NULL);
+
+	arv_gc_memo_end (genicam, &priv->int64_memos[node_type]);
+
+	return priv->int64_values[node_type];
+}
+
+gint64
+arv_gc_converter_convert_to_int64 (ArvGcConverter *gc_converter, ArvGcConverterNodeType node_type, GError **error)
+{
+	ArvGcConverterPrivate *priv = arv_gc_converter_get_instance_private (gc_converter);
+	gint64 value;
+
+	g_return_val_if_fail (ARV_IS_GC_CONVERTER (gc_converter), 0);
+	g_return_val_if_fail (node_type <= ARV_GC_CONVERTER_NODE_TYPE_INC, 0);
+
+	g_rec_mutex_lock (&priv->mutex);
+	value = _convert_to_int64 (gc_converter, node_type, error);
+	g_rec_mutex_unlock (&priv->mutex);
+
+	return value;
 }
 
 static void
@@ -496,9 +557,13 @@ arv_gc_converter_convert_from_double (ArvGcConverter *gc_converter, double value
 
 	g_return_if_fail (ARV_IS_GC_CONVERTER (gc_converter));
 
+	g_rec_mutex_lock (&priv->mutex);
+
 	arv_gc_feature_node_increment_change_count (ARV_GC_FEATURE_NODE (gc_converter));
 	arv_evaluator_set_double_variable (priv->formula_to, "FROM", value);
 	arv_gc_converter_update_to_variables (gc_converter, error);
+
+	g_rec_mutex_unlock (&priv->mutex);
 }
 
 void
@@ -508,9 +573,13 @@ arv_gc_converter_convert_from_int64 (ArvGcConverter *gc_converter, gint64 value,
 
 	g_return_if_fail (ARV_IS_GC_CONVERTER (gc_converter));
 
+	g_rec_mutex_lock (&priv->mutex);
+
 	arv_gc_feature_node_increment_change_count (ARV_GC_FEATURE_NODE (gc_converter));
 	arv_evaluator_set_int64_variable (priv->formula_to, "FROM", value);
 	arv_gc_converter_update_to_variables (gc_converter, error);
+
+	g_rec_mutex_unlock (&priv->mutex);
 }
 
 const char *
@@ -30,7 +30,7 @@
 
 #include <arvgcfeaturenode.h>
 #include <arvgcpropertynode.h>
-#include <arvgc.h>
+#include <arvgcprivate.h>
 #include <arvgcboolean.h>
 #include <arvgcinteger.h>
 #include <arvgcfloat.h>
@@ -55,6 +55,7 @@ typedef struct {
 	ArvGcPropertyNode *access_mode;
 	ArvGcPropertyNode *imposed_access_mode;
 
+	GMutex change_count_mutex;
 	guint64 change_count;
 
 	char *string_buffer;
@@ -433,20 +434,46 @@ void
 arv_gc_feature_node_increment_change_count (ArvGcFeatureNode *self)
 {
 	ArvGcFeatureNodePrivate *priv = arv_gc_feature_node_get_instance_private (self);
+	ArvDomDocument *document;
 
 	g_return_if_fail (ARV_IS_GC_FEATURE_NODE (self));
 
+	g_mutex_lock (&priv->change_count_mutex);
 	priv->change_count++;
+	g_mutex_unlock (&priv->change_count_mutex);
+
+	document = arv_dom_node_get_owner_document (ARV_DOM_NODE (self));
+	if (ARV_IS_GC (document))
+		arv_gc_invalidate_dependents (ARV_GC (document), self);
+}
+
+/* Called by the dependency graph when one of the nodes this node depends on has changed */
+
+void
+arv_gc_feature_node_invalidate (ArvGcFeatureNode *self)
+{
+	ArvGcFeatureNodePrivate *priv = arv_gc_feature_node_get_instance_private (self);
+
+	g_return_if_fail (ARV_IS_GC_FEATURE_NODE (self));
+
+	g_mutex_lock (&priv->change_count_mutex);
+	priv->change_count++;
+	g_mutex_unlock (&priv->change_count_mutex);
 }
 
 guint64
 arv_gc_feature_node_get_change_count (ArvGcFeatureNode *self)
 {
 	ArvGcFeatureNodePrivate *priv = arv_gc_feature_node_get_instance_private (self);
+	guint64 change_count;
 
 	g_return_val_if_fail (ARV_IS_GC_FEATURE_NODE (self), 0);
 
-	return priv->change_count;
+	g_mutex_lock (&priv->change_count_mutex);
+	change_count = priv->change_count;
+	g_mutex_unlock (&priv->change_count_mutex);
+
+	return change_count;
 }
 
 static void
@@ -454,6 +481,7 @@ arv_gc_feature_node_init (ArvGcFeatureNode *self)
 {
 	ArvGcFeatureNodePrivate *priv = arv_gc_feature_node_get_instance_private (self);
 
+	g_mutex_init (&priv->change_count_mutex);
 	priv->change_count = 0;
 }
 
@@ -464,6 +492,7 @@ arv_gc_feature_node_finalize (GObject *object)
 
 	g_clear_pointer (&priv->name, g_free);
 	g_clear_pointer (&priv->string_buffer, g_free);
+	g_mutex_clear (&priv->change_count_mutex);
 
 	G_OBJECT_CLASS (arv_gc_feature_node_parent_class)->finalize (object);
 }
@@ -30,6 +30,7 @@ G_BEGIN_DECLS
 
 void			arv_gc_feature_node_increment_change_count	(ArvGcFeatureNode *gc_feature_node);
 guint64 		arv_gc_feature_node_get_change_count 		(ArvGcFeatureNode *gc_feature_node);
+void			arv_gc_feature_node_invalidate			(ArvGcFeatureNode *gc_feature_node);
 
 G_END_DECLS
 
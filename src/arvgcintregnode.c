@@ -20,7 +20,7 @@
  * Author: Emmanuel Pacaud <emmanuel@gnome.org>
  */
 
-#include <arvgcintregnode.h>
+#include <arvgcintregnodeprivate.h>
 #include <arvgcregisternodeprivate.h>
 #include <arvgcpropertynode.h>
 #include <arvgcinteger.h>
@@ -205,6 +205,19 @@ arv_gc_int_reg_node_new	(void)
 	return g_object_new (ARV_TYPE_GC_INT_REG_NODE, NULL);
 }
 
+void
+arv_gc_int_reg_node_get_format (ArvGcIntRegNode *self, ArvGcSignedness *signedness, guint *endianess)
+{
+	ArvGcIntRegNodePrivate *priv = arv_gc_int_reg_node_get_instance_private (self);
+
+	g_return_if_fail (ARV_IS_GC_INT_REG_NODE (self));
+
+	if (signedness != NULL)
+		*signedness = arv_gc_property_node_get_sign (priv->sign, ARV_GC_SIGNEDNESS_UNSIGNED);
+	if (endianess != NULL)
+		*endianess = arv_gc_property_node_get_endianess (priv->endianess, G_LITTLE_ENDIAN);
+}
+
 static void
 arv_gc_int_reg_node_integer_interface_init (ArvGcIntegerInterface *interface)
 {
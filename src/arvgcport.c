@@ -25,7 +25,7 @@
  * @short_description: Class for Port nodes
  */
 
-#include <arvgcport.h>
+#include <arvgcportprivate.h>
 #include <arvgcregisterdescriptionnode.h>
 #include <arvgcfeaturenodeprivate.h>
 #include <arvdevice.h>
@@ -33,12 +33,18 @@
 #include <arvchunkparserprivate.h>
 #include <arvbuffer.h>
 #include <arvgcpropertynode.h>
-#include <arvgc.h>
+#include <arvgcprivate.h>
 #include <memory.h>
 
 typedef struct {
 	ArvGcPropertyNode *chunk_id;
 	ArvGcPropertyNode *event_id;
+
+	gint is_chunk_id_parsed;	/* Atomic access */
+	guint32 chunk_id_value;
+
+	gint is_event_id_parsed;	/* Atomic access */
+	guint16 event_id_value;
 } ArvGcPortPrivate;
 
 struct _ArvGcPort {
@@ -104,6 +110,56 @@ _use_legacy_endianess_mechanism (ArvGcPort *port, guint64 length)
 	return length == 4 && (arv_gc_register_description_node_compare_schema_version (register_description, 1, 1, 0) < 0);
 }
 
+/* The ChunkID string is parsed on first use, once the document is fully loaded */
+
+static guint32
+_get_chunk_id (ArvGcPort *port)
+{
+	if (!g_atomic_int_get (&port->priv->is_chunk_id_parsed)) {
+		port->priv->chunk_id_value = g_ascii_strtoll (arv_gc_property_node_get_string (port->priv->chunk_id,
+											       NULL), NULL, 16);
+		g_atomic_int_set (&port->priv->is_chunk_id_parsed, TRUE);
+	}
+
+	return port->priv->chunk_id_value;
+}
+
+/* Same for the EventID string */
+
+static guint16
+_get_event_id (ArvGcPort *port)
+{
+	if (!g_atomic_int_get (&port->priv->is_event_id_parsed)) {
+		port->priv->event_id_value = g_ascii_strtoll (arv_gc_property_node_get_string (port->priv->event_id,
+											       NULL), NULL, 16);
+		g_atomic_int_set (&port->priv->is_event_id_parsed, TRUE);
+	}
+
+	return port->priv->event_id_value;
+}
+
+/**
+ * arv_gc_port_get_event_id:
+ * @port: a #ArvGcPort
+ * @event_id: (out) (optional): the event identifier
+ *
+ * Returns: %TRUE if @port exposes event data.
+ */
+
+gboolean
+arv_gc_port_get_event_id (ArvGcPort *port, guint16 *event_id)
+{
+	g_return_val_if_fail (ARV_IS_GC_PORT (port), FALSE);
+
+	if (port->priv->event_id == NULL)
+		return FALSE;
+
+	if (event_id != NULL)
+		*event_id = _get_event_id (port);
+
+	return TRUE;
+}
+
 void
 arv_gc_port_read (ArvGcPort *port, void *buffer, guint64 address, guint64 length, GError **error)
 {
@@ -119,6 +175,9 @@ arv_gc_port_read (ArvGcPort *port, void *buffer, guint64 address, guint64 length
 
 		chunk_data_buffer = arv_gc_get_buffer (genicam);
 
+		/* Chunk data changes with each buffer */
+		arv_gc_increment_uncached_read_count (genicam);
+
 		if (!ARV_IS_BUFFER (chunk_data_buffer)) {
 			g_set_error (error, ARV_CHUNK_PARSER_ERROR, ARV_CHUNK_PARSER_ERROR_BUFFER_NOT_FOUND,
 				     "[ArvGcPort::read] Buffer not found");
@@ -127,7 +186,7 @@ arv_gc_port_read (ArvGcPort *port, void *buffer, guint64 address, guint64 length
 			size_t chunk_data_size;
 			guint chunk_id;
 
-			chunk_id = g_ascii_strtoll (arv_gc_property_node_get_string (port->priv->chunk_id, NULL), NULL, 16);
+			chunk_id = _get_chunk_id (port);
 			chunk_data = (char *) arv_buffer_get_chunk_data (chunk_data_buffer, chunk_id, &chunk_data_size);
 
 			if (chunk_data != NULL) {
@@ -138,8 +197,28 @@ arv_gc_port_read (ArvGcPort *port, void *buffer, guint64 address, guint64 length
 			}
 		}
 	} else if (port->priv->event_id != NULL) {
-		g_set_error (error, ARV_GC_ERROR, ARV_GC_ERROR_NO_EVENT_IMPLEMENTATION,
-			     "[ArvGcPort::read] Event support is not implemented");
+		GBytes *event_data;
+		guint16 event_id;
+
+		event_id = _get_event_id (port);
+		event_data = arv_gc_dup_event_data (genicam, event_id);
+
+		if (event_data == NULL) {
+			g_set_error (error, ARV_GC_ERROR, ARV_GC_ERROR_EVENT_NOT_FOUND,
+				     "[ArvGcPort::read] Event 0x%04x not received", event_id);
+		} else {
+			const char *data;
+			size_t data_size;
+
+			data = g_bytes_get_data (event_data, &data_size);
+			if (address + length <= data_size) {
+				memcpy (buffer, data + address, length);
+			} else {
+				g_set_error (error, ARV_GC_ERROR, ARV_GC_ERROR_INVALID_LENGTH,
+					     "[ArvGcPort::read] Read outside of event 0x%04x data", event_id);
+			}
+			g_bytes_unref (event_data);
+		}
 	} else {
 		ArvDevice *device;
 
@@ -189,7 +268,7 @@ arv_gc_port_write (ArvGcPort *port, void *buffer, guint64 address, guint64 lengt
 			size_t chunk_data_size;
 			guint chunk_id;
 
-			chunk_id = g_ascii_strtoll (arv_gc_property_node_get_string (port->priv->chunk_id, NULL), NULL, 16);
+			chunk_id = _get_chunk_id (port);
 			chunk_data = (char *) arv_buffer_get_chunk_data (chunk_data_buffer, chunk_id, &chunk_data_size);
 
 			if (chunk_data != NULL) {
@@ -200,8 +279,8 @@ arv_gc_port_write (ArvGcPort *port, void *buffer, guint64 address, guint64 lengt
 			}
 		}
 	} else if (port->priv->event_id != NULL) {
-		g_set_error (error, ARV_GC_ERROR, ARV_GC_ERROR_NO_EVENT_IMPLEMENTATION,
-			     "[ArvGcPort::read] Event support is not implemented");
+		g_set_error (error, ARV_GC_ERROR, ARV_GC_ERROR_READ_ONLY,
+			     "[ArvGcPort::write] Event data are read only");
 	} else {
 		device = arv_gc_get_device (genicam);
 
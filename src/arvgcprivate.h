@@ -0,0 +1,54 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2019 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel@gnome.org>
+ */
+
+
+#ifndef ARV_GC_PRIVATE_H
+#define ARV_GC_PRIVATE_H
+
+#include <arvgc.h>
+
+G_BEGIN_DECLS
+
+/* Memoization state of a computed node value (SwissKnife, Converter...). The memoized value is valid as long as
+ * no node the computed value depends on has changed, and if no volatile data was read during its evaluation. */
+
+typedef struct {
+	gboolean is_valid;
+	guint64 change_count;
+	guint64 n_uncached_reads;
+} ArvGcMemo;
+
+ArvGc *		arv_gc_new_from_document		(ArvDevice *device, ArvDomDocument *document);
+
+void		arv_gc_invalidate_dependents		(ArvGc *genicam, ArvGcFeatureNode *node);
+void		arv_gc_update_cache_statistics		(ArvGc *genicam, gboolean hit);
+void		arv_gc_increment_uncached_read_count	(ArvGc *genicam);
+guint		arv_gc_get_nodes_generation		(ArvGc *genicam);
+GBytes *	arv_gc_dup_event_data			(ArvGc *genicam, guint16 event_id);
+
+gboolean	arv_gc_memo_is_valid			(ArvGc *genicam, ArvGcFeatureNode *node, ArvGcMemo *memo);
+void		arv_gc_memo_begin			(ArvGc *genicam, ArvGcFeatureNode *node, ArvGcMemo *memo);
+void		arv_gc_memo_end				(ArvGc *genicam, ArvGcMemo *memo);
+
+G_END_DECLS
+
+#endif
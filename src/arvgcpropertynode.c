@@ -33,7 +33,7 @@
 #include <arvgcinteger.h>
 #include <arvgcfloat.h>
 #include <arvgcstring.h>
-#include <arvgc.h>
+#include <arvgcprivate.h>
 #include <arvdomtext.h>
 #include <arvmisc.h>
 #include <arvdebug.h>
@@ -52,8 +52,12 @@ typedef struct {
 
 	char *name;
 
+	GMutex mutex;		/* Protects the value data cache and the linked node */
 	gboolean value_data_up_to_date;
 	char *value_data;
+
+	ArvGcNode *linked_node;
+	guint linked_node_generation;
 } ArvGcPropertyNodePrivate;
 
 G_DEFINE_TYPE_WITH_CODE (ArvGcPropertyNode, arv_gc_property_node, ARV_TYPE_GC_NODE, G_ADD_PRIVATE (ArvGcPropertyNode))
@@ -178,7 +182,10 @@ _post_new_child (ArvDomNode *parent, ArvDomNode *child)
 {
 	ArvGcPropertyNodePrivate *priv = arv_gc_property_node_get_instance_private (ARV_GC_PROPERTY_NODE (parent));
 
+	g_mutex_lock (&priv->mutex);
 	priv->value_data_up_to_date = FALSE;
+	priv->linked_node = NULL;
+	g_mutex_unlock (&priv->mutex);
 }
 
 static void
@@ -186,7 +193,10 @@ _pre_remove_child (ArvDomNode *parent, ArvDomNode *child)
 {
 	ArvGcPropertyNodePrivate *priv = arv_gc_property_node_get_instance_private (ARV_GC_PROPERTY_NODE (parent));
 
+	g_mutex_lock (&priv->mutex);
 	priv->value_data_up_to_date = FALSE;
+	priv->linked_node = NULL;
+	g_mutex_unlock (&priv->mutex);
 }
 
 /* ArvDomElement implementation */
@@ -218,8 +228,12 @@ arv_gc_property_node_get_attribute (ArvDomElement *self, const char *name)
 
 /* ArvGcPropertyNode implementation */
 
+/* The value data cache is protected by the per node mutex. It is freed on each write of the property, which means
+ * the raw pointer must never escape the lock: numerical values are parsed and strings compared while holding it, and
+ * _dup_value_data and _intern_value_data return copies. */
+
 static const char *
-_get_value_data (ArvGcPropertyNode *property_node)
+_update_value_data (ArvGcPropertyNode *property_node)
 {
 	ArvGcPropertyNodePrivate *priv = arv_gc_property_node_get_instance_private (property_node);
 	ArvDomNode *dom_node = ARV_DOM_NODE (property_node);
@@ -233,20 +247,89 @@ _get_value_data (ArvGcPropertyNode *property_node)
 		     iter = arv_dom_node_get_next_sibling (iter))
 			g_string_append (string, arv_dom_character_data_get_data (ARV_DOM_CHARACTER_DATA (iter)));
 		g_free (priv->value_data);
-		priv->value_data = string->str;
-		g_string_free (string, FALSE);
+		priv->value_data = g_string_free (string, FALSE);
 		priv->value_data_up_to_date = TRUE;
 	}
 
 	return priv->value_data;
 }
 
+static char *
+_dup_value_data (ArvGcPropertyNode *property_node)
+{
+	ArvGcPropertyNodePrivate *priv = arv_gc_property_node_get_instance_private (property_node);
+	char *value_data;
+
+	g_mutex_lock (&priv->mutex);
+	value_data = g_strdup (_update_value_data (property_node));
+	g_mutex_unlock (&priv->mutex);
+
+	return value_data;
+}
+
+/* Property values are mostly constant strings from the description file (formulas, units, tooltips...), interning
+ * them keeps the set of leaked strings bounded while giving the caller a pointer that survives a concurrent write. */
+
+static const char *
+_intern_value_data (ArvGcPropertyNode *property_node)
+{
+	ArvGcPropertyNodePrivate *priv = arv_gc_property_node_get_instance_private (property_node);
+	const char *value_data;
+
+	g_mutex_lock (&priv->mutex);
+	value_data = g_intern_string (_update_value_data (property_node));
+	g_mutex_unlock (&priv->mutex);
+
+	return value_data;
+}
+
+static gboolean
+_value_data_equal (ArvGcPropertyNode *property_node, const char *string)
+{
+	ArvGcPropertyNodePrivate *priv = arv_gc_property_node_get_instance_private (property_node);
+	gboolean is_equal;
+
+	g_mutex_lock (&priv->mutex);
+	is_equal = g_strcmp0 (_update_value_data (property_node), string) == 0;
+	g_mutex_unlock (&priv->mutex);
+
+	return is_equal;
+}
+
+static gint64
+_get_value_data_int64 (ArvGcPropertyNode *property_node, guint base)
+{
+	ArvGcPropertyNodePrivate *priv = arv_gc_property_node_get_instance_private (property_node);
+	gint64 value;
+
+	g_mutex_lock (&priv->mutex);
+	value = g_ascii_strtoll (_update_value_data (property_node), NULL, base);
+	g_mutex_unlock (&priv->mutex);
+
+	return value;
+}
+
+static double
+_get_value_data_double (ArvGcPropertyNode *property_node)
+{
+	ArvGcPropertyNodePrivate *priv = arv_gc_property_node_get_instance_private (property_node);
+	double value;
+
+	g_mutex_lock (&priv->mutex);
+	value = g_ascii_strtod (_update_value_data (property_node), NULL);
+	g_mutex_unlock (&priv->mutex);
+
+	return value;
+}
+
 static void
 _set_value_data (ArvGcPropertyNode *property_node, const char *data)
 {
 	ArvGcPropertyNodePrivate *priv = arv_gc_property_node_get_instance_private (property_node);
 	ArvDomNode *dom_node = ARV_DOM_NODE (property_node);
 
+	g_mutex_lock (&priv->mutex);
+
 	if (arv_dom_node_get_first_child (dom_node) != NULL) {
 		ArvDomNode *iter;
 
@@ -260,23 +343,53 @@ _set_value_data (ArvGcPropertyNode *property_node, const char *data)
 	g_free (priv->value_data);
 	priv->value_data = g_strdup (data);
 	priv->value_data_up_to_date = TRUE;
+	priv->linked_node = NULL;
+
+	g_mutex_unlock (&priv->mutex);
 }
 
-static ArvDomNode *
-_get_pvalue_node (ArvGcPropertyNode *property_node)
+/* The node pointed by a pValue like property is resolved once, and kept until the genicam node table changes */
+
+static ArvGcNode *
+_get_linked_node (ArvGcPropertyNode *property_node)
 {
-	ArvDomNode *pvalue_node;
-	const char *node_name;
+	ArvGcPropertyNodePrivate *priv = arv_gc_property_node_get_instance_private (property_node);
+	ArvGcNode *linked_node;
 	ArvGc *genicam;
+	char *name;
+	guint generation;
+
+	genicam = arv_gc_node_get_genicam (ARV_GC_NODE (property_node));
+	generation = arv_gc_get_nodes_generation (genicam);
+
+	g_mutex_lock (&priv->mutex);
+	linked_node = priv->linked_node_generation == generation ? priv->linked_node : NULL;
+	g_mutex_unlock (&priv->mutex);
 
+	if (linked_node != NULL)
+		return linked_node;
+
+	name = _dup_value_data (property_node);
+	linked_node = arv_gc_get_node (genicam, name);
+	g_free (name);
+
+	if (linked_node != NULL) {
+		g_mutex_lock (&priv->mutex);
+		priv->linked_node = linked_node;
+		priv->linked_node_generation = generation;
+		g_mutex_unlock (&priv->mutex);
+	}
+
+	return linked_node;
+}
+
+static ArvDomNode *
+_get_pvalue_node (ArvGcPropertyNode *property_node)
+{
 	if (arv_gc_property_node_get_node_type (property_node) < ARV_GC_PROPERTY_NODE_TYPE_P_UNKNONW)
 		return NULL;
 
-	node_name = _get_value_data (property_node);
-	genicam = arv_gc_node_get_genicam (ARV_GC_NODE (property_node));
-	pvalue_node = ARV_DOM_NODE (arv_gc_get_node (genicam, node_name));
-
-	return pvalue_node;
+	return ARV_DOM_NODE (_get_linked_node (property_node));
 }
 
 /**
@@ -308,7 +421,7 @@ arv_gc_property_node_get_string (ArvGcPropertyNode *node, GError **error)
 
 	pvalue_node = _get_pvalue_node (node);
 	if (pvalue_node == NULL)
-		return _get_value_data (node);
+		return _intern_value_data (node);
 
 	if (ARV_IS_GC_STRING (pvalue_node)) {
 		GError *local_error = NULL;
@@ -367,7 +480,7 @@ arv_gc_property_node_get_int64 (ArvGcPropertyNode *node, GError **error)
 
 	pvalue_node = _get_pvalue_node (node);
 	if (pvalue_node == NULL)
-		return g_ascii_strtoll (_get_value_data (node), NULL, 0);
+		return _get_value_data_int64 (node, 0);
 
 	if (ARV_IS_GC_INTEGER (pvalue_node)) {
 		GError *local_error = NULL;
@@ -430,7 +543,7 @@ arv_gc_property_node_get_double (ArvGcPropertyNode *node, GError **error)
 
 	pvalue_node = _get_pvalue_node (node);
 	if (pvalue_node == NULL)
-		return g_ascii_strtod (_get_value_data (node), NULL);
+		return _get_value_data_double (node);
 
 
 	if (ARV_IS_GC_FLOAT (pvalue_node)) {
@@ -494,15 +607,12 @@ arv_gc_property_node_get_node_type (ArvGcPropertyNode *node)
 ArvGcNode *
 arv_gc_property_node_get_linked_node (ArvGcPropertyNode *node)
 {
-	ArvGc *genicam;
-
 	g_return_val_if_fail (ARV_IS_GC_PROPERTY_NODE (node), NULL);
 
 	if (arv_gc_property_node_get_node_type (node) <= ARV_GC_PROPERTY_NODE_TYPE_P_UNKNONW)
 		return NULL;
 
-	genicam = arv_gc_node_get_genicam (ARV_GC_NODE (node));
-	return arv_gc_get_node (genicam, _get_value_data (node));
+	return _get_linked_node (node);
 }
 
 static ArvGcNode *
@@ -719,7 +829,6 @@ ArvGcAccessMode
 arv_gc_property_node_get_access_mode (ArvGcPropertyNode *self, ArvGcAccessMode default_value)
 {
 	ArvGcPropertyNodePrivate *priv = arv_gc_property_node_get_instance_private (self);
-	const char *value;
 
 	if (self == NULL)
 		return default_value;
@@ -728,11 +837,9 @@ arv_gc_property_node_get_access_mode (ArvGcPropertyNode *self, ArvGcAccessMode d
 	g_return_val_if_fail (priv->type == ARV_GC_PROPERTY_NODE_TYPE_ACCESS_MODE ||
 			      priv->type == ARV_GC_PROPERTY_NODE_TYPE_IMPOSED_ACCESS_MODE, default_value);
 
-	value = _get_value_data (self);
-
-	if (g_strcmp0 (value, "RO") == 0)
+	if (_value_data_equal (self, "RO"))
 		return ARV_GC_ACCESS_MODE_RO;
-	else if (g_strcmp0 (value, "WO") == 0)
+	else if (_value_data_equal (self, "WO"))
 		return ARV_GC_ACCESS_MODE_WO;
 
 	return ARV_GC_ACCESS_MODE_RW;
@@ -748,7 +855,6 @@ ArvGcCachable
 arv_gc_property_node_get_cachable (ArvGcPropertyNode *self, ArvGcCachable default_value)
 {
 	ArvGcPropertyNodePrivate *priv = arv_gc_property_node_get_instance_private (self);
-	const char *value;
 
 	if (self == NULL)
 		return default_value;
@@ -756,11 +862,9 @@ arv_gc_property_node_get_cachable (ArvGcPropertyNode *self, ArvGcCachable defaul
 	g_return_val_if_fail (ARV_IS_GC_PROPERTY_NODE (self), default_value);
 	g_return_val_if_fail (priv->type == ARV_GC_PROPERTY_NODE_TYPE_CACHABLE, default_value);
 
-	value = _get_value_data (self);
-
-	if (g_strcmp0 (value, "WriteAround") == 0)
+	if (_value_data_equal (self, "WriteAround"))
 		return ARV_GC_CACHABLE_WRITE_AROUND;
-	else if (g_strcmp0 (value, "WriteThrough") == 0)
+	else if (_value_data_equal (self, "WriteThrough"))
 		return ARV_GC_CACHABLE_WRITE_THROUGH;
 
 	return ARV_GC_CACHABLE_NO_CACHE;
@@ -789,7 +893,7 @@ arv_gc_property_node_get_endianess (ArvGcPropertyNode *self, guint default_value
 	g_return_val_if_fail (ARV_IS_GC_PROPERTY_NODE (self), default_value);
 	g_return_val_if_fail (priv->type == ARV_GC_PROPERTY_NODE_TYPE_ENDIANESS, default_value);
 
-	if (g_strcmp0 (_get_value_data (self), "BigEndian") == 0)
+	if (_value_data_equal (self, "BigEndian"))
 		return G_BIG_ENDIAN;
 
 	return G_LITTLE_ENDIAN;
@@ -812,7 +916,7 @@ arv_gc_property_node_get_sign (ArvGcPropertyNode *self, ArvGcSignedness default_
 	g_return_val_if_fail (ARV_IS_GC_PROPERTY_NODE (self), default_value);
 	g_return_val_if_fail (priv->type == ARV_GC_PROPERTY_NODE_TYPE_SIGN, default_value);
 
-	if (g_strcmp0 (_get_value_data (self), "Unsigned") == 0)
+	if (_value_data_equal (self, "Unsigned"))
 		return ARV_GC_SIGNEDNESS_UNSIGNED;
 
 	return ARV_GC_SIGNEDNESS_SIGNED;
@@ -836,7 +940,7 @@ arv_gc_property_node_get_lsb (ArvGcPropertyNode *self, guint default_value)
 	g_return_val_if_fail (priv->type == ARV_GC_PROPERTY_NODE_TYPE_LSB ||
 			      priv->type == ARV_GC_PROPERTY_NODE_TYPE_BIT, default_value);
 
-	return g_ascii_strtoll (_get_value_data (self), NULL, 10);
+	return _get_value_data_int64 (self, 10);
 }
 
 ArvGcNode *
@@ -857,7 +961,7 @@ arv_gc_property_node_get_msb (ArvGcPropertyNode *self, guint default_value)
 	g_return_val_if_fail (priv->type == ARV_GC_PROPERTY_NODE_TYPE_MSB ||
 			      priv->type == ARV_GC_PROPERTY_NODE_TYPE_BIT, default_value);
 
-	return g_ascii_strtoll (_get_value_data (self), NULL, 10);
+	return _get_value_data_int64 (self, 10);
 }
 
 ArvGcNode *
@@ -937,9 +1041,11 @@ arv_gc_property_node_init (ArvGcPropertyNode *self)
 {
 	ArvGcPropertyNodePrivate *priv = arv_gc_property_node_get_instance_private (self);
 
+	g_mutex_init (&priv->mutex);
 	priv->type = ARV_GC_PROPERTY_NODE_TYPE_UNKNOWN;
 	priv->value_data = NULL;
 	priv->value_data_up_to_date = FALSE;
+	priv->linked_node = NULL;
 }
 
 static void
@@ -951,6 +1057,7 @@ arv_gc_property_node_finalize (GObject *object)
 
 	g_free (priv->value_data);
 	g_free (priv->name);
+	g_mutex_clear (&priv->mutex);
 }
 
 static void
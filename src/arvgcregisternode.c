@@ -25,9 +25,8 @@
  * @short_description: Class for Register nodes
  */
 
-#include <arvgcregisternode.h>
+#include <arvgcregisternodeprivate.h>
 #include <arvgcindexnode.h>
-#include <arvgcinvalidatornode.h>
 #include <arvgcfeaturenodeprivate.h>
 #include <arvgcswissknife.h>
 #include <arvgcregister.h>
@@ -36,7 +35,7 @@
 #include <arvgcfloat.h>
 #include <arvgcstring.h>
 #include <arvgcport.h>
-#include <arvgc.h>
+#include <arvgcprivate.h>
 #include <arvmisc.h>
 #include <arvdebug.h>
 #include <stdlib.h>
@@ -72,6 +71,12 @@ arv_gc_cache_key_new (gint64 address, gint64 length)
 	return key;
 }
 
+typedef enum {
+	ARV_GC_REGISTER_NODE_LOCATION_UNKNOWN,
+	ARV_GC_REGISTER_NODE_LOCATION_STATIC,
+	ARV_GC_REGISTER_NODE_LOCATION_DYNAMIC
+} ArvGcRegisterNodeLocation;
+
 typedef struct {
 	GSList *addresses;
 	GSList *swiss_knives;
@@ -82,9 +87,16 @@ typedef struct {
 	ArvGcPropertyNode *polling_time;
 	ArvGcPropertyNode *endianess;
 
-	GSList *invalidators;		/* #ArvGcPropertyNode */
+	GRecMutex cache_mutex;		/* Protects the cache data and state */
+
+	/* Address and length resolved once if they don't depend on other nodes */
+	ArvGcRegisterNodeLocation location;
+	gint64 static_address;
+	gint64 static_length;
+	void *static_cache;
 
 	gboolean cached;
+	guint64 cached_change_count;
 	GHashTable *caches;
 	guint n_cache_hits;
 	guint n_cache_misses;
@@ -111,6 +123,8 @@ arv_gc_register_node_post_new_child (ArvDomNode *self, ArvDomNode *child)
 {
 	ArvGcRegisterNodePrivate *priv = arv_gc_register_node_get_instance_private (ARV_GC_REGISTER_NODE (self));
 
+	priv->location = ARV_GC_REGISTER_NODE_LOCATION_UNKNOWN;
+
 	if (ARV_IS_GC_PROPERTY_NODE (child)) {
 		ArvGcPropertyNode *property_node = ARV_GC_PROPERTY_NODE (child);
 
@@ -140,7 +154,7 @@ arv_gc_register_node_post_new_child (ArvDomNode *self, ArvDomNode *child)
 				priv->endianess = property_node;
 				break;
 			case ARV_GC_PROPERTY_NODE_TYPE_P_INVALIDATOR:
-				priv->invalidators = g_slist_prepend (priv->invalidators, property_node);
+				/* Handled by the genicam dependency graph */
 				break;
 			default:
 				ARV_DOM_NODE_CLASS (arv_gc_register_node_parent_class)->post_new_child (self, child);
@@ -243,8 +257,7 @@ _get_cached (ArvGcRegisterNode *self, ArvRegisterCachePolicy *cache_policy)
 {
 	ArvGcRegisterNodePrivate *priv = arv_gc_register_node_get_instance_private (ARV_GC_REGISTER_NODE (self));
 	ArvGc *genicam;
-	GSList *iter;
-	gboolean cached = priv->cached;
+	gboolean cached;
 
 	*cache_policy = ARV_REGISTER_CACHE_POLICY_DISABLE;
 
@@ -256,19 +269,70 @@ _get_cached (ArvGcRegisterNode *self, ArvRegisterCachePolicy *cache_policy)
 	if (*cache_policy == ARV_REGISTER_CACHE_POLICY_DISABLE)
 		return FALSE;
 
-	for (iter = priv->invalidators; iter != NULL; iter = iter->next) {
-		if (arv_gc_invalidator_has_changed (iter->data))
-			cached = FALSE;
-	}
+	/* Writes to any node this register depends on (including pInvalidator
+	 * links) increment its change count through the genicam dependency graph */
+	cached = priv->cached &&
+		priv->cached_change_count == arv_gc_feature_node_get_change_count (ARV_GC_FEATURE_NODE (self));
 
 	if (cached)
 		priv->n_cache_hits++;
 	else
 		priv->n_cache_misses++;
 
+	arv_gc_update_cache_statistics (genicam, cached);
+
 	return cached;
 }
 
+static void
+_set_cached (ArvGcRegisterNode *self, gboolean cached)
+{
+	ArvGcRegisterNodePrivate *priv = arv_gc_register_node_get_instance_private (ARV_GC_REGISTER_NODE (self));
+
+	priv->cached = cached;
+	priv->cached_change_count = arv_gc_feature_node_get_change_count (ARV_GC_FEATURE_NODE (self));
+}
+
+static gboolean
+_is_location_static (ArvGcRegisterNode *self)
+{
+	ArvGcRegisterNodePrivate *priv = arv_gc_register_node_get_instance_private (ARV_GC_REGISTER_NODE (self));
+	GError *local_error = NULL;
+	GSList *iter;
+
+	if (priv->location != ARV_GC_REGISTER_NODE_LOCATION_UNKNOWN)
+		return priv->location == ARV_GC_REGISTER_NODE_LOCATION_STATIC;
+
+	priv->location = ARV_GC_REGISTER_NODE_LOCATION_DYNAMIC;
+
+	if (priv->swiss_knives != NULL || priv->index != NULL)
+		return FALSE;
+	if (priv->length != NULL &&
+	    arv_gc_property_node_get_node_type (priv->length) != ARV_GC_PROPERTY_NODE_TYPE_LENGTH)
+		return FALSE;
+	for (iter = priv->addresses; iter != NULL; iter = iter->next)
+		if (arv_gc_property_node_get_node_type (iter->data) != ARV_GC_PROPERTY_NODE_TYPE_ADDRESS)
+			return FALSE;
+
+	priv->static_address = _get_address (self, &local_error);
+	if (local_error == NULL)
+		priv->static_length = _get_length (self, &local_error);
+
+	if (local_error != NULL) {
+		g_clear_error (&local_error);
+		return FALSE;
+	}
+
+	priv->static_cache = g_malloc0 (priv->static_length);
+	g_hash_table_replace (priv->caches,
+			      arv_gc_cache_key_new (priv->static_address, priv->static_length),
+			      priv->static_cache);
+
+	priv->location = ARV_GC_REGISTER_NODE_LOCATION_STATIC;
+
+	return TRUE;
+}
+
 static void *
 _get_cache (ArvGcRegisterNode *self, gint64 *address, gint64 *length, GError **error)
 {
@@ -277,6 +341,15 @@ _get_cache (ArvGcRegisterNode *self, gint64 *address, gint64 *length, GError **e
 	ArvGcCacheKey key;
 	void *cache;
 
+	if (_is_location_static (self)) {
+		if (address != NULL)
+			*address = priv->static_address;
+		if (length != NULL)
+			*length = priv->static_length;
+
+		return priv->static_cache;
+	}
+
 	key.address = _get_address (self, &local_error);
 	if (local_error == NULL)
 		key.length = _get_length (self, &local_error);
@@ -327,9 +400,13 @@ _read_from_port (ArvGcRegisterNode *self, gint64 address, gint64 length, void *b
 		memcpy (cache, buffer, length);
 	}
 
-	if (!cached || cache_policy == ARV_REGISTER_CACHE_POLICY_DEBUG)
+	if (!cached || cache_policy == ARV_REGISTER_CACHE_POLICY_DEBUG) {
 		arv_gc_port_read (ARV_GC_PORT (port), buffer, address, length, &local_error);
 
+		if (cachable == ARV_GC_CACHABLE_NO_CACHE)
+			arv_gc_increment_uncached_read_count (arv_gc_node_get_genicam (ARV_GC_NODE (self)));
+	}
+
 	if (local_error != NULL) {
 		g_propagate_error (error, local_error);
 		priv->cached = FALSE;
@@ -344,10 +421,7 @@ _read_from_port (ArvGcRegisterNode *self, gint64 address, gint64 length, void *b
 		g_free (cache);
 	}
 
-	if (cachable != ARV_GC_CACHABLE_NO_CACHE)
-		priv->cached = TRUE;
-	else
-		priv->cached = FALSE;
+	_set_cached (self, cachable != ARV_GC_CACHABLE_NO_CACHE);
 }
 
 static void
@@ -375,10 +449,7 @@ _write_to_port (ArvGcRegisterNode *self, gint64 address, gint64 length, void *bu
 		return;
 	}
 
-	if (cachable == ARV_GC_CACHABLE_WRITE_THROUGH)
-		priv->cached = TRUE;
-	else
-		priv->cached = FALSE;
+	_set_cached (self, cachable == ARV_GC_CACHABLE_WRITE_THROUGH);
 }
 
 ArvGcNode *
@@ -392,6 +463,8 @@ arv_gc_register_node_init (ArvGcRegisterNode *self)
 {
 	ArvGcRegisterNodePrivate *priv = arv_gc_register_node_get_instance_private (ARV_GC_REGISTER_NODE (self));
 
+	g_rec_mutex_init (&priv->cache_mutex);
+	priv->location = ARV_GC_REGISTER_NODE_LOCATION_UNKNOWN;
 	priv->cached = FALSE;
 	priv->caches = g_hash_table_new_full (arv_gc_cache_key_hash, arv_gc_cache_key_equal, g_free, g_free);
 	priv->n_cache_hits = 0;
@@ -405,8 +478,8 @@ arv_gc_register_node_finalize (GObject *self)
 
 	g_slist_free (priv->addresses);
 	g_slist_free (priv->swiss_knives);
-	g_slist_free (priv->invalidators);
 	g_clear_pointer (&priv->caches, g_hash_table_unref);
+	g_rec_mutex_clear (&priv->cache_mutex);
 
 	if (priv->n_cache_hits > 0 || priv->n_cache_misses > 0) {
 		const char *name = arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (self));
@@ -440,9 +513,8 @@ arv_gc_register_node_class_init (ArvGcRegisterNodeClass *this_class)
 /* ArvGcRegister interface implementation */
 
 static void
-arv_gc_register_node_get (ArvGcRegister *gc_register, void *buffer, guint64 length, GError **error)
+_get (ArvGcRegisterNode *gc_register_node, void *buffer, guint64 length, GError **error)
 {
-	ArvGcRegisterNode *gc_register_node = ARV_GC_REGISTER_NODE (gc_register);
 	GError *local_error = NULL;
 	void *cache;
 	gint64 address;
@@ -476,9 +548,18 @@ arv_gc_register_node_get (ArvGcRegister *gc_register, void *buffer, guint64 leng
 }
 
 static void
-arv_gc_register_node_set (ArvGcRegister *gc_register, const void *buffer, guint64 length, GError **error)
+arv_gc_register_node_get (ArvGcRegister *gc_register, void *buffer, guint64 length, GError **error)
+{
+	ArvGcRegisterNodePrivate *priv = arv_gc_register_node_get_instance_private (ARV_GC_REGISTER_NODE (gc_register));
+
+	g_rec_mutex_lock (&priv->cache_mutex);
+	_get (ARV_GC_REGISTER_NODE (gc_register), buffer, length, error);
+	g_rec_mutex_unlock (&priv->cache_mutex);
+}
+
+static void
+_set (ArvGcRegisterNode *gc_register_node, const void *buffer, guint64 length, GError **error)
 {
-	ArvGcRegisterNode *gc_register_node = ARV_GC_REGISTER_NODE (gc_register);
 	GError *local_error = NULL;
 	void *cache;
 	gint64 address;
@@ -512,10 +593,24 @@ arv_gc_register_node_set (ArvGcRegister *gc_register, const void *buffer, guint6
 	arv_log_genicam ("[GcRegisterNode::set] 0x%Lx,%Ld", address, length);
 }
 
+static void
+arv_gc_register_node_set (ArvGcRegister *gc_register, const void *buffer, guint64 length, GError **error)
+{
+	ArvGcRegisterNodePrivate *priv = arv_gc_register_node_get_instance_private (ARV_GC_REGISTER_NODE (gc_register));
+
+	g_rec_mutex_lock (&priv->cache_mutex);
+	_set (ARV_GC_REGISTER_NODE (gc_register), buffer, length, error);
+	g_rec_mutex_unlock (&priv->cache_mutex);
+}
+
 static guint64
 arv_gc_register_node_get_address (ArvGcRegister *gc_register, GError **error)
 {
 	ArvGcRegisterNode *gc_register_node = ARV_GC_REGISTER_NODE (gc_register);
+	guint64 address;
+
+	if (arv_gc_register_node_get_static_location (gc_register_node, &address, NULL))
+		return address;
 
 	return _get_address (gc_register_node, error);
 }
@@ -524,10 +619,63 @@ static guint64
 arv_gc_register_node_get_length (ArvGcRegister *gc_register, GError **error)
 {
 	ArvGcRegisterNode *gc_register_node = ARV_GC_REGISTER_NODE (gc_register);
+	guint64 length;
+
+	if (arv_gc_register_node_get_static_location (gc_register_node, NULL, &length))
+		return length;
 
 	return _get_length (gc_register_node, error);
 }
 
+/* Retrieves the register location, if it does not depend on the value of other nodes (pAddress, pIndex, IntSwissKnife
+ * or pLength). Returns FALSE otherwise. */
+
+gboolean
+arv_gc_register_node_get_static_location (ArvGcRegisterNode *gc_register_node, guint64 *address, guint64 *length)
+{
+	ArvGcRegisterNodePrivate *priv = arv_gc_register_node_get_instance_private (gc_register_node);
+	gboolean is_static;
+
+	g_return_val_if_fail (ARV_IS_GC_REGISTER_NODE (gc_register_node), FALSE);
+
+	g_rec_mutex_lock (&priv->cache_mutex);
+
+	is_static = _is_location_static (gc_register_node);
+	if (is_static) {
+		if (address != NULL)
+			*address = priv->static_address;
+		if (length != NULL)
+			*length = priv->static_length;
+	}
+
+	g_rec_mutex_unlock (&priv->cache_mutex);
+
+	return is_static;
+}
+
+/* Port and cachable mode, for the direct register access of #ArvFeatureHandle */
+
+ArvGcPort *
+arv_gc_register_node_get_port (ArvGcRegisterNode *gc_register_node)
+{
+	ArvGcRegisterNodePrivate *priv = arv_gc_register_node_get_instance_private (gc_register_node);
+	ArvGcNode *port;
+
+	g_return_val_if_fail (ARV_IS_GC_REGISTER_NODE (gc_register_node), NULL);
+
+	port = arv_gc_property_node_get_linked_node (priv->port);
+
+	return ARV_IS_GC_PORT (port) ? ARV_GC_PORT (port) : NULL;
+}
+
+ArvGcCachable
+arv_gc_register_node_get_cachable (ArvGcRegisterNode *gc_register_node)
+{
+	g_return_val_if_fail (ARV_IS_GC_REGISTER_NODE (gc_register_node), ARV_GC_CACHABLE_NO_CACHE);
+
+	return _get_cachable (gc_register_node);
+}
+
 static void
 arv_gc_register_node_register_interface_init (ArvGcRegisterInterface *interface)
 {
@@ -614,6 +762,9 @@ arv_gc_register_node_get_masked_integer_value (ArvGcRegisterNode *self,
 					       ArvGcCachable cachable,
 					       gboolean is_masked, GError **error)
 {
+	ArvGcRegisterNodePrivate *priv = arv_gc_register_node_get_instance_private (self);
+	gint64 value;
+
 	g_return_val_if_fail (ARV_IS_GC_REGISTER_NODE (self), 0);
 	g_return_val_if_fail (error == NULL || *error == NULL, 0);
 
@@ -623,7 +774,11 @@ arv_gc_register_node_get_masked_integer_value (ArvGcRegisterNode *self,
 	if (endianess == 0)
 		endianess = _get_endianess (self);
 
-	return _get_integer_value (self, lsb, msb, signedness, endianess, cachable, is_masked, error);
+	g_rec_mutex_lock (&priv->cache_mutex);
+	value = _get_integer_value (self, lsb, msb, signedness, endianess, cachable, is_masked, error);
+	g_rec_mutex_unlock (&priv->cache_mutex);
+
+	return value;
 }
 
 static void
@@ -703,6 +858,8 @@ arv_gc_register_node_set_masked_integer_value (ArvGcRegisterNode *self,
 					       gboolean is_masked,
 					       gint64 value, GError **error)
 {
+	ArvGcRegisterNodePrivate *priv = arv_gc_register_node_get_instance_private (self);
+
 	g_return_if_fail (ARV_IS_GC_REGISTER_NODE (self));
 	g_return_if_fail (error == NULL || *error == NULL);
 
@@ -712,5 +869,7 @@ arv_gc_register_node_set_masked_integer_value (ArvGcRegisterNode *self,
 	if (endianess == 0)
 		endianess = _get_endianess (self);
 
+	g_rec_mutex_lock (&priv->cache_mutex);
 	_set_integer_value (self, lsb, msb, signedness, endianess, cachable, is_masked, value, error);
+	g_rec_mutex_unlock (&priv->cache_mutex);
 }
@@ -25,6 +25,11 @@
 
 #include <arvgcregisternode.h>
 
+gboolean	arv_gc_register_node_get_static_location	(ArvGcRegisterNode *gc_register_node,
+								 guint64 *address, guint64 *length);
+ArvGcPort *	arv_gc_register_node_get_port			(ArvGcRegisterNode *gc_register_node);
+ArvGcCachable	arv_gc_register_node_get_cachable		(ArvGcRegisterNode *gc_register_node);
+
 gint64 		arv_gc_register_node_get_masked_integer_value 	(ArvGcRegisterNode *gc_register_node,
 								 guint lsb, guint msb,
 								 ArvGcSignedness signedness, guint endianess,
@@ -30,7 +30,7 @@
 #include <arvgcinteger.h>
 #include <arvgcfloat.h>
 #include <arvgcport.h>
-#include <arvgc.h>
+#include <arvgcprivate.h>
 #include <arvdebug.h>
 #include <string.h>
 
@@ -42,7 +42,13 @@ typedef struct {
 
 	ArvGcPropertyNode *formula_node;
 
+	GRecMutex mutex;	/* Protects the evaluator and memoized values */
 	ArvEvaluator *formula;
+
+	ArvGcMemo int64_memo;
+	gint64 int64_value;
+	ArvGcMemo double_memo;
+	double double_value;
 } ArvGcSwissKnifePrivate;
 
 G_DEFINE_ABSTRACT_TYPE_WITH_CODE (ArvGcSwissKnife, arv_gc_swiss_knife, ARV_TYPE_GC_FEATURE_NODE, G_ADD_PRIVATE (ArvGcSwissKnife))
@@ -90,6 +96,7 @@ arv_gc_swiss_knife_init (ArvGcSwissKnife *self)
 {
 	ArvGcSwissKnifePrivate *priv = arv_gc_swiss_knife_get_instance_private (self);
 
+	g_rec_mutex_init (&priv->mutex);
 	priv->formula = arv_evaluator_new (NULL);
 }
 
@@ -103,6 +110,7 @@ arv_gc_swiss_knife_finalize (GObject *object)
 	g_slist_free (priv->constants);
 
 	g_clear_object (&priv->formula);
+	g_rec_mutex_clear (&priv->mutex);
 
 	G_OBJECT_CLASS (arv_gc_swiss_knife_parent_class)->finalize (object);
 }
@@ -210,17 +218,40 @@ arv_gc_swiss_knife_get_integer_value (ArvGcSwissKnife *self, GError **error)
 {
 	ArvGcSwissKnifePrivate *priv = arv_gc_swiss_knife_get_instance_private (self);
 	GError *local_error = NULL;
+	ArvGc *genicam;
+	gint64 value;
 
 	g_return_val_if_fail (ARV_IS_GC_SWISS_KNIFE (self), 0);
 
+	genicam = arv_gc_node_get_genicam (ARV_GC_NODE (self));
+
+	g_rec_mutex_lock (&priv->mutex);
+
+	if (arv_gc_memo_is_valid (genicam, ARV_GC_FEATURE_NODE (self), &priv->int64_memo)) {
+		value = priv->int64_value;
+		g_rec_mutex_unlock (&priv->mutex);
+		return value;
+	}
+
+	arv_gc_memo_begin (genicam, ARV_GC_FEATURE_NODE (self), &priv->int64_memo);
+
 	_update_variables (self, &local_error);
 
 	if (local_error != NULL) {
+		g_rec_mutex_unlock (&priv->mutex);
 		g_propagate_error (error, local_error);
 		return 0;
 	}
 
-	return arv_evaluator_evaluate_as_int64 (priv->formula, NULL);
+	priv->int64_value = arv_evaluator_evaluate_as_int64 (priv->formula, NULL);
+
+	arv_gc_memo_end (genicam, &priv->int64_memo);
+
+	value = priv->int64_value;
+
+	g_rec_mutex_unlock (&priv->mutex);
+
+	return value;
 }
 
 double
@@ -228,15 +259,38 @@ arv_gc_swiss_knife_get_float_value (ArvGcSwissKnife *self, GError **error)
 {
 	ArvGcSwissKnifePrivate *priv = arv_gc_swiss_knife_get_instance_private (self);
 	GError *local_error = NULL;
+	ArvGc *genicam;
+	double value;
 
 	g_return_val_if_fail (ARV_IS_GC_SWISS_KNIFE (self), 0.0);
 
+	genicam = arv_gc_node_get_genicam (ARV_GC_NODE (self));
+
+	g_rec_mutex_lock (&priv->mutex);
+
+	if (arv_gc_memo_is_valid (genicam, ARV_GC_FEATURE_NODE (self), &priv->double_memo)) {
+		value = priv->double_value;
+		g_rec_mutex_unlock (&priv->mutex);
+		return value;
+	}
+
+	arv_gc_memo_begin (genicam, ARV_GC_FEATURE_NODE (self), &priv->double_memo);
+
 	_update_variables (self, &local_error);
 
 	if (local_error != NULL) {
+		g_rec_mutex_unlock (&priv->mutex);
 		g_propagate_error (error, local_error);
 		return 0.0;
 	}
 
-	return arv_evaluator_evaluate_as_double (priv->formula, NULL);
+	priv->double_value = arv_evaluator_evaluate_as_double (priv->formula, NULL);
+
+	arv_gc_memo_end (genicam, &priv->double_memo);
+
+	value = priv->double_value;
+
+	g_rec_mutex_unlock (&priv->mutex);
+
+	return value;
 }
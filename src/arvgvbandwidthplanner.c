@@ -0,0 +1,729 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2019 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel@gnome.org>
+ */
+
+/**
+ * SECTION: arvgvbandwidthplanner
+ * @short_description: Bandwidth planner for GigE Vision cameras sharing a link
+ *
+ * #ArvGvBandwidthPlanner computes the inter packet delays (GevSCPD) and the
+ * frame transmission delays (GevSCFTD) of a set of GigE Vision cameras
+ * streaming through a shared link, typically several cameras connected to a
+ * switch whose uplink is a single 10 GigE host interface.
+ *
+ * Without any flow control, a camera sends its frames at the wire speed of
+ * its own link. When several cameras transmit at the same time, the
+ * aggregated bursts exceed the link capacity, the switch buffers overflow
+ * and packets are dropped. The planner spreads the transmission of each frame
+ * over time, such that the aggregated bandwidth never exceeds a configurable
+ * fraction of the link capacity, the link budget.
+ *
+ * In %ARV_GV_BANDWIDTH_PLANNER_MODE_SHARED mode, all the cameras may transmit
+ * at the same time, each one at a rate proportional to its mean bandwidth.
+ * This works for free running cameras, whatever their frame rates.
+ *
+ * In %ARV_GV_BANDWIDTH_PLANNER_MODE_STAGGERED mode, the cameras are assumed
+ * to be triggered at the same time. Each one is given a time slot, using the
+ * frame transmission delay, during which it transmits at the full budget
+ * rate. The transmission of the last frame ends at the same time as in shared
+ * mode, but the other frames are received earlier.
+ *
+ * <informalexample>
+ * <programlisting>
+ * ArvGvBandwidthPlanner *planner;
+ *
+ * planner = arv_gv_bandwidth_planner_new (10000000000);
+ * arv_gv_bandwidth_planner_set_link_budget (planner, 0.9);
+ * arv_gv_bandwidth_planner_add_camera (planner, camera_a, NULL);
+ * arv_gv_bandwidth_planner_add_camera (planner, camera_b, NULL);
+ *
+ * if (arv_gv_bandwidth_planner_apply (planner, &error))
+ *         g_print ("Camera A uses %.1f%% of the link\n", 100.0 * arv_gv_bandwidth_planner_get_utilization (planner, 0));
+ * </programlisting>
+ * </informalexample>
+ */
+
+#include <arvgvbandwidthplanner.h>
+#include <arvgvspprivate.h>
+#include <arvcamera.h>
+#include <arvdebug.h>
+#include <math.h>
+
+#define ARV_GV_BANDWIDTH_PLANNER_DEFAULT_LINK_BUDGET		0.9
+/* Ethernet header, frame check sequence, preamble and inter frame gap, in bytes */
+#define ARV_GV_BANDWIDTH_PLANNER_ETHERNET_OVERHEAD		(14 + 4 + 8 + 12)
+/* Wire size of a minimum size Ethernet frame, used for the leader and trailer packets */
+#define ARV_GV_BANDWIDTH_PLANNER_MIN_FRAME_WIRE_SIZE		(64 + 8 + 12)
+/* Gap between two staggered time slots, in ns, absorbing the trigger and the readout jitter */
+#define ARV_GV_BANDWIDTH_PLANNER_SLOT_GUARD_NS			20000
+
+typedef struct {
+	ArvCamera *camera;
+
+	guint payload;
+	double frame_rate;
+	guint packet_size;
+	guint64 camera_link_speed;
+
+	/* Plan */
+	guint64 frame_bits;
+	double mean_rate;
+	double peak_rate;
+	gint64 packet_delay;
+	gint64 frame_transmission_delay;
+	gint64 frame_transmission_duration;
+} ArvGvBandwidthPlannerCamera;
+
+typedef struct {
+	GArray *cameras;
+
+	guint64 link_capacity;
+	double link_budget;
+	ArvGvBandwidthPlannerMode mode;
+
+	gboolean is_computed;
+} ArvGvBandwidthPlannerPrivate;
+
+struct _ArvGvBandwidthPlanner {
+	GObject	object;
+
+	ArvGvBandwidthPlannerPrivate *priv;
+};
+
+struct _ArvGvBandwidthPlannerClass {
+	GObjectClass parent_class;
+};
+
+G_DEFINE_TYPE_WITH_CODE (ArvGvBandwidthPlanner, arv_gv_bandwidth_planner, G_TYPE_OBJECT,
+			 G_ADD_PRIVATE (ArvGvBandwidthPlanner))
+
+GQuark
+arv_gv_bandwidth_planner_error_quark (void)
+{
+	return g_quark_from_static_string ("arv-gv-bandwidth-planner-error-quark");
+}
+
+static ArvGvBandwidthPlannerCamera *
+_get_camera (ArvGvBandwidthPlanner *planner, guint index)
+{
+	return &g_array_index (planner->priv->cameras, ArvGvBandwidthPlannerCamera, index);
+}
+
+/**
+ * arv_gv_bandwidth_planner_new:
+ * @link_capacity: capacity of the shared link, in bits per second
+ *
+ * Returns: a new #ArvGvBandwidthPlanner
+ *
+ * Since: 0.8.0
+ */
+
+ArvGvBandwidthPlanner *
+arv_gv_bandwidth_planner_new (guint64 link_capacity)
+{
+	ArvGvBandwidthPlanner *planner;
+
+	g_return_val_if_fail (link_capacity > 0, NULL);
+
+	planner = g_object_new (ARV_TYPE_GV_BANDWIDTH_PLANNER, NULL);
+	planner->priv->link_capacity = link_capacity;
+
+	return planner;
+}
+
+/**
+ * arv_gv_bandwidth_planner_get_link_capacity:
+ * @planner: a #ArvGvBandwidthPlanner
+ *
+ * Returns: the capacity of the shared link, in bits per second.
+ *
+ * Since: 0.8.0
+ */
+
+guint64
+arv_gv_bandwidth_planner_get_link_capacity (ArvGvBandwidthPlanner *planner)
+{
+	g_return_val_if_fail (ARV_IS_GV_BANDWIDTH_PLANNER (planner), 0);
+
+	return planner->priv->link_capacity;
+}
+
+/**
+ * arv_gv_bandwidth_planner_set_link_budget:
+ * @planner: a #ArvGvBandwidthPlanner
+ * @budget: fraction of the link capacity available for streaming, in the ]0,1] range
+ *
+ * Sets the maximum aggregated bandwidth of the camera streams, as a fraction
+ * of the link capacity. The remaining part is left for the control traffic
+ * and the packet resend requests. Default value is 0.9.
+ *
+ * Since: 0.8.0
+ */
+
+void
+arv_gv_bandwidth_planner_set_link_budget (ArvGvBandwidthPlanner *planner, double budget)
+{
+	g_return_if_fail (ARV_IS_GV_BANDWIDTH_PLANNER (planner));
+	g_return_if_fail (budget > 0.0 && budget <= 1.0);
+
+	planner->priv->link_budget = budget;
+	planner->priv->is_computed = FALSE;
+}
+
+/**
+ * arv_gv_bandwidth_planner_get_link_budget:
+ * @planner: a #ArvGvBandwidthPlanner
+ *
+ * Returns: the fraction of the link capacity available for streaming.
+ *
+ * Since: 0.8.0
+ */
+
+double
+arv_gv_bandwidth_planner_get_link_budget (ArvGvBandwidthPlanner *planner)
+{
+	g_return_val_if_fail (ARV_IS_GV_BANDWIDTH_PLANNER (planner), 0.0);
+
+	return planner->priv->link_budget;
+}
+
+/**
+ * arv_gv_bandwidth_planner_set_mode:
+ * @planner: a #ArvGvBandwidthPlanner
+ * @mode: planning mode
+ *
+ * Default mode is %ARV_GV_BANDWIDTH_PLANNER_MODE_SHARED.
+ *
+ * Since: 0.8.0
+ */
+
+void
+arv_gv_bandwidth_planner_set_mode (ArvGvBandwidthPlanner *planner, ArvGvBandwidthPlannerMode mode)
+{
+	g_return_if_fail (ARV_IS_GV_BANDWIDTH_PLANNER (planner));
+
+	planner->priv->mode = mode;
+	planner->priv->is_computed = FALSE;
+}
+
+/**
+ * arv_gv_bandwidth_planner_get_mode:
+ * @planner: a #ArvGvBandwidthPlanner
+ *
+ * Returns: the planning mode.
+ *
+ * Since: 0.8.0
+ */
+
+ArvGvBandwidthPlannerMode
+arv_gv_bandwidth_planner_get_mode (ArvGvBandwidthPlanner *planner)
+{
+	g_return_val_if_fail (ARV_IS_GV_BANDWIDTH_PLANNER (planner), ARV_GV_BANDWIDTH_PLANNER_MODE_SHARED);
+
+	return planner->priv->mode;
+}
+
+/**
+ * arv_gv_bandwidth_planner_add_camera_full:
+ * @planner: a #ArvGvBandwidthPlanner
+ * @camera: a GigE Vision #ArvCamera
+ * @payload: frame payload size, in bytes
+ * @frame_rate: frame rate, in frames per second
+ * @packet_size: stream packet size, in bytes, including the IP and UDP headers
+ * @camera_link_speed: speed of the camera network link, in bits per second, 0 if it is the shared link capacity
+ *
+ * Adds a camera to the plan, with explicit stream parameters. This is useful
+ * for planning a configuration before applying it to the cameras, or when the
+ * frame rate is driven by an external trigger. Cameras are indexed in the
+ * order they are added.
+ *
+ * Since: 0.8.0
+ */
+
+void
+arv_gv_bandwidth_planner_add_camera_full (ArvGvBandwidthPlanner *planner, ArvCamera *camera,
+					  guint payload, double frame_rate, guint packet_size,
+					  guint64 camera_link_speed)
+{
+	ArvGvBandwidthPlannerCamera planner_camera = {0};
+
+	g_return_if_fail (ARV_IS_GV_BANDWIDTH_PLANNER (planner));
+	g_return_if_fail (ARV_IS_CAMERA (camera));
+
+	planner_camera.camera = g_object_ref (camera);
+	planner_camera.payload = payload;
+	planner_camera.frame_rate = frame_rate;
+	planner_camera.packet_size = packet_size;
+	planner_camera.camera_link_speed = camera_link_speed;
+
+	g_array_append_val (planner->priv->cameras, planner_camera);
+	planner->priv->is_computed = FALSE;
+}
+
+/**
+ * arv_gv_bandwidth_planner_add_camera:
+ * @planner: a #ArvGvBandwidthPlanner
+ * @camera: a GigE Vision #ArvCamera
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Adds a camera to the plan, using its current payload size, frame rate and
+ * packet size. Cameras are indexed in the order they are added.
+ *
+ * Returns: %TRUE if the camera stream parameters could be read and the camera was added.
+ *
+ * Since: 0.8.0
+ */
+
+gboolean
+arv_gv_bandwidth_planner_add_camera (ArvGvBandwidthPlanner *planner, ArvCamera *camera, GError **error)
+{
+	GError *local_error = NULL;
+	guint payload = 0;
+	double frame_rate = 0.0;
+	guint packet_size = 0;
+
+	g_return_val_if_fail (ARV_IS_GV_BANDWIDTH_PLANNER (planner), FALSE);
+	g_return_val_if_fail (ARV_IS_CAMERA (camera), FALSE);
+	g_return_val_if_fail (arv_camera_is_gv_device (camera), FALSE);
+
+	payload = arv_camera_get_payload (camera, &local_error);
+	if (local_error == NULL)
+		frame_rate = arv_camera_get_frame_rate (camera, &local_error);
+	if (local_error == NULL)
+		packet_size = arv_camera_gv_get_packet_size (camera, &local_error);
+
+	if (local_error != NULL) {
+		g_propagate_error (error, local_error);
+		return FALSE;
+	}
+
+	arv_gv_bandwidth_planner_add_camera_full (planner, camera, payload, frame_rate, packet_size, 0);
+
+	return TRUE;
+}
+
+/**
+ * arv_gv_bandwidth_planner_get_n_cameras:
+ * @planner: a #ArvGvBandwidthPlanner
+ *
+ * Returns: the number of cameras in the plan.
+ *
+ * Since: 0.8.0
+ */
+
+guint
+arv_gv_bandwidth_planner_get_n_cameras (ArvGvBandwidthPlanner *planner)
+{
+	g_return_val_if_fail (ARV_IS_GV_BANDWIDTH_PLANNER (planner), 0);
+
+	return planner->priv->cameras->len;
+}
+
+/**
+ * arv_gv_bandwidth_planner_get_camera:
+ * @planner: a #ArvGvBandwidthPlanner
+ * @index: camera index
+ *
+ * Returns: (transfer none): the camera at @index.
+ *
+ * Since: 0.8.0
+ */
+
+ArvCamera *
+arv_gv_bandwidth_planner_get_camera (ArvGvBandwidthPlanner *planner, guint index)
+{
+	g_return_val_if_fail (ARV_IS_GV_BANDWIDTH_PLANNER (planner), NULL);
+	g_return_val_if_fail (index < planner->priv->cameras->len, NULL);
+
+	return _get_camera (planner, index)->camera;
+}
+
+/**
+ * arv_gv_bandwidth_planner_compute:
+ * @planner: a #ArvGvBandwidthPlanner
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Computes the packet delays and the frame transmission delays of the
+ * cameras, without applying them. The frame wire size accounts for the GVSP,
+ * UDP, IP and Ethernet overheads, including the preamble and the inter frame
+ * gap.
+ *
+ * Returns: %TRUE if the camera streams fit in the link budget.
+ *
+ * Since: 0.8.0
+ */
+
+gboolean
+arv_gv_bandwidth_planner_compute (ArvGvBandwidthPlanner *planner, GError **error)
+{
+	ArvGvBandwidthPlannerPrivate *priv;
+	double budget_rate;
+	double total_rate = 0.0;
+	gint64 slot_start = 0;
+	guint i;
+
+	g_return_val_if_fail (ARV_IS_GV_BANDWIDTH_PLANNER (planner), FALSE);
+
+	priv = planner->priv;
+	priv->is_computed = FALSE;
+
+	budget_rate = (double) priv->link_capacity * priv->link_budget;
+
+	for (i = 0; i < priv->cameras->len; i++) {
+		ArvGvBandwidthPlannerCamera *planner_camera = _get_camera (planner, i);
+		guint64 n_packets;
+		guint data_size;
+
+		if (planner_camera->payload == 0 ||
+		    planner_camera->frame_rate <= 0.0 ||
+		    planner_camera->packet_size <= ARV_GVSP_PACKET_PROTOCOL_OVERHEAD) {
+			g_set_error (error, ARV_GV_BANDWIDTH_PLANNER_ERROR,
+				     ARV_GV_BANDWIDTH_PLANNER_ERROR_INVALID_PARAMETER,
+				     "Invalid stream parameters for camera %u (payload: %u, frame rate: %g, packet size: %u)",
+				     i, planner_camera->payload, planner_camera->frame_rate,
+				     planner_camera->packet_size);
+			return FALSE;
+		}
+
+		data_size = planner_camera->packet_size - ARV_GVSP_PACKET_PROTOCOL_OVERHEAD;
+		n_packets = (planner_camera->payload + data_size - 1) / data_size;
+
+		planner_camera->frame_bits = 8 * ((guint64) planner_camera->payload +
+						  n_packets * (ARV_GVSP_PACKET_PROTOCOL_OVERHEAD +
+							       ARV_GV_BANDWIDTH_PLANNER_ETHERNET_OVERHEAD) +
+						  2 * ARV_GV_BANDWIDTH_PLANNER_MIN_FRAME_WIRE_SIZE);
+		planner_camera->mean_rate = planner_camera->frame_bits * planner_camera->frame_rate;
+
+		total_rate += planner_camera->mean_rate;
+	}
+
+	if (total_rate > budget_rate) {
+		g_set_error (error, ARV_GV_BANDWIDTH_PLANNER_ERROR, ARV_GV_BANDWIDTH_PLANNER_ERROR_OVER_BUDGET,
+			     "Camera streams need %.1f%% of the link capacity, over the %.1f%% budget",
+			     100.0 * total_rate / priv->link_capacity, 100.0 * priv->link_budget);
+		return FALSE;
+	}
+
+	for (i = 0; i < priv->cameras->len; i++) {
+		ArvGvBandwidthPlannerCamera *planner_camera = _get_camera (planner, i);
+		double link_rate;
+		double rate;
+		double packet_bits;
+
+		link_rate = planner_camera->camera_link_speed > 0 ?
+			MIN (planner_camera->camera_link_speed, priv->link_capacity) : priv->link_capacity;
+
+		if (priv->mode == ARV_GV_BANDWIDTH_PLANNER_MODE_STAGGERED)
+			rate = budget_rate;
+		else
+			/* Sum of the rates is the budget: bursts never exceed it, even when all cameras transmit at
+			 * the same time, and each frame is sent within its frame period */
+			rate = budget_rate * planner_camera->mean_rate / total_rate;
+		rate = MIN (rate, link_rate);
+
+		/* The camera sends its packets at its link speed, the delay stretches the interval between the
+		 * packet starts to the planned rate */
+		packet_bits = 8.0 * (planner_camera->packet_size + ARV_GV_BANDWIDTH_PLANNER_ETHERNET_OVERHEAD);
+
+		planner_camera->peak_rate = rate;
+		planner_camera->packet_delay = MAX (0, ceil (1e9 * packet_bits / rate - 1e9 * packet_bits / link_rate));
+		planner_camera->frame_transmission_duration = ceil (1e9 * planner_camera->frame_bits / rate);
+
+		if (priv->mode == ARV_GV_BANDWIDTH_PLANNER_MODE_STAGGERED) {
+			planner_camera->frame_transmission_delay = slot_start;
+
+			if (slot_start + planner_camera->frame_transmission_duration >
+			    1e9 / planner_camera->frame_rate) {
+				g_set_error (error, ARV_GV_BANDWIDTH_PLANNER_ERROR,
+					     ARV_GV_BANDWIDTH_PLANNER_ERROR_OVER_BUDGET,
+					     "Staggered transmission of camera %u frames would overlap the next frame",
+					     i);
+				return FALSE;
+			}
+
+			slot_start += planner_camera->frame_transmission_duration +
+				ARV_GV_BANDWIDTH_PLANNER_SLOT_GUARD_NS;
+		} else
+			planner_camera->frame_transmission_delay = 0;
+
+		arv_debug_device ("[GvBandwidthPlanner::compute] Camera %u: utilization %.1f%% (peak %.1f%%),"
+				  " packet delay %" G_GINT64_FORMAT " ns, frame transmission delay %" G_GINT64_FORMAT
+				  " ns, duration %" G_GINT64_FORMAT " ns",
+				  i, 100.0 * planner_camera->mean_rate / priv->link_capacity,
+				  100.0 * planner_camera->peak_rate / priv->link_capacity,
+				  planner_camera->packet_delay, planner_camera->frame_transmission_delay,
+				  planner_camera->frame_transmission_duration);
+	}
+
+	priv->is_computed = TRUE;
+
+	return TRUE;
+}
+
+/**
+ * arv_gv_bandwidth_planner_apply:
+ * @planner: a #ArvGvBandwidthPlanner
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Computes the plan if needed, and sets the GevSCPD and GevSCFTD features of
+ * the cameras on their current stream channel. The frame transmission delay
+ * is only set on the cameras which support it, except in
+ * %ARV_GV_BANDWIDTH_PLANNER_MODE_STAGGERED mode, where it is mandatory.
+ *
+ * Returns: %TRUE on success.
+ *
+ * Since: 0.8.0
+ */
+
+gboolean
+arv_gv_bandwidth_planner_apply (ArvGvBandwidthPlanner *planner, GError **error)
+{
+	guint i;
+
+	g_return_val_if_fail (ARV_IS_GV_BANDWIDTH_PLANNER (planner), FALSE);
+
+	if (!planner->priv->is_computed &&
+	    !arv_gv_bandwidth_planner_compute (planner, error))
+		return FALSE;
+
+	for (i = 0; i < planner->priv->cameras->len; i++) {
+		ArvGvBandwidthPlannerCamera *planner_camera = _get_camera (planner, i);
+		GError *local_error = NULL;
+
+		arv_camera_gv_set_packet_delay (planner_camera->camera, planner_camera->packet_delay, &local_error);
+
+		if (local_error == NULL) {
+			if (arv_camera_is_feature_available (planner_camera->camera, "GevSCFTD", NULL))
+				arv_camera_gv_set_frame_transmission_delay (planner_camera->camera,
+									    planner_camera->frame_transmission_delay,
+									    &local_error);
+			else if (planner_camera->frame_transmission_delay > 0)
+				g_set_error (&local_error, ARV_GV_BANDWIDTH_PLANNER_ERROR,
+					     ARV_GV_BANDWIDTH_PLANNER_ERROR_NO_FRAME_TRANSMISSION_DELAY,
+					     "Camera %u does not support frame transmission delay", i);
+		}
+
+		if (local_error != NULL) {
+			g_propagate_error (error, local_error);
+			return FALSE;
+		}
+	}
+
+	return TRUE;
+}
+
+/**
+ * arv_gv_bandwidth_planner_get_packet_delay:
+ * @planner: a #ArvGvBandwidthPlanner
+ * @index: camera index
+ *
+ * Returns: the planned inter packet delay, in nanoseconds, 0 if the plan is not computed.
+ *
+ * Since: 0.8.0
+ */
+
+gint64
+arv_gv_bandwidth_planner_get_packet_delay (ArvGvBandwidthPlanner *planner, guint index)
+{
+	g_return_val_if_fail (ARV_IS_GV_BANDWIDTH_PLANNER (planner), 0);
+	g_return_val_if_fail (index < planner->priv->cameras->len, 0);
+
+	return planner->priv->is_computed ? _get_camera (planner, index)->packet_delay : 0;
+}
+
+/**
+ * arv_gv_bandwidth_planner_get_frame_transmission_delay:
+ * @planner: a #ArvGvBandwidthPlanner
+ * @index: camera index
+ *
+ * Returns: the planned frame transmission delay, in nanoseconds, 0 if the plan is not computed.
+ *
+ * Since: 0.8.0
+ */
+
+gint64
+arv_gv_bandwidth_planner_get_frame_transmission_delay (ArvGvBandwidthPlanner *planner, guint index)
+{
+	g_return_val_if_fail (ARV_IS_GV_BANDWIDTH_PLANNER (planner), 0);
+	g_return_val_if_fail (index < planner->priv->cameras->len, 0);
+
+	return planner->priv->is_computed ? _get_camera (planner, index)->frame_transmission_delay : 0;
+}
+
+/**
+ * arv_gv_bandwidth_planner_get_frame_transmission_duration:
+ * @planner: a #ArvGvBandwidthPlanner
+ * @index: camera index
+ *
+ * Returns: the predicted time needed to transmit a frame, in nanoseconds, 0 if the plan is not computed.
+ *
+ * Since: 0.8.0
+ */
+
+gint64
+arv_gv_bandwidth_planner_get_frame_transmission_duration (ArvGvBandwidthPlanner *planner, guint index)
+{
+	g_return_val_if_fail (ARV_IS_GV_BANDWIDTH_PLANNER (planner), 0);
+	g_return_val_if_fail (index < planner->priv->cameras->len, 0);
+
+	return planner->priv->is_computed ? _get_camera (planner, index)->frame_transmission_duration : 0;
+}
+
+/**
+ * arv_gv_bandwidth_planner_get_utilization:
+ * @planner: a #ArvGvBandwidthPlanner
+ * @index: camera index
+ *
+ * Returns: the predicted mean bandwidth of the camera stream, as a fraction of the link capacity, 0 if the
+ * plan is not computed.
+ *
+ * Since: 0.8.0
+ */
+
+double
+arv_gv_bandwidth_planner_get_utilization (ArvGvBandwidthPlanner *planner, guint index)
+{
+	g_return_val_if_fail (ARV_IS_GV_BANDWIDTH_PLANNER (planner), 0.0);
+	g_return_val_if_fail (index < planner->priv->cameras->len, 0.0);
+
+	if (!planner->priv->is_computed)
+		return 0.0;
+
+	return _get_camera (planner, index)->mean_rate / planner->priv->link_capacity;
+}
+
+/**
+ * arv_gv_bandwidth_planner_get_peak_utilization:
+ * @planner: a #ArvGvBandwidthPlanner
+ * @index: camera index
+ *
+ * Returns: the predicted bandwidth of the camera stream during a frame transmission, as a fraction of the
+ * link capacity, 0 if the plan is not computed.
+ *
+ * Since: 0.8.0
+ */
+
+double
+arv_gv_bandwidth_planner_get_peak_utilization (ArvGvBandwidthPlanner *planner, guint index)
+{
+	g_return_val_if_fail (ARV_IS_GV_BANDWIDTH_PLANNER (planner), 0.0);
+	g_return_val_if_fail (index < planner->priv->cameras->len, 0.0);
+
+	if (!planner->priv->is_computed)
+		return 0.0;
+
+	return _get_camera (planner, index)->peak_rate / planner->priv->link_capacity;
+}
+
+/**
+ * arv_gv_bandwidth_planner_get_total_utilization:
+ * @planner: a #ArvGvBandwidthPlanner
+ *
+ * Returns: the predicted mean bandwidth of all the camera streams, as a fraction of the link capacity, 0 if
+ * the plan is not computed.
+ *
+ * Since: 0.8.0
+ */
+
+double
+arv_gv_bandwidth_planner_get_total_utilization (ArvGvBandwidthPlanner *planner)
+{
+	double total_rate = 0.0;
+	guint i;
+
+	g_return_val_if_fail (ARV_IS_GV_BANDWIDTH_PLANNER (planner), 0.0);
+
+	if (!planner->priv->is_computed)
+		return 0.0;
+
+	for (i = 0; i < planner->priv->cameras->len; i++)
+		total_rate += _get_camera (planner, i)->mean_rate;
+
+	return total_rate / planner->priv->link_capacity;
+}
+
+/**
+ * arv_gv_bandwidth_planner_get_total_peak_utilization:
+ * @planner: a #ArvGvBandwidthPlanner
+ *
+ * Returns: the predicted worst case aggregated bandwidth of the camera streams, as a fraction of the link
+ * capacity, 0 if the plan is not computed. It is never over the link budget.
+ *
+ * Since: 0.8.0
+ */
+
+double
+arv_gv_bandwidth_planner_get_total_peak_utilization (ArvGvBandwidthPlanner *planner)
+{
+	double peak_rate = 0.0;
+	guint i;
+
+	g_return_val_if_fail (ARV_IS_GV_BANDWIDTH_PLANNER (planner), 0.0);
+
+	if (!planner->priv->is_computed)
+		return 0.0;
+
+	for (i = 0; i < planner->priv->cameras->len; i++) {
+		ArvGvBandwidthPlannerCamera *planner_camera = _get_camera (planner, i);
+
+		if (planner->priv->mode == ARV_GV_BANDWIDTH_PLANNER_MODE_STAGGERED)
+			peak_rate = MAX (peak_rate, planner_camera->peak_rate);
+		else
+			peak_rate += planner_camera->peak_rate;
+	}
+
+	return peak_rate / planner->priv->link_capacity;
+}
+
+static void
+_clear_camera (ArvGvBandwidthPlannerCamera *planner_camera)
+{
+	g_clear_object (&planner_camera->camera);
+}
+
+static void
+arv_gv_bandwidth_planner_init (ArvGvBandwidthPlanner *planner)
+{
+	planner->priv = arv_gv_bandwidth_planner_get_instance_private (planner);
+
+	planner->priv->cameras = g_array_new (FALSE, TRUE, sizeof (ArvGvBandwidthPlannerCamera));
+	g_array_set_clear_func (planner->priv->cameras, (GDestroyNotify) _clear_camera);
+	planner->priv->link_budget = ARV_GV_BANDWIDTH_PLANNER_DEFAULT_LINK_BUDGET;
+	planner->priv->mode = ARV_GV_BANDWIDTH_PLANNER_MODE_SHARED;
+}
+
+static void
+_finalize (GObject *object)
+{
+	ArvGvBandwidthPlanner *planner = ARV_GV_BANDWIDTH_PLANNER (object);
+
+	g_array_unref (planner->priv->cameras);
+
+	G_OBJECT_CLASS (arv_gv_bandwidth_planner_parent_class)->finalize (object);
+}
+
+static void
+arv_gv_bandwidth_planner_class_init (ArvGvBandwidthPlannerClass *this_class)
+{
+	GObjectClass *object_class = G_OBJECT_CLASS (this_class);
+
+	object_class->finalize = _finalize;
+}
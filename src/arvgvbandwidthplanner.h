@@ -0,0 +1,109 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2019 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel@gnome.org>
+ */
+
+#ifndef ARV_GV_BANDWIDTH_PLANNER_H
+#define ARV_GV_BANDWIDTH_PLANNER_H
+
+#if !defined (ARV_H_INSIDE) && !defined (ARAVIS_COMPILATION)
+#error "Only <arv.h> can be included directly."
+#endif
+
+#include <arvtypes.h>
+
+G_BEGIN_DECLS
+
+#define ARV_GV_BANDWIDTH_PLANNER_ERROR arv_gv_bandwidth_planner_error_quark()
+
+GQuark 		arv_gv_bandwidth_planner_error_quark 		(void);
+
+/**
+ * ArvGvBandwidthPlannerError:
+ * @ARV_GV_BANDWIDTH_PLANNER_ERROR_INVALID_PARAMETER: invalid camera stream parameter
+ * @ARV_GV_BANDWIDTH_PLANNER_ERROR_OVER_BUDGET: the camera streams do not fit in the link budget
+ * @ARV_GV_BANDWIDTH_PLANNER_ERROR_NO_FRAME_TRANSMISSION_DELAY: a staggered plan needs the GevSCFTD feature
+ */
+
+typedef enum {
+	ARV_GV_BANDWIDTH_PLANNER_ERROR_INVALID_PARAMETER,
+	ARV_GV_BANDWIDTH_PLANNER_ERROR_OVER_BUDGET,
+	ARV_GV_BANDWIDTH_PLANNER_ERROR_NO_FRAME_TRANSMISSION_DELAY
+} ArvGvBandwidthPlannerError;
+
+/**
+ * ArvGvBandwidthPlannerMode:
+ * @ARV_GV_BANDWIDTH_PLANNER_MODE_SHARED: cameras transmit concurrently, each one at a rate proportional to its
+ * mean bandwidth
+ * @ARV_GV_BANDWIDTH_PLANNER_MODE_STAGGERED: cameras transmit one after the other, at the full link budget
+ * rate. Only meaningful for cameras triggered at the same time.
+ *
+ * Since: 0.8.0
+ */
+
+typedef enum {
+	ARV_GV_BANDWIDTH_PLANNER_MODE_SHARED,
+	ARV_GV_BANDWIDTH_PLANNER_MODE_STAGGERED
+} ArvGvBandwidthPlannerMode;
+
+#define ARV_TYPE_GV_BANDWIDTH_PLANNER             (arv_gv_bandwidth_planner_get_type ())
+G_DECLARE_FINAL_TYPE (ArvGvBandwidthPlanner, arv_gv_bandwidth_planner, ARV, GV_BANDWIDTH_PLANNER, GObject)
+
+ArvGvBandwidthPlanner *	arv_gv_bandwidth_planner_new				(guint64 link_capacity);
+
+guint64			arv_gv_bandwidth_planner_get_link_capacity		(ArvGvBandwidthPlanner *planner);
+void			arv_gv_bandwidth_planner_set_link_budget		(ArvGvBandwidthPlanner *planner,
+										 double budget);
+double			arv_gv_bandwidth_planner_get_link_budget		(ArvGvBandwidthPlanner *planner);
+void			arv_gv_bandwidth_planner_set_mode			(ArvGvBandwidthPlanner *planner,
+										 ArvGvBandwidthPlannerMode mode);
+ArvGvBandwidthPlannerMode	arv_gv_bandwidth_planner_get_mode		(ArvGvBandwidthPlanner *planner);
+
+gboolean		arv_gv_bandwidth_planner_add_camera			(ArvGvBandwidthPlanner *planner,
+										 ArvCamera *camera, GError **error);
+void			arv_gv_bandwidth_planner_add_camera_full		(ArvGvBandwidthPlanner *planner,
+										 ArvCamera *camera, guint payload,
+										 double frame_rate, guint packet_size,
+										 guint64 camera_link_speed);
+guint			arv_gv_bandwidth_planner_get_n_cameras			(ArvGvBandwidthPlanner *planner);
+ArvCamera *		arv_gv_bandwidth_planner_get_camera			(ArvGvBandwidthPlanner *planner,
+										 guint index);
+
+gboolean		arv_gv_bandwidth_planner_compute			(ArvGvBandwidthPlanner *planner,
+										 GError **error);
+gboolean		arv_gv_bandwidth_planner_apply				(ArvGvBandwidthPlanner *planner,
+										 GError **error);
+
+gint64			arv_gv_bandwidth_planner_get_packet_delay		(ArvGvBandwidthPlanner *planner,
+										 guint index);
+gint64			arv_gv_bandwidth_planner_get_frame_transmission_delay	(ArvGvBandwidthPlanner *planner,
+										 guint index);
+gint64			arv_gv_bandwidth_planner_get_frame_transmission_duration	(ArvGvBandwidthPlanner *planner,
+										 guint index);
+double			arv_gv_bandwidth_planner_get_utilization		(ArvGvBandwidthPlanner *planner,
+										 guint index);
+double			arv_gv_bandwidth_planner_get_peak_utilization		(ArvGvBandwidthPlanner *planner,
+										 guint index);
+double			arv_gv_bandwidth_planner_get_total_utilization		(ArvGvBandwidthPlanner *planner);
+double			arv_gv_bandwidth_planner_get_total_peak_utilization	(ArvGvBandwidthPlanner *planner);
+
+G_END_DECLS
+
+#endif
@@ -427,6 +427,197 @@ arv_gvcp_packet_new_packet_resend_cmd (guint32 frame_id,
 	return packet;
 }
 
+/**
+ * arv_gvcp_packet_new_action_cmd: (skip)
+ * @device_key: device key
+ * @group_key: group key
+ * @group_mask: group mask
+ * @action_time: scheduled action time, in device timestamp ticks, 0 for an immediate action
+ * @ack_required: wether the devices should acknowledge the command
+ * @packet_id: packet id
+ * @packet_size: (out): packet size, in bytes
+ *
+ * Create a gvcp packet for an action command.
+ *
+ * Return value: (transfer full): a new #ArvGvcpPacket
+ *
+ * Since: 0.8.0
+ */
+
+ArvGvcpPacket *
+arv_gvcp_packet_new_action_cmd (guint32 device_key, guint32 group_key, guint32 group_mask,
+				guint64 action_time, gboolean ack_required,
+				guint16 packet_id, size_t *packet_size)
+{
+	ArvGvcpPacket *packet;
+	size_t data_size;
+	guint32 *data;
+
+	g_return_val_if_fail (packet_size != NULL, NULL);
+
+	data_size = 3 * sizeof (guint32);
+	if (action_time != 0)
+		data_size += sizeof (guint64);
+
+	*packet_size = sizeof (ArvGvcpHeader) + data_size;
+
+	packet = g_malloc (*packet_size);
+
+	packet->header.packet_type = ARV_GVCP_PACKET_TYPE_CMD;
+	packet->header.packet_flags = ack_required ? ARV_GVCP_CMD_PACKET_FLAGS_ACK_REQUIRED : 0;
+	if (action_time != 0)
+		packet->header.packet_flags |= ARV_GVCP_ACTION_PACKET_FLAGS_SCHEDULED;
+	packet->header.command = g_htons (ARV_GVCP_COMMAND_ACTION_CMD);
+	packet->header.size = g_htons (data_size);
+	packet->header.id = g_htons (packet_id);
+
+	data = (guint32 *) &packet->data;
+
+	data[0] = g_htonl (device_key);
+	data[1] = g_htonl (group_key);
+	data[2] = g_htonl (group_mask);
+
+	if (action_time != 0) {
+		guint64 be_action_time = GUINT64_TO_BE (action_time);
+
+		memcpy (&data[3], &be_action_time, sizeof (guint64));
+	}
+
+	return packet;
+}
+
+/**
+ * arv_gvcp_packet_new_action_ack: (skip)
+ * @status: %ARV_GVCP_ERROR_NONE on success, an error code otherwise
+ * @packet_id: packet id
+ * @packet_size: (out): packet size, in bytes
+ *
+ * Create a gvcp packet for an action acknowledge.
+ *
+ * Return value: (transfer full): a new #ArvGvcpPacket
+ *
+ * Since: 0.8.0
+ */
+
+ArvGvcpPacket *
+arv_gvcp_packet_new_action_ack (ArvGvcpError status, guint16 packet_id, size_t *packet_size)
+{
+	ArvGvcpPacket *packet;
+
+	g_return_val_if_fail (packet_size != NULL, NULL);
+
+	*packet_size = sizeof (ArvGvcpHeader);
+
+	packet = g_malloc (*packet_size);
+
+	/* The acknowledge status field overlaps the packet type and flags */
+	if (status == ARV_GVCP_ERROR_NONE) {
+		packet->header.packet_type = ARV_GVCP_PACKET_TYPE_ACK;
+		packet->header.packet_flags = 0;
+	} else {
+		packet->header.packet_type = ARV_GVCP_PACKET_TYPE_ERROR;
+		packet->header.packet_flags = status;
+	}
+	packet->header.command = g_htons (ARV_GVCP_COMMAND_ACTION_ACK);
+	packet->header.size = 0;
+	packet->header.id = g_htons (packet_id);
+
+	return packet;
+}
+
+/**
+ * arv_gvcp_packet_new_event_cmd: (skip)
+ * @event_id: event identifier
+ * @stream_channel_index: index of the related stream channel, 0xffff if none
+ * @block_id: related block id, 0 if none
+ * @timestamp: event timestamp, in device timestamp ticks
+ * @data: (allow-none): event data
+ * @data_size: size of @data, in bytes
+ * @packet_id: packet id
+ * @packet_size: (out): packet size, in bytes
+ *
+ * Create a gvcp packet for an event notification. An EVENTDATA message is created if @data is not %NULL, an EVENT
+ * message otherwise. The acknowledge required flag is always set.
+ *
+ * Return value: (transfer full): a new #ArvGvcpPacket
+ *
+ * Since: 0.8.0
+ */
+
+ArvGvcpPacket *
+arv_gvcp_packet_new_event_cmd (guint16 event_id, guint16 stream_channel_index, guint16 block_id, guint64 timestamp,
+			       const void *data, size_t data_size,
+			       guint16 packet_id, size_t *packet_size)
+{
+	ArvGvcpPacket *packet;
+	ArvGvcpEventItem *item;
+
+	g_return_val_if_fail (packet_size != NULL, NULL);
+	g_return_val_if_fail (data_size <= ARV_GVCP_EVENTDATA_MAX_DATA_SIZE, NULL);
+
+	if (data == NULL)
+		data_size = 0;
+
+	*packet_size = sizeof (ArvGvcpHeader) + sizeof (ArvGvcpEventItem) + data_size;
+
+	packet = g_malloc (*packet_size);
+
+	packet->header.packet_type = ARV_GVCP_PACKET_TYPE_CMD;
+	packet->header.packet_flags = ARV_GVCP_CMD_PACKET_FLAGS_ACK_REQUIRED;
+	packet->header.command = g_htons (data != NULL ? ARV_GVCP_COMMAND_EVENTDATA_CMD : ARV_GVCP_COMMAND_EVENT_CMD);
+	packet->header.size = g_htons (sizeof (ArvGvcpEventItem) + data_size);
+	packet->header.id = g_htons (packet_id);
+
+	item = (ArvGvcpEventItem *) &packet->data;
+
+	item->reserved = 0;
+	item->event_id = g_htons (event_id);
+	item->stream_channel_index = g_htons (stream_channel_index);
+	item->block_id = g_htons (block_id);
+	item->timestamp_high = g_htonl (timestamp >> 32);
+	item->timestamp_low = g_htonl (timestamp & 0xffffffff);
+
+	if (data_size > 0)
+		memcpy ((char *) item + sizeof (ArvGvcpEventItem), data, data_size);
+
+	return packet;
+}
+
+/**
+ * arv_gvcp_packet_new_event_ack: (skip)
+ * @command: %ARV_GVCP_COMMAND_EVENT_ACK or %ARV_GVCP_COMMAND_EVENTDATA_ACK
+ * @packet_id: packet id of the acknowledged message
+ * @packet_size: (out): packet size, in bytes
+ *
+ * Create a gvcp packet for an event acknowledge.
+ *
+ * Return value: (transfer full): a new #ArvGvcpPacket
+ *
+ * Since: 0.8.0
+ */
+
+ArvGvcpPacket *
+arv_gvcp_packet_new_event_ack (ArvGvcpCommand command, guint16 packet_id, size_t *packet_size)
+{
+	ArvGvcpPacket *packet;
+
+	g_return_val_if_fail (packet_size != NULL, NULL);
+	g_return_val_if_fail (command == ARV_GVCP_COMMAND_EVENT_ACK ||
+			      command == ARV_GVCP_COMMAND_EVENTDATA_ACK, NULL);
+
+	*packet_size = sizeof (ArvGvcpHeader);
+
+	packet = g_malloc (*packet_size);
+
+	packet->header.packet_type = ARV_GVCP_PACKET_TYPE_ACK;
+	packet->header.packet_flags = 0;
+	packet->header.command = g_htons (command);
+	packet->header.size = 0;
+	packet->header.id = g_htons (packet_id);
+
+	return packet;
+}
+
 static const char *
 arv_enum_to_string (GType type,
 		    guint enum_value)
@@ -499,6 +690,21 @@ arv_gvcp_packet_flags_to_string_new (ArvGvcpCommand command, guint8 flags)
 								arv_enum_to_string (ARV_TYPE_GVCP_EVENT_PACKET_FLAGS, 1 << i));
 			}
 			break;
+		case ARV_GVCP_COMMAND_EVENT_CMD:
+		case ARV_GVCP_COMMAND_EVENTDATA_CMD:
+			for (i = 0; i < 8; i++) {
+				if ((1 << i) & flags)
+					g_string_append_printf (string, "%s%s", string->len > 0 ? " " : "",
+								arv_enum_to_string (ARV_TYPE_GVCP_EVENT_PACKET_FLAGS, 1 << i));
+			}
+			break;
+		case ARV_GVCP_COMMAND_ACTION_CMD:
+			for (i = 0; i < 8; i++) {
+				if ((1 << i) & flags)
+					g_string_append_printf (string, "%s%s", string->len > 0 ? " " : "",
+								arv_enum_to_string (ARV_TYPE_GVCP_ACTION_PACKET_FLAGS, 1 << i));
+			}
+			break;
 		default:
 			break;
 	}
@@ -645,6 +851,43 @@ arv_gvcp_packet_to_string (const ArvGvcpPacket *packet)
 			g_string_append_printf (string, "address      = %10u (0x%08x)\n",
 						value, value);
 			break;
+		case ARV_GVCP_COMMAND_ACTION_CMD:
+			{
+				guint32 device_key, group_key, group_mask;
+				guint64 action_time;
+
+				arv_gvcp_packet_get_action_cmd_infos (packet, &device_key, &group_key, &group_mask,
+								      &action_time);
+				g_string_append_printf (string, "device key   = 0x%08x\n", device_key);
+				g_string_append_printf (string, "group key    = 0x%08x\n", group_key);
+				g_string_append_printf (string, "group mask   = 0x%08x\n", group_mask);
+				if (action_time != 0)
+					g_string_append_printf (string, "action time  = %" G_GUINT64_FORMAT "\n",
+								action_time);
+			}
+			break;
+		case ARV_GVCP_COMMAND_EVENT_CMD:
+		case ARV_GVCP_COMMAND_EVENTDATA_CMD:
+			{
+				guint n_events = arv_gvcp_packet_get_n_events (packet);
+				guint i;
+
+				for (i = 0; i < n_events; i++) {
+					guint16 event_id;
+					guint64 block_id, timestamp;
+					size_t data_size;
+
+					arv_gvcp_packet_get_event_infos (packet, i, &event_id, NULL, &block_id,
+									 &timestamp, NULL, &data_size);
+					g_string_append_printf (string, "event id     = 0x%04x\n", event_id);
+					g_string_append_printf (string, "block id     = %" G_GUINT64_FORMAT "\n", block_id);
+					g_string_append_printf (string, "timestamp    = %" G_GUINT64_FORMAT "\n", timestamp);
+					if (data_size > 0)
+						g_string_append_printf (string, "data size    = %" G_GSIZE_FORMAT "\n",
+									data_size);
+				}
+			}
+			break;
 	}
 
 	packet_size = sizeof (ArvGvcpHeader) + g_ntohs (packet->header.size);
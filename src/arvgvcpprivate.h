@@ -91,6 +91,8 @@ G_BEGIN_DECLS
 
 #define ARV_GVBS_N_MESSAGE_CHANNELS_OFFSET		0x00000900
 #define ARV_GVBS_N_STREAM_CHANNELS_OFFSET		0x00000904
+#define ARV_GVBS_N_ACTION_SIGNALS_OFFSET		0x00000908
+#define ARV_GVBS_ACTION_DEVICE_KEY_OFFSET		0x0000090c
 
 #define ARV_GVBS_GVCP_CAPABILITY_OFFSET			0x00000934
 #define ARV_GVBS_GVCP_CAPABILITY_CONCATENATION			1 << 0
@@ -116,6 +118,8 @@ G_BEGIN_DECLS
 #define ARV_GVBS_TIMESTAMP_TICK_FREQUENCY_HIGH_OFFSET	0x0000093c
 #define ARV_GVBS_TIMESTAMP_TICK_FREQUENCY_LOW_OFFSET	0x00000940
 #define ARV_GVBS_TIMESTAMP_CONTROL_OFFSET		0x00000944
+#define ARV_GVBS_TIMESTAMP_CONTROL_LATCH		1 << 1
+#define ARV_GVBS_TIMESTAMP_CONTROL_RESET		1 << 0
 #define ARV_GVBS_TIMESTAMP_LATCHED_VALUE_HIGH_OFFSET	0x00000948
 #define ARV_GVBS_TIMESTAMP_LATCHED_VALUE_LOW_OFFSET	0x0000094c
 
@@ -123,6 +127,12 @@ G_BEGIN_DECLS
 #define ARV_GVBS_CONTROL_CHANNEL_PRIVILEGE_CONTROL	1 << 1
 #define ARV_GVBS_CONTROL_CHANNEL_PRIVILEGE_EXCLUSIVE	1 << 0
 
+#define ARV_GVBS_MESSAGE_CHANNEL_0_PORT_OFFSET			0x00000b00
+#define ARV_GVBS_MESSAGE_CHANNEL_0_IP_ADDRESS_OFFSET		0x00000b10
+#define ARV_GVBS_MESSAGE_CHANNEL_0_TRANSMISSION_TIMEOUT_OFFSET	0x00000b14
+#define ARV_GVBS_MESSAGE_CHANNEL_0_RETRY_COUNT_OFFSET		0x00000b18
+#define ARV_GVBS_MESSAGE_CHANNEL_0_SOURCE_PORT_OFFSET		0x00000b1c
+
 #define ARV_GVBS_STREAM_CHANNEL_0_PORT_OFFSET		0x00000d00
 
 #define ARV_GVBS_STREAM_CHANNEL_0_PACKET_SIZE_OFFSET		0x00000d04
@@ -136,6 +146,10 @@ G_BEGIN_DECLS
 
 #define ARV_GVBS_STREAM_CHANNEL_0_IP_ADDRESS_OFFSET		0x00000d18
 
+#define ARV_GVBS_ACTION_GROUP_KEY_0_OFFSET			0x00009800
+#define ARV_GVBS_ACTION_GROUP_MASK_0_OFFSET			0x00009804
+#define ARV_GVBS_ACTION_GROUP_SIZE				0x00000010
+
 #define ARV_GVBS_DEVICE_LINK_SPEED_0_OFFSET			0x0000b000
 
 #define ARV_GVBS_STREAM_CHANNEL_0_PACKET_SIZE_MIN_OFFSET		0x0000c000
@@ -261,6 +275,17 @@ typedef enum {
 	ARV_GVCP_DISCOVERY_PACKET_FLAGS_ALLOW_BROADCAST_ACK = 	0x10,
 } ArvGvcpDiscoveryPacketFlags;
 
+/**
+ * ArvGvcpActionPacketFlags:
+ * @ARV_GVCP_ACTION_PACKET_FLAGS_NONE: no flag defined
+ * @ARV_GVCP_ACTION_PACKET_FLAGS_SCHEDULED: action time field is present
+ */
+
+typedef enum {
+	ARV_GVCP_ACTION_PACKET_FLAGS_NONE =			0x00,
+	ARV_GVCP_ACTION_PACKET_FLAGS_SCHEDULED =		0x80,
+} ArvGvcpActionPacketFlags;
+
 /**
  * ArvGvcpCommand:
  * @ARV_GVCP_COMMAND_DISCOVERY_CMD: discovery command
@@ -277,7 +302,13 @@ typedef enum {
  * @ARV_GVCP_COMMAND_READ_MEMORY_ACK: read memory acknowledge
  * @ARV_GVCP_COMMAND_WRITE_MEMORY_CMD: write memory command
  * @ARV_GVCP_COMMAND_WRITE_MEMORY_ACK: write memory acknowledge
+ * @ARV_GVCP_COMMAND_EVENT_CMD: event command
+ * @ARV_GVCP_COMMAND_EVENT_ACK: event acknowledge
+ * @ARV_GVCP_COMMAND_EVENTDATA_CMD: event with data command
+ * @ARV_GVCP_COMMAND_EVENTDATA_ACK: event with data acknowledge
  * @ARV_GVCP_COMMAND_PENDING_ACK: pending command acknowledge
+ * @ARV_GVCP_COMMAND_ACTION_CMD: action command
+ * @ARV_GVCP_COMMAND_ACTION_ACK: action acknowledge
  */
 
 typedef enum {
@@ -295,7 +326,13 @@ typedef enum {
 	ARV_GVCP_COMMAND_READ_MEMORY_ACK =	0x0085,
 	ARV_GVCP_COMMAND_WRITE_MEMORY_CMD =	0x0086,
 	ARV_GVCP_COMMAND_WRITE_MEMORY_ACK =	0x0087,
-	ARV_GVCP_COMMAND_PENDING_ACK =		0x0089
+	ARV_GVCP_COMMAND_EVENT_CMD =		0x00c0,
+	ARV_GVCP_COMMAND_EVENT_ACK =		0x00c1,
+	ARV_GVCP_COMMAND_EVENTDATA_CMD =	0x00c2,
+	ARV_GVCP_COMMAND_EVENTDATA_ACK =	0x00c3,
+	ARV_GVCP_COMMAND_PENDING_ACK =		0x0089,
+	ARV_GVCP_COMMAND_ACTION_CMD =		0x0100,
+	ARV_GVCP_COMMAND_ACTION_ACK =		0x0101
 } ArvGvcpCommand;
 
 #pragma pack(push,1)
@@ -332,8 +369,33 @@ typedef struct {
 	unsigned char data[];
 } ArvGvcpPacket;
 
+/**
+ * ArvGvcpEventItem:
+ * @reserved: reserved
+ * @event_id: event identifier
+ * @stream_channel_index: index of the stream channel the event relates to, 0xffff if none
+ * @block_id: block id of the related stream channel, 0 if none
+ * @timestamp_high: event timestamp, high 32 bits
+ * @timestamp_low: event timestamp, low 32 bits
+ *
+ * Event description, used in EVENT and EVENTDATA messages. An EVENT message may contain several items, an EVENTDATA
+ * message contains one item followed by device specific data.
+ */
+
+typedef struct {
+	guint16 reserved;
+	guint16 event_id;
+	guint16 stream_channel_index;
+	guint16 block_id;
+	guint32 timestamp_high;
+	guint32 timestamp_low;
+} ArvGvcpEventItem;
+
 #pragma pack(pop)
 
+#define ARV_GVCP_EVENT_ITEM_EXTENDED_ID_SIZE		24
+#define ARV_GVCP_EVENTDATA_MAX_DATA_SIZE		540
+
 void 			arv_gvcp_packet_free 			(ArvGvcpPacket *packet);
 ArvGvcpPacket * 	arv_gvcp_packet_new_read_memory_cmd 	(guint32 address, guint32 size,
 								 guint16 packet_id, size_t *packet_size);
@@ -356,6 +418,18 @@ ArvGvcpPacket * 	arv_gvcp_packet_new_discovery_ack 	(guint16 packet_id, size_t *
 ArvGvcpPacket * 	arv_gvcp_packet_new_packet_resend_cmd 	(guint32 frame_id,
 								 guint32 first_block, guint32 last_block,
 								 guint16 packet_id, size_t *packet_size);
+ArvGvcpPacket * 	arv_gvcp_packet_new_action_cmd 		(guint32 device_key, guint32 group_key,
+								 guint32 group_mask, guint64 action_time,
+								 gboolean ack_required,
+								 guint16 packet_id, size_t *packet_size);
+ArvGvcpPacket * 	arv_gvcp_packet_new_action_ack 		(ArvGvcpError status,
+								 guint16 packet_id, size_t *packet_size);
+ArvGvcpPacket * 	arv_gvcp_packet_new_event_cmd 		(guint16 event_id, guint16 stream_channel_index,
+								 guint16 block_id, guint64 timestamp,
+								 const void *data, size_t data_size,
+								 guint16 packet_id, size_t *packet_size);
+ArvGvcpPacket * 	arv_gvcp_packet_new_event_ack 		(ArvGvcpCommand command,
+								 guint16 packet_id, size_t *packet_size);
 
 const char *		arv_gvcp_packet_type_to_string 		(ArvGvcpPacketType value);
 const char * 		arv_gvcp_command_to_string 		(ArvGvcpCommand value);
@@ -534,6 +608,140 @@ arv_gvcp_packet_get_write_register_ack_size (void)
 	return sizeof (ArvGvcpHeader) + sizeof (guint32);
 }
 
+/**
+ * arv_gvcp_packet_get_action_cmd_infos:
+ * @packet: a #ArvGvcpPacket
+ * @device_key: (out) (optional): device key
+ * @group_key: (out) (optional): group key
+ * @group_mask: (out) (optional): group mask
+ * @action_time: (out) (optional): scheduled action time, 0 if the action is not scheduled
+ *
+ * Since: 0.8.0
+ */
+
+static inline void
+arv_gvcp_packet_get_action_cmd_infos (const ArvGvcpPacket *packet,
+				      guint32 *device_key, guint32 *group_key, guint32 *group_mask,
+				      guint64 *action_time)
+{
+	const char *data;
+
+	if (packet == NULL) {
+		if (device_key != NULL)
+			*device_key = 0;
+		if (group_key != NULL)
+			*group_key = 0;
+		if (group_mask != NULL)
+			*group_mask = 0;
+		if (action_time != NULL)
+			*action_time = 0;
+		return;
+	}
+
+	data = (const char *) packet + sizeof (ArvGvcpPacket);
+
+	if (device_key != NULL)
+		*device_key = g_ntohl (*((guint32 *) data));
+	if (group_key != NULL)
+		*group_key = g_ntohl (*((guint32 *) (data + sizeof (guint32))));
+	if (group_mask != NULL)
+		*group_mask = g_ntohl (*((guint32 *) (data + 2 * sizeof (guint32))));
+	if (action_time != NULL) {
+		if ((packet->header.packet_flags & ARV_GVCP_ACTION_PACKET_FLAGS_SCHEDULED) != 0 &&
+		    g_ntohs (packet->header.size) >= 3 * sizeof (guint32) + sizeof (guint64))
+			*action_time = GUINT64_FROM_BE (*((guint64 *) (data + 3 * sizeof (guint32))));
+		else
+			*action_time = 0;
+	}
+}
+
+/**
+ * arv_gvcp_packet_get_n_events:
+ * @packet: a EVENT or EVENTDATA #ArvGvcpPacket
+ *
+ * Returns: The number of event items contained in @packet.
+ *
+ * Since: 0.8.0
+ */
+
+static inline guint
+arv_gvcp_packet_get_n_events (const ArvGvcpPacket *packet)
+{
+	size_t item_size;
+	size_t size;
+
+	if (packet == NULL)
+		return 0;
+
+	item_size = (packet->header.packet_flags & ARV_GVCP_EVENT_PACKET_FLAGS_64BIT_ID) != 0 ?
+		ARV_GVCP_EVENT_ITEM_EXTENDED_ID_SIZE : sizeof (ArvGvcpEventItem);
+	size = g_ntohs (packet->header.size);
+
+	if (g_ntohs (packet->header.command) == ARV_GVCP_COMMAND_EVENTDATA_CMD)
+		return size >= item_size ? 1 : 0;
+
+	return size / item_size;
+}
+
+/**
+ * arv_gvcp_packet_get_event_infos:
+ * @packet: a EVENT or EVENTDATA #ArvGvcpPacket
+ * @index: event item index
+ * @event_id: (out) (optional): event identifier
+ * @stream_channel_index: (out) (optional): related stream channel
+ * @block_id: (out) (optional): related block id
+ * @timestamp: (out) (optional): event timestamp
+ * @data: (out) (optional): event data, %NULL for EVENT items
+ * @data_size: (out) (optional): event data size
+ *
+ * Returns: a pointer to the raw event item, including its header, which is what is exposed to the event ports of the
+ * Genicam data, or %NULL if @index is out of range.
+ *
+ * Since: 0.8.0
+ */
+
+static inline const void *
+arv_gvcp_packet_get_event_infos (const ArvGvcpPacket *packet, guint index,
+				 guint16 *event_id, guint16 *stream_channel_index, guint64 *block_id,
+				 guint64 *timestamp, const void **data, size_t *data_size)
+{
+	const char *item;
+	size_t item_size;
+	gboolean is_extended_id;
+
+	if (index >= arv_gvcp_packet_get_n_events (packet))
+		return NULL;
+
+	is_extended_id = (packet->header.packet_flags & ARV_GVCP_EVENT_PACKET_FLAGS_64BIT_ID) != 0;
+	item_size = is_extended_id ? ARV_GVCP_EVENT_ITEM_EXTENDED_ID_SIZE : sizeof (ArvGvcpEventItem);
+	item = (const char *) packet + sizeof (ArvGvcpHeader) + index * item_size;
+
+	if (event_id != NULL)
+		*event_id = g_ntohs (*((guint16 *) (item + 2)));
+	if (stream_channel_index != NULL)
+		*stream_channel_index = g_ntohs (*((guint16 *) (item + 4)));
+	if (block_id != NULL)
+		*block_id = is_extended_id ?
+			GUINT64_FROM_BE (*((guint64 *) (item + 8))) :
+			g_ntohs (*((guint16 *) (item + 6)));
+	if (timestamp != NULL)
+		*timestamp = GUINT64_FROM_BE (*((guint64 *) (item + item_size - sizeof (guint64))));
+
+	if (g_ntohs (packet->header.command) == ARV_GVCP_COMMAND_EVENTDATA_CMD) {
+		if (data != NULL)
+			*data = item + item_size;
+		if (data_size != NULL)
+			*data_size = g_ntohs (packet->header.size) - item_size;
+	} else {
+		if (data != NULL)
+			*data = NULL;
+		if (data_size != NULL)
+			*data_size = 0;
+	}
+
+	return item;
+}
+
 static inline guint16
 arv_gvcp_next_packet_id (guint16 packet_id)
 {
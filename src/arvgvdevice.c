@@ -30,6 +30,7 @@
 #include <arvgc.h>
 #include <arvgccommand.h>
 #include <arvgcboolean.h>
+#include <arvgcinteger.h>
 #include <arvgcregisterdescriptionnode.h>
 #include <arvdebug.h>
 #include <arvgvstreamprivate.h>
@@ -38,6 +39,7 @@
 #include <arvzip.h>
 #include <arvstr.h>
 #include <arvmisc.h>
+#include <arvwakeupprivate.h>
 #include <arvenumtypes.h>
 #include <string.h>
 #include <stdlib.h>
@@ -45,6 +47,18 @@
 #include <linux/ip.h>
 #endif
 #include <netinet/udp.h>
+#include <sys/ioctl.h>
+#include <net/if.h>
+#include <ifaddrs.h>
+#include <unistd.h>
+#include <errno.h>
+
+enum {
+	ARV_GV_DEVICE_SIGNAL_EVENT,
+	ARV_GV_DEVICE_SIGNAL_LAST
+};
+
+static guint arv_gv_device_signals[ARV_GV_DEVICE_SIGNAL_LAST] = {0};
 
 /* Shared data (main thread - heartbeat) */
 
@@ -98,6 +112,9 @@ typedef struct {
 	void *heartbeat_thread;
 	void *heartbeat_data;
 
+	void *message_thread;
+	void *message_data;
+
 	ArvGc *genicam;
 
 	char *genicam_xml;
@@ -107,6 +124,11 @@ typedef struct {
 	gboolean is_write_memory_supported;
 
 	ArvGvStreamOption stream_options;
+
+	/* Constant, only read once for the timestamp latches */
+	guint64 timestamp_tick_frequency;
+
+	guint64 open_phase_durations[ARV_GV_DEVICE_N_OPEN_PHASES];
 } ArvGvDevicePrivate ;
 
 struct _ArvGvDevice {
@@ -122,13 +144,18 @@ struct _ArvGvDeviceClass {
 GRegex *
 arv_gv_device_get_url_regex (void)
 {
-static GRegex *arv_gv_device_url_regex = NULL;
+	static gsize arv_gv_device_url_regex = 0;
+
+	if (g_once_init_enter (&arv_gv_device_url_regex)) {
+		GRegex *regex;
 
-	if (arv_gv_device_url_regex == NULL)
-		arv_gv_device_url_regex = g_regex_new ("^(local:|file:|http:)(.+\\.[^;]+);?(?:0x)?([0-9:a-f]*)?;?(?:0x)?([0-9:a-f]*)?$",
-						       G_REGEX_CASELESS, 0, NULL);
+		regex = g_regex_new ("^(local:|file:|http:)(.+\\.[^;]+);?(?:0x)?([0-9:a-f]*)?;?(?:0x)?([0-9:a-f]*)?$",
+				     G_REGEX_CASELESS, 0, NULL);
 
-	return arv_gv_device_url_regex;
+		g_once_init_leave (&arv_gv_device_url_regex, (gsize) regex);
+	}
+
+	return (GRegex *) arv_gv_device_url_regex;
 }
 
 static gboolean
@@ -378,6 +405,7 @@ typedef struct {
 	ArvGvDeviceIOData *io_data;
 	int period_us;
 	gboolean cancel;
+	gboolean clock_sampling;
 } ArvGvDeviceHeartbeatData;
 
 static void *
@@ -386,6 +414,7 @@ arv_gv_device_heartbeat_thread (void *data)
 	ArvGvDeviceHeartbeatData *thread_data = data;
 	ArvGvDeviceIOData *io_data = thread_data->io_data;
 	GTimer *timer;
+	gint64 next_clock_sample_time_us = 0;
 	guint32 value;
 
 	timer = g_timer_new ();
@@ -425,6 +454,21 @@ arv_gv_device_heartbeat_thread (void *data)
 				}
 			} else
 				io_data->is_controller = FALSE;
+
+			/* Timestamp latches only use bootstrap registers, they can safely be done from this thread. They
+			 * are done less often than the heartbeat, in order to limit the delay added to the control
+			 * channel transactions of the application. */
+			if (io_data->is_controller && g_atomic_int_get (&thread_data->clock_sampling) &&
+			    g_get_monotonic_time () >= next_clock_sample_time_us) {
+				GError *error = NULL;
+
+				next_clock_sample_time_us = g_get_monotonic_time () + ARV_GV_DEVICE_CLOCK_SAMPLING_PERIOD_US;
+
+				if (!arv_device_sample_clock (ARV_DEVICE (thread_data->gv_device), &error)) {
+					arv_warning_device ("[GvDevice::Heartbeat] Clock sampling failed: %s", error->message);
+					g_clear_error (&error);
+				}
+			}
 		}
 	} while (!g_atomic_int_get (&thread_data->cancel));
 
@@ -433,6 +477,289 @@ arv_gv_device_heartbeat_thread (void *data)
 	return NULL;
 }
 
+/* Message channel thread */
+
+typedef struct {
+	ArvGvDevice *gv_device;
+
+	GSocket *socket;
+	ArvWakeup *wakeup;
+
+	gboolean cancel;
+
+	gboolean has_last_packet_id;
+	guint16 last_packet_id;
+
+	guint64 n_events;
+	guint64 n_duplicated_messages;
+	guint64 n_ignored_packets;
+} ArvGvDeviceMessageData;
+
+static void
+_process_message (ArvGvDeviceMessageData *thread_data, ArvGvcpPacket *packet, size_t read_count,
+		  GSocketAddress *sender_address)
+{
+	ArvGvcpCommand command;
+	guint16 packet_id;
+	guint n_events;
+	guint i;
+
+	if (read_count < sizeof (ArvGvcpHeader) ||
+	    arv_gvcp_packet_get_packet_type (packet) != ARV_GVCP_PACKET_TYPE_CMD ||
+	    sizeof (ArvGvcpHeader) + g_ntohs (packet->header.size) > read_count) {
+		thread_data->n_ignored_packets++;
+		return;
+	}
+
+	command = arv_gvcp_packet_get_command (packet);
+	if (command != ARV_GVCP_COMMAND_EVENT_CMD &&
+	    command != ARV_GVCP_COMMAND_EVENTDATA_CMD) {
+		thread_data->n_ignored_packets++;
+		return;
+	}
+
+	arv_gvcp_packet_debug (packet, ARV_DEBUG_LEVEL_LOG);
+
+	packet_id = arv_gvcp_packet_get_packet_id (packet);
+
+	if ((arv_gvcp_packet_get_packet_flags (packet) & ARV_GVCP_CMD_PACKET_FLAGS_ACK_REQUIRED) != 0 &&
+	    sender_address != NULL) {
+		ArvGvcpPacket *ack_packet;
+		size_t ack_size;
+
+		ack_packet = arv_gvcp_packet_new_event_ack (command == ARV_GVCP_COMMAND_EVENT_CMD ?
+							    ARV_GVCP_COMMAND_EVENT_ACK :
+							    ARV_GVCP_COMMAND_EVENTDATA_ACK,
+							    packet_id, &ack_size);
+		g_socket_send_to (thread_data->socket, sender_address, (const char *) ack_packet, ack_size, NULL, NULL);
+		arv_gvcp_packet_free (ack_packet);
+	}
+
+	/* The device resends the message if our acknowledge was lost */
+	if (thread_data->has_last_packet_id && packet_id == thread_data->last_packet_id) {
+		thread_data->n_duplicated_messages++;
+		return;
+	}
+
+	thread_data->has_last_packet_id = TRUE;
+	thread_data->last_packet_id = packet_id;
+
+	n_events = arv_gvcp_packet_get_n_events (packet);
+
+	for (i = 0; i < n_events; i++) {
+		const void *item;
+		const void *data;
+		size_t data_size;
+		guint16 event_id;
+		guint16 stream_channel_index;
+		guint64 block_id;
+		guint64 timestamp;
+		GBytes *bytes;
+
+		item = arv_gvcp_packet_get_event_infos (packet, i, &event_id, &stream_channel_index, &block_id,
+							&timestamp, &data, &data_size);
+		if (item == NULL)
+			break;
+
+		arv_log_device ("[GvDevice::process_message] Event 0x%04x - block id %" G_GUINT64_FORMAT
+				" - timestamp %" G_GUINT64_FORMAT, event_id, block_id, timestamp);
+
+		/* Event ports expose the event item, including its header */
+		if (ARV_IS_GC (thread_data->gv_device->priv->genicam))
+			arv_gc_set_event_data (thread_data->gv_device->priv->genicam, event_id, item,
+					       (const char *) packet + sizeof (ArvGvcpHeader) +
+					       g_ntohs (packet->header.size) - (const char *) item);
+
+		bytes = g_bytes_new (data, data_size);
+		g_signal_emit (thread_data->gv_device, arv_gv_device_signals[ARV_GV_DEVICE_SIGNAL_EVENT], 0,
+			       (guint) event_id, (guint) stream_channel_index, block_id, timestamp, bytes);
+		g_bytes_unref (bytes);
+
+		thread_data->n_events++;
+	}
+}
+
+static void *
+arv_gv_device_message_thread (void *data)
+{
+	ArvGvDeviceMessageData *thread_data = data;
+	ArvGvcpPacket *packet;
+	GPollFD poll_fd[2];
+
+	poll_fd[0].fd = g_socket_get_fd (thread_data->socket);
+	poll_fd[0].events =  G_IO_IN;
+	poll_fd[0].revents = 0;
+
+	arv_wakeup_get_pollfd (thread_data->wakeup, &poll_fd[1]);
+
+	packet = g_malloc0 (ARV_GV_DEVICE_BUFFER_SIZE);
+
+	do {
+		int n_events;
+		int errsv;
+
+		do {
+			poll_fd[0].revents = 0;
+
+			n_events = g_poll (poll_fd, 2, -1);
+			errsv = errno;
+		} while (n_events < 0 && errsv == EINTR);
+
+		if (poll_fd[0].revents != 0) {
+			GSocketAddress *sender_address = NULL;
+			gssize read_count;
+
+			read_count = g_socket_receive_from (thread_data->socket, &sender_address, (char *) packet,
+							    ARV_GV_DEVICE_BUFFER_SIZE, NULL, NULL);
+			if (read_count > 0)
+				_process_message (thread_data, packet, read_count, sender_address);
+
+			g_clear_object (&sender_address);
+		}
+	} while (!g_atomic_int_get (&thread_data->cancel));
+
+	g_free (packet);
+
+	return NULL;
+}
+
+/**
+ * arv_gv_device_enable_events:
+ * @gv_device: a #ArvGvDevice
+ * @error: a #GError placeholder
+ *
+ * Configures the first message channel of @gv_device to send its EVENT and EVENTDATA messages to the host, and starts
+ * a thread receiving them. The data of each event are made available to the Genicam event features, and
+ * #ArvGvDevice::event is emitted. The events themselves still have to be enabled on the device side, usually using the
+ * EventSelector and EventNotification features.
+ *
+ * Control access is required.
+ *
+ * Returns: %TRUE on success.
+ *
+ * Since: 0.8.0
+ */
+
+gboolean
+arv_gv_device_enable_events (ArvGvDevice *gv_device, GError **error)
+{
+	ArvGvDeviceIOData *io_data;
+	ArvGvDeviceMessageData *message_data;
+	GSocketAddress *local_address;
+	GInetAddress *interface_address;
+	GError *local_error = NULL;
+	guint32 n_message_channels = 0;
+	guint16 port;
+
+	g_return_val_if_fail (ARV_IS_GV_DEVICE (gv_device), FALSE);
+
+	io_data = gv_device->priv->io_data;
+
+	if (gv_device->priv->message_thread != NULL)
+		return TRUE;
+
+	if (!io_data->is_controller) {
+		g_set_error (error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_PROTOCOL_ERROR,
+			     "Control access is required for event reception");
+		return FALSE;
+	}
+
+	if (!arv_device_read_register (ARV_DEVICE (gv_device), ARV_GVBS_N_MESSAGE_CHANNELS_OFFSET,
+				       &n_message_channels, error))
+		return FALSE;
+
+	if (n_message_channels < 1) {
+		g_set_error (error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_PROTOCOL_ERROR,
+			     "Device has no message channel");
+		return FALSE;
+	}
+
+	message_data = g_new0 (ArvGvDeviceMessageData, 1);
+	message_data->gv_device = gv_device;
+	message_data->cancel = FALSE;
+	message_data->socket = g_socket_new (G_SOCKET_FAMILY_IPV4, G_SOCKET_TYPE_DATAGRAM, G_SOCKET_PROTOCOL_UDP,
+					     &local_error);
+
+	if (local_error == NULL)
+		g_socket_bind (message_data->socket, io_data->interface_address, FALSE, &local_error);
+
+	if (local_error != NULL) {
+		g_clear_object (&message_data->socket);
+		g_free (message_data);
+		g_propagate_error (error, local_error);
+		return FALSE;
+	}
+
+	local_address = g_socket_get_local_address (message_data->socket, NULL);
+	port = g_inet_socket_address_get_port (G_INET_SOCKET_ADDRESS (local_address));
+	g_object_unref (local_address);
+
+	interface_address = g_inet_socket_address_get_address (G_INET_SOCKET_ADDRESS (io_data->interface_address));
+
+	if (!arv_device_write_register (ARV_DEVICE (gv_device), ARV_GVBS_MESSAGE_CHANNEL_0_IP_ADDRESS_OFFSET,
+					g_htonl (*((guint32 *) g_inet_address_to_bytes (interface_address))),
+					&local_error) ||
+	    !arv_device_write_register (ARV_DEVICE (gv_device), ARV_GVBS_MESSAGE_CHANNEL_0_PORT_OFFSET,
+					port, &local_error)) {
+		g_object_unref (message_data->socket);
+		g_free (message_data);
+		g_propagate_error (error, local_error);
+		return FALSE;
+	}
+
+	arv_debug_device ("[GvDevice::enable_events] Message channel port = %d", port);
+
+	message_data->wakeup = arv_wakeup_new ();
+
+	gv_device->priv->message_data = message_data;
+	gv_device->priv->message_thread = g_thread_new ("arv_gv_message", arv_gv_device_message_thread,
+							message_data);
+
+	return TRUE;
+}
+
+/**
+ * arv_gv_device_disable_events:
+ * @gv_device: a #ArvGvDevice
+ *
+ * Stops the event reception started by arv_gv_device_enable_events(), and disables the device message channel.
+ *
+ * Since: 0.8.0
+ */
+
+void
+arv_gv_device_disable_events (ArvGvDevice *gv_device)
+{
+	ArvGvDeviceMessageData *message_data;
+
+	g_return_if_fail (ARV_IS_GV_DEVICE (gv_device));
+
+	if (gv_device->priv->message_thread == NULL)
+		return;
+
+	message_data = gv_device->priv->message_data;
+
+	if (gv_device->priv->io_data->is_controller)
+		arv_device_write_register (ARV_DEVICE (gv_device), ARV_GVBS_MESSAGE_CHANNEL_0_PORT_OFFSET, 0, NULL);
+
+	g_atomic_int_set (&message_data->cancel, TRUE);
+	arv_wakeup_signal (message_data->wakeup);
+	g_thread_join (gv_device->priv->message_thread);
+
+	arv_debug_device ("[GvDevice::disable_events] n_events = %" G_GUINT64_FORMAT
+			  " - n_duplicated_messages = %" G_GUINT64_FORMAT
+			  " - n_ignored_packets = %" G_GUINT64_FORMAT,
+			  message_data->n_events, message_data->n_duplicated_messages,
+			  message_data->n_ignored_packets);
+
+	arv_wakeup_free (message_data->wakeup);
+	g_object_unref (message_data->socket);
+	g_free (message_data);
+
+	gv_device->priv->message_data = NULL;
+	gv_device->priv->message_thread = NULL;
+}
+
 /* ArvGvDevice implemenation */
 
 static gboolean
@@ -512,6 +839,158 @@ arv_gv_device_set_packet_size (ArvGvDevice *gv_device, gint packet_size, GError
 	arv_device_set_integer_feature_value (ARV_DEVICE (gv_device), "GevSCPSPacketSize", packet_size, error);
 }
 
+/* Process wide packet size cache, indexed by interface address and device MAC address */
+
+static GMutex packet_size_cache_mutex;
+static GHashTable *packet_size_cache = NULL;
+
+static char *
+_get_packet_size_cache_key (ArvGvDevice *gv_device)
+{
+	ArvGvDeviceIOData *io_data = gv_device->priv->io_data;
+	GInetAddress *interface_address;
+	char *interface_string;
+	char *key;
+	guint32 mac_high;
+	guint32 mac_low;
+
+	if (!_read_register (io_data, ARV_GVBS_DEVICE_MAC_ADDRESS_HIGH_OFFSET, &mac_high, NULL) ||
+	    !_read_register (io_data, ARV_GVBS_DEVICE_MAC_ADDRESS_LOW_OFFSET, &mac_low, NULL))
+		return NULL;
+
+	interface_address = g_inet_socket_address_get_address (G_INET_SOCKET_ADDRESS (io_data->interface_address));
+	interface_string = g_inet_address_to_string (interface_address);
+	key = g_strdup_printf ("%s/%04x%08x", interface_string, mac_high & 0xffff, mac_low);
+	g_free (interface_string);
+
+	return key;
+}
+
+static guint
+_get_cached_packet_size (const char *key)
+{
+	guint packet_size = 0;
+
+	g_mutex_lock (&packet_size_cache_mutex);
+	if (packet_size_cache != NULL)
+		packet_size = GPOINTER_TO_UINT (g_hash_table_lookup (packet_size_cache, key));
+	g_mutex_unlock (&packet_size_cache_mutex);
+
+	return packet_size;
+}
+
+/* A packet size of 0 removes the cache entry */
+
+static void
+_set_cached_packet_size (const char *key, guint packet_size)
+{
+	g_mutex_lock (&packet_size_cache_mutex);
+	if (packet_size == 0) {
+		if (packet_size_cache != NULL)
+			g_hash_table_remove (packet_size_cache, key);
+	} else {
+		if (packet_size_cache == NULL)
+			packet_size_cache = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+		g_hash_table_replace (packet_size_cache, g_strdup (key), GUINT_TO_POINTER (packet_size));
+	}
+	g_mutex_unlock (&packet_size_cache_mutex);
+}
+
+void
+arv_gv_device_clear_packet_size_cache (void)
+{
+	g_mutex_lock (&packet_size_cache_mutex);
+	g_clear_pointer (&packet_size_cache, g_hash_table_unref);
+	g_mutex_unlock (&packet_size_cache_mutex);
+}
+
+/* The MTU of the interface is the upper bound of the path MTU, and the actual path MTU in most setups */
+
+static guint
+_get_interface_mtu (GInetAddress *interface_address)
+{
+	guint mtu = 0;
+#ifdef SIOCGIFMTU
+	struct ifaddrs *ifap = NULL;
+	struct ifaddrs *ifap_iter;
+
+	if (getifaddrs (&ifap) < 0)
+		return 0;
+
+	for (ifap_iter = ifap; ifap_iter != NULL; ifap_iter = ifap_iter->ifa_next) {
+		if (ifap_iter->ifa_addr != NULL &&
+		    ifap_iter->ifa_addr->sa_family == AF_INET &&
+		    memcmp (&((struct sockaddr_in *) ifap_iter->ifa_addr)->sin_addr,
+			    g_inet_address_to_bytes (interface_address), 4) == 0) {
+			struct ifreq ifr;
+			int fd;
+
+			fd = socket (AF_INET, SOCK_DGRAM, 0);
+			if (fd >= 0) {
+				memset (&ifr, 0, sizeof (ifr));
+				g_strlcpy (ifr.ifr_name, ifap_iter->ifa_name, IFNAMSIZ);
+				if (ioctl (fd, SIOCGIFMTU, &ifr) == 0)
+					mtu = ifr.ifr_mtu;
+				close (fd);
+			}
+			break;
+		}
+	}
+
+	freeifaddrs (ifap);
+#endif
+	return mtu;
+}
+
+typedef struct {
+	ArvGcNode *packet_size_node;
+	ArvGcNode *fire_test_packet_node;
+	GSocket *socket;
+	GPollFD poll_fd;
+	char *buffer;
+	size_t buffer_size;
+} ArvGvDevicePacketSizeProbe;
+
+/* Sets the packet size, rounded by the device, and checks a test packet of this size gets through */
+
+static gboolean
+_probe_packet_size (ArvGvDevicePacketSizeProbe *probe, guint *size)
+{
+	unsigned int n_tries = 0;
+	size_t read_count = 0;
+	int n_events;
+
+	arv_gc_integer_set_value (ARV_GC_INTEGER (probe->packet_size_node), *size, NULL);
+	*size = arv_gc_integer_get_value (ARV_GC_INTEGER (probe->packet_size_node), NULL);
+
+	arv_debug_device ("[GvDevice::auto_packet_size] Try packet size = %d", *size);
+
+	do {
+		if (ARV_IS_GC_COMMAND (probe->fire_test_packet_node)) {
+			arv_gc_command_execute (ARV_GC_COMMAND (probe->fire_test_packet_node), NULL);
+		} else {
+			arv_gc_boolean_set_value (ARV_GC_BOOLEAN (probe->fire_test_packet_node), FALSE, NULL);
+			arv_gc_boolean_set_value (ARV_GC_BOOLEAN (probe->fire_test_packet_node), TRUE, NULL);
+		}
+
+		do {
+			n_events = g_poll (&probe->poll_fd, 1, 10);
+			if (n_events != 0)
+				read_count = g_socket_receive (probe->socket, probe->buffer, probe->buffer_size, NULL, NULL);
+			else
+				read_count = 0;
+			/* Discard late packets, read_count should be equal to packet size minus IP and UDP headers */
+		} while (n_events != 0 && read_count != (*size - sizeof (struct iphdr) - sizeof (struct udphdr)));
+
+		n_tries++;
+	} while (n_events == 0 && n_tries < 3);
+
+	if (n_events != 0)
+		arv_debug_device ("[GvDevice::auto_packet_size] Received %d bytes", (int) read_count);
+
+	return n_events != 0;
+}
+
 /**
  * arv_gv_device_auto_packet_size:
  * @gv_device: a #ArvGvDevice
@@ -522,6 +1001,13 @@ arv_gv_device_set_packet_size (ArvGvDevice *gv_device, gint packet_size, GError
  * on the GevSCPSFireTestPacket feature. If this feature is not available, the
  * packet size will be set to a default value (1500 bytes).
  *
+ * The MTU of the network interface is tried first, and a binary search is
+ * only done if the corresponding test packet does not get through. The
+ * result is cached for the lifetime of the process, indexed by interface
+ * and device MAC address, and subsequent calls for the same device only
+ * confirm the cached value with a single test packet. Only a size confirmed
+ * by a test packet is cached.
+ *
  * Returns: The packet size, in bytes.
  *
  * Since: 0.6.0
@@ -532,36 +1018,42 @@ arv_gv_device_auto_packet_size (ArvGvDevice *gv_device, GError **error)
 {
 	ArvDevice *device = ARV_DEVICE (gv_device);
 	ArvGvDeviceIOData *io_data = gv_device->priv->io_data;
-	ArvGcNode *node;
-	GSocket *socket;
+	ArvGvDevicePacketSizeProbe probe;
 	GInetAddress *interface_address;
 	GSocketAddress *interface_socket_address;
 	GInetSocketAddress *local_address;
-	GPollFD poll_fd;
 	const guint8 *address_bytes;
 	guint16 port;
 	gboolean do_not_fragment;
-	gboolean is_command;
-	int n_events;
 	guint max_size, min_size, current_size;
 	guint packet_size = 1500;
 	gint64 minimum, maximum;
 	guint inc;
-	char *buffer;
+	guint mtu;
 	guint last_size = 0;
+	gboolean is_confirmed = FALSE;
+	char *cache_key;
+	gint64 start_time;
 
 	g_return_val_if_fail (ARV_IS_GV_DEVICE (gv_device), 1500);
 
-	node = arv_device_get_feature (device, "GevSCPSFireTestPacket");
-	if (!ARV_IS_GC_COMMAND (node) && !ARV_IS_GC_BOOLEAN (node)) {
+	probe.fire_test_packet_node = arv_device_get_feature (device, "GevSCPSFireTestPacket");
+	if (!ARV_IS_GC_COMMAND (probe.fire_test_packet_node) && !ARV_IS_GC_BOOLEAN (probe.fire_test_packet_node)) {
 		arv_debug_device ("[GvDevice::auto_packet_size] No GevSCPSFireTestPacket feature found, "
 				  "use default packet size (%d bytes)",
 				  packet_size);
 		return packet_size;
 	}
 
-	inc = MAX (1, arv_device_get_integer_feature_increment (device, "GevSCPSPacketSize", NULL));
-	arv_device_get_integer_feature_bounds (device, "GevSCPSPacketSize", &minimum, &maximum, NULL);
+	probe.packet_size_node = arv_device_get_feature (device, "GevSCPSPacketSize");
+	if (!ARV_IS_GC_INTEGER (probe.packet_size_node)) {
+		arv_warning_device ("[GvDevice::auto_packet_size] Invalid GevSCPSPacketSize feature");
+		return packet_size;
+	}
+
+	inc = MAX (1, arv_gc_integer_get_inc (ARV_GC_INTEGER (probe.packet_size_node), NULL));
+	minimum = arv_gc_integer_get_min (ARV_GC_INTEGER (probe.packet_size_node), NULL);
+	maximum = arv_gc_integer_get_max (ARV_GC_INTEGER (probe.packet_size_node), NULL);
 	max_size = MIN (65536, maximum);
 	min_size = MAX (ARV_GVSP_PACKET_PROTOCOL_OVERHEAD, minimum);
 
@@ -574,13 +1066,13 @@ arv_gv_device_auto_packet_size (ArvGvDevice *gv_device, GError **error)
 		return packet_size;
 	}
 
-	is_command = ARV_IS_GC_COMMAND (node);
+	start_time = g_get_monotonic_time ();
 
 	interface_address = g_inet_socket_address_get_address (G_INET_SOCKET_ADDRESS (io_data->interface_address));
 	interface_socket_address = g_inet_socket_address_new (interface_address, 0);
-	socket = g_socket_new (G_SOCKET_FAMILY_IPV4, G_SOCKET_TYPE_DATAGRAM, G_SOCKET_PROTOCOL_UDP, NULL);
-	g_socket_bind (socket, interface_socket_address, FALSE, NULL);
-	local_address = G_INET_SOCKET_ADDRESS (g_socket_get_local_address (socket, NULL));
+	probe.socket = g_socket_new (G_SOCKET_FAMILY_IPV4, G_SOCKET_TYPE_DATAGRAM, G_SOCKET_PROTOCOL_UDP, NULL);
+	g_socket_bind (probe.socket, interface_socket_address, FALSE, NULL);
+	local_address = G_INET_SOCKET_ADDRESS (g_socket_get_local_address (probe.socket, NULL));
 	port = g_inet_socket_address_get_port (local_address);
 
 	address_bytes = g_inet_address_to_bytes (interface_address);
@@ -593,75 +1085,74 @@ arv_gv_device_auto_packet_size (ArvGvDevice *gv_device, GError **error)
 	do_not_fragment = arv_device_get_boolean_feature_value (device, "GevSCPSDoNotFragment", NULL);
 	arv_device_set_boolean_feature_value (device, "GevSCPSDoNotFragment", TRUE, NULL);
 
-	poll_fd.fd = g_socket_get_fd (socket);
-	poll_fd.events =  G_IO_IN;
-	poll_fd.revents = 0;
-
-	current_size = 1500;
-
-	buffer = g_malloc (max_size);
-
-	do {
-		size_t read_count;
-		unsigned n_tries = 0;
-
-		current_size = ((current_size + inc - 1) / inc) * inc;
-
-		arv_debug_device ("[GvDevice::auto_packet_size] Try packet size = %d", current_size);
-		arv_device_set_integer_feature_value (device, "GevSCPSPacketSize", current_size, NULL);
-
-		current_size = arv_device_get_integer_feature_value(device, "GevSCPSPacketSize", NULL);
-
-		if (current_size == last_size)
-			break;
+	probe.poll_fd.fd = g_socket_get_fd (probe.socket);
+	probe.poll_fd.events =  G_IO_IN;
+	probe.poll_fd.revents = 0;
+
+	probe.buffer_size = max_size;
+	probe.buffer = g_malloc (probe.buffer_size);
+
+	/* First candidate: the cached value, or the interface MTU */
+	cache_key = _get_packet_size_cache_key (gv_device);
+	current_size = cache_key != NULL ? _get_cached_packet_size (cache_key) : 0;
+	if (current_size != 0) {
+		arv_debug_device ("[GvDevice::auto_packet_size] Cached packet size for %s = %d", cache_key, current_size);
+	} else {
+		mtu = _get_interface_mtu (interface_address);
+		arv_debug_device ("[GvDevice::auto_packet_size] Interface MTU = %d", mtu);
+		current_size = mtu >= min_size ? MIN (mtu, max_size) : max_size;
+	}
+	current_size = (current_size / inc) * inc;
 
-		last_size = current_size;
+	if (_probe_packet_size (&probe, &current_size)) {
+		packet_size = current_size;
+		is_confirmed = TRUE;
+	} else {
+		/* Binary search below the failed candidate, starting with the standard Ethernet MTU when it is
+		 * smaller */
+		max_size = current_size;
+		current_size = 1500 < max_size ? 1500 : (max_size - min_size) / 2 + min_size;
 
 		do {
-			if (is_command) {
-				arv_device_execute_command (device, "GevSCPSFireTestPacket", NULL);
+			current_size = ((current_size + inc - 1) / inc) * inc;
+
+			if (_probe_packet_size (&probe, &current_size)) {
+				packet_size = current_size;
+				min_size = current_size;
+				is_confirmed = TRUE;
 			} else {
-				arv_device_set_boolean_feature_value (device, "GevSCPSFireTestPacket", FALSE, NULL);
-				arv_device_set_boolean_feature_value (device, "GevSCPSFireTestPacket", TRUE, NULL);
+				max_size = current_size;
 			}
 
-			do {
-				n_events = g_poll (&poll_fd, 1, 10);
-				if (n_events != 0)
-					read_count = g_socket_receive (socket, buffer, 16384, NULL, NULL);
-				else
-					read_count = 0;
-				/* Discard late packets, read_count should be equal to packet size minus IP and UDP headers */
-			} while (n_events != 0 && read_count != (current_size - sizeof (struct iphdr) - sizeof (struct udphdr)));
-
-			n_tries++;
-		} while (n_events == 0 && n_tries < 3);
-
-		if (n_events != 0) {
-			arv_debug_device ("[GvDevice::auto_packet_size] Received %d bytes", (int) read_count);
+			if (current_size == last_size)
+				break;
 
-			packet_size = current_size;
-			min_size = current_size;
-			current_size = (max_size - min_size) / 2 + min_size;
-		} else {
-			max_size = current_size;
+			last_size = current_size;
 			current_size = (max_size - min_size) / 2 + min_size;
-		}
-	} while ((max_size - min_size) > 16);
+		} while ((max_size - min_size) > 16);
+	}
+
+	g_clear_pointer (&probe.buffer, g_free);
+	g_clear_object (&probe.socket);
 
-	g_clear_pointer (&buffer, g_free);
-	g_clear_object (&socket);
+	/* Only a size confirmed by a test packet is cached, a stale entry is dropped if none got through */
+	if (cache_key != NULL)
+		_set_cached_packet_size (cache_key, is_confirmed ? packet_size : 0);
+	g_free (cache_key);
 
-	arv_debug_device ("[GvDevice::auto_packet_size] Packet size set to %d bytes", packet_size);
+	arv_debug_device ("[GvDevice::auto_packet_size] Packet size set to %d bytes in %" G_GINT64_FORMAT " ms",
+			  packet_size, (g_get_monotonic_time () - start_time) / 1000);
 
 	arv_device_set_boolean_feature_value (device, "GevSCPSDoNotFragment", do_not_fragment, NULL);
-	arv_device_set_integer_feature_value (device, "GevSCPSPacketSize", packet_size, NULL);
+	arv_gc_integer_set_value (ARV_GC_INTEGER (probe.packet_size_node), packet_size, NULL);
 
 	return packet_size;
 }
 
+/* The xml url stored at @address is read from the device, unless it is given in @url */
+
 static char *
-_load_genicam (ArvGvDevice *gv_device, guint32 address, size_t  *size)
+_load_genicam (ArvGvDevice *gv_device, guint32 address, const char *url, size_t  *size, ArvGc **genicam_out)
 {
 	char filename[ARV_GVBS_XML_URL_SIZE];
 	char **tokens;
@@ -671,7 +1162,9 @@ _load_genicam (ArvGvDevice *gv_device, guint32 address, size_t  *size)
 
 	*size = 0;
 
-	if (!arv_device_read_memory (ARV_DEVICE (gv_device), address, ARV_GVBS_XML_URL_SIZE, filename, NULL))
+	if (url != NULL)
+		g_strlcpy (filename, url, ARV_GVBS_XML_URL_SIZE);
+	else if (!arv_device_read_memory (ARV_DEVICE (gv_device), address, ARV_GVBS_XML_URL_SIZE, filename, NULL))
 		return NULL;
 
 	filename[ARV_GVBS_XML_URL_SIZE - 1] = '\0';
@@ -699,6 +1192,17 @@ _load_genicam (ArvGvDevice *gv_device, guint32 address, size_t  *size)
 			arv_debug_device ("[GvDevice::load_genicam] Xml address = 0x%x - size = 0x%x - %s",
 					  file_address, file_size, tokens[2]);
 
+			/* Zipped data are inflated and parsed while being read from the device memory. If it fails,
+			 * fall back to a full download followed by decompression. */
+			if (file_size > 0 && g_str_has_suffix (tokens[2], ".zip")) {
+				genicam = arv_device_load_zipped_genicam (ARV_DEVICE (gv_device), file_address, file_size,
+									  size, genicam_out);
+				if (genicam != NULL) {
+					g_strfreev (tokens);
+					return genicam;
+				}
+			}
+
 			if (file_size > 0) {
 				genicam = g_malloc (file_size);
 				if (arv_device_read_memory (ARV_DEVICE (gv_device), file_address, file_size,
@@ -776,23 +1280,220 @@ _load_genicam (ArvGvDevice *gv_device, guint32 address, size_t  *size)
 	return genicam;
 }
 
-static const char *
-arv_gv_device_get_genicam_xml (ArvDevice *device, size_t *size)
+/* Process wide Genicam data cache
+ *
+ * While retained, devices reporting the same model name, device version and xml url share a single download of the
+ * Genicam data. The first device to request a given xml performs the download, the other ones wait for its
+ * completion and get a copy. The parsed document can not be shared, as its nodes are bound to a device, but the
+ * download is by far the slowest part of the device instantiation. */
+
+typedef struct {
+	char *xml;
+	size_t size;
+	gboolean is_loading;
+} ArvGvDeviceGenicamCacheEntry;
+
+static GMutex genicam_cache_mutex;
+static GCond genicam_cache_cond;
+static GHashTable *genicam_cache = NULL;
+static unsigned int genicam_cache_ref_count = 0;
+
+/* Number of successful Genicam data downloads, for the checks of the cache efficiency */
+static guint genicam_n_downloads = 0;
+
+static void
+_genicam_cache_entry_free (ArvGvDeviceGenicamCacheEntry *entry)
+{
+	if (entry == NULL)
+		return;
+
+	g_free (entry->xml);
+	g_free (entry);
+}
+
+void
+arv_gv_device_retain_genicam_cache (void)
+{
+	g_mutex_lock (&genicam_cache_mutex);
+
+	if (genicam_cache_ref_count == 0)
+		genicam_cache = g_hash_table_new_full (g_str_hash, g_str_equal, g_free,
+						       (GDestroyNotify) _genicam_cache_entry_free);
+	genicam_cache_ref_count++;
+
+	g_mutex_unlock (&genicam_cache_mutex);
+}
+
+void
+arv_gv_device_release_genicam_cache (void)
+{
+	g_mutex_lock (&genicam_cache_mutex);
+
+	if (genicam_cache_ref_count > 0) {
+		genicam_cache_ref_count--;
+		if (genicam_cache_ref_count == 0) {
+			g_clear_pointer (&genicam_cache, g_hash_table_unref);
+			/* Wake up any waiter, they will do the download themselves */
+			g_cond_broadcast (&genicam_cache_cond);
+		}
+	}
+
+	g_mutex_unlock (&genicam_cache_mutex);
+}
+
+guint
+arv_gv_device_get_n_genicam_downloads (void)
+{
+	return g_atomic_int_get (&genicam_n_downloads);
+}
+
+static char *
+_read_bootstrap_string (ArvGvDevice *gv_device, guint32 address, size_t size)
+{
+	char *string;
+
+	string = g_malloc0 (size + 1);
+	if (!arv_device_read_memory (ARV_DEVICE (gv_device), address, size, string, NULL)) {
+		g_free (string);
+		return NULL;
+	}
+
+	return string;
+}
+
+/* The cache key is made of the model name, the device version and the first xml url. The url is returned in @url, in
+ * order to not read it again for the download. */
+
+static char *
+_get_genicam_cache_key (ArvGvDevice *gv_device, char **url)
+{
+	char model_and_version[ARV_GVBS_MODEL_NAME_SIZE + ARV_GVBS_DEVICE_VERSION_SIZE];
+
+	G_STATIC_ASSERT (ARV_GVBS_MODEL_NAME_OFFSET + ARV_GVBS_MODEL_NAME_SIZE == ARV_GVBS_DEVICE_VERSION_OFFSET);
+
+	*url = _read_bootstrap_string (gv_device, ARV_GVBS_XML_URL_0_OFFSET, ARV_GVBS_XML_URL_SIZE);
+	if (*url == NULL)
+		return NULL;
+
+	/* Model name and device version are contiguous, a single read gets both */
+	if (!arv_device_read_memory (ARV_DEVICE (gv_device), ARV_GVBS_MODEL_NAME_OFFSET, sizeof (model_and_version),
+				     model_and_version, NULL))
+		return NULL;
+
+	return g_strdup_printf ("%.*s|%.*s|%s",
+				ARV_GVBS_MODEL_NAME_SIZE, model_and_version,
+				ARV_GVBS_DEVICE_VERSION_SIZE, model_and_version + ARV_GVBS_MODEL_NAME_SIZE,
+				*url);
+}
+
+static char *
+_download_genicam_xml (ArvGvDevice *gv_device, const char *url, size_t *size, ArvGc **genicam)
 {
 	char *xml;
 
-	ArvGvDevice *gv_device = ARV_GV_DEVICE (device);
+	*size = 0;
+
+	xml = _load_genicam (gv_device, ARV_GVBS_XML_URL_0_OFFSET, url, size, genicam);
+	if (xml == NULL)
+		xml = _load_genicam (gv_device, ARV_GVBS_XML_URL_1_OFFSET, NULL, size, genicam);
+
+	if (xml != NULL)
+		g_atomic_int_inc (&genicam_n_downloads);
+
+	return xml;
+}
+
+static char *
+_download_genicam_xml_cached (ArvGvDevice *gv_device, size_t *size, ArvGc **genicam)
+{
+	ArvGvDeviceGenicamCacheEntry *entry;
+	char *key;
+	char *url = NULL;
+	char *xml = NULL;
+
+	g_mutex_lock (&genicam_cache_mutex);
+	if (genicam_cache == NULL) {
+		g_mutex_unlock (&genicam_cache_mutex);
+		return _download_genicam_xml (gv_device, NULL, size, genicam);
+	}
+	g_mutex_unlock (&genicam_cache_mutex);
+
+	key = _get_genicam_cache_key (gv_device, &url);
+	if (key == NULL) {
+		xml = _download_genicam_xml (gv_device, url, size, genicam);
+		g_free (url);
+		return xml;
+	}
+
+	g_mutex_lock (&genicam_cache_mutex);
+
+	entry = genicam_cache != NULL ? g_hash_table_lookup (genicam_cache, key) : NULL;
+	while (entry != NULL && entry->is_loading) {
+		g_cond_wait (&genicam_cache_cond, &genicam_cache_mutex);
+		entry = genicam_cache != NULL ? g_hash_table_lookup (genicam_cache, key) : NULL;
+	}
+
+	if (entry != NULL) {
+		xml = g_malloc (entry->size + 1);
+		memcpy (xml, entry->xml, entry->size);
+		xml[entry->size] = '\0';
+		*size = entry->size;
+
+		g_mutex_unlock (&genicam_cache_mutex);
+
+		arv_debug_device ("[GvDevice::load_genicam] Use cached Genicam data for %s", key);
+
+		g_free (key);
+		g_free (url);
+
+		return xml;
+	}
+
+	if (genicam_cache != NULL) {
+		entry = g_new0 (ArvGvDeviceGenicamCacheEntry, 1);
+		entry->is_loading = TRUE;
+		g_hash_table_replace (genicam_cache, g_strdup (key), entry);
+	}
+
+	g_mutex_unlock (&genicam_cache_mutex);
+
+	xml = _download_genicam_xml (gv_device, url, size, genicam);
+
+	g_mutex_lock (&genicam_cache_mutex);
+
+	if (genicam_cache != NULL && g_hash_table_lookup (genicam_cache, key) != NULL) {
+		if (xml != NULL) {
+			entry = g_hash_table_lookup (genicam_cache, key);
+			entry->xml = g_malloc (*size + 1);
+			memcpy (entry->xml, xml, *size);
+			entry->xml[*size] = '\0';
+			entry->size = *size;
+			entry->is_loading = FALSE;
+		} else
+			/* Let the waiters try by themselves */
+			g_hash_table_remove (genicam_cache, key);
+	}
+
+	g_cond_broadcast (&genicam_cache_cond);
+	g_mutex_unlock (&genicam_cache_mutex);
+
+	g_free (key);
+	g_free (url);
+
+	return xml;
+}
+
+static const char *
+_get_genicam_xml (ArvGvDevice *gv_device, size_t *size, ArvGc **genicam)
+{
+	char *xml;
 
 	if (gv_device->priv->genicam_xml != NULL) {
 		*size = gv_device->priv->genicam_xml_size;
 		return gv_device->priv->genicam_xml;
 	}
 
-	*size = 0;
-
-	xml = _load_genicam (gv_device, ARV_GVBS_XML_URL_0_OFFSET, size);
-	if (xml == NULL)
-		xml = _load_genicam (gv_device, ARV_GVBS_XML_URL_1_OFFSET, size);
+	xml = _download_genicam_xml_cached (gv_device, size, genicam);
 
 	gv_device->priv->genicam_xml = xml;
 	gv_device->priv->genicam_xml_size = *size;
@@ -800,15 +1501,32 @@ arv_gv_device_get_genicam_xml (ArvDevice *device, size_t *size)
 	return xml;
 }
 
+static const char *
+arv_gv_device_get_genicam_xml (ArvDevice *device, size_t *size)
+{
+	return _get_genicam_xml (ARV_GV_DEVICE (device), size, NULL);
+}
+
 static void
 arv_gv_device_load_genicam (ArvGvDevice *gv_device)
 {
 	const char *genicam;
+	ArvGc *parsed_genicam = NULL;
 	size_t size;
+	gint64 start_time;
+
+	start_time = g_get_monotonic_time ();
+	genicam = _get_genicam_xml (gv_device, &size, &parsed_genicam);
+	gv_device->priv->open_phase_durations[ARV_GV_DEVICE_OPEN_PHASE_XML_LOAD] = g_get_monotonic_time () - start_time;
 
-	genicam = arv_gv_device_get_genicam_xml (ARV_DEVICE (gv_device), &size);
 	if (genicam != NULL) {
-		gv_device->priv->genicam = arv_gc_new (ARV_DEVICE (gv_device), genicam, size);
+		start_time = g_get_monotonic_time ();
+		if (parsed_genicam != NULL)
+			gv_device->priv->genicam = parsed_genicam;
+		else
+			gv_device->priv->genicam = arv_gc_new (ARV_DEVICE (gv_device), genicam, size);
+		gv_device->priv->open_phase_durations[ARV_GV_DEVICE_OPEN_PHASE_XML_PARSE] =
+			g_get_monotonic_time () - start_time;
 
 		arv_gc_set_default_node_data (gv_device->priv->genicam, "DeviceVendorName",
 					      "<StringReg Name=\"DeviceVendorName\">"
@@ -1132,6 +1850,79 @@ arv_gv_device_write_register (ArvDevice *device, guint64 address, guint32 value,
 	return _write_register (gv_device->priv->io_data, address, value, error);
 }
 
+static gboolean
+arv_gv_device_latch_timestamp (ArvDevice *device, GError **error)
+{
+	ArvGvDevice *gv_device = ARV_GV_DEVICE (device);
+
+	return _write_register (gv_device->priv->io_data, ARV_GVBS_TIMESTAMP_CONTROL_OFFSET,
+				ARV_GVBS_TIMESTAMP_CONTROL_LATCH, error);
+}
+
+static gboolean
+arv_gv_device_get_latched_timestamp (ArvDevice *device, guint64 *timestamp_ns, GError **error)
+{
+	ArvGvDevice *gv_device = ARV_GV_DEVICE (device);
+	GError *local_error = NULL;
+	guint64 timestamp_tick_frequency;
+	guint64 timestamp;
+	guint32 latched_value[2];
+
+	timestamp_tick_frequency = gv_device->priv->timestamp_tick_frequency;
+	if (timestamp_tick_frequency == 0) {
+		timestamp_tick_frequency = arv_gv_device_get_timestamp_tick_frequency (gv_device, &local_error);
+		if (local_error != NULL) {
+			g_propagate_error (error, local_error);
+			return FALSE;
+		}
+
+		if (timestamp_tick_frequency < 1) {
+			g_set_error (error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_PROTOCOL_ERROR,
+				     "[ArvGvDevice::get_latched_timestamp] Timestamp not supported");
+			return FALSE;
+		}
+
+		gv_device->priv->timestamp_tick_frequency = timestamp_tick_frequency;
+	}
+
+	/* High and low registers are contiguous, they are read in a single transaction */
+	if (!_read_memory (gv_device->priv->io_data, ARV_GVBS_TIMESTAMP_LATCHED_VALUE_HIGH_OFFSET,
+			   sizeof (latched_value), latched_value, error))
+		return FALSE;
+
+	/* Same conversion as for the GVSP packet timestamps */
+	timestamp = ((guint64) GUINT32_FROM_BE (latched_value[0]) << 32) | GUINT32_FROM_BE (latched_value[1]);
+	*timestamp_ns = (timestamp / timestamp_tick_frequency) * 1000000000 +
+		((timestamp % timestamp_tick_frequency) * 1000000000) / timestamp_tick_frequency;
+
+	return TRUE;
+}
+
+/**
+ * arv_gv_device_set_clock_sampling:
+ * @gv_device: a #ArvGvDevice
+ * @enable: enable state
+ *
+ * Makes the heartbeat thread sample the device clock every 5 seconds, using arv_device_sample_clock(). As the
+ * timestamp latch only uses the bootstrap registers, it does not interfere with the Genicam feature accesses of
+ * the application, but each sample delays them by a few control channel transactions. Sampling only occurs when
+ * the application has control access.
+ *
+ * Since: 0.8.0
+ */
+
+void
+arv_gv_device_set_clock_sampling (ArvGvDevice *gv_device, gboolean enable)
+{
+	ArvGvDeviceHeartbeatData *heartbeat_data;
+
+	g_return_if_fail (ARV_IS_GV_DEVICE (gv_device));
+
+	heartbeat_data = gv_device->priv->heartbeat_data;
+	if (heartbeat_data != NULL)
+		g_atomic_int_set (&heartbeat_data->clock_sampling, enable);
+}
+
 /**
  * arv_gv_device_get_stream_options:
  * @gv_device: a #ArvGvDevice
@@ -1167,6 +1958,38 @@ arv_gv_device_set_stream_options (ArvGvDevice *gv_device, ArvGvStreamOption opti
 	gv_device->priv->stream_options = options;
 }
 
+/**
+ * arv_gv_device_get_open_phase_duration:
+ * @gv_device: a #ArvGvDevice
+ * @phase: an opening phase
+ *
+ * Gets the time spent in one of the phases of the device opening. When zipped Genicam data are parsed during their
+ * download, the parsing time is included in the %ARV_GV_DEVICE_OPEN_PHASE_XML_LOAD phase. The
+ * %ARV_GV_DEVICE_OPEN_PHASE_LOCATE duration is only known when the device is opened using arv_open_device().
+ *
+ * Returns: the phase duration, in µs.
+ *
+ * Since: 0.8.0
+ */
+
+guint64
+arv_gv_device_get_open_phase_duration (ArvGvDevice *gv_device, ArvGvDeviceOpenPhase phase)
+{
+	g_return_val_if_fail (ARV_IS_GV_DEVICE (gv_device), 0);
+	g_return_val_if_fail (phase < ARV_GV_DEVICE_N_OPEN_PHASES, 0);
+
+	return gv_device->priv->open_phase_durations[phase];
+}
+
+void
+arv_gv_device_set_open_phase_duration (ArvGvDevice *gv_device, ArvGvDeviceOpenPhase phase, guint64 duration_us)
+{
+	g_return_if_fail (ARV_IS_GV_DEVICE (gv_device));
+	g_return_if_fail (phase < ARV_GV_DEVICE_N_OPEN_PHASES);
+
+	gv_device->priv->open_phase_durations[phase] = duration_us;
+}
+
 ArvDevice *
 arv_gv_device_new (GInetAddress *interface_address, GInetAddress *device_address)
 {
@@ -1177,10 +2000,13 @@ arv_gv_device_new (GInetAddress *interface_address, GInetAddress *device_address
 	ArvDomDocument *document;
 	char *address_string;
 	guint32 capabilities;
+	gint64 start_time;
 
 	g_return_val_if_fail (G_IS_INET_ADDRESS (interface_address), NULL);
 	g_return_val_if_fail (G_IS_INET_ADDRESS (device_address), NULL);
 
+	start_time = g_get_monotonic_time ();
+
 	address_string = g_inet_address_to_string (interface_address);
 	arv_debug_device ("[GvDevice::new] Interface address = %s", address_string);
 	g_free (address_string);
@@ -1212,6 +2038,8 @@ arv_gv_device_new (GInetAddress *interface_address, GInetAddress *device_address
 
 	gv_device->priv->io_data = io_data;
 
+	gv_device->priv->open_phase_durations[ARV_GV_DEVICE_OPEN_PHASE_BOOTSTRAP] = g_get_monotonic_time () - start_time;
+
 	arv_gv_device_load_genicam (gv_device);
 
 	if (!ARV_IS_GC (gv_device->priv->genicam)) {
@@ -1220,20 +2048,25 @@ arv_gv_device_new (GInetAddress *interface_address, GInetAddress *device_address
 		return NULL;
 	}
 
+	start_time = g_get_monotonic_time ();
 	arv_gv_device_take_control (gv_device);
+	gv_device->priv->open_phase_durations[ARV_GV_DEVICE_OPEN_PHASE_TAKE_CONTROL] = g_get_monotonic_time () - start_time;
 
 	heartbeat_data = g_new (ArvGvDeviceHeartbeatData, 1);
 	heartbeat_data->gv_device = gv_device;
 	heartbeat_data->io_data = io_data;
 	heartbeat_data->period_us = ARV_GV_DEVICE_HEARTBEAT_PERIOD_US;
 	heartbeat_data->cancel = FALSE;
+	heartbeat_data->clock_sampling = FALSE;
 
 	gv_device->priv->heartbeat_data = heartbeat_data;
 
 	gv_device->priv->heartbeat_thread = g_thread_new ("arv_gv_heartbeat", arv_gv_device_heartbeat_thread,
 							  gv_device->priv->heartbeat_data);
 
+	start_time = g_get_monotonic_time ();
 	arv_device_read_register (ARV_DEVICE (gv_device), ARV_GVBS_GVCP_CAPABILITY_OFFSET, &capabilities, NULL);
+	gv_device->priv->open_phase_durations[ARV_GV_DEVICE_OPEN_PHASE_BOOTSTRAP] += g_get_monotonic_time () - start_time;
 	gv_device->priv->is_packet_resend_supported = (capabilities & ARV_GVBS_GVCP_CAPABILITY_PACKET_RESEND) != 0;
 	gv_device->priv->is_write_memory_supported = (capabilities & ARV_GVBS_GVCP_CAPABILITY_WRITE_MEMORY) != 0;
 
@@ -1268,6 +2101,8 @@ arv_gv_device_finalize (GObject *object)
 	ArvGvDevice *gv_device = ARV_GV_DEVICE (object);
 	ArvGvDeviceIOData *io_data;
 
+	arv_gv_device_disable_events (gv_device);
+
 	if (gv_device->priv->heartbeat_thread != NULL) {
 		ArvGvDeviceHeartbeatData *heartbeat_data;
 
@@ -1347,4 +2182,33 @@ arv_gv_device_class_init (ArvGvDeviceClass *gv_device_class)
 	device_class->write_memory = arv_gv_device_write_memory;
 	device_class->read_register = arv_gv_device_read_register;
 	device_class->write_register = arv_gv_device_write_register;
+	device_class->latch_timestamp = arv_gv_device_latch_timestamp;
+	device_class->get_latched_timestamp = arv_gv_device_get_latched_timestamp;
+
+	/**
+	 * ArvGvDevice::event:
+	 * @gv_device: a #ArvGvDevice
+	 * @event_id: event identifier
+	 * @stream_channel_index: index of the related stream channel, 0xffff if none
+	 * @block_id: block id of the related stream channel, 0 if none
+	 * @timestamp: event timestamp, in device timestamp ticks
+	 * @data: device specific event data, empty for EVENT messages
+	 *
+	 * Signal that an event message was received. See arv_gv_device_enable_events(). At the time of the emission, the
+	 * Genicam event features already reflect the content of the event.
+	 *
+	 * This signal is emited from the message channel thread, so please take care to shared data access from the
+	 * callback.
+	 *
+	 * Since: 0.8.0
+	 */
+
+	arv_gv_device_signals[ARV_GV_DEVICE_SIGNAL_EVENT] =
+		g_signal_new ("event",
+			      G_TYPE_FROM_CLASS (gv_device_class),
+			      G_SIGNAL_RUN_LAST,
+			      0,
+			      NULL, NULL,
+			      g_cclosure_marshal_generic, G_TYPE_NONE, 5,
+			      G_TYPE_UINT, G_TYPE_UINT, G_TYPE_UINT64, G_TYPE_UINT64, G_TYPE_BYTES);
 }
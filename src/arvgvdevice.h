@@ -34,6 +34,25 @@
 
 G_BEGIN_DECLS
 
+/**
+ * ArvGvDeviceOpenPhase:
+ * @ARV_GV_DEVICE_OPEN_PHASE_LOCATE: search of the device and of the local interface
+ * @ARV_GV_DEVICE_OPEN_PHASE_BOOTSTRAP: control channel setup and bootstrap register reads
+ * @ARV_GV_DEVICE_OPEN_PHASE_XML_LOAD: Genicam data download and decompression
+ * @ARV_GV_DEVICE_OPEN_PHASE_XML_PARSE: Genicam data parsing, when not done during the download
+ * @ARV_GV_DEVICE_OPEN_PHASE_TAKE_CONTROL: control access request
+ *
+ * Since: 0.8.0
+ */
+
+typedef enum {
+	ARV_GV_DEVICE_OPEN_PHASE_LOCATE,
+	ARV_GV_DEVICE_OPEN_PHASE_BOOTSTRAP,
+	ARV_GV_DEVICE_OPEN_PHASE_XML_LOAD,
+	ARV_GV_DEVICE_OPEN_PHASE_XML_PARSE,
+	ARV_GV_DEVICE_OPEN_PHASE_TAKE_CONTROL
+} ArvGvDeviceOpenPhase;
+
 #define ARV_TYPE_GV_DEVICE             (arv_gv_device_get_type ())
 G_DECLARE_FINAL_TYPE (ArvGvDevice, arv_gv_device, ARV, GV_DEVICE, ArvDevice)
 
@@ -51,6 +70,13 @@ guint			arv_gv_device_auto_packet_size 			(ArvGvDevice *gv_device, GError **erro
 ArvGvStreamOption	arv_gv_device_get_stream_options		(ArvGvDevice *gv_device);
 void 			arv_gv_device_set_stream_options 		(ArvGvDevice *gv_device, ArvGvStreamOption options);
 
+guint64			arv_gv_device_get_open_phase_duration		(ArvGvDevice *gv_device, ArvGvDeviceOpenPhase phase);
+
+gboolean		arv_gv_device_enable_events			(ArvGvDevice *gv_device, GError **error);
+void			arv_gv_device_disable_events			(ArvGvDevice *gv_device);
+
+void			arv_gv_device_set_clock_sampling		(ArvGvDevice *gv_device, gboolean enable);
+
 G_END_DECLS
 
 #endif
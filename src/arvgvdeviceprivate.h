@@ -37,20 +37,33 @@ G_BEGIN_DECLS
     #define ARV_GV_DEVICE_HEARTBEAT_PERIOD_US       50000
     #define ARV_GV_DEVICE_HEARTBEAT_RETRY_DELAY_US  1000
     #define ARV_GV_DEVICE_HEARTBEAT_RETRY_TIMEOUT_S 0.25
+    #define ARV_GV_DEVICE_CLOCK_SAMPLING_PERIOD_US  250000
 #else
     #define ARV_GV_DEVICE_GVCP_N_RETRIES_DEFAULT    5
     #define ARV_GV_DEVICE_GVCP_TIMEOUT_MS_DEFAULT   500
     #define ARV_GV_DEVICE_HEARTBEAT_PERIOD_US       1000000
     #define ARV_GV_DEVICE_HEARTBEAT_RETRY_DELAY_US  10000
     #define ARV_GV_DEVICE_HEARTBEAT_RETRY_TIMEOUT_S 5.0		/* FIXME */
+    #define ARV_GV_DEVICE_CLOCK_SAMPLING_PERIOD_US  5000000
 #endif
 
 #define ARV_GV_DEVICE_GVSP_PACKET_SIZE_DEFAULT	1500
 
 #define ARV_GV_DEVICE_BUFFER_SIZE	1024
 
+#define ARV_GV_DEVICE_N_OPEN_PHASES	(ARV_GV_DEVICE_OPEN_PHASE_TAKE_CONTROL + 1)
+
 GRegex * 		arv_gv_device_get_url_regex 			(void);
 
+void			arv_gv_device_set_open_phase_duration		(ArvGvDevice *gv_device, ArvGvDeviceOpenPhase phase,
+									 guint64 duration_us);
+
+void			arv_gv_device_retain_genicam_cache		(void);
+void			arv_gv_device_release_genicam_cache		(void);
+guint			arv_gv_device_get_n_genicam_downloads		(void);
+
+void			arv_gv_device_clear_packet_size_cache		(void);
+
 G_END_DECLS
 
 #endif
@@ -52,6 +52,9 @@ enum
   PROP_SERIAL_NUMBER,
   PROP_GENICAM_FILENAME,
   PROP_GVSP_LOST_PACKET_RATIO,
+  PROP_GVSP_LATE_LEADER,
+  PROP_TEST_PACKET_MAX_SIZE,
+  PROP_N_TEST_PACKETS,
   PROP_CM_DOMAIN
 };
 
@@ -77,7 +80,16 @@ typedef struct {
 	GThread *thread;
 	gboolean cancel;
 
+	/* Pending action trigger, in µs since epoch, 0 if none. Only accessed from the camera thread. */
+	gint64 action_time_us;
+
+	guint16 message_packet_id;
+
 	double gvsp_lost_packet_ratio;
+	gboolean gvsp_late_leader;
+
+	guint test_packet_max_size;
+	guint n_test_packets;
 } ArvGvFakeCameraPrivate;
 
 struct _ArvGvFakeCamera {
@@ -106,6 +118,58 @@ _g_inet_socket_address_is_equal (GInetSocketAddress *a, GInetSocketAddress *b)
 				     g_inet_socket_address_get_address (b));
 }
 
+/* The fire test packet bit is self clearing. The test packet content is irrelevant, only its size matters. Test
+ * packets larger than test_packet_max_size are dropped, which simulates a smaller path MTU. */
+
+static void
+_fire_test_packet (ArvGvFakeCamera *gv_fake_camera)
+{
+	GSocketAddress *stream_address;
+	GError *error = NULL;
+	guint32 value;
+	guint max_size;
+	size_t size;
+	char *data;
+
+	arv_fake_camera_read_register (gv_fake_camera->priv->camera, ARV_GVBS_STREAM_CHANNEL_0_PACKET_SIZE_OFFSET, &value);
+	if ((value & ARV_GVBS_STREAM_CHANNEL_0_PACKET_SIZE_FIRE_TEST) == 0)
+		return;
+
+	arv_fake_camera_write_register (gv_fake_camera->priv->camera, ARV_GVBS_STREAM_CHANNEL_0_PACKET_SIZE_OFFSET,
+					value & ~ARV_GVBS_STREAM_CHANNEL_0_PACKET_SIZE_FIRE_TEST);
+
+	/* Packet size includes the IP and UDP headers */
+	size = (value >> ARV_GVBS_STREAM_CHANNEL_0_PACKET_SIZE_POS) & ARV_GVBS_STREAM_CHANNEL_0_PACKET_SIZE_MASK;
+	if (size <= ARV_GVSP_PACKET_PROTOCOL_OVERHEAD)
+		return;
+
+	g_atomic_int_inc (&gv_fake_camera->priv->n_test_packets);
+
+	max_size = g_atomic_int_get (&gv_fake_camera->priv->test_packet_max_size);
+	if (max_size > 0 && size > max_size) {
+		arv_debug_device ("[GvFakeCamera::fire_test_packet] Drop test packet of %" G_GSIZE_FORMAT " bytes",
+				  size);
+		return;
+	}
+
+	size -= ARV_GVSP_PACKET_PROTOCOL_OVERHEAD - sizeof (ArvGvspHeader);
+
+	stream_address = arv_fake_camera_get_stream_address (gv_fake_camera->priv->camera);
+	data = g_malloc0 (size);
+
+	g_socket_send_to (gv_fake_camera->priv->gvsp_socket, stream_address, data, size, NULL, &error);
+	if (error != NULL) {
+		arv_warning_device ("[GvFakeCamera::fire_test_packet] Failed to send a %" G_GSIZE_FORMAT
+				    " bytes test packet: %s", size, error->message);
+		g_clear_error (&error);
+	} else
+		arv_debug_device ("[GvFakeCamera::fire_test_packet] Test packet of %" G_GSIZE_FORMAT " bytes sent",
+				  size);
+
+	g_free (data);
+	g_object_unref (stream_address);
+}
+
 static gboolean
 _handle_control_packet (ArvGvFakeCamera *gv_fake_camera, GSocket *socket,
 			GSocketAddress *remote_address,
@@ -149,6 +213,14 @@ _handle_control_packet (ArvGvFakeCamera *gv_fake_camera, GSocket *socket,
 	packet_id = arv_gvcp_packet_get_packet_id (packet);
 	packet_type = arv_gvcp_packet_get_packet_type (packet);
 
+	if (packet_type == ARV_GVCP_PACKET_TYPE_ACK &&
+	    (arv_gvcp_packet_get_command (packet) == ARV_GVCP_COMMAND_EVENT_ACK ||
+	     arv_gvcp_packet_get_command (packet) == ARV_GVCP_COMMAND_EVENTDATA_ACK)) {
+		/* Messages are not resent, acknowledges are just ignored */
+		arv_debug_device ("[GvFakeCamera::handle_control_packet] Event acknowledge %d", packet_id);
+		return FALSE;
+	}
+
 	if (packet_type != ARV_GVCP_PACKET_TYPE_CMD) {
 		arv_warning_device ("[GvFakeCamera::handle_control_packet] Unknown packet type");
 		return FALSE;
@@ -182,6 +254,7 @@ _handle_control_packet (ArvGvFakeCamera *gv_fake_camera, GSocket *socket,
 					  block_address, block_size);
 			arv_fake_camera_write_memory (gv_fake_camera->priv->camera, block_address, block_size,
 						      arv_gvcp_packet_get_write_memory_cmd_data (packet));
+			_fire_test_packet (gv_fake_camera);
 			ack_packet = arv_gvcp_packet_new_write_memory_ack (block_address, packet_id,
 									   &ack_packet_size);
 			break;
@@ -208,9 +281,48 @@ _handle_control_packet (ArvGvFakeCamera *gv_fake_camera, GSocket *socket,
 			arv_fake_camera_write_register (gv_fake_camera->priv->camera, register_address, register_value);
 			arv_debug_device ("[GvFakeCamera::handle_control_packet] Write register command %d -> %d",
 					  register_address, register_value);
+			_fire_test_packet (gv_fake_camera);
 			ack_packet = arv_gvcp_packet_new_write_register_ack (1, packet_id,
 									     &ack_packet_size);
 			break;
+		case ARV_GVCP_COMMAND_ACTION_CMD:
+			{
+				ArvGvcpError status = ARV_GVCP_ERROR_NONE;
+				guint32 device_key;
+				guint32 group_key;
+				guint32 group_mask;
+				guint64 action_time;
+				gint64 time_us;
+
+				/* Action commands are accepted from any application, not only from the controller */
+				arv_gvcp_packet_get_action_cmd_infos (packet, &device_key, &group_key, &group_mask,
+								      &action_time);
+				if (!arv_fake_camera_check_action_command (gv_fake_camera->priv->camera,
+									   device_key, group_key, group_mask)) {
+					/* No acknowledge is sent for actions not addressed to this device */
+					arv_debug_device ("[GvFakeCamera::handle_control_packet] Ignore action command "
+							  "0x%08x 0x%08x 0x%08x", device_key, group_key, group_mask);
+					break;
+				}
+
+				/* Device timestamps are in ns since epoch */
+				time_us = g_get_real_time ();
+				if (action_time == 0) {
+					gv_fake_camera->priv->action_time_us = time_us;
+				} else if ((gint64) (action_time / 1000) < time_us) {
+					/* Late actions are executed immediately */
+					gv_fake_camera->priv->action_time_us = time_us;
+					status = ARV_GVCP_ERROR_ACTION_LATE;
+				} else
+					gv_fake_camera->priv->action_time_us = action_time / 1000;
+
+				arv_debug_device ("[GvFakeCamera::handle_control_packet] Action command scheduled in %"
+						  G_GINT64_FORMAT " µs", gv_fake_camera->priv->action_time_us - time_us);
+
+				if ((arv_gvcp_packet_get_packet_flags (packet) & ARV_GVCP_CMD_PACKET_FLAGS_ACK_REQUIRED) != 0)
+					ack_packet = arv_gvcp_packet_new_action_ack (status, packet_id, &ack_packet_size);
+			}
+			break;
 		default:
 			arv_warning_device ("[GvFakeCamera::handle_control_packet] Unknown command");
 	}
@@ -241,6 +353,88 @@ _handle_control_packet (ArvGvFakeCamera *gv_fake_camera, GSocket *socket,
 	return success;
 }
 
+static void
+_send_event (ArvGvFakeCamera *gv_fake_camera, GSocketAddress *message_address,
+	     guint16 event_id, ArvBuffer *buffer, const void *data, size_t data_size)
+{
+	ArvGvcpPacket *packet;
+	GError *error = NULL;
+	size_t packet_size;
+
+	gv_fake_camera->priv->message_packet_id = arv_gvcp_next_packet_id (gv_fake_camera->priv->message_packet_id);
+
+	packet = arv_gvcp_packet_new_event_cmd (event_id, 0, buffer->priv->frame_id, buffer->priv->timestamp_ns,
+						data, data_size,
+						gv_fake_camera->priv->message_packet_id, &packet_size);
+
+	g_socket_send_to (gv_fake_camera->priv->input_sockets[ARV_GV_FAKE_CAMERA_INPUT_SOCKET_GVCP],
+			  message_address, (const char *) packet, packet_size, NULL, &error);
+
+	if (error != NULL) {
+		arv_warning_device ("[GvFakeCamera::send_event] Failed to send event 0x%04x: %s",
+				    event_id, error->message);
+		g_clear_error (&error);
+	}
+
+	arv_gvcp_packet_debug (packet, ARV_DEBUG_LEVEL_LOG);
+	arv_gvcp_packet_free (packet);
+}
+
+static void
+_send_frame_events (ArvGvFakeCamera *gv_fake_camera, ArvBuffer *buffer)
+{
+	ArvFakeCamera *camera = gv_fake_camera->priv->camera;
+	GSocketAddress *message_address;
+
+	message_address = arv_fake_camera_get_message_address (camera);
+	if (message_address == NULL)
+		return;
+
+	if (arv_fake_camera_is_event_notification_enabled (camera, ARV_FAKE_CAMERA_EVENT_EXPOSURE_END))
+		_send_event (gv_fake_camera, message_address, ARV_FAKE_CAMERA_EVENT_ID_EXPOSURE_END, buffer, NULL, 0);
+
+	if (arv_fake_camera_is_event_notification_enabled (camera, ARV_FAKE_CAMERA_EVENT_FRAME_END)) {
+		guint32 data[2];
+
+		data[0] = g_htonl (buffer->priv->width);
+		data[1] = g_htonl (buffer->priv->height);
+
+		_send_event (gv_fake_camera, message_address, ARV_FAKE_CAMERA_EVENT_ID_FRAME_END, buffer,
+			     data, sizeof (data));
+	}
+
+	g_object_unref (message_address);
+}
+
+static void
+_send_leader (ArvGvFakeCamera *gv_fake_camera, GSocketAddress *stream_address, ArvBuffer *image_buffer,
+	      void *packet_buffer)
+{
+	GError *error = NULL;
+	size_t packet_size;
+
+	packet_size = ARV_GV_FAKE_CAMERA_BUFFER_SIZE;
+	arv_gvsp_packet_new_data_leader (image_buffer->priv->frame_id,
+					 0,
+					 image_buffer->priv->timestamp_ns,
+					 image_buffer->priv->pixel_format,
+					 image_buffer->priv->width, image_buffer->priv->height,
+					 image_buffer->priv->x_offset, image_buffer->priv->y_offset,
+					 packet_buffer, &packet_size);
+
+	if (g_random_double () >= gv_fake_camera->priv->gvsp_lost_packet_ratio)
+		g_socket_send_to (gv_fake_camera->priv->gvsp_socket, stream_address,
+				  packet_buffer, packet_size, NULL, &error);
+	else
+		arv_debug_stream_thread ("Drop GVSP leader packet frame:%u", image_buffer->priv->frame_id);
+
+	if (error != NULL) {
+		arv_warning_stream_thread ("[GvFakeCamera::thread] Failed to send leader for frame %d: %s",
+					   image_buffer->priv->frame_id, error->message);
+		g_clear_error (&error);
+	}
+}
+
 static void *
 _thread (void *user_data)
 {
@@ -267,7 +461,13 @@ _thread (void *user_data)
 		guint64 next_timestamp_us;
 		guint64 sleep_time_us;
 
-		if (is_streaming) {
+		if (is_streaming && arv_fake_camera_is_action_trigger_enabled (gv_fake_camera->priv->camera)) {
+			/* Frames are only sent on action commands */
+			if (gv_fake_camera->priv->action_time_us > 0)
+				next_timestamp_us = gv_fake_camera->priv->action_time_us;
+			else
+				next_timestamp_us = g_get_real_time () + 100000;
+		} else if (is_streaming) {
 			sleep_time_us = arv_fake_camera_get_sleep_time_for_next_frame (gv_fake_camera->priv->camera, &next_timestamp_us);
 		} else {
 			sleep_time_us = 100000;
@@ -277,7 +477,7 @@ _thread (void *user_data)
 		do {
 			gint timeout_ms;
 
-			timeout_ms = MIN (100, (next_timestamp_us - g_get_real_time ()) / 1000LL);
+			timeout_ms = MIN (100, ((gint64) next_timestamp_us - g_get_real_time ()) / 1000LL);
 			if (timeout_ms < 0)
 				timeout_ms = 0;
 
@@ -303,6 +503,12 @@ _thread (void *user_data)
 					}
 				}
 
+				/* Wake up on time for an action received during the wait */
+				if (gv_fake_camera->priv->action_time_us > 0 &&
+				    (guint64) gv_fake_camera->priv->action_time_us < next_timestamp_us &&
+				    arv_fake_camera_is_action_trigger_enabled (gv_fake_camera->priv->camera))
+					next_timestamp_us = gv_fake_camera->priv->action_time_us;
+
 				if (arv_fake_camera_get_control_channel_privilege (gv_fake_camera->priv->camera) == 0 ||
 				    arv_fake_camera_get_acquisition_status (gv_fake_camera->priv->camera) == 0) {
 					if (stream_address != NULL) {
@@ -313,6 +519,7 @@ _thread (void *user_data)
 						arv_debug_stream_thread ("[GvFakeCamera::thread] Stop stream");
 					}
 					is_streaming = FALSE;
+					gv_fake_camera->priv->action_time_us = 0;
 				}
 			}
 		} while (!g_atomic_int_get (&gv_fake_camera->priv->cancel) && g_get_real_time () < next_timestamp_us);
@@ -337,32 +544,23 @@ _thread (void *user_data)
 				image_buffer = arv_buffer_new (payload, NULL);
 			}
 
+			if (arv_fake_camera_is_action_trigger_enabled (gv_fake_camera->priv->camera)) {
+				if (gv_fake_camera->priv->action_time_us == 0 ||
+				    gv_fake_camera->priv->action_time_us > g_get_real_time ()) {
+					is_streaming = TRUE;
+					continue;
+				}
+				gv_fake_camera->priv->action_time_us = 0;
+			}
+
 			arv_fake_camera_fill_buffer (gv_fake_camera->priv->camera, image_buffer, &gv_packet_size);
 
 			arv_debug_stream_thread ("[GvFakeCamera::thread] Send frame %d", image_buffer->priv->frame_id);
 
 			block_id = 0;
 
-			packet_size = ARV_GV_FAKE_CAMERA_BUFFER_SIZE;
-			arv_gvsp_packet_new_data_leader (image_buffer->priv->frame_id,
-							 block_id,
-							 image_buffer->priv->timestamp_ns,
-							 image_buffer->priv->pixel_format,
-							 image_buffer->priv->width, image_buffer->priv->height,
-							 image_buffer->priv->x_offset, image_buffer->priv->y_offset,
-							 packet_buffer, &packet_size);
-
-			if (g_random_double () >= gv_fake_camera->priv->gvsp_lost_packet_ratio)
-				g_socket_send_to (gv_fake_camera->priv->gvsp_socket, stream_address,
-						  packet_buffer, packet_size, NULL, &error);
-			else
-				arv_debug_stream_thread ("Drop GVSP leader packet frame:%u", image_buffer->priv->frame_id);
-
-			if (error != NULL) {
-				arv_warning_stream_thread ("[GvFakeCamera::thread] Failed to send leader for frame %d: %s",
-							   image_buffer->priv->frame_id, error->message);
-				g_clear_error (&error);
-			}
+			if (!g_atomic_int_get (&gv_fake_camera->priv->gvsp_late_leader))
+				_send_leader (gv_fake_camera, stream_address, image_buffer, packet_buffer);
 
 			block_id++;
 
@@ -392,6 +590,10 @@ _thread (void *user_data)
 					g_clear_error (&error);
 				}
 
+				/* Simulate a leader received after the first data block */
+				if (block_id == 1 && g_atomic_int_get (&gv_fake_camera->priv->gvsp_late_leader))
+					_send_leader (gv_fake_camera, stream_address, image_buffer, packet_buffer);
+
 				offset += data_size;
 				block_id++;
 			}
@@ -413,6 +615,8 @@ _thread (void *user_data)
 				g_clear_error (&error);
 			}
 
+			_send_frame_events (gv_fake_camera, image_buffer);
+
 			is_streaming = TRUE;
 		}
 
@@ -471,6 +675,58 @@ _create_and_bind_input_socket (GSocket **socket_out, const char *socket_name, GI
 	return G_IS_SOCKET (socket);
 }
 
+static gboolean
+_bind_sockets (ArvGvFakeCamera *gv_fake_camera, GInetAddress *gvcp_inet_address, GInetAddress *broadcast_inet_address)
+{
+	GInetAddress *inet_address;
+	unsigned int n_socket_fds;
+	unsigned int i;
+	gboolean success = TRUE;
+
+	arv_fake_camera_set_inet_address (gv_fake_camera->priv->camera, gvcp_inet_address);
+
+	success = success && _create_and_bind_input_socket (&gv_fake_camera->priv->gvsp_socket,
+							    "GVSP", gvcp_inet_address, 0, FALSE, FALSE);
+	success = success && _create_and_bind_input_socket
+		(&gv_fake_camera->priv->input_sockets[ARV_GV_FAKE_CAMERA_INPUT_SOCKET_GVCP],
+		 "GVCP", gvcp_inet_address, ARV_GVCP_PORT, FALSE, FALSE);
+
+	if (broadcast_inet_address != NULL) {
+		inet_address = g_inet_address_new_from_string ("255.255.255.255");
+		if (!g_inet_address_equal (gvcp_inet_address, inet_address))
+			success = success && _create_and_bind_input_socket
+				(&gv_fake_camera->priv->input_sockets[ARV_GV_FAKE_CAMERA_INPUT_SOCKET_GLOBAL_DISCOVERY],
+				 "Global discovery", inet_address, ARV_GVCP_PORT, TRUE, FALSE);
+		g_clear_object (&inet_address);
+
+		if (!g_inet_address_equal (gvcp_inet_address, broadcast_inet_address))
+			success = success && _create_and_bind_input_socket
+				(&gv_fake_camera->priv->input_sockets[ARV_GV_FAKE_CAMERA_INPUT_SOCKET_SUBNET_DISCOVERY],
+				 "Subnet discovery", broadcast_inet_address, ARV_GVCP_PORT, FALSE, FALSE);
+	}
+
+	n_socket_fds = 0;
+	if (success) {
+		for (i = 0; i < ARV_GV_FAKE_CAMERA_N_INPUT_SOCKETS; i++) {
+			GSocket *socket = gv_fake_camera->priv->input_sockets[i];
+
+			if (G_IS_SOCKET (socket)) {
+				gv_fake_camera->priv->socket_fds[n_socket_fds].fd = g_socket_get_fd (socket);
+				gv_fake_camera->priv->socket_fds[n_socket_fds].events = G_IO_IN;
+				gv_fake_camera->priv->socket_fds[n_socket_fds].revents = 0;
+
+				n_socket_fds++;
+			}
+		}
+
+		arv_debug_device ("Listening to %d sockets", n_socket_fds);
+	}
+
+	gv_fake_camera->priv->n_socket_fds = n_socket_fds;
+
+	return success;
+}
+
 static gboolean
 arv_gv_fake_camera_start (ArvGvFakeCamera *gv_fake_camera)
 {
@@ -482,78 +738,58 @@ arv_gv_fake_camera_start (ArvGvFakeCamera *gv_fake_camera)
 
 	g_return_val_if_fail (ARV_IS_GV_FAKE_CAMERA (gv_fake_camera), FALSE);
 
-	return_value = getifaddrs (&ifap);
-	if (return_value < 0) {
-		arv_warning_device ("[GvFakeCamera::start] No network interface found");
-		return FALSE;
-	}
+	if (g_hostname_is_ip_address (gv_fake_camera->priv->interface_name)) {
+		GInetAddress *gvcp_inet_address;
 
-	for (ifap_iter = ifap ;ifap_iter != NULL && !interface_found; ifap_iter = ifap_iter->ifa_next) {
-		if ((ifap_iter->ifa_flags & IFF_UP) != 0 &&
-		    (ifap_iter->ifa_flags & IFF_POINTOPOINT) == 0 &&
-		    (ifap_iter->ifa_addr->sa_family == AF_INET) &&
-		    g_strcmp0 (ifap_iter->ifa_name, gv_fake_camera->priv->interface_name) == 0) {
-			GSocketAddress *socket_address;
-			GInetAddress *inet_address;
-			GInetAddress *gvcp_inet_address;
-			unsigned int n_socket_fds;
-			unsigned int i;
-
-			socket_address = g_socket_address_new_from_native (ifap_iter->ifa_addr,
-									   sizeof (struct sockaddr));
-			gvcp_inet_address = g_object_ref (g_inet_socket_address_get_address (G_INET_SOCKET_ADDRESS (socket_address)));
-			g_clear_object (&socket_address);
-			arv_fake_camera_set_inet_address (gv_fake_camera->priv->camera, gvcp_inet_address);
-
-			success = success && _create_and_bind_input_socket (&gv_fake_camera->priv->gvsp_socket,
-									    "GVSP", gvcp_inet_address, 0, FALSE, FALSE);
-			success = success && _create_and_bind_input_socket
-				(&gv_fake_camera->priv->input_sockets[ARV_GV_FAKE_CAMERA_INPUT_SOCKET_GVCP],
-				 "GVCP", gvcp_inet_address, ARV_GVCP_PORT, FALSE, FALSE);
-
-			inet_address = g_inet_address_new_from_string ("255.255.255.255");
-			if (!g_inet_address_equal (gvcp_inet_address, inet_address))
-				success = success && _create_and_bind_input_socket 
-					(&gv_fake_camera->priv->input_sockets[ARV_GV_FAKE_CAMERA_INPUT_SOCKET_GLOBAL_DISCOVERY],
-					 "Global discovery", inet_address, ARV_GVCP_PORT, TRUE, FALSE);
-			g_clear_object (&inet_address);
-
-			socket_address = g_socket_address_new_from_native (ifap_iter->ifa_broadaddr,
-									   sizeof (struct sockaddr));
-                        inet_address = g_object_ref (g_inet_socket_address_get_address (G_INET_SOCKET_ADDRESS (socket_address)));
-			g_clear_object (&socket_address);
-			if (!g_inet_address_equal (gvcp_inet_address, inet_address))
-				success = success && _create_and_bind_input_socket 
-					(&gv_fake_camera->priv->input_sockets[ARV_GV_FAKE_CAMERA_INPUT_SOCKET_SUBNET_DISCOVERY],
-					 "Subnet discovery", inet_address, ARV_GVCP_PORT, FALSE, FALSE);
-			g_clear_object (&inet_address);
-
-			g_clear_object (&gvcp_inet_address);
-
-			n_socket_fds = 0;
-			if (success) {
-				for (i = 0; i < ARV_GV_FAKE_CAMERA_N_INPUT_SOCKETS; i++) {
-					GSocket *socket = gv_fake_camera->priv->input_sockets[i];
+		/* Listen on the given address only, without discovery support. On linux, any 127.x.y.z address
+		 * can be used this way, which allows to run several simulators on the loopback interface. */
+		gvcp_inet_address = g_inet_address_new_from_string (gv_fake_camera->priv->interface_name);
+		if (gvcp_inet_address == NULL)
+			return FALSE;
 
-					if (G_IS_SOCKET (socket)) {
-						gv_fake_camera->priv->socket_fds[n_socket_fds].fd = g_socket_get_fd (socket);
-						gv_fake_camera->priv->socket_fds[n_socket_fds].events = G_IO_IN;
-						gv_fake_camera->priv->socket_fds[n_socket_fds].revents = 0;
+		success = _bind_sockets (gv_fake_camera, gvcp_inet_address, NULL);
+		g_clear_object (&gvcp_inet_address);
 
-						n_socket_fds++;
-					}
-				}
+		interface_found = TRUE;
+	} else {
+		return_value = getifaddrs (&ifap);
+		if (return_value < 0) {
+			arv_warning_device ("[GvFakeCamera::start] No network interface found");
+			return FALSE;
+		}
 
-				arv_debug_device ("Listening to %d sockets", n_socket_fds);
+		for (ifap_iter = ifap ;ifap_iter != NULL && !interface_found; ifap_iter = ifap_iter->ifa_next) {
+			if ((ifap_iter->ifa_flags & IFF_UP) != 0 &&
+			    (ifap_iter->ifa_flags & IFF_POINTOPOINT) == 0 &&
+			    (ifap_iter->ifa_addr->sa_family == AF_INET) &&
+			    g_strcmp0 (ifap_iter->ifa_name, gv_fake_camera->priv->interface_name) == 0) {
+				GSocketAddress *socket_address;
+				GInetAddress *gvcp_inet_address;
+				GInetAddress *broadcast_inet_address;
+
+				socket_address = g_socket_address_new_from_native (ifap_iter->ifa_addr,
+										   sizeof (struct sockaddr));
+				gvcp_inet_address = g_object_ref (g_inet_socket_address_get_address
+								  (G_INET_SOCKET_ADDRESS (socket_address)));
+				g_clear_object (&socket_address);
+
+				socket_address = g_socket_address_new_from_native (ifap_iter->ifa_broadaddr,
+										   sizeof (struct sockaddr));
+				broadcast_inet_address = g_object_ref (g_inet_socket_address_get_address
+								       (G_INET_SOCKET_ADDRESS (socket_address)));
+				g_clear_object (&socket_address);
+
+				success = _bind_sockets (gv_fake_camera, gvcp_inet_address, broadcast_inet_address);
+
+				g_clear_object (&broadcast_inet_address);
+				g_clear_object (&gvcp_inet_address);
+
+				interface_found = TRUE;
 			}
-
-			gv_fake_camera->priv->n_socket_fds = n_socket_fds;
-
-			interface_found = TRUE;
 		}
-	}
 
-	freeifaddrs (ifap);
+		freeifaddrs (ifap);
+	}
 
 	if (!success) {
 		unsigned int i;
@@ -598,7 +834,7 @@ arv_gv_fake_camera_stop (ArvGvFakeCamera *gv_fake_camera)
 
 /**
  * arv_gv_fake_camera_new_full:
- * @interface_name: (nullable): listening network interface, default is lo
+ * @interface_name: (nullable): listening network interface name or IPv4 address, default is lo
  * @serial_number: (nullable): fake device serial number, default is GV01
  * @genicam_filename: (nullable): path to alternative genicam data
  *
@@ -621,7 +857,7 @@ arv_gv_fake_camera_new_full (const char *interface_name, const char *serial_numb
 
 /**
  * arv_gv_fake_camera_new:
- * @interface_name: (nullable): listening network interface ('lo' by default)
+ * @interface_name: (nullable): listening network interface name or IPv4 address ('lo' by default)
  * @serial_number: (nullable): fake device serial number ('GV01' by default)
  *
  * Returns: a new #ArvGvFakeCamera
@@ -657,6 +893,28 @@ _set_property (GObject *object, guint prop_id, const GValue *value, GParamSpec *
 		case PROP_GVSP_LOST_PACKET_RATIO:
 			gv_fake_camera->priv->gvsp_lost_packet_ratio = g_value_get_double (value);
 			break;
+		case PROP_GVSP_LATE_LEADER:
+			g_atomic_int_set (&gv_fake_camera->priv->gvsp_late_leader, g_value_get_boolean (value));
+			break;
+		case PROP_TEST_PACKET_MAX_SIZE:
+			g_atomic_int_set (&gv_fake_camera->priv->test_packet_max_size, g_value_get_uint (value));
+			break;
+		default:
+			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+			break;
+	}
+}
+
+static void
+_get_property (GObject *object, guint prop_id, GValue *value, GParamSpec *pspec)
+{
+	ArvGvFakeCamera *gv_fake_camera = ARV_GV_FAKE_CAMERA (object);
+
+	switch (prop_id)
+	{
+		case PROP_N_TEST_PACKETS:
+			g_value_set_uint (value, g_atomic_int_get (&gv_fake_camera->priv->n_test_packets));
+			break;
 		default:
 			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
 			break;
@@ -740,6 +998,7 @@ arv_gv_fake_camera_class_init (ArvGvFakeCameraClass *this_class)
 	GObjectClass *object_class = G_OBJECT_CLASS (this_class);
 
 	object_class->set_property = _set_property;
+	object_class->get_property = _get_property;
 	object_class->constructed = _constructed;
 	object_class->finalize = _finalize;
 
@@ -779,4 +1038,31 @@ arv_gv_fake_camera_class_init (ArvGvFakeCameraClass *this_class)
 							      G_PARAM_WRITABLE | G_PARAM_CONSTRUCT |
 							      G_PARAM_STATIC_NAME | G_PARAM_STATIC_NICK |
 							      G_PARAM_STATIC_BLURB));
+	g_object_class_install_property (object_class,
+					 PROP_GVSP_LATE_LEADER,
+					 g_param_spec_boolean ("gvsp-late-leader",
+							       "GVSP late leader",
+							       "Send the GVSP leader packet after the first data block",
+							       FALSE,
+							       G_PARAM_WRITABLE | G_PARAM_CONSTRUCT |
+							       G_PARAM_STATIC_NAME | G_PARAM_STATIC_NICK |
+							       G_PARAM_STATIC_BLURB));
+	g_object_class_install_property (object_class,
+					 PROP_TEST_PACKET_MAX_SIZE,
+					 g_param_spec_uint ("test-packet-max-size",
+							    "Test packet maximum size",
+							    "Size above which test packets are dropped, 0 for no limit",
+							    0, G_MAXUINT, 0,
+							    G_PARAM_WRITABLE | G_PARAM_CONSTRUCT |
+							    G_PARAM_STATIC_NAME | G_PARAM_STATIC_NICK |
+							    G_PARAM_STATIC_BLURB));
+	g_object_class_install_property (object_class,
+					 PROP_N_TEST_PACKETS,
+					 g_param_spec_uint ("n-test-packets",
+							    "Number of test packets",
+							    "Number of test packet requests received",
+							    0, G_MAXUINT, 0,
+							    G_PARAM_READABLE |
+							    G_PARAM_STATIC_NAME | G_PARAM_STATIC_NICK |
+							    G_PARAM_STATIC_BLURB));
 }
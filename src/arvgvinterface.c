@@ -122,6 +122,7 @@ arv_gv_discover_socket_list_new (void)
 								G_SOCKET_TYPE_DATAGRAM,
 								G_SOCKET_PROTOCOL_UDP, NULL);
 			arv_gv_discover_socket_set_buffer_size (discover_socket, buffer_size);
+			g_socket_set_blocking (discover_socket->socket, FALSE);
 			g_socket_bind (discover_socket->socket, discover_socket->interface_address, FALSE, &error);
 
 			socket_list->sockets = g_slist_prepend (socket_list->sockets, discover_socket);
@@ -167,6 +168,43 @@ arv_gv_discover_socket_list_free (ArvGvDiscoverSocketList *socket_list)
 	g_free (socket_list);
 }
 
+/* Single socket list, bound to any address, for packets sent to explicit destinations */
+
+static ArvGvDiscoverSocketList *
+arv_gv_discover_socket_list_new_any (void)
+{
+	ArvGvDiscoverSocketList *socket_list;
+	ArvGvDiscoverSocket *discover_socket;
+	GInetAddress *inet_address;
+
+	socket_list = g_new0 (ArvGvDiscoverSocketList, 1);
+
+	discover_socket = g_new0 (ArvGvDiscoverSocket, 1);
+	inet_address = g_inet_address_new_any (G_SOCKET_FAMILY_IPV4);
+	discover_socket->interface_address = g_inet_socket_address_new (inet_address, 0);
+	g_object_unref (inet_address);
+
+	discover_socket->socket = g_socket_new (G_SOCKET_FAMILY_IPV4, G_SOCKET_TYPE_DATAGRAM, G_SOCKET_PROTOCOL_UDP, NULL);
+	if (!G_IS_SOCKET (discover_socket->socket)) {
+		g_object_unref (discover_socket->interface_address);
+		g_free (discover_socket);
+		return socket_list;
+	}
+
+	g_socket_set_blocking (discover_socket->socket, FALSE);
+	g_socket_bind (discover_socket->socket, discover_socket->interface_address, FALSE, NULL);
+
+	socket_list->sockets = g_slist_prepend (socket_list->sockets, discover_socket);
+	socket_list->n_sockets = 1;
+
+	socket_list->poll_fds = g_new (GPollFD, 1);
+	socket_list->poll_fds[0].fd = g_socket_get_fd (discover_socket->socket);
+	socket_list->poll_fds[0].events =  G_IO_IN;
+	socket_list->poll_fds[0].revents = 0;
+
+	return socket_list;
+}
+
 static void
 arv_gv_discover_socket_list_send_discover_packet (ArvGvDiscoverSocketList *socket_list)
 {
@@ -303,6 +341,7 @@ arv_gv_interface_device_infos_unref (ArvGvInterfaceDeviceInfos *infos)
 /* ArvGvInterface implementation */
 
 typedef struct {
+	GMutex devices_mutex;
 	GHashTable *devices;
 } ArvGvInterfacePrivate;
 
@@ -318,19 +357,96 @@ struct _ArvGvInterfaceClass {
 
 G_DEFINE_TYPE_WITH_CODE (ArvGvInterface, arv_gv_interface, ARV_TYPE_INTERFACE, G_ADD_PRIVATE (ArvGvInterface))
 
+static GHashTable *
+_device_table_new (void)
+{
+	return g_hash_table_new_full (g_str_hash, g_str_equal, NULL,
+				      (GDestroyNotify) arv_gv_interface_device_infos_unref);
+}
+
+static void
+_device_table_add (GHashTable *devices, ArvGvInterfaceDeviceInfos *device_infos)
+{
+	if (device_infos->id != NULL && device_infos->id[0] != '\0')
+		g_hash_table_replace (devices, device_infos->id,
+				      arv_gv_interface_device_infos_ref (device_infos));
+	if (device_infos->user_id != NULL && device_infos->user_id[0] != '\0')
+		g_hash_table_replace (devices, device_infos->user_id,
+				      arv_gv_interface_device_infos_ref (device_infos));
+	if (device_infos->vendor_serial != NULL && device_infos->vendor_serial[0] != '\0')
+		g_hash_table_replace (devices, device_infos->vendor_serial,
+				      arv_gv_interface_device_infos_ref (device_infos));
+	if (device_infos->vendor_alias_serial != NULL && device_infos->vendor_alias_serial[0] != '\0')
+		g_hash_table_replace (devices, device_infos->vendor_alias_serial,
+				      arv_gv_interface_device_infos_ref (device_infos));
+	g_hash_table_replace (devices, device_infos->mac,
+			      arv_gv_interface_device_infos_ref (device_infos));
+}
+
+static gboolean
+_device_infos_match (ArvGvInterfaceDeviceInfos *device_infos, const char *device_id)
+{
+	return  g_strcmp0 (device_infos->id, device_id) == 0 ||
+		g_strcmp0 (device_infos->user_id, device_id) == 0 ||
+		g_strcmp0 (device_infos->vendor_serial, device_id) == 0 ||
+		g_strcmp0 (device_infos->vendor_alias_serial, device_id) == 0 ||
+		g_strcmp0 (device_infos->mac, device_id) == 0;
+}
+
+static gboolean
+_is_expectation_met (GHashTable *devices, guint n_devices, guint n_expected_devices, const char **expected_device_ids)
+{
+	unsigned int i;
+
+	if (n_devices < n_expected_devices)
+		return FALSE;
+
+	if (expected_device_ids != NULL)
+		for (i = 0; expected_device_ids[i] != NULL; i++)
+			if (!g_hash_table_contains (devices, expected_device_ids[i]))
+				return FALSE;
+
+	return TRUE;
+}
+
+/*
+ * _discover:
+ * @devices: (allow-none): table to fill with the answering devices
+ * @device_id: (allow-none): device to search for, if @devices is %NULL
+ * @n_expected_devices: stop as soon as this number of devices answered, 0 for no limit
+ * @expected_device_ids: (allow-none): stop as soon as all these devices answered
+ * @timeout_ms: maximum time to wait for the answers, 0 for the default timeout
+ *
+ * Broadcasts a discovery request on all the network interfaces, and collects the answers until the timeout
+ * expires, or until the expected devices have answered.
+ *
+ * Returns: the infos of the device matching @device_id, or the first answering device if @devices and
+ * @device_id are %NULL.
+ */
+
 static ArvGvInterfaceDeviceInfos *
-_discover (GHashTable *devices, const char *device_id)
+_discover (GHashTable *devices, const char *device_id,
+	   guint n_expected_devices, const char **expected_device_ids, guint timeout_ms)
 {
 	ArvGvDiscoverSocketList *socket_list;
 	GSList *iter;
 	char buffer[ARV_GV_INTERFACE_SOCKET_BUFFER_SIZE];
+	gboolean has_expectation;
+	guint n_devices = 0;
+	gint64 start_time;
+	gint64 deadline;
 	int count;
 	int i;
 
 	g_assert (devices == NULL || device_id == NULL);
 
-	if (devices != NULL)
-		g_hash_table_remove_all (devices);
+	if (timeout_ms == 0)
+		timeout_ms = ARV_GV_INTERFACE_DISCOVERY_TIMEOUT_MS;
+
+	has_expectation = devices != NULL && (n_expected_devices > 0 || expected_device_ids != NULL);
+
+	if (has_expectation && _is_expectation_met (devices, 0, n_expected_devices, expected_device_ids))
+		return NULL;
 
 	socket_list = arv_gv_discover_socket_list_new ();
 
@@ -341,20 +457,23 @@ _discover (GHashTable *devices, const char *device_id)
 
 	arv_gv_discover_socket_list_send_discover_packet (socket_list);
 
+	start_time = g_get_monotonic_time ();
+	deadline = start_time + (gint64) timeout_ms * 1000;
+
 	do {
-		if (g_poll (socket_list->poll_fds, socket_list->n_sockets, ARV_GV_INTERFACE_DISCOVERY_TIMEOUT_MS) == 0) {
-			arv_gv_discover_socket_list_free (socket_list);
-			return NULL;
-		}
+		gint64 remaining = deadline - g_get_monotonic_time ();
+
+		if (remaining <= 0 ||
+		    g_poll (socket_list->poll_fds, socket_list->n_sockets, (remaining + 999) / 1000) == 0)
+			break;
 
 		for (i = 0, iter = socket_list->sockets; iter != NULL; i++, iter = iter->next) {
 			ArvGvDiscoverSocket *discover_socket = iter->data;
 
+			/* Sockets are non blocking, read all the pending answers */
 			do {
-				g_socket_set_blocking (discover_socket->socket, FALSE);
 				count = g_socket_receive (discover_socket->socket, buffer, ARV_GV_INTERFACE_SOCKET_BUFFER_SIZE,
 							  NULL, NULL);
-				g_socket_set_blocking (discover_socket->socket, TRUE);
 
 				if (count > 0) {
 					ArvGvcpPacket *packet = (ArvGvcpPacket *) buffer;
@@ -384,31 +503,14 @@ _discover (GHashTable *devices, const char *device_id)
 						g_free (address_string);
 
 						if (devices != NULL) {
-							if (device_infos->id != NULL && device_infos->id[0] != '\0')
-								g_hash_table_replace (devices, device_infos->id,
-										      arv_gv_interface_device_infos_ref (device_infos));
-							if (device_infos->user_id != NULL && device_infos->user_id[0] != '\0')
-								g_hash_table_replace (devices, device_infos->user_id,
-										      arv_gv_interface_device_infos_ref (device_infos));
-							if (device_infos->vendor_serial != NULL && device_infos->vendor_serial[0] != '\0')
-								g_hash_table_replace (devices, device_infos->vendor_serial,
-										      arv_gv_interface_device_infos_ref (device_infos));
-							if (device_infos->vendor_alias_serial != NULL && device_infos->vendor_alias_serial[0] != '\0')
-								g_hash_table_replace (devices, device_infos->vendor_alias_serial,
-										      arv_gv_interface_device_infos_ref (device_infos));
-							g_hash_table_replace (devices, device_infos->mac,
-									      arv_gv_interface_device_infos_ref (device_infos));
-						} else {
-							if (device_id == NULL ||
-							    g_strcmp0 (device_infos->id, device_id) == 0 ||
-							    g_strcmp0 (device_infos->user_id, device_id) == 0 ||
-							    g_strcmp0 (device_infos->vendor_serial, device_id) == 0 ||
-							    g_strcmp0 (device_infos->vendor_alias_serial, device_id) == 0 ||
-							    g_strcmp0 (device_infos->mac, device_id) == 0) {
-								arv_gv_discover_socket_list_free (socket_list);
-
-								return device_infos;
-							}
+							/* A device may answer on several interfaces */
+							if (!g_hash_table_contains (devices, device_infos->mac))
+								n_devices++;
+							_device_table_add (devices, device_infos);
+						} else if (device_id == NULL || _device_infos_match (device_infos, device_id)) {
+							arv_gv_discover_socket_list_free (socket_list);
+
+							return device_infos;
 						}
 
 						arv_gv_interface_device_infos_unref (device_infos);
@@ -416,13 +518,18 @@ _discover (GHashTable *devices, const char *device_id)
 				}
 			} while (count > 0);
 		}
-	} while (1);
-}
+	} while (!has_expectation ||
+		 !_is_expectation_met (devices, n_devices, n_expected_devices, expected_device_ids));
 
-static void
-arv_gv_interface_discover (ArvGvInterface *gv_interface)
-{
-	_discover (gv_interface->priv->devices, NULL);
+	arv_debug_interface ("[GvInterface::discovery] %u device%s found in %.3f s%s",
+			     n_devices, n_devices > 1 ? "s" : "",
+			     (g_get_monotonic_time () - start_time) / 1e6,
+			     has_expectation && _is_expectation_met (devices, n_devices, n_expected_devices,
+								     expected_device_ids) ? " (early completion)" : "");
+
+	arv_gv_discover_socket_list_free (socket_list);
+
+	return NULL;
 }
 
 static GInetAddress *
@@ -437,20 +544,26 @@ _device_infos_to_ginetaddress (ArvGvInterfaceDeviceInfos *device_infos)
 	return device_address;
 }
 
-static void
-arv_gv_interface_update_device_list (ArvInterface *interface, GArray *device_ids)
+static gboolean
+arv_gv_interface_update_device_list_full (ArvInterface *interface, GArray *device_ids,
+					  guint n_expected_devices, const char **expected_device_ids,
+					  guint timeout_ms)
 {
 	ArvGvInterface *gv_interface;
+	GHashTable *devices;
 	GHashTableIter iter;
 	gpointer key, value;
+	gboolean success;
 
 	g_assert (device_ids->len == 0);
 
 	gv_interface = ARV_GV_INTERFACE (interface);
 
-	arv_gv_interface_discover (gv_interface);
+	devices = _device_table_new ();
+
+	_discover (devices, NULL, n_expected_devices, expected_device_ids, timeout_ms);
 
-	g_hash_table_iter_init (&iter, gv_interface->priv->devices);
+	g_hash_table_iter_init (&iter, devices);
 	while (g_hash_table_iter_next (&iter, &key, &value)) {
 		ArvGvInterfaceDeviceInfos *infos = value;
 
@@ -473,6 +586,104 @@ arv_gv_interface_update_device_list (ArvInterface *interface, GArray *device_ids
 			g_object_unref (device_address);
 		}
 	}
+
+	success = _is_expectation_met (devices, device_ids->len, n_expected_devices, expected_device_ids);
+
+	/* The device table is used by concurrent open_device calls. A partial discovery doesn't tell anything about
+	 * the devices that didn't answer yet, they are kept in the table. */
+	g_mutex_lock (&gv_interface->priv->devices_mutex);
+	if (n_expected_devices == 0 && expected_device_ids == NULL) {
+		g_hash_table_unref (gv_interface->priv->devices);
+		gv_interface->priv->devices = g_hash_table_ref (devices);
+	} else {
+		g_hash_table_iter_init (&iter, devices);
+		while (g_hash_table_iter_next (&iter, &key, &value))
+			g_hash_table_replace (gv_interface->priv->devices, key,
+					      arv_gv_interface_device_infos_ref (value));
+	}
+	g_mutex_unlock (&gv_interface->priv->devices_mutex);
+
+	g_hash_table_unref (devices);
+
+	return success;
+}
+
+static void
+arv_gv_interface_update_device_list (ArvInterface *interface, GArray *device_ids)
+{
+	arv_gv_interface_update_device_list_full (interface, device_ids, 0, NULL, 0);
+}
+
+/* Lets the kernel choose the local address using its routing table. Connecting an UDP socket doesn't send
+ * any packet. It succeeds as soon as a default route exists, even if the device is not reachable through it, the
+ * result must be checked with _is_on_link(). */
+
+static GInetAddress *
+_route_lookup (GInetAddress *device_address)
+{
+	GSocket *socket;
+	GSocketAddress *device_socket_address;
+	GSocketAddress *local_address;
+	GInetAddress *interface_address = NULL;
+
+	socket = g_socket_new (G_SOCKET_FAMILY_IPV4, G_SOCKET_TYPE_DATAGRAM, G_SOCKET_PROTOCOL_UDP, NULL);
+	if (socket == NULL)
+		return NULL;
+
+	device_socket_address = g_inet_socket_address_new (device_address, ARV_GVCP_PORT);
+
+	if (g_socket_connect (socket, device_socket_address, NULL, NULL)) {
+		local_address = g_socket_get_local_address (socket, NULL);
+		if (local_address != NULL) {
+			interface_address = g_object_ref (g_inet_socket_address_get_address
+							  (G_INET_SOCKET_ADDRESS (local_address)));
+			g_object_unref (local_address);
+		}
+	}
+
+	g_object_unref (device_socket_address);
+	g_object_unref (socket);
+
+	return interface_address;
+}
+
+/* Checks the device is on the subnet of the network interface owning @interface_address. GigE Vision devices are
+ * usually not routed, an address outside of the interface subnet is most likely the default route. */
+
+static gboolean
+_is_on_link (GInetAddress *interface_address, GInetAddress *device_address)
+{
+	struct ifaddrs *ifap = NULL;
+	struct ifaddrs *ifap_iter;
+	gboolean is_on_link = FALSE;
+	guint32 interface_ip;
+	guint32 device_ip;
+
+	if (g_inet_address_get_family (interface_address) != G_SOCKET_FAMILY_IPV4 ||
+	    g_inet_address_get_family (device_address) != G_SOCKET_FAMILY_IPV4)
+		return FALSE;
+
+	memcpy (&interface_ip, g_inet_address_to_bytes (interface_address), sizeof (interface_ip));
+	memcpy (&device_ip, g_inet_address_to_bytes (device_address), sizeof (device_ip));
+
+	if (getifaddrs (&ifap) < 0)
+		return FALSE;
+
+	for (ifap_iter = ifap; ifap_iter != NULL; ifap_iter = ifap_iter->ifa_next) {
+		if (ifap_iter->ifa_addr != NULL &&
+		    ifap_iter->ifa_netmask != NULL &&
+		    ifap_iter->ifa_addr->sa_family == AF_INET &&
+		    ((struct sockaddr_in *) ifap_iter->ifa_addr)->sin_addr.s_addr == interface_ip) {
+			guint32 mask = ((struct sockaddr_in *) ifap_iter->ifa_netmask)->sin_addr.s_addr;
+
+			is_on_link = (interface_ip & mask) == (device_ip & mask);
+			break;
+		}
+	}
+
+	freeifaddrs (ifap);
+
+	return is_on_link;
 }
 
 static GInetAddress *
@@ -483,6 +694,7 @@ arv_gv_interface_camera_locate (ArvGvInterface *gv_interface, GInetAddress *devi
 	char buffer[ARV_GV_INTERFACE_SOCKET_BUFFER_SIZE];
 	GSList *iter;
 	GSocketAddress *device_socket_address;
+	GInetAddress *interface_address;
 	size_t size;
 	int i, count;
 
@@ -490,6 +702,26 @@ arv_gv_interface_camera_locate (ArvGvInterface *gv_interface, GInetAddress *devi
 	struct ifaddrs *ifap_iter;
 	struct sockaddr_in device_sockaddr;
 
+	/* The routing table is only trusted for a device on the interface subnet. Otherwise, look for an interface
+	 * matching the device subnet, then ask all the interfaces for an answer of the device. */
+	interface_address = _route_lookup (device_address);
+	if (interface_address != NULL) {
+		gboolean is_on_link;
+		char *address_string;
+
+		is_on_link = _is_on_link (interface_address, device_address);
+
+		address_string = g_inet_address_to_string (interface_address);
+		arv_debug_interface ("[GvInterface::camera_locate] Route found through %s%s", address_string,
+				     is_on_link ? "" : ", not on the device subnet");
+		g_free (address_string);
+
+		if (is_on_link)
+			return interface_address;
+
+		g_clear_object (&interface_address);
+	}
+
 	device_socket_address = g_inet_socket_address_new(device_address, ARV_GVCP_PORT);
 
 	if (getifaddrs(&ifap) >= 0) {
@@ -561,11 +793,9 @@ arv_gv_interface_camera_locate (ArvGvInterface *gv_interface, GInetAddress *devi
 			ArvGvDiscoverSocket *socket = iter->data;
 
 			do {
-				g_socket_set_blocking (socket->socket, FALSE);
 				count = g_socket_receive (socket->socket, buffer,
 						ARV_GV_INTERFACE_SOCKET_BUFFER_SIZE,
 						NULL, NULL);
-				g_socket_set_blocking (socket->socket, TRUE);
 
 				if (count > 0) {
 					ArvGvcpPacket *packet = (ArvGvcpPacket *) buffer;
@@ -587,24 +817,91 @@ arv_gv_interface_camera_locate (ArvGvInterface *gv_interface, GInetAddress *devi
 	return NULL;
 }
 
-static ArvDevice *
-_open_device (ArvInterface *interface, GHashTable *devices, const char *device_id)
+static ArvGvInterfaceDeviceInfos *
+_lookup_device_infos (ArvGvInterface *gv_interface, const char *device_id)
 {
-	ArvGvInterface *gv_interface;
-	ArvDevice *device = NULL;
 	ArvGvInterfaceDeviceInfos *device_infos;
-	GInetAddress *device_address;
 
-	gv_interface = ARV_GV_INTERFACE (interface);
+	g_mutex_lock (&gv_interface->priv->devices_mutex);
 
 	if (device_id == NULL) {
 		GList *device_list;
 
-		device_list = g_hash_table_get_values (devices);
+		device_list = g_hash_table_get_values (gv_interface->priv->devices);
 		device_infos = device_list != NULL ? device_list->data : NULL;
 		g_list_free (device_list);
 	} else
-		device_infos = g_hash_table_lookup (devices, device_id);
+		device_infos = g_hash_table_lookup (gv_interface->priv->devices, device_id);
+
+	if (device_infos != NULL)
+		arv_gv_interface_device_infos_ref (device_infos);
+
+	g_mutex_unlock (&gv_interface->priv->devices_mutex);
+
+	return device_infos;
+}
+
+static ArvDevice *
+_new_device (GInetAddress *interface_address, GInetAddress *device_address, gint64 start_time, GError **error)
+{
+	ArvDevice *device;
+	guint64 locate_duration;
+
+	locate_duration = g_get_monotonic_time () - start_time;
+
+	device = arv_gv_device_new (interface_address, device_address);
+	if (ARV_IS_GV_DEVICE (device))
+		arv_gv_device_set_open_phase_duration (ARV_GV_DEVICE (device), ARV_GV_DEVICE_OPEN_PHASE_LOCATE,
+						       locate_duration);
+	else {
+		char *address_string = g_inet_address_to_string (device_address);
+
+		/* The Genicam data loading is the only failure point of the device instantiation */
+		g_set_error (error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_GENICAM_NOT_FOUND,
+			     "[GvInterface::open_device] Failed to load the Genicam data of the device at %s",
+			     address_string);
+		g_free (address_string);
+	}
+
+	return device;
+}
+
+static ArvDevice *
+_open_device_by_address (ArvGvInterface *gv_interface, GInetAddress *device_address, gint64 start_time,
+			 GError **error)
+{
+	ArvDevice *device;
+	GInetAddress *interface_address;
+
+	/* Try and find an interface that the camera will respond on */
+	interface_address = arv_gv_interface_camera_locate (gv_interface, device_address);
+	if (interface_address == NULL) {
+		char *address_string = g_inet_address_to_string (device_address);
+
+		g_set_error (error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_NOT_CONNECTED,
+			     "[GvInterface::open_device] No answer from the device at %s", address_string);
+		g_free (address_string);
+
+		return NULL;
+	}
+
+	device = _new_device (interface_address, device_address, start_time, error);
+	g_object_unref (interface_address);
+
+	return device;
+}
+
+static ArvDevice *
+_open_device (ArvInterface *interface, const char *device_id, gint64 start_time, GError **error)
+{
+	ArvGvInterface *gv_interface;
+	ArvDevice *device = NULL;
+	ArvGvInterfaceDeviceInfos *device_infos;
+	GInetAddress *device_address;
+
+	gv_interface = ARV_GV_INTERFACE (interface);
+
+	device_infos = _lookup_device_infos (gv_interface, device_id);
 
 	if (device_infos == NULL) {
 		struct addrinfo hints;
@@ -613,7 +910,19 @@ _open_device (ArvInterface *interface, GHashTable *devices, const char *device_i
 		if (device_id == NULL)
 			return NULL;
 
-		/* Try if device_id is a hostname/IP address */
+		/* Direct path for IP addresses, without name resolution */
+		if (g_hostname_is_ip_address (device_id)) {
+			device_address = g_inet_address_new_from_string (device_id);
+			if (device_address != NULL) {
+				if (g_inet_address_get_family (device_address) == G_SOCKET_FAMILY_IPV4)
+					device = _open_device_by_address (gv_interface, device_address, start_time,
+									  error);
+				g_object_unref (device_address);
+			}
+			return device;
+		}
+
+		/* Try if device_id is a hostname */
 
 		memset(&hints, 0, sizeof (hints));
 		hints.ai_family = AF_INET;
@@ -631,16 +940,11 @@ _open_device (ArvInterface *interface, GHashTable *devices, const char *device_i
 
 			device_address = g_inet_address_new_from_string (ipstr);
 			if (device_address != NULL) {
-				/* Try and find an interface that the camera will respond on */
-				GInetAddress *interface_address =
-					arv_gv_interface_camera_locate (gv_interface, device_address);
-
-				if (interface_address != NULL) {
-					device = arv_gv_device_new (interface_address, device_address);
-					g_object_unref (interface_address);
-				}
+				/* Only the error of the last endpoint is reported */
+				g_clear_error (error);
+				device = _open_device_by_address (gv_interface, device_address, start_time, error);
+				g_object_unref (device_address);
 			}
-			g_object_unref (device_address);
 			if (device != NULL) {
 				break;
 			}
@@ -650,36 +954,246 @@ _open_device (ArvInterface *interface, GHashTable *devices, const char *device_i
 	}
 
 	device_address = _device_infos_to_ginetaddress (device_infos);
-	device = arv_gv_device_new (device_infos->interface_address, device_address);
+	device = _new_device (device_infos->interface_address, device_address, start_time, error);
 	g_object_unref (device_address);
 
+	arv_gv_interface_device_infos_unref (device_infos);
+
 	return device;
 }
 
 static ArvDevice *
-arv_gv_interface_open_device (ArvInterface *interface, const char *device_id)
+arv_gv_interface_open_device (ArvInterface *interface, const char *device_id, GError **error)
 {
 	ArvDevice *device;
 	ArvGvInterfaceDeviceInfos *device_infos;
+	GError *local_error = NULL;
+	gint64 start_time;
 
-	device = _open_device (interface, ARV_GV_INTERFACE (interface)->priv->devices, device_id);
+	start_time = g_get_monotonic_time ();
+
+	device = _open_device (interface, device_id, start_time, &local_error);
 	if (ARV_IS_DEVICE (device))
 		return device;
 
-	device_infos = _discover (NULL, device_id);
-	if (device_infos != NULL) {
-		GInetAddress *device_address;
+	/* An IP address is not a valid id for the discovery */
+	if (device_id == NULL || !g_hostname_is_ip_address (device_id)) {
+		if (arv_interface_is_device_list_cache_valid (interface)) {
+			/* The last discovery is recent enough, don't search the network again */
+			arv_debug_interface ("[GvInterface::open_device] Device '%s' not found in cached device list",
+					     device_id != NULL ? device_id : "(null)");
+		} else {
+			device_infos = _discover (NULL, device_id, 0, NULL, 0);
+			if (device_infos != NULL) {
+				GInetAddress *device_address;
+
+				g_clear_error (&local_error);
+
+				device_address = _device_infos_to_ginetaddress (device_infos);
+				device = _new_device (device_infos->interface_address, device_address, start_time,
+						      &local_error);
+				g_object_unref (device_address);
+
+				arv_gv_interface_device_infos_unref (device_infos);
+			}
+		}
+	}
+
+	if (device == NULL) {
+		if (local_error == NULL)
+			g_set_error (&local_error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_NOT_FOUND,
+				     "[GvInterface::open_device] Device '%s' not found",
+				     device_id != NULL ? device_id : "(null)");
+		g_propagate_error (error, local_error);
+	}
 
-		device_address = _device_infos_to_ginetaddress (device_infos);
-		device = arv_gv_device_new (device_infos->interface_address, device_address);
-		g_object_unref (device_address);
+	return device;
+}
 
-		arv_gv_interface_device_infos_unref (device_infos);
+static volatile gint action_packet_id = 0;
 
-		return device;
+static gboolean
+_send_action_command (ArvGvDiscoverSocketList *socket_list, const char **destinations,
+		      const ArvGvcpPacket *packet, size_t size, GError **error)
+{
+	GSList *iter;
+	unsigned int i;
+
+	for (iter = socket_list->sockets; iter != NULL; iter = iter->next) {
+		ArvGvDiscoverSocket *discover_socket = iter->data;
+
+		arv_gv_discover_socket_set_broadcast (discover_socket, TRUE);
+
+		for (i = 0; destinations == NULL ? i < 1 : destinations[i] != NULL; i++) {
+			GInetAddress *inet_address;
+			GSocketAddress *socket_address;
+			GError *local_error = NULL;
+
+			inet_address = g_inet_address_new_from_string (destinations != NULL ?
+								       destinations[i] : "255.255.255.255");
+			if (inet_address == NULL) {
+				g_set_error (error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_NOT_CONNECTED,
+					     "[GvInterface::issue_action_command] Invalid address '%s'", destinations[i]);
+				return FALSE;
+			}
+
+			socket_address = g_inet_socket_address_new (inet_address, ARV_GVCP_PORT);
+			g_socket_send_to (discover_socket->socket, socket_address, (const char *) packet, size,
+					  NULL, &local_error);
+			g_object_unref (socket_address);
+			g_object_unref (inet_address);
+
+			if (local_error != NULL) {
+				arv_warning_interface ("[GvInterface::issue_action_command] Error: %s", local_error->message);
+				g_error_free (local_error);
+			}
+		}
+
+		arv_gv_discover_socket_set_broadcast (discover_socket, FALSE);
 	}
 
-	return NULL;
+	return TRUE;
+}
+
+/**
+ * arv_gv_interface_issue_action_command:
+ * @device_key: device key
+ * @group_key: group key
+ * @group_mask: group mask
+ * @action_time: scheduled action time, in device timestamp ticks, 0 for an immediate action
+ * @destinations: (array zero-terminated=1) (nullable): IPv4 destination addresses, %NULL for a broadcast on all the
+ * interfaces
+ * @n_expected_acknowledges: number of expected acknowledges, 0 for no acknowledge request
+ * @timeout_ms: acknowledge timeout, in milliseconds
+ * @n_acknowledges: (out) (optional): number of received acknowledges
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Sends a GigE Vision action command, used for triggering several devices at
+ * once. Devices execute the action if their device key matches @device_key, and
+ * if one of their action signals has a group key equal to @group_key and a group
+ * mask sharing at least one bit with @group_mask. Device side keys and masks are
+ * usually set using the ActionDeviceKey, ActionGroupKey and ActionGroupMask
+ * features.
+ *
+ * All the command packets are sent before waiting for the acknowledges. The
+ * wait stops as soon as @n_expected_acknowledges are received, or after
+ * @timeout_ms.
+ *
+ * When @action_time is not zero, the devices execute the action when their
+ * timestamp counter reaches @action_time. This removes the network latency
+ * differences between devices, but requires synchronized device clocks.
+ *
+ * Returns: %TRUE if the command was sent and all the expected acknowledges were received without error.
+ *
+ * Since: 0.8.0
+ */
+
+gboolean
+arv_gv_interface_issue_action_command (guint32 device_key, guint32 group_key, guint32 group_mask,
+				       guint64 action_time, const char **destinations,
+				       guint n_expected_acknowledges, guint timeout_ms,
+				       guint *n_acknowledges, GError **error)
+{
+	ArvGvDiscoverSocketList *socket_list;
+	ArvGvcpPacket *packet;
+	GSList *iter;
+	char buffer[ARV_GV_INTERFACE_SOCKET_BUFFER_SIZE];
+	guint n_acks = 0;
+	guint n_error_acks = 0;
+	ArvGvcpError last_error = ARV_GVCP_ERROR_NONE;
+	gint64 deadline;
+	guint16 packet_id;
+	size_t size;
+	int count;
+
+	if (n_acknowledges != NULL)
+		*n_acknowledges = 0;
+
+	socket_list = destinations != NULL ?
+		arv_gv_discover_socket_list_new_any () :
+		arv_gv_discover_socket_list_new ();
+
+	if (socket_list->n_sockets < 1) {
+		arv_gv_discover_socket_list_free (socket_list);
+		g_set_error (error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_NOT_CONNECTED,
+			     "[GvInterface::issue_action_command] No network interface");
+		return FALSE;
+	}
+
+	packet_id = arv_gvcp_next_packet_id (g_atomic_int_add (&action_packet_id, 1) & 0xffff);
+	packet = arv_gvcp_packet_new_action_cmd (device_key, group_key, group_mask, action_time,
+						 n_expected_acknowledges > 0, packet_id, &size);
+
+	arv_gvcp_packet_debug (packet, ARV_DEBUG_LEVEL_LOG);
+
+	if (!_send_action_command (socket_list, destinations, packet, size, error)) {
+		arv_gvcp_packet_free (packet);
+		arv_gv_discover_socket_list_free (socket_list);
+		return FALSE;
+	}
+
+	arv_gvcp_packet_free (packet);
+
+	deadline = g_get_monotonic_time () + (gint64) timeout_ms * 1000;
+
+	while (n_acks + n_error_acks < n_expected_acknowledges) {
+		gint64 remaining = deadline - g_get_monotonic_time ();
+
+		if (remaining <= 0 ||
+		    g_poll (socket_list->poll_fds, socket_list->n_sockets, (remaining + 999) / 1000) == 0)
+			break;
+
+		for (iter = socket_list->sockets; iter != NULL; iter = iter->next) {
+			ArvGvDiscoverSocket *discover_socket = iter->data;
+
+			do {
+				count = g_socket_receive (discover_socket->socket, buffer, ARV_GV_INTERFACE_SOCKET_BUFFER_SIZE,
+							  NULL, NULL);
+
+				if (count >= (int) sizeof (ArvGvcpHeader)) {
+					ArvGvcpPacket *ack_packet = (ArvGvcpPacket *) buffer;
+
+					if (arv_gvcp_packet_get_command (ack_packet) != ARV_GVCP_COMMAND_ACTION_ACK ||
+					    arv_gvcp_packet_get_packet_id (ack_packet) != packet_id)
+						continue;
+
+					arv_gvcp_packet_debug (ack_packet, ARV_DEBUG_LEVEL_LOG);
+
+					if (arv_gvcp_packet_get_packet_type (ack_packet) == ARV_GVCP_PACKET_TYPE_ACK) {
+						n_acks++;
+					} else {
+						last_error = arv_gvcp_packet_get_packet_flags (ack_packet);
+						n_error_acks++;
+					}
+				}
+			} while (count > 0);
+		}
+	}
+
+	arv_gv_discover_socket_list_free (socket_list);
+
+	arv_debug_interface ("[GvInterface::issue_action_command] %u/%u acknowledge%s, %u error%s",
+			     n_acks, n_expected_acknowledges, n_acks > 1 ? "s" : "",
+			     n_error_acks, n_error_acks > 1 ? "s" : "");
+
+	if (n_acknowledges != NULL)
+		*n_acknowledges = n_acks;
+
+	if (n_error_acks > 0) {
+		g_set_error (error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_PROTOCOL_ERROR,
+			     "[GvInterface::issue_action_command] %u device%s reported an error (%s)",
+			     n_error_acks, n_error_acks > 1 ? "s" : "", arv_gvcp_error_to_string (last_error));
+		return FALSE;
+	}
+
+	if (n_acks < n_expected_acknowledges) {
+		g_set_error (error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_TIMEOUT,
+			     "[GvInterface::issue_action_command] %u acknowledge%s received, %u expected",
+			     n_acks, n_acks > 1 ? "s" : "", n_expected_acknowledges);
+		return FALSE;
+	}
+
+	return TRUE;
 }
 
 static ArvInterface *gv_interface = NULL;
@@ -716,6 +1230,8 @@ arv_gv_interface_destroy_instance (void)
 		gv_interface = NULL;
 	}
 
+	arv_gv_device_clear_packet_size_cache ();
+
 	g_mutex_unlock (&gv_interface_mutex);
 }
 
@@ -724,8 +1240,8 @@ arv_gv_interface_init (ArvGvInterface *gv_interface)
 {
 	gv_interface->priv = arv_gv_interface_get_instance_private (gv_interface);
 
-	gv_interface->priv->devices = g_hash_table_new_full (g_str_hash, g_str_equal, NULL,
-							     (GDestroyNotify) arv_gv_interface_device_infos_unref);
+	g_mutex_init (&gv_interface->priv->devices_mutex);
+	gv_interface->priv->devices = _device_table_new ();
 }
 
 static void
@@ -735,6 +1251,7 @@ arv_gv_interface_finalize (GObject *object)
 
 	g_hash_table_unref (gv_interface->priv->devices);
 	gv_interface->priv->devices = NULL;
+	g_mutex_clear (&gv_interface->priv->devices_mutex);
 
 	G_OBJECT_CLASS (arv_gv_interface_parent_class)->finalize (object);
 }
@@ -748,7 +1265,8 @@ arv_gv_interface_class_init (ArvGvInterfaceClass *gv_interface_class)
 	object_class->finalize = arv_gv_interface_finalize;
 
 	interface_class->update_device_list = arv_gv_interface_update_device_list;
-	interface_class->open_device = arv_gv_interface_open_device;
+	interface_class->update_device_list_full = arv_gv_interface_update_device_list_full;
+	interface_class->open_device_with_error = arv_gv_interface_open_device;
 
 	interface_class->protocol = "GigEVision";
 }
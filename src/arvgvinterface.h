@@ -37,6 +37,12 @@ G_DECLARE_FINAL_TYPE (ArvGvInterface, arv_gv_interface, ARV, GV_INTERFACE, ArvIn
 
 ArvInterface * 		arv_gv_interface_get_instance 		(void);
 
+gboolean		arv_gv_interface_issue_action_command	(guint32 device_key, guint32 group_key,
+								 guint32 group_mask, guint64 action_time,
+								 const char **destinations,
+								 guint n_expected_acknowledges, guint timeout_ms,
+								 guint *n_acknowledges, GError **error);
+
 G_END_DECLS
 
 #endif
@@ -110,6 +110,9 @@ typedef struct {
 
 	gboolean error_packet_received;
 
+	/* Rows are written at their padded offset only if the leader is received before any data block */
+	gboolean has_data_block;
+
 	guint n_packets;
 	ArvGvStreamPacketData *packet_data;
 } ArvGvStreamFrameData;
@@ -274,6 +277,9 @@ _process_data_leader (ArvGvStreamThreadData *thread_data,
 		frame->buffer->priv->pixel_format = arv_gvsp_packet_get_pixel_format (packet);
 	}
 
+	if (!frame->has_data_block)
+		arv_buffer_get_padded_layout (frame->buffer, NULL, &frame->buffer->priv->row_stride);
+
 	if (frame->packet_data[packet_id].time_us > 0) {
 		thread_data->n_resent_packets++;
 		arv_log_stream_thread ("[GvStream::process_data_leader] Received resent packet %u for frame %u",
@@ -316,7 +322,9 @@ _process_data_block (ArvGvStreamThreadData *thread_data,
 		block_size = block_end - block_offset;
 	}
 
-	memcpy (((char *) frame->buffer->priv->data) + block_offset, &packet->data, block_size);
+	arv_buffer_write_image_data (frame->buffer, block_offset, &packet->data, block_size);
+
+	frame->has_data_block = TRUE;
 
 	if (frame->packet_data[packet_id].time_us > 0) {
 		thread_data->n_resent_packets++;
@@ -395,6 +403,7 @@ _find_frame_data (ArvGvStreamThreadData *thread_data,
 	frame->buffer = buffer;
 	_update_socket (thread_data, frame->buffer);
 	frame->buffer->priv->status = ARV_BUFFER_STATUS_FILLING;
+	arv_buffer_invalidate_chunk_index (frame->buffer);
 	n_packets = (frame->buffer->priv->size + thread_data->data_size - 1) / thread_data->data_size + 2;
 
 	frame->first_packet_time_us = time_us;
@@ -533,6 +542,10 @@ _close_frame (ArvGvStreamThreadData *thread_data, ArvGvStreamFrameData *frame)
 	    frame->buffer->priv->status != ARV_BUFFER_STATUS_ABORTED)
 		thread_data->n_missing_packets += (int) frame->n_packets - (frame->last_valid_packet + 1);
 
+	/* Data blocks received before the leader were written tightly packed */
+	if (frame->buffer->priv->status == ARV_BUFFER_STATUS_SUCCESS)
+		arv_buffer_pad_image_rows (frame->buffer);
+
 	arv_stream_push_output_buffer (thread_data->stream, frame->buffer);
 	if (thread_data->callback != NULL)
 		thread_data->callback (thread_data->user_data,
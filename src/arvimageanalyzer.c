@@ -0,0 +1,1057 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2019 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel@gnome.org>
+ */
+
+/**
+ * SECTION: arvimageanalyzer
+ * @short_description: Image statistics computation
+ *
+ * #ArvImageAnalyzer computes the #ArvImageStats of images, as needed by a software
+ * auto exposure, a focus assistant or an image quality check: histograms, mean values,
+ * percentiles, saturated pixel counts and a sharpness metric, in a single pass over the
+ * image. Monochrome and Bayer images up to 16 bits per pixel are supported. The
+ * statistics of Bayer images are also given for each color channel.
+ *
+ * The analysis can be restricted to a region of the image, and to one pixel, or one Bayer
+ * cell, every n pixels in both directions. The sums and saturated pixel counts use SSSE3,
+ * AVX2 or NEON instructions, selected at runtime.
+ *
+ * An analyzer can be attached to a stream with arv_stream_set_image_analyzer(), in which
+ * case the statistics of each successfully received image are computed by the stream thread,
+ * and are available using arv_buffer_get_image_stats().
+ *
+ * <informalexample>
+ * <programlisting>
+ * ArvImageAnalyzer *analyzer;
+ * ArvImageStats *stats;
+ *
+ * analyzer = arv_image_analyzer_new ();
+ * arv_image_analyzer_set_subsampling (analyzer, 4);
+ *
+ * stats = arv_image_analyzer_process_buffer (analyzer, buffer, &error);
+ * median = arv_image_stats_get_percentile (stats, ARV_IMAGE_STATS_CHANNEL_ALL, 0.5);
+ * </programlisting>
+ * </informalexample>
+ */
+
+#include <arvimageanalyzerprivate.h>
+#include <arvimagestatsprivate.h>
+#include <arvbufferprivate.h>
+#include <arvdebug.h>
+
+#if ARV_SIMD_HAS_X86
+#include <immintrin.h>
+#endif
+
+#if ARV_SIMD_HAS_NEON
+#include <arm_neon.h>
+#endif
+
+/* Histograms are limited to 12 bits, the least significant bits of deeper pixels are dropped */
+#define ARV_IMAGE_ANALYZER_MAX_BIN_BITS		12
+
+typedef struct {
+	ArvPixelFormat pixel_format;
+	guint pixel_size;
+	guint n_bits;
+	gboolean is_bayer;
+	guint red_x;
+	guint red_y;
+} ArvImageAnalyzerFormat;
+
+static const ArvImageAnalyzerFormat arv_image_analyzer_formats[] = {
+	{ARV_PIXEL_FORMAT_MONO_8,		1,	8,	FALSE,	0, 0},
+	{ARV_PIXEL_FORMAT_MONO_10,		2,	10,	FALSE,	0, 0},
+	{ARV_PIXEL_FORMAT_MONO_12,		2,	12,	FALSE,	0, 0},
+	{ARV_PIXEL_FORMAT_MONO_14,		2,	14,	FALSE,	0, 0},
+	{ARV_PIXEL_FORMAT_MONO_16,		2,	16,	FALSE,	0, 0},
+
+	{ARV_PIXEL_FORMAT_BAYER_GR_8,		1,	8,	TRUE,	1, 0},
+	{ARV_PIXEL_FORMAT_BAYER_RG_8,		1,	8,	TRUE,	0, 0},
+	{ARV_PIXEL_FORMAT_BAYER_GB_8,		1,	8,	TRUE,	0, 1},
+	{ARV_PIXEL_FORMAT_BAYER_BG_8,		1,	8,	TRUE,	1, 1},
+
+	{ARV_PIXEL_FORMAT_BAYER_GR_10,		2,	10,	TRUE,	1, 0},
+	{ARV_PIXEL_FORMAT_BAYER_RG_10,		2,	10,	TRUE,	0, 0},
+	{ARV_PIXEL_FORMAT_BAYER_GB_10,		2,	10,	TRUE,	0, 1},
+	{ARV_PIXEL_FORMAT_BAYER_BG_10,		2,	10,	TRUE,	1, 1},
+
+	{ARV_PIXEL_FORMAT_BAYER_GR_12,		2,	12,	TRUE,	1, 0},
+	{ARV_PIXEL_FORMAT_BAYER_RG_12,		2,	12,	TRUE,	0, 0},
+	{ARV_PIXEL_FORMAT_BAYER_GB_12,		2,	12,	TRUE,	0, 1},
+	{ARV_PIXEL_FORMAT_BAYER_BG_12,		2,	12,	TRUE,	1, 1},
+
+	{ARV_PIXEL_FORMAT_BAYER_GR_16,		2,	16,	TRUE,	1, 0},
+	{ARV_PIXEL_FORMAT_BAYER_RG_16,		2,	16,	TRUE,	0, 0},
+	{ARV_PIXEL_FORMAT_BAYER_GB_16,		2,	16,	TRUE,	0, 1},
+	{ARV_PIXEL_FORMAT_BAYER_BG_16,		2,	16,	TRUE,	1, 1}
+};
+
+/* Sums of a row, split by pixel parity */
+
+typedef struct {
+	guint64 sum[2];
+	guint64 n_saturated[2];
+	guint64 gradient_energy;
+} ArvImageAnalyzerRowSums;
+
+/* State of an image analysis. The accumulators are indexed by the position of the pixel in the 2x2 Bayer
+ * cell, ((y & 1) << 1) | (x & 1), in image coordinates. Only the first one is used for monochrome images. */
+
+typedef struct {
+	ArvSimdIsa isa;
+	guint pixel_size;
+	guint16 mask;
+	guint shift;
+	guint16 saturation;
+	guint distance;
+	gboolean is_bayer;
+
+	guint32 *histograms[4];
+	guint64 n_pixels[4];
+	guint64 sums[4];
+	guint64 n_saturated[4];
+	guint64 gradient_energy;
+	guint64 n_gradients;
+} ArvImageAnalyzerJob;
+
+typedef struct {
+	GMutex mutex;
+
+	guint x;
+	guint y;
+	guint width;
+	guint height;
+	guint step;
+} ArvImageAnalyzerPrivate;
+
+struct _ArvImageAnalyzer {
+	GObject	object;
+
+	ArvImageAnalyzerPrivate *priv;
+};
+
+struct _ArvImageAnalyzerClass {
+	GObjectClass parent_class;
+};
+
+G_DEFINE_TYPE_WITH_CODE (ArvImageAnalyzer, arv_image_analyzer, G_TYPE_OBJECT, G_ADD_PRIVATE (ArvImageAnalyzer))
+
+GQuark
+arv_image_analyzer_error_quark (void)
+{
+	return g_quark_from_static_string ("arv-image-analyzer-error-quark");
+}
+
+static const ArvImageAnalyzerFormat *
+_find_format (ArvPixelFormat pixel_format)
+{
+	guint i;
+
+	for (i = 0; i < G_N_ELEMENTS (arv_image_analyzer_formats); i++)
+		if (arv_image_analyzer_formats[i].pixel_format == pixel_format)
+			return &arv_image_analyzer_formats[i];
+
+	return NULL;
+}
+
+/* Reference implementation, also used for the pixels left over by the vector kernels. Bits above the pixel
+ * depth are ignored, the gradient is computed on the histogram bins, such that the differences fit in 16 bits. */
+
+static void
+_row_sums_8_scalar (const guint8 *row, size_t first, size_t n, guint8 saturation, guint distance,
+		    ArvImageAnalyzerRowSums *sums)
+{
+	size_t i;
+
+	for (i = first; i < n; i++) {
+		guint value = row[i];
+
+		sums->sum[i & 1] += value;
+		if (value >= saturation)
+			sums->n_saturated[i & 1]++;
+		if (i + distance < n) {
+			gint difference = (gint) value - (gint) row[i + distance];
+
+			sums->gradient_energy += difference * difference;
+		}
+	}
+}
+
+static void
+_row_sums_16_scalar (const guint16 *row, size_t first, size_t n, guint16 mask, guint shift,
+		     guint16 saturation, guint distance, ArvImageAnalyzerRowSums *sums)
+{
+	size_t i;
+
+	for (i = first; i < n; i++) {
+		guint value = row[i] & mask;
+
+		sums->sum[i & 1] += value;
+		if (value >= saturation)
+			sums->n_saturated[i & 1]++;
+		if (i + distance < n) {
+			gint difference = (gint) (value >> shift) - (gint) ((row[i + distance] & mask) >> shift);
+
+			sums->gradient_energy += difference * difference;
+		}
+	}
+}
+
+/* The vector kernels process a multiple of the vector size, and return the number of processed pixels. The
+ * pixel at the gradient distance must be available for each processed pixel. */
+
+#if ARV_SIMD_HAS_X86
+
+/* Only SSE2 instructions are needed, the kernels share the SSSE3 baseline of the other x86 kernels */
+
+__attribute__ ((target ("ssse3")))
+static size_t
+_row_sums_8_ssse3 (const guint8 *row, size_t n, guint8 saturation, guint distance, ArvImageAnalyzerRowSums *sums)
+{
+	const __m128i zero = _mm_setzero_si128 ();
+	const __m128i even_mask = _mm_set1_epi16 (0x00ff);
+	const __m128i one = _mm_set1_epi8 (1);
+	const __m128i saturation_v = _mm_set1_epi8 ((char) saturation);
+	__m128i sum_even = zero, sum_odd = zero;
+	__m128i saturated_even = zero, saturated_odd = zero;
+	__m128i energy = zero;
+	guint64 lanes[2];
+	size_t i;
+
+	for (i = 0; i + 16 + distance <= n; i += 16) {
+		__m128i a, b, saturated, difference_low, difference_high, squares;
+
+		a = _mm_loadu_si128 ((const __m128i *) (row + i));
+		b = _mm_loadu_si128 ((const __m128i *) (row + i + distance));
+
+		sum_even = _mm_add_epi64 (sum_even, _mm_sad_epu8 (_mm_and_si128 (a, even_mask), zero));
+		sum_odd = _mm_add_epi64 (sum_odd, _mm_sad_epu8 (_mm_srli_epi16 (a, 8), zero));
+
+		saturated = _mm_and_si128 (_mm_cmpeq_epi8 (_mm_subs_epu8 (saturation_v, a), zero), one);
+		saturated_even = _mm_add_epi64 (saturated_even,
+						_mm_sad_epu8 (_mm_and_si128 (saturated, even_mask), zero));
+		saturated_odd = _mm_add_epi64 (saturated_odd, _mm_sad_epu8 (_mm_srli_epi16 (saturated, 8), zero));
+
+		difference_low = _mm_sub_epi16 (_mm_unpacklo_epi8 (a, zero), _mm_unpacklo_epi8 (b, zero));
+		difference_high = _mm_sub_epi16 (_mm_unpackhi_epi8 (a, zero), _mm_unpackhi_epi8 (b, zero));
+		squares = _mm_add_epi32 (_mm_madd_epi16 (difference_low, difference_low),
+					 _mm_madd_epi16 (difference_high, difference_high));
+		energy = _mm_add_epi64 (energy, _mm_unpacklo_epi32 (squares, zero));
+		energy = _mm_add_epi64 (energy, _mm_unpackhi_epi32 (squares, zero));
+	}
+
+#define ARV_IMAGE_ANALYZER_SUM_128(v) (_mm_storeu_si128 ((__m128i *) lanes, (v)), lanes[0] + lanes[1])
+
+	sums->sum[0] += ARV_IMAGE_ANALYZER_SUM_128 (sum_even);
+	sums->sum[1] += ARV_IMAGE_ANALYZER_SUM_128 (sum_odd);
+	sums->n_saturated[0] += ARV_IMAGE_ANALYZER_SUM_128 (saturated_even);
+	sums->n_saturated[1] += ARV_IMAGE_ANALYZER_SUM_128 (saturated_odd);
+	sums->gradient_energy += ARV_IMAGE_ANALYZER_SUM_128 (energy);
+
+	return i;
+}
+
+__attribute__ ((target ("ssse3")))
+static size_t
+_row_sums_16_ssse3 (const guint16 *row, size_t n, guint16 mask, guint shift, guint16 saturation, guint distance,
+		    ArvImageAnalyzerRowSums *sums)
+{
+	const __m128i zero = _mm_setzero_si128 ();
+	const __m128i mask_v = _mm_set1_epi16 ((short) mask);
+	const __m128i even_mask = _mm_set1_epi32 (0xffff);
+	const __m128i saturation_v = _mm_set1_epi16 ((short) saturation);
+	const __m128i shift_v = _mm_cvtsi32_si128 (shift);
+	__m128i sum_even = zero, sum_odd = zero;
+	__m128i saturated_even = zero, saturated_odd = zero;
+	__m128i energy = zero;
+	guint64 lanes[2];
+	guint32 counts[4];
+	size_t i;
+
+	for (i = 0; i + 8 + distance <= n; i += 8) {
+		__m128i a, b, even, odd, saturated, difference, squares;
+
+		a = _mm_and_si128 (_mm_loadu_si128 ((const __m128i *) (row + i)), mask_v);
+		b = _mm_and_si128 (_mm_loadu_si128 ((const __m128i *) (row + i + distance)), mask_v);
+
+		even = _mm_and_si128 (a, even_mask);
+		odd = _mm_srli_epi32 (a, 16);
+		sum_even = _mm_add_epi64 (sum_even, _mm_unpacklo_epi32 (even, zero));
+		sum_even = _mm_add_epi64 (sum_even, _mm_unpackhi_epi32 (even, zero));
+		sum_odd = _mm_add_epi64 (sum_odd, _mm_unpacklo_epi32 (odd, zero));
+		sum_odd = _mm_add_epi64 (sum_odd, _mm_unpackhi_epi32 (odd, zero));
+
+		/* At most one count per lane and iteration, 32 bit counters can't overflow */
+		saturated = _mm_srli_epi16 (_mm_cmpeq_epi16 (_mm_subs_epu16 (saturation_v, a), zero), 15);
+		saturated_even = _mm_add_epi32 (saturated_even, _mm_and_si128 (saturated, even_mask));
+		saturated_odd = _mm_add_epi32 (saturated_odd, _mm_srli_epi32 (saturated, 16));
+
+		difference = _mm_sub_epi16 (_mm_srl_epi16 (a, shift_v), _mm_srl_epi16 (b, shift_v));
+		squares = _mm_madd_epi16 (difference, difference);
+		energy = _mm_add_epi64 (energy, _mm_unpacklo_epi32 (squares, zero));
+		energy = _mm_add_epi64 (energy, _mm_unpackhi_epi32 (squares, zero));
+	}
+
+	sums->sum[0] += ARV_IMAGE_ANALYZER_SUM_128 (sum_even);
+	sums->sum[1] += ARV_IMAGE_ANALYZER_SUM_128 (sum_odd);
+	sums->gradient_energy += ARV_IMAGE_ANALYZER_SUM_128 (energy);
+
+#undef ARV_IMAGE_ANALYZER_SUM_128
+
+	_mm_storeu_si128 ((__m128i *) counts, saturated_even);
+	sums->n_saturated[0] += (guint64) counts[0] + counts[1] + counts[2] + counts[3];
+	_mm_storeu_si128 ((__m128i *) counts, saturated_odd);
+	sums->n_saturated[1] += (guint64) counts[0] + counts[1] + counts[2] + counts[3];
+
+	return i;
+}
+
+/* The AVX2 unpack instructions work on each 128 bit lane independently, which does not matter for sums */
+
+__attribute__ ((target ("avx2")))
+static size_t
+_row_sums_8_avx2 (const guint8 *row, size_t n, guint8 saturation, guint distance, ArvImageAnalyzerRowSums *sums)
+{
+	const __m256i zero = _mm256_setzero_si256 ();
+	const __m256i even_mask = _mm256_set1_epi16 (0x00ff);
+	const __m256i one = _mm256_set1_epi8 (1);
+	const __m256i saturation_v = _mm256_set1_epi8 ((char) saturation);
+	__m256i sum_even = zero, sum_odd = zero;
+	__m256i saturated_even = zero, saturated_odd = zero;
+	__m256i energy = zero;
+	guint64 lanes[4];
+	size_t i;
+
+	for (i = 0; i + 32 + distance <= n; i += 32) {
+		__m256i a, b, saturated, difference_low, difference_high, squares;
+
+		a = _mm256_loadu_si256 ((const __m256i *) (row + i));
+		b = _mm256_loadu_si256 ((const __m256i *) (row + i + distance));
+
+		sum_even = _mm256_add_epi64 (sum_even, _mm256_sad_epu8 (_mm256_and_si256 (a, even_mask), zero));
+		sum_odd = _mm256_add_epi64 (sum_odd, _mm256_sad_epu8 (_mm256_srli_epi16 (a, 8), zero));
+
+		saturated = _mm256_and_si256 (_mm256_cmpeq_epi8 (_mm256_subs_epu8 (saturation_v, a), zero), one);
+		saturated_even = _mm256_add_epi64 (saturated_even,
+						   _mm256_sad_epu8 (_mm256_and_si256 (saturated, even_mask), zero));
+		saturated_odd = _mm256_add_epi64 (saturated_odd,
+						  _mm256_sad_epu8 (_mm256_srli_epi16 (saturated, 8), zero));
+
+		difference_low = _mm256_sub_epi16 (_mm256_unpacklo_epi8 (a, zero), _mm256_unpacklo_epi8 (b, zero));
+		difference_high = _mm256_sub_epi16 (_mm256_unpackhi_epi8 (a, zero), _mm256_unpackhi_epi8 (b, zero));
+		squares = _mm256_add_epi32 (_mm256_madd_epi16 (difference_low, difference_low),
+					    _mm256_madd_epi16 (difference_high, difference_high));
+		energy = _mm256_add_epi64 (energy, _mm256_unpacklo_epi32 (squares, zero));
+		energy = _mm256_add_epi64 (energy, _mm256_unpackhi_epi32 (squares, zero));
+	}
+
+#define ARV_IMAGE_ANALYZER_SUM_256(v) (_mm256_storeu_si256 ((__m256i *) lanes, (v)), \
+				       lanes[0] + lanes[1] + lanes[2] + lanes[3])
+
+	sums->sum[0] += ARV_IMAGE_ANALYZER_SUM_256 (sum_even);
+	sums->sum[1] += ARV_IMAGE_ANALYZER_SUM_256 (sum_odd);
+	sums->n_saturated[0] += ARV_IMAGE_ANALYZER_SUM_256 (saturated_even);
+	sums->n_saturated[1] += ARV_IMAGE_ANALYZER_SUM_256 (saturated_odd);
+	sums->gradient_energy += ARV_IMAGE_ANALYZER_SUM_256 (energy);
+
+	return i;
+}
+
+__attribute__ ((target ("avx2")))
+static size_t
+_row_sums_16_avx2 (const guint16 *row, size_t n, guint16 mask, guint shift, guint16 saturation, guint distance,
+		   ArvImageAnalyzerRowSums *sums)
+{
+	const __m256i zero = _mm256_setzero_si256 ();
+	const __m256i mask_v = _mm256_set1_epi16 ((short) mask);
+	const __m256i even_mask = _mm256_set1_epi32 (0xffff);
+	const __m256i saturation_v = _mm256_set1_epi16 ((short) saturation);
+	const __m128i shift_v = _mm_cvtsi32_si128 (shift);
+	__m256i sum_even = zero, sum_odd = zero;
+	__m256i saturated_even = zero, saturated_odd = zero;
+	__m256i energy = zero;
+	guint64 lanes[4];
+	guint32 counts[8];
+	guint j;
+	size_t i;
+
+	for (i = 0; i + 16 + distance <= n; i += 16) {
+		__m256i a, b, even, odd, saturated, difference, squares;
+
+		a = _mm256_and_si256 (_mm256_loadu_si256 ((const __m256i *) (row + i)), mask_v);
+		b = _mm256_and_si256 (_mm256_loadu_si256 ((const __m256i *) (row + i + distance)), mask_v);
+
+		even = _mm256_and_si256 (a, even_mask);
+		odd = _mm256_srli_epi32 (a, 16);
+		sum_even = _mm256_add_epi64 (sum_even, _mm256_unpacklo_epi32 (even, zero));
+		sum_even = _mm256_add_epi64 (sum_even, _mm256_unpackhi_epi32 (even, zero));
+		sum_odd = _mm256_add_epi64 (sum_odd, _mm256_unpacklo_epi32 (odd, zero));
+		sum_odd = _mm256_add_epi64 (sum_odd, _mm256_unpackhi_epi32 (odd, zero));
+
+		saturated = _mm256_srli_epi16 (_mm256_cmpeq_epi16 (_mm256_subs_epu16 (saturation_v, a), zero), 15);
+		saturated_even = _mm256_add_epi32 (saturated_even, _mm256_and_si256 (saturated, even_mask));
+		saturated_odd = _mm256_add_epi32 (saturated_odd, _mm256_srli_epi32 (saturated, 16));
+
+		difference = _mm256_sub_epi16 (_mm256_srl_epi16 (a, shift_v), _mm256_srl_epi16 (b, shift_v));
+		squares = _mm256_madd_epi16 (difference, difference);
+		energy = _mm256_add_epi64 (energy, _mm256_unpacklo_epi32 (squares, zero));
+		energy = _mm256_add_epi64 (energy, _mm256_unpackhi_epi32 (squares, zero));
+	}
+
+	sums->sum[0] += ARV_IMAGE_ANALYZER_SUM_256 (sum_even);
+	sums->sum[1] += ARV_IMAGE_ANALYZER_SUM_256 (sum_odd);
+	sums->gradient_energy += ARV_IMAGE_ANALYZER_SUM_256 (energy);
+
+#undef ARV_IMAGE_ANALYZER_SUM_256
+
+	_mm256_storeu_si256 ((__m256i *) counts, saturated_even);
+	for (j = 0; j < 8; j++)
+		sums->n_saturated[0] += counts[j];
+	_mm256_storeu_si256 ((__m256i *) counts, saturated_odd);
+	for (j = 0; j < 8; j++)
+		sums->n_saturated[1] += counts[j];
+
+	return i;
+}
+
+#endif
+
+#if ARV_SIMD_HAS_NEON
+
+/* The 32 bit accumulators of the 8 bit kernel grow by at most 510 per iteration, which allows rows of more than
+ * a billion pixels */
+
+static size_t
+_row_sums_8_neon (const guint8 *row, size_t n, guint8 saturation, guint distance, ArvImageAnalyzerRowSums *sums)
+{
+	const uint8x16_t saturation_v = vdupq_n_u8 (saturation);
+	const uint16x8_t even_mask = vdupq_n_u16 (0x00ff);
+	uint32x4_t sum_even = vdupq_n_u32 (0), sum_odd = vdupq_n_u32 (0);
+	uint32x4_t saturated_even = vdupq_n_u32 (0), saturated_odd = vdupq_n_u32 (0);
+	uint64x2_t energy = vdupq_n_u64 (0);
+	size_t i;
+
+	for (i = 0; i + 16 + distance <= n; i += 16) {
+		uint8x16_t a, b;
+		uint16x8_t a16, saturated;
+		int16x8_t difference_low, difference_high;
+		int32x4_t squares;
+
+		a = vld1q_u8 (row + i);
+		b = vld1q_u8 (row + i + distance);
+
+		a16 = vreinterpretq_u16_u8 (a);
+		sum_even = vpadalq_u16 (sum_even, vandq_u16 (a16, even_mask));
+		sum_odd = vpadalq_u16 (sum_odd, vshrq_n_u16 (a16, 8));
+
+		saturated = vreinterpretq_u16_u8 (vshrq_n_u8 (vcgeq_u8 (a, saturation_v), 7));
+		saturated_even = vpadalq_u16 (saturated_even, vandq_u16 (saturated, even_mask));
+		saturated_odd = vpadalq_u16 (saturated_odd, vshrq_n_u16 (saturated, 8));
+
+		difference_low = vreinterpretq_s16_u16 (vsubl_u8 (vget_low_u8 (a), vget_low_u8 (b)));
+		difference_high = vreinterpretq_s16_u16 (vsubl_u8 (vget_high_u8 (a), vget_high_u8 (b)));
+		squares = vmull_s16 (vget_low_s16 (difference_low), vget_low_s16 (difference_low));
+		squares = vmlal_s16 (squares, vget_high_s16 (difference_low), vget_high_s16 (difference_low));
+		squares = vmlal_s16 (squares, vget_low_s16 (difference_high), vget_low_s16 (difference_high));
+		squares = vmlal_s16 (squares, vget_high_s16 (difference_high), vget_high_s16 (difference_high));
+		energy = vpadalq_u32 (energy, vreinterpretq_u32_s32 (squares));
+	}
+
+	sums->sum[0] += vaddlvq_u32 (sum_even);
+	sums->sum[1] += vaddlvq_u32 (sum_odd);
+	sums->n_saturated[0] += vaddlvq_u32 (saturated_even);
+	sums->n_saturated[1] += vaddlvq_u32 (saturated_odd);
+	sums->gradient_energy += vaddvq_u64 (energy);
+
+	return i;
+}
+
+static size_t
+_row_sums_16_neon (const guint16 *row, size_t n, guint16 mask, guint shift, guint16 saturation, guint distance,
+		   ArvImageAnalyzerRowSums *sums)
+{
+	const uint16x8_t mask_v = vdupq_n_u16 (mask);
+	const uint16x8_t saturation_v = vdupq_n_u16 (saturation);
+	const uint32x4_t even_mask = vdupq_n_u32 (0xffff);
+	/* Negative shifts are right shifts */
+	const int16x8_t shift_v = vdupq_n_s16 (-(gint16) shift);
+	uint64x2_t sum_even = vdupq_n_u64 (0), sum_odd = vdupq_n_u64 (0);
+	uint32x4_t saturated_even = vdupq_n_u32 (0), saturated_odd = vdupq_n_u32 (0);
+	uint64x2_t energy = vdupq_n_u64 (0);
+	size_t i;
+
+	for (i = 0; i + 8 + distance <= n; i += 8) {
+		uint16x8_t a, b;
+		uint32x4_t a32, saturated;
+		int16x8_t difference;
+		int32x4_t squares;
+
+		a = vandq_u16 (vld1q_u16 (row + i), mask_v);
+		b = vandq_u16 (vld1q_u16 (row + i + distance), mask_v);
+
+		a32 = vreinterpretq_u32_u16 (a);
+		sum_even = vpadalq_u32 (sum_even, vandq_u32 (a32, even_mask));
+		sum_odd = vpadalq_u32 (sum_odd, vshrq_n_u32 (a32, 16));
+
+		saturated = vreinterpretq_u32_u16 (vshrq_n_u16 (vcgeq_u16 (a, saturation_v), 15));
+		saturated_even = vaddq_u32 (saturated_even, vandq_u32 (saturated, even_mask));
+		saturated_odd = vaddq_u32 (saturated_odd, vshrq_n_u32 (saturated, 16));
+
+		difference = vreinterpretq_s16_u16 (vsubq_u16 (vshlq_u16 (a, shift_v), vshlq_u16 (b, shift_v)));
+		squares = vmull_s16 (vget_low_s16 (difference), vget_low_s16 (difference));
+		squares = vmlal_s16 (squares, vget_high_s16 (difference), vget_high_s16 (difference));
+		energy = vpadalq_u32 (energy, vreinterpretq_u32_s32 (squares));
+	}
+
+	sums->sum[0] += vaddvq_u64 (sum_even);
+	sums->sum[1] += vaddvq_u64 (sum_odd);
+	sums->n_saturated[0] += vaddlvq_u32 (saturated_even);
+	sums->n_saturated[1] += vaddlvq_u32 (saturated_odd);
+	sums->gradient_energy += vaddvq_u64 (energy);
+
+	return i;
+}
+
+#endif
+
+/* Full resolution analysis of a row segment starting at image column x. The histogram counts have a dependency
+ * through memory, there is no vector gather/scatter instruction to speed them up, but alternating between the
+ * even and odd pixel histograms lets consecutive increments proceed in parallel. These are the Bayer cell
+ * histograms, or for monochrome images the channel histogram and a scratch one, merged at the end. */
+
+static void
+_analyze_row (ArvImageAnalyzerJob *job, const void *row, size_t n, guint x, guint y)
+{
+	ArvImageAnalyzerRowSums sums = {{0}, {0}, 0};
+	guint32 *histogram_even;
+	guint32 *histogram_odd;
+	guint cell_even, cell_odd;
+	size_t n_processed = 0;
+	size_t i;
+
+	cell_even = job->is_bayer ? ((y & 1) << 1) | (x & 1) : 0;
+	cell_odd = job->is_bayer ? cell_even ^ 1 : 1;
+	histogram_even = job->histograms[cell_even];
+	histogram_odd = job->histograms[cell_odd];
+
+	if (job->pixel_size == 1) {
+		const guint8 *pixels = row;
+
+		for (i = 0; i + 1 < n; i += 2) {
+			histogram_even[pixels[i]]++;
+			histogram_odd[pixels[i + 1]]++;
+		}
+		if (i < n)
+			histogram_even[pixels[i]]++;
+
+		switch (job->isa) {
+#if ARV_SIMD_HAS_X86
+			case ARV_SIMD_ISA_AVX2:
+				n_processed = _row_sums_8_avx2 (pixels, n, job->saturation, job->distance, &sums);
+				break;
+			case ARV_SIMD_ISA_SSSE3:
+				n_processed = _row_sums_8_ssse3 (pixels, n, job->saturation, job->distance, &sums);
+				break;
+#endif
+#if ARV_SIMD_HAS_NEON
+			case ARV_SIMD_ISA_NEON:
+				n_processed = _row_sums_8_neon (pixels, n, job->saturation, job->distance, &sums);
+				break;
+#endif
+			default:
+				break;
+		}
+
+		_row_sums_8_scalar (pixels, n_processed, n, job->saturation, job->distance, &sums);
+	} else {
+		const guint16 *pixels = row;
+
+		for (i = 0; i + 1 < n; i += 2) {
+			histogram_even[(pixels[i] & job->mask) >> job->shift]++;
+			histogram_odd[(pixels[i + 1] & job->mask) >> job->shift]++;
+		}
+		if (i < n)
+			histogram_even[(pixels[i] & job->mask) >> job->shift]++;
+
+		switch (job->isa) {
+#if ARV_SIMD_HAS_X86
+			case ARV_SIMD_ISA_AVX2:
+				n_processed = _row_sums_16_avx2 (pixels, n, job->mask, job->shift,
+								 job->saturation, job->distance, &sums);
+				break;
+			case ARV_SIMD_ISA_SSSE3:
+				n_processed = _row_sums_16_ssse3 (pixels, n, job->mask, job->shift,
+								  job->saturation, job->distance, &sums);
+				break;
+#endif
+#if ARV_SIMD_HAS_NEON
+			case ARV_SIMD_ISA_NEON:
+				n_processed = _row_sums_16_neon (pixels, n, job->mask, job->shift,
+								 job->saturation, job->distance, &sums);
+				break;
+#endif
+			default:
+				break;
+		}
+
+		_row_sums_16_scalar (pixels, n_processed, n, job->mask, job->shift,
+				     job->saturation, job->distance, &sums);
+	}
+
+	job->n_pixels[cell_even] += (n + 1) / 2;
+	job->n_pixels[cell_odd] += n / 2;
+	job->sums[cell_even] += sums.sum[0];
+	job->sums[cell_odd] += sums.sum[1];
+	job->n_saturated[cell_even] += sums.n_saturated[0];
+	job->n_saturated[cell_odd] += sums.n_saturated[1];
+	job->gradient_energy += sums.gradient_energy;
+	if (n > job->distance)
+		job->n_gradients += n - job->distance;
+}
+
+/* Subsampled analysis, one pixel, or one Bayer cell, every unit * step pixels. The gradient is still computed
+ * between full resolution neighbours. */
+
+static void
+_analyze_row_subsampled (ArvImageAnalyzerJob *job, const void *row, size_t n, guint x, guint y, guint step)
+{
+	const guint8 *pixels_8 = row;
+	const guint16 *pixels_16 = row;
+	guint unit = job->is_bayer ? 2 : 1;
+	size_t i, j;
+
+	for (i = 0; i < n; i += unit * step) {
+		for (j = i; j < i + unit && j < n; j++) {
+			guint cell = job->is_bayer ? ((y & 1) << 1) | ((x + j) & 1) : 0;
+			guint value;
+
+			value = job->pixel_size == 1 ? pixels_8[j] : pixels_16[j] & job->mask;
+
+			job->histograms[cell][value >> job->shift]++;
+			job->n_pixels[cell]++;
+			job->sums[cell] += value;
+			if (value >= job->saturation)
+				job->n_saturated[cell]++;
+
+			if (j + job->distance < n) {
+				guint next;
+				gint difference;
+
+				next = job->pixel_size == 1 ?
+					pixels_8[j + job->distance] :
+					pixels_16[j + job->distance] & job->mask;
+				difference = (gint) (value >> job->shift) - (gint) (next >> job->shift);
+
+				job->gradient_energy += difference * difference;
+				job->n_gradients++;
+			}
+		}
+	}
+}
+
+/**
+ * arv_image_analyzer_process_with_isa:
+ * @analyzer: a #ArvImageAnalyzer
+ * @isa: instruction set to use
+ * @pixel_format: pixel format of the image
+ * @data: image data
+ * @row_stride: distance between the first pixels of consecutive rows, in bytes
+ * @width: image width, in pixels
+ * @height: image height, in pixels
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Same as arv_image_analyzer_process(), with an explicit instruction set. Used for the
+ * validation of the vector kernels against the scalar implementation.
+ *
+ * Returns: (transfer full): the image statistics, %NULL on error.
+ */
+
+ArvImageStats *
+arv_image_analyzer_process_with_isa (ArvImageAnalyzer *analyzer, ArvSimdIsa isa, ArvPixelFormat pixel_format,
+				     const void *data, size_t row_stride, guint width, guint height,
+				     GError **error)
+{
+	const ArvImageAnalyzerFormat *format;
+	ArvImageAnalyzerJob job = {0};
+	ArvImageStats *stats;
+	guint32 *cell_histograms = NULL;
+	guint32 *histograms[ARV_IMAGE_STATS_N_CHANNELS];
+	guint region_x, region_y, region_width, region_height, step;
+	guint n_bins;
+	guint unit;
+	guint i, j, k;
+
+	g_return_val_if_fail (ARV_IS_IMAGE_ANALYZER (analyzer), NULL);
+	g_return_val_if_fail (data != NULL, NULL);
+	g_return_val_if_fail (arv_simd_isa_is_supported (isa), NULL);
+
+	format = _find_format (pixel_format);
+	if (format == NULL) {
+		g_set_error (error, ARV_IMAGE_ANALYZER_ERROR, ARV_IMAGE_ANALYZER_ERROR_INVALID_PIXEL_FORMAT,
+			     "[ImageAnalyzer::process] Pixel format 0x%08x not supported", pixel_format);
+		return NULL;
+	}
+
+	if (width == 0 || height == 0 || row_stride < (size_t) width * format->pixel_size) {
+		g_set_error (error, ARV_IMAGE_ANALYZER_ERROR, ARV_IMAGE_ANALYZER_ERROR_INVALID_GEOMETRY,
+			     "[ImageAnalyzer::process] Invalid geometry (%ux%u, stride %" G_GSIZE_FORMAT ")",
+			     width, height, row_stride);
+		return NULL;
+	}
+
+	g_mutex_lock (&analyzer->priv->mutex);
+	region_x = analyzer->priv->x;
+	region_y = analyzer->priv->y;
+	region_width = analyzer->priv->width;
+	region_height = analyzer->priv->height;
+	step = analyzer->priv->step;
+	g_mutex_unlock (&analyzer->priv->mutex);
+
+	if (region_x >= width || region_y >= height) {
+		g_set_error (error, ARV_IMAGE_ANALYZER_ERROR, ARV_IMAGE_ANALYZER_ERROR_INVALID_GEOMETRY,
+			     "[ImageAnalyzer::process] Region origin (%u,%u) outside of the %ux%u image",
+			     region_x, region_y, width, height);
+		return NULL;
+	}
+
+	region_width = region_width == 0 ? width - region_x : MIN (region_width, width - region_x);
+	region_height = region_height == 0 ? height - region_y : MIN (region_height, height - region_y);
+
+	job.isa = isa;
+	job.pixel_size = format->pixel_size;
+	job.mask = (1 << format->n_bits) - 1;
+	job.shift = format->n_bits > ARV_IMAGE_ANALYZER_MAX_BIN_BITS ?
+		format->n_bits - ARV_IMAGE_ANALYZER_MAX_BIN_BITS : 0;
+	job.saturation = job.mask;
+	job.distance = format->is_bayer ? 2 : 1;
+	job.is_bayer = format->is_bayer;
+
+	n_bins = 1 << (format->n_bits - job.shift);
+	stats = arv_image_stats_new (n_bins, job.shift, job.saturation);
+
+	for (i = 0; i < ARV_IMAGE_STATS_N_CHANNELS; i++)
+		histograms[i] = arv_image_stats_get_histogram_data (stats, i);
+
+	if (format->is_bayer) {
+		cell_histograms = g_new0 (guint32, 4 * n_bins);
+		for (i = 0; i < 4; i++)
+			job.histograms[i] = cell_histograms + i * n_bins;
+	} else {
+		cell_histograms = g_new0 (guint32, n_bins);
+		for (i = 0; i < 4; i++)
+			job.histograms[i] = histograms[ARV_IMAGE_STATS_CHANNEL_ALL];
+		job.histograms[1] = cell_histograms;
+	}
+
+	unit = format->is_bayer ? 2 : 1;
+
+	for (i = 0; i < region_height; i += unit * step) {
+		for (j = i; j < i + unit && j < region_height; j++) {
+			guint y = region_y + j;
+			const guint8 *row = (const guint8 *) data + y * row_stride + region_x * format->pixel_size;
+
+			if (step > 1)
+				_analyze_row_subsampled (&job, row, region_width, region_x, y, step);
+			else
+				_analyze_row (&job, row, region_width, region_x, y);
+		}
+	}
+
+	if (format->is_bayer) {
+		guint red = (format->red_y << 1) | format->red_x;
+		guint blue = red ^ 3;
+		guint green_1 = red ^ 1;
+		guint green_2 = red ^ 2;
+
+		for (k = 0; k < n_bins; k++) {
+			guint32 red_count = job.histograms[red][k];
+			guint32 green_count = job.histograms[green_1][k] + job.histograms[green_2][k];
+			guint32 blue_count = job.histograms[blue][k];
+
+			histograms[ARV_IMAGE_STATS_CHANNEL_RED][k] = red_count;
+			histograms[ARV_IMAGE_STATS_CHANNEL_GREEN][k] = green_count;
+			histograms[ARV_IMAGE_STATS_CHANNEL_BLUE][k] = blue_count;
+			histograms[ARV_IMAGE_STATS_CHANNEL_ALL][k] = red_count + green_count + blue_count;
+		}
+
+		arv_image_stats_set_channel (stats, ARV_IMAGE_STATS_CHANNEL_RED,
+					     job.n_pixels[red], job.sums[red], job.n_saturated[red]);
+		arv_image_stats_set_channel (stats, ARV_IMAGE_STATS_CHANNEL_GREEN,
+					     job.n_pixels[green_1] + job.n_pixels[green_2],
+					     job.sums[green_1] + job.sums[green_2],
+					     job.n_saturated[green_1] + job.n_saturated[green_2]);
+		arv_image_stats_set_channel (stats, ARV_IMAGE_STATS_CHANNEL_BLUE,
+					     job.n_pixels[blue], job.sums[blue], job.n_saturated[blue]);
+	} else {
+		for (k = 0; k < n_bins; k++)
+			histograms[ARV_IMAGE_STATS_CHANNEL_ALL][k] += cell_histograms[k];
+	}
+
+	arv_image_stats_set_channel (stats, ARV_IMAGE_STATS_CHANNEL_ALL,
+				     job.n_pixels[0] + job.n_pixels[1] + job.n_pixels[2] + job.n_pixels[3],
+				     job.sums[0] + job.sums[1] + job.sums[2] + job.sums[3],
+				     job.n_saturated[0] + job.n_saturated[1] + job.n_saturated[2] + job.n_saturated[3]);
+
+	if (job.n_gradients > 0)
+		arv_image_stats_set_sharpness (stats, (double) job.gradient_energy / (double) job.n_gradients *
+					       (double) (1 << (2 * job.shift)));
+
+	g_free (cell_histograms);
+
+	return stats;
+}
+
+/**
+ * arv_image_analyzer_process:
+ * @analyzer: a #ArvImageAnalyzer
+ * @pixel_format: pixel format of the image
+ * @data: image data
+ * @row_stride: distance between the first pixels of consecutive rows, in bytes
+ * @width: image width, in pixels
+ * @height: image height, in pixels
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Computes the statistics of an image. This function is thread safe, an analyzer can process several
+ * images at the same time.
+ *
+ * Returns: (transfer full): the image statistics, %NULL on error.
+ *
+ * Since: 0.8.0
+ */
+
+ArvImageStats *
+arv_image_analyzer_process (ArvImageAnalyzer *analyzer, ArvPixelFormat pixel_format,
+			    const void *data, size_t row_stride, guint width, guint height,
+			    GError **error)
+{
+	return arv_image_analyzer_process_with_isa (analyzer, arv_simd_get_isa (), pixel_format,
+						    data, row_stride, width, height, error);
+}
+
+/**
+ * arv_image_analyzer_process_buffer:
+ * @analyzer: a #ArvImageAnalyzer
+ * @buffer: a #ArvBuffer containing an image
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Computes the statistics of the image of @buffer. The rows of @buffer may be padded, see
+ * arv_buffer_new_padded().
+ *
+ * Returns: (transfer full): the image statistics, %NULL on error.
+ *
+ * Since: 0.8.0
+ */
+
+ArvImageStats *
+arv_image_analyzer_process_buffer (ArvImageAnalyzer *analyzer, ArvBuffer *buffer, GError **error)
+{
+	const void *data;
+	size_t size;
+	size_t row_stride;
+	gint width, height;
+
+	g_return_val_if_fail (ARV_IS_IMAGE_ANALYZER (analyzer), NULL);
+	g_return_val_if_fail (ARV_IS_BUFFER (buffer), NULL);
+
+	if (!arv_buffer_payload_type_has_aoi (buffer->priv->payload_type)) {
+		g_set_error (error, ARV_IMAGE_ANALYZER_ERROR, ARV_IMAGE_ANALYZER_ERROR_INVALID_PIXEL_FORMAT,
+			     "[ImageAnalyzer::process_buffer] Buffer does not contain an image");
+		return NULL;
+	}
+
+	arv_buffer_get_image_region (buffer, NULL, NULL, &width, &height);
+	data = arv_buffer_get_data (buffer, &size);
+	row_stride = arv_buffer_get_image_row_stride (buffer);
+
+	if (width <= 0 || height <= 0 || data == NULL || size < row_stride * height) {
+		g_set_error (error, ARV_IMAGE_ANALYZER_ERROR, ARV_IMAGE_ANALYZER_ERROR_INVALID_GEOMETRY,
+			     "[ImageAnalyzer::process_buffer] Buffer too small");
+		return NULL;
+	}
+
+	return arv_image_analyzer_process (analyzer, arv_buffer_get_image_pixel_format (buffer),
+					   data, row_stride, width, height, error);
+}
+
+/**
+ * arv_image_analyzer_is_pixel_format_supported:
+ * @pixel_format: a pixel format
+ *
+ * Returns: %TRUE if the images of @pixel_format can be analyzed.
+ *
+ * Since: 0.8.0
+ */
+
+gboolean
+arv_image_analyzer_is_pixel_format_supported (ArvPixelFormat pixel_format)
+{
+	return _find_format (pixel_format) != NULL;
+}
+
+/**
+ * arv_image_analyzer_set_region:
+ * @analyzer: a #ArvImageAnalyzer
+ * @x: horizontal offset of the region
+ * @y: vertical offset of the region
+ * @width: region width, 0 to extend the region to the right edge of the image
+ * @height: region height, 0 to extend the region to the bottom edge of the image
+ *
+ * Restricts the analysis to a region of the images. The region is clipped to the image size.
+ * By default, the whole image is analyzed.
+ *
+ * Since: 0.8.0
+ */
+
+void
+arv_image_analyzer_set_region (ArvImageAnalyzer *analyzer, guint x, guint y, guint width, guint height)
+{
+	g_return_if_fail (ARV_IS_IMAGE_ANALYZER (analyzer));
+
+	g_mutex_lock (&analyzer->priv->mutex);
+
+	analyzer->priv->x = x;
+	analyzer->priv->y = y;
+	analyzer->priv->width = width;
+	analyzer->priv->height = height;
+
+	g_mutex_unlock (&analyzer->priv->mutex);
+}
+
+/**
+ * arv_image_analyzer_get_region:
+ * @analyzer: a #ArvImageAnalyzer
+ * @x: (out) (optional): horizontal offset of the region
+ * @y: (out) (optional): vertical offset of the region
+ * @width: (out) (optional): region width
+ * @height: (out) (optional): region height
+ *
+ * Gets the analyzed region, as set by arv_image_analyzer_set_region().
+ *
+ * Since: 0.8.0
+ */
+
+void
+arv_image_analyzer_get_region (ArvImageAnalyzer *analyzer, guint *x, guint *y, guint *width, guint *height)
+{
+	g_return_if_fail (ARV_IS_IMAGE_ANALYZER (analyzer));
+
+	g_mutex_lock (&analyzer->priv->mutex);
+
+	if (x != NULL)
+		*x = analyzer->priv->x;
+	if (y != NULL)
+		*y = analyzer->priv->y;
+	if (width != NULL)
+		*width = analyzer->priv->width;
+	if (height != NULL)
+		*height = analyzer->priv->height;
+
+	g_mutex_unlock (&analyzer->priv->mutex);
+}
+
+/**
+ * arv_image_analyzer_set_subsampling:
+ * @analyzer: a #ArvImageAnalyzer
+ * @step: subsampling step, 1 to analyze all the pixels
+ *
+ * Restricts the analysis to one pixel every @step pixels, horizontally and vertically. For Bayer images,
+ * the subsampling keeps whole 2x2 cells, one cell every @step cells.
+ *
+ * Since: 0.8.0
+ */
+
+void
+arv_image_analyzer_set_subsampling (ArvImageAnalyzer *analyzer, guint step)
+{
+	g_return_if_fail (ARV_IS_IMAGE_ANALYZER (analyzer));
+	g_return_if_fail (step > 0);
+
+	g_mutex_lock (&analyzer->priv->mutex);
+
+	analyzer->priv->step = step;
+
+	g_mutex_unlock (&analyzer->priv->mutex);
+}
+
+/**
+ * arv_image_analyzer_get_subsampling:
+ * @analyzer: a #ArvImageAnalyzer
+ *
+ * Returns: the subsampling step.
+ *
+ * Since: 0.8.0
+ */
+
+guint
+arv_image_analyzer_get_subsampling (ArvImageAnalyzer *analyzer)
+{
+	guint step;
+
+	g_return_val_if_fail (ARV_IS_IMAGE_ANALYZER (analyzer), 1);
+
+	g_mutex_lock (&analyzer->priv->mutex);
+	step = analyzer->priv->step;
+	g_mutex_unlock (&analyzer->priv->mutex);
+
+	return step;
+}
+
+/**
+ * arv_image_analyzer_new:
+ *
+ * Returns: a new #ArvImageAnalyzer, analyzing all the pixels of the images.
+ *
+ * Since: 0.8.0
+ */
+
+ArvImageAnalyzer *
+arv_image_analyzer_new (void)
+{
+	return g_object_new (ARV_TYPE_IMAGE_ANALYZER, NULL);
+}
+
+static void
+arv_image_analyzer_init (ArvImageAnalyzer *analyzer)
+{
+	analyzer->priv = arv_image_analyzer_get_instance_private (analyzer);
+
+	g_mutex_init (&analyzer->priv->mutex);
+	analyzer->priv->step = 1;
+}
+
+static void
+_finalize (GObject *object)
+{
+	ArvImageAnalyzer *analyzer = ARV_IMAGE_ANALYZER (object);
+
+	g_mutex_clear (&analyzer->priv->mutex);
+
+	G_OBJECT_CLASS (arv_image_analyzer_parent_class)->finalize (object);
+}
+
+static void
+arv_image_analyzer_class_init (ArvImageAnalyzerClass *this_class)
+{
+	GObjectClass *object_class = G_OBJECT_CLASS (this_class);
+
+	object_class->finalize = _finalize;
+}
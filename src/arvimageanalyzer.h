@@ -0,0 +1,75 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2019 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel@gnome.org>
+ */
+
+#ifndef ARV_IMAGE_ANALYZER_H
+#define ARV_IMAGE_ANALYZER_H
+
+#if !defined (ARV_H_INSIDE) && !defined (ARAVIS_COMPILATION)
+#error "Only <arv.h> can be included directly."
+#endif
+
+#include <arvtypes.h>
+#include <arvbuffer.h>
+#include <arvimagestats.h>
+
+G_BEGIN_DECLS
+
+#define ARV_IMAGE_ANALYZER_ERROR arv_image_analyzer_error_quark()
+
+GQuark 		arv_image_analyzer_error_quark 		(void);
+
+/**
+ * ArvImageAnalyzerError:
+ * @ARV_IMAGE_ANALYZER_ERROR_INVALID_PIXEL_FORMAT: the pixel format is not supported
+ * @ARV_IMAGE_ANALYZER_ERROR_INVALID_GEOMETRY: the image size, the row stride or the region are not supported
+ */
+
+typedef enum {
+	ARV_IMAGE_ANALYZER_ERROR_INVALID_PIXEL_FORMAT,
+	ARV_IMAGE_ANALYZER_ERROR_INVALID_GEOMETRY
+} ArvImageAnalyzerError;
+
+#define ARV_TYPE_IMAGE_ANALYZER             (arv_image_analyzer_get_type ())
+G_DECLARE_FINAL_TYPE (ArvImageAnalyzer, arv_image_analyzer, ARV, IMAGE_ANALYZER, GObject)
+
+ArvImageAnalyzer *	arv_image_analyzer_new			(void);
+
+void			arv_image_analyzer_set_region		(ArvImageAnalyzer *analyzer,
+								 guint x, guint y, guint width, guint height);
+void			arv_image_analyzer_get_region		(ArvImageAnalyzer *analyzer,
+								 guint *x, guint *y, guint *width, guint *height);
+void			arv_image_analyzer_set_subsampling	(ArvImageAnalyzer *analyzer, guint step);
+guint			arv_image_analyzer_get_subsampling	(ArvImageAnalyzer *analyzer);
+
+gboolean		arv_image_analyzer_is_pixel_format_supported	(ArvPixelFormat pixel_format);
+
+ArvImageStats *		arv_image_analyzer_process		(ArvImageAnalyzer *analyzer,
+								 ArvPixelFormat pixel_format,
+								 const void *data, size_t row_stride,
+								 guint width, guint height,
+								 GError **error);
+ArvImageStats *		arv_image_analyzer_process_buffer	(ArvImageAnalyzer *analyzer, ArvBuffer *buffer,
+								 GError **error);
+
+G_END_DECLS
+
+#endif
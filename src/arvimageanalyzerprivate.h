@@ -0,0 +1,39 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2019 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel@gnome.org>
+ */
+
+#ifndef ARV_IMAGE_ANALYZER_PRIVATE_H
+#define ARV_IMAGE_ANALYZER_PRIVATE_H
+
+#include <arvimageanalyzer.h>
+#include <arvsimdprivate.h>
+
+G_BEGIN_DECLS
+
+ArvImageStats *		arv_image_analyzer_process_with_isa	(ArvImageAnalyzer *analyzer, ArvSimdIsa isa,
+								 ArvPixelFormat pixel_format,
+								 const void *data, size_t row_stride,
+								 guint width, guint height,
+								 GError **error);
+
+G_END_DECLS
+
+#endif
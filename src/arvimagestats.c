@@ -0,0 +1,337 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2019 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel@gnome.org>
+ */
+
+/**
+ * SECTION: arvimagestats
+ * @short_description: Image statistics
+ *
+ * #ArvImageStats holds the statistics computed by an #ArvImageAnalyzer: pixel value
+ * histograms, mean values, saturated pixel counts and a sharpness metric. The statistics
+ * are given for all the analyzed pixels, and for each color channel of Bayer images.
+ *
+ * The histograms have at most 4096 bins. The bins of images with more than 12 bits per
+ * pixel group several pixel values, see arv_image_stats_get_bin_shift(). Once computed,
+ * the statistics are read only, and can be shared between threads.
+ */
+
+#include <arvimagestatsprivate.h>
+#include <math.h>
+
+typedef struct {
+	guint n_bins;
+	guint bin_shift;
+	guint max_value;
+
+	guint32 *histograms;
+	guint64 n_pixels[ARV_IMAGE_STATS_N_CHANNELS];
+	guint64 sums[ARV_IMAGE_STATS_N_CHANNELS];
+	guint64 n_saturated[ARV_IMAGE_STATS_N_CHANNELS];
+
+	double sharpness;
+} ArvImageStatsPrivate;
+
+struct _ArvImageStats {
+	GObject	object;
+
+	ArvImageStatsPrivate *priv;
+};
+
+struct _ArvImageStatsClass {
+	GObjectClass parent_class;
+};
+
+G_DEFINE_TYPE_WITH_CODE (ArvImageStats, arv_image_stats, G_TYPE_OBJECT, G_ADD_PRIVATE (ArvImageStats))
+
+ArvImageStats *
+arv_image_stats_new (guint n_bins, guint bin_shift, guint max_value)
+{
+	ArvImageStats *stats;
+
+	g_return_val_if_fail (n_bins > 0, NULL);
+
+	stats = g_object_new (ARV_TYPE_IMAGE_STATS, NULL);
+	stats->priv->n_bins = n_bins;
+	stats->priv->bin_shift = bin_shift;
+	stats->priv->max_value = max_value;
+	stats->priv->histograms = g_new0 (guint32, ARV_IMAGE_STATS_N_CHANNELS * n_bins);
+
+	return stats;
+}
+
+guint32 *
+arv_image_stats_get_histogram_data (ArvImageStats *stats, ArvImageStatsChannel channel)
+{
+	g_return_val_if_fail (ARV_IS_IMAGE_STATS (stats), NULL);
+	g_return_val_if_fail (channel < ARV_IMAGE_STATS_N_CHANNELS, NULL);
+
+	return stats->priv->histograms + channel * stats->priv->n_bins;
+}
+
+void
+arv_image_stats_set_channel (ArvImageStats *stats, ArvImageStatsChannel channel,
+			     guint64 n_pixels, guint64 sum, guint64 n_saturated)
+{
+	g_return_if_fail (ARV_IS_IMAGE_STATS (stats));
+	g_return_if_fail (channel < ARV_IMAGE_STATS_N_CHANNELS);
+
+	stats->priv->n_pixels[channel] = n_pixels;
+	stats->priv->sums[channel] = sum;
+	stats->priv->n_saturated[channel] = n_saturated;
+}
+
+void
+arv_image_stats_set_sharpness (ArvImageStats *stats, double sharpness)
+{
+	g_return_if_fail (ARV_IS_IMAGE_STATS (stats));
+
+	stats->priv->sharpness = sharpness;
+}
+
+/**
+ * arv_image_stats_get_n_bins:
+ * @stats: a #ArvImageStats
+ *
+ * Returns: the number of bins of the histograms.
+ *
+ * Since: 0.8.0
+ */
+
+guint
+arv_image_stats_get_n_bins (ArvImageStats *stats)
+{
+	g_return_val_if_fail (ARV_IS_IMAGE_STATS (stats), 0);
+
+	return stats->priv->n_bins;
+}
+
+/**
+ * arv_image_stats_get_bin_shift:
+ * @stats: a #ArvImageStats
+ *
+ * Pixel values are right shifted by this amount before being counted in the histograms. It is
+ * 0, one bin per value, for images up to 12 bits per pixel.
+ *
+ * Returns: the bit shift between pixel values and histogram bins.
+ *
+ * Since: 0.8.0
+ */
+
+guint
+arv_image_stats_get_bin_shift (ArvImageStats *stats)
+{
+	g_return_val_if_fail (ARV_IS_IMAGE_STATS (stats), 0);
+
+	return stats->priv->bin_shift;
+}
+
+/**
+ * arv_image_stats_get_max_value:
+ * @stats: a #ArvImageStats
+ *
+ * Returns: the largest pixel value of the analyzed pixel format, which is also the saturation level.
+ *
+ * Since: 0.8.0
+ */
+
+guint
+arv_image_stats_get_max_value (ArvImageStats *stats)
+{
+	g_return_val_if_fail (ARV_IS_IMAGE_STATS (stats), 0);
+
+	return stats->priv->max_value;
+}
+
+/**
+ * arv_image_stats_get_histogram:
+ * @stats: a #ArvImageStats
+ * @channel: a color channel
+ * @n_bins: (out) (optional): number of bins
+ *
+ * Returns: (array length=n_bins) (transfer none): the pixel count of each bin. The histograms of
+ * the color channels of a monochrome image are empty.
+ *
+ * Since: 0.8.0
+ */
+
+const guint32 *
+arv_image_stats_get_histogram (ArvImageStats *stats, ArvImageStatsChannel channel, guint *n_bins)
+{
+	g_return_val_if_fail (ARV_IS_IMAGE_STATS (stats), NULL);
+	g_return_val_if_fail (channel < ARV_IMAGE_STATS_N_CHANNELS, NULL);
+
+	if (n_bins != NULL)
+		*n_bins = stats->priv->n_bins;
+
+	return stats->priv->histograms + channel * stats->priv->n_bins;
+}
+
+/**
+ * arv_image_stats_get_n_pixels:
+ * @stats: a #ArvImageStats
+ * @channel: a color channel
+ *
+ * Returns: the number of analyzed pixels of @channel.
+ *
+ * Since: 0.8.0
+ */
+
+guint64
+arv_image_stats_get_n_pixels (ArvImageStats *stats, ArvImageStatsChannel channel)
+{
+	g_return_val_if_fail (ARV_IS_IMAGE_STATS (stats), 0);
+	g_return_val_if_fail (channel < ARV_IMAGE_STATS_N_CHANNELS, 0);
+
+	return stats->priv->n_pixels[channel];
+}
+
+/**
+ * arv_image_stats_get_mean:
+ * @stats: a #ArvImageStats
+ * @channel: a color channel
+ *
+ * Returns: the mean pixel value of @channel, computed from the exact pixel values, 0.0 if
+ * @channel is empty.
+ *
+ * Since: 0.8.0
+ */
+
+double
+arv_image_stats_get_mean (ArvImageStats *stats, ArvImageStatsChannel channel)
+{
+	g_return_val_if_fail (ARV_IS_IMAGE_STATS (stats), 0.0);
+	g_return_val_if_fail (channel < ARV_IMAGE_STATS_N_CHANNELS, 0.0);
+
+	if (stats->priv->n_pixels[channel] == 0)
+		return 0.0;
+
+	return (double) stats->priv->sums[channel] / (double) stats->priv->n_pixels[channel];
+}
+
+/**
+ * arv_image_stats_get_percentile:
+ * @stats: a #ArvImageStats
+ * @channel: a color channel
+ * @fraction: a fraction of the pixels, between 0.0 and 1.0
+ *
+ * Gets the smallest value such that at least @fraction of the pixels of @channel are lower or
+ * equal, as a median for 0.5. The value is computed from the histogram, and is thus rounded down
+ * to a multiple of the bin size for images with more than 12 bits per pixel.
+ *
+ * Returns: the percentile value, 0 if @channel is empty.
+ *
+ * Since: 0.8.0
+ */
+
+guint
+arv_image_stats_get_percentile (ArvImageStats *stats, ArvImageStatsChannel channel, double fraction)
+{
+	const guint32 *histogram;
+	guint64 n_pixels;
+	guint64 target;
+	guint64 count = 0;
+	guint i;
+
+	g_return_val_if_fail (ARV_IS_IMAGE_STATS (stats), 0);
+	g_return_val_if_fail (channel < ARV_IMAGE_STATS_N_CHANNELS, 0);
+
+	n_pixels = stats->priv->n_pixels[channel];
+	if (n_pixels == 0)
+		return 0;
+
+	fraction = CLAMP (fraction, 0.0, 1.0);
+	target = MAX ((guint64) ceil (fraction * (double) n_pixels), 1);
+	target = MIN (target, n_pixels);
+
+	histogram = stats->priv->histograms + channel * stats->priv->n_bins;
+	for (i = 0; i < stats->priv->n_bins; i++) {
+		count += histogram[i];
+		if (count >= target)
+			break;
+	}
+
+	return MIN (i, stats->priv->n_bins - 1) << stats->priv->bin_shift;
+}
+
+/**
+ * arv_image_stats_get_n_saturated:
+ * @stats: a #ArvImageStats
+ * @channel: a color channel
+ *
+ * Returns: the number of pixels of @channel at the maximum value of the pixel format.
+ *
+ * Since: 0.8.0
+ */
+
+guint64
+arv_image_stats_get_n_saturated (ArvImageStats *stats, ArvImageStatsChannel channel)
+{
+	g_return_val_if_fail (ARV_IS_IMAGE_STATS (stats), 0);
+	g_return_val_if_fail (channel < ARV_IMAGE_STATS_N_CHANNELS, 0);
+
+	return stats->priv->n_saturated[channel];
+}
+
+/**
+ * arv_image_stats_get_sharpness:
+ * @stats: a #ArvImageStats
+ *
+ * Gets a focus metric, the mean squared difference between horizontally adjacent pixels of the
+ * same color. It only makes sense to compare the sharpness of images of the same scene, taken with
+ * the same exposure, as for a focus sweep. For images with more than 12 bits per pixel, the
+ * differences are computed on the histogram bins, then scaled to pixel values.
+ *
+ * Returns: the mean squared horizontal gradient, in squared pixel value units.
+ *
+ * Since: 0.8.0
+ */
+
+double
+arv_image_stats_get_sharpness (ArvImageStats *stats)
+{
+	g_return_val_if_fail (ARV_IS_IMAGE_STATS (stats), 0.0);
+
+	return stats->priv->sharpness;
+}
+
+static void
+arv_image_stats_init (ArvImageStats *stats)
+{
+	stats->priv = arv_image_stats_get_instance_private (stats);
+}
+
+static void
+_finalize (GObject *object)
+{
+	ArvImageStats *stats = ARV_IMAGE_STATS (object);
+
+	g_clear_pointer (&stats->priv->histograms, g_free);
+
+	G_OBJECT_CLASS (arv_image_stats_parent_class)->finalize (object);
+}
+
+static void
+arv_image_stats_class_init (ArvImageStatsClass *this_class)
+{
+	GObjectClass *object_class = G_OBJECT_CLASS (this_class);
+
+	object_class->finalize = _finalize;
+}
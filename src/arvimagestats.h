@@ -0,0 +1,68 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2019 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel@gnome.org>
+ */
+
+#ifndef ARV_IMAGE_STATS_H
+#define ARV_IMAGE_STATS_H
+
+#if !defined (ARV_H_INSIDE) && !defined (ARAVIS_COMPILATION)
+#error "Only <arv.h> can be included directly."
+#endif
+
+#include <arvtypes.h>
+
+G_BEGIN_DECLS
+
+/**
+ * ArvImageStatsChannel:
+ * @ARV_IMAGE_STATS_CHANNEL_ALL: all the analyzed pixels
+ * @ARV_IMAGE_STATS_CHANNEL_RED: red pixels of a Bayer image
+ * @ARV_IMAGE_STATS_CHANNEL_GREEN: green pixels of a Bayer image, from both rows of the pattern
+ * @ARV_IMAGE_STATS_CHANNEL_BLUE: blue pixels of a Bayer image
+ */
+
+typedef enum {
+	ARV_IMAGE_STATS_CHANNEL_ALL,
+	ARV_IMAGE_STATS_CHANNEL_RED,
+	ARV_IMAGE_STATS_CHANNEL_GREEN,
+	ARV_IMAGE_STATS_CHANNEL_BLUE
+} ArvImageStatsChannel;
+
+#define ARV_IMAGE_STATS_N_CHANNELS	4
+
+#define ARV_TYPE_IMAGE_STATS             (arv_image_stats_get_type ())
+G_DECLARE_FINAL_TYPE (ArvImageStats, arv_image_stats, ARV, IMAGE_STATS, GObject)
+
+guint			arv_image_stats_get_n_bins		(ArvImageStats *stats);
+guint			arv_image_stats_get_bin_shift		(ArvImageStats *stats);
+guint			arv_image_stats_get_max_value		(ArvImageStats *stats);
+const guint32 *		arv_image_stats_get_histogram		(ArvImageStats *stats, ArvImageStatsChannel channel,
+								 guint *n_bins);
+guint64			arv_image_stats_get_n_pixels		(ArvImageStats *stats, ArvImageStatsChannel channel);
+double			arv_image_stats_get_mean		(ArvImageStats *stats, ArvImageStatsChannel channel);
+guint			arv_image_stats_get_percentile		(ArvImageStats *stats, ArvImageStatsChannel channel,
+								 double fraction);
+guint64			arv_image_stats_get_n_saturated		(ArvImageStats *stats, ArvImageStatsChannel channel);
+double			arv_image_stats_get_sharpness		(ArvImageStats *stats);
+
+G_END_DECLS
+
+#endif
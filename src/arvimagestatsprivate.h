@@ -0,0 +1,38 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2019 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel@gnome.org>
+ */
+
+#ifndef ARV_IMAGE_STATS_PRIVATE_H
+#define ARV_IMAGE_STATS_PRIVATE_H
+
+#include <arvimagestats.h>
+
+G_BEGIN_DECLS
+
+ArvImageStats *		arv_image_stats_new			(guint n_bins, guint bin_shift, guint max_value);
+guint32 *		arv_image_stats_get_histogram_data	(ArvImageStats *stats, ArvImageStatsChannel channel);
+void			arv_image_stats_set_channel		(ArvImageStats *stats, ArvImageStatsChannel channel,
+								 guint64 n_pixels, guint64 sum, guint64 n_saturated);
+void			arv_image_stats_set_sharpness		(ArvImageStats *stats, double sharpness);
+
+G_END_DECLS
+
+#endif
@@ -32,29 +32,82 @@
  */
 
 #include <arvinterfaceprivate.h>
+#include <arvdebug.h>
 
 typedef struct {
 	GArray *device_ids;
+
+	/* Result of the last complete discovery */
+	GMutex cache_mutex;
+	GArray *cached_device_ids;
+	gint64 cache_time;
+	guint cache_ttl_ms;
 } ArvInterfacePrivate;
 
 G_DEFINE_ABSTRACT_TYPE_WITH_CODE (ArvInterface, arv_interface, G_TYPE_OBJECT, G_ADD_PRIVATE (ArvInterface))
 
+ArvInterfaceDeviceIds *
+arv_interface_device_ids_copy (const ArvInterfaceDeviceIds *ids)
+{
+	ArvInterfaceDeviceIds *copy;
+
+	g_return_val_if_fail (ids != NULL, NULL);
+
+	copy = g_new0 (ArvInterfaceDeviceIds, 1);
+	copy->device = g_strdup (ids->device);
+	copy->physical = g_strdup (ids->physical);
+	copy->address = g_strdup (ids->address);
+	copy->vendor = g_strdup (ids->vendor);
+	copy->model = g_strdup (ids->model);
+	copy->serial_nbr = g_strdup (ids->serial_nbr);
+
+	return copy;
+}
+
+void
+arv_interface_device_ids_free (ArvInterfaceDeviceIds *ids)
+{
+	if (ids == NULL)
+		return;
+
+	g_free (ids->device);
+	g_free (ids->physical);
+	g_free (ids->address);
+	g_free (ids->vendor);
+	g_free (ids->model);
+	g_free (ids->serial_nbr);
+	g_free (ids);
+}
+
 static void
-arv_interface_clear_device_ids (ArvInterface *interface)
+_clear_device_ids (GArray *device_ids)
 {
-	ArvInterfacePrivate *priv = arv_interface_get_instance_private (interface);
 	unsigned int i;
 
-	for (i = 0; i < priv->device_ids->len; i++) {
-		g_free (g_array_index (priv->device_ids, ArvInterfaceDeviceIds *, i)->device);
-		g_free (g_array_index (priv->device_ids, ArvInterfaceDeviceIds *, i)->physical);
-		g_free (g_array_index (priv->device_ids, ArvInterfaceDeviceIds *, i)->address);
-		g_free (g_array_index (priv->device_ids, ArvInterfaceDeviceIds *, i)->vendor);
-		g_free (g_array_index (priv->device_ids, ArvInterfaceDeviceIds *, i)->model);
-		g_free (g_array_index (priv->device_ids, ArvInterfaceDeviceIds *, i)->serial_nbr);
-		g_free (g_array_index (priv->device_ids, ArvInterfaceDeviceIds *, i));
+	for (i = 0; i < device_ids->len; i++)
+		arv_interface_device_ids_free (g_array_index (device_ids, ArvInterfaceDeviceIds *, i));
+	g_array_set_size (device_ids, 0);
+}
+
+static void
+_copy_device_ids (GArray *destination, GArray *source)
+{
+	unsigned int i;
+
+	for (i = 0; i < source->len; i++) {
+		ArvInterfaceDeviceIds *ids;
+
+		ids = arv_interface_device_ids_copy (g_array_index (source, ArvInterfaceDeviceIds *, i));
+		g_array_append_val (destination, ids);
 	}
-	g_array_set_size (priv->device_ids, 0);
+}
+
+static void
+arv_interface_clear_device_ids (ArvInterface *interface)
+{
+	ArvInterfacePrivate *priv = arv_interface_get_instance_private (interface);
+
+	_clear_device_ids (priv->device_ids);
 }
 
 static gint
@@ -68,6 +121,64 @@ _compare_device_ids (ArvInterfaceDeviceIds **a, ArvInterfaceDeviceIds **b)
 	return g_ascii_strcasecmp ((*a)->device, (*b)->device);
 }
 
+static gboolean
+_is_expectation_met (GArray *device_ids, guint n_expected_devices, const char **expected_device_ids)
+{
+	unsigned int i, j;
+
+	if (device_ids->len < n_expected_devices)
+		return FALSE;
+
+	if (expected_device_ids == NULL)
+		return TRUE;
+
+	for (i = 0; expected_device_ids[i] != NULL; i++) {
+		gboolean found = FALSE;
+
+		for (j = 0; j < device_ids->len && !found; j++) {
+			ArvInterfaceDeviceIds *ids = g_array_index (device_ids, ArvInterfaceDeviceIds *, j);
+
+			found = g_strcmp0 (ids->device, expected_device_ids[i]) == 0 ||
+				g_strcmp0 (ids->physical, expected_device_ids[i]) == 0 ||
+				g_strcmp0 (ids->address, expected_device_ids[i]) == 0;
+		}
+
+		if (!found)
+			return FALSE;
+	}
+
+	return TRUE;
+}
+
+static gboolean
+_discover (ArvInterface *interface, GArray *device_ids,
+	   guint n_expected_devices, const char **expected_device_ids, guint timeout_ms)
+{
+	ArvInterfaceClass *interface_class = ARV_INTERFACE_GET_CLASS (interface);
+	gboolean success;
+
+	if (interface_class->update_device_list_full != NULL)
+		success = interface_class->update_device_list_full (interface, device_ids,
+								    n_expected_devices, expected_device_ids,
+								    timeout_ms);
+	else {
+		interface_class->update_device_list (interface, device_ids);
+		success = _is_expectation_met (device_ids, n_expected_devices, expected_device_ids);
+	}
+
+	g_array_sort (device_ids, (GCompareFunc) _compare_device_ids);
+
+	return success;
+}
+
+static gboolean
+_is_cache_valid (ArvInterfacePrivate *priv)
+{
+	return priv->cache_ttl_ms > 0 &&
+		priv->cache_time > 0 &&
+		g_get_monotonic_time () - priv->cache_time < (gint64) priv->cache_ttl_ms * 1000;
+}
+
 /**
  * arv_interface_update_device_list:
  * @interface: a #ArvInterface
@@ -75,6 +186,9 @@ _compare_device_ids (ArvInterfaceDeviceIds **a, ArvInterfaceDeviceIds **b)
  * Updates the internal list of available devices. This may change the
  * connection between a list index and a device ID.
  *
+ * If a device list time to live is set, using arv_interface_set_device_list_ttl(), the result of the last
+ * complete discovery is reused as long as it is not expired.
+ *
  * Since: 0.2.0
  */
 
@@ -84,11 +198,167 @@ arv_interface_update_device_list (ArvInterface *interface)
 	ArvInterfacePrivate *priv = arv_interface_get_instance_private (interface);
 	g_return_if_fail (ARV_IS_INTERFACE (interface));
 
+	g_mutex_lock (&priv->cache_mutex);
+
+	if (!_is_cache_valid (priv)) {
+		_clear_device_ids (priv->cached_device_ids);
+		_discover (interface, priv->cached_device_ids, 0, NULL, 0);
+		priv->cache_time = g_get_monotonic_time ();
+	} else
+		arv_debug_interface ("[Interface::update_device_list] Use cached %s device list",
+				     ARV_INTERFACE_GET_CLASS (interface)->protocol);
+
 	arv_interface_clear_device_ids (interface);
+	_copy_device_ids (priv->device_ids, priv->cached_device_ids);
+
+	g_mutex_unlock (&priv->cache_mutex);
+}
+
+/**
+ * arv_interface_update_device_list_full:
+ * @interface: a #ArvInterface
+ * @n_expected_devices: number of devices to wait for, 0 for no constraint
+ * @expected_device_ids: (array zero-terminated=1) (allow-none): %NULL terminated list of device ids to wait for
+ * @timeout_ms: discovery timeout in milliseconds, 0 for the interface default
+ *
+ * Updates the internal list of available devices, like arv_interface_update_device_list(), but returns as soon as
+ * at least @n_expected_devices devices, and all the devices listed in @expected_device_ids, have answered. In this
+ * case, the list may not contain all the available devices.
+ *
+ * Returns: %TRUE if all the expected devices were found before the timeout.
+ *
+ * Since: 0.8.0
+ */
+
+gboolean
+arv_interface_update_device_list_full (ArvInterface *interface,
+				       guint n_expected_devices, const char **expected_device_ids,
+				       guint timeout_ms)
+{
+	ArvInterfacePrivate *priv = arv_interface_get_instance_private (interface);
+	gboolean is_complete;
+	gboolean success;
+
+	g_return_val_if_fail (ARV_IS_INTERFACE (interface), FALSE);
 
-	ARV_INTERFACE_GET_CLASS (interface)->update_device_list (interface, priv->device_ids);
+	is_complete = n_expected_devices == 0 && expected_device_ids == NULL;
 
-	g_array_sort (priv->device_ids, (GCompareFunc) _compare_device_ids);
+	g_mutex_lock (&priv->cache_mutex);
+
+	arv_interface_clear_device_ids (interface);
+
+	if (_is_cache_valid (priv) &&
+	    _is_expectation_met (priv->cached_device_ids, n_expected_devices, expected_device_ids)) {
+		_copy_device_ids (priv->device_ids, priv->cached_device_ids);
+		success = TRUE;
+	} else {
+		success = _discover (interface, priv->device_ids, n_expected_devices, expected_device_ids, timeout_ms);
+
+		/* Only a complete discovery is worth caching */
+		if (is_complete) {
+			_clear_device_ids (priv->cached_device_ids);
+			_copy_device_ids (priv->cached_device_ids, priv->device_ids);
+			priv->cache_time = g_get_monotonic_time ();
+		}
+	}
+
+	g_mutex_unlock (&priv->cache_mutex);
+
+	return success;
+}
+
+/**
+ * arv_interface_set_device_list_ttl:
+ * @interface: a #ArvInterface
+ * @ttl_ms: time to live of the device list, in milliseconds
+ *
+ * Sets for how long the result of a device discovery is considered valid. During this time,
+ * arv_interface_update_device_list() and arv_interface_open_device() don't send any discovery request on the
+ * network. A value of 0, which is the default, disables the cache.
+ *
+ * Since: 0.8.0
+ */
+
+void
+arv_interface_set_device_list_ttl (ArvInterface *interface, guint ttl_ms)
+{
+	ArvInterfacePrivate *priv = arv_interface_get_instance_private (interface);
+
+	g_return_if_fail (ARV_IS_INTERFACE (interface));
+
+	g_mutex_lock (&priv->cache_mutex);
+	priv->cache_ttl_ms = ttl_ms;
+	g_mutex_unlock (&priv->cache_mutex);
+}
+
+/**
+ * arv_interface_get_device_list_ttl:
+ * @interface: a #ArvInterface
+ *
+ * Returns: the device list time to live, in milliseconds.
+ *
+ * Since: 0.8.0
+ */
+
+guint
+arv_interface_get_device_list_ttl (ArvInterface *interface)
+{
+	ArvInterfacePrivate *priv = arv_interface_get_instance_private (interface);
+	guint ttl_ms;
+
+	g_return_val_if_fail (ARV_IS_INTERFACE (interface), 0);
+
+	g_mutex_lock (&priv->cache_mutex);
+	ttl_ms = priv->cache_ttl_ms;
+	g_mutex_unlock (&priv->cache_mutex);
+
+	return ttl_ms;
+}
+
+gboolean
+arv_interface_is_device_list_cache_valid (ArvInterface *interface)
+{
+	ArvInterfacePrivate *priv = arv_interface_get_instance_private (interface);
+	gboolean is_valid;
+
+	g_return_val_if_fail (ARV_IS_INTERFACE (interface), FALSE);
+
+	g_mutex_lock (&priv->cache_mutex);
+	is_valid = _is_cache_valid (priv);
+	g_mutex_unlock (&priv->cache_mutex);
+
+	return is_valid;
+}
+
+/*
+ * arv_interface_refresh_device_list_cache:
+ * @interface: a #ArvInterface
+ *
+ * Runs a complete discovery and stores its result in the device list cache, without changing the list returned by
+ * the arv_interface_get_device_xxx functions. The discovery is done without holding the cache lock, so it doesn't
+ * block concurrent accesses to the interface.
+ */
+
+void
+arv_interface_refresh_device_list_cache (ArvInterface *interface)
+{
+	ArvInterfacePrivate *priv = arv_interface_get_instance_private (interface);
+	GArray *device_ids;
+	GArray *old_device_ids;
+
+	g_return_if_fail (ARV_IS_INTERFACE (interface));
+
+	device_ids = g_array_new (FALSE, TRUE, sizeof (ArvInterfaceDeviceIds *));
+	_discover (interface, device_ids, 0, NULL, 0);
+
+	g_mutex_lock (&priv->cache_mutex);
+	old_device_ids = priv->cached_device_ids;
+	priv->cached_device_ids = device_ids;
+	priv->cache_time = g_get_monotonic_time ();
+	g_mutex_unlock (&priv->cache_mutex);
+
+	_clear_device_ids (old_device_ids);
+	g_array_free (old_device_ids, TRUE);
 }
 
 /**
@@ -330,9 +600,32 @@ arv_interface_get_device_protocol (ArvInterface *interface, unsigned int index)
 ArvDevice *
 arv_interface_open_device (ArvInterface *interface, const char *device_id)
 {
+	return arv_interface_open_device_with_error (interface, device_id, NULL);
+}
+
+/* Same as arv_interface_open_device(), but reports why the device could not be opened. Interfaces without an
+ * open_device_with_error implementation can only tell the device was not found. */
+
+ArvDevice *
+arv_interface_open_device_with_error (ArvInterface *interface, const char *device_id, GError **error)
+{
+	ArvInterfaceClass *interface_class;
+	ArvDevice *device;
+
 	g_return_val_if_fail (ARV_IS_INTERFACE (interface), NULL);
 
-	return ARV_INTERFACE_GET_CLASS (interface)->open_device (interface, device_id);
+	interface_class = ARV_INTERFACE_GET_CLASS (interface);
+
+	if (interface_class->open_device_with_error != NULL)
+		return interface_class->open_device_with_error (interface, device_id, error);
+
+	device = interface_class->open_device (interface, device_id);
+	if (device == NULL)
+		g_set_error (error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_NOT_FOUND,
+			     "[Interface::open_device] Device '%s' not found",
+			     device_id != NULL ? device_id : "(null)");
+
+	return device;
 }
 
 static void
@@ -341,6 +634,8 @@ arv_interface_init (ArvInterface *interface)
 	ArvInterfacePrivate *priv = arv_interface_get_instance_private (interface);
 
 	priv->device_ids = g_array_new (FALSE, TRUE, sizeof (ArvInterfaceDeviceIds *));
+	priv->cached_device_ids = g_array_new (FALSE, TRUE, sizeof (ArvInterfaceDeviceIds *));
+	g_mutex_init (&priv->cache_mutex);
 }
 
 static void
@@ -354,6 +649,11 @@ arv_interface_finalize (GObject *object)
 	arv_interface_clear_device_ids (interface);
 	g_array_free (priv->device_ids, TRUE);
 	priv->device_ids = NULL;
+
+	_clear_device_ids (priv->cached_device_ids);
+	g_array_free (priv->cached_device_ids, TRUE);
+	priv->cached_device_ids = NULL;
+	g_mutex_clear (&priv->cache_mutex);
 }
 
 static void
@@ -42,9 +42,20 @@ struct _ArvInterfaceClass {
 	ArvDevice *	(*open_device)			(ArvInterface *interface, const char *device_id);
 
 	const char *	protocol;
+
+	gboolean	(*update_device_list_full)	(ArvInterface *interface, GArray *device_ids,
+							 guint n_expected_devices, const char **expected_device_ids,
+							 guint timeout_ms);
+	ArvDevice *	(*open_device_with_error)	(ArvInterface *interface, const char *device_id,
+							 GError **error);
 };
 
 void 			arv_interface_update_device_list 	(ArvInterface *interface);
+gboolean		arv_interface_update_device_list_full	(ArvInterface *interface,
+								 guint n_expected_devices, const char **expected_device_ids,
+								 guint timeout_ms);
+void			arv_interface_set_device_list_ttl	(ArvInterface *interface, guint ttl_ms);
+guint			arv_interface_get_device_list_ttl	(ArvInterface *interface);
 unsigned int 		arv_interface_get_n_devices 		(ArvInterface *interface);
 const char * 		arv_interface_get_device_id 		(ArvInterface *interface, unsigned int index);
 const char * 		arv_interface_get_device_physical_id 	(ArvInterface *interface, unsigned int index);
@@ -44,6 +44,15 @@ typedef struct {
 	char *serial_nbr;
 } ArvInterfaceDeviceIds;
 
+ArvInterfaceDeviceIds *	arv_interface_device_ids_copy		(const ArvInterfaceDeviceIds *ids);
+void			arv_interface_device_ids_free		(ArvInterfaceDeviceIds *ids);
+
+ArvDevice *		arv_interface_open_device_with_error		(ArvInterface *interface, const char *device_id,
+									 GError **error);
+
+gboolean		arv_interface_is_device_list_cache_valid	(ArvInterface *interface);
+void			arv_interface_refresh_device_list_cache		(ArvInterface *interface);
+
 G_END_DECLS
 
 #endif
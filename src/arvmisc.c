@@ -676,6 +676,13 @@ ArvGstCapsInfos arv_gst_caps_infos[] = {
 		"video/x-raw-rgb, format=(string)RGB, bpp=(int)24, depth=(int)24",
 		"video/x-raw-rgb",	24,	24,	0
 	},
+	{
+		ARV_PIXEL_FORMAT_BGRA_8_PACKED,
+		"video/x-raw, format=(string)BGRx",
+		"video/x-raw",		"BGRx",
+		"video/x-raw-rgb, format=(string)BGRx, bpp=(int)32, depth=(int)24",
+		"video/x-raw-rgb",	32,	24,	0
+	},
 	{
 		ARV_PIXEL_FORMAT_CUSTOM_YUV_422_YUYV_PACKED,
 		"video/x-raw, format=(string)YUY2",
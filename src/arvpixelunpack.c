@@ -0,0 +1,484 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2019 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel@gnome.org>
+ */
+
+/**
+ * SECTION: arvpixelunpack
+ * @short_description: Unpacking of packed pixel formats
+ *
+ * Packed pixel formats, like Mono12p, BayerRG10p or Mono12Packed, save link
+ * bandwidth by not padding the pixels to a byte boundary. These functions
+ * convert packed images to 16 bit per pixel images, the pixel values being
+ * stored in the least significant bits, in the host byte order, as in the
+ * corresponding unpacked pixel formats (Mono12, BayerRG10...).
+ *
+ * Depending on the processor, the unpacking uses SSSE3, AVX2 or NEON
+ * instructions. The implementation is selected at runtime.
+ */
+
+#include <arvpixelunpackprivate.h>
+#include <arvdebug.h>
+
+#if ARV_SIMD_HAS_X86
+#include <immintrin.h>
+#endif
+
+#if ARV_SIMD_HAS_NEON
+#include <arm_neon.h>
+#endif
+
+typedef enum {
+	ARV_PIXEL_UNPACK_LAYOUT_10P,		/* PFNC, 4 pixels in 5 bytes, least significant bits first */
+	ARV_PIXEL_UNPACK_LAYOUT_12P,		/* PFNC, 2 pixels in 3 bytes, least significant bits first */
+	ARV_PIXEL_UNPACK_LAYOUT_10_PACKED,	/* GigE Vision, 2 pixels in 3 bytes, 2 bytes of most significant bits */
+	ARV_PIXEL_UNPACK_LAYOUT_12_PACKED	/* GigE Vision, 2 pixels in 3 bytes, 2 bytes of most significant bits */
+} ArvPixelUnpackLayout;
+
+typedef struct {
+	ArvPixelFormat packed_format;
+	ArvPixelFormat unpacked_format;
+	ArvPixelUnpackLayout layout;
+} ArvPixelUnpackFormat;
+
+static const ArvPixelUnpackFormat arv_pixel_unpack_formats[] = {
+	{ARV_PIXEL_FORMAT_MONO_10P,		ARV_PIXEL_FORMAT_MONO_10,	ARV_PIXEL_UNPACK_LAYOUT_10P},
+	{ARV_PIXEL_FORMAT_BAYER_BG_10P,		ARV_PIXEL_FORMAT_BAYER_BG_10,	ARV_PIXEL_UNPACK_LAYOUT_10P},
+	{ARV_PIXEL_FORMAT_BAYER_GB_10P,		ARV_PIXEL_FORMAT_BAYER_GB_10,	ARV_PIXEL_UNPACK_LAYOUT_10P},
+	{ARV_PIXEL_FORMAT_BAYER_GR_10P,		ARV_PIXEL_FORMAT_BAYER_GR_10,	ARV_PIXEL_UNPACK_LAYOUT_10P},
+	{ARV_PIXEL_FORMAT_BAYER_RG_10P,		ARV_PIXEL_FORMAT_BAYER_RG_10,	ARV_PIXEL_UNPACK_LAYOUT_10P},
+
+	{ARV_PIXEL_FORMAT_MONO_12P,		ARV_PIXEL_FORMAT_MONO_12,	ARV_PIXEL_UNPACK_LAYOUT_12P},
+	{ARV_PIXEL_FORMAT_BAYER_BG_12P,		ARV_PIXEL_FORMAT_BAYER_BG_12,	ARV_PIXEL_UNPACK_LAYOUT_12P},
+	{ARV_PIXEL_FORMAT_BAYER_GB_12P,		ARV_PIXEL_FORMAT_BAYER_GB_12,	ARV_PIXEL_UNPACK_LAYOUT_12P},
+	{ARV_PIXEL_FORMAT_BAYER_GR_12P,		ARV_PIXEL_FORMAT_BAYER_GR_12,	ARV_PIXEL_UNPACK_LAYOUT_12P},
+	{ARV_PIXEL_FORMAT_BAYER_RG_12P,		ARV_PIXEL_FORMAT_BAYER_RG_12,	ARV_PIXEL_UNPACK_LAYOUT_12P},
+
+	{ARV_PIXEL_FORMAT_MONO_10_PACKED,	ARV_PIXEL_FORMAT_MONO_10,	ARV_PIXEL_UNPACK_LAYOUT_10_PACKED},
+	{ARV_PIXEL_FORMAT_BAYER_BG_10_PACKED,	ARV_PIXEL_FORMAT_BAYER_BG_10,	ARV_PIXEL_UNPACK_LAYOUT_10_PACKED},
+	{ARV_PIXEL_FORMAT_BAYER_GB_10_PACKED,	ARV_PIXEL_FORMAT_BAYER_GB_10,	ARV_PIXEL_UNPACK_LAYOUT_10_PACKED},
+	{ARV_PIXEL_FORMAT_BAYER_GR_10_PACKED,	ARV_PIXEL_FORMAT_BAYER_GR_10,	ARV_PIXEL_UNPACK_LAYOUT_10_PACKED},
+	{ARV_PIXEL_FORMAT_BAYER_RG_10_PACKED,	ARV_PIXEL_FORMAT_BAYER_RG_10,	ARV_PIXEL_UNPACK_LAYOUT_10_PACKED},
+
+	{ARV_PIXEL_FORMAT_MONO_12_PACKED,	ARV_PIXEL_FORMAT_MONO_12,	ARV_PIXEL_UNPACK_LAYOUT_12_PACKED},
+	{ARV_PIXEL_FORMAT_BAYER_BG_12_PACKED,	ARV_PIXEL_FORMAT_BAYER_BG_12,	ARV_PIXEL_UNPACK_LAYOUT_12_PACKED},
+	{ARV_PIXEL_FORMAT_BAYER_GB_12_PACKED,	ARV_PIXEL_FORMAT_BAYER_GB_12,	ARV_PIXEL_UNPACK_LAYOUT_12_PACKED},
+	{ARV_PIXEL_FORMAT_BAYER_GR_12_PACKED,	ARV_PIXEL_FORMAT_BAYER_GR_12,	ARV_PIXEL_UNPACK_LAYOUT_12_PACKED},
+	{ARV_PIXEL_FORMAT_BAYER_RG_12_PACKED,	ARV_PIXEL_FORMAT_BAYER_RG_12,	ARV_PIXEL_UNPACK_LAYOUT_12_PACKED}
+};
+
+/* Description of the vector kernels, which unpack 8 pixels at once. The 16 input bytes are first shuffled
+ * such that each 16 bit lane contains the two bytes holding a pixel, v = data[shuffle[2 * i]] |
+ * data[shuffle[2 * i + 1]] << 8. The pixel value is then (v & mask_0) | ((v >> shift_1) & mask_1) |
+ * ((v >> shift_2) & mask_2). Shifts must be in the [1,15] range where the corresponding mask is not null. */
+
+typedef struct {
+	size_t n_vector_bytes;		/* Input bytes consumed per 8 pixels */
+	guint8 shuffle[16];
+	guint16 mask_0[8];
+	guint16 shift_1[8];
+	guint16 mask_1[8];
+	guint16 shift_2[8];
+	guint16 mask_2[8];
+} ArvPixelUnpackKernel;
+
+static const ArvPixelUnpackKernel arv_pixel_unpack_kernels[] = {
+	[ARV_PIXEL_UNPACK_LAYOUT_10P] = {
+		10,
+		{0, 1, 1, 2, 2, 3, 3, 4, 5, 6, 6, 7, 7, 8, 8, 9},
+		{0x3ff, 0, 0, 0, 0x3ff, 0, 0, 0},
+		{0, 2, 4, 6, 0, 2, 4, 6},
+		{0, 0x3ff, 0x3ff, 0x3ff, 0, 0x3ff, 0x3ff, 0x3ff},
+		{0, 0, 0, 0, 0, 0, 0, 0},
+		{0, 0, 0, 0, 0, 0, 0, 0}
+	},
+	[ARV_PIXEL_UNPACK_LAYOUT_12P] = {
+		12,
+		{0, 1, 1, 2, 3, 4, 4, 5, 6, 7, 7, 8, 9, 10, 10, 11},
+		{0xfff, 0, 0xfff, 0, 0xfff, 0, 0xfff, 0},
+		{0, 4, 0, 4, 0, 4, 0, 4},
+		{0, 0xfff, 0, 0xfff, 0, 0xfff, 0, 0xfff},
+		{0, 0, 0, 0, 0, 0, 0, 0},
+		{0, 0, 0, 0, 0, 0, 0, 0}
+	},
+	[ARV_PIXEL_UNPACK_LAYOUT_10_PACKED] = {
+		12,
+		{1, 0, 1, 2, 4, 3, 4, 5, 7, 6, 7, 8, 10, 9, 10, 11},
+		{0x3, 0, 0x3, 0, 0x3, 0, 0x3, 0},
+		{6, 6, 6, 6, 6, 6, 6, 6},
+		{0x3fc, 0x3fc, 0x3fc, 0x3fc, 0x3fc, 0x3fc, 0x3fc, 0x3fc},
+		{0, 4, 0, 4, 0, 4, 0, 4},
+		{0, 0x3, 0, 0x3, 0, 0x3, 0, 0x3}
+	},
+	[ARV_PIXEL_UNPACK_LAYOUT_12_PACKED] = {
+		12,
+		{1, 0, 1, 2, 4, 3, 4, 5, 7, 6, 7, 8, 10, 9, 10, 11},
+		{0xf, 0, 0xf, 0, 0xf, 0, 0xf, 0},
+		{4, 4, 4, 4, 4, 4, 4, 4},
+		{0xff0, 0xfff, 0xff0, 0xfff, 0xff0, 0xfff, 0xff0, 0xfff},
+		{0, 0, 0, 0, 0, 0, 0, 0},
+		{0, 0, 0, 0, 0, 0, 0, 0}
+	}
+};
+
+static const ArvPixelUnpackFormat *
+_find_format (ArvPixelFormat pixel_format)
+{
+	guint i;
+
+	for (i = 0; i < G_N_ELEMENTS (arv_pixel_unpack_formats); i++)
+		if (arv_pixel_unpack_formats[i].packed_format == pixel_format)
+			return &arv_pixel_unpack_formats[i];
+
+	return NULL;
+}
+
+static size_t
+_get_packed_size (ArvPixelUnpackLayout layout, size_t n_pixels)
+{
+	switch (layout) {
+		case ARV_PIXEL_UNPACK_LAYOUT_10P:
+			return (n_pixels * 10 + 7) / 8;
+		case ARV_PIXEL_UNPACK_LAYOUT_12P:
+		case ARV_PIXEL_UNPACK_LAYOUT_10_PACKED:
+		case ARV_PIXEL_UNPACK_LAYOUT_12_PACKED:
+			return (n_pixels * 3 + 1) / 2;
+	}
+
+	return 0;
+}
+
+/* Reference implementation, also used for the pixels left over by the vector kernels */
+
+static void
+_unpack_scalar (ArvPixelUnpackLayout layout, const guint8 *data, guint16 *output, size_t first_pixel,
+		size_t n_pixels)
+{
+	size_t i;
+
+	switch (layout) {
+		case ARV_PIXEL_UNPACK_LAYOUT_10P:
+			for (i = first_pixel; i < n_pixels; i++) {
+				size_t bit = i * 10;
+				guint v = data[bit >> 3] | (data[(bit >> 3) + 1] << 8);
+
+				output[i] = (v >> (bit & 7)) & 0x3ff;
+			}
+			break;
+		case ARV_PIXEL_UNPACK_LAYOUT_12P:
+			for (i = first_pixel; i < n_pixels; i++) {
+				size_t bit = i * 12;
+				guint v = data[bit >> 3] | (data[(bit >> 3) + 1] << 8);
+
+				output[i] = (v >> (bit & 7)) & 0xfff;
+			}
+			break;
+		case ARV_PIXEL_UNPACK_LAYOUT_10_PACKED:
+			for (i = first_pixel; i < n_pixels; i++) {
+				const guint8 *group = data + (i >> 1) * 3;
+
+				if ((i & 1) == 0)
+					output[i] = (group[0] << 2) | (group[1] & 0x3);
+				else
+					output[i] = (group[2] << 2) | ((group[1] >> 4) & 0x3);
+			}
+			break;
+		case ARV_PIXEL_UNPACK_LAYOUT_12_PACKED:
+			for (i = first_pixel; i < n_pixels; i++) {
+				const guint8 *group = data + (i >> 1) * 3;
+
+				if ((i & 1) == 0)
+					output[i] = (group[0] << 4) | (group[1] & 0xf);
+				else
+					output[i] = (group[2] << 4) | (group[1] >> 4);
+			}
+			break;
+	}
+}
+
+#if ARV_SIMD_HAS_X86
+
+/* x86 has no 16 bit variable shift before AVX-512, v >> shift is computed as the high half of v * 2^(16 - shift) */
+
+static void
+_get_multipliers (const guint16 *shifts, const guint16 *masks, guint16 *multipliers)
+{
+	guint i;
+
+	for (i = 0; i < 8; i++)
+		multipliers[i] = masks[i] != 0 ? 1 << (16 - shifts[i]) : 0;
+}
+
+/* SSE2 lacks a byte shuffle instruction, SSSE3 is the baseline of the x86 vector kernels */
+
+__attribute__ ((target ("ssse3")))
+static size_t
+_unpack_ssse3 (const ArvPixelUnpackKernel *kernel, const guint8 *data, size_t size, guint16 *output,
+	       size_t n_pixels)
+{
+	guint16 multipliers_1[8];
+	guint16 multipliers_2[8];
+	__m128i shuffle, mask_0, multiplier_1, mask_1, multiplier_2, mask_2;
+	size_t offset = 0;
+	size_t i;
+
+	_get_multipliers (kernel->shift_1, kernel->mask_1, multipliers_1);
+	_get_multipliers (kernel->shift_2, kernel->mask_2, multipliers_2);
+
+	shuffle = _mm_loadu_si128 ((const __m128i *) kernel->shuffle);
+	mask_0 = _mm_loadu_si128 ((const __m128i *) kernel->mask_0);
+	multiplier_1 = _mm_loadu_si128 ((const __m128i *) multipliers_1);
+	mask_1 = _mm_loadu_si128 ((const __m128i *) kernel->mask_1);
+	multiplier_2 = _mm_loadu_si128 ((const __m128i *) multipliers_2);
+	mask_2 = _mm_loadu_si128 ((const __m128i *) kernel->mask_2);
+
+	for (i = 0; i + 8 <= n_pixels && offset + 16 <= size; i += 8, offset += kernel->n_vector_bytes) {
+		__m128i v, pixels;
+
+		v = _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i *) (data + offset)), shuffle);
+
+		pixels = _mm_and_si128 (v, mask_0);
+		pixels = _mm_or_si128 (pixels, _mm_and_si128 (_mm_mulhi_epu16 (v, multiplier_1), mask_1));
+		pixels = _mm_or_si128 (pixels, _mm_and_si128 (_mm_mulhi_epu16 (v, multiplier_2), mask_2));
+
+		_mm_storeu_si128 ((__m128i *) (output + i), pixels);
+	}
+
+	return i;
+}
+
+/* The AVX2 byte shuffle works on each 128 bit lane independently, each lane unpacks 8 pixels */
+
+__attribute__ ((target ("avx2")))
+static size_t
+_unpack_avx2 (const ArvPixelUnpackKernel *kernel, const guint8 *data, size_t size, guint16 *output,
+	      size_t n_pixels)
+{
+	guint16 multipliers_1[8];
+	guint16 multipliers_2[8];
+	__m128i v128;
+	__m256i shuffle, mask_0, multiplier_1, mask_1, multiplier_2, mask_2;
+	size_t offset = 0;
+	size_t i;
+
+	_get_multipliers (kernel->shift_1, kernel->mask_1, multipliers_1);
+	_get_multipliers (kernel->shift_2, kernel->mask_2, multipliers_2);
+
+#define ARV_PIXEL_UNPACK_BROADCAST(array) \
+	(v128 = _mm_loadu_si128 ((const __m128i *) (array)), \
+	 _mm256_inserti128_si256 (_mm256_castsi128_si256 (v128), v128, 1))
+
+	shuffle = ARV_PIXEL_UNPACK_BROADCAST (kernel->shuffle);
+	mask_0 = ARV_PIXEL_UNPACK_BROADCAST (kernel->mask_0);
+	multiplier_1 = ARV_PIXEL_UNPACK_BROADCAST (multipliers_1);
+	mask_1 = ARV_PIXEL_UNPACK_BROADCAST (kernel->mask_1);
+	multiplier_2 = ARV_PIXEL_UNPACK_BROADCAST (multipliers_2);
+	mask_2 = ARV_PIXEL_UNPACK_BROADCAST (kernel->mask_2);
+
+#undef ARV_PIXEL_UNPACK_BROADCAST
+
+	for (i = 0;
+	     i + 16 <= n_pixels && offset + kernel->n_vector_bytes + 16 <= size;
+	     i += 16, offset += 2 * kernel->n_vector_bytes) {
+		__m256i v, pixels;
+
+		v = _mm256_inserti128_si256
+			(_mm256_castsi128_si256 (_mm_loadu_si128 ((const __m128i *) (data + offset))),
+			 _mm_loadu_si128 ((const __m128i *) (data + offset + kernel->n_vector_bytes)), 1);
+		v = _mm256_shuffle_epi8 (v, shuffle);
+
+		pixels = _mm256_and_si256 (v, mask_0);
+		pixels = _mm256_or_si256 (pixels, _mm256_and_si256 (_mm256_mulhi_epu16 (v, multiplier_1), mask_1));
+		pixels = _mm256_or_si256 (pixels, _mm256_and_si256 (_mm256_mulhi_epu16 (v, multiplier_2), mask_2));
+
+		_mm256_storeu_si256 ((__m256i *) (output + i), pixels);
+	}
+
+	return i;
+}
+
+#endif
+
+#if ARV_SIMD_HAS_NEON
+
+static size_t
+_unpack_neon (const ArvPixelUnpackKernel *kernel, const guint8 *data, size_t size, guint16 *output,
+	      size_t n_pixels)
+{
+	uint8x16_t shuffle;
+	uint16x8_t mask_0, mask_1, mask_2;
+	int16x8_t shift_1, shift_2;
+	size_t offset = 0;
+	size_t i;
+
+	shuffle = vld1q_u8 (kernel->shuffle);
+	mask_0 = vld1q_u16 (kernel->mask_0);
+	mask_1 = vld1q_u16 (kernel->mask_1);
+	mask_2 = vld1q_u16 (kernel->mask_2);
+	/* Negative shifts are right shifts */
+	shift_1 = vnegq_s16 (vreinterpretq_s16_u16 (vld1q_u16 (kernel->shift_1)));
+	shift_2 = vnegq_s16 (vreinterpretq_s16_u16 (vld1q_u16 (kernel->shift_2)));
+
+	for (i = 0; i + 8 <= n_pixels && offset + 16 <= size; i += 8, offset += kernel->n_vector_bytes) {
+		uint16x8_t v, pixels;
+
+		v = vreinterpretq_u16_u8 (vqtbl1q_u8 (vld1q_u8 (data + offset), shuffle));
+
+		pixels = vandq_u16 (v, mask_0);
+		pixels = vorrq_u16 (pixels, vandq_u16 (vshlq_u16 (v, shift_1), mask_1));
+		pixels = vorrq_u16 (pixels, vandq_u16 (vshlq_u16 (v, shift_2), mask_2));
+
+		vst1q_u16 (output + i, pixels);
+	}
+
+	return i;
+}
+
+#endif
+
+/**
+ * arv_pixel_unpack_with_isa:
+ * @isa: instruction set to use
+ * @pixel_format: packed pixel format
+ * @data: packed pixels
+ * @size: size of @data, in bytes
+ * @output: destination of the unpacked pixels
+ * @n_pixels: number of pixels to unpack
+ *
+ * Same as arv_pixel_unpack(), with an explicit instruction set. Used for the
+ * validation of the vector kernels against the scalar implementation.
+ *
+ * Returns: %TRUE on success.
+ */
+
+gboolean
+arv_pixel_unpack_with_isa (ArvSimdIsa isa, ArvPixelFormat pixel_format,
+			   const void *data, size_t size, guint16 *output, size_t n_pixels)
+{
+	const ArvPixelUnpackFormat *format;
+	const ArvPixelUnpackKernel *kernel;
+	size_t n_unpacked = 0;
+
+	g_return_val_if_fail (data != NULL || n_pixels == 0, FALSE);
+	g_return_val_if_fail (output != NULL || n_pixels == 0, FALSE);
+
+	format = _find_format (pixel_format);
+	if (format == NULL) {
+		arv_debug_misc ("[PixelUnpack::unpack] Pixel format 0x%08x is not a packed format", pixel_format);
+		return FALSE;
+	}
+
+	if (size < _get_packed_size (format->layout, n_pixels)) {
+		arv_debug_misc ("[PixelUnpack::unpack] %" G_GSIZE_FORMAT " bytes is too small for %" G_GSIZE_FORMAT
+				" pixels", size, n_pixels);
+		return FALSE;
+	}
+
+	if (!arv_simd_isa_is_supported (isa))
+		return FALSE;
+
+	kernel = &arv_pixel_unpack_kernels[format->layout];
+
+	switch (isa) {
+#if ARV_SIMD_HAS_X86
+		case ARV_SIMD_ISA_AVX2:
+			n_unpacked = _unpack_avx2 (kernel, data, size, output, n_pixels);
+			break;
+		case ARV_SIMD_ISA_SSSE3:
+			n_unpacked = _unpack_ssse3 (kernel, data, size, output, n_pixels);
+			break;
+#endif
+#if ARV_SIMD_HAS_NEON
+		case ARV_SIMD_ISA_NEON:
+			n_unpacked = _unpack_neon (kernel, data, size, output, n_pixels);
+			break;
+#endif
+		default:
+			break;
+	}
+
+	_unpack_scalar (format->layout, data, output, n_unpacked, n_pixels);
+
+	return TRUE;
+}
+
+/**
+ * arv_pixel_format_get_unpacked_format:
+ * @pixel_format: a pixel format
+ *
+ * Returns: the 16 bit per pixel format of the pixels unpacked by arv_pixel_unpack(), 0 if @pixel_format is
+ * not a supported packed format.
+ *
+ * Since: 0.8.0
+ */
+
+ArvPixelFormat
+arv_pixel_format_get_unpacked_format (ArvPixelFormat pixel_format)
+{
+	const ArvPixelUnpackFormat *format;
+
+	format = _find_format (pixel_format);
+
+	return format != NULL ? format->unpacked_format : 0;
+}
+
+/**
+ * arv_pixel_format_get_packed_size:
+ * @pixel_format: a packed pixel format
+ * @n_pixels: number of pixels
+ *
+ * Returns: the size of @n_pixels packed pixels, in bytes, 0 if @pixel_format is not a supported packed format.
+ *
+ * Since: 0.8.0
+ */
+
+size_t
+arv_pixel_format_get_packed_size (ArvPixelFormat pixel_format, size_t n_pixels)
+{
+	const ArvPixelUnpackFormat *format;
+
+	format = _find_format (pixel_format);
+
+	return format != NULL ? _get_packed_size (format->layout, n_pixels) : 0;
+}
+
+/**
+ * arv_pixel_unpack:
+ * @pixel_format: packed pixel format
+ * @data: (array length=size) (element-type guint8): packed pixels
+ * @size: size of @data, in bytes
+ * @output: (array length=n_pixels): destination of the unpacked pixels
+ * @n_pixels: number of pixels to unpack
+ *
+ * Unpacks @n_pixels pixels to 16 bit values. Supported formats are Mono10p,
+ * Mono12p, Bayer*10p, Bayer*12p, and the GigE Vision Mono10Packed,
+ * Mono12Packed, Bayer*10Packed and Bayer*12Packed formats. The image lines
+ * are expected to be contiguous, without any padding.
+ *
+ * Returns: %TRUE on success, %FALSE if @pixel_format is not supported or @data is too small.
+ *
+ * Since: 0.8.0
+ */
+
+gboolean
+arv_pixel_unpack (ArvPixelFormat pixel_format, const void *data, size_t size, guint16 *output, size_t n_pixels)
+{
+	return arv_pixel_unpack_with_isa (arv_simd_get_isa (), pixel_format, data, size, output, n_pixels);
+}
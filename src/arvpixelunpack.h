@@ -0,0 +1,43 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2019 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel@gnome.org>
+ */
+
+#ifndef ARV_PIXEL_UNPACK_H
+#define ARV_PIXEL_UNPACK_H
+
+#if !defined (ARV_H_INSIDE) && !defined (ARAVIS_COMPILATION)
+#error "Only <arv.h> can be included directly."
+#endif
+
+#include <arvtypes.h>
+
+G_BEGIN_DECLS
+
+ArvPixelFormat	arv_pixel_format_get_unpacked_format	(ArvPixelFormat pixel_format);
+size_t		arv_pixel_format_get_packed_size	(ArvPixelFormat pixel_format, size_t n_pixels);
+
+gboolean	arv_pixel_unpack			(ArvPixelFormat pixel_format,
+							 const void *data, size_t size,
+							 guint16 *output, size_t n_pixels);
+
+G_END_DECLS
+
+#endif
@@ -0,0 +1,110 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2019 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel@gnome.org>
+ */
+
+/* Runtime selection of the vector instruction set used by the image processing functions */
+
+#include <arvsimdprivate.h>
+#include <arvdebug.h>
+
+/**
+ * arv_simd_isa_is_supported:
+ * @isa: an instruction set
+ *
+ * Returns: %TRUE if @isa kernels are available in this build and supported by the processor.
+ */
+
+gboolean
+arv_simd_isa_is_supported (ArvSimdIsa isa)
+{
+	switch (isa) {
+		case ARV_SIMD_ISA_SCALAR:
+			return TRUE;
+#if ARV_SIMD_HAS_X86
+		case ARV_SIMD_ISA_SSSE3:
+			__builtin_cpu_init ();
+			return __builtin_cpu_supports ("ssse3");
+		case ARV_SIMD_ISA_AVX2:
+			__builtin_cpu_init ();
+			return __builtin_cpu_supports ("avx2");
+#endif
+#if ARV_SIMD_HAS_NEON
+		case ARV_SIMD_ISA_NEON:
+			return TRUE;
+#endif
+		default:
+			return FALSE;
+	}
+}
+
+/**
+ * arv_simd_isa_to_string:
+ * @isa: an instruction set
+ *
+ * Returns: the instruction set name.
+ */
+
+const char *
+arv_simd_isa_to_string (ArvSimdIsa isa)
+{
+	switch (isa) {
+		case ARV_SIMD_ISA_SSSE3:
+			return "SSSE3";
+		case ARV_SIMD_ISA_AVX2:
+			return "AVX2";
+		case ARV_SIMD_ISA_NEON:
+			return "NEON";
+		default:
+			return "scalar";
+	}
+}
+
+/**
+ * arv_simd_get_isa:
+ *
+ * Returns: the most capable instruction set supported by the processor, detected on first call.
+ */
+
+ArvSimdIsa
+arv_simd_get_isa (void)
+{
+	static gsize isa = 0;
+
+	/* Stored as isa + 1, as g_once_init_leave() does not accept 0 */
+	if (g_once_init_enter (&isa)) {
+		ArvSimdIsa selected_isa;
+
+		if (arv_simd_isa_is_supported (ARV_SIMD_ISA_AVX2))
+			selected_isa = ARV_SIMD_ISA_AVX2;
+		else if (arv_simd_isa_is_supported (ARV_SIMD_ISA_SSSE3))
+			selected_isa = ARV_SIMD_ISA_SSSE3;
+		else if (arv_simd_isa_is_supported (ARV_SIMD_ISA_NEON))
+			selected_isa = ARV_SIMD_ISA_NEON;
+		else
+			selected_isa = ARV_SIMD_ISA_SCALAR;
+
+		arv_debug_misc ("[Simd::get_isa] Use %s kernels", arv_simd_isa_to_string (selected_isa));
+
+		g_once_init_leave (&isa, selected_isa + 1);
+	}
+
+	return isa - 1;
+}
@@ -0,0 +1,58 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2019 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel@gnome.org>
+ */
+
+#ifndef ARV_SIMD_PRIVATE_H
+#define ARV_SIMD_PRIVATE_H
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/* Vector kernels are compiled for x86 with GCC or clang target attributes, and for little endian aarch64, where
+ * NEON is always available */
+
+#if defined (__GNUC__) && (defined (__x86_64__) || defined (__i386__))
+#define ARV_SIMD_HAS_X86	1
+#else
+#define ARV_SIMD_HAS_X86	0
+#endif
+
+#if defined (__aarch64__) && defined (__ARM_NEON) && G_BYTE_ORDER == G_LITTLE_ENDIAN
+#define ARV_SIMD_HAS_NEON	1
+#else
+#define ARV_SIMD_HAS_NEON	0
+#endif
+
+typedef enum {
+	ARV_SIMD_ISA_SCALAR,
+	ARV_SIMD_ISA_SSSE3,
+	ARV_SIMD_ISA_AVX2,
+	ARV_SIMD_ISA_NEON
+} ArvSimdIsa;
+
+ArvSimdIsa		arv_simd_get_isa		(void);
+gboolean		arv_simd_isa_is_supported	(ArvSimdIsa isa);
+const char *		arv_simd_isa_to_string		(ArvSimdIsa isa);
+
+G_END_DECLS
+
+#endif
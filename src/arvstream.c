@@ -31,7 +31,9 @@
  */
 
 #include <arvstreamprivate.h>
-#include <arvbuffer.h>
+#include <arvbufferprivate.h>
+#include <arvimageanalyzer.h>
+#include <arvclockmodel.h>
 #include <arvdebug.h>
 
 enum {
@@ -52,6 +54,8 @@ typedef struct {
 	GAsyncQueue *output_queue;
 	GRecMutex mutex;
 	gboolean emit_signals;
+	ArvImageAnalyzer *image_analyzer;
+	ArvClockModel *clock_model;
 } ArvStreamPrivate;
 
 G_DEFINE_ABSTRACT_TYPE_WITH_CODE (ArvStream, arv_stream, G_TYPE_OBJECT, G_ADD_PRIVATE (ArvStream))
@@ -168,20 +172,64 @@ ArvBuffer *
 arv_stream_pop_input_buffer (ArvStream *stream)
 {
 	ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
+	ArvBuffer *buffer;
 
 	g_return_val_if_fail (ARV_IS_STREAM (stream), NULL);
 
-	return g_async_queue_try_pop (priv->input_queue);
+	buffer = g_async_queue_try_pop (priv->input_queue);
+	if (buffer != NULL) {
+		buffer->priv->row_stride = 0;
+		g_clear_object (&buffer->priv->image_stats);
+	}
+
+	return buffer;
 }
 
 void
 arv_stream_push_output_buffer (ArvStream *stream, ArvBuffer *buffer)
 {
 	ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
+	ArvImageAnalyzer *image_analyzer = NULL;
+	ArvClockModel *clock_model = NULL;
 
 	g_return_if_fail (ARV_IS_STREAM (stream));
 	g_return_if_fail (ARV_IS_BUFFER (buffer));
 
+	buffer->priv->completion_timestamp_ns = g_get_real_time () * 1000LL;
+
+	g_rec_mutex_lock (&priv->mutex);
+	if (priv->image_analyzer != NULL)
+		image_analyzer = g_object_ref (priv->image_analyzer);
+	if (priv->clock_model != NULL)
+		clock_model = g_object_ref (priv->clock_model);
+	g_rec_mutex_unlock (&priv->mutex);
+
+	if (clock_model != NULL) {
+		buffer->priv->host_timestamp_ns = arv_clock_model_get_host_timestamp (clock_model,
+										      buffer->priv->timestamp_ns);
+		g_object_unref (clock_model);
+	} else
+		buffer->priv->host_timestamp_ns = 0;
+
+	/* Computed while the image data are still in the processor cache. This delays the reception of the next
+	 * packets, see arv_stream_set_image_analyzer(). */
+	if (image_analyzer != NULL) {
+		if (buffer->priv->status == ARV_BUFFER_STATUS_SUCCESS &&
+		    arv_buffer_payload_type_has_aoi (buffer->priv->payload_type) &&
+		    arv_image_analyzer_is_pixel_format_supported (buffer->priv->pixel_format)) {
+			GError *error = NULL;
+
+			arv_buffer_set_image_stats (buffer, arv_image_analyzer_process_buffer (image_analyzer,
+												buffer, &error));
+			if (error != NULL) {
+				arv_debug_stream ("[Stream::push_output_buffer] Image analysis failed: %s",
+						  error->message);
+				g_error_free (error);
+			}
+		}
+		g_object_unref (image_analyzer);
+	}
+
 	g_async_queue_push (priv->output_queue, buffer);
 
 	g_rec_mutex_lock (&priv->mutex);
@@ -397,6 +445,66 @@ arv_stream_get_emit_signals (ArvStream *stream)
 	return ret;
 }
 
+/**
+ * arv_stream_set_image_analyzer:
+ * @stream: a #ArvStream
+ * @image_analyzer: (allow-none): a #ArvImageAnalyzer, %NULL to disable the image analysis
+ *
+ * Makes @stream compute the statistics of the successfully received images, just before the buffers are
+ * pushed to the output queue, using @image_analyzer. This adds the analysis time to the buffer latency,
+ * but avoids to load the image data in the processor cache a second time. The statistics are available
+ * using arv_buffer_get_image_stats(). The images in an unsupported pixel format are not analyzed.
+ *
+ * The analysis runs in the stream receiving thread, which does not read the incoming packets in the
+ * meantime. If it takes longer than the socket buffer can absorb, typically with large images at a high frame
+ * rate, packets of the following frame are lost. In this case, use arv_image_analyzer_set_subsampling() and
+ * arv_image_analyzer_set_region() to reduce the analyzed pixel count, or analyze the popped buffers in the
+ * application thread instead.
+ *
+ * Since: 0.8.0
+ */
+
+void
+arv_stream_set_image_analyzer (ArvStream *stream, ArvImageAnalyzer *image_analyzer)
+{
+	ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
+
+	g_return_if_fail (ARV_IS_STREAM (stream));
+	g_return_if_fail (image_analyzer == NULL || ARV_IS_IMAGE_ANALYZER (image_analyzer));
+
+	if (image_analyzer != NULL)
+		g_object_ref (image_analyzer);
+
+	g_rec_mutex_lock (&priv->mutex);
+
+	g_clear_object (&priv->image_analyzer);
+	priv->image_analyzer = image_analyzer;
+
+	g_rec_mutex_unlock (&priv->mutex);
+}
+
+/* Clock model used for the conversion of the buffer timestamps to the host time base, see
+ * arv_buffer_get_host_timestamp() */
+
+void
+arv_stream_set_clock_model (ArvStream *stream, ArvClockModel *clock_model)
+{
+	ArvStreamPrivate *priv = arv_stream_get_instance_private (stream);
+
+	g_return_if_fail (ARV_IS_STREAM (stream));
+	g_return_if_fail (clock_model == NULL || ARV_IS_CLOCK_MODEL (clock_model));
+
+	if (clock_model != NULL)
+		g_object_ref (clock_model);
+
+	g_rec_mutex_lock (&priv->mutex);
+
+	g_clear_object (&priv->clock_model);
+	priv->clock_model = clock_model;
+
+	g_rec_mutex_unlock (&priv->mutex);
+}
+
 static void
 arv_stream_set_property (GObject * object, guint prop_id,
 			 const GValue * value, GParamSpec * pspec)
@@ -476,6 +584,9 @@ arv_stream_finalize (GObject *object)
 	g_async_queue_unref (priv->input_queue);
 	g_async_queue_unref (priv->output_queue);
 
+	g_clear_object (&priv->image_analyzer);
+	g_clear_object (&priv->clock_model);
+
 	g_rec_mutex_clear (&priv->mutex);
 
 	G_OBJECT_CLASS (arv_stream_parent_class)->finalize (object);
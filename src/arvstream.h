@@ -82,6 +82,7 @@ void		arv_stream_get_statistics		(ArvStream *stream,
 
 void 		arv_stream_set_emit_signals 		(ArvStream *stream, gboolean emit_signals);
 gboolean 	arv_stream_get_emit_signals 		(ArvStream *stream);
+void		arv_stream_set_image_analyzer		(ArvStream *stream, ArvImageAnalyzer *image_analyzer);
 
 G_END_DECLS
 
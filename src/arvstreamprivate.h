@@ -28,11 +28,13 @@
 #endif
 
 #include <arvstream.h>
+#include <arvclockmodel.h>
 
 G_BEGIN_DECLS
 
 ArvBuffer *	arv_stream_pop_input_buffer		(ArvStream *stream);
 void		arv_stream_push_output_buffer		(ArvStream *stream, ArvBuffer *buffer);
+void		arv_stream_set_clock_model		(ArvStream *stream, ArvClockModel *clock_model);
 
 G_END_DECLS
 
@@ -28,6 +28,7 @@
 #endif
 #include <arvfakeinterfaceprivate.h>
 #include <arvdevice.h>
+#include <arvinterfaceprivate.h>
 #include <arvdebug.h>
 #include <string.h>
 #include <arvmisc.h>
@@ -176,6 +177,266 @@ arv_update_device_list (void)
 	g_mutex_unlock (&arv_system_mutex);
 }
 
+/* Duration of the first discovery pass on each interface, in milliseconds. It is long enough for the devices of
+ * a local network to answer, and makes sure every interface is searched before the remaining time is spent waiting
+ * on a single one. */
+#define ARV_SYSTEM_FIRST_DISCOVERY_PASS_TIMEOUT_MS	100
+
+static void
+_remove_device_id (GPtrArray *device_ids, const char *device_id)
+{
+	unsigned int i;
+
+	if (device_id == NULL)
+		return;
+
+	/* The last element is the NULL terminator */
+	for (i = 0; i + 1 < device_ids->len; i++)
+		if (g_strcmp0 (g_ptr_array_index (device_ids, i), device_id) == 0) {
+			g_ptr_array_remove_index (device_ids, i);
+			return;
+		}
+}
+
+/* Fills @remaining_ids with the expected ids not found in the device lists updated so far, except the one of the
+ * interface at @skipped_index, and returns the number of devices still to be found */
+
+static guint
+_get_remaining_expectation (const gboolean *is_updated, unsigned int skipped_index,
+			    guint n_expected_devices, const char **expected_device_ids,
+			    GPtrArray *remaining_ids)
+{
+	guint n_devices = 0;
+	unsigned int i, j;
+
+	g_ptr_array_set_size (remaining_ids, 0);
+	if (expected_device_ids != NULL)
+		for (i = 0; expected_device_ids[i] != NULL; i++)
+			g_ptr_array_add (remaining_ids, (char *) expected_device_ids[i]);
+	g_ptr_array_add (remaining_ids, NULL);
+
+	for (i = 0; i < G_N_ELEMENTS (interfaces); i++) {
+		ArvInterface *interface;
+
+		if (!is_updated[i] || i == skipped_index)
+			continue;
+
+		interface = interfaces[i].get_interface_instance ();
+
+		n_devices += arv_interface_get_n_devices (interface);
+
+		for (j = 0; j < arv_interface_get_n_devices (interface); j++) {
+			_remove_device_id (remaining_ids, arv_interface_get_device_id (interface, j));
+			_remove_device_id (remaining_ids, arv_interface_get_device_physical_id (interface, j));
+			_remove_device_id (remaining_ids, arv_interface_get_device_address (interface, j));
+		}
+	}
+
+	return n_devices < n_expected_devices ? n_expected_devices - n_devices : 0;
+}
+
+/**
+ * arv_update_device_list_full:
+ * @n_expected_devices: number of devices to wait for, 0 for no constraint
+ * @expected_device_ids: (array zero-terminated=1) (allow-none): %NULL terminated list of device ids to wait for
+ * @timeout_ms: discovery timeout in milliseconds, 0 for the interface defaults
+ *
+ * Updates the list of currently online devices, like arv_update_device_list(), but stops the discovery as soon
+ * as at least @n_expected_devices devices, and all the devices listed in @expected_device_ids, have answered.
+ * In this case, the list may not contain all the online devices. Expected ids are compared to the device ids,
+ * physical ids and addresses.
+ *
+ * All the interfaces are first searched with a short timeout, then the ones which are still missing some of the
+ * expected devices are given the remaining time.
+ *
+ * Returns: %TRUE if all the expected devices were found before the timeout.
+ *
+ * Since: 0.8.0
+ **/
+
+gboolean
+arv_update_device_list_full (guint n_expected_devices, const char **expected_device_ids, guint timeout_ms)
+{
+	GPtrArray *remaining_ids;
+	gboolean is_updated[G_N_ELEMENTS (interfaces)] = {FALSE};
+	gboolean has_expectation;
+	gboolean is_met = FALSE;
+	gint64 start_time;
+	guint n_remaining_devices;
+	unsigned int pass;
+	unsigned int i;
+
+	has_expectation = n_expected_devices > 0 || expected_device_ids != NULL;
+
+	remaining_ids = g_ptr_array_new ();
+
+	g_mutex_lock (&arv_system_mutex);
+
+	start_time = g_get_monotonic_time ();
+
+	/* Without expectation, a single pass waits for all the answers */
+	for (pass = 0; pass < (has_expectation ? 2 : 1) && !is_met; pass++) {
+		guint pass_timeout_ms;
+
+		if (!has_expectation)
+			pass_timeout_ms = timeout_ms;
+		else if (pass == 0)
+			pass_timeout_ms = timeout_ms > 0 ?
+				MIN (timeout_ms, ARV_SYSTEM_FIRST_DISCOVERY_PASS_TIMEOUT_MS) :
+				ARV_SYSTEM_FIRST_DISCOVERY_PASS_TIMEOUT_MS;
+		else if (timeout_ms > 0) {
+			gint64 elapsed_ms = (g_get_monotonic_time () - start_time) / 1000;
+
+			if (elapsed_ms >= timeout_ms)
+				break;
+
+			pass_timeout_ms = timeout_ms - elapsed_ms;
+		} else
+			pass_timeout_ms = 0;
+
+		for (i = 0; i < G_N_ELEMENTS (interfaces) && !(pass > 0 && is_met); i++) {
+			ArvInterface *interface;
+
+			if (!interfaces[i].is_available)
+				continue;
+
+			interface = interfaces[i].get_interface_instance ();
+
+			/* Each interface only waits for the devices not found on the other ones. Once the
+			 * expectation is met, as the interface may know device aliases unknown here, the following
+			 * interfaces of the first pass are given an empty expectation, which returns immediately. */
+			if (is_met) {
+				g_ptr_array_set_size (remaining_ids, 0);
+				g_ptr_array_add (remaining_ids, NULL);
+				n_remaining_devices = 0;
+			} else
+				n_remaining_devices = _get_remaining_expectation (is_updated, i,
+										  n_expected_devices,
+										  expected_device_ids,
+										  remaining_ids);
+
+			if (arv_interface_update_device_list_full (interface, n_remaining_devices,
+								   expected_device_ids != NULL || is_met ?
+								   (const char **) remaining_ids->pdata : NULL,
+								   pass_timeout_ms) && has_expectation)
+				is_met = TRUE;
+
+			is_updated[i] = TRUE;
+		}
+
+		if (!is_met) {
+			n_remaining_devices = _get_remaining_expectation (is_updated, G_N_ELEMENTS (interfaces),
+									  n_expected_devices, expected_device_ids,
+									  remaining_ids);
+			is_met = n_remaining_devices == 0 && remaining_ids->len <= 1;
+		}
+	}
+
+	g_mutex_unlock (&arv_system_mutex);
+
+	g_ptr_array_unref (remaining_ids);
+
+	return is_met;
+}
+
+/**
+ * arv_set_device_list_ttl:
+ * @ttl_ms: time to live of the device lists, in milliseconds
+ *
+ * Sets for how long the result of a device discovery is considered valid, for all the interfaces. During this
+ * time, arv_update_device_list() and arv_open_device() don't send any discovery request. A value of 0, which is
+ * the default, disables the cache.
+ *
+ * Since: 0.8.0
+ **/
+
+void
+arv_set_device_list_ttl (guint ttl_ms)
+{
+	unsigned int i;
+
+	g_mutex_lock (&arv_system_mutex);
+
+	for (i = 0; i < G_N_ELEMENTS (interfaces); i++)
+		arv_interface_set_device_list_ttl (interfaces[i].get_interface_instance (), ttl_ms);
+
+	g_mutex_unlock (&arv_system_mutex);
+}
+
+static GThread *refresh_thread = NULL;
+static GMutex refresh_mutex;
+static GCond refresh_cond;
+static guint refresh_period_ms = 0;
+
+static void *
+_refresh_thread (void *data)
+{
+	g_mutex_lock (&refresh_mutex);
+
+	while (refresh_period_ms > 0) {
+		gint64 end_time;
+		unsigned int i;
+
+		for (i = 0; i < G_N_ELEMENTS (interfaces); i++) {
+			if (interfaces[i].is_available) {
+				ArvInterface *interface;
+
+				interface = g_object_ref (interfaces[i].get_interface_instance ());
+
+				/* Don't block arv_set_device_list_refresh_period during the discovery */
+				g_mutex_unlock (&refresh_mutex);
+				arv_interface_refresh_device_list_cache (interface);
+				g_mutex_lock (&refresh_mutex);
+
+				g_object_unref (interface);
+			}
+		}
+
+		end_time = g_get_monotonic_time () + (gint64) refresh_period_ms * 1000;
+		while (refresh_period_ms > 0 && g_cond_wait_until (&refresh_cond, &refresh_mutex, end_time))
+			;
+	}
+
+	g_mutex_unlock (&refresh_mutex);
+
+	return NULL;
+}
+
+/**
+ * arv_set_device_list_refresh_period:
+ * @period_ms: refresh period, in milliseconds
+ *
+ * Starts a background thread which periodically runs a device discovery on all the available interfaces. The
+ * result is stored in the device list caches, which makes the next calls to arv_update_device_list() and
+ * arv_open_device() immediate, provided the device list time to live set by arv_set_device_list_ttl() is larger
+ * than @period_ms. A value of 0 stops the background refresh.
+ *
+ * Since: 0.8.0
+ **/
+
+void
+arv_set_device_list_refresh_period (guint period_ms)
+{
+	GThread *thread = NULL;
+
+	g_mutex_lock (&refresh_mutex);
+
+	refresh_period_ms = period_ms;
+	g_cond_signal (&refresh_cond);
+
+	if (period_ms > 0 && refresh_thread == NULL)
+		refresh_thread = g_thread_new ("arv_device_list_refresh", _refresh_thread, NULL);
+	else if (period_ms == 0) {
+		thread = refresh_thread;
+		refresh_thread = NULL;
+	}
+
+	g_mutex_unlock (&refresh_mutex);
+
+	if (thread != NULL)
+		g_thread_join (thread);
+}
+
 /**
  * arv_get_n_devices:
  *
@@ -390,27 +651,70 @@ arv_get_device_protocol	(unsigned int index)
 ArvDevice *
 arv_open_device (const char *device_id)
 {
+	return arv_open_device_with_error (device_id, NULL);
+}
+
+/**
+ * arv_open_device_with_error:
+ * @device_id: (allow-none): a device identifier string
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Same as arv_open_device(), but reports why the device could not be opened. If the device was found on an
+ * interface but failed to open, the corresponding error is returned, otherwise the error is
+ * %ARV_DEVICE_ERROR_NOT_FOUND.
+ *
+ * Return value: (transfer full): A new #ArvDevice instance, %NULL on error.
+ *
+ * Since: 0.8.0
+ */
+
+ArvDevice *
+arv_open_device_with_error (const char *device_id, GError **error)
+{
+	ArvInterface *available_interfaces[G_N_ELEMENTS (interfaces)];
+	ArvDevice *device = NULL;
+	GError *open_error = NULL;
+	unsigned int n_interfaces = 0;
 	unsigned int i;
 
+	/* The system lock only protects the interface instances. The device opening itself is done outside of it, in
+	 * order to allow concurrent opening of different devices from several threads. */
+
 	g_mutex_lock (&arv_system_mutex);
 
-	for (i = 0; i < G_N_ELEMENTS (interfaces); i++) {
-		ArvInterface *interface;
-		ArvDevice *device;
+	for (i = 0; i < G_N_ELEMENTS (interfaces); i++)
+		if (interfaces[i].is_available)
+			available_interfaces[n_interfaces++] = g_object_ref (interfaces[i].get_interface_instance ());
 
-		if (interfaces[i].is_available) {
-			interface = interfaces[i].get_interface_instance ();
-			device = arv_interface_open_device (interface, device_id);
-			if (device != NULL) {
-				g_mutex_unlock (&arv_system_mutex);
-				return device;
-			}
+	g_mutex_unlock (&arv_system_mutex);
+
+	for (i = 0; i < n_interfaces; i++) {
+		if (device == NULL) {
+			GError *local_error = NULL;
+
+			device = arv_interface_open_device_with_error (available_interfaces[i], device_id,
+								       &local_error);
+
+			/* Keep the first error which is not the mere absence of the device on an interface */
+			if (local_error != NULL && open_error == NULL &&
+			    !g_error_matches (local_error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_NOT_FOUND))
+				open_error = local_error;
+			else
+				g_clear_error (&local_error);
 		}
+		g_object_unref (available_interfaces[i]);
 	}
 
-	g_mutex_unlock (&arv_system_mutex);
+	if (device != NULL) {
+		g_clear_error (&open_error);
+	} else {
+		if (open_error == NULL)
+			g_set_error (&open_error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_NOT_FOUND,
+				     "Device '%s' not found", device_id != NULL ? device_id : "(null)");
+		g_propagate_error (error, open_error);
+	}
 
-	return NULL;
+	return device;
 }
 
 /**
@@ -426,6 +730,8 @@ arv_shutdown (void)
 {
 	unsigned int i;
 
+	arv_set_device_list_refresh_period (0);
+
 	g_mutex_lock (&arv_system_mutex);
 
 	for (i = 0; i < G_N_ELEMENTS (interfaces); i++)
@@ -37,6 +37,10 @@ void 			arv_enable_interface 		(const char *interface_id);
 void 			arv_disable_interface		(const char *interface_id);
 
 void 			arv_update_device_list 		(void);
+gboolean		arv_update_device_list_full	(guint n_expected_devices, const char **expected_device_ids,
+							 guint timeout_ms);
+void			arv_set_device_list_ttl		(guint ttl_ms);
+void			arv_set_device_list_refresh_period	(guint period_ms);
 unsigned int 		arv_get_n_devices 		(void);
 const char * 		arv_get_device_id 		(unsigned int index);
 const char * 		arv_get_device_physical_id 	(unsigned int index);
@@ -47,6 +51,7 @@ const char * 		arv_get_device_serial_nbr 	(unsigned int index);
 const char *		arv_get_device_protocol		(unsigned int index);
 
 ArvDevice * 		arv_open_device 		(const char *device_id);
+ArvDevice *		arv_open_device_with_error	(const char *device_id, GError **error);
 
 void 			arv_shutdown 			(void);
 
@@ -30,6 +30,7 @@ static char *arv_option_device_address = NULL;
 static char *arv_option_debug_domains = NULL;
 static char *arv_option_cache_policy = NULL;
 static gboolean arv_option_show_time = FALSE;
+static gboolean arv_option_show_open_time = FALSE;
 
 static const GOptionEntry arv_option_entries[] =
 {
@@ -41,6 +42,8 @@ static const GOptionEntry arv_option_entries[] =
 		&arv_option_cache_policy, 	"Register cache policy", "[disable|enable|debug]" },
 	{ "time",		't', 0, G_OPTION_ARG_NONE,
 		&arv_option_show_time, 		"Show execution time", NULL},
+	{ "open-time",		'o', 0, G_OPTION_ARG_NONE,
+		&arv_option_show_open_time,	"Show device opening time, per phase", NULL},
 	{ "debug", 		'd', 0, G_OPTION_ARG_STRING,
 		&arv_option_debug_domains, 	NULL, "<category>[:<level>][,...]" },
 	{ NULL }
@@ -371,6 +374,40 @@ arv_tool_execute_command (int argc, char **argv, ArvDevice *device, ArvRegisterC
 		printf ("Executed in %g s\n", (g_get_monotonic_time () - start) / 1000000.0);
 }
 
+static ArvDevice *
+arv_tool_open_device (const char *device_id)
+{
+	static const struct {
+		ArvGvDeviceOpenPhase phase;
+		const char *name;
+	} phases[] = {
+		{ARV_GV_DEVICE_OPEN_PHASE_LOCATE,	"locate"},
+		{ARV_GV_DEVICE_OPEN_PHASE_BOOTSTRAP,	"bootstrap"},
+		{ARV_GV_DEVICE_OPEN_PHASE_XML_LOAD,	"xml load"},
+		{ARV_GV_DEVICE_OPEN_PHASE_XML_PARSE,	"xml parse"},
+		{ARV_GV_DEVICE_OPEN_PHASE_TAKE_CONTROL,	"take control"}
+	};
+	ArvDevice *device;
+	gint64 start;
+	unsigned int i;
+
+	start = g_get_monotonic_time ();
+
+	device = arv_open_device (device_id);
+
+	if (arv_option_show_open_time && ARV_IS_DEVICE (device)) {
+		printf ("Opened in %g s\n", (g_get_monotonic_time () - start) / 1000000.0);
+
+		if (ARV_IS_GV_DEVICE (device))
+			for (i = 0; i < G_N_ELEMENTS (phases); i++)
+				printf ("  %-14s %g s\n", phases[i].name,
+					arv_gv_device_get_open_phase_duration (ARV_GV_DEVICE (device),
+									       phases[i].phase) / 1000000.0);
+	}
+
+	return device;
+}
+
 int
 main (int argc, char **argv)
 {
@@ -412,7 +449,7 @@ main (int argc, char **argv)
 
 	device_id = arv_option_device_address != NULL ? arv_option_device_address : arv_option_device_name;
 	if (device_id != NULL) {
-		device = arv_open_device (device_id);
+		device = arv_tool_open_device (device_id);
 
 		if (ARV_IS_DEVICE (device)) {
 			if (argc < 2)
@@ -430,7 +467,7 @@ main (int argc, char **argv)
 		if (n_devices > 0) {
 			for (i = 0; i < n_devices; i++) {
 				device_id = arv_get_device_id (i);
-				device = arv_open_device (device_id);
+				device = arv_tool_open_device (device_id);
 
 				if (ARV_IS_DEVICE (device)) {
 					printf ("%s (%s)\n", device_id, arv_get_device_address (i));
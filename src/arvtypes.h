@@ -80,9 +80,18 @@ typedef struct _ArvInterface 		ArvInterface;
 typedef struct _ArvDevice 		ArvDevice;
 typedef struct _ArvStream 		ArvStream;
 typedef struct _ArvChunkParser		ArvChunkParser;
+typedef struct _ArvFeatureHandle	ArvFeatureHandle;
+typedef struct _ArvCameraGroup		ArvCameraGroup;
+typedef struct _ArvFrameSet		ArvFrameSet;
+typedef struct _ArvFrameSync		ArvFrameSync;
+typedef struct _ArvClockModel		ArvClockModel;
+typedef struct _ArvConverter		ArvConverter;
+typedef struct _ArvImageStats		ArvImageStats;
+typedef struct _ArvImageAnalyzer	ArvImageAnalyzer;
 
 typedef struct _ArvGvInterface 		ArvGvInterface;
 typedef struct _ArvGvDevice 		ArvGvDevice;
+typedef struct _ArvGvBandwidthPlanner	ArvGvBandwidthPlanner;
 typedef struct _ArvGvStream 		ArvGvStream;
 
 #if ARAVIS_HAS_USB
@@ -97,6 +106,7 @@ typedef struct _ArvGvFakeCamera		ArvGvFakeCamera;
 
 typedef struct _ArvZip			ArvZip;
 typedef struct _ArvZipFile 		ArvZipFile;
+typedef struct _ArvZipStream 		ArvZipStream;
 
 G_END_DECLS
 
@@ -29,6 +29,7 @@
 #include <arvuvdeviceprivate.h>
 #include <arvuvinterfaceprivate.h>
 #include <arvuvcpprivate.h>
+#include <arvdeviceprivate.h>
 #include <arvgc.h>
 #include <arvdebug.h>
 #include <libusb.h>
@@ -527,6 +528,23 @@ _bootstrap (ArvUvDevice *uv_device)
 	arv_debug_device ("genicam address =          0x%016lx", entry.address);
 	arv_debug_device ("genicam size    =          0x%016lx", entry.size);
 
+	schema_type = arv_uvcp_manifest_entry_get_schema_type (&entry);
+
+	/* Zipped data are inflated and parsed while being read from the device memory. If it fails,
+	 * fall back to a full download followed by decompression. */
+	if (schema_type == ARV_UVCP_SCHEMA_ZIP) {
+		uv_device->priv->genicam_xml = arv_device_load_zipped_genicam (device, entry.address, entry.size,
+									       &uv_device->priv->genicam_xml_size,
+									       &uv_device->priv->genicam);
+		if (uv_device->priv->genicam_xml != NULL) {
+			if (uv_device->priv->genicam == NULL)
+				uv_device->priv->genicam = arv_gc_new (ARV_DEVICE (uv_device),
+								       uv_device->priv->genicam_xml,
+								       uv_device->priv->genicam_xml_size);
+			return TRUE;
+		}
+	}
+
 	data = g_malloc0 (entry.size);
 	success = success && arv_device_read_memory (device, entry.address, entry.size, data, NULL);
 	if (!success){
@@ -542,8 +560,6 @@ _bootstrap (ArvUvDevice *uv_device)
 	g_string_free (string, TRUE);
 #endif
 
-	schema_type = arv_uvcp_manifest_entry_get_schema_type (&entry);
-
 	switch (schema_type) {
 		case ARV_UVCP_SCHEMA_ZIP:
 			{
@@ -99,8 +99,18 @@ arv_uv_interface_device_infos_unref (ArvUvInterfaceDeviceInfos *infos)
 }
 
 typedef struct {
+	GMutex devices_mutex;
 	GHashTable *devices;
 	libusb_context *usb;
+
+	/* Hotplug support */
+	gboolean has_hotplug;
+	libusb_hotplug_callback_handle hotplug_handle;
+	GHashTable *hotplug_devices;	/* libusb_device -> ArvInterfaceDeviceIds */
+	GSList *arrived_devices;
+	GSList *left_devices;
+	GThread *event_thread;
+	gint event_thread_run;		/* Atomic access */
 } ArvUvInterfacePrivate;
 
 struct _ArvUvInterface {
@@ -221,10 +231,12 @@ _usb_device_to_device_ids (ArvUvInterface *uv_interface, libusb_device *device)
 			libusb_get_string_descriptor_ascii (device_handle, index, serial_nbr, 256);
 
 		device_infos = arv_uv_interface_device_infos_new ((char *) manufacturer, (char *) product, (char *) serial_nbr);
+		g_mutex_lock (&uv_interface->priv->devices_mutex);
 		g_hash_table_replace (uv_interface->priv->devices, device_infos->name,
 				      arv_uv_interface_device_infos_ref (device_infos));
 		g_hash_table_replace (uv_interface->priv->devices, device_infos->full_name,
 				      arv_uv_interface_device_infos_ref (device_infos));
+		g_mutex_unlock (&uv_interface->priv->devices_mutex);
 		arv_uv_interface_device_infos_unref (device_infos);
 
 		device_ids->device = g_strdup (device_infos->name);
@@ -268,15 +280,8 @@ _discover (ArvUvInterface *uv_interface,  GArray *device_ids)
 		    uv_count++;
 		    if (device_ids != NULL)
 			    g_array_append_val (device_ids, ids);
-		    else {
-			    g_free (ids->device);
-			    g_free (ids->physical);
-			    g_free (ids->address);
-			    g_free (ids->vendor);
-			    g_free (ids->model);
-			    g_free (ids->serial_nbr);
-			    g_free (ids);
-		    }
+		    else
+			    arv_interface_device_ids_free (ids);
 		}
 	}
 
@@ -287,6 +292,137 @@ _discover (ArvUvInterface *uv_interface,  GArray *device_ids)
 	libusb_free_device_list (devices, 1);
 }
 
+/* Hotplug support. Device arrivals and removals are queued by the hotplug callback, as no synchronous transfer is
+ * allowed from there, and processed by the event thread once the libusb event handling returns. */
+
+static int LIBUSB_CALL
+_hotplug_cb (libusb_context *context, libusb_device *device, libusb_hotplug_event event, void *user_data)
+{
+	ArvUvInterface *uv_interface = user_data;
+
+	if (event == LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED)
+		uv_interface->priv->arrived_devices = g_slist_append (uv_interface->priv->arrived_devices,
+								      libusb_ref_device (device));
+	else if (event == LIBUSB_HOTPLUG_EVENT_DEVICE_LEFT)
+		uv_interface->priv->left_devices = g_slist_append (uv_interface->priv->left_devices,
+								   libusb_ref_device (device));
+
+	return 0;
+}
+
+static gboolean
+_remove_device_infos (gpointer key, gpointer value, gpointer user_data)
+{
+	ArvUvInterfaceDeviceInfos *infos = value;
+
+	return g_strcmp0 (infos->name, user_data) == 0;
+}
+
+static void
+_process_hotplug_events (ArvUvInterface *uv_interface)
+{
+	GSList *iter;
+
+	for (iter = uv_interface->priv->arrived_devices; iter != NULL; iter = iter->next) {
+		libusb_device *device = iter->data;
+		ArvInterfaceDeviceIds *ids;
+
+		ids = _usb_device_to_device_ids (uv_interface, device);
+		if (ids != NULL) {
+			arv_debug_interface ("[UvInterface::hotplug] Device '%s' arrived", ids->device);
+
+			g_mutex_lock (&uv_interface->priv->devices_mutex);
+			g_hash_table_replace (uv_interface->priv->hotplug_devices, libusb_ref_device (device), ids);
+			g_mutex_unlock (&uv_interface->priv->devices_mutex);
+		}
+		libusb_unref_device (device);
+	}
+	g_slist_free (uv_interface->priv->arrived_devices);
+	uv_interface->priv->arrived_devices = NULL;
+
+	for (iter = uv_interface->priv->left_devices; iter != NULL; iter = iter->next) {
+		libusb_device *device = iter->data;
+		ArvInterfaceDeviceIds *ids;
+
+		g_mutex_lock (&uv_interface->priv->devices_mutex);
+		ids = g_hash_table_lookup (uv_interface->priv->hotplug_devices, device);
+		if (ids != NULL) {
+			arv_debug_interface ("[UvInterface::hotplug] Device '%s' left", ids->device);
+
+			g_hash_table_foreach_remove (uv_interface->priv->devices, _remove_device_infos, ids->device);
+			g_hash_table_remove (uv_interface->priv->hotplug_devices, device);
+		}
+		g_mutex_unlock (&uv_interface->priv->devices_mutex);
+		libusb_unref_device (device);
+	}
+	g_slist_free (uv_interface->priv->left_devices);
+	uv_interface->priv->left_devices = NULL;
+}
+
+static void *
+_event_thread (void *data)
+{
+	ArvUvInterface *uv_interface = data;
+
+	while (g_atomic_int_get (&uv_interface->priv->event_thread_run)) {
+		struct timeval timeout = {0, ARV_UV_INTERFACE_EVENT_TIMEOUT_US};
+
+		libusb_handle_events_timeout_completed (uv_interface->priv->usb, &timeout, NULL);
+		_process_hotplug_events (uv_interface);
+	}
+
+	return NULL;
+}
+
+static void
+_start_hotplug (ArvUvInterface *uv_interface)
+{
+	int result;
+
+	if (!libusb_has_capability (LIBUSB_CAP_HAS_HOTPLUG)) {
+		arv_debug_interface ("[UvInterface::start_hotplug] Hotplug not supported, fall back to enumeration");
+		return;
+	}
+
+	/* Arrival events for the already connected devices are emitted during the callback registration */
+	result = libusb_hotplug_register_callback (uv_interface->priv->usb,
+						   LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED | LIBUSB_HOTPLUG_EVENT_DEVICE_LEFT,
+						   LIBUSB_HOTPLUG_ENUMERATE,
+						   LIBUSB_HOTPLUG_MATCH_ANY, LIBUSB_HOTPLUG_MATCH_ANY,
+						   LIBUSB_HOTPLUG_MATCH_ANY,
+						   _hotplug_cb, uv_interface, &uv_interface->priv->hotplug_handle);
+	if (result != LIBUSB_SUCCESS) {
+		arv_warning_interface ("[UvInterface::start_hotplug] Failed to register hotplug callback: %s",
+				       libusb_error_name (result));
+		return;
+	}
+
+	_process_hotplug_events (uv_interface);
+
+	uv_interface->priv->has_hotplug = TRUE;
+	uv_interface->priv->event_thread_run = TRUE;
+	uv_interface->priv->event_thread = g_thread_new ("arv_uv_interface", _event_thread, uv_interface);
+}
+
+static void
+_stop_hotplug (ArvUvInterface *uv_interface)
+{
+	if (!uv_interface->priv->has_hotplug)
+		return;
+
+	g_atomic_int_set (&uv_interface->priv->event_thread_run, FALSE);
+	libusb_hotplug_deregister_callback (uv_interface->priv->usb, uv_interface->priv->hotplug_handle);
+	g_thread_join (uv_interface->priv->event_thread);
+	uv_interface->priv->event_thread = NULL;
+
+	g_slist_free_full (uv_interface->priv->arrived_devices, (GDestroyNotify) libusb_unref_device);
+	uv_interface->priv->arrived_devices = NULL;
+	g_slist_free_full (uv_interface->priv->left_devices, (GDestroyNotify) libusb_unref_device);
+	uv_interface->priv->left_devices = NULL;
+
+	uv_interface->priv->has_hotplug = FALSE;
+}
+
 static void
 arv_uv_interface_update_device_list (ArvInterface *interface, GArray *device_ids)
 {
@@ -294,11 +430,28 @@ arv_uv_interface_update_device_list (ArvInterface *interface, GArray *device_ids
 
 	g_assert (device_ids->len == 0);
 
+	/* With hotplug support, the device table is always up to date */
+	if (uv_interface->priv->has_hotplug) {
+		GHashTableIter iter;
+		gpointer value;
+
+		g_mutex_lock (&uv_interface->priv->devices_mutex);
+		g_hash_table_iter_init (&iter, uv_interface->priv->hotplug_devices);
+		while (g_hash_table_iter_next (&iter, NULL, &value)) {
+			ArvInterfaceDeviceIds *ids = arv_interface_device_ids_copy (value);
+
+			g_array_append_val (device_ids, ids);
+		}
+		g_mutex_unlock (&uv_interface->priv->devices_mutex);
+
+		return;
+	}
+
 	_discover (uv_interface, device_ids);
 }
 
 static ArvDevice *
-_open_device (ArvInterface *interface, const char *device_id)
+_open_device (ArvInterface *interface, const char *device_id, GError **error)
 {
 	ArvUvInterface *uv_interface;
 	ArvDevice *device = NULL;
@@ -306,6 +459,8 @@ _open_device (ArvInterface *interface, const char *device_id)
 
 	uv_interface = ARV_UV_INTERFACE (interface);
 
+	g_mutex_lock (&uv_interface->priv->devices_mutex);
+
 	if (device_id == NULL) {
 		GList *device_list;
 
@@ -315,26 +470,49 @@ _open_device (ArvInterface *interface, const char *device_id)
 	} else
 		device_infos = g_hash_table_lookup (uv_interface->priv->devices, device_id);
 
-	if (device_infos == NULL)
+	if (device_infos != NULL)
+		arv_uv_interface_device_infos_ref (device_infos);
+
+	g_mutex_unlock (&uv_interface->priv->devices_mutex);
+
+	if (device_infos == NULL) {
+		g_set_error (error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_NOT_FOUND,
+			     "[UvInterface::open_device] Device '%s' not found",
+			     device_id != NULL ? device_id : "(null)");
 		return NULL;
+	}
 
 	device = arv_uv_device_new (device_infos->manufacturer, device_infos->product, device_infos->serial_nbr);
+	if (device == NULL)
+		g_set_error (error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_NOT_CONNECTED,
+			     "[UvInterface::open_device] Failed to open '%s - #%s'",
+			     device_infos->product, device_infos->serial_nbr);
+
+	arv_uv_interface_device_infos_unref (device_infos);
 
 	return device;
 }
 
 static ArvDevice *
-arv_uv_interface_open_device (ArvInterface *interface, const char *device_id)
+arv_uv_interface_open_device (ArvInterface *interface, const char *device_id, GError **error)
 {
 	ArvDevice *device;
-
-	device = _open_device (interface, device_id);
-	if (ARV_IS_DEVICE (device))
+	GError *local_error = NULL;
+
+	device = _open_device (interface, device_id, &local_error);
+	if (ARV_IS_DEVICE (device) ||
+	    ARV_UV_INTERFACE (interface)->priv->has_hotplug ||
+	    arv_interface_is_device_list_cache_valid (interface)) {
+		if (local_error != NULL)
+			g_propagate_error (error, local_error);
 		return device;
+	}
+
+	g_clear_error (&local_error);
 
 	_discover (ARV_UV_INTERFACE (interface), NULL);
 
-	return _open_device (interface, device_id);
+	return _open_device (interface, device_id, error);
 }
 
 static ArvInterface *uv_interface = NULL;
@@ -379,8 +557,14 @@ arv_uv_interface_init (ArvUvInterface *uv_interface)
 	uv_interface->priv = arv_uv_interface_get_instance_private (uv_interface);
 
 	libusb_init (&uv_interface->priv->usb);
+	g_mutex_init (&uv_interface->priv->devices_mutex);
 	uv_interface->priv->devices = g_hash_table_new_full (g_str_hash, g_str_equal, NULL,
 							     (GDestroyNotify) arv_uv_interface_device_infos_unref);
+	uv_interface->priv->hotplug_devices = g_hash_table_new_full (g_direct_hash, g_direct_equal,
+								     (GDestroyNotify) libusb_unref_device,
+								     (GDestroyNotify) arv_interface_device_ids_free);
+
+	_start_hotplug (uv_interface);
 }
 
 static void
@@ -388,7 +572,11 @@ arv_uv_interface_finalize (GObject *object)
 {
 	ArvUvInterface *uv_interface = ARV_UV_INTERFACE (object);
 
+	_stop_hotplug (uv_interface);
+
+	g_hash_table_unref (uv_interface->priv->hotplug_devices);
 	g_hash_table_unref (uv_interface->priv->devices);
+	g_mutex_clear (&uv_interface->priv->devices_mutex);
 
 	G_OBJECT_CLASS (arv_uv_interface_parent_class)->finalize (object);
 
@@ -404,7 +592,7 @@ arv_uv_interface_class_init (ArvUvInterfaceClass *uv_interface_class)
 	object_class->finalize = arv_uv_interface_finalize;
 
 	interface_class->update_device_list = arv_uv_interface_update_device_list;
-	interface_class->open_device = arv_uv_interface_open_device;
+	interface_class->open_device_with_error = arv_uv_interface_open_device;
 
 	interface_class->protocol = "USB3Vision";
 }
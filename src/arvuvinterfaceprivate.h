@@ -39,6 +39,8 @@
 #define ARV_UV_INTERFACE_EVENT_PROTOCOL			0x01
 #define ARV_UV_INTERFACE_DATA_PROTOCOL			0x02
 
+#define ARV_UV_INTERFACE_EVENT_TIMEOUT_US		100000
+
 G_BEGIN_DECLS
 
 void 			arv_uv_interface_destroy_instance 	(void);
@@ -107,9 +107,11 @@ arv_uv_stream_thread (void *data)
 				size = thread_data->trailer_size;
 		}
 
-		/* Avoid unnecessary memory copy by transferring data directly to the image buffer */
+		/* Avoid unnecessary memory copy by transferring data directly to the image buffer, unless the rows
+		 * have to be written at their padded offset */
 		if (buffer != NULL &&
 		    buffer->priv->status == ARV_BUFFER_STATUS_FILLING &&
+		    buffer->priv->row_stride == 0 &&
 		    offset + size <= buffer->priv->size)
 			packet = (ArvUvspPacket *) (buffer->priv->data + offset);
 		else
@@ -146,6 +148,7 @@ arv_uv_stream_thread (void *data)
 					if (buffer != NULL) {
 						buffer->priv->system_timestamp_ns = g_get_real_time () * 1000LL;
 						buffer->priv->status = ARV_BUFFER_STATUS_FILLING;
+						arv_buffer_invalidate_chunk_index (buffer);
 						buffer->priv->payload_type = arv_uvsp_packet_get_buffer_payload_type (packet);
 						buffer->priv->chunk_endianness = G_LITTLE_ENDIAN;
 						if (buffer->priv->payload_type == ARV_BUFFER_PAYLOAD_TYPE_IMAGE ||
@@ -156,6 +159,7 @@ arv_uv_stream_thread (void *data)
 										    &buffer->priv->x_offset,
 										    &buffer->priv->y_offset);
 							buffer->priv->pixel_format = arv_uvsp_packet_get_pixel_format (packet);
+							arv_buffer_get_padded_layout (buffer, NULL, &buffer->priv->row_stride);
 						}
 						buffer->priv->frame_id = arv_uvsp_packet_get_frame_id (packet);
 						buffer->priv->timestamp_ns = arv_uvsp_packet_get_timestamp (packet);
@@ -204,7 +208,7 @@ arv_uv_stream_thread (void *data)
 					if (buffer != NULL && buffer->priv->status == ARV_BUFFER_STATUS_FILLING) {
 						if (offset + transferred <= buffer->priv->size) {
 							if (packet == incoming_buffer)
-								memcpy (((char *) buffer->priv->data) + offset, packet, transferred);
+								arv_buffer_write_image_data (buffer, offset, packet, transferred);
 							offset += transferred;
 						} else
 							buffer->priv->status = ARV_BUFFER_STATUS_SIZE_MISMATCH;
@@ -271,3 +271,267 @@ arv_zip_get_file (ArvZip *zip, const char *name, size_t *size)
 
         return output_buffer;
 }
+
+/* Incremental extraction of the first file of a zip archive, using the local file header. It allows to inflate the
+ * archive content while it is downloaded, without the need of the central directory stored at the end of the
+ * archive. */
+
+#define ARV_ZIP_LOCAL_HEADER_SIZE	30
+#define ARV_ZIP_STREAM_CHUNK_SIZE	16384
+
+#define ARV_ZIP_FLAG_DATA_DESCRIPTOR	0x0008
+
+#define ARV_ZIP_METHOD_STORED		0
+#define ARV_ZIP_METHOD_DEFLATED		8
+
+typedef enum {
+	ARV_ZIP_STREAM_STATE_HEADER,
+	ARV_ZIP_STREAM_STATE_DATA,
+	ARV_ZIP_STREAM_STATE_DONE,
+	ARV_ZIP_STREAM_STATE_ERROR
+} ArvZipStreamState;
+
+struct _ArvZipStream {
+	ArvZipStreamState state;
+
+	ArvZipStreamCallback callback;
+	void *user_data;
+
+	GByteArray *header;
+	size_t header_size;
+
+	char *name;
+	guint16 flags;
+	guint16 method;
+	size_t compressed_size;
+	size_t uncompressed_size;
+	size_t n_consumed;
+
+	z_stream zs;
+	gboolean is_zs_initialized;
+
+	unsigned char output[ARV_ZIP_STREAM_CHUNK_SIZE];
+};
+
+/**
+ * arv_zip_stream_new: (skip)
+ * @callback: a callback for the uncompressed data
+ * @user_data: user data for @callback
+ * Return value: a new #ArvZipStream instance
+ */
+
+ArvZipStream *
+arv_zip_stream_new (ArvZipStreamCallback callback, void *user_data)
+{
+	ArvZipStream *zip_stream;
+
+	g_return_val_if_fail (callback != NULL, NULL);
+
+	zip_stream = g_new0 (ArvZipStream, 1);
+	zip_stream->state = ARV_ZIP_STREAM_STATE_HEADER;
+	zip_stream->callback = callback;
+	zip_stream->user_data = user_data;
+	zip_stream->header = g_byte_array_sized_new (ARV_ZIP_LOCAL_HEADER_SIZE);
+	zip_stream->header_size = ARV_ZIP_LOCAL_HEADER_SIZE;
+
+	return zip_stream;
+}
+
+void
+arv_zip_stream_free (ArvZipStream *zip_stream)
+{
+	g_return_if_fail (zip_stream != NULL);
+
+	if (zip_stream->is_zs_initialized)
+		inflateEnd (&zip_stream->zs);
+
+	g_byte_array_unref (zip_stream->header);
+	g_free (zip_stream->name);
+	g_free (zip_stream);
+}
+
+static gboolean
+_zip_stream_parse_header (ArvZipStream *zip_stream)
+{
+	const char *ptr = (const char *) zip_stream->header->data;
+
+	if (ARV_GUINT32_FROM_LE_PTR (ptr, 0) != 0x04034b50) {
+		arv_debug_misc ("[ZipStream::parse_header] Magic number for file header not found (0x04034b50)");
+		return FALSE;
+	}
+
+	if (zip_stream->header_size == ARV_ZIP_LOCAL_HEADER_SIZE) {
+		/* Variable length fields are not received yet */
+		zip_stream->header_size += ARV_GUINT16_FROM_LE_PTR (ptr, 26) + ARV_GUINT16_FROM_LE_PTR (ptr, 28);
+		if (zip_stream->header_size > ARV_ZIP_LOCAL_HEADER_SIZE)
+			return TRUE;
+	}
+
+	zip_stream->flags = ARV_GUINT16_FROM_LE_PTR (ptr, 6);
+	zip_stream->method = ARV_GUINT16_FROM_LE_PTR (ptr, 8);
+	zip_stream->compressed_size = ARV_GUINT32_FROM_LE_PTR (ptr, 18);
+	zip_stream->uncompressed_size = ARV_GUINT32_FROM_LE_PTR (ptr, 22);
+	zip_stream->name = g_strndup (ptr + ARV_ZIP_LOCAL_HEADER_SIZE, ARV_GUINT16_FROM_LE_PTR (ptr, 26));
+
+	arv_log_misc ("[ZipStream::parse_header] %s - method = %d - flags = 0x%04x - size = %" G_GSIZE_FORMAT
+		      " / %" G_GSIZE_FORMAT, zip_stream->name, zip_stream->method, zip_stream->flags,
+		      zip_stream->compressed_size, zip_stream->uncompressed_size);
+
+	if ((zip_stream->flags & ARV_ZIP_FLAG_DATA_DESCRIPTOR) != 0) {
+		/* Sizes are stored after the data */
+		zip_stream->compressed_size = 0;
+		zip_stream->uncompressed_size = 0;
+	}
+
+	switch (zip_stream->method) {
+		case ARV_ZIP_METHOD_STORED:
+			if ((zip_stream->flags & ARV_ZIP_FLAG_DATA_DESCRIPTOR) != 0) {
+				arv_debug_misc ("[ZipStream::parse_header] Unknown size of stored data");
+				return FALSE;
+			}
+			break;
+		case ARV_ZIP_METHOD_DEFLATED:
+			zip_stream->zs.zalloc = Z_NULL;
+			zip_stream->zs.zfree = Z_NULL;
+			zip_stream->zs.opaque = Z_NULL;
+			zip_stream->zs.avail_in = 0;
+			zip_stream->zs.next_in = Z_NULL;
+			if (inflateInit2 (&zip_stream->zs, -MAX_WBITS) != Z_OK) {
+				arv_debug_misc ("[ZipStream::parse_header] Failed to initialize zlib");
+				return FALSE;
+			}
+			zip_stream->is_zs_initialized = TRUE;
+			break;
+		default:
+			arv_debug_misc ("[ZipStream::parse_header] Unsupported compression method (%d)", zip_stream->method);
+			return FALSE;
+	}
+
+	zip_stream->state = zip_stream->method == ARV_ZIP_METHOD_STORED && zip_stream->compressed_size == 0 ?
+		ARV_ZIP_STREAM_STATE_DONE : ARV_ZIP_STREAM_STATE_DATA;
+
+	return TRUE;
+}
+
+static gboolean
+_zip_stream_inflate (ArvZipStream *zip_stream, const unsigned char *data, size_t size)
+{
+	int result;
+
+	zip_stream->zs.next_in = (unsigned char *) data;
+	zip_stream->zs.avail_in = size;
+
+	do {
+		size_t n_bytes;
+
+		zip_stream->zs.next_out = zip_stream->output;
+		zip_stream->zs.avail_out = ARV_ZIP_STREAM_CHUNK_SIZE;
+
+		result = inflate (&zip_stream->zs, Z_NO_FLUSH);
+		if (result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR) {
+			arv_debug_misc ("[ZipStream::inflate] Inflate error (%d)", result);
+			return FALSE;
+		}
+
+		n_bytes = ARV_ZIP_STREAM_CHUNK_SIZE - zip_stream->zs.avail_out;
+		if (n_bytes > 0)
+			zip_stream->callback (zip_stream->output, n_bytes, zip_stream->user_data);
+
+		if (result == Z_STREAM_END) {
+			zip_stream->state = ARV_ZIP_STREAM_STATE_DONE;
+			return TRUE;
+		}
+	} while (zip_stream->zs.avail_out == 0 || zip_stream->zs.avail_in > 0);
+
+	return TRUE;
+}
+
+/**
+ * arv_zip_stream_push: (skip)
+ * @zip_stream: a #ArvZipStream
+ * @data: the next chunk of zipped data
+ * @size: size of the chunk
+ *
+ * Processes the next chunk of the archive. Uncompressed data are passed to the stream callback. Data following
+ * the end of the first file are ignored.
+ *
+ * Return value: %FALSE on error.
+ */
+
+gboolean
+arv_zip_stream_push (ArvZipStream *zip_stream, const void *data, size_t size)
+{
+	const unsigned char *ptr = data;
+
+	g_return_val_if_fail (zip_stream != NULL, FALSE);
+	g_return_val_if_fail (data != NULL || size == 0, FALSE);
+
+	while (size > 0) {
+		size_t n_bytes;
+
+		switch (zip_stream->state) {
+			case ARV_ZIP_STREAM_STATE_HEADER:
+				n_bytes = MIN (size, zip_stream->header_size - zip_stream->header->len);
+				g_byte_array_append (zip_stream->header, ptr, n_bytes);
+				if (zip_stream->header->len == zip_stream->header_size &&
+				    !_zip_stream_parse_header (zip_stream))
+					zip_stream->state = ARV_ZIP_STREAM_STATE_ERROR;
+				break;
+			case ARV_ZIP_STREAM_STATE_DATA:
+				if (zip_stream->method == ARV_ZIP_METHOD_STORED) {
+					n_bytes = MIN (size, zip_stream->compressed_size - zip_stream->n_consumed);
+					zip_stream->callback (ptr, n_bytes, zip_stream->user_data);
+					zip_stream->n_consumed += n_bytes;
+					if (zip_stream->n_consumed == zip_stream->compressed_size)
+						zip_stream->state = ARV_ZIP_STREAM_STATE_DONE;
+				} else {
+					if (!_zip_stream_inflate (zip_stream, ptr, size))
+						zip_stream->state = ARV_ZIP_STREAM_STATE_ERROR;
+					n_bytes = size;
+				}
+				break;
+			case ARV_ZIP_STREAM_STATE_DONE:
+				return TRUE;
+			case ARV_ZIP_STREAM_STATE_ERROR:
+			default:
+				return FALSE;
+		}
+
+		ptr += n_bytes;
+		size -= n_bytes;
+	}
+
+	return zip_stream->state != ARV_ZIP_STREAM_STATE_ERROR;
+}
+
+gboolean
+arv_zip_stream_is_done (ArvZipStream *zip_stream)
+{
+	g_return_val_if_fail (zip_stream != NULL, FALSE);
+
+	return zip_stream->state == ARV_ZIP_STREAM_STATE_DONE;
+}
+
+const char *
+arv_zip_stream_get_file_name (ArvZipStream *zip_stream)
+{
+	g_return_val_if_fail (zip_stream != NULL, NULL);
+
+	return zip_stream->name;
+}
+
+/**
+ * arv_zip_stream_get_uncompressed_size: (skip)
+ * @zip_stream: a #ArvZipStream
+ *
+ * Return value: the uncompressed size of the file, as stored in its local header. 0 if the header is not parsed yet,
+ * or if the size is only stored after the compressed data.
+ */
+
+size_t
+arv_zip_stream_get_uncompressed_size (ArvZipStream *zip_stream)
+{
+	g_return_val_if_fail (zip_stream != NULL, 0);
+
+	return zip_stream->uncompressed_size;
+}
@@ -39,6 +39,24 @@ const GSList *	arv_zip_get_file_list	(ArvZip *zip);
 const char *	arv_zip_file_get_name			(ArvZipFile *zip_file);
 size_t		arv_zip_file_get_uncompressed_size	(ArvZipFile *zip_file);
 
+/**
+ * ArvZipStreamCallback:
+ * @data: a chunk of uncompressed data
+ * @size: size of the chunk
+ * @user_data: user data
+ *
+ * Called for each chunk of uncompressed data produced by a #ArvZipStream.
+ */
+
+typedef void (*ArvZipStreamCallback) (const void *data, size_t size, void *user_data);
+
+ArvZipStream *	arv_zip_stream_new			(ArvZipStreamCallback callback, void *user_data);
+void		arv_zip_stream_free			(ArvZipStream *zip_stream);
+gboolean	arv_zip_stream_push			(ArvZipStream *zip_stream, const void *data, size_t size);
+gboolean	arv_zip_stream_is_done			(ArvZipStream *zip_stream);
+const char *	arv_zip_stream_get_file_name		(ArvZipStream *zip_stream);
+size_t		arv_zip_stream_get_uncompressed_size	(ArvZipStream *zip_stream);
+
 #define ARV_GUINT32_FROM_LE_PTR(ptr,offset) arv_guint32_from_unaligned_le_ptr (ptr, offset)
 #define ARV_GUINT16_FROM_LE_PTR(ptr,offset) arv_guint16_from_unaligned_le_ptr (ptr, offset)
 
@@ -15,10 +15,17 @@ main (int argc, char **argv)
 
 	if (arv_camera_is_gv_device (camera)) {
 		unsigned packet_size;
+		gint64 start_time;
+		unsigned i;
 
-		packet_size = arv_camera_gv_auto_packet_size (camera, NULL);
-		printf ("Packet size set to %d bytes on camera %s-%s\n", packet_size,
-			arv_camera_get_vendor_name (camera, NULL), arv_camera_get_device_id (camera, NULL));
+		/* The second negotiation uses the cached result */
+		for (i = 0; i < 2; i++) {
+			start_time = g_get_monotonic_time ();
+			packet_size = arv_camera_gv_auto_packet_size (camera, NULL);
+			printf ("Packet size set to %d bytes on camera %s-%s in %.1f ms%s\n", packet_size,
+				arv_camera_get_vendor_name (camera, NULL), arv_camera_get_device_id (camera, NULL),
+				(g_get_monotonic_time () - start_time) / 1000.0, i > 0 ? " (cached)" : "");
+		}
 	} else {
 		printf ("%s-%s is not a GigEVision camera\n",
 			arv_camera_get_vendor_name (camera, NULL), arv_camera_get_device_id (camera, NULL));
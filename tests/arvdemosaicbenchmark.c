@@ -0,0 +1,126 @@
+#include <arv.h>
+#include "../src/arvdemosaicprivate.h"
+#include <stdlib.h>
+#include <stdio.h>
+
+static int arv_option_width = 2048;
+static int arv_option_height = 1536;
+static int arv_option_n_iterations = 50;
+static int arv_option_n_threads = 0;
+static gboolean arv_option_16_bit = FALSE;
+
+static const GOptionEntry arv_option_entries[] =
+{
+	{
+		"width",				0, 0, G_OPTION_ARG_INT,
+		&arv_option_width,			"Image width", NULL
+	},
+	{
+		"height",				0, 0, G_OPTION_ARG_INT,
+		&arv_option_height,			"Image height", NULL
+	},
+	{
+		"iterations",				'i', 0, G_OPTION_ARG_INT,
+		&arv_option_n_iterations,		"Number of conversions per measurement", NULL
+	},
+	{
+		"threads",				't', 0, G_OPTION_ARG_INT,
+		&arv_option_n_threads,			"Number of threads for the multithreaded measurement, 0 for all processors", NULL
+	},
+	{
+		"16-bit",				'l', 0, G_OPTION_ARG_NONE,
+		&arv_option_16_bit,			"Use 16 bit pixels", NULL
+	},
+	{ NULL }
+};
+
+static const char *method_names[] = {"nearest", "bilinear", "edge-aware"};
+
+static double
+measure (ArvSimdIsa isa, ArvPixelFormat bayer_format, const void *input, size_t pixel_size,
+	 void *output, ArvDemosaicMethod method, guint n_threads)
+{
+	gint64 start;
+	gint64 duration;
+	int i;
+
+	/* Warm up, with the output pages mapped */
+	arv_demosaic_with_isa (isa, bayer_format, input, arv_option_width * pixel_size,
+			       arv_option_width, arv_option_height,
+			       arv_demosaic_get_output_format (bayer_format, FALSE),
+			       output, 3 * arv_option_width * pixel_size, method, n_threads);
+
+	start = g_get_monotonic_time ();
+	for (i = 0; i < arv_option_n_iterations; i++)
+		arv_demosaic_with_isa (isa, bayer_format, input, arv_option_width * pixel_size,
+				       arv_option_width, arv_option_height,
+				       arv_demosaic_get_output_format (bayer_format, FALSE),
+				       output, 3 * arv_option_width * pixel_size, method, n_threads);
+	duration = g_get_monotonic_time () - start;
+
+	return (double) arv_option_width * arv_option_height * arv_option_n_iterations / MAX (duration, 1);
+}
+
+int
+main (int argc, char **argv)
+{
+	GOptionContext *context;
+	GError *error = NULL;
+	ArvPixelFormat bayer_format;
+	ArvSimdIsa isa;
+	GRand *rand;
+	guint8 *input;
+	guint8 *output;
+	size_t pixel_size;
+	size_t i;
+	int method;
+
+	context = g_option_context_new (NULL);
+	g_option_context_add_main_entries (context, arv_option_entries, NULL);
+
+	if (!g_option_context_parse (context, &argc, &argv, &error)) {
+		g_option_context_free (context);
+		g_print ("Option parsing failed: %s\n", error->message);
+		g_error_free (error);
+		return EXIT_FAILURE;
+	}
+
+	g_option_context_free (context);
+
+	if (arv_option_width < 2 || arv_option_height < 2 || arv_option_n_iterations < 1 || arv_option_n_threads < 0) {
+		g_print ("Invalid parameters\n");
+		return EXIT_FAILURE;
+	}
+
+	bayer_format = arv_option_16_bit ? ARV_PIXEL_FORMAT_BAYER_RG_12 : ARV_PIXEL_FORMAT_BAYER_RG_8;
+	pixel_size = arv_option_16_bit ? 2 : 1;
+	isa = arv_simd_get_isa ();
+
+	input = g_malloc ((size_t) arv_option_width * arv_option_height * pixel_size);
+	output = g_malloc ((size_t) 3 * arv_option_width * arv_option_height * pixel_size);
+
+	rand = g_rand_new_with_seed (1234);
+	for (i = 0; i < (size_t) arv_option_width * arv_option_height * pixel_size; i++)
+		input[i] = g_rand_int_range (rand, 0, arv_option_16_bit && (i & 1) ? 16 : 256);
+	g_rand_free (rand);
+
+	printf ("%dx%d %s pixels, %d iterations, %u processors\n\n",
+		arv_option_width, arv_option_height, arv_option_16_bit ? "16 bit" : "8 bit",
+		arv_option_n_iterations, g_get_num_processors ());
+	printf ("%-12s %14s %14s %14s\n", "method", "scalar", arv_simd_isa_to_string (isa), "threaded");
+
+	for (method = ARV_DEMOSAIC_METHOD_NEAREST; method <= ARV_DEMOSAIC_METHOD_EDGE_AWARE; method++) {
+		double scalar, simd, threaded;
+
+		scalar = measure (ARV_SIMD_ISA_SCALAR, bayer_format, input, pixel_size, output, method, 1);
+		simd = measure (isa, bayer_format, input, pixel_size, output, method, 1);
+		threaded = measure (isa, bayer_format, input, pixel_size, output, method, arv_option_n_threads);
+
+		printf ("%-12s %7.1f MPix/s %7.1f MPix/s %7.1f MPix/s\n", method_names[method], scalar, simd, threaded);
+	}
+
+	g_free (output);
+	g_free (input);
+
+	return EXIT_SUCCESS;
+}
@@ -1,5 +1,6 @@
 #include <arv.h>
 #include <stdlib.h>
+#include <string.h>
 
 static char **arv_option_filenames = NULL;
 static char *arv_option_debug_domains;
@@ -13,6 +14,12 @@ static const GOptionEntry arv_option_entries[] =
 	{ NULL }
 };
 
+static void
+_stream_cb (const void *data, size_t size, void *user_data)
+{
+	g_byte_array_append (user_data, data, size);
+}
+
 int
 main (int argc, char **argv)
 {
@@ -46,8 +53,38 @@ main (int argc, char **argv)
 		g_file_get_contents (arv_option_filenames[i], &buffer, &size, NULL);
 
 		if (buffer != NULL) {
+			ArvZipStream *stream;
+			GByteArray *output;
+			const GSList *zip_files;
+			size_t offset;
+
 			zip = arv_zip_new (buffer, size);
+			zip_files = arv_zip_get_file_list (zip);
+
+			/* Feed the streaming inflater with small chunks and compare with the full archive extraction */
+			output = g_byte_array_new ();
+			stream = arv_zip_stream_new (_stream_cb, output);
+			for (offset = 0; offset < size && !arv_zip_stream_is_done (stream); offset += 512)
+				if (!arv_zip_stream_push (stream, buffer + offset, MIN (512, size - offset)))
+					break;
+
+			if (zip_files != NULL && arv_zip_stream_is_done (stream)) {
+				void *data;
+				size_t data_size;
+
+				data = arv_zip_get_file (zip, arv_zip_file_get_name (zip_files->data), &data_size);
+				g_print ("%s: %s (%" G_GSIZE_FORMAT " bytes) - streaming %s\n",
+					 arv_option_filenames[i], arv_zip_stream_get_file_name (stream), data_size,
+					 data_size == output->len && memcmp (data, output->data, data_size) == 0 ?
+					 "ok" : "mismatch");
+				g_free (data);
+			} else
+				g_print ("%s: streaming failed\n", arv_option_filenames[i]);
+
+			arv_zip_stream_free (stream);
+			g_byte_array_unref (output);
 			arv_zip_free (zip);
+			g_free (buffer);
 		}
 	}
 
@@ -1,6 +1,13 @@
 #include <glib.h>
 #include <arv.h>
 
+#define ARAVIS_COMPILATION
+#include "../src/arvbufferprivate.h"
+#include "../src/arvpixelunpackprivate.h"
+#include "../src/arvdemosaicprivate.h"
+#include "../src/arvimageanalyzerprivate.h"
+#include <string.h>
+
 static void
 simple_buffer_test (void)
 {
@@ -113,6 +120,957 @@ allocate (void)
 	g_object_unref (buffer);
 }
 
+static void
+unpack_known_values (void)
+{
+	const guint8 packed_10p[] = {0x21, 0x43, 0x65, 0x87, 0xa9};
+	const guint8 packed_2x12[] = {0x21, 0x43, 0x65};
+	guint16 pixels[4];
+	gboolean success;
+
+	success = arv_pixel_unpack (ARV_PIXEL_FORMAT_MONO_10P, packed_10p, sizeof (packed_10p), pixels, 4);
+	g_assert (success);
+	g_assert_cmpint (pixels[0], ==, 0x321);
+	g_assert_cmpint (pixels[1], ==, 0x150);
+	g_assert_cmpint (pixels[2], ==, 0x076);
+	g_assert_cmpint (pixels[3], ==, 0x2a6);
+
+	success = arv_pixel_unpack (ARV_PIXEL_FORMAT_BAYER_RG_12P, packed_2x12, sizeof (packed_2x12), pixels, 2);
+	g_assert (success);
+	g_assert_cmpint (pixels[0], ==, 0x321);
+	g_assert_cmpint (pixels[1], ==, 0x654);
+
+	success = arv_pixel_unpack (ARV_PIXEL_FORMAT_MONO_12_PACKED, packed_2x12, sizeof (packed_2x12), pixels, 2);
+	g_assert (success);
+	g_assert_cmpint (pixels[0], ==, 0x213);
+	g_assert_cmpint (pixels[1], ==, 0x654);
+
+	success = arv_pixel_unpack (ARV_PIXEL_FORMAT_MONO_10_PACKED, packed_2x12, sizeof (packed_2x12), pixels, 2);
+	g_assert (success);
+	g_assert_cmpint (pixels[0], ==, 0x087);
+	g_assert_cmpint (pixels[1], ==, 0x194);
+
+	g_assert_cmpint (arv_pixel_format_get_unpacked_format (ARV_PIXEL_FORMAT_BAYER_GB_10P), ==,
+			 ARV_PIXEL_FORMAT_BAYER_GB_10);
+	g_assert_cmpint (arv_pixel_format_get_unpacked_format (ARV_PIXEL_FORMAT_MONO_8), ==, 0);
+	g_assert_cmpint (arv_pixel_format_get_packed_size (ARV_PIXEL_FORMAT_MONO_10P, 5), ==, 7);
+	g_assert_cmpint (arv_pixel_format_get_packed_size (ARV_PIXEL_FORMAT_MONO_12_PACKED, 5), ==, 8);
+
+	/* Unsupported format and truncated data */
+	g_assert (!arv_pixel_unpack (ARV_PIXEL_FORMAT_MONO_8, packed_2x12, sizeof (packed_2x12), pixels, 2));
+	g_assert (!arv_pixel_unpack (ARV_PIXEL_FORMAT_MONO_12P, packed_2x12, sizeof (packed_2x12), pixels, 3));
+}
+
+/* All the vector kernels available on the test machine must give the same result as the scalar one, for any
+ * number of pixels, including the ones not a multiple of the vector size */
+
+static void
+unpack_kernels (void)
+{
+	const ArvPixelFormat pixel_formats[] = {
+		ARV_PIXEL_FORMAT_MONO_10P,
+		ARV_PIXEL_FORMAT_MONO_12P,
+		ARV_PIXEL_FORMAT_MONO_10_PACKED,
+		ARV_PIXEL_FORMAT_MONO_12_PACKED
+	};
+	const ArvSimdIsa isas[] = {
+		ARV_SIMD_ISA_SSSE3,
+		ARV_SIMD_ISA_AVX2,
+		ARV_SIMD_ISA_NEON
+	};
+	const size_t max_n_pixels = 257;
+	GRand *rand;
+	guint8 *data;
+	guint16 *reference;
+	guint16 *pixels;
+	guint i, j;
+	size_t n_pixels;
+	size_t k;
+
+	rand = g_rand_new_with_seed (1234);
+	data = g_malloc (arv_pixel_format_get_packed_size (ARV_PIXEL_FORMAT_MONO_12P, max_n_pixels));
+	reference = g_new (guint16, max_n_pixels);
+	pixels = g_new (guint16, max_n_pixels);
+
+	for (j = 0; j < G_N_ELEMENTS (isas); j++)
+		if (arv_simd_isa_is_supported (isas[j]))
+			g_test_message ("Check %s kernel", arv_simd_isa_to_string (isas[j]));
+
+	for (i = 0; i < G_N_ELEMENTS (pixel_formats); i++) {
+		for (n_pixels = 0; n_pixels <= max_n_pixels; n_pixels++) {
+			size_t size = arv_pixel_format_get_packed_size (pixel_formats[i], n_pixels);
+
+			for (k = 0; k < size; k++)
+				data[k] = g_rand_int_range (rand, 0, 256);
+
+			g_assert (arv_pixel_unpack_with_isa (ARV_SIMD_ISA_SCALAR, pixel_formats[i],
+							     data, size, reference, n_pixels));
+
+			for (j = 0; j < G_N_ELEMENTS (isas); j++) {
+				if (!arv_simd_isa_is_supported (isas[j]))
+					continue;
+
+				memset (pixels, 0xff, max_n_pixels * sizeof (guint16));
+				g_assert (arv_pixel_unpack_with_isa (isas[j], pixel_formats[i],
+								     data, size, pixels, n_pixels));
+				g_assert (memcmp (pixels, reference, n_pixels * sizeof (guint16)) == 0);
+			}
+		}
+	}
+
+	g_free (pixels);
+	g_free (reference);
+	g_free (data);
+	g_rand_free (rand);
+}
+
+static void
+unpack_buffer (void)
+{
+	ArvBuffer *buffer;
+	ArvPixelFormat pixel_format = 0;
+	guint8 *data;
+	guint16 pixels[8 * 4];
+	guint i;
+
+	buffer = arv_buffer_new_allocate (arv_pixel_format_get_packed_size (ARV_PIXEL_FORMAT_MONO_12P, 8 * 4));
+	buffer->priv->payload_type = ARV_BUFFER_PAYLOAD_TYPE_IMAGE;
+	buffer->priv->status = ARV_BUFFER_STATUS_SUCCESS;
+	buffer->priv->pixel_format = ARV_PIXEL_FORMAT_MONO_12P;
+	buffer->priv->width = 8;
+	buffer->priv->height = 4;
+
+	/* Pixel i value is i * 0x7f */
+	data = (guint8 *) arv_buffer_get_data (buffer, NULL);
+	for (i = 0; i < 8 * 4; i += 2) {
+		guint p0 = i * 0x7f;
+		guint p1 = (i + 1) * 0x7f;
+
+		data[i / 2 * 3] = p0 & 0xff;
+		data[i / 2 * 3 + 1] = (p0 >> 8) | ((p1 & 0xf) << 4);
+		data[i / 2 * 3 + 2] = p1 >> 4;
+	}
+
+	g_assert (!arv_buffer_unpack_to_16bit (buffer, pixels, 8 * 4 - 1, NULL));
+	g_assert (arv_buffer_unpack_to_16bit (buffer, pixels, 8 * 4, &pixel_format));
+	g_assert_cmpint (pixel_format, ==, ARV_PIXEL_FORMAT_MONO_12);
+
+	for (i = 0; i < 8 * 4; i++)
+		g_assert_cmpint (pixels[i], ==, i * 0x7f);
+
+	g_object_unref (buffer);
+}
+
+static void
+padded_buffer (void)
+{
+	ArvBuffer *buffer;
+	guint8 *data;
+	guint8 packed[7 * 3 + 5];
+	guint16 pixels[6 * 3];
+	size_t size;
+	guint i;
+
+	/* 9 byte rows of 6 Mono12p pixels, padded to 12 bytes */
+	buffer = arv_buffer_new_padded (9 * 3, 3, 4);
+	g_assert (ARV_IS_BUFFER (buffer));
+	g_assert_cmpint (arv_buffer_get_row_alignment (buffer), ==, 4);
+
+	buffer->priv->payload_type = ARV_BUFFER_PAYLOAD_TYPE_IMAGE;
+	buffer->priv->status = ARV_BUFFER_STATUS_SUCCESS;
+	buffer->priv->pixel_format = ARV_PIXEL_FORMAT_MONO_12P;
+	buffer->priv->width = 6;
+	buffer->priv->height = 3;
+
+	data = (guint8 *) arv_buffer_get_data (buffer, &size);
+	g_assert_cmpint (size, ==, 9 * 3);
+	g_assert_cmpint (arv_buffer_get_image_row_stride (buffer), ==, 9);
+
+	for (i = 0; i < 6 * 3; i += 2) {
+		guint p0 = i * 0x7f;
+		guint p1 = (i + 1) * 0x7f;
+
+		data[i / 2 * 3] = p0 & 0xff;
+		data[i / 2 * 3 + 1] = (p0 >> 8) | ((p1 & 0xf) << 4);
+		data[i / 2 * 3 + 2] = p1 >> 4;
+	}
+
+	arv_buffer_pad_image_rows (buffer);
+
+	arv_buffer_get_data (buffer, &size);
+	g_assert_cmpint (size, ==, 12 * 3);
+	g_assert_cmpint (arv_buffer_get_image_row_stride (buffer), ==, 12);
+
+	g_assert (arv_buffer_unpack_to_16bit (buffer, pixels, 6 * 3, NULL));
+	for (i = 0; i < 6 * 3; i++)
+		g_assert_cmpint (pixels[i], ==, i * 0x7f);
+
+	g_object_unref (buffer);
+
+	/* Rows already aligned, or buffer without room for the padding */
+	buffer = arv_buffer_new_padded (8 * 3, 3, 4);
+	buffer->priv->payload_type = ARV_BUFFER_PAYLOAD_TYPE_IMAGE;
+	buffer->priv->pixel_format = ARV_PIXEL_FORMAT_MONO_8;
+	buffer->priv->width = 8;
+	buffer->priv->height = 3;
+	g_assert (!arv_buffer_get_padded_layout (buffer, NULL, NULL));
+	g_object_unref (buffer);
+
+	buffer = arv_buffer_new_allocate (7 * 3);
+	buffer->priv->payload_type = ARV_BUFFER_PAYLOAD_TYPE_IMAGE;
+	buffer->priv->pixel_format = ARV_PIXEL_FORMAT_MONO_8;
+	buffer->priv->width = 7;
+	buffer->priv->height = 3;
+	g_assert (!arv_buffer_get_padded_layout (buffer, NULL, NULL));
+	arv_buffer_pad_image_rows (buffer);
+	g_assert_cmpint (arv_buffer_get_image_row_stride (buffer), ==, 7);
+	g_object_unref (buffer);
+
+	/* Image data written at their padded offset during reception, in chunks spanning several rows */
+	buffer = arv_buffer_new_padded (7 * 3, 3, 4);
+	buffer->priv->payload_type = ARV_BUFFER_PAYLOAD_TYPE_IMAGE;
+	buffer->priv->pixel_format = ARV_PIXEL_FORMAT_MONO_8;
+	buffer->priv->width = 7;
+	buffer->priv->height = 3;
+	g_assert (arv_buffer_get_padded_layout (buffer, NULL, &buffer->priv->row_stride));
+	g_assert_cmpint (arv_buffer_get_image_row_stride (buffer), ==, 8);
+
+	data = (guint8 *) arv_buffer_get_data (buffer, &size);
+	g_assert_cmpint (size, ==, 8 * 3);
+	memset (data, 0xff, size);
+
+	for (i = 0; i < G_N_ELEMENTS (packed); i++)
+		packed[i] = i;
+
+	arv_buffer_write_image_data (buffer, 0, packed, 5);
+	arv_buffer_write_image_data (buffer, 5, packed + 5, 11);
+	/* Data past the last row are dropped */
+	arv_buffer_write_image_data (buffer, 16, packed + 16, G_N_ELEMENTS (packed) - 16);
+
+	for (i = 0; i < 8 * 3; i++)
+		g_assert_cmpint (data[i], ==, (i % 8) == 7 ? 0xff : (i / 8) * 7 + i % 8);
+
+	g_object_unref (buffer);
+}
+
+/* Bayer image of a uniform color, red 200, green 100 and blue 30, with 8 bit or 16 bit pixels */
+
+static void
+_fill_uniform_bayer (ArvPixelFormat bayer_format, void *data, guint width, guint height)
+{
+	guint red_x, red_y;
+	guint x, y;
+
+	switch (bayer_format) {
+		case ARV_PIXEL_FORMAT_BAYER_RG_8:
+		case ARV_PIXEL_FORMAT_BAYER_RG_16:
+			red_x = 0; red_y = 0;
+			break;
+		case ARV_PIXEL_FORMAT_BAYER_GR_8:
+		case ARV_PIXEL_FORMAT_BAYER_GR_16:
+			red_x = 1; red_y = 0;
+			break;
+		case ARV_PIXEL_FORMAT_BAYER_GB_8:
+		case ARV_PIXEL_FORMAT_BAYER_GB_16:
+			red_x = 0; red_y = 1;
+			break;
+		default:
+			red_x = 1; red_y = 1;
+			break;
+	}
+
+	for (y = 0; y < height; y++) {
+		for (x = 0; x < width; x++) {
+			guint value;
+
+			if ((x & 1) == red_x && (y & 1) == red_y)
+				value = 200;
+			else if ((x & 1) != red_x && (y & 1) != red_y)
+				value = 30;
+			else
+				value = 100;
+
+			if (ARV_PIXEL_FORMAT_BIT_PER_PIXEL (bayer_format) == 8)
+				((guint8 *) data)[y * width + x] = value;
+			else
+				((guint16 *) data)[y * width + x] = value * 256;
+		}
+	}
+}
+
+static void
+demosaic_uniform (void)
+{
+	const ArvPixelFormat bayer_formats[] = {
+		ARV_PIXEL_FORMAT_BAYER_GR_8,
+		ARV_PIXEL_FORMAT_BAYER_RG_8,
+		ARV_PIXEL_FORMAT_BAYER_GB_8,
+		ARV_PIXEL_FORMAT_BAYER_BG_8,
+		ARV_PIXEL_FORMAT_BAYER_GR_16,
+		ARV_PIXEL_FORMAT_BAYER_RG_16,
+		ARV_PIXEL_FORMAT_BAYER_GB_16,
+		ARV_PIXEL_FORMAT_BAYER_BG_16
+	};
+	const guint width = 37;
+	const guint height = 11;
+	guint16 *input;
+	guint16 *output;
+	guint i, k;
+	int method;
+
+	input = g_new (guint16, width * height);
+	output = g_new (guint16, 3 * width * height);
+
+	for (i = 0; i < G_N_ELEMENTS (bayer_formats); i++) {
+		gboolean is_8_bit = ARV_PIXEL_FORMAT_BIT_PER_PIXEL (bayer_formats[i]) == 8;
+		guint scale = is_8_bit ? 1 : 256;
+		size_t pixel_size = is_8_bit ? 1 : 2;
+
+		_fill_uniform_bayer (bayer_formats[i], input, width, height);
+
+		for (method = ARV_DEMOSAIC_METHOD_NEAREST; method <= ARV_DEMOSAIC_METHOD_EDGE_AWARE; method++) {
+			g_assert (arv_demosaic (bayer_formats[i], input, width * pixel_size, width, height,
+						arv_demosaic_get_output_format (bayer_formats[i], TRUE),
+						output, 3 * width * pixel_size, method, 1));
+
+			for (k = 0; k < width * height; k++) {
+				guint blue = is_8_bit ? ((guint8 *) output)[3 * k] : output[3 * k];
+				guint green = is_8_bit ? ((guint8 *) output)[3 * k + 1] : output[3 * k + 1];
+				guint red = is_8_bit ? ((guint8 *) output)[3 * k + 2] : output[3 * k + 2];
+
+				g_assert_cmpint (red, ==, 200 * scale);
+				g_assert_cmpint (green, ==, 100 * scale);
+				g_assert_cmpint (blue, ==, 30 * scale);
+			}
+		}
+	}
+
+	g_assert_cmpint (arv_demosaic_get_output_format (ARV_PIXEL_FORMAT_BAYER_RG_12, FALSE), ==,
+			 ARV_PIXEL_FORMAT_RGB_12_PACKED);
+	g_assert_cmpint (arv_demosaic_get_output_format (ARV_PIXEL_FORMAT_MONO_8, FALSE), ==, 0);
+
+	g_assert (!arv_demosaic (ARV_PIXEL_FORMAT_MONO_8, input, width, width, height,
+				 ARV_PIXEL_FORMAT_RGB_8_PACKED, output, 3 * width, ARV_DEMOSAIC_METHOD_BILINEAR, 1));
+	g_assert (!arv_demosaic (ARV_PIXEL_FORMAT_BAYER_RG_8, input, width, width, height,
+				 ARV_PIXEL_FORMAT_RGB_16_PACKED, output, 6 * width, ARV_DEMOSAIC_METHOD_BILINEAR, 1));
+	g_assert (!arv_demosaic (ARV_PIXEL_FORMAT_BAYER_RG_8, input, width, width, height,
+				 ARV_PIXEL_FORMAT_RGB_8_PACKED, output, 3 * width - 1, ARV_DEMOSAIC_METHOD_BILINEAR, 1));
+	g_assert (!arv_demosaic (ARV_PIXEL_FORMAT_BAYER_RG_8, input, width, 1, height,
+				 ARV_PIXEL_FORMAT_RGB_8_PACKED, output, 3 * width, ARV_DEMOSAIC_METHOD_BILINEAR, 1));
+
+	g_free (output);
+	g_free (input);
+}
+
+/* The vector kernels and the multithreaded conversion must give the same result as the scalar code, for widths
+ * not a multiple of the vector size, and row strides larger than the image width */
+
+static void
+demosaic_kernels (void)
+{
+	const ArvPixelFormat bayer_formats[] = {
+		ARV_PIXEL_FORMAT_BAYER_GR_8,
+		ARV_PIXEL_FORMAT_BAYER_RG_8,
+		ARV_PIXEL_FORMAT_BAYER_GB_8,
+		ARV_PIXEL_FORMAT_BAYER_BG_8,
+		ARV_PIXEL_FORMAT_BAYER_GR_16,
+		ARV_PIXEL_FORMAT_BAYER_RG_16,
+		ARV_PIXEL_FORMAT_BAYER_GB_16,
+		ARV_PIXEL_FORMAT_BAYER_BG_16
+	};
+	const ArvSimdIsa isas[] = {
+		ARV_SIMD_ISA_SCALAR,
+		ARV_SIMD_ISA_SSSE3,
+		ARV_SIMD_ISA_AVX2,
+		ARV_SIMD_ISA_NEON
+	};
+	const guint sizes[][2] = {{2, 2}, {3, 5}, {17, 4}, {18, 3}, {33, 33}, {100, 70}};
+	GRand *rand;
+	guint8 *input;
+	guint8 *reference;
+	guint8 *output;
+	guint i, j, k, l;
+	int method;
+
+	rand = g_rand_new_with_seed (1234);
+
+	for (i = 0; i < G_N_ELEMENTS (bayer_formats); i++) {
+		size_t pixel_size = ARV_PIXEL_FORMAT_BIT_PER_PIXEL (bayer_formats[i]) / 8;
+
+		for (j = 0; j < G_N_ELEMENTS (sizes); j++) {
+			guint width = sizes[j][0];
+			guint height = sizes[j][1];
+			size_t input_stride = width * pixel_size + 6;
+			size_t output_stride = 3 * width * pixel_size + 4;
+
+			input = g_malloc (input_stride * height);
+			reference = g_malloc0 (output_stride * height);
+			output = g_malloc (output_stride * height);
+
+			for (k = 0; k < input_stride * height; k++)
+				input[k] = g_rand_int_range (rand, 0, 256);
+
+			for (method = ARV_DEMOSAIC_METHOD_NEAREST; method <= ARV_DEMOSAIC_METHOD_EDGE_AWARE; method++) {
+				ArvPixelFormat output_format = arv_demosaic_get_output_format (bayer_formats[i],
+											       method == ARV_DEMOSAIC_METHOD_BILINEAR);
+
+				g_assert (arv_demosaic_with_isa (ARV_SIMD_ISA_SCALAR, bayer_formats[i],
+								 input, input_stride, width, height,
+								 output_format, reference, output_stride, method, 1));
+
+				for (k = 0; k < G_N_ELEMENTS (isas); k++) {
+					if (!arv_simd_isa_is_supported (isas[k]))
+						continue;
+
+					memset (output, 0, output_stride * height);
+					g_assert (arv_demosaic_with_isa (isas[k], bayer_formats[i],
+									 input, input_stride, width, height,
+									 output_format, output, output_stride, method, 3));
+
+					for (l = 0; l < height; l++)
+						g_assert (memcmp (output + l * output_stride, reference + l * output_stride,
+								  3 * width * pixel_size) == 0);
+				}
+			}
+
+			g_free (output);
+			g_free (reference);
+			g_free (input);
+		}
+	}
+
+	g_rand_free (rand);
+}
+
+static void
+demosaic_buffer (void)
+{
+	ArvBuffer *buffer;
+	ArvBuffer *output_buffer;
+	const guint8 *rgb;
+	size_t size;
+	guint i;
+
+	buffer = arv_buffer_new_allocate (8 * 4);
+	buffer->priv->payload_type = ARV_BUFFER_PAYLOAD_TYPE_IMAGE;
+	buffer->priv->status = ARV_BUFFER_STATUS_SUCCESS;
+	buffer->priv->pixel_format = ARV_PIXEL_FORMAT_BAYER_BG_8;
+	buffer->priv->frame_id = 42;
+	buffer->priv->timestamp_ns = 1000;
+	buffer->priv->width = 8;
+	buffer->priv->height = 4;
+
+	_fill_uniform_bayer (ARV_PIXEL_FORMAT_BAYER_BG_8, buffer->priv->data, 8, 4);
+
+	output_buffer = arv_buffer_new_allocate (3 * 8 * 4 - 1);
+	g_assert (!arv_buffer_demosaic (buffer, output_buffer, 0, ARV_DEMOSAIC_METHOD_BILINEAR, 0));
+	g_object_unref (output_buffer);
+
+	output_buffer = arv_buffer_new_allocate (3 * 8 * 4);
+	g_assert (arv_buffer_demosaic (buffer, output_buffer, 0, ARV_DEMOSAIC_METHOD_BILINEAR, 0));
+
+	g_assert_cmpint (arv_buffer_get_payload_type (output_buffer), ==, ARV_BUFFER_PAYLOAD_TYPE_IMAGE);
+	g_assert_cmpint (arv_buffer_get_image_pixel_format (output_buffer), ==, ARV_PIXEL_FORMAT_RGB_8_PACKED);
+	g_assert_cmpint (arv_buffer_get_image_width (output_buffer), ==, 8);
+	g_assert_cmpint (arv_buffer_get_image_height (output_buffer), ==, 4);
+	g_assert_cmpint (arv_buffer_get_frame_id (output_buffer), ==, 42);
+	g_assert_cmpint (arv_buffer_get_timestamp (output_buffer), ==, 1000);
+
+	rgb = arv_buffer_get_data (output_buffer, &size);
+	g_assert_cmpint (size, ==, 3 * 8 * 4);
+	for (i = 0; i < 8 * 4; i++) {
+		g_assert_cmpint (rgb[3 * i], ==, 200);
+		g_assert_cmpint (rgb[3 * i + 1], ==, 100);
+		g_assert_cmpint (rgb[3 * i + 2], ==, 30);
+	}
+
+	g_object_unref (output_buffer);
+	g_object_unref (buffer);
+}
+
+static void
+converter_steps (void)
+{
+	ArvConverter *converter;
+	GError *error = NULL;
+	guint8 lut[256] = {0};
+
+	converter = arv_converter_new (ARV_PIXEL_FORMAT_MONO_12);
+	g_assert_cmpint (arv_converter_get_output_format (converter), ==, ARV_PIXEL_FORMAT_MONO_12);
+
+	g_assert (!arv_converter_add_lut (converter, lut, &error));
+	g_assert_error (error, ARV_CONVERTER_ERROR, ARV_CONVERTER_ERROR_INVALID_PIXEL_FORMAT);
+	g_clear_error (&error);
+
+	g_assert (!arv_converter_add_window (converter, 100, 100, &error));
+	g_assert_error (error, ARV_CONVERTER_ERROR, ARV_CONVERTER_ERROR_INVALID_PARAMETER);
+	g_clear_error (&error);
+
+	g_assert (arv_converter_add_window (converter, 0, 4095, NULL));
+	g_assert (arv_converter_add_lut (converter, lut, NULL));
+	g_assert_cmpint (arv_converter_get_output_format (converter), ==, ARV_PIXEL_FORMAT_MONO_8);
+
+	g_assert (!arv_converter_add_swap_red_blue (converter, &error));
+	g_assert_error (error, ARV_CONVERTER_ERROR, ARV_CONVERTER_ERROR_INVALID_PIXEL_FORMAT);
+	g_clear_error (&error);
+
+	g_assert_cmpint (arv_converter_get_n_steps (converter), ==, 2);
+
+	g_object_unref (converter);
+
+	converter = arv_converter_new (ARV_PIXEL_FORMAT_BAYER_RG_12);
+	g_assert (arv_converter_add_window (converter, 0, 4095, NULL));
+
+	g_assert (!arv_converter_add_demosaic (converter, ARV_DEMOSAIC_METHOD_BILINEAR, FALSE, &error));
+	g_assert_error (error, ARV_CONVERTER_ERROR, ARV_CONVERTER_ERROR_INVALID_STEP);
+	g_clear_error (&error);
+
+	g_object_unref (converter);
+
+	converter = arv_converter_new (ARV_PIXEL_FORMAT_BAYER_RG_12P);
+	g_assert (arv_converter_add_unpack (converter, NULL));
+	g_assert (arv_converter_add_demosaic (converter, ARV_DEMOSAIC_METHOD_BILINEAR, FALSE, NULL));
+	g_assert_cmpint (arv_converter_get_output_format (converter), ==, ARV_PIXEL_FORMAT_RGB_12_PACKED);
+
+	g_assert (!arv_converter_add_alpha (converter, &error));
+	g_assert_error (error, ARV_CONVERTER_ERROR, ARV_CONVERTER_ERROR_INVALID_PIXEL_FORMAT);
+	g_clear_error (&error);
+
+	g_object_unref (converter);
+}
+
+static void
+converter_alpha (void)
+{
+	ArvConverter *converter;
+	const guint8 bgr[] = {1, 2, 3, 4, 5, 6};
+	guint8 bgra[8];
+
+	converter = arv_converter_new (ARV_PIXEL_FORMAT_BGR_8_PACKED);
+	g_assert (arv_converter_add_alpha (converter, NULL));
+	g_assert_cmpint (arv_converter_get_output_format (converter), ==, ARV_PIXEL_FORMAT_BGRA_8_PACKED);
+
+	g_assert (arv_converter_process (converter, bgr, sizeof (bgr), 2, 1, bgra, sizeof (bgra), NULL));
+
+	g_assert_cmpint (bgra[0], ==, 1); g_assert_cmpint (bgra[1], ==, 2); g_assert_cmpint (bgra[2], ==, 3);
+	g_assert_cmpint (bgra[3], ==, 255);
+	g_assert_cmpint (bgra[4], ==, 4); g_assert_cmpint (bgra[5], ==, 5); g_assert_cmpint (bgra[6], ==, 6);
+	g_assert_cmpint (bgra[7], ==, 255);
+
+	g_object_unref (converter);
+}
+
+/* Row by row unpacking, followed by a windowing to 8 bit */
+
+static void
+converter_unpack (void)
+{
+	ArvConverter *converter;
+	guint8 packed[3 * 6];
+	guint8 output[4 * 3];
+	GError *error = NULL;
+	guint i;
+
+	/* 4x3 Mono12p image, pixel i value is i * 0x100 + 0x80 */
+	for (i = 0; i < 12; i += 2) {
+		guint p0 = i * 0x100 + 0x80;
+		guint p1 = (i + 1) * 0x100 + 0x80;
+
+		packed[i / 2 * 3] = p0 & 0xff;
+		packed[i / 2 * 3 + 1] = (p0 >> 8) | ((p1 & 0xf) << 4);
+		packed[i / 2 * 3 + 2] = p1 >> 4;
+	}
+
+	converter = arv_converter_new (ARV_PIXEL_FORMAT_MONO_12P);
+	g_assert (arv_converter_add_unpack (converter, NULL));
+	g_assert_cmpint (arv_converter_get_output_format (converter), ==, ARV_PIXEL_FORMAT_MONO_12);
+	g_assert (arv_converter_add_window (converter, 0, 0x1000, NULL));
+
+	g_assert (arv_converter_process (converter, packed, 6, 4, 3, output, 4, NULL));
+	for (i = 0; i < 12; i++)
+		g_assert_cmpint (output[i], ==, ((i * 0x100 + 0x80) * 255 + 0x800) / 0x1000);
+
+	/* Odd width, the rows do not end on a byte boundary */
+	g_assert (!arv_converter_process (converter, packed, 6, 3, 3, output, 4, &error));
+	g_assert_error (error, ARV_CONVERTER_ERROR, ARV_CONVERTER_ERROR_INVALID_GEOMETRY);
+	g_clear_error (&error);
+
+	g_object_unref (converter);
+}
+
+/* A fused Bayer 16 to BGR 8 conversion, split in bands processed by several threads, must give the same result as
+ * the separate conversions */
+
+static void
+converter_process (void)
+{
+	ArvConverter *converter;
+	GRand *rand;
+	guint16 *bayer;
+	guint16 *rgb_16;
+	guint8 *output;
+	guint8 lut[256];
+	const guint width = 301;
+	const guint height = 400;
+	const size_t output_stride = 3 * width + 3;
+	guint n_threads;
+	guint x, y;
+
+	rand = g_rand_new_with_seed (1234);
+	bayer = g_new (guint16, width * height);
+	rgb_16 = g_new (guint16, 3 * width * height);
+	output = g_malloc (output_stride * height);
+
+	for (x = 0; x < width * height; x++)
+		bayer[x] = g_rand_int_range (rand, 0, 4096);
+	for (x = 0; x < 256; x++)
+		lut[x] = 255 - x;
+
+	g_assert (arv_demosaic (ARV_PIXEL_FORMAT_BAYER_GB_12, bayer, 2 * width, width, height,
+				ARV_PIXEL_FORMAT_RGB_12_PACKED, rgb_16, 6 * width, ARV_DEMOSAIC_METHOD_EDGE_AWARE, 1));
+
+	converter = arv_converter_new (ARV_PIXEL_FORMAT_BAYER_GB_12);
+	g_assert (arv_converter_add_demosaic (converter, ARV_DEMOSAIC_METHOD_EDGE_AWARE, FALSE, NULL));
+	g_assert (arv_converter_add_window (converter, 1024, 3072, NULL));
+	g_assert (arv_converter_add_swap_red_blue (converter, NULL));
+	g_assert (arv_converter_add_lut (converter, lut, NULL));
+	g_assert_cmpint (arv_converter_get_output_format (converter), ==, ARV_PIXEL_FORMAT_BGR_8_PACKED);
+
+	for (n_threads = 1; n_threads <= 4; n_threads += 3) {
+		arv_converter_set_n_threads (converter, n_threads);
+		memset (output, 0, output_stride * height);
+
+		g_assert (arv_converter_process (converter, bayer, 2 * width, width, height,
+						 output, output_stride, NULL));
+
+		for (y = 0; y < height; y++) {
+			for (x = 0; x < width; x++) {
+				const guint16 *rgb = rgb_16 + 3 * (y * width + x);
+				const guint8 *bgr = output + y * output_stride + 3 * x;
+				guint channel;
+
+				for (channel = 0; channel < 3; channel++) {
+					guint value = CLAMP ((int) rgb[channel] - 1024, 0, 2048);
+
+					value = (value * 255 + 1024) / 2048;
+					g_assert_cmpint (bgr[2 - channel], ==, 255 - value);
+				}
+			}
+		}
+	}
+
+	g_object_unref (converter);
+	g_free (output);
+	g_free (rgb_16);
+	g_free (bayer);
+	g_rand_free (rand);
+}
+
+/* Packed Bayer demosaicing, with the rows unpacked in the demosaicing window, must give the same result as the
+ * unpacking of the whole image followed by arv_demosaic() */
+
+static void
+converter_unpack_demosaic (void)
+{
+	ArvConverter *converter;
+	GRand *rand;
+	guint16 *bayer;
+	guint8 *packed;
+	guint16 *rgb;
+	guint16 *output;
+	const guint width = 300;
+	const guint height = 200;
+	const size_t packed_stride = width * 3 / 2;
+	guint n_threads;
+	guint i;
+
+	rand = g_rand_new_with_seed (1234);
+	bayer = g_new (guint16, width * height);
+	packed = g_malloc (packed_stride * height);
+	rgb = g_new (guint16, 3 * width * height);
+	output = g_new (guint16, 3 * width * height);
+
+	/* BayerRG12p, two pixels in three bytes */
+	for (i = 0; i < width * height; i += 2) {
+		bayer[i] = g_rand_int_range (rand, 0, 4096);
+		bayer[i + 1] = g_rand_int_range (rand, 0, 4096);
+
+		packed[i / 2 * 3] = bayer[i] & 0xff;
+		packed[i / 2 * 3 + 1] = (bayer[i] >> 8) | ((bayer[i + 1] & 0xf) << 4);
+		packed[i / 2 * 3 + 2] = bayer[i + 1] >> 4;
+	}
+
+	g_assert (arv_demosaic (ARV_PIXEL_FORMAT_BAYER_RG_12, bayer, 2 * width, width, height,
+				ARV_PIXEL_FORMAT_RGB_12_PACKED, rgb, 6 * width, ARV_DEMOSAIC_METHOD_EDGE_AWARE, 1));
+
+	converter = arv_converter_new (ARV_PIXEL_FORMAT_BAYER_RG_12P);
+	g_assert (arv_converter_add_unpack (converter, NULL));
+	g_assert (arv_converter_add_demosaic (converter, ARV_DEMOSAIC_METHOD_EDGE_AWARE, FALSE, NULL));
+
+	for (n_threads = 1; n_threads <= 4; n_threads += 3) {
+		arv_converter_set_n_threads (converter, n_threads);
+		memset (output, 0, 6 * width * height);
+
+		g_assert (arv_converter_process (converter, packed, packed_stride, width, height,
+						 output, 6 * width, NULL));
+		g_assert (memcmp (output, rgb, 6 * width * height) == 0);
+	}
+
+	g_object_unref (converter);
+	g_free (output);
+	g_free (rgb);
+	g_free (packed);
+	g_free (bayer);
+	g_rand_free (rand);
+}
+
+static void
+converter_yuv (void)
+{
+	ArvConverter *converter;
+	/* White, black, red and red, in UYVY order */
+	const guint8 uyvy[] = {128, 235, 128, 16, 90, 81, 240, 81};
+	guint8 rgb[12];
+	GError *error = NULL;
+
+	converter = arv_converter_new (ARV_PIXEL_FORMAT_YUV_422_PACKED);
+	g_assert (arv_converter_add_yuv_to_rgb (converter, FALSE, NULL));
+
+	g_assert (arv_converter_process (converter, uyvy, sizeof (uyvy), 4, 1, rgb, sizeof (rgb), NULL));
+
+	g_assert_cmpint (rgb[0], ==, 255); g_assert_cmpint (rgb[1], ==, 255); g_assert_cmpint (rgb[2], ==, 255);
+	g_assert_cmpint (rgb[3], ==, 0); g_assert_cmpint (rgb[4], ==, 0); g_assert_cmpint (rgb[5], ==, 0);
+	g_assert_cmpint (rgb[6], ==, 255); g_assert_cmpint (rgb[7], ==, 0); g_assert_cmpint (rgb[8], ==, 0);
+
+	g_assert (!arv_converter_process (converter, uyvy, sizeof (uyvy), 3, 1, rgb, sizeof (rgb), &error));
+	g_assert_error (error, ARV_CONVERTER_ERROR, ARV_CONVERTER_ERROR_INVALID_GEOMETRY);
+	g_clear_error (&error);
+
+	g_object_unref (converter);
+}
+
+static void
+converter_buffer (void)
+{
+	ArvConverter *converter;
+	ArvBuffer *buffer;
+	ArvBuffer *output_buffer;
+	const guint8 *data;
+	size_t size;
+	guint i;
+
+	buffer = arv_buffer_new_allocate (5 * 3 * 2);
+	buffer->priv->payload_type = ARV_BUFFER_PAYLOAD_TYPE_IMAGE;
+	buffer->priv->status = ARV_BUFFER_STATUS_SUCCESS;
+	buffer->priv->pixel_format = ARV_PIXEL_FORMAT_MONO_16;
+	buffer->priv->frame_id = 7;
+	buffer->priv->width = 5;
+	buffer->priv->height = 3;
+
+	for (i = 0; i < 5 * 3; i++)
+		((guint16 *) buffer->priv->data)[i] = i * 4096;
+
+	converter = arv_converter_new (ARV_PIXEL_FORMAT_MONO_8);
+	output_buffer = arv_buffer_new_allocate (5 * 3);
+	g_assert (!arv_converter_process_buffer (converter, buffer, output_buffer, NULL));
+	g_object_unref (converter);
+
+	converter = arv_converter_new (ARV_PIXEL_FORMAT_MONO_16);
+	g_assert (arv_converter_add_window (converter, 0, 0xffff, NULL));
+	g_assert (arv_converter_process_buffer (converter, buffer, output_buffer, NULL));
+
+	g_assert_cmpint (arv_buffer_get_image_pixel_format (output_buffer), ==, ARV_PIXEL_FORMAT_MONO_8);
+	g_assert_cmpint (arv_buffer_get_image_width (output_buffer), ==, 5);
+	g_assert_cmpint (arv_buffer_get_frame_id (output_buffer), ==, 7);
+
+	data = arv_buffer_get_data (output_buffer, &size);
+	for (i = 0; i < 5 * 3; i++)
+		g_assert_cmpint (data[i], ==, (i * 4096 * 255 + 0x7fff) / 0xffff);
+
+	g_object_unref (output_buffer);
+	g_object_unref (converter);
+	g_object_unref (buffer);
+}
+
+static void
+image_stats_known_values (void)
+{
+	ArvImageAnalyzer *analyzer;
+	ArvImageStats *stats;
+	GError *error = NULL;
+	const guint32 *histogram;
+	guint8 bayer[4 * 4];
+	guint8 mono[4 * 4];
+	guint16 mono_16[2] = {0xffff, 0x0010};
+	guint n_bins;
+	guint x, y;
+
+	/* BayerRG8: red 10, green 20, saturated blue */
+	for (y = 0; y < 4; y++)
+		for (x = 0; x < 4; x++)
+			bayer[y * 4 + x] = (x % 2) == 0 && (y % 2) == 0 ? 10 : ((x % 2) == 1 && (y % 2) == 1 ? 255 : 20);
+
+	analyzer = arv_image_analyzer_new ();
+
+	stats = arv_image_analyzer_process (analyzer, ARV_PIXEL_FORMAT_BAYER_RG_8, bayer, 4, 4, 4, NULL);
+	g_assert (ARV_IS_IMAGE_STATS (stats));
+
+	histogram = arv_image_stats_get_histogram (stats, ARV_IMAGE_STATS_CHANNEL_RED, &n_bins);
+	g_assert_cmpint (n_bins, ==, 256);
+	g_assert_cmpint (histogram[10], ==, 4);
+	histogram = arv_image_stats_get_histogram (stats, ARV_IMAGE_STATS_CHANNEL_GREEN, NULL);
+	g_assert_cmpint (histogram[20], ==, 8);
+	histogram = arv_image_stats_get_histogram (stats, ARV_IMAGE_STATS_CHANNEL_ALL, NULL);
+	g_assert_cmpint (histogram[255], ==, 4);
+
+	g_assert_cmpint (arv_image_stats_get_n_pixels (stats, ARV_IMAGE_STATS_CHANNEL_ALL), ==, 16);
+	g_assert_cmpint (arv_image_stats_get_n_pixels (stats, ARV_IMAGE_STATS_CHANNEL_BLUE), ==, 4);
+	g_assert_cmpfloat (arv_image_stats_get_mean (stats, ARV_IMAGE_STATS_CHANNEL_ALL), ==, 1220.0 / 16.0);
+	g_assert_cmpfloat (arv_image_stats_get_mean (stats, ARV_IMAGE_STATS_CHANNEL_GREEN), ==, 20.0);
+	g_assert_cmpint (arv_image_stats_get_percentile (stats, ARV_IMAGE_STATS_CHANNEL_ALL, 0.0), ==, 10);
+	g_assert_cmpint (arv_image_stats_get_percentile (stats, ARV_IMAGE_STATS_CHANNEL_ALL, 0.5), ==, 20);
+	g_assert_cmpint (arv_image_stats_get_percentile (stats, ARV_IMAGE_STATS_CHANNEL_ALL, 1.0), ==, 255);
+	g_assert_cmpint (arv_image_stats_get_n_saturated (stats, ARV_IMAGE_STATS_CHANNEL_ALL), ==, 4);
+	g_assert_cmpint (arv_image_stats_get_n_saturated (stats, ARV_IMAGE_STATS_CHANNEL_BLUE), ==, 4);
+	g_assert_cmpint (arv_image_stats_get_n_saturated (stats, ARV_IMAGE_STATS_CHANNEL_RED), ==, 0);
+	/* Uniform color planes */
+	g_assert_cmpfloat (arv_image_stats_get_sharpness (stats), ==, 0.0);
+
+	g_object_unref (stats);
+
+	/* Mono8 horizontal ramp, analyzed in a region */
+	for (y = 0; y < 4; y++)
+		for (x = 0; x < 4; x++)
+			mono[y * 4 + x] = x * 10;
+
+	arv_image_analyzer_set_region (analyzer, 1, 1, 2, 0);
+	stats = arv_image_analyzer_process (analyzer, ARV_PIXEL_FORMAT_MONO_8, mono, 4, 4, 4, NULL);
+	g_assert (ARV_IS_IMAGE_STATS (stats));
+	g_assert_cmpint (arv_image_stats_get_n_pixels (stats, ARV_IMAGE_STATS_CHANNEL_ALL), ==, 6);
+	g_assert_cmpint (arv_image_stats_get_n_pixels (stats, ARV_IMAGE_STATS_CHANNEL_RED), ==, 0);
+	g_assert_cmpfloat (arv_image_stats_get_mean (stats, ARV_IMAGE_STATS_CHANNEL_ALL), ==, 15.0);
+	g_assert_cmpfloat (arv_image_stats_get_sharpness (stats), ==, 100.0);
+	g_object_unref (stats);
+
+	arv_image_analyzer_set_region (analyzer, 0, 0, 0, 0);
+	arv_image_analyzer_set_subsampling (analyzer, 2);
+	stats = arv_image_analyzer_process (analyzer, ARV_PIXEL_FORMAT_MONO_8, mono, 4, 4, 4, NULL);
+	g_assert_cmpint (arv_image_stats_get_n_pixels (stats, ARV_IMAGE_STATS_CHANNEL_ALL), ==, 4);
+	g_assert_cmpfloat (arv_image_stats_get_mean (stats, ARV_IMAGE_STATS_CHANNEL_ALL), ==, 10.0);
+	g_object_unref (stats);
+	arv_image_analyzer_set_subsampling (analyzer, 1);
+
+	/* More than 12 bits per pixel */
+	stats = arv_image_analyzer_process (analyzer, ARV_PIXEL_FORMAT_MONO_16, mono_16, 4, 2, 1, NULL);
+	g_assert_cmpint (arv_image_stats_get_n_bins (stats), ==, 4096);
+	g_assert_cmpint (arv_image_stats_get_bin_shift (stats), ==, 4);
+	g_assert_cmpint (arv_image_stats_get_max_value (stats), ==, 0xffff);
+	g_assert_cmpint (arv_image_stats_get_n_saturated (stats, ARV_IMAGE_STATS_CHANNEL_ALL), ==, 1);
+	g_assert_cmpint (arv_image_stats_get_percentile (stats, ARV_IMAGE_STATS_CHANNEL_ALL, 1.0), ==, 0xfff0);
+	g_assert_cmpfloat (arv_image_stats_get_mean (stats, ARV_IMAGE_STATS_CHANNEL_ALL), ==, (0xffff + 0x10) / 2.0);
+	g_object_unref (stats);
+
+	g_assert (arv_image_analyzer_process (analyzer, ARV_PIXEL_FORMAT_RGB_8_PACKED, mono, 12, 4, 1, &error) == NULL);
+	g_assert_error (error, ARV_IMAGE_ANALYZER_ERROR, ARV_IMAGE_ANALYZER_ERROR_INVALID_PIXEL_FORMAT);
+	g_clear_error (&error);
+
+	g_assert (arv_image_analyzer_process (analyzer, ARV_PIXEL_FORMAT_MONO_16, mono, 4, 4, 2, &error) == NULL);
+	g_assert_error (error, ARV_IMAGE_ANALYZER_ERROR, ARV_IMAGE_ANALYZER_ERROR_INVALID_GEOMETRY);
+	g_clear_error (&error);
+
+	arv_image_analyzer_set_region (analyzer, 4, 0, 0, 0);
+	g_assert (arv_image_analyzer_process (analyzer, ARV_PIXEL_FORMAT_MONO_8, mono, 4, 4, 4, &error) == NULL);
+	g_assert_error (error, ARV_IMAGE_ANALYZER_ERROR, ARV_IMAGE_ANALYZER_ERROR_INVALID_GEOMETRY);
+	g_clear_error (&error);
+
+	g_object_unref (analyzer);
+}
+
+/* The vector kernels must give the same statistics as the scalar implementation, for any row length and region
+ * offset. The high bits of the 10 to 14 bit pixels are random, they must be ignored. */
+
+static void
+image_stats_kernels (void)
+{
+	const ArvPixelFormat pixel_formats[] = {
+		ARV_PIXEL_FORMAT_MONO_8,
+		ARV_PIXEL_FORMAT_MONO_12,
+		ARV_PIXEL_FORMAT_MONO_16,
+		ARV_PIXEL_FORMAT_BAYER_GR_8,
+		ARV_PIXEL_FORMAT_BAYER_BG_10,
+		ARV_PIXEL_FORMAT_BAYER_RG_16
+	};
+	const ArvSimdIsa isas[] = {
+		ARV_SIMD_ISA_SSSE3,
+		ARV_SIMD_ISA_AVX2,
+		ARV_SIMD_ISA_NEON
+	};
+	const guint max_width = 75;
+	const guint height = 5;
+	ArvImageAnalyzer *analyzer;
+	GRand *rand;
+	guint8 *data;
+	guint i, j, k, c;
+	guint width;
+
+	analyzer = arv_image_analyzer_new ();
+	rand = g_rand_new_with_seed (1234);
+	/* Room for the region offset */
+	data = g_malloc ((max_width + 2) * height * 2);
+
+	for (i = 0; i < G_N_ELEMENTS (pixel_formats); i++) {
+		size_t row_stride = (max_width + 2) * ARV_PIXEL_FORMAT_BIT_PER_PIXEL (pixel_formats[i]) / 8;
+
+		for (width = 1; width <= max_width; width++) {
+			ArvImageStats *reference;
+
+			for (k = 0; k < (max_width + 2) * height * 2; k++)
+				data[k] = g_rand_int_range (rand, 0, 8) == 0 ? 0xff : g_rand_int_range (rand, 0, 256);
+
+			arv_image_analyzer_set_region (analyzer, width % 3, width % 2, 0, 0);
+
+			reference = arv_image_analyzer_process_with_isa (analyzer, ARV_SIMD_ISA_SCALAR, pixel_formats[i],
+									 data, row_stride, width + width % 3,
+									 height, NULL);
+			g_assert (ARV_IS_IMAGE_STATS (reference));
+
+			for (j = 0; j < G_N_ELEMENTS (isas); j++) {
+				ArvImageStats *stats;
+
+				if (!arv_simd_isa_is_supported (isas[j]))
+					continue;
+
+				stats = arv_image_analyzer_process_with_isa (analyzer, isas[j], pixel_formats[i],
+									     data, row_stride, width + width % 3,
+									     height, NULL);
+				g_assert (ARV_IS_IMAGE_STATS (stats));
+
+				for (c = 0; c < ARV_IMAGE_STATS_N_CHANNELS; c++) {
+					g_assert (memcmp (arv_image_stats_get_histogram (stats, c, NULL),
+							  arv_image_stats_get_histogram (reference, c, NULL),
+							  arv_image_stats_get_n_bins (stats) * sizeof (guint32)) == 0);
+					g_assert_cmpint (arv_image_stats_get_n_pixels (stats, c), ==,
+							 arv_image_stats_get_n_pixels (reference, c));
+					g_assert_cmpfloat (arv_image_stats_get_mean (stats, c), ==,
+							   arv_image_stats_get_mean (reference, c));
+					g_assert_cmpint (arv_image_stats_get_n_saturated (stats, c), ==,
+							 arv_image_stats_get_n_saturated (reference, c));
+				}
+				g_assert_cmpfloat (arv_image_stats_get_sharpness (stats), ==,
+						   arv_image_stats_get_sharpness (reference));
+
+				g_object_unref (stats);
+			}
+
+			g_object_unref (reference);
+		}
+	}
+
+	g_free (data);
+	g_rand_free (rand);
+	g_object_unref (analyzer);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -125,6 +1083,22 @@ main (int argc, char *argv[])
 	g_test_add_func ("/buffer/full-buffer", full_buffer_test);
 	g_test_add_func ("/buffer/timestamp", timestamp);
 	g_test_add_func ("/buffer/allocate", allocate);
+	g_test_add_func ("/buffer/unpack-known-values", unpack_known_values);
+	g_test_add_func ("/buffer/unpack-kernels", unpack_kernels);
+	g_test_add_func ("/buffer/unpack-buffer", unpack_buffer);
+	g_test_add_func ("/buffer/padded-buffer", padded_buffer);
+	g_test_add_func ("/buffer/demosaic-uniform", demosaic_uniform);
+	g_test_add_func ("/buffer/demosaic-kernels", demosaic_kernels);
+	g_test_add_func ("/buffer/demosaic-buffer", demosaic_buffer);
+	g_test_add_func ("/buffer/converter-steps", converter_steps);
+	g_test_add_func ("/buffer/converter-unpack", converter_unpack);
+	g_test_add_func ("/buffer/converter-process", converter_process);
+	g_test_add_func ("/buffer/converter-unpack-demosaic", converter_unpack_demosaic);
+	g_test_add_func ("/buffer/converter-yuv", converter_yuv);
+	g_test_add_func ("/buffer/converter-alpha", converter_alpha);
+	g_test_add_func ("/buffer/converter-buffer", converter_buffer);
+	g_test_add_func ("/buffer/image-stats-known-values", image_stats_known_values);
+	g_test_add_func ("/buffer/image-stats-kernels", image_stats_kernels);
 
 	result = g_test_run();
 
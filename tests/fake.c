@@ -1,5 +1,6 @@
 #include <glib.h>
 #include <arv.h>
+#include "fillpattern.h"
 
 static void
 trigger_registers_test (void)
@@ -313,6 +314,129 @@ fake_stream_test (void)
 	g_clear_object (&camera);
 }
 
+static void
+fake_padded_stream_test (void)
+{
+	ArvCamera *camera;
+	ArvDevice *device;
+	ArvFakeCamera *fake_camera;
+	ArvStream *stream;
+	ArvBuffer *buffer;
+	const guint8 *data;
+	size_t size;
+	gint payload;
+	guint x, y;
+
+	camera = arv_camera_new ("Fake_1");
+	g_assert (ARV_IS_CAMERA (camera));
+
+	device = arv_camera_get_device (camera);
+	fake_camera = arv_fake_device_get_fake_camera (ARV_FAKE_DEVICE (device));
+	g_assert (ARV_IS_FAKE_CAMERA (fake_camera));
+
+	arv_camera_set_pixel_format (camera, ARV_PIXEL_FORMAT_MONO_8, NULL);
+	arv_camera_set_region (camera, 0, 0, 301, 16, NULL);
+
+	stream = arv_camera_create_stream (camera, NULL, NULL);
+	g_assert (ARV_IS_STREAM (stream));
+
+	arv_fake_camera_set_fill_pattern (fake_camera, padded_fill_pattern_cb, NULL);
+
+	payload = arv_camera_get_payload (camera, NULL);
+	g_assert_cmpint (payload, ==, 301 * 16);
+
+	arv_stream_push_buffer (stream, arv_buffer_new_padded (payload, 16, 4));
+	arv_camera_set_acquisition_mode (camera, ARV_ACQUISITION_MODE_SINGLE_FRAME, NULL);
+	arv_camera_start_acquisition (camera, NULL);
+	buffer = arv_stream_pop_buffer (stream);
+	arv_camera_stop_acquisition (camera, NULL);
+
+	arv_fake_camera_set_fill_pattern (fake_camera, NULL, NULL);
+
+	g_assert (ARV_IS_BUFFER (buffer));
+	g_assert_cmpint (arv_buffer_get_status (buffer), ==, ARV_BUFFER_STATUS_SUCCESS);
+	g_assert_cmpint (arv_buffer_get_image_row_stride (buffer), ==, 304);
+
+	data = arv_buffer_get_data (buffer, &size);
+	g_assert_cmpint (size, ==, 304 * 16);
+
+	for (y = 0; y < 16; y++)
+		for (x = 0; x < 301; x++)
+			g_assert_cmpint (data[y * 304 + x], ==, (y * 301 + x) % 251);
+
+	g_clear_object (&buffer);
+	g_clear_object (&stream);
+	g_clear_object (&camera);
+}
+
+static void
+fake_stream_image_stats_test (void)
+{
+	ArvCamera *camera;
+	ArvDevice *device;
+	ArvFakeCamera *fake_camera;
+	ArvStream *stream;
+	ArvBuffer *buffer;
+	ArvImageAnalyzer *analyzer;
+	ArvImageStats *stats;
+	const guint8 *data;
+	size_t size;
+	guint64 sum = 0;
+	gint payload;
+	guint x, y;
+
+	camera = arv_camera_new ("Fake_1");
+	g_assert (ARV_IS_CAMERA (camera));
+
+	device = arv_camera_get_device (camera);
+	fake_camera = arv_fake_device_get_fake_camera (ARV_FAKE_DEVICE (device));
+	g_assert (ARV_IS_FAKE_CAMERA (fake_camera));
+
+	arv_camera_set_pixel_format (camera, ARV_PIXEL_FORMAT_MONO_8, NULL);
+	arv_camera_set_region (camera, 0, 0, 301, 16, NULL);
+
+	stream = arv_camera_create_stream (camera, NULL, NULL);
+	g_assert (ARV_IS_STREAM (stream));
+
+	arv_fake_camera_set_fill_pattern (fake_camera, padded_fill_pattern_cb, NULL);
+
+	analyzer = arv_image_analyzer_new ();
+	arv_stream_set_image_analyzer (stream, analyzer);
+	g_object_unref (analyzer);
+
+	payload = arv_camera_get_payload (camera, NULL);
+	g_assert_cmpint (payload, ==, 301 * 16);
+
+	arv_stream_push_buffer (stream, arv_buffer_new_padded (payload, 16, 4));
+	arv_camera_set_acquisition_mode (camera, ARV_ACQUISITION_MODE_SINGLE_FRAME, NULL);
+	arv_camera_start_acquisition (camera, NULL);
+	buffer = arv_stream_pop_buffer (stream);
+	arv_camera_stop_acquisition (camera, NULL);
+
+	arv_fake_camera_set_fill_pattern (fake_camera, NULL, NULL);
+
+	g_assert (ARV_IS_BUFFER (buffer));
+	g_assert_cmpint (arv_buffer_get_status (buffer), ==, ARV_BUFFER_STATUS_SUCCESS);
+
+	data = arv_buffer_get_data (buffer, &size);
+	g_assert_cmpint (size, ==, 304 * 16);
+
+	for (y = 0; y < 16; y++)
+		for (x = 0; x < 301; x++)
+			sum += data[y * 304 + x];
+
+	/* The statistics are attached to the buffer by the stream. The padding bytes must not be analyzed. */
+	stats = arv_buffer_get_image_stats (buffer);
+	g_assert (ARV_IS_IMAGE_STATS (stats));
+	g_assert_cmpint (arv_image_stats_get_n_pixels (stats, ARV_IMAGE_STATS_CHANNEL_ALL), ==, 301 * 16);
+	g_assert_cmpfloat (arv_image_stats_get_mean (stats, ARV_IMAGE_STATS_CHANNEL_ALL), ==, sum / (301.0 * 16.0));
+	g_assert_cmpint (arv_image_stats_get_n_saturated (stats, ARV_IMAGE_STATS_CHANNEL_ALL), ==, 0);
+
+	g_clear_object (&buffer);
+	g_clear_object (&stream);
+	g_clear_object (&camera);
+}
+
 static void
 camera_api_test (void)
 {
@@ -451,6 +575,220 @@ camera_api_test (void)
 	g_object_unref (camera);
 }
 
+static void
+feature_handle_test (void)
+{
+	ArvDevice *device;
+	ArvFeatureHandle *handle;
+	GError *error = NULL;
+	guint64 address;
+	guint64 length;
+	gint64 value;
+	double exposure;
+
+	device = arv_fake_device_new ("TEST0");
+	g_assert (ARV_IS_FAKE_DEVICE (device));
+
+	handle = arv_device_get_feature_handle (device, "Width", &error);
+	g_assert (ARV_IS_FEATURE_HANDLE (handle));
+	g_assert (error == NULL);
+	g_assert_cmpstr (arv_feature_handle_get_name (handle), ==, "Width");
+
+	g_assert (arv_feature_handle_get_register_location (handle, &address, &length));
+	g_assert_cmpint (address, ==, ARV_FAKE_CAMERA_REGISTER_WIDTH);
+	g_assert_cmpint (length, ==, 4);
+
+	arv_feature_handle_set_int64 (handle, 128, &error);
+	g_assert (error == NULL);
+	value = arv_feature_handle_get_int64 (handle, &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (value, ==, 128);
+	g_assert_cmpint (arv_device_get_integer_feature_value (device, "Width", NULL), ==, 128);
+
+	/* The register is read directly when the register cache is disabled, and through the node chain otherwise */
+	arv_device_set_register_cache_policy (device, ARV_REGISTER_CACHE_POLICY_ENABLE);
+	arv_feature_handle_set_int64 (handle, 128, &error);
+	g_assert (error == NULL);
+	arv_device_write_register (device, ARV_FAKE_CAMERA_REGISTER_WIDTH, 256, &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (arv_feature_handle_get_int64 (handle, NULL), ==, 128);
+	arv_device_set_register_cache_policy (device, ARV_REGISTER_CACHE_POLICY_DISABLE);
+	g_assert_cmpint (arv_feature_handle_get_int64 (handle, NULL), ==, 256);
+
+	arv_feature_handle_get_double (handle, &error);
+	g_assert_error (error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_WRONG_FEATURE);
+	g_clear_error (&error);
+
+	g_object_unref (handle);
+
+	handle = arv_device_get_feature_handle (device, "ExposureTimeAbs", &error);
+	g_assert (ARV_IS_FEATURE_HANDLE (handle));
+	g_assert (error == NULL);
+
+	/* Value computed by a converter */
+	g_assert (!arv_feature_handle_get_register_location (handle, NULL, NULL));
+
+	arv_feature_handle_set_double (handle, 2000.0, &error);
+	g_assert (error == NULL);
+	exposure = arv_feature_handle_get_double (handle, &error);
+	g_assert (error == NULL);
+	g_assert_cmpfloat (exposure, ==, 2000.0);
+
+	g_object_unref (handle);
+
+	handle = arv_device_get_feature_handle (device, "Unknown", &error);
+	g_assert (handle == NULL);
+	g_assert_error (error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_FEATURE_NOT_FOUND);
+	g_clear_error (&error);
+
+	g_object_unref (device);
+}
+
+#define CONCURRENT_ACCESS_N_THREADS		4
+#define CONCURRENT_ACCESS_N_ITERATIONS		1000
+
+typedef struct {
+	ArvDevice *device;
+	gboolean is_writer;
+} ConcurrentAccessData;
+
+static gpointer
+concurrent_access_thread (gpointer user_data)
+{
+	ConcurrentAccessData *data = user_data;
+	ArvGc *genicam;
+	ArvBuffer *buffer;
+	GError *error = NULL;
+	gint64 value;
+	double exposure;
+	int i;
+
+	genicam = arv_device_get_genicam (data->device);
+
+	/* Chunk data buffers are bound per thread */
+	buffer = arv_buffer_new (16, NULL);
+	arv_gc_set_buffer (genicam, buffer);
+
+	for (i = 0; i < CONCURRENT_ACCESS_N_ITERATIONS; i++) {
+		if (data->is_writer) {
+			arv_device_set_integer_feature_value (data->device, "Width", (i % 2) == 0 ? 256 : 512, &error);
+			g_assert (error == NULL);
+			arv_device_set_float_feature_value (data->device, "ExposureTimeAbs", (i % 2) == 0 ? 100.0 : 200.0,
+							    &error);
+			g_assert (error == NULL);
+		} else {
+			value = arv_device_get_integer_feature_value (data->device, "Width", &error);
+			g_assert (error == NULL);
+			g_assert (value == 256 || value == 512);
+
+			exposure = arv_device_get_float_feature_value (data->device, "ExposureTimeAbs", &error);
+			g_assert (error == NULL);
+			g_assert (exposure == 100.0 || exposure == 200.0);
+
+			arv_device_get_integer_feature_value (data->device, "Height", &error);
+			g_assert (error == NULL);
+		}
+
+		g_assert (arv_gc_get_buffer (genicam) == buffer);
+	}
+
+	g_object_unref (buffer);
+
+	return NULL;
+}
+
+static void
+concurrent_access_test (void)
+{
+	ConcurrentAccessData data[CONCURRENT_ACCESS_N_THREADS];
+	GThread *threads[CONCURRENT_ACCESS_N_THREADS];
+	ArvDevice *device;
+	GError *error = NULL;
+	int i;
+
+	device = arv_fake_device_new ("TEST0");
+	g_assert (ARV_IS_FAKE_DEVICE (device));
+
+	arv_device_set_register_cache_policy (device, ARV_REGISTER_CACHE_POLICY_ENABLE);
+
+	arv_device_set_integer_feature_value (device, "Width", 256, &error);
+	g_assert (error == NULL);
+	arv_device_set_float_feature_value (device, "ExposureTimeAbs", 100.0, &error);
+	g_assert (error == NULL);
+
+	for (i = 0; i < CONCURRENT_ACCESS_N_THREADS; i++) {
+		data[i].device = device;
+		data[i].is_writer = i == 0;
+		threads[i] = g_thread_new ("concurrent-access", concurrent_access_thread, &data[i]);
+	}
+
+	for (i = 0; i < CONCURRENT_ACCESS_N_THREADS; i++)
+		g_thread_join (threads[i]);
+
+	g_object_unref (device);
+}
+
+#define CAMERA_GROUP_N_CAMERAS	8
+
+static void
+camera_group_test (void)
+{
+	ArvCameraGroup *group;
+	const char *device_ids[CAMERA_GROUP_N_CAMERAS + 2];
+	const char *features[] = {"Width", "Height", "GainRaw"};
+	const char *values[] = {"512", "256", "2"};
+	const char *bad_features[] = {"Width", "Foo"};
+	const char *bad_values[] = {"128", "1"};
+	GError *error = NULL;
+	gboolean success;
+	unsigned int i;
+
+	for (i = 0; i < CAMERA_GROUP_N_CAMERAS; i++)
+		device_ids[i] = "Fake_1";
+	device_ids[CAMERA_GROUP_N_CAMERAS] = "Unknown-Device";
+	device_ids[CAMERA_GROUP_N_CAMERAS + 1] = NULL;
+
+	group = arv_camera_group_new (device_ids, 4);
+	g_assert (ARV_IS_CAMERA_GROUP (group));
+	g_assert_cmpint (arv_camera_group_get_n_cameras (group), ==, CAMERA_GROUP_N_CAMERAS + 1);
+	g_assert_cmpint (arv_camera_group_get_n_opened_cameras (group), ==, CAMERA_GROUP_N_CAMERAS);
+
+	for (i = 0; i < CAMERA_GROUP_N_CAMERAS; i++) {
+		g_assert (ARV_IS_CAMERA (arv_camera_group_get_camera (group, i)));
+		g_assert (arv_camera_group_get_error (group, i) == NULL);
+	}
+	g_assert (arv_camera_group_get_camera (group, CAMERA_GROUP_N_CAMERAS) == NULL);
+	g_assert (arv_camera_group_get_error (group, CAMERA_GROUP_N_CAMERAS) != NULL);
+	g_assert_cmpstr (arv_camera_group_get_device_id (group, CAMERA_GROUP_N_CAMERAS), ==, "Unknown-Device");
+
+	success = arv_camera_group_set_features (group, features, values, G_N_ELEMENTS (features), &error);
+	g_assert (success);
+	g_assert (error == NULL);
+
+	for (i = 0; i < CAMERA_GROUP_N_CAMERAS; i++) {
+		ArvDevice *device = arv_camera_get_device (arv_camera_group_get_camera (group, i));
+
+		g_assert_cmpint (arv_device_get_integer_feature_value (device, "Width", NULL), ==, 512);
+		g_assert_cmpint (arv_device_get_integer_feature_value (device, "Height", NULL), ==, 256);
+		g_assert (arv_camera_group_get_error (group, i) == NULL);
+	}
+
+	/* The configuration of each camera stops at the first failing feature */
+	success = arv_camera_group_set_features (group, bad_features, bad_values, G_N_ELEMENTS (bad_features), &error);
+	g_assert (!success);
+	g_assert_error (error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_FEATURE_NOT_FOUND);
+	g_clear_error (&error);
+
+	for (i = 0; i < CAMERA_GROUP_N_CAMERAS; i++) {
+		ArvDevice *device = arv_camera_get_device (arv_camera_group_get_camera (group, i));
+
+		g_assert_cmpint (arv_device_get_integer_feature_value (device, "Width", NULL), ==, 128);
+		g_assert_error (arv_camera_group_get_error (group, i), ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_FEATURE_NOT_FOUND);
+	}
+
+	g_object_unref (group);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -469,7 +807,12 @@ main (int argc, char *argv[])
 	g_test_add_func ("/fake/fake-device", fake_device_test);
 	g_test_add_func ("/fake/fake-device-error", fake_device_error_test);
 	g_test_add_func ("/fake/fake-stream", fake_stream_test);
+	g_test_add_func ("/fake/fake-padded-stream", fake_padded_stream_test);
+	g_test_add_func ("/fake/fake-stream-image-stats", fake_stream_image_stats_test);
 	g_test_add_func ("/fake/camera-api", camera_api_test);
+	g_test_add_func ("/fake/feature-handle", feature_handle_test);
+	g_test_add_func ("/fake/concurrent-access", concurrent_access_test);
+	g_test_add_func ("/fake/camera-group", camera_group_test);
 
 	result = g_test_run();
 
@@ -1,7 +1,13 @@
+#define ARAVIS_COMPILATION
+
 #include <glib.h>
 #include <arv.h>
+#include "../src/arvgvdeviceprivate.h"
+#include "fillpattern.h"
+#include <stdlib.h>
 
 static ArvCamera *camera = NULL;
+static ArvGvFakeCamera *simulator = NULL;
 
 static void
 register_test (void)
@@ -214,10 +220,815 @@ dynamic_roi_test (void)
 	g_clear_object (&stream);
 }
 
+static void
+open_phase_test (void)
+{
+	ArvGvDevice *gv_device;
+
+	gv_device = ARV_GV_DEVICE (arv_camera_get_device (camera));
+
+	g_assert_cmpint (arv_gv_device_get_open_phase_duration (gv_device, ARV_GV_DEVICE_OPEN_PHASE_LOCATE), >, 0);
+	g_assert_cmpint (arv_gv_device_get_open_phase_duration (gv_device, ARV_GV_DEVICE_OPEN_PHASE_XML_LOAD), >, 0);
+	g_assert_cmpint (arv_gv_device_get_open_phase_duration (gv_device, ARV_GV_DEVICE_OPEN_PHASE_TAKE_CONTROL), >, 0);
+}
+
+static void
+device_list_test (void)
+{
+	const char *device_ids[] = {"Aravis-GV01", NULL};
+	gint64 start_time;
+	gboolean success;
+
+	/* Discovery returns as soon as the expected device has answered, well before the timeout, even on a loaded
+	 * test machine */
+	start_time = g_get_monotonic_time ();
+	success = arv_update_device_list_full (0, device_ids, 20000);
+	g_assert (success);
+	g_assert_cmpint (g_get_monotonic_time () - start_time, <, 10000000);
+	g_assert_cmpint (arv_get_n_devices (), >=, 1);
+
+	/* Cached device list, which does not wait for the 1 s GigEVision discovery timeout */
+	arv_set_device_list_ttl (60000);
+	arv_update_device_list ();
+	g_assert_cmpint (arv_get_n_devices (), >=, 1);
+
+	start_time = g_get_monotonic_time ();
+	arv_update_device_list ();
+	g_assert_cmpint (g_get_monotonic_time () - start_time, <, 500000);
+	g_assert_cmpint (arv_get_n_devices (), >=, 1);
+
+	arv_set_device_list_ttl (0);
+}
+
+#define CAMERA_GROUP_N_CAMERAS	6
+
+static void
+camera_group_test (void)
+{
+	ArvCameraGroup *group;
+	const char *device_ids[CAMERA_GROUP_N_CAMERAS + 1];
+	guint n_genicam_downloads;
+	unsigned int i;
+
+	/* Only one fake GV camera can listen on the loopback interface, open it several times, using both its
+	 * name and its address. Only the first opened device is controller, the other ones are read only. */
+	for (i = 0; i < CAMERA_GROUP_N_CAMERAS; i++)
+		device_ids[i] = i % 2 == 0 ? "Aravis-GV01" : "127.0.0.1";
+	device_ids[CAMERA_GROUP_N_CAMERAS] = NULL;
+
+	n_genicam_downloads = arv_gv_device_get_n_genicam_downloads ();
+
+	group = arv_camera_group_new (device_ids, 0);
+	g_assert (ARV_IS_CAMERA_GROUP (group));
+	g_assert_cmpint (arv_camera_group_get_n_opened_cameras (group), ==, CAMERA_GROUP_N_CAMERAS);
+
+	/* All the cameras share a single download of the Genicam data */
+	g_assert_cmpint (arv_gv_device_get_n_genicam_downloads () - n_genicam_downloads, ==, 1);
+
+	for (i = 0; i < CAMERA_GROUP_N_CAMERAS; i++) {
+		ArvCamera *group_camera = arv_camera_group_get_camera (group, i);
+
+		g_assert (ARV_IS_CAMERA (group_camera));
+		g_assert (arv_camera_group_get_error (group, i) == NULL);
+		g_assert_cmpint (arv_camera_group_get_open_duration (group, i), >, 0);
+		g_assert_cmpstr (arv_camera_get_model_name (group_camera, NULL), ==,
+				 arv_camera_get_model_name (camera, NULL));
+	}
+
+	g_object_unref (group);
+
+	/* The open error is kept for each camera */
+	device_ids[0] = "Aravis-GV01";
+	device_ids[1] = "Aravis-Missing";
+	device_ids[2] = NULL;
+
+	group = arv_camera_group_new (device_ids, 0);
+	g_assert (ARV_IS_CAMERA_GROUP (group));
+	g_assert_cmpint (arv_camera_group_get_n_opened_cameras (group), ==, 1);
+	g_assert (arv_camera_group_get_error (group, 0) == NULL);
+	g_assert (arv_camera_group_get_camera (group, 1) == NULL);
+	g_assert_error (arv_camera_group_get_error (group, 1), ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_NOT_FOUND);
+
+	g_object_unref (group);
+}
+
+#define ACTION_N_CAMERAS	3
+#define ACTION_DEVICE_KEY	0x12345678
+#define ACTION_GROUP_KEY	0x1
+#define ACTION_GROUP_MASK	0x1
+
+static gint64
+_get_action_skew (ArvStream **streams, guint64 *first_timestamp)
+{
+	guint64 min_timestamp = G_MAXUINT64;
+	guint64 max_timestamp = 0;
+	unsigned int i;
+
+	for (i = 0; i < ACTION_N_CAMERAS; i++) {
+		ArvBuffer *buffer;
+		guint64 timestamp;
+
+		buffer = arv_stream_timeout_pop_buffer (streams[i], 2000000);
+		g_assert (ARV_IS_BUFFER (buffer));
+		g_assert_cmpint (arv_buffer_get_status (buffer), ==, ARV_BUFFER_STATUS_SUCCESS);
+
+		timestamp = arv_buffer_get_timestamp (buffer);
+		min_timestamp = MIN (min_timestamp, timestamp);
+		max_timestamp = MAX (max_timestamp, timestamp);
+
+		arv_stream_push_buffer (streams[i], buffer);
+	}
+
+	if (first_timestamp != NULL)
+		*first_timestamp = min_timestamp;
+
+	return max_timestamp - min_timestamp;
+}
+
+static void
+action_command_test (void)
+{
+	ArvGvFakeCamera *simulators[ACTION_N_CAMERAS];
+	ArvCamera *cameras[ACTION_N_CAMERAS];
+	ArvStream *streams[ACTION_N_CAMERAS];
+	char *addresses[ACTION_N_CAMERAS + 1];
+	GError *error = NULL;
+	guint64 action_time;
+	guint64 first_timestamp;
+	guint n_acknowledges;
+	gint64 skew;
+	gboolean success;
+	unsigned int i, j;
+
+	/* Several simulators listening on distinct loopback addresses */
+	for (i = 0; i < ACTION_N_CAMERAS; i++) {
+		char *serial_number = g_strdup_printf ("GVA%d", i);
+
+		addresses[i] = g_strdup_printf ("127.0.0.%d", i + 2);
+		simulators[i] = arv_gv_fake_camera_new (addresses[i], serial_number);
+		g_assert (arv_gv_fake_camera_is_running (simulators[i]));
+
+		g_free (serial_number);
+	}
+	addresses[ACTION_N_CAMERAS] = NULL;
+
+	for (i = 0; i < ACTION_N_CAMERAS; i++) {
+		size_t payload;
+
+		cameras[i] = arv_camera_new (addresses[i]);
+		g_assert (ARV_IS_CAMERA (cameras[i]));
+
+		arv_camera_set_string (cameras[i], "TriggerSelector", "FrameStart", &error);
+		g_assert (error == NULL);
+		arv_camera_set_string (cameras[i], "TriggerMode", "On", &error);
+		g_assert (error == NULL);
+		arv_camera_set_string (cameras[i], "TriggerSource", "Action1", &error);
+		g_assert (error == NULL);
+		arv_camera_set_integer (cameras[i], "ActionDeviceKey", ACTION_DEVICE_KEY, &error);
+		g_assert (error == NULL);
+		arv_camera_set_integer (cameras[i], "ActionSelector", 0, &error);
+		g_assert (error == NULL);
+		arv_camera_set_integer (cameras[i], "ActionGroupKey", ACTION_GROUP_KEY, &error);
+		g_assert (error == NULL);
+		arv_camera_set_integer (cameras[i], "ActionGroupMask", ACTION_GROUP_MASK, &error);
+		g_assert (error == NULL);
+
+		streams[i] = arv_camera_create_stream (cameras[i], NULL, NULL);
+		g_assert (ARV_IS_STREAM (streams[i]));
+
+		payload = arv_camera_get_payload (cameras[i], NULL);
+		for (j = 0; j < 2; j++)
+			arv_stream_push_buffer (streams[i], arv_buffer_new (payload, NULL));
+
+		arv_camera_start_acquisition (cameras[i], &error);
+		g_assert (error == NULL);
+	}
+
+	/* Let the simulators notice the acquisition start */
+	g_usleep (300000);
+
+	/* Unmatched group key, no device answers */
+	success = arv_gv_interface_issue_action_command (ACTION_DEVICE_KEY, ACTION_GROUP_KEY + 1, ACTION_GROUP_MASK, 0,
+							 (const char **) addresses, ACTION_N_CAMERAS, 200,
+							 &n_acknowledges, &error);
+	g_assert (!success);
+	g_assert_error (error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_TIMEOUT);
+	g_assert_cmpint (n_acknowledges, ==, 0);
+	g_clear_error (&error);
+
+	/* Immediate action */
+	success = arv_gv_interface_issue_action_command (ACTION_DEVICE_KEY, ACTION_GROUP_KEY, ACTION_GROUP_MASK, 0,
+							 (const char **) addresses, ACTION_N_CAMERAS, 1000,
+							 &n_acknowledges, &error);
+	g_assert (success);
+	g_assert (error == NULL);
+	g_assert_cmpint (n_acknowledges, ==, ACTION_N_CAMERAS);
+
+	skew = _get_action_skew (streams, NULL);
+	g_test_message ("Immediate action skew: %" G_GINT64_FORMAT " ns", skew);
+	g_assert_cmpint (skew, <, 50000000);
+
+	/* Scheduled action, fake camera timestamps are in ns since epoch */
+	action_time = (g_get_real_time () + 200000) * 1000;
+	success = arv_gv_interface_issue_action_command (ACTION_DEVICE_KEY, ACTION_GROUP_KEY, ACTION_GROUP_MASK,
+							 action_time, (const char **) addresses, ACTION_N_CAMERAS, 1000,
+							 &n_acknowledges, &error);
+	g_assert (success);
+	g_assert (error == NULL);
+	g_assert_cmpint (n_acknowledges, ==, ACTION_N_CAMERAS);
+
+	skew = _get_action_skew (streams, &first_timestamp);
+	g_test_message ("Scheduled action skew: %" G_GINT64_FORMAT " ns", skew);
+	g_assert_cmpint (first_timestamp, >=, action_time);
+	g_assert_cmpint (skew, <, 5000000);
+
+	/* Late action, executed immediately and reported as late */
+	action_time = (g_get_real_time () - 1000000) * 1000;
+	success = arv_gv_interface_issue_action_command (ACTION_DEVICE_KEY, ACTION_GROUP_KEY, ACTION_GROUP_MASK,
+							 action_time, (const char **) addresses, ACTION_N_CAMERAS, 1000,
+							 &n_acknowledges, &error);
+	g_assert (!success);
+	g_assert_error (error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_PROTOCOL_ERROR);
+	g_clear_error (&error);
+
+	_get_action_skew (streams, NULL);
+
+	for (i = 0; i < ACTION_N_CAMERAS; i++) {
+		arv_camera_stop_acquisition (cameras[i], NULL);
+		g_object_unref (streams[i]);
+		g_object_unref (cameras[i]);
+		g_object_unref (simulators[i]);
+		g_free (addresses[i]);
+	}
+}
+
+#define FRAME_SYNC_N_CAMERAS	2
+#define FRAME_SYNC_TOLERANCE	10000000
+
+static void
+_issue_frame_sync_action (char **addresses, guint n_addresses)
+{
+	GError *error = NULL;
+	guint n_acknowledges;
+	gboolean success;
+
+	/* Scheduled action, for a tight timestamp skew */
+	success = arv_gv_interface_issue_action_command (ACTION_DEVICE_KEY, ACTION_GROUP_KEY, ACTION_GROUP_MASK,
+							 (g_get_real_time () + 100000) * 1000,
+							 (const char **) addresses, n_addresses, 1000,
+							 &n_acknowledges, &error);
+	g_assert (success);
+	g_assert (error == NULL);
+	g_assert_cmpint (n_acknowledges, ==, n_addresses);
+}
+
+static void
+frame_sync_test (void)
+{
+	ArvGvFakeCamera *simulators[FRAME_SYNC_N_CAMERAS];
+	ArvCamera *cameras[FRAME_SYNC_N_CAMERAS];
+	ArvStream *streams[FRAME_SYNC_N_CAMERAS];
+	char *addresses[FRAME_SYNC_N_CAMERAS];
+	ArvFrameSync *sync;
+	ArvFrameSet *frame_set;
+	GError *error = NULL;
+	guint64 n_complete_frame_sets;
+	guint64 n_incomplete_frame_sets;
+	guint64 n_dropped_buffers;
+	unsigned int i, j;
+
+	for (i = 0; i < FRAME_SYNC_N_CAMERAS; i++) {
+		char *serial_number = g_strdup_printf ("GVS%d", i);
+		size_t payload;
+
+		addresses[i] = g_strdup_printf ("127.0.0.%d", i + 20);
+		simulators[i] = arv_gv_fake_camera_new (addresses[i], serial_number);
+		g_assert (arv_gv_fake_camera_is_running (simulators[i]));
+		g_free (serial_number);
+
+		cameras[i] = arv_camera_new (addresses[i]);
+		g_assert (ARV_IS_CAMERA (cameras[i]));
+
+		arv_camera_set_string (cameras[i], "TriggerSelector", "FrameStart", &error);
+		g_assert (error == NULL);
+		arv_camera_set_string (cameras[i], "TriggerMode", "On", &error);
+		g_assert (error == NULL);
+		arv_camera_set_string (cameras[i], "TriggerSource", "Action1", &error);
+		g_assert (error == NULL);
+		arv_camera_set_integer (cameras[i], "ActionDeviceKey", ACTION_DEVICE_KEY, &error);
+		g_assert (error == NULL);
+		arv_camera_set_integer (cameras[i], "ActionSelector", 0, &error);
+		g_assert (error == NULL);
+		arv_camera_set_integer (cameras[i], "ActionGroupKey", ACTION_GROUP_KEY, &error);
+		g_assert (error == NULL);
+		arv_camera_set_integer (cameras[i], "ActionGroupMask", ACTION_GROUP_MASK, &error);
+		g_assert (error == NULL);
+
+		streams[i] = arv_camera_create_stream (cameras[i], NULL, NULL);
+		g_assert (ARV_IS_STREAM (streams[i]));
+
+		payload = arv_camera_get_payload (cameras[i], NULL);
+		for (j = 0; j < 4; j++)
+			arv_stream_push_buffer (streams[i], arv_buffer_new (payload, NULL));
+	}
+
+	sync = arv_frame_sync_new (streams, FRAME_SYNC_N_CAMERAS, ARV_FRAME_SYNC_MODE_TIMESTAMP);
+	g_assert (ARV_IS_FRAME_SYNC (sync));
+
+	/* Simulator timestamps are already in the host time base */
+	arv_frame_sync_set_clock_offset_estimation (sync, FALSE);
+	arv_frame_sync_set_tolerance (sync, FRAME_SYNC_TOLERANCE);
+
+	for (i = 0; i < FRAME_SYNC_N_CAMERAS; i++) {
+		arv_camera_start_acquisition (cameras[i], &error);
+		g_assert (error == NULL);
+	}
+
+	/* Let the simulators notice the acquisition start */
+	g_usleep (300000);
+
+	g_assert (arv_frame_sync_try_pop_frame_set (sync) == NULL);
+
+	for (i = 0; i < 3; i++) {
+		guint64 min_timestamp = G_MAXUINT64;
+		guint64 max_timestamp = 0;
+
+		_issue_frame_sync_action (addresses, FRAME_SYNC_N_CAMERAS);
+
+		frame_set = arv_frame_sync_timeout_pop_frame_set (sync, 2000000);
+		g_assert (ARV_IS_FRAME_SET (frame_set));
+		g_assert (arv_frame_set_is_complete (frame_set));
+		g_assert_cmpint (arv_frame_set_get_n_buffers (frame_set), ==, FRAME_SYNC_N_CAMERAS);
+
+		for (j = 0; j < FRAME_SYNC_N_CAMERAS; j++) {
+			guint64 timestamp = arv_buffer_get_timestamp (arv_frame_set_get_buffer (frame_set, j));
+
+			min_timestamp = MIN (min_timestamp, timestamp);
+			max_timestamp = MAX (max_timestamp, timestamp);
+		}
+
+		g_assert_cmpint (max_timestamp - min_timestamp, <=, FRAME_SYNC_TOLERANCE);
+		g_assert_cmpint (arv_frame_set_get_timestamp (frame_set), ==, min_timestamp);
+
+		arv_frame_sync_push_frame_set (sync, frame_set);
+	}
+
+	/* A frame from the first camera only is dropped once the next complete set is received */
+	_issue_frame_sync_action (addresses, 1);
+	g_usleep (300000);
+	g_assert (arv_frame_sync_try_pop_frame_set (sync) == NULL);
+
+	_issue_frame_sync_action (addresses, FRAME_SYNC_N_CAMERAS);
+	frame_set = arv_frame_sync_timeout_pop_frame_set (sync, 2000000);
+	g_assert (ARV_IS_FRAME_SET (frame_set));
+	g_assert (arv_frame_set_is_complete (frame_set));
+	arv_frame_sync_push_frame_set (sync, frame_set);
+
+	arv_frame_sync_get_statistics (sync, &n_complete_frame_sets, &n_incomplete_frame_sets, &n_dropped_buffers);
+	g_assert_cmpint (n_complete_frame_sets, ==, 4);
+	g_assert_cmpint (n_incomplete_frame_sets, ==, 0);
+	g_assert_cmpint (n_dropped_buffers, ==, 1);
+
+	g_object_unref (sync);
+
+	for (i = 0; i < FRAME_SYNC_N_CAMERAS; i++) {
+		arv_camera_stop_acquisition (cameras[i], NULL);
+		g_object_unref (streams[i]);
+		g_object_unref (cameras[i]);
+		g_object_unref (simulators[i]);
+		g_free (addresses[i]);
+	}
+}
+
+static void
+clock_model_test (void)
+{
+	ArvDevice *device;
+	ArvClockModel *model;
+	ArvStream *stream;
+	ArvBuffer *buffer;
+	GError *error = NULL;
+	guint64 host_timestamp;
+	gint64 latency;
+	unsigned int i;
+
+	device = arv_camera_get_device (camera);
+	model = arv_device_get_clock_model (device);
+	g_assert (ARV_IS_CLOCK_MODEL (model));
+
+	arv_clock_model_reset (model);
+
+	for (i = 0; i < 5; i++) {
+		g_assert (arv_device_sample_clock (device, &error));
+		g_assert (error == NULL);
+		g_usleep (20000);
+	}
+
+	g_assert_cmpint (arv_clock_model_get_n_samples (model), ==, 5);
+
+	/* Simulator timestamps are in the host time base */
+	g_assert_cmpint (llabs (arv_clock_model_get_offset (model)), <, 5000000);
+
+	/* The Genicam features give the same latch */
+	arv_device_execute_command (device, "GevTimestampControlLatch", &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (llabs (arv_device_get_integer_feature_value (device, "GevTimestampValue", &error) -
+				g_get_real_time () * 1000LL), <, 100000000);
+	g_assert (error == NULL);
+
+	stream = arv_camera_create_stream (camera, NULL, NULL);
+	g_assert (ARV_IS_STREAM (stream));
+	arv_stream_push_buffer (stream, arv_buffer_new (arv_camera_get_payload (camera, NULL), NULL));
+
+	arv_camera_set_acquisition_mode (camera, ARV_ACQUISITION_MODE_SINGLE_FRAME, NULL);
+	arv_camera_start_acquisition (camera, NULL);
+
+	buffer = arv_stream_timeout_pop_buffer (stream, 2000000);
+	g_assert (ARV_IS_BUFFER (buffer));
+
+	arv_camera_stop_acquisition (camera, NULL);
+
+	/* Converted on buffer completion, with the same model */
+	host_timestamp = arv_clock_model_get_host_timestamp (model, arv_buffer_get_timestamp (buffer));
+	g_assert_cmpint (arv_buffer_get_host_timestamp (buffer), ==, host_timestamp);
+	latency = arv_buffer_get_system_timestamp (buffer) - host_timestamp;
+	g_test_message ("Frame transfer latency: %" G_GINT64_FORMAT " ns", latency);
+	g_assert_cmpint (llabs (latency), <, 1000000000);
+
+	g_object_unref (buffer);
+	g_object_unref (stream);
+
+	arv_camera_set_acquisition_mode (camera, ARV_ACQUISITION_MODE_CONTINUOUS, NULL);
+
+	/* Heartbeat sampling, the first sample being taken at the next heartbeat */
+	arv_gv_device_set_clock_sampling (ARV_GV_DEVICE (device), TRUE);
+	g_usleep (2500000);
+	arv_gv_device_set_clock_sampling (ARV_GV_DEVICE (device), FALSE);
+
+	g_assert_cmpint (arv_clock_model_get_n_samples (model), >, 5);
+}
+
+/* A single packet size probe fires up to 3 test packets if the answer is late */
+#define PROBE_MAX_N_TEST_PACKETS	3
+
+static guint
+_get_n_test_packets (void)
+{
+	guint n_test_packets;
+
+	g_object_get (simulator, "n-test-packets", &n_test_packets, NULL);
+
+	return n_test_packets;
+}
+
+static void
+auto_packet_size_test (void)
+{
+	ArvDevice *device;
+	GError *error = NULL;
+	guint packet_size;
+	guint initial_packet_size;
+	guint n_test_packets;
+	gint64 start_time;
+	gint64 first_duration;
+	gint64 second_duration;
+
+	device = arv_camera_get_device (camera);
+
+	initial_packet_size = arv_camera_gv_get_packet_size (camera, &error);
+	g_assert (error == NULL);
+
+	/* No test packet gets through, the default size is used but not cached */
+	g_object_set (simulator, "test-packet-max-size", 1, NULL);
+	packet_size = arv_camera_gv_auto_packet_size (camera, &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (packet_size, ==, 1500);
+
+	/* Loopback MTU is larger than the simulator maximum packet size */
+	g_object_set (simulator, "test-packet-max-size", 0, NULL);
+	n_test_packets = _get_n_test_packets ();
+	start_time = g_get_monotonic_time ();
+	packet_size = arv_camera_gv_auto_packet_size (camera, &error);
+	first_duration = g_get_monotonic_time () - start_time;
+	g_assert (error == NULL);
+	g_assert_cmpint (packet_size, ==, 9000);
+	g_assert_cmpint (arv_device_get_integer_feature_value (device, "GevSCPSPacketSize", NULL), ==, 9000);
+	g_assert_cmpint (_get_n_test_packets () - n_test_packets, <=, PROBE_MAX_N_TEST_PACKETS);
+
+	arv_camera_gv_set_packet_size (camera, initial_packet_size, &error);
+	g_assert (error == NULL);
+
+	/* Cached result, confirmed by a single probe */
+	n_test_packets = _get_n_test_packets ();
+	start_time = g_get_monotonic_time ();
+	packet_size = arv_camera_gv_auto_packet_size (camera, &error);
+	second_duration = g_get_monotonic_time () - start_time;
+	g_assert (error == NULL);
+	g_assert_cmpint (packet_size, ==, 9000);
+	g_assert_cmpint (_get_n_test_packets () - n_test_packets, <=, PROBE_MAX_N_TEST_PACKETS);
+
+	g_test_message ("Auto packet size: %" G_GINT64_FORMAT " µs, cached: %" G_GINT64_FORMAT " µs",
+			first_duration, second_duration);
+
+	/* Smaller path MTU, the stale cached size fails and the search starts below it */
+	g_object_set (simulator, "test-packet-max-size", 4000, NULL);
+	packet_size = arv_camera_gv_auto_packet_size (camera, &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (packet_size, <=, 4000);
+	g_assert_cmpint (packet_size, >, 4000 - 32);
+
+	n_test_packets = _get_n_test_packets ();
+	g_assert_cmpint (arv_camera_gv_auto_packet_size (camera, &error), ==, packet_size);
+	g_assert (error == NULL);
+	g_assert_cmpint (_get_n_test_packets () - n_test_packets, <=, PROBE_MAX_N_TEST_PACKETS);
+
+	/* Drop the cached size */
+	g_object_set (simulator, "test-packet-max-size", 1, NULL);
+	arv_camera_gv_auto_packet_size (camera, NULL);
+	g_object_set (simulator, "test-packet-max-size", 0, NULL);
+
+	arv_camera_gv_set_packet_size (camera, initial_packet_size, &error);
+	g_assert (error == NULL);
+}
+
+static void
+bandwidth_planner_test (void)
+{
+	ArvGvBandwidthPlanner *planner;
+	GError *error = NULL;
+	gboolean success;
+	guint payload;
+	double frame_rate;
+	gint64 duration;
+
+	payload = arv_camera_get_payload (camera, &error);
+	g_assert (error == NULL);
+	frame_rate = arv_camera_get_frame_rate (camera, &error);
+	g_assert (error == NULL);
+
+	/* The same simulator stands for two cameras on a 1 GigE link */
+	planner = arv_gv_bandwidth_planner_new (1000000000);
+	g_assert (ARV_IS_GV_BANDWIDTH_PLANNER (planner));
+	g_assert_cmpfloat (arv_gv_bandwidth_planner_get_link_budget (planner), ==, 0.9);
+
+	success = arv_gv_bandwidth_planner_add_camera (planner, camera, &error);
+	g_assert (success);
+	g_assert (error == NULL);
+	arv_gv_bandwidth_planner_add_camera_full (planner, camera, payload, frame_rate, 1500, 0);
+	g_assert_cmpint (arv_gv_bandwidth_planner_get_n_cameras (planner), ==, 2);
+
+	success = arv_gv_bandwidth_planner_apply (planner, &error);
+	g_assert (success);
+	g_assert (error == NULL);
+
+	g_assert_cmpfloat (arv_gv_bandwidth_planner_get_utilization (planner, 0), >,
+			   8.0 * payload * frame_rate / 1e9);
+	g_assert_cmpfloat (arv_gv_bandwidth_planner_get_total_utilization (planner), <, 0.9);
+	g_assert_cmpfloat (arv_gv_bandwidth_planner_get_total_peak_utilization (planner), <=, 0.9 + 1e-9);
+	g_assert_cmpint (arv_gv_bandwidth_planner_get_packet_delay (planner, 1), >, 0);
+	g_assert_cmpint (arv_gv_bandwidth_planner_get_frame_transmission_delay (planner, 1), ==, 0);
+	g_assert_cmpint (arv_gv_bandwidth_planner_get_frame_transmission_duration (planner, 1), <=,
+			 1e9 / frame_rate);
+
+	/* Last applied camera settings win */
+	g_assert_cmpint (arv_camera_gv_get_packet_delay (camera, NULL), ==,
+			 arv_gv_bandwidth_planner_get_packet_delay (planner, 1));
+
+	arv_gv_bandwidth_planner_set_mode (planner, ARV_GV_BANDWIDTH_PLANNER_MODE_STAGGERED);
+	success = arv_gv_bandwidth_planner_apply (planner, &error);
+	g_assert (success);
+	g_assert (error == NULL);
+
+	duration = arv_gv_bandwidth_planner_get_frame_transmission_duration (planner, 0);
+	g_assert_cmpint (arv_gv_bandwidth_planner_get_frame_transmission_delay (planner, 0), ==, 0);
+	g_assert_cmpint (arv_gv_bandwidth_planner_get_frame_transmission_delay (planner, 1), >, duration);
+	g_assert_cmpfloat (arv_gv_bandwidth_planner_get_total_peak_utilization (planner), <=, 0.9 + 1e-9);
+	g_assert_cmpint (arv_camera_gv_get_frame_transmission_delay (camera, NULL), ==,
+			 arv_gv_bandwidth_planner_get_frame_transmission_delay (planner, 1));
+
+	g_object_unref (planner);
+
+	/* Same streams on a 100 Mb/s link */
+	planner = arv_gv_bandwidth_planner_new (100000000);
+	arv_gv_bandwidth_planner_add_camera_full (planner, camera, payload, frame_rate, 1500, 0);
+	arv_gv_bandwidth_planner_add_camera_full (planner, camera, payload, frame_rate, 1500, 0);
+
+	success = arv_gv_bandwidth_planner_compute (planner, &error);
+	g_assert (!success);
+	g_assert_error (error, ARV_GV_BANDWIDTH_PLANNER_ERROR, ARV_GV_BANDWIDTH_PLANNER_ERROR_OVER_BUDGET);
+	g_clear_error (&error);
+	g_assert_cmpfloat (arv_gv_bandwidth_planner_get_utilization (planner, 0), ==, 0.0);
+
+	g_object_unref (planner);
+
+	arv_camera_gv_set_packet_delay (camera, 0, &error);
+	g_assert (error == NULL);
+	arv_camera_gv_set_frame_transmission_delay (camera, 0, &error);
+	g_assert (error == NULL);
+}
+
+typedef struct {
+	GMutex mutex;
+	guint n_exposure_end_events;
+	guint n_frame_end_events;
+	guint64 frame_end_timestamp;
+	guint64 frame_end_block_id;
+	guint32 frame_end_width;
+	guint32 frame_end_height;
+	gint64 frame_end_timestamp_feature;
+} EventTestData;
+
+static void
+event_cb (ArvGvDevice *gv_device, guint event_id, guint stream_channel_index, guint64 block_id, guint64 timestamp,
+	  GBytes *data, EventTestData *test_data)
+{
+	g_mutex_lock (&test_data->mutex);
+
+	if (event_id == ARV_FAKE_CAMERA_EVENT_ID_EXPOSURE_END) {
+		g_assert_cmpint (g_bytes_get_size (data), ==, 0);
+		test_data->n_exposure_end_events++;
+	} else if (event_id == ARV_FAKE_CAMERA_EVENT_ID_FRAME_END) {
+		const guint32 *values;
+		size_t size;
+
+		values = g_bytes_get_data (data, &size);
+		g_assert_cmpint (size, ==, 2 * sizeof (guint32));
+
+		test_data->frame_end_width = g_ntohl (values[0]);
+		test_data->frame_end_height = g_ntohl (values[1]);
+		test_data->frame_end_timestamp = timestamp;
+		test_data->frame_end_block_id = block_id;
+
+		/* Event features are up to date at signal emission */
+		test_data->frame_end_timestamp_feature =
+			arv_device_get_integer_feature_value (ARV_DEVICE (gv_device), "EventFrameEndTimestamp", NULL);
+
+		test_data->n_frame_end_events++;
+	}
+
+	g_mutex_unlock (&test_data->mutex);
+}
+
+static void
+event_test (void)
+{
+	EventTestData test_data = {0};
+	ArvDevice *device;
+	ArvStream *stream;
+	GError *error = NULL;
+	size_t payload;
+	gulong handler_id;
+	gint64 value;
+	unsigned int i;
+
+	device = arv_camera_get_device (camera);
+	g_assert (ARV_IS_GV_DEVICE (device));
+
+	g_mutex_init (&test_data.mutex);
+
+	/* No event received yet */
+	arv_device_get_integer_feature_value (device, "EventExposureEndTimestamp", &error);
+	g_assert_error (error, ARV_GC_ERROR, ARV_GC_ERROR_EVENT_NOT_FOUND);
+	g_clear_error (&error);
+
+	handler_id = g_signal_connect (device, "event", G_CALLBACK (event_cb), &test_data);
+
+	g_assert (arv_gv_device_enable_events (ARV_GV_DEVICE (device), &error));
+	g_assert (error == NULL);
+
+	arv_device_set_string_feature_value (device, "EventSelector", "ExposureEnd", &error);
+	g_assert (error == NULL);
+	arv_device_set_string_feature_value (device, "EventNotification", "On", &error);
+	g_assert (error == NULL);
+	arv_device_set_string_feature_value (device, "EventSelector", "FrameEnd", &error);
+	g_assert (error == NULL);
+	arv_device_set_string_feature_value (device, "EventNotification", "On", &error);
+	g_assert (error == NULL);
+
+	stream = arv_camera_create_stream (camera, NULL, NULL);
+	g_assert (ARV_IS_STREAM (stream));
+
+	payload = arv_camera_get_payload (camera, NULL);
+	for (i = 0; i < 5; i++)
+		arv_stream_push_buffer (stream, arv_buffer_new (payload, NULL));
+
+	arv_camera_start_acquisition (camera, NULL);
+
+	for (i = 0; i < 500; i++) {
+		guint n_events;
+
+		g_mutex_lock (&test_data.mutex);
+		n_events = test_data.n_frame_end_events;
+		g_mutex_unlock (&test_data.mutex);
+
+		if (n_events >= 3)
+			break;
+
+		g_usleep (10000);
+	}
+
+	arv_camera_stop_acquisition (camera, NULL);
+
+	arv_device_set_string_feature_value (device, "EventSelector", "ExposureEnd", NULL);
+	arv_device_set_string_feature_value (device, "EventNotification", "Off", NULL);
+	arv_device_set_string_feature_value (device, "EventSelector", "FrameEnd", NULL);
+	arv_device_set_string_feature_value (device, "EventNotification", "Off", NULL);
+
+	arv_gv_device_disable_events (ARV_GV_DEVICE (device));
+	g_signal_handler_disconnect (device, handler_id);
+
+	g_assert_cmpint (test_data.n_frame_end_events, >=, 3);
+	g_assert_cmpint (test_data.n_exposure_end_events, >=, 3);
+	g_assert_cmpint (test_data.frame_end_width, ==, arv_camera_get_integer (camera, "Width", NULL));
+	g_assert_cmpint (test_data.frame_end_height, ==, arv_camera_get_integer (camera, "Height", NULL));
+	g_assert_cmpint (test_data.frame_end_timestamp_feature, ==, test_data.frame_end_timestamp);
+
+	/* Event data remain available after the event reception is stopped */
+	value = arv_device_get_integer_feature_value (device, "EventFrameEndTimestamp", &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (value, ==, test_data.frame_end_timestamp);
+	value = arv_device_get_integer_feature_value (device, "EventFrameEndFrameID", &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (value, ==, test_data.frame_end_block_id);
+	value = arv_device_get_integer_feature_value (device, "EventExposureEndTimestamp", &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (value, >, 0);
+
+	g_object_unref (stream);
+	g_mutex_clear (&test_data.mutex);
+}
+
+static void
+_padded_stream_test (gboolean late_leader)
+{
+	ArvFakeCamera *fake_camera;
+	ArvStream *stream;
+	ArvBuffer *buffer;
+	const guint8 *data;
+	size_t payload;
+	size_t size;
+	guint x, y;
+
+	fake_camera = arv_gv_fake_camera_get_fake_camera (simulator);
+	g_assert (ARV_IS_FAKE_CAMERA (fake_camera));
+
+	/* Rows of 301 bytes, padded to 304, spread over several packets */
+	arv_camera_set_region (camera, 0, 0, 301, 64, NULL);
+	arv_fake_camera_set_fill_pattern (fake_camera, padded_fill_pattern_cb, NULL);
+
+	/* Data blocks received before the leader are written tightly packed, and moved to their padded offset
+	 * on frame completion */
+	g_object_set (simulator, "gvsp-late-leader", late_leader, NULL);
+
+	stream = arv_camera_create_stream (camera, NULL, NULL);
+	g_assert (ARV_IS_STREAM (stream));
+
+	payload = arv_camera_get_payload (camera, NULL);
+	g_assert_cmpint (payload, ==, 301 * 64);
+
+	arv_stream_push_buffer (stream, arv_buffer_new_padded (payload, 64, 4));
+
+	arv_camera_set_acquisition_mode (camera, ARV_ACQUISITION_MODE_SINGLE_FRAME, NULL);
+	arv_camera_start_acquisition (camera, NULL);
+	buffer = arv_stream_timeout_pop_buffer (stream, 2000000);
+	arv_camera_stop_acquisition (camera, NULL);
+	arv_camera_set_acquisition_mode (camera, ARV_ACQUISITION_MODE_CONTINUOUS, NULL);
+
+	g_object_set (simulator, "gvsp-late-leader", FALSE, NULL);
+	arv_fake_camera_set_fill_pattern (fake_camera, NULL, NULL);
+
+	g_assert (ARV_IS_BUFFER (buffer));
+	g_assert_cmpint (arv_buffer_get_status (buffer), ==, ARV_BUFFER_STATUS_SUCCESS);
+	g_assert_cmpint (arv_buffer_get_image_row_stride (buffer), ==, 304);
+
+	data = arv_buffer_get_data (buffer, &size);
+	g_assert_cmpint (size, ==, 304 * 64);
+
+	for (y = 0; y < 64; y++)
+		for (x = 0; x < 301; x++)
+			g_assert_cmpint (data[y * 304 + x], ==, (y * 301 + x) % 251);
+
+	g_clear_object (&buffer);
+	g_clear_object (&stream);
+
+	arv_camera_set_region (camera, 0, 0, 1024, 1024, NULL);
+}
+
+static void
+padded_stream_test (void)
+{
+	_padded_stream_test (FALSE);
+}
+
+static void
+padded_stream_late_leader_test (void)
+{
+	_padded_stream_test (TRUE);
+}
+
 int
 main (int argc, char *argv[])
 {
-	ArvGvFakeCamera *simulator;
 	int result;
 
 	g_test_init (&argc, &argv, NULL);
@@ -233,6 +1044,17 @@ main (int argc, char *argv[])
 	g_test_add_func ("/fakegv/acquisition", acquisition_test);
 	g_test_add_func ("/fakegv/stream", stream_test);
 	g_test_add_func ("/fakegv/dynamic_roi", dynamic_roi_test);
+	g_test_add_func ("/fakegv/open_phases", open_phase_test);
+	g_test_add_func ("/fakegv/device_list", device_list_test);
+	g_test_add_func ("/fakegv/camera_group", camera_group_test);
+	g_test_add_func ("/fakegv/action_command", action_command_test);
+	g_test_add_func ("/fakegv/frame_sync", frame_sync_test);
+	g_test_add_func ("/fakegv/event", event_test);
+	g_test_add_func ("/fakegv/clock_model", clock_model_test);
+	g_test_add_func ("/fakegv/auto_packet_size", auto_packet_size_test);
+	g_test_add_func ("/fakegv/bandwidth_planner", bandwidth_planner_test);
+	g_test_add_func ("/fakegv/padded_stream", padded_stream_test);
+	g_test_add_func ("/fakegv/padded_stream_late_leader", padded_stream_late_leader_test);
 
 	result = g_test_run();
 
@@ -0,0 +1,32 @@
+#ifndef ARV_TESTS_FILL_PATTERN_H
+#define ARV_TESTS_FILL_PATTERN_H
+
+#include <glib.h>
+#include <arv.h>
+
+/* Fake camera fill pattern writing (y * row_size + x) % 251 at each byte of the image rows, at their padded offset
+ * if the buffer rows are padded */
+
+static void
+padded_fill_pattern_cb (ArvBuffer *buffer, void *fill_pattern_data, guint32 exposure_time_us, guint32 gain,
+			ArvPixelFormat pixel_format)
+{
+	guint8 *data;
+	size_t row_size;
+	size_t row_stride;
+	gint width;
+	gint height;
+	size_t x;
+	gint y;
+
+	arv_buffer_get_image_region (buffer, NULL, NULL, &width, &height);
+	row_size = (size_t) width * ARV_PIXEL_FORMAT_BIT_PER_PIXEL (arv_buffer_get_image_pixel_format (buffer)) / 8;
+	row_stride = arv_buffer_get_image_row_stride (buffer);
+
+	data = (guint8 *) arv_buffer_get_data (buffer, NULL);
+	for (y = 0; y < height; y++)
+		for (x = 0; x < row_size; x++)
+			data[y * row_stride + x] = (y * row_size + x) % 251;
+}
+
+#endif
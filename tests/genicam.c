@@ -721,6 +721,114 @@ register_test (void)
 
 GRegex *arv_gv_device_get_url_regex (void);
 
+static void
+register_cache_test (void)
+{
+	ArvDevice *device;
+	ArvGc *genicam;
+	ArvGcNode *node;
+	ArvGcNode *alias;
+	ArvGcNode *invalidator;
+	guint64 n_hits;
+	guint64 n_misses;
+	gint64 value;
+
+	device = arv_fake_device_new ("TEST0");
+	g_assert (ARV_IS_FAKE_DEVICE (device));
+
+	genicam = arv_device_get_genicam (device);
+	g_assert (ARV_IS_GC (genicam));
+
+	arv_gc_set_register_cache_policy (genicam, ARV_REGISTER_CACHE_POLICY_ENABLE);
+
+	node = arv_gc_get_node (genicam, "CachedRegister");
+	g_assert (ARV_IS_GC_REGISTER (node));
+	alias = arv_gc_get_node (genicam, "CachedRegisterAlias");
+	g_assert (ARV_IS_GC_REGISTER (alias));
+	invalidator = arv_gc_get_node (genicam, "CacheInvalidator");
+	g_assert (ARV_IS_GC_INTEGER (invalidator));
+
+	arv_gc_integer_set_value (ARV_GC_INTEGER (node), 1, NULL);
+	value = arv_gc_integer_get_value (ARV_GC_INTEGER (node), NULL);
+	g_assert_cmpint (value, ==, 1);
+
+	/* Alias write is not visible through the cache */
+	arv_gc_integer_set_value (ARV_GC_INTEGER (alias), 2, NULL);
+	value = arv_gc_integer_get_value (ARV_GC_INTEGER (node), NULL);
+	g_assert_cmpint (value, ==, 1);
+
+	/* Invalidator is an Integer node, changed through its pValue register */
+	arv_gc_integer_set_value (ARV_GC_INTEGER (invalidator), 10, NULL);
+	value = arv_gc_integer_get_value (ARV_GC_INTEGER (node), NULL);
+	g_assert_cmpint (value, ==, 2);
+
+	value = arv_gc_integer_get_value (ARV_GC_INTEGER (node), NULL);
+	g_assert_cmpint (value, ==, 2);
+
+	arv_gc_get_register_cache_statistics (genicam, &n_hits, &n_misses);
+	g_assert_cmpint (n_hits, >=, 3);
+	g_assert_cmpint (n_misses, >=, 1);
+
+	g_object_unref (device);
+}
+
+static void
+memoization_test (void)
+{
+	ArvDevice *device;
+	ArvGc *genicam;
+	ArvGcNode *node;
+	ArvGcNode *alias;
+	ArvGcNode *memoized;
+	ArvGcNode *volatile_node;
+	gint64 value;
+
+	device = arv_fake_device_new ("TEST0");
+	g_assert (ARV_IS_FAKE_DEVICE (device));
+
+	genicam = arv_device_get_genicam (device);
+	g_assert (ARV_IS_GC (genicam));
+
+	arv_gc_set_register_cache_policy (genicam, ARV_REGISTER_CACHE_POLICY_ENABLE);
+
+	node = arv_gc_get_node (genicam, "CachedRegister");
+	g_assert (ARV_IS_GC_REGISTER (node));
+	alias = arv_gc_get_node (genicam, "CachedRegisterAlias");
+	g_assert (ARV_IS_GC_REGISTER (alias));
+	memoized = arv_gc_get_node (genicam, "MemoizedSwissKnife");
+	g_assert (ARV_IS_GC_SWISS_KNIFE (memoized));
+	volatile_node = arv_gc_get_node (genicam, "VolatileSwissKnife");
+	g_assert (ARV_IS_GC_SWISS_KNIFE (volatile_node));
+
+	arv_gc_integer_set_value (ARV_GC_INTEGER (node), 3, NULL);
+	value = arv_gc_integer_get_value (ARV_GC_INTEGER (memoized), NULL);
+	g_assert_cmpint (value, ==, 6);
+
+	/* Memoized value is kept as long as the inputs are not changed */
+	arv_gc_integer_set_value (ARV_GC_INTEGER (alias), 5, NULL);
+	value = arv_gc_integer_get_value (ARV_GC_INTEGER (memoized), NULL);
+	g_assert_cmpint (value, ==, 6);
+
+	/* Formulas with non cachable inputs are always evaluated */
+	value = arv_gc_integer_get_value (ARV_GC_INTEGER (volatile_node), NULL);
+	g_assert_cmpint (value, ==, 10);
+	arv_gc_integer_set_value (ARV_GC_INTEGER (alias), 7, NULL);
+	value = arv_gc_integer_get_value (ARV_GC_INTEGER (volatile_node), NULL);
+	g_assert_cmpint (value, ==, 14);
+
+	arv_gc_integer_set_value (ARV_GC_INTEGER (node), 4, NULL);
+	value = arv_gc_integer_get_value (ARV_GC_INTEGER (memoized), NULL);
+	g_assert_cmpint (value, ==, 8);
+
+	/* No memoization without register cache */
+	arv_gc_set_register_cache_policy (genicam, ARV_REGISTER_CACHE_POLICY_DISABLE);
+	arv_gc_integer_set_value (ARV_GC_INTEGER (alias), 9, NULL);
+	value = arv_gc_integer_get_value (ARV_GC_INTEGER (memoized), NULL);
+	g_assert_cmpint (value, ==, 18);
+
+	g_object_unref (device);
+}
+
 static void
 url_test (void)
 {
@@ -928,6 +1036,29 @@ chunk_data_test (void)
 	g_assert (error != NULL);
 	g_clear_error (&error);
 
+	{
+		const char *chunks[] = {"ChunkInt", "ChunkFloat", "ChunkString", "ChunkBoolean"};
+		GValue values[G_N_ELEMENTS (chunks)] = {G_VALUE_INIT, G_VALUE_INIT, G_VALUE_INIT, G_VALUE_INIT};
+		unsigned int i;
+
+		g_assert (arv_chunk_parser_get_values (parser, buffer, chunks, values, G_N_ELEMENTS (chunks), &error));
+		g_assert (error == NULL);
+
+		g_assert_cmpint (g_value_get_int64 (&values[0]), ==, 0x11223344);
+		g_assert_cmpfloat (g_value_get_double (&values[1]), ==, 1.1);
+		g_assert_cmpstr (g_value_get_string (&values[2]), ==, "Hello");
+		g_assert (g_value_get_boolean (&values[3]));
+
+		chunks[1] = "Dummy";
+		g_assert (!arv_chunk_parser_get_values (parser, buffer, chunks, values, G_N_ELEMENTS (chunks), &error));
+		g_assert_error (error, ARV_CHUNK_PARSER_ERROR, ARV_CHUNK_PARSER_ERROR_INVALID_FEATURE_TYPE);
+		g_clear_error (&error);
+
+		for (i = 0; i < G_N_ELEMENTS (chunks); i++)
+			if (G_IS_VALUE (&values[i]))
+				g_value_unset (&values[i]);
+	}
+
 	g_object_unref (buffer);
 	g_object_unref (parser);
 	g_object_unref (device);
@@ -950,6 +1081,8 @@ main (int argc, char *argv[])
 	g_test_add_func ("/genicam/swissknife", swiss_knife_test);
 	g_test_add_func ("/genicam/converter", converter_test);
 	g_test_add_func ("/genicam/register", register_test);
+	g_test_add_func ("/genicam/register-cache", register_cache_test);
+	g_test_add_func ("/genicam/memoization", memoization_test);
 	g_test_add_func ("/genicam/url", url_test);
 	g_test_add_func ("/genicam/mandatory", mandatory_test);
 	g_test_add_func ("/genicam/chunk-data", chunk_data_test);
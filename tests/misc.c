@@ -2,6 +2,12 @@
 #include <arv.h>
 #include <arvstr.h>
 #include <string.h>
+#include <stdlib.h>
+#include <math.h>
+
+#define ARAVIS_COMPILATION
+#include "../src/arvstreamprivate.h"
+#include "../src/arvbufferprivate.h"
 
 #if !ARAVIS_CHECK_VERSION (ARAVIS_MAJOR_VERSION, ARAVIS_MINOR_VERSION, ARAVIS_MICRO_VERSION)
 #error
@@ -177,6 +183,266 @@ arv_vendor_alias_lookup_test (void)
 	g_assert (alias == vendor_b);
 }
 
+static void
+clock_model_test (void)
+{
+	ArvClockModel *model;
+	guint64 device_time = 5000000000LL;
+	guint64 host_time = 1600000000000000000LL;
+	gint64 offset = host_time - device_time;
+	guint64 expected;
+	unsigned int i;
+
+	model = arv_clock_model_new ();
+
+	g_assert_cmpint (arv_clock_model_get_n_samples (model), ==, 0);
+	g_assert_cmpint (arv_clock_model_get_host_timestamp (model, device_time), ==, 0);
+
+	/* Host clock 50 ppm faster than the device clock, one sample per second with a +/- 20 µs jitter */
+	for (i = 0; i < 40; i++) {
+		guint64 d = device_time + i * 1000000000LL;
+		guint64 h = host_time + i * 1000050000LL + ((gint64) (i % 3) - 1) * 20000;
+
+		arv_clock_model_add_sample (model, d, h, 100000);
+	}
+
+	g_assert_cmpint (arv_clock_model_get_n_samples (model), ==, 32);
+	g_assert_cmpfloat (fabs (arv_clock_model_get_drift (model) - 50.0), <, 1.0);
+
+	expected = host_time + 39 * 1000050000LL;
+	g_assert_cmpint (llabs ((gint64) (arv_clock_model_get_host_timestamp (model, device_time + 39 * 1000000000LL) -
+					  expected)), <, 20000);
+
+	/* One second extrapolation */
+	expected = host_time + 40 * 1000050000LL;
+	g_assert_cmpint (llabs ((gint64) (arv_clock_model_get_host_timestamp (model, device_time + 40 * 1000000000LL) -
+					  expected)), <, 20000);
+
+	g_assert_cmpint (llabs (arv_clock_model_get_offset (model) - (offset + 39 * 50000)), <, 20000);
+
+	/* Device timestamp reset */
+	arv_clock_model_add_sample (model, 1000, host_time, 1000);
+	g_assert_cmpint (arv_clock_model_get_n_samples (model), ==, 1);
+	g_assert_cmpint (arv_clock_model_get_host_timestamp (model, 2000), ==, host_time + 1000);
+	g_assert_cmpfloat (arv_clock_model_get_drift (model), ==, 0.0);
+
+	arv_clock_model_reset (model);
+	g_assert_cmpint (arv_clock_model_get_n_samples (model), ==, 0);
+
+	g_object_unref (model);
+}
+
+/* Stream without thread, the buffers being completed by the test itself */
+
+typedef struct {
+	ArvStream stream;
+} TestStream;
+
+typedef struct {
+	ArvStreamClass parent_class;
+} TestStreamClass;
+
+static GType test_stream_get_type (void);
+
+G_DEFINE_TYPE (TestStream, test_stream, ARV_TYPE_STREAM)
+
+static void
+test_stream_init (TestStream *stream)
+{
+}
+
+static void
+test_stream_class_init (TestStreamClass *this_class)
+{
+}
+
+static void
+_complete_buffer (ArvStream *stream, guint32 frame_id, guint64 timestamp, guint64 system_timestamp)
+{
+	ArvBuffer *buffer;
+
+	buffer = arv_buffer_new_allocate (16);
+	buffer->priv->status = ARV_BUFFER_STATUS_SUCCESS;
+	buffer->priv->frame_id = frame_id;
+	buffer->priv->timestamp_ns = timestamp;
+	buffer->priv->system_timestamp_ns = system_timestamp;
+
+	arv_stream_push_output_buffer (stream, buffer);
+}
+
+static void
+frame_sync_clock_offset_test (void)
+{
+	ArvStream *streams[2];
+	ArvFrameSync *sync;
+	ArvFrameSet *frame_set;
+	guint64 capture_time = 1600000000000000000LL;
+	guint64 frame_period = 33000000;
+	gint64 device_offsets[2] = {5000000000LL, -3000000000LL};
+
+	streams[0] = g_object_new (test_stream_get_type (), NULL);
+	streams[1] = g_object_new (test_stream_get_type (), NULL);
+
+	sync = arv_frame_sync_new (streams, 2, ARV_FRAME_SYNC_MODE_TIMESTAMP);
+	arv_frame_sync_set_tolerance (sync, 100000);
+
+	/* Device clocks 5 s ahead and 3 s behind the host clock. The estimated offset of the first device improves
+	 * with its second frame, while its first frame is still waiting for a match. */
+	_complete_buffer (streams[0], 1, capture_time + device_offsets[0], capture_time + 2000000);
+	_complete_buffer (streams[0], 2, capture_time + frame_period + device_offsets[0],
+			  capture_time + frame_period + 500000);
+	g_assert_cmpint (arv_frame_sync_get_clock_offset (sync, 0), ==, device_offsets[0] - 500000);
+
+	_complete_buffer (streams[1], 1, capture_time + device_offsets[1], capture_time + 2000000);
+	g_assert_cmpint (arv_frame_sync_get_clock_offset (sync, 1), ==, device_offsets[1] - 2000000);
+
+	/* The first frame of each device was converted with the offset known at its reception */
+	frame_set = arv_frame_sync_try_pop_frame_set (sync);
+	g_assert (ARV_IS_FRAME_SET (frame_set));
+	g_assert (arv_frame_set_is_complete (frame_set));
+	g_assert_cmpint (arv_frame_set_get_timestamp (frame_set), ==, capture_time + 2000000);
+	arv_frame_sync_push_frame_set (sync, frame_set);
+
+	_complete_buffer (streams[1], 2, capture_time + frame_period + device_offsets[1],
+			  capture_time + frame_period + 500000);
+	g_assert_cmpint (arv_frame_sync_get_clock_offset (sync, 1), ==, device_offsets[1] - 500000);
+
+	frame_set = arv_frame_sync_try_pop_frame_set (sync);
+	g_assert (ARV_IS_FRAME_SET (frame_set));
+	g_assert (arv_frame_set_is_complete (frame_set));
+	g_assert_cmpint (arv_buffer_get_frame_id (arv_frame_set_get_buffer (frame_set, 0)), ==, 2);
+	g_assert_cmpint (arv_buffer_get_frame_id (arv_frame_set_get_buffer (frame_set, 1)), ==, 2);
+	g_assert_cmpint (arv_frame_set_get_timestamp (frame_set), ==, capture_time + frame_period + 500000);
+	arv_frame_sync_push_frame_set (sync, frame_set);
+
+	g_assert (arv_frame_sync_try_pop_frame_set (sync) == NULL);
+
+	g_object_unref (sync);
+
+	g_object_unref (streams[0]);
+	g_object_unref (streams[1]);
+}
+
+static void
+frame_sync_frame_id_test (void)
+{
+	ArvStream *streams[2];
+	ArvFrameSync *sync;
+	ArvFrameSet *frame_set;
+	guint64 n_complete_frame_sets;
+	guint64 n_incomplete_frame_sets;
+	guint64 n_dropped_buffers;
+	guint32 frame_ids[] = {65534, 0, 1};
+	unsigned int i;
+
+	streams[0] = g_object_new (test_stream_get_type (), NULL);
+	streams[1] = g_object_new (test_stream_get_type (), NULL);
+
+	/* Unrelated timestamps */
+	sync = arv_frame_sync_new (streams, 2, ARV_FRAME_SYNC_MODE_FRAME_ID);
+	g_assert_cmpint (arv_frame_sync_get_tolerance (sync), ==, 0);
+
+	_complete_buffer (streams[0], 65534, 1000000000LL, 1000000000LL);
+	_complete_buffer (streams[1], 65534, 9000000000LL, 9000000000LL);
+
+	/* The second stream misses frame 65535, which is older than frame 0 */
+	_complete_buffer (streams[0], 65535, 1033000000LL, 1033000000LL);
+	_complete_buffer (streams[0], 0, 1066000000LL, 1066000000LL);
+	_complete_buffer (streams[1], 0, 9066000000LL, 9066000000LL);
+
+	_complete_buffer (streams[0], 1, 1099000000LL, 1099000000LL);
+	_complete_buffer (streams[1], 1, 9099000000LL, 9099000000LL);
+
+	for (i = 0; i < G_N_ELEMENTS (frame_ids); i++) {
+		frame_set = arv_frame_sync_try_pop_frame_set (sync);
+		g_assert (ARV_IS_FRAME_SET (frame_set));
+		g_assert (arv_frame_set_is_complete (frame_set));
+		g_assert_cmpint (arv_buffer_get_frame_id (arv_frame_set_get_buffer (frame_set, 0)), ==, frame_ids[i]);
+		g_assert_cmpint (arv_buffer_get_frame_id (arv_frame_set_get_buffer (frame_set, 1)), ==, frame_ids[i]);
+		arv_frame_sync_push_frame_set (sync, frame_set);
+	}
+
+	g_assert (arv_frame_sync_try_pop_frame_set (sync) == NULL);
+
+	arv_frame_sync_get_statistics (sync, &n_complete_frame_sets, &n_incomplete_frame_sets, &n_dropped_buffers);
+	g_assert_cmpint (n_complete_frame_sets, ==, 3);
+	g_assert_cmpint (n_incomplete_frame_sets, ==, 0);
+	g_assert_cmpint (n_dropped_buffers, ==, 1);
+
+	g_object_unref (sync);
+
+	g_object_unref (streams[0]);
+	g_object_unref (streams[1]);
+}
+
+static void
+_zip_stream_cb (const void *data, size_t size, void *user_data)
+{
+	g_byte_array_append (user_data, data, size);
+}
+
+static void
+zip_stream_test (void)
+{
+	/* 0 for the whole archive at once */
+	const size_t chunk_sizes[] = {1, 7, 512, 4096, 0};
+	ArvZip *zip;
+	ArvZipStream *stream;
+	GByteArray *output;
+	const GSList *zip_files;
+	const char *file_name;
+	char *buffer;
+	gsize size;
+	void *data;
+	size_t data_size;
+	size_t offset;
+	guint i;
+
+	g_assert (g_file_get_contents (GENICAM_ZIP_FILENAME, &buffer, &size, NULL));
+
+	/* One-shot extraction */
+	zip = arv_zip_new (buffer, size);
+	zip_files = arv_zip_get_file_list (zip);
+	g_assert (zip_files != NULL);
+	file_name = arv_zip_file_get_name (zip_files->data);
+	data = arv_zip_get_file (zip, file_name, &data_size);
+	g_assert (data != NULL);
+	g_assert_cmpint (data_size, >, size);
+
+	/* The streaming inflater gives the same result, whatever the chunk size */
+	for (i = 0; i < G_N_ELEMENTS (chunk_sizes); i++) {
+		size_t chunk_size = chunk_sizes[i] > 0 ? chunk_sizes[i] : size;
+
+		output = g_byte_array_new ();
+		stream = arv_zip_stream_new (_zip_stream_cb, output);
+
+		for (offset = 0; offset < size; offset += chunk_size)
+			g_assert (arv_zip_stream_push (stream, buffer + offset, MIN (chunk_size, size - offset)));
+
+		g_assert (arv_zip_stream_is_done (stream));
+		g_assert_cmpstr (arv_zip_stream_get_file_name (stream), ==, file_name);
+		g_assert_cmpint (arv_zip_stream_get_uncompressed_size (stream), ==, data_size);
+		g_assert_cmpint (output->len, ==, data_size);
+		g_assert (memcmp (output->data, data, data_size) == 0);
+
+		arv_zip_stream_free (stream);
+		g_byte_array_unref (output);
+	}
+
+	/* A truncated archive is never done */
+	output = g_byte_array_new ();
+	stream = arv_zip_stream_new (_zip_stream_cb, output);
+	g_assert (arv_zip_stream_push (stream, buffer, size / 2));
+	g_assert (!arv_zip_stream_is_done (stream));
+	g_assert_cmpint (output->len, <, data_size);
+	arv_zip_stream_free (stream);
+	g_byte_array_unref (output);
+
+	g_free (data);
+	arv_zip_free (zip);
+	g_free (buffer);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -190,6 +456,10 @@ main (int argc, char *argv[])
 	g_test_add_func ("/str/arv-str-parse-double", arv_str_parse_double_test);
 	g_test_add_func ("/str/arv-str-parse-double-list", arv_str_parse_double_list_test);
 	g_test_add_func ("/misc/arv-vendor-alias-lookup", arv_vendor_alias_lookup_test);
+	g_test_add_func ("/misc/clock-model", clock_model_test);
+	g_test_add_func ("/misc/frame-sync-clock-offset", frame_sync_clock_offset_test);
+	g_test_add_func ("/misc/frame-sync-frame-id", frame_sync_frame_id_test);
+	g_test_add_func ("/misc/zip-stream", zip_stream_test);
 
 	result = g_test_run();
 
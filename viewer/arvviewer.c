@@ -119,6 +119,12 @@ typedef struct {
 	char *camera_name;
 	ArvStream *stream;
 	ArvBuffer *last_buffer;
+	ArvConverter *converter;
+
+	/* Latest completed buffer, not displayed yet */
+	GMutex latest_buffer_mutex;
+	ArvBuffer *latest_buffer;
+	guint display_tick_id;
 
 	GstElement *pipeline;
 	GstElement *appsrc;
@@ -188,9 +194,11 @@ typedef struct {
 	gint64 last_status_bar_update_time_ms;
 	unsigned last_n_images;
 	unsigned last_n_bytes;
+	unsigned last_n_displayed_images;
 	unsigned n_images;
 	unsigned n_bytes;
 	unsigned n_errors;
+	unsigned n_displayed_images;
 
 	gboolean auto_socket_buffer;
 	gboolean packet_resend;
@@ -284,8 +292,12 @@ gst_buffer_release_cb (void *user_data)
 	g_free (release_data);
 }
 
+/* Converts the image when the pixel format is not supported by GStreamer, or when the row stride is not a multiple
+ * of 4, as required by GStreamer, which only happens if the rows could not be padded during reception. Otherwise,
+ * the buffer data are wrapped, and the buffer is returned to the stream once released by GStreamer. */
+
 static GstBuffer *
-arv_to_gst_buffer (ArvBuffer *arv_buffer, ArvStream *stream)
+arv_to_gst_buffer (ArvViewer *viewer, ArvBuffer *arv_buffer, ArvStream *stream)
 {
 	GstBuffer *buffer;
 	int arv_row_stride;
@@ -295,24 +307,32 @@ arv_to_gst_buffer (ArvBuffer *arv_buffer, ArvStream *stream)
 
 	buffer_data = (char *) arv_buffer_get_data (arv_buffer, &buffer_size);
 	arv_buffer_get_image_region (arv_buffer, NULL, NULL, &width, &height);
-	arv_row_stride = width * ARV_PIXEL_FORMAT_BIT_PER_PIXEL (arv_buffer_get_image_pixel_format (arv_buffer)) / 8;
+	arv_row_stride = arv_buffer_get_image_row_stride (arv_buffer);
 
-	/* Gstreamer requires row stride to be a multiple of 4 */
-	if ((arv_row_stride & 0x3) != 0) {
+	if (arv_converter_get_n_steps (viewer->converter) > 0 || (arv_row_stride & 0x3) != 0) {
+		GError *error = NULL;
 		int gst_row_stride;
 		size_t size;
 		void *data;
-		int i;
 
-		gst_row_stride = (arv_row_stride & ~(0x3)) + 4;
+		gst_row_stride = width *
+			ARV_PIXEL_FORMAT_BIT_PER_PIXEL (arv_converter_get_output_format (viewer->converter)) / 8;
+		gst_row_stride = (gst_row_stride + 3) & ~(0x3);
 
 		size = height * gst_row_stride;
 		data = g_malloc (size);
 
-		for (i = 0; i < height; i++)
-			memcpy (((char *) data) + i * gst_row_stride, buffer_data + i * arv_row_stride, arv_row_stride);
+		if (!arv_converter_process (viewer->converter, buffer_data, arv_row_stride, width, height,
+					    data, gst_row_stride, &error)) {
+			arv_debug_viewer ("conversion failed: %s", error->message);
+			g_clear_error (&error);
+			g_free (data);
+			return NULL;
+		}
 
 		buffer = gst_buffer_new_wrapped (data, size);
+
+		arv_stream_push_buffer (stream, arv_buffer);
 	} else {
 		ArvGstBufferReleaseData* release_data = g_new0 (ArvGstBufferReleaseData, 1);
 
@@ -342,13 +362,20 @@ new_buffer_cb (ArvStream *stream, ArvViewer *viewer)
 	arv_log_viewer ("pop_buffer (%d,%d)", n_input_buffers, n_output_buffers);
 
 	if (arv_buffer_get_status (arv_buffer) == ARV_BUFFER_STATUS_SUCCESS) {
+		ArvBuffer *skipped_buffer;
 		size_t size;
 
 		arv_buffer_get_data (arv_buffer, &size);
-		gst_app_src_push_buffer (GST_APP_SRC (viewer->appsrc), arv_to_gst_buffer (arv_buffer, stream));
 
-		g_clear_object( &viewer->last_buffer );
-		viewer->last_buffer = g_object_ref( arv_buffer );
+		/* Only the latest buffer is kept for display, the previous one goes back to the stream right away if
+		 * it was not displayed in the meantime */
+		g_mutex_lock (&viewer->latest_buffer_mutex);
+		skipped_buffer = viewer->latest_buffer;
+		viewer->latest_buffer = arv_buffer;
+		g_mutex_unlock (&viewer->latest_buffer_mutex);
+
+		if (skipped_buffer != NULL)
+			arv_stream_push_buffer (stream, skipped_buffer);
 
 		viewer->n_images++;
 		viewer->n_bytes += size;
@@ -358,6 +385,47 @@ new_buffer_cb (ArvStream *stream, ArvViewer *viewer)
 	}
 }
 
+/* Called at the display refresh rate. The latest buffer is only given to the pipeline once the previous one was
+ * consumed, which prevents any backlog in the appsrc queue, whatever the camera frame rate. */
+
+static gboolean
+display_tick_cb (GtkWidget *widget, GdkFrameClock *frame_clock, gpointer user_data)
+{
+	ArvViewer *viewer = user_data;
+	ArvBuffer *arv_buffer;
+	GstBuffer *buffer;
+
+	if (!GST_IS_APP_SRC (viewer->appsrc) || !ARV_IS_STREAM (viewer->stream))
+		return G_SOURCE_CONTINUE;
+
+	if (gst_app_src_get_current_level_bytes (GST_APP_SRC (viewer->appsrc)) > 0)
+		return G_SOURCE_CONTINUE;
+
+	g_mutex_lock (&viewer->latest_buffer_mutex);
+	arv_buffer = viewer->latest_buffer;
+	viewer->latest_buffer = NULL;
+	g_mutex_unlock (&viewer->latest_buffer_mutex);
+
+	if (arv_buffer == NULL)
+		return G_SOURCE_CONTINUE;
+
+	g_clear_object (&viewer->last_buffer);
+	viewer->last_buffer = g_object_ref (arv_buffer);
+
+	buffer = arv_to_gst_buffer (viewer, arv_buffer, viewer->stream);
+	if (buffer == NULL) {
+		arv_stream_push_buffer (viewer->stream, arv_buffer);
+		viewer->n_errors++;
+		return G_SOURCE_CONTINUE;
+	}
+
+	gst_app_src_push_buffer (GST_APP_SRC (viewer->appsrc), buffer);
+
+	viewer->n_displayed_images++;
+
+	return G_SOURCE_CONTINUE;
+}
+
 static void
 frame_rate_entry_cb (GtkEntry *entry, ArvViewer *viewer)
 {
@@ -531,6 +599,7 @@ void
 snapshot_cb (GtkButton *button, ArvViewer *viewer)
 {
 	GFile *file;
+	GFileOutputStream *stream;
 	char *path;
 	char *filename;
 	GDateTime *date;
@@ -539,6 +608,9 @@ snapshot_cb (GtkButton *button, ArvViewer *viewer)
 	const char *data;
 	const char *pixel_format;
 	size_t size;
+	size_t row_size;
+	size_t row_stride;
+	int i;
 
 	g_return_if_fail (ARV_IS_CAMERA (viewer->camera));
 	g_return_if_fail (ARV_IS_BUFFER (viewer->last_buffer));
@@ -547,6 +619,11 @@ snapshot_cb (GtkButton *button, ArvViewer *viewer)
 	arv_buffer_get_image_region (viewer->last_buffer, NULL, NULL, &width, &height);
 	data = arv_buffer_get_data (viewer->last_buffer, &size);
 
+	/* The rows of the stream buffers are padded, the padding is not saved */
+	row_stride = arv_buffer_get_image_row_stride (viewer->last_buffer);
+	row_size = (size_t) width * ARV_PIXEL_FORMAT_BIT_PER_PIXEL (arv_buffer_get_image_pixel_format
+								    (viewer->last_buffer)) / 8;
+
 	path = g_build_filename (g_get_user_special_dir (G_USER_DIRECTORY_PICTURES),
 					 "Aravis", NULL);
 	file = g_file_new_for_path (path);
@@ -565,7 +642,18 @@ snapshot_cb (GtkButton *button, ArvViewer *viewer)
 				    date_string);
 	path = g_build_filename (g_get_user_special_dir (G_USER_DIRECTORY_PICTURES),
 				 "Aravis", filename, NULL);
-	g_file_set_contents (path, data, size, NULL);
+
+	file = g_file_new_for_path (path);
+	stream = g_file_replace (file, NULL, FALSE, G_FILE_CREATE_NONE, NULL, NULL);
+	if (stream != NULL) {
+		for (i = 0; i < height && (i * row_stride + row_size) <= size; i++)
+			if (!g_output_stream_write_all (G_OUTPUT_STREAM (stream), data + i * row_stride, row_size,
+							NULL, NULL, NULL))
+				break;
+		g_output_stream_close (G_OUTPUT_STREAM (stream), NULL, NULL);
+		g_object_unref (stream);
+	}
+	g_object_unref (file);
 
 	if (viewer->notification) {
 		notify_notification_update (viewer->notification,
@@ -639,25 +727,33 @@ update_status_bar_cb (void *data)
 	guint n_images = viewer->n_images;
 	guint n_bytes = viewer->n_bytes;
 	guint n_errors = viewer->n_errors;
+	guint n_displayed_images = viewer->n_displayed_images;
+	guint64 n_underruns = 0;
 
 	if (elapsed_time_ms == 0)
 		return TRUE;
 
-	text = g_strdup_printf ("%.1f fps (%.1f MB/s)",
+	if (ARV_IS_STREAM (viewer->stream))
+		arv_stream_get_statistics (viewer->stream, NULL, NULL, &n_underruns);
+
+	text = g_strdup_printf ("%.1f fps (%.1f MB/s) / %.1f fps displayed",
 				1000.0 * (n_images - viewer->last_n_images) / elapsed_time_ms,
-				((n_bytes - viewer->last_n_bytes) / 1000.0) / elapsed_time_ms);
+				((n_bytes - viewer->last_n_bytes) / 1000.0) / elapsed_time_ms,
+				1000.0 * (n_displayed_images - viewer->last_n_displayed_images) / elapsed_time_ms);
 	gtk_label_set_label (GTK_LABEL (viewer->fps_label), text);
 	g_free (text);
 
-	text = g_strdup_printf ("%u image%s / %u error%s",
+	text = g_strdup_printf ("%u image%s / %u error%s / %" G_GUINT64_FORMAT " underrun%s",
 				n_images, n_images > 0 ? "s" : "",
-				n_errors, n_errors > 0 ? "s" : "");
+				n_errors, n_errors > 0 ? "s" : "",
+				n_underruns, n_underruns > 0 ? "s" : "");
 	gtk_label_set_label (GTK_LABEL (viewer->image_label), text);
 	g_free (text);
 
 	viewer->last_status_bar_update_time_ms = time_ms;
 	viewer->last_n_images = n_images;
 	viewer->last_n_bytes = n_bytes;
+	viewer->last_n_displayed_images = n_displayed_images;
 
 	return TRUE;
 }
@@ -803,9 +899,45 @@ remove_widget (GtkWidget *widget, gpointer data)
 	g_object_unref (widget);
 }
 
+/* Packed formats are unpacked, and 8 bit Bayer formats are demosaiced in the viewer, before being handed to
+ * GStreamer */
+
+static ArvConverter *
+_create_converter (ArvPixelFormat pixel_format)
+{
+	ArvConverter *converter;
+
+	converter = arv_converter_new (pixel_format);
+
+	if (arv_pixel_format_get_unpacked_format (pixel_format) != 0)
+		arv_converter_add_unpack (converter, NULL);
+	else if (arv_demosaic_get_output_format (pixel_format, FALSE) == ARV_PIXEL_FORMAT_RGB_8_PACKED)
+		arv_converter_add_demosaic (converter, ARV_DEMOSAIC_METHOD_BILINEAR, FALSE, NULL);
+
+	return converter;
+}
+
+static const char *
+_get_gst_caps_string (ArvPixelFormat pixel_format)
+{
+	ArvConverter *converter;
+	const char *caps_string;
+
+	converter = _create_converter (pixel_format);
+	caps_string = arv_pixel_format_to_gst_caps_string (arv_converter_get_output_format (converter));
+	g_object_unref (converter);
+
+	return caps_string;
+}
+
 static void
 stop_video (ArvViewer *viewer)
 {
+	if (viewer->display_tick_id > 0) {
+		gtk_widget_remove_tick_callback (viewer->main_window, viewer->display_tick_id);
+		viewer->display_tick_id = 0;
+	}
+
 	if (GST_IS_PIPELINE (viewer->pipeline))
 		gst_element_set_state (viewer->pipeline, GST_STATE_NULL);
 
@@ -815,9 +947,14 @@ stop_video (ArvViewer *viewer)
 	g_clear_object (&viewer->stream);
 	g_clear_object (&viewer->pipeline);
 
+	g_mutex_lock (&viewer->latest_buffer_mutex);
+	g_clear_object (&viewer->latest_buffer);
+	g_mutex_unlock (&viewer->latest_buffer_mutex);
+
 	viewer->appsrc = NULL;
 
 	g_clear_object (&viewer->last_buffer);
+	g_clear_object (&viewer->converter);
 
 	if (ARV_IS_CAMERA (viewer->camera))
 		arv_camera_stop_acquisition (viewer->camera, NULL);
@@ -913,11 +1050,13 @@ start_video (ArvViewer *viewer)
 	}
 
 	arv_stream_set_emit_signals (viewer->stream, TRUE);
+	arv_camera_get_region (viewer->camera, NULL, NULL, &width, &height, NULL);
+
+	/* Rows padded to a multiple of 4 bytes can be handed to GStreamer without any copy */
 	payload = arv_camera_get_payload (viewer->camera, NULL);
 	for (i = 0; i < 5; i++)
-		arv_stream_push_buffer (viewer->stream, arv_buffer_new (payload, NULL));
+		arv_stream_push_buffer (viewer->stream, arv_buffer_new_padded (payload, height, 4));
 
-	arv_camera_get_region (viewer->camera, NULL, NULL, &width, &height, NULL);
 	pixel_format = arv_camera_get_pixel_format (viewer->camera, NULL);
 	arv_camera_get_exposure_time_bounds (viewer->camera, &viewer->exposure_min, &viewer->exposure_max, NULL);
 	arv_camera_get_gain_bounds (viewer->camera, &gain_min, &gain_max, NULL);
@@ -980,7 +1119,9 @@ start_video (ArvViewer *viewer)
 	g_signal_handler_unblock (viewer->auto_gain_toggle, viewer->auto_gain_clicked);
 	g_signal_handler_unblock (viewer->auto_exposure_toggle, viewer->auto_exposure_clicked);
 
-	caps_string = arv_pixel_format_to_gst_caps_string (pixel_format);
+	viewer->converter = _create_converter (pixel_format);
+
+	caps_string = arv_pixel_format_to_gst_caps_string (arv_converter_get_output_format (viewer->converter));
 	if (caps_string == NULL) {
 		g_message ("GStreamer cannot understand the camera pixel format: 0x%x!\n", (int) pixel_format);
 		stop_video (viewer);
@@ -1074,8 +1215,13 @@ start_video (ArvViewer *viewer)
 	viewer->n_images = 0;
 	viewer->n_bytes = 0;
 	viewer->n_errors = 0;
+	viewer->last_n_displayed_images = 0;
+	viewer->n_displayed_images = 0;
 	viewer->status_bar_update_event = g_timeout_add_seconds (1, update_status_bar_cb, viewer);
 
+	/* The frame clock of the main window ticks at the display refresh rate */
+	viewer->display_tick_id = gtk_widget_add_tick_callback (viewer->main_window, display_tick_cb, viewer, NULL);
+
 	g_signal_connect (viewer->stream, "new-buffer", G_CALLBACK (new_buffer_cb), viewer);
 
 	return TRUE;
@@ -1146,7 +1292,7 @@ start_camera (ArvViewer *viewer, const char *camera_id)
 	g_assert (n_pixel_formats == n_pixel_format_strings);
 	pixel_format_string = arv_camera_get_pixel_format_as_string (viewer->camera, NULL);
 	for (i = 0; i < n_pixel_formats; i++) {
-		if (arv_pixel_format_to_gst_caps_string (pixel_formats[i]) != NULL) {
+		if (_get_gst_caps_string (pixel_formats[i]) != NULL) {
 			gtk_list_store_append (list_store, &iter);
 			gtk_list_store_set (list_store, &iter, 0, pixel_format_strings[i], -1);
 			if (g_strcmp0 (pixel_format_strings[i], pixel_format_string) == 0)
@@ -1379,9 +1525,10 @@ finalize (GObject *object)
 {
 	ArvViewer *viewer = (ArvViewer *) object;
 
-	G_OBJECT_CLASS (arv_viewer_parent_class)->finalize (object);
-
+	g_mutex_clear (&viewer->latest_buffer_mutex);
 	g_clear_object (&viewer->notification);
+
+	G_OBJECT_CLASS (arv_viewer_parent_class)->finalize (object);
 }
 
 ArvViewer *
@@ -1408,6 +1555,7 @@ static void
 arv_viewer_init (ArvViewer *viewer)
 {
 	viewer->notification = notify_notification_new (NULL, NULL, NULL);
+	g_mutex_init (&viewer->latest_buffer_mutex);
 	viewer->auto_socket_buffer = FALSE;
 	viewer->packet_resend = TRUE;
 	viewer->packet_timeout = 20;